@@ -0,0 +1,214 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_SCENE_H
+#define BENCHMARK_SCENE_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class BenchmarkScene
+/**
+ * This is the base class of the headless scenes of the scene benchmark. A scene creates
+ * the bodies, colliders and joints of one of the testbed scenes into a physics world
+ * without any rendering. The scale factor multiplies the number of objects of the scene.
+ * The vertex and height data of the meshes are owned by the scene and must therefore
+ * outlive the physics common object that uses them.
+ */
+class BenchmarkScene {
+
+    private :
+
+        // ---------- Attributes ---------- //
+
+        /// Name of the scene
+        std::string mName;
+
+        /// Vertices of the meshes of the scene
+        std::vector<std::vector<float>> mMeshVertices;
+
+        /// Triangle indices of the meshes of the scene
+        std::vector<std::vector<int>> mMeshIndices;
+
+        /// Triangle vertex arrays of the meshes of the scene
+        std::vector<std::unique_ptr<TriangleVertexArray>> mTriangleVertexArrays;
+
+    protected :
+
+        // ---------- Attributes ---------- //
+
+        /// Physics common object
+        PhysicsCommon* mPhysicsCommon = nullptr;
+
+        /// Physics world of the scene
+        PhysicsWorld* mWorld = nullptr;
+
+        /// Scale factor of the number of objects of the scene
+        decimal mScale = decimal(1.0);
+
+        // ---------- Methods ---------- //
+
+        /// Return a number of objects multiplied by the scale factor of the scene (at least one)
+        uint32 scaleCount(uint32 count) const {
+            return std::max(uint32(1), static_cast<uint32>(std::lround(count * mScale)));
+        }
+
+        /// Create a rigid body with a single collider
+        RigidBody* createBody(CollisionShape* shape, const Transform& transform,
+                              BodyType type = BodyType::DYNAMIC, decimal bounciness = decimal(0.0)) {
+
+            RigidBody* body = mWorld->createRigidBody(transform);
+            Collider* collider = body->addCollider(shape, Transform::identity());
+            collider->getMaterial().setBounciness(bounciness);
+            body->setType(type);
+            if (type == BodyType::DYNAMIC) {
+                body->updateMassPropertiesFromColliders();
+            }
+
+            return body;
+        }
+
+        /// Create a dumbbell body (two spheres linked by a capsule) as in the testbed
+        RigidBody* createDumbbell(SphereShape* sphereShape, CapsuleShape* capsuleShape, decimal distanceBetweenSpheres,
+                                  const Transform& transform) {
+
+            RigidBody* body = mWorld->createRigidBody(transform);
+            body->addCollider(sphereShape, Transform(Vector3(0, distanceBetweenSpheres * decimal(0.5), 0), Quaternion::identity()));
+            body->addCollider(sphereShape, Transform(Vector3(0, -distanceBetweenSpheres * decimal(0.5), 0), Quaternion::identity()));
+            body->addCollider(capsuleShape, Transform::identity());
+            body->updateMassPropertiesFromColliders();
+
+            return body;
+        }
+
+        /// Create the convex mesh shape used in place of the convex mesh of the testbed. The
+        /// polyhedron is the convex hull of the corners of a box and of its pushed out face centers.
+        ConvexMeshShape* createConvexMeshShape(float halfSize) {
+
+            std::vector<float> points;
+            for (int i=0; i < 8; i++) {
+                points.push_back((i & 1) ? halfSize : -halfSize);
+                points.push_back((i & 2) ? halfSize : -halfSize);
+                points.push_back((i & 4) ? halfSize : -halfSize);
+            }
+            for (int axis=0; axis < 3; axis++) {
+                for (int side=0; side < 2; side++) {
+                    for (int k=0; k < 3; k++) {
+                        points.push_back(k == axis ? (side == 0 ? -1.4f : 1.4f) * halfSize : 0.0f);
+                    }
+                }
+            }
+
+            PolyhedronMesh* mesh = mPhysicsCommon->createConvexHullMesh(points.data(), static_cast<uint32>(points.size() / 3),
+                                                                        3 * sizeof(float),
+                                                                        PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE);
+            return mPhysicsCommon->createConvexMeshShape(mesh);
+        }
+
+        /// Create a concave mesh shape of a grid of (nbCells x nbCells) cells in the XZ plane with a given
+        /// height at each vertex. The heights are given row by row with (nbCells + 1) values per row.
+        ConcaveMeshShape* createGridMeshShape(uint32 nbCells, float cellSize, const std::vector<float>& heights) {
+
+            const uint32 nbVerticesPerRow = nbCells + 1;
+            const float halfSize = nbCells * cellSize * 0.5f;
+
+            mMeshVertices.emplace_back();
+            std::vector<float>& vertices = mMeshVertices.back();
+            vertices.reserve(nbVerticesPerRow * nbVerticesPerRow * 3);
+            for (uint32 z=0; z < nbVerticesPerRow; z++) {
+                for (uint32 x=0; x < nbVerticesPerRow; x++) {
+                    vertices.push_back(x * cellSize - halfSize);
+                    vertices.push_back(heights[z * nbVerticesPerRow + x]);
+                    vertices.push_back(z * cellSize - halfSize);
+                }
+            }
+
+            mMeshIndices.emplace_back();
+            std::vector<int>& indices = mMeshIndices.back();
+            indices.reserve(nbCells * nbCells * 6);
+            for (uint32 z=0; z < nbCells; z++) {
+                for (uint32 x=0; x < nbCells; x++) {
+                    const int v0 = static_cast<int>(z * nbVerticesPerRow + x);
+                    const int v1 = v0 + 1;
+                    const int v2 = v0 + static_cast<int>(nbVerticesPerRow);
+                    const int v3 = v2 + 1;
+                    indices.insert(indices.end(), {v0, v2, v1, v1, v2, v3});
+                }
+            }
+
+            mTriangleVertexArrays.emplace_back(new TriangleVertexArray(static_cast<uint32>(vertices.size() / 3), vertices.data(),
+                                                                       3 * sizeof(float), static_cast<uint32>(indices.size() / 3),
+                                                                       indices.data(), 3 * sizeof(int),
+                                                                       TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                                                       TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE));
+
+            TriangleMesh* triangleMesh = mPhysicsCommon->createTriangleMesh();
+            triangleMesh->addSubpart(mTriangleVertexArrays.back().get());
+
+            return mPhysicsCommon->createConcaveMeshShape(triangleMesh);
+        }
+
+        /// Create the bodies, colliders and joints of the scene
+        virtual void createScene()=0;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        BenchmarkScene(const std::string& name) : mName(name) {
+
+        }
+
+        /// Destructor
+        virtual ~BenchmarkScene() = default;
+
+        /// Return the name of the scene
+        const std::string& getName() const {
+            return mName;
+        }
+
+        /// Create the scene into a physics world with a given scale factor
+        void create(PhysicsCommon& physicsCommon, PhysicsWorld* world, decimal scale) {
+
+            mPhysicsCommon = &physicsCommon;
+            mWorld = world;
+            mScale = scale;
+
+            createScene();
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,634 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_SCENES_H
+#define BENCHMARK_SCENES_H
+
+// Libraries
+#include "BenchmarkScene.h"
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class PileBenchmarkScene
+/**
+ * Headless version of the "pile" testbed scene: boxes, spheres, capsules and convex meshes
+ * falling into a sandbox. The sandbox mesh of the testbed is replaced by a procedural bowl.
+ */
+class PileBenchmarkScene : public BenchmarkScene {
+
+    protected :
+
+        /// Create the bodies of the scene
+        virtual void createScene() override {
+
+            const decimal boxSize = 3;
+            const decimal sphereRadius = decimal(2.5);
+            const decimal capsuleRadius = decimal(1.5);
+            const decimal capsuleHeight = 3;
+            const decimal radius = 3;
+            const decimal bounciness = decimal(0.2);
+
+            BoxShape* boxShape = mPhysicsCommon->createBoxShape(Vector3(boxSize, boxSize, boxSize) * decimal(0.5));
+            SphereShape* sphereShape = mPhysicsCommon->createSphereShape(sphereRadius);
+            CapsuleShape* capsuleShape = mPhysicsCommon->createCapsuleShape(capsuleRadius, capsuleHeight);
+            ConvexMeshShape* convexMeshShape = createConvexMeshShape(1.5f);
+
+            for (uint32 i=0; i < scaleCount(100); i++) {
+                const decimal angle = i * decimal(30.0);
+                const Vector3 position(radius * std::cos(angle), 70 + i * (boxSize + decimal(0.8)), radius * std::sin(angle));
+                createBody(boxShape, Transform(position, Quaternion::identity()), BodyType::DYNAMIC, bounciness);
+            }
+
+            for (uint32 i=0; i < scaleCount(40); i++) {
+                const decimal angle = i * decimal(35.0);
+                const Vector3 position(radius * std::cos(angle), 50 + i * (sphereRadius + decimal(0.8)), radius * std::sin(angle));
+                createBody(sphereShape, Transform(position, Quaternion::identity()), BodyType::DYNAMIC, bounciness);
+            }
+
+            for (uint32 i=0; i < scaleCount(30); i++) {
+                const decimal angle = i * decimal(45.0);
+                const Vector3 position(radius * std::cos(angle), 30 + i * (capsuleHeight + decimal(0.3)), radius * std::sin(angle));
+                createBody(capsuleShape, Transform(position, Quaternion::identity()), BodyType::DYNAMIC, bounciness);
+            }
+
+            for (uint32 i=0; i < scaleCount(30); i++) {
+                const decimal angle = i * decimal(30.0);
+                const Vector3 position(radius * std::cos(angle), 10 + i * (capsuleHeight + decimal(0.3)), radius * std::sin(angle));
+                createBody(convexMeshShape, Transform(position, Quaternion::identity()), BodyType::DYNAMIC, bounciness);
+            }
+
+            // Bowl shaped sandbox
+            const uint32 nbCells = 40;
+            const float cellSize = 2.0f;
+            std::vector<float> heights;
+            for (uint32 z=0; z <= nbCells; z++) {
+                for (uint32 x=0; x <= nbCells; x++) {
+                    const float dx = (x - nbCells * 0.5f) * cellSize;
+                    const float dz = (z - nbCells * 0.5f) * cellSize;
+                    heights.push_back(0.012f * (dx * dx + dz * dz));
+                }
+            }
+            createBody(createGridMeshShape(nbCells, cellSize, heights), Transform::identity(), BodyType::STATIC, bounciness);
+        }
+
+    public :
+
+        /// Constructor
+        PileBenchmarkScene() : BenchmarkScene("pile") {
+
+        }
+};
+
+// Class BoxTowerBenchmarkScene
+/**
+ * Headless version of the "boxtower" testbed scene: a tower of long boxes with alternating
+ * orientations. The scale factor is the number of towers.
+ */
+class BoxTowerBenchmarkScene : public BenchmarkScene {
+
+    protected :
+
+        /// Create the bodies of the scene
+        virtual void createScene() override {
+
+            const uint32 nbBoxes = 16;
+            const Vector3 boxSize(2, 2, 16);
+            const decimal distFromCenter = 4;
+            const decimal bounciness = decimal(0.2);
+
+            BoxShape* boxShape = mPhysicsCommon->createBoxShape(boxSize * decimal(0.5));
+            BoxShape* floorShape = mPhysicsCommon->createBoxShape(Vector3(30, decimal(0.5), 30) * decimal(0.5));
+
+            for (uint32 t=0; t < scaleCount(1); t++) {
+
+                const Vector3 offset(0, 0, t * decimal(40.0));
+
+                bool rotated = false;
+                uint32 floorIndex = 0;
+                for (uint32 i=0; i < nbBoxes; i++) {
+
+                    const decimal side = i % 2 == 0 ? -distFromCenter : distFromCenter;
+                    Vector3 position(side, 4 + floorIndex * (boxSize.y + decimal(0.1)), 0);
+                    Quaternion orientation = Quaternion::identity();
+                    if (rotated) {
+                        orientation = Quaternion::fromEulerAngles(0, PI_RP3D / decimal(2.0), 0);
+                        position = Vector3(0, 3 + floorIndex * (boxSize.y + decimal(0.2)), side);
+                    }
+
+                    createBody(boxShape, Transform(position + offset, orientation), BodyType::DYNAMIC, bounciness);
+
+                    if (i % 2 == 1) {
+                        rotated = !rotated;
+                        floorIndex++;
+                    }
+                }
+
+                createBody(floorShape, Transform(offset, Quaternion::identity()), BodyType::STATIC, bounciness);
+            }
+        }
+
+    public :
+
+        /// Constructor
+        BoxTowerBenchmarkScene() : BenchmarkScene("boxtower") {
+
+        }
+};
+
+// Class RagdollBenchmarkScene
+/**
+ * Headless version of the "ragdoll" testbed scene: ragdolls made of capsules linked with
+ * ball-and-socket, hinge and fixed joints falling on static boxes. The scale factor is the
+ * number of copies of the whole scene.
+ */
+class RagdollBenchmarkScene : public BenchmarkScene {
+
+    private :
+
+        /// Create a dynamic capsule or sphere body of a ragdoll
+        RigidBody* createPart(CollisionShape* shape, const Vector3& position, const Quaternion& orientation,
+                              decimal massDensity, decimal friction) {
+
+            RigidBody* body = mWorld->createRigidBody(Transform(position, orientation));
+            Collider* collider = body->addCollider(shape, Transform::identity());
+            collider->getMaterial().setMassDensity(massDensity);
+            collider->getMaterial().setFrictionCoefficient(friction);
+            body->updateMassPropertiesFromColliders();
+            body->setLinearDamping(decimal(0.02));
+            body->setAngularDamping(decimal(0.02));
+
+            return body;
+        }
+
+        /// Create a ball-and-socket joint with a cone limit
+        void createBallAndSocketJoint(RigidBody* body1, RigidBody* body2, const Vector3& anchor, decimal coneHalfAngle) {
+
+            BallAndSocketJointInfo jointInfo(body1, body2, anchor);
+            jointInfo.isCollisionEnabled = false;
+            BallAndSocketJoint* joint = static_cast<BallAndSocketJoint*>(mWorld->createJoint(jointInfo));
+            joint->setConeLimitHalfAngle(coneHalfAngle * PI_RP3D / decimal(180.0));
+            joint->enableConeLimit(true);
+        }
+
+        /// Create a hinge joint with limits between two bodies with the anchor in the middle of the bodies
+        void createHingeJoint(RigidBody* body1, RigidBody* body2, const Vector3& axis, decimal minAngle, decimal maxAngle) {
+
+            const Vector3 anchor = (body1->getTransform().getPosition() + body2->getTransform().getPosition()) * decimal(0.5);
+            HingeJointInfo jointInfo(body1, body2, anchor, axis, minAngle * PI_RP3D / decimal(180.0),
+                                     maxAngle * PI_RP3D / decimal(180.0));
+            jointInfo.isCollisionEnabled = false;
+            mWorld->createJoint(jointInfo);
+        }
+
+        /// Create a fixed joint between two bodies with the anchor in the middle of the bodies
+        void createFixedJoint(RigidBody* body1, RigidBody* body2) {
+
+            const Vector3 anchor = (body1->getTransform().getPosition() + body2->getTransform().getPosition()) * decimal(0.5);
+            FixedJointInfo jointInfo(body1, body2, anchor);
+            jointInfo.isCollisionEnabled = false;
+            mWorld->createJoint(jointInfo);
+        }
+
+        /// Create a ragdoll with the head at a given position
+        void createRagdoll(const Vector3& headPosition) {
+
+            const Quaternion horizontal = Quaternion::fromEulerAngles(0, 0, PI_RP3D / decimal(2.0));
+            const decimal friction = decimal(0.4);
+
+            SphereShape* headShape = mPhysicsCommon->createSphereShape(decimal(0.75));
+            CapsuleShape* torsoShape = mPhysicsCommon->createCapsuleShape(1, decimal(1.5));
+            CapsuleShape* hipShape = mPhysicsCommon->createCapsuleShape(1, 1);
+            CapsuleShape* armShape = mPhysicsCommon->createCapsuleShape(decimal(0.5), 2);
+            CapsuleShape* upperLegShape = mPhysicsCommon->createCapsuleShape(decimal(0.75), 2);
+            CapsuleShape* lowerLegShape = mPhysicsCommon->createCapsuleShape(decimal(0.5), 3);
+
+            const Vector3 chestPosition = headPosition + Vector3(0, decimal(-1.75), 0);
+            const Vector3 waistPosition = chestPosition + Vector3(0, -2, 0);
+            const Vector3 hipPosition = waistPosition + Vector3(0, -2, 0);
+            const Vector3 leftUpperArmPosition = chestPosition + Vector3(decimal(2.25), 0, 0);
+            const Vector3 rightUpperArmPosition = chestPosition + Vector3(decimal(-2.25), 0, 0);
+            const Vector3 leftUpperLegPosition = hipPosition + Vector3(decimal(0.8), decimal(-1.5), 0);
+            const Vector3 rightUpperLegPosition = hipPosition + Vector3(decimal(-0.8), decimal(-1.5), 0);
+
+            RigidBody* head = createPart(headShape, headPosition, Quaternion::identity(), 7, friction);
+            RigidBody* chest = createPart(torsoShape, chestPosition, horizontal, 9, friction);
+            RigidBody* waist = createPart(torsoShape, waistPosition, Quaternion::identity(), 9, friction);
+            RigidBody* hip = createPart(hipShape, hipPosition, horizontal, 9, friction);
+            RigidBody* leftUpperArm = createPart(armShape, leftUpperArmPosition, horizontal, 8, friction);
+            RigidBody* leftLowerArm = createPart(armShape, leftUpperArmPosition + Vector3(decimal(2.5), 0, 0), horizontal, 8, friction);
+            RigidBody* rightUpperArm = createPart(armShape, rightUpperArmPosition, horizontal, 8, friction);
+            RigidBody* rightLowerArm = createPart(armShape, rightUpperArmPosition + Vector3(decimal(-2.5), 0, 0), horizontal, 8, friction);
+            RigidBody* leftUpperLeg = createPart(upperLegShape, leftUpperLegPosition, Quaternion::identity(), 8, friction);
+            RigidBody* leftLowerLeg = createPart(lowerLegShape, leftUpperLegPosition + Vector3(0, -3, 0), Quaternion::identity(), 8, decimal(0.3));
+            RigidBody* rightUpperLeg = createPart(upperLegShape, rightUpperLegPosition, Quaternion::identity(), 8, friction);
+            RigidBody* rightLowerLeg = createPart(lowerLegShape, rightUpperLegPosition + Vector3(0, -3, 0), Quaternion::identity(), 8, decimal(0.3));
+
+            createBallAndSocketJoint(head, chest, headPosition + Vector3(0, decimal(-0.75), 0), 40);
+            createBallAndSocketJoint(chest, leftUpperArm, leftUpperArmPosition + Vector3(-1, 0, 0), 180);
+            createBallAndSocketJoint(chest, rightUpperArm, rightUpperArmPosition + Vector3(1, 0, 0), 180);
+            createHingeJoint(leftUpperArm, leftLowerArm, Vector3(0, 0, 1), 0, 340);
+            createHingeJoint(rightUpperArm, rightLowerArm, Vector3(0, 0, 1), 0, 340);
+            createFixedJoint(chest, waist);
+            createFixedJoint(waist, hip);
+            createBallAndSocketJoint(hip, leftUpperLeg, hipPosition + Vector3(decimal(0.8), 0, 0), 80);
+            createBallAndSocketJoint(hip, rightUpperLeg, hipPosition + Vector3(decimal(-0.8), 0, 0), 80);
+            createHingeJoint(leftUpperLeg, leftLowerLeg, Vector3(1, 0, 0), 0, 140);
+            createHingeJoint(rightUpperLeg, rightLowerLeg, Vector3(1, 0, 0), 0, 140);
+        }
+
+    protected :
+
+        /// Create the bodies and joints of the scene
+        virtual void createScene() override {
+
+            const uint32 nbRows = 3;
+            const uint32 nbColumns = 2;
+
+            BoxShape* floor1Shape = mPhysicsCommon->createBoxShape(Vector3(52, decimal(0.5), 52) * decimal(0.5));
+            BoxShape* floor2Shape = mPhysicsCommon->createBoxShape(Vector3(60, decimal(0.5), 82) * decimal(0.5));
+            BoxShape* largeBoxShape = mPhysicsCommon->createBoxShape(Vector3(36, 15, 18) * decimal(0.5));
+            BoxShape* planeShape = mPhysicsCommon->createBoxShape(Vector3(36, 1, 25) * decimal(0.5));
+
+            for (uint32 c=0; c < scaleCount(1); c++) {
+
+                const Vector3 offset(c * decimal(70.0), 0, 0);
+
+                for (uint32 i=0; i < nbRows; i++) {
+                    for (uint32 j=0; j < nbColumns; j++) {
+                        const Vector3 position((-(nbRows - 1) / decimal(2.0) + i) * 17, 31,
+                                               -6 + (-(nbColumns - 1) / decimal(2.0) + j) * 16);
+                        createRagdoll(position + offset);
+                    }
+                }
+
+                createBody(floor1Shape, Transform(offset + Vector3(0, 5, -4), Quaternion::identity()), BodyType::STATIC);
+                createBody(floor2Shape, Transform(offset + Vector3(0, -10, 0), Quaternion::identity()), BodyType::STATIC);
+                createBody(largeBoxShape, Transform(offset + Vector3(0, 10, -14), Quaternion::identity()), BodyType::STATIC);
+                createBody(planeShape, Transform(offset + Vector3(0, decimal(10.82), decimal(5.56)),
+                                                 Quaternion::fromEulerAngles(decimal(30.0) * PI_RP3D / decimal(180.0), 0, 0)),
+                           BodyType::STATIC);
+            }
+        }
+
+    public :
+
+        /// Constructor
+        RagdollBenchmarkScene() : BenchmarkScene("ragdoll") {
+
+        }
+};
+
+// Class BridgeBenchmarkScene
+/**
+ * Headless version of the "bridge" testbed scene: bridges of boxes linked with hinge joints
+ * and heavy spheres falling on them. The scale factor multiplies the number of bridges.
+ */
+class BridgeBenchmarkScene : public BenchmarkScene {
+
+    protected :
+
+        /// Create the bodies and joints of the scene
+        virtual void createScene() override {
+
+            const int nbBoxes = 16;
+            const Vector3 boxSize(2, decimal(0.5), 4);
+            const int nbBridges = static_cast<int>(scaleCount(4));
+
+            BoxShape* boxShape = mPhysicsCommon->createBoxShape(boxSize * decimal(0.5));
+            SphereShape* sphereShape = mPhysicsCommon->createSphereShape(2);
+
+            for (int b=0; b < nbBridges; b++) {
+
+                const decimal z = (-4 / 2 + b) * (boxSize.z + 4);
+
+                RigidBody* previousBox = nullptr;
+                for (int i=0; i < nbBoxes; i++) {
+
+                    const Vector3 position((-nbBoxes / 2 + i) * (boxSize.x + decimal(0.2)), -7, z);
+                    const bool isEnd = i == 0 || i == nbBoxes - 1;
+                    RigidBody* box = createBody(boxShape, Transform(position, Quaternion::identity()),
+                                                isEnd ? BodyType::STATIC : BodyType::DYNAMIC);
+
+                    if (previousBox != nullptr) {
+                        const Vector3 anchor = previousBox->getTransform().getPosition() + Vector3(boxSize.x * decimal(0.5), 0, 0);
+                        HingeJointInfo jointInfo(previousBox, box, anchor, Vector3(0, 0, 1));
+                        jointInfo.isCollisionEnabled = false;
+                        mWorld->createJoint(jointInfo);
+                    }
+                    previousBox = box;
+                }
+
+                RigidBody* sphere = createBody(sphereShape, Transform(Vector3(-12, 10, z), Quaternion::identity()));
+                sphere->setMass(40);
+            }
+        }
+
+    public :
+
+        /// Constructor
+        BridgeBenchmarkScene() : BenchmarkScene("bridge") {
+
+        }
+};
+
+// Class HeightFieldBenchmarkScene
+/**
+ * Headless version of the "heightfield" testbed scene: bodies of all the shape types falling
+ * on a height field. The Perlin noise terrain of the testbed is replaced by a sum of sines.
+ */
+class HeightFieldBenchmarkScene : public BenchmarkScene {
+
+    private :
+
+        /// Number of points of the height field in each direction
+        static const int NB_POINTS = 100;
+
+        /// Heights of the height field (they are not copied by the shape)
+        std::vector<float> mHeights;
+
+    protected :
+
+        /// Create the bodies of the scene
+        virtual void createScene() override {
+
+            const decimal boxSize = 2;
+            const decimal sphereRadius = decimal(1.5);
+            const decimal capsuleHeight = 1;
+            const decimal dumbbellHeight = 1;
+            const decimal radius = 3;
+
+            BoxShape* boxShape = mPhysicsCommon->createBoxShape(Vector3(boxSize, boxSize, boxSize) * decimal(0.5));
+            SphereShape* sphereShape = mPhysicsCommon->createSphereShape(sphereRadius);
+            CapsuleShape* capsuleShape = mPhysicsCommon->createCapsuleShape(1, capsuleHeight);
+            ConvexMeshShape* convexMeshShape = createConvexMeshShape(1.0f);
+            SphereShape* dumbbellSphereShape = mPhysicsCommon->createSphereShape(decimal(1.5));
+            CapsuleShape* dumbbellCapsuleShape = mPhysicsCommon->createCapsuleShape(decimal(0.5), 7);
+
+            for (uint32 i=0; i < scaleCount(3); i++) {
+                const decimal angle = i * decimal(30.0);
+                const Vector3 position(radius * std::cos(angle), 125 + i * (dumbbellHeight + decimal(0.3)), radius * std::sin(angle));
+                createDumbbell(dumbbellSphereShape, dumbbellCapsuleShape, 8, Transform(position, Quaternion::identity()));
+            }
+
+            for (uint32 i=0; i < scaleCount(10); i++) {
+                const decimal angle = i * decimal(30.0);
+                const Vector3 position(radius * std::cos(angle), 85 + i * (boxSize + decimal(0.8)), radius * std::sin(angle));
+                createBody(boxShape, Transform(position, Quaternion::identity()));
+            }
+
+            for (uint32 i=0; i < scaleCount(5); i++) {
+                const decimal angle = i * decimal(35.0);
+                const Vector3 position(radius * std::cos(angle), 75 + i * (sphereRadius + decimal(0.8)), radius * std::sin(angle));
+                createBody(sphereShape, Transform(position, Quaternion::identity()));
+            }
+
+            for (uint32 i=0; i < scaleCount(5); i++) {
+                const decimal angle = i * decimal(45.0);
+                const Vector3 position(radius * std::cos(angle), 40 + i * (capsuleHeight + decimal(0.3)), radius * std::sin(angle));
+                createBody(capsuleShape, Transform(position, Quaternion::identity()));
+            }
+
+            for (uint32 i=0; i < scaleCount(4); i++) {
+                const decimal angle = i * decimal(30.0);
+                const Vector3 position(radius * std::cos(angle), 30 + i * (capsuleHeight + decimal(0.3)), radius * std::sin(angle));
+                createBody(convexMeshShape, Transform(position, Quaternion::identity()));
+            }
+
+            // Height field
+            mHeights.resize(NB_POINTS * NB_POINTS);
+            float minHeight = 0;
+            float maxHeight = 0;
+            for (int j=0; j < NB_POINTS; j++) {
+                for (int i=0; i < NB_POINTS; i++) {
+                    const float height = 6.0f * std::sin(0.21f * i) * std::cos(0.17f * j) + 3.0f * std::sin(0.05f * (i + j));
+                    mHeights[j * NB_POINTS + i] = height;
+                    minHeight = std::min(minHeight, height);
+                    maxHeight = std::max(maxHeight, height);
+                }
+            }
+            HeightFieldShape* heightFieldShape = mPhysicsCommon->createHeightFieldShape(NB_POINTS, NB_POINTS, minHeight, maxHeight,
+                                                                                        mHeights.data(),
+                                                                                        HeightFieldShape::HeightDataType::HEIGHT_FLOAT_TYPE,
+                                                                                        1, 1, Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            createBody(heightFieldShape, Transform::identity(), BodyType::STATIC);
+        }
+
+    public :
+
+        /// Constructor
+        HeightFieldBenchmarkScene() : BenchmarkScene("heightfield") {
+
+        }
+};
+
+// Class ConcaveMeshBenchmarkScene
+/**
+ * Headless version of the "concavemesh" testbed scene: bodies of all the shape types falling
+ * on a static concave mesh. The castle mesh of the testbed is replaced by a procedural terrain.
+ */
+class ConcaveMeshBenchmarkScene : public BenchmarkScene {
+
+    protected :
+
+        /// Create the bodies of the scene
+        virtual void createScene() override {
+
+            const decimal boxSize = 2;
+            const decimal sphereRadius = decimal(0.5);
+            const decimal capsuleHeight = decimal(0.5);
+            const decimal dumbbellHeight = decimal(0.5);
+            const decimal radius = 15;
+
+            BoxShape* boxShape = mPhysicsCommon->createBoxShape(Vector3(boxSize, boxSize, boxSize) * decimal(0.5));
+            SphereShape* sphereShape = mPhysicsCommon->createSphereShape(sphereRadius);
+            CapsuleShape* capsuleShape = mPhysicsCommon->createCapsuleShape(decimal(0.5), capsuleHeight);
+            ConvexMeshShape* convexMeshShape = createConvexMeshShape(1.0f);
+            SphereShape* dumbbellSphereShape = mPhysicsCommon->createSphereShape(decimal(1.5));
+            CapsuleShape* dumbbellCapsuleShape = mPhysicsCommon->createCapsuleShape(decimal(0.5), 7);
+
+            for (uint32 i=0; i < scaleCount(3); i++) {
+                const decimal angle = i * decimal(30.0);
+                const Vector3 position(radius * std::cos(angle), 125 + i * (dumbbellHeight + decimal(0.3)), radius * std::sin(angle));
+                createDumbbell(dumbbellSphereShape, dumbbellCapsuleShape, 8, Transform(position, Quaternion::identity()));
+            }
+
+            for (uint32 i=0; i < scaleCount(20); i++) {
+                const decimal angle = i * decimal(30.0);
+                const Vector3 position(radius * std::cos(angle), 85 + i * (boxSize + decimal(0.8)), radius * std::sin(angle));
+                createBody(boxShape, Transform(position, Quaternion::identity()));
+            }
+
+            for (uint32 i=0; i < scaleCount(20); i++) {
+                const decimal angle = i * decimal(35.0);
+                const Vector3 position(radius * std::cos(angle), 75 + i * (sphereRadius + decimal(0.8)), radius * std::sin(angle));
+                createBody(sphereShape, Transform(position, Quaternion::identity()));
+            }
+
+            for (uint32 i=0; i < scaleCount(10); i++) {
+                const decimal angle = i * decimal(45.0);
+                const Vector3 position(radius * std::cos(angle), 40 + i * (capsuleHeight + decimal(0.3)), radius * std::sin(angle));
+                createBody(capsuleShape, Transform(position, Quaternion::identity()));
+            }
+
+            for (uint32 i=0; i < scaleCount(5); i++) {
+                const decimal angle = i * decimal(30.0);
+                const Vector3 position(radius * std::cos(angle), 30 + i * (capsuleHeight + decimal(0.3)), radius * std::sin(angle));
+                createBody(convexMeshShape, Transform(position, Quaternion::identity()));
+            }
+
+            // Terrain with walls and bumps
+            const uint32 nbCells = 60;
+            const float cellSize = 1.5f;
+            std::vector<float> heights;
+            for (uint32 z=0; z <= nbCells; z++) {
+                for (uint32 x=0; x <= nbCells; x++) {
+                    const bool isBorder = x < 2 || z < 2 || x > nbCells - 2 || z > nbCells - 2;
+                    heights.push_back(isBorder ? 10.0f : 2.0f * std::sin(0.4f * x) * std::sin(0.3f * z));
+                }
+            }
+            createBody(createGridMeshShape(nbCells, cellSize, heights), Transform::identity(), BodyType::STATIC);
+        }
+
+    public :
+
+        /// Constructor
+        ConcaveMeshBenchmarkScene() : BenchmarkScene("concavemesh") {
+
+        }
+};
+
+// Class CubeStackBenchmarkScene
+/**
+ * Headless version of the "cubestack" testbed scene: a pyramid of cubes on a floor. The
+ * scale factor is the number of pyramids.
+ */
+class CubeStackBenchmarkScene : public BenchmarkScene {
+
+    protected :
+
+        /// Create the bodies of the scene
+        virtual void createScene() override {
+
+            const int nbFloors = 15;
+            const decimal boxSize = 2;
+            const decimal bounciness = decimal(0.4);
+
+            BoxShape* boxShape = mPhysicsCommon->createBoxShape(Vector3(boxSize, boxSize, boxSize) * decimal(0.5));
+            BoxShape* floorShape = mPhysicsCommon->createBoxShape(Vector3(50, 1, 20) * decimal(0.5));
+
+            for (uint32 s=0; s < scaleCount(1); s++) {
+
+                const Vector3 offset(0, 0, s * decimal(25.0));
+
+                for (int i=nbFloors; i > 0; i--) {
+                    for (int j=0; j < i; j++) {
+                        const Vector3 position((-i * decimal(0.5) + j) * (decimal(0.1) + boxSize),
+                                               boxSize + (nbFloors - i) * (boxSize + decimal(0.1)), 0);
+                        createBody(boxShape, Transform(position + offset, Quaternion::identity()), BodyType::DYNAMIC, bounciness);
+                    }
+                }
+
+                createBody(floorShape, Transform(offset, Quaternion::identity()), BodyType::STATIC, bounciness);
+            }
+        }
+
+    public :
+
+        /// Constructor
+        CubeStackBenchmarkScene() : BenchmarkScene("cubestack") {
+
+        }
+};
+
+// Class HingeJointsChainBenchmarkScene
+/**
+ * Headless version of the "hingejointschain" testbed scene: a chain of boxes linked with
+ * hinge joints and hanging from a static box. The scale factor is the number of chains.
+ */
+class HingeJointsChainBenchmarkScene : public BenchmarkScene {
+
+    protected :
+
+        /// Create the bodies and joints of the scene
+        virtual void createScene() override {
+
+            const uint32 nbBoxes = 20;
+            const Vector3 boxSize(2, 1, 1);
+            const decimal space = decimal(0.3);
+
+            BoxShape* boxShape = mPhysicsCommon->createBoxShape(boxSize * decimal(0.5));
+
+            for (uint32 c=0; c < scaleCount(1); c++) {
+
+                RigidBody* previousBox = nullptr;
+                for (uint32 i=0; i < nbBoxes; i++) {
+
+                    const Vector3 position(i * (boxSize.x + space), 20, c * decimal(3.0));
+                    RigidBody* box = createBody(boxShape, Transform(position, Quaternion::identity()),
+                                                i == 0 ? BodyType::STATIC : BodyType::DYNAMIC);
+
+                    if (previousBox != nullptr) {
+                        const Vector3 anchor = previousBox->getTransform().getPosition() + Vector3(boxSize.x * decimal(0.5), 0, 0);
+                        HingeJointInfo jointInfo(previousBox, box, anchor, Vector3(0, 0, 1));
+                        jointInfo.isCollisionEnabled = false;
+                        mWorld->createJoint(jointInfo);
+                    }
+                    previousBox = box;
+                }
+            }
+        }
+
+    public :
+
+        /// Constructor
+        HingeJointsChainBenchmarkScene() : BenchmarkScene("hingejointschain") {
+
+        }
+};
+
+// Return the names of all the benchmark scenes
+inline std::vector<std::string> getBenchmarkSceneNames() {
+    return {"pile", "boxtower", "ragdoll", "bridge", "heightfield", "concavemesh", "cubestack", "hingejointschain"};
+}
+
+// Create a benchmark scene from its name (null if there is no scene with this name)
+inline std::unique_ptr<BenchmarkScene> createBenchmarkScene(const std::string& name) {
+
+    if (name == "pile") return std::unique_ptr<BenchmarkScene>(new PileBenchmarkScene());
+    if (name == "boxtower") return std::unique_ptr<BenchmarkScene>(new BoxTowerBenchmarkScene());
+    if (name == "ragdoll") return std::unique_ptr<BenchmarkScene>(new RagdollBenchmarkScene());
+    if (name == "bridge") return std::unique_ptr<BenchmarkScene>(new BridgeBenchmarkScene());
+    if (name == "heightfield") return std::unique_ptr<BenchmarkScene>(new HeightFieldBenchmarkScene());
+    if (name == "concavemesh") return std::unique_ptr<BenchmarkScene>(new ConcaveMeshBenchmarkScene());
+    if (name == "cubestack") return std::unique_ptr<BenchmarkScene>(new CubeStackBenchmarkScene());
+    if (name == "hingejointschain") return std::unique_ptr<BenchmarkScene>(new HingeJointsChainBenchmarkScene());
+
+    return nullptr;
+}
+
+}
+
+#endif
@@ -0,0 +1,66 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_BUILD_INFO_H
+#define BENCHMARK_BUILD_INFO_H
+
+// Libraries
+#include "JsonWriter.h"
+#include <reactphysics3d/reactphysics3d.h>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Write the options the library has been compiled with
+inline void writeBuildInfo(JsonWriter& writer) {
+
+    writer.beginObject("build");
+    writer.write("version", RP3D_VERSION);
+#ifdef IS_RP3D_DOUBLE_PRECISION_ENABLED
+    writer.write("double_precision", true);
+#else
+    writer.write("double_precision", false);
+#endif
+#ifdef IS_RP3D_PROFILING_ENABLED
+    writer.write("profiling", true);
+#else
+    writer.write("profiling", false);
+#endif
+#ifdef IS_RP3D_OPEN_ADDRESSING_MAPS_ENABLED
+    writer.write("open_addressing_maps", true);
+#else
+    writer.write("open_addressing_maps", false);
+#endif
+#ifdef NDEBUG
+    writer.write("assertions", false);
+#else
+    writer.write("assertions", true);
+#endif
+    writer.endObject();
+}
+
+}
+
+#endif
@@ -0,0 +1,174 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_JSON_WRITER_H
+#define BENCHMARK_JSON_WRITER_H
+
+// Libraries
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <iomanip>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class JsonWriter
+/**
+ * This class writes the results of the benchmarks into an output stream in the JSON format.
+ * The objects and arrays are opened and closed with the begin/end methods and the commas
+ * between the members are written automatically.
+ */
+class JsonWriter {
+
+    private :
+
+        // ---------- Attributes ---------- //
+
+        /// Output stream
+        std::ostream& mStream;
+
+        /// For each opened object or array, true if it already contains a member
+        std::vector<bool> mHasMembers;
+
+        // ---------- Methods ---------- //
+
+        /// Write the separator and the indentation before a new member
+        void beginMember() {
+
+            if (!mHasMembers.empty()) {
+                if (mHasMembers.back()) mStream << ",";
+                mHasMembers.back() = true;
+                mStream << "\n" << std::string(mHasMembers.size() * 2, ' ');
+            }
+        }
+
+        /// Write the key of a member of an object
+        void writeKey(const std::string& key) {
+            beginMember();
+            writeString(key);
+            mStream << ": ";
+        }
+
+        /// Write a string with the JSON escaped characters
+        void writeString(const std::string& text) {
+
+            mStream << "\"";
+            for (const char c : text) {
+                switch (c) {
+                    case '"': mStream << "\\\""; break;
+                    case '\\': mStream << "\\\\"; break;
+                    case '\n': mStream << "\\n"; break;
+                    case '\t': mStream << "\\t"; break;
+                    default: mStream << c;
+                }
+            }
+            mStream << "\"";
+        }
+
+        /// Close the current object or array
+        void end(char closingCharacter) {
+
+            const bool hasMembers = mHasMembers.back();
+            mHasMembers.pop_back();
+            if (hasMembers) {
+                mStream << "\n" << std::string(mHasMembers.size() * 2, ' ');
+            }
+            mStream << closingCharacter;
+            if (mHasMembers.empty()) mStream << std::endl;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        JsonWriter(std::ostream& stream) : mStream(stream) {
+            mStream << std::setprecision(6);
+        }
+
+        /// Begin an object (a member of an object if the key is not empty)
+        void beginObject(const std::string& key = "") {
+            if (key.empty()) beginMember(); else writeKey(key);
+            mStream << "{";
+            mHasMembers.push_back(false);
+        }
+
+        /// End the current object
+        void endObject() {
+            end('}');
+        }
+
+        /// Begin an array (a member of an object if the key is not empty)
+        void beginArray(const std::string& key = "") {
+            if (key.empty()) beginMember(); else writeKey(key);
+            mStream << "[";
+            mHasMembers.push_back(false);
+        }
+
+        /// End the current array
+        void endArray() {
+            end(']');
+        }
+
+        /// Write a member with a string value
+        void write(const std::string& key, const std::string& value) {
+            writeKey(key);
+            writeString(value);
+        }
+
+        /// Write a member with a string value
+        void write(const std::string& key, const char* value) {
+            write(key, std::string(value));
+        }
+
+        /// Write a member with a number value
+        void write(const std::string& key, double value) {
+            writeKey(key);
+            mStream << value;
+        }
+
+        /// Write a member with an integer value
+        void write(const std::string& key, uint64_t value) {
+            writeKey(key);
+            mStream << value;
+        }
+
+        /// Write a member with an integer value
+        void write(const std::string& key, uint32_t value) {
+            write(key, static_cast<uint64_t>(value));
+        }
+
+        /// Write a member with a boolean value
+        void write(const std::string& key, bool value) {
+            writeKey(key);
+            mStream << (value ? "true" : "false");
+        }
+};
+
+}
+
+#endif
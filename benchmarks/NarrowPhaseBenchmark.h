@@ -0,0 +1,545 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_NARROW_PHASE_BENCHMARK_H
+#define BENCHMARK_NARROW_PHASE_BENCHMARK_H
+
+// Libraries
+#include "JsonWriter.h"
+#include "BuildInfo.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/collision/narrowphase/CollisionDispatch.h>
+#include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
+#include <reactphysics3d/collision/narrowphase/GJK/GJKAlgorithm.h>
+#include <reactphysics3d/collision/shapes/TriangleShape.h>
+#include <reactphysics3d/components/ColliderComponents.h>
+#include <reactphysics3d/components/CollisionBodyComponents.h>
+#include <reactphysics3d/components/RigidBodyComponents.h>
+#include <reactphysics3d/engine/OverlappingPairs.h>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <memory>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class BenchmarkTriangleShape
+/**
+ * Triangle shape that can be created outside of the middle-phase of the library
+ */
+class BenchmarkTriangleShape : public TriangleShape {
+
+    public:
+
+        /// Constructor
+        BenchmarkTriangleShape(const Vector3* vertices, const Vector3* verticesNormals, HalfEdgeStructure& triangleHalfEdgeStructure,
+                               MemoryAllocator& allocator)
+            : TriangleShape(vertices, verticesNormals, 0, triangleHalfEdgeStructure, allocator) {
+
+        }
+};
+
+// Class NarrowPhaseBenchmark
+/**
+ * This benchmark measures the narrow-phase algorithms in isolation. For each case, a batch of
+ * randomized pairs of shapes is generated with a controlled distribution of penetration and
+ * separation distances and the algorithm of the case is run over the whole NarrowPhaseInfoBatch
+ * several times. The time per pair, the ratio of colliding pairs and the number of contact
+ * points per pair are written in the JSON format.
+ */
+class NarrowPhaseBenchmark {
+
+    public :
+
+        // Structure PairsSettings
+        /**
+         * Distribution of the generated pairs of shapes
+         */
+        struct PairsSettings {
+
+            /// Number of pairs in the batch of each case
+            uint32 nbPairs = 4096;
+
+            /// Number of times the algorithm is run over the batch
+            uint32 nbRepeats = 50;
+
+            /// Ratio of the pairs generated with a penetration (the other ones are separated)
+            double overlapRatio = 0.5;
+
+            /// Maximum penetration distance along the approach direction of the overlapping pairs
+            decimal maxPenetration = decimal(0.1);
+
+            /// Maximum separation distance along the approach direction of the separated pairs
+            decimal maxSeparation = decimal(0.5);
+
+            /// Seed of the random generator
+            uint32 seed = 1;
+        };
+
+    private :
+
+        // Enumeration Algorithm
+        /**
+         * Narrow-phase algorithm that is run by a benchmark case
+         */
+        enum class Algorithm {
+            SphereVsSphere,
+            SphereVsCapsule,
+            CapsuleVsCapsule,
+            GJK,
+            SphereVsConvexPolyhedron,
+            CapsuleVsConvexPolyhedron,
+            ConvexPolyhedronVsConvexPolyhedron
+        };
+
+        // Structure BenchmarkCase
+        /**
+         * An algorithm and the two shapes of its pairs
+         */
+        struct BenchmarkCase {
+
+            /// Name of the case
+            std::string name;
+
+            /// Tested algorithm
+            Algorithm algorithm;
+
+            /// First shape of the pairs
+            CollisionShape* shape1;
+
+            /// Second shape of the pairs
+            CollisionShape* shape2;
+        };
+
+        // ---------- Attributes ---------- //
+
+        /// Physics common used to create the shapes
+        PhysicsCommon mPhysicsCommon;
+
+        /// Memory manager of the narrow-phase batches and algorithms
+        MemoryManager mMemoryManager;
+
+        /// Components and pairs required by the narrow-phase batches
+        ColliderComponents mColliderComponents;
+        CollisionBodyComponents mCollisionBodyComponents;
+        RigidBodyComponents mRigidBodyComponents;
+        Set<bodypair> mNoCollisionPairs;
+
+        /// Collision dispatch that owns the narrow-phase algorithms
+        CollisionDispatch mCollisionDispatch;
+
+        /// Overlapping pairs referenced by the narrow-phase batches
+        OverlappingPairs mOverlappingPairs;
+
+        /// GJK algorithm (tested directly)
+        GJKAlgorithm mGJKAlgorithm;
+
+        /// Half-edge structure of the triangle shape
+        HalfEdgeStructure mTriangleHalfEdgeStructure;
+
+        /// Vertices and vertices normals of the triangle shape
+        Vector3 mTriangleVertices[3];
+        Vector3 mTriangleVerticesNormals[3];
+
+        /// Triangle shape
+        std::unique_ptr<BenchmarkTriangleShape> mTriangleShape;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        /// Profiler of the algorithms
+        Profiler mProfiler;
+
+#endif
+
+        /// Benchmark cases
+        std::vector<BenchmarkCase> mCases;
+
+        /// Distribution of the pairs
+        PairsSettings mSettings;
+
+        // ---------- Methods ---------- //
+
+        /// Initialize the half-edge structure of the triangle shape (same as the one of the library)
+        void initTriangleHalfEdgeStructure() {
+
+            mTriangleHalfEdgeStructure.addVertex(0);
+            mTriangleHalfEdgeStructure.addVertex(1);
+            mTriangleHalfEdgeStructure.addVertex(2);
+
+            Array<uint> face0(mMemoryManager.getHeapAllocator(), 3);
+            face0.add(0); face0.add(1); face0.add(2);
+            Array<uint> face1(mMemoryManager.getHeapAllocator(), 3);
+            face1.add(0); face1.add(2); face1.add(1);
+
+            mTriangleHalfEdgeStructure.addFace(face0);
+            mTriangleHalfEdgeStructure.addFace(face1);
+
+            mTriangleHalfEdgeStructure.init();
+        }
+
+        /// Create a convex mesh shape from the convex hull of a box with a pyramid on each face
+        ConvexMeshShape* createHullShape(float halfSize) {
+
+            std::vector<float> points;
+            for (int i=0; i < 8; i++) {
+                points.push_back((i & 1) ? halfSize : -halfSize);
+                points.push_back((i & 2) ? halfSize : -halfSize);
+                points.push_back((i & 4) ? halfSize : -halfSize);
+            }
+            for (int axis=0; axis < 3; axis++) {
+                for (int side=0; side < 2; side++) {
+                    for (int k=0; k < 3; k++) {
+                        points.push_back(k == axis ? (side == 0 ? -1.4f : 1.4f) * halfSize : 0.0f);
+                    }
+                }
+            }
+
+            PolyhedronMesh* mesh = mPhysicsCommon.createConvexHullMesh(points.data(), static_cast<uint32>(points.size() / 3),
+                                                                       3 * sizeof(float),
+                                                                       PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE);
+            return mPhysicsCommon.createConvexMeshShape(mesh);
+        }
+
+        /// Create the benchmark cases
+        void createCases() {
+
+            SphereShape* sphere = mPhysicsCommon.createSphereShape(decimal(0.5));
+            CapsuleShape* capsule = mPhysicsCommon.createCapsuleShape(decimal(0.3), decimal(1.0));
+            BoxShape* box = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            ConvexMeshShape* hull = createHullShape(0.5f);
+            TriangleShape* triangle = mTriangleShape.get();
+
+            mCases = {
+                {"sphere-sphere", Algorithm::SphereVsSphere, sphere, sphere},
+                {"sphere-capsule", Algorithm::SphereVsCapsule, sphere, capsule},
+                {"capsule-capsule", Algorithm::CapsuleVsCapsule, capsule, capsule},
+                {"gjk-sphere-box", Algorithm::GJK, sphere, box},
+                {"gjk-capsule-hull", Algorithm::GJK, capsule, hull},
+                {"sphere-box", Algorithm::SphereVsConvexPolyhedron, sphere, box},
+                {"capsule-box", Algorithm::CapsuleVsConvexPolyhedron, capsule, box},
+                {"sat-box-box", Algorithm::ConvexPolyhedronVsConvexPolyhedron, box, box},
+                {"sat-hull-hull", Algorithm::ConvexPolyhedronVsConvexPolyhedron, hull, hull},
+                {"sphere-triangle", Algorithm::SphereVsConvexPolyhedron, sphere, triangle},
+                {"capsule-triangle", Algorithm::CapsuleVsConvexPolyhedron, capsule, triangle},
+                {"box-triangle", Algorithm::ConvexPolyhedronVsConvexPolyhedron, box, triangle},
+                {"hull-triangle", Algorithm::ConvexPolyhedronVsConvexPolyhedron, hull, triangle},
+            };
+        }
+
+        /// Run the algorithm of a case over a range of the batch and return the number of colliding pairs
+        uint32 testCollision(const BenchmarkCase& benchmarkCase, NarrowPhaseInfoBatch& batch, uint32 startIndex,
+                             uint32 nbItems, Array<GJKAlgorithm::GJKResult>& gjkResults) {
+
+            MemoryAllocator& allocator = mMemoryManager.getSingleFrameAllocator();
+
+            switch (benchmarkCase.algorithm) {
+                case Algorithm::SphereVsSphere:
+                    mCollisionDispatch.getSphereVsSphereAlgorithm()->testCollision(batch, startIndex, nbItems, allocator);
+                    break;
+                case Algorithm::SphereVsCapsule:
+                    mCollisionDispatch.getSphereVsCapsuleAlgorithm()->testCollision(batch, startIndex, nbItems, allocator);
+                    break;
+                case Algorithm::CapsuleVsCapsule:
+                    mCollisionDispatch.getCapsuleVsCapsuleAlgorithm()->testCollision(batch, startIndex, nbItems, allocator);
+                    break;
+                case Algorithm::GJK:
+                    gjkResults.clear();
+                    mGJKAlgorithm.testCollision(batch, startIndex, nbItems, gjkResults);
+                    break;
+                case Algorithm::SphereVsConvexPolyhedron:
+                    mCollisionDispatch.getSphereVsConvexPolyhedronAlgorithm()->testCollision(batch, startIndex, nbItems, true, allocator);
+                    break;
+                case Algorithm::CapsuleVsConvexPolyhedron:
+                    mCollisionDispatch.getCapsuleVsConvexPolyhedronAlgorithm()->testCollision(batch, startIndex, nbItems, true, allocator);
+                    break;
+                case Algorithm::ConvexPolyhedronVsConvexPolyhedron:
+                    mCollisionDispatch.getConvexPolyhedronVsConvexPolyhedronAlgorithm()->testCollision(batch, startIndex, nbItems, true, allocator);
+                    break;
+            }
+
+            uint32 nbCollidingPairs = 0;
+            for (uint32 i=startIndex; i < startIndex + nbItems; i++) {
+                const bool isColliding = benchmarkCase.algorithm == Algorithm::GJK ?
+                                         gjkResults[i - startIndex] != GJKAlgorithm::GJKResult::SEPARATED :
+                                         batch.narrowPhaseInfos[i].isColliding;
+                if (isColliding) nbCollidingPairs++;
+            }
+
+            return nbCollidingPairs;
+        }
+
+        /// Reset the results of the previous run of the batch
+        static void resetResults(NarrowPhaseInfoBatch& batch) {
+
+            for (uint32 i=0; i < batch.getNbObjects(); i++) {
+                NarrowPhaseInfoBatch::NarrowPhaseInfo& info = batch.narrowPhaseInfos[i];
+                info.isColliding = false;
+                info.nbContactPoints = 0;
+                info.contactPointsIndex = 0;
+                *info.lastFrameCollisionInfo = LastFrameCollisionInfo();
+            }
+            batch.contactPoints.clear();
+        }
+
+        /// Return the radius of a sphere centered at the origin of a shape that contains it
+        static decimal getBoundingRadius(const CollisionShape* shape) {
+
+            Vector3 min;
+            Vector3 max;
+            shape->getLocalBounds(min, max);
+            return Vector3(std::max(std::abs(min.x), std::abs(max.x)), std::max(std::abs(min.y), std::abs(max.y)),
+                           std::max(std::abs(min.z), std::abs(max.z))).length();
+        }
+
+        /// Return a random unit vector
+        static Vector3 getRandomDirection(std::mt19937& generator) {
+
+            std::normal_distribution<double> distribution;
+            Vector3 direction;
+            do {
+                direction = Vector3(decimal(distribution(generator)), decimal(distribution(generator)), decimal(distribution(generator)));
+            } while (direction.lengthSquare() < decimal(1e-6));
+
+            return direction.getUnit();
+        }
+
+        /// Return a random orientation
+        static Quaternion getRandomOrientation(std::mt19937& generator) {
+
+            std::normal_distribution<double> distribution;
+            Quaternion orientation;
+            do {
+                orientation = Quaternion(decimal(distribution(generator)), decimal(distribution(generator)),
+                                         decimal(distribution(generator)), decimal(distribution(generator)));
+            } while (orientation.lengthSquare() < decimal(1e-6));
+
+            return orientation.getUnit();
+        }
+
+        /// Find the distance along a direction between the centers of the two shapes of a case where they start to
+        /// touch. The touching distance is found by bisection with the algorithm of the case itself.
+        decimal findTouchingDistance(const BenchmarkCase& benchmarkCase, const Transform& transform1,
+                                     const Quaternion& orientation2, const Vector3& direction) {
+
+            NarrowPhaseInfoBatch batch(mOverlappingPairs, mMemoryManager.getPoolAllocator());
+            Array<GJKAlgorithm::GJKResult> gjkResults(mMemoryManager.getPoolAllocator(), 1);
+            LastFrameCollisionInfo lastFrameInfo;
+
+            batch.addNarrowPhaseInfo(0, Entity(0, 0), Entity(1, 0), benchmarkCase.shape1, benchmarkCase.shape2,
+                                     transform1, transform1, TriangleReference(), true, &lastFrameInfo);
+
+            decimal minDistance = decimal(0.0);
+            decimal maxDistance = getBoundingRadius(benchmarkCase.shape1) + getBoundingRadius(benchmarkCase.shape2) + decimal(0.1);
+            for (uint32 i=0; i < 24; i++) {
+
+                const decimal distance = decimal(0.5) * (minDistance + maxDistance);
+                batch.narrowPhaseInfos[0].shape2ToWorldTransform = Transform(transform1.getPosition() + distance * direction, orientation2);
+                resetResults(batch);
+
+                if (testCollision(benchmarkCase, batch, 0, 1, gjkResults) > 0) {
+                    minDistance = distance;
+                }
+                else {
+                    maxDistance = distance;
+                }
+
+                mMemoryManager.resetFrameAllocator();
+            }
+
+            // The contact points must be consumed before the batch is destroyed
+            resetResults(batch);
+
+            return minDistance;
+        }
+
+        /// Generate the pairs of a case
+        void generatePairs(const BenchmarkCase& benchmarkCase, NarrowPhaseInfoBatch& batch,
+                           std::vector<LastFrameCollisionInfo>& lastFrameInfos) {
+
+            std::mt19937 generator(mSettings.seed);
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            std::uniform_real_distribution<double> uniformPosition(-100.0, 100.0);
+
+            lastFrameInfos.assign(mSettings.nbPairs, LastFrameCollisionInfo());
+
+            for (uint32 i=0; i < mSettings.nbPairs; i++) {
+
+                const Vector3 position1(decimal(uniformPosition(generator)), decimal(uniformPosition(generator)),
+                                        decimal(uniformPosition(generator)));
+                const Transform transform1(position1, getRandomOrientation(generator));
+                const Quaternion orientation2 = getRandomOrientation(generator);
+                const Vector3 direction = getRandomDirection(generator);
+
+                // Signed distance to the touching position along the approach direction
+                const decimal gap = uniform(generator) < mSettings.overlapRatio ?
+                                    -decimal(uniform(generator)) * mSettings.maxPenetration :
+                                    decimal(uniform(generator)) * mSettings.maxSeparation;
+
+                const decimal touchingDistance = findTouchingDistance(benchmarkCase, transform1, orientation2, direction);
+                const decimal distance = std::max(touchingDistance + gap, decimal(0.0));
+                const Transform transform2(position1 + distance * direction, orientation2);
+
+                batch.addNarrowPhaseInfo(i, Entity(2 * i, 0), Entity(2 * i + 1, 0), benchmarkCase.shape1, benchmarkCase.shape2,
+                                         transform1, transform2, TriangleReference(), true, &lastFrameInfos[i]);
+            }
+        }
+
+        /// Return a percentile of sorted times
+        static double getPercentile(const std::vector<double>& sortedTimes, double percentile) {
+
+            const size_t index = static_cast<size_t>(std::ceil(percentile / 100.0 * sortedTimes.size()));
+            return sortedTimes[std::min(sortedTimes.size() - 1, index == 0 ? 0 : index - 1)];
+        }
+
+        /// Run a case and write its results
+        void runCase(JsonWriter& writer, const BenchmarkCase& benchmarkCase) {
+
+            NarrowPhaseInfoBatch batch(mOverlappingPairs, mMemoryManager.getPoolAllocator());
+            Array<GJKAlgorithm::GJKResult> gjkResults(mMemoryManager.getPoolAllocator(), mSettings.nbPairs);
+            std::vector<LastFrameCollisionInfo> lastFrameInfos;
+
+            generatePairs(benchmarkCase, batch, lastFrameInfos);
+
+            std::vector<double> times;
+            times.reserve(mSettings.nbRepeats);
+            uint32 nbCollidingPairs = 0;
+
+            for (uint32 r=0; r < mSettings.nbRepeats; r++) {
+
+                resetResults(batch);
+
+                const auto start = std::chrono::high_resolution_clock::now();
+
+                nbCollidingPairs = testCollision(benchmarkCase, batch, 0, mSettings.nbPairs, gjkResults);
+
+                const auto end = std::chrono::high_resolution_clock::now();
+                times.push_back(std::chrono::duration<double, std::nano>(end - start).count() / mSettings.nbPairs);
+
+                mMemoryManager.resetFrameAllocator();
+            }
+
+            const double totalTime = std::accumulate(times.begin(), times.end(), 0.0);
+            std::sort(times.begin(), times.end());
+
+            writer.beginObject();
+            writer.write("name", benchmarkCase.name);
+            writer.write("nb_pairs", mSettings.nbPairs);
+            writer.write("colliding_ratio", static_cast<double>(nbCollidingPairs) / mSettings.nbPairs);
+            writer.write("contacts_per_pair", static_cast<double>(batch.contactPoints.size()) / mSettings.nbPairs);
+            writer.beginObject("ns_per_pair");
+            writer.write("min", times.front());
+            writer.write("mean", totalTime / times.size());
+            writer.write("p50", getPercentile(times, 50));
+            writer.write("p90", getPercentile(times, 90));
+            writer.write("max", times.back());
+            writer.endObject();
+            writer.endObject();
+
+            // The contact points must be consumed before the batch is destroyed
+            resetResults(batch);
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        NarrowPhaseBenchmark(const PairsSettings& settings)
+            : mMemoryManager(nullptr), mColliderComponents(mMemoryManager.getHeapAllocator()),
+              mCollisionBodyComponents(mMemoryManager.getHeapAllocator()), mRigidBodyComponents(mMemoryManager.getHeapAllocator()),
+              mNoCollisionPairs(mMemoryManager.getPoolAllocator()), mCollisionDispatch(mMemoryManager.getPoolAllocator()),
+              mOverlappingPairs(mMemoryManager, mColliderComponents, mCollisionBodyComponents, mRigidBodyComponents,
+                                mNoCollisionPairs, mCollisionDispatch),
+              mTriangleHalfEdgeStructure(mMemoryManager.getHeapAllocator(), 2, 3, 6), mSettings(settings) {
+
+            mSettings.nbPairs = std::max(mSettings.nbPairs, uint32(1));
+            mSettings.nbRepeats = std::max(mSettings.nbRepeats, uint32(1));
+
+            initTriangleHalfEdgeStructure();
+
+            // Triangle centered at the origin
+            mTriangleVertices[0] = Vector3(-1, 0, decimal(-0.577));
+            mTriangleVertices[1] = Vector3(0, 0, decimal(1.155));
+            mTriangleVertices[2] = Vector3(1, 0, decimal(-0.577));
+            for (uint32 i=0; i < 3; i++) {
+                mTriangleVerticesNormals[i] = Vector3(0, 1, 0);
+            }
+            mTriangleShape.reset(new BenchmarkTriangleShape(mTriangleVertices, mTriangleVerticesNormals, mTriangleHalfEdgeStructure,
+                                                            mMemoryManager.getHeapAllocator()));
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+            mCollisionDispatch.setProfiler(&mProfiler);
+            mGJKAlgorithm.setProfiler(&mProfiler);
+#endif
+
+            createCases();
+        }
+
+        /// Return the names of the benchmark cases
+        std::vector<std::string> getCaseNames() const {
+
+            std::vector<std::string> names;
+            for (const BenchmarkCase& benchmarkCase : mCases) {
+                names.push_back(benchmarkCase.name);
+            }
+
+            return names;
+        }
+
+        /// Run some cases of the benchmark and write the results in the JSON format
+        void run(std::ostream& stream, const std::vector<std::string>& caseNames) {
+
+            JsonWriter writer(stream);
+
+            writer.beginObject();
+
+            writeBuildInfo(writer);
+
+            writer.write("pairs", mSettings.nbPairs);
+            writer.write("repeats", mSettings.nbRepeats);
+            writer.write("overlap_ratio", mSettings.overlapRatio);
+            writer.write("max_penetration", static_cast<double>(mSettings.maxPenetration));
+            writer.write("max_separation", static_cast<double>(mSettings.maxSeparation));
+            writer.write("seed", mSettings.seed);
+
+            writer.beginArray("cases");
+            for (const std::string& caseName : caseNames) {
+                for (const BenchmarkCase& benchmarkCase : mCases) {
+                    if (benchmarkCase.name == caseName) {
+                        runCase(writer, benchmarkCase);
+                    }
+                }
+            }
+            writer.endArray();
+
+            writer.endObject();
+        }
+};
+
+}
+
+#endif
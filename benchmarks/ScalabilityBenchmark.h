@@ -0,0 +1,318 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+
+#ifndef BENCHMARK_SCALABILITY_BENCHMARK_H
+#define BENCHMARK_SCALABILITY_BENCHMARK_H
+
+// Libraries
+#include "ScalabilityScenes.h"
+#include "JsonWriter.h"
+#include "BuildInfo.h"
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class ScalabilityBenchmark
+/**
+ * This benchmark measures how the step time of a world and of each stage of the
+ * PhysicsWorld::update() method grows with the number of bodies for a few scene archetypes.
+ * The library does not have worker threads yet. To plan the number of worlds per machine,
+ * the benchmark can instead step several independent copies of a world at the same time,
+ * one per thread. Each thread creates its world and the worlds are stepped concurrently
+ * after a barrier. The results are written in the JSON format.
+ */
+class ScalabilityBenchmark {
+
+    private :
+
+        // -------------------- Internal Classes -------------------- //
+
+        // Structure WorldRun
+        /**
+         * A world of the benchmark with the measures of its steps
+         */
+        struct WorldRun {
+
+            /// Scene that owns the mesh data of the world
+            std::unique_ptr<BenchmarkScene> scene;
+
+            /// Physics common object of the world (destroyed before the scene)
+            std::unique_ptr<PhysicsCommon> physicsCommon;
+
+            /// Physics world
+            PhysicsWorld* world = nullptr;
+
+            /// Time to create the world and its scene (in milliseconds)
+            double creationTime = 0;
+
+            /// Time of each measured step (in microseconds)
+            std::vector<double> stepTimes;
+
+            /// Statistics of each measured step
+            std::vector<PhysicsWorld::StepStats> stepStats;
+        };
+
+        // ---------- Attributes ---------- //
+
+        /// Number of bodies of the scenes for a scale factor of one
+        static const uint32 NB_BODIES_AT_UNIT_SCALE = 1000;
+
+        /// Names of the scenes to run
+        std::vector<std::string> mSceneNames;
+
+        /// Number of bodies of the worlds to measure
+        std::vector<uint32> mNbBodies;
+
+        /// Number of worlds stepped concurrently (one per thread) to measure
+        std::vector<uint32> mNbThreads;
+
+        /// Number of measured frames
+        uint32 mNbFrames;
+
+        /// Number of frames taken before measuring
+        uint32 mNbWarmupFrames;
+
+        /// Time step
+        const decimal mTimeStep = decimal(1.0) / decimal(60.0);
+
+        /// Mutex of the barrier between the threads
+        mutable std::mutex mBarrierMutex;
+
+        /// Condition variable of the barrier between the threads
+        mutable std::condition_variable mBarrierCondition;
+
+        /// Number of threads that have reached the barrier
+        mutable uint32 mNbThreadsAtBarrier;
+
+        // ---------- Methods ---------- //
+
+        /// Return a percentile of sorted step times
+        static double getPercentile(const std::vector<double>& sortedTimes, double percentile) {
+
+            const size_t index = static_cast<size_t>(std::ceil(percentile / 100.0 * sortedTimes.size()));
+            return sortedTimes[std::min(sortedTimes.size() - 1, index == 0 ? 0 : index - 1)];
+        }
+
+        /// Wait until a given number of threads have reached the barrier
+        void waitAtBarrier(uint32 nbThreads) const {
+
+            std::unique_lock<std::mutex> lock(mBarrierMutex);
+            mNbThreadsAtBarrier++;
+            if (mNbThreadsAtBarrier == nbThreads) {
+                mBarrierCondition.notify_all();
+            }
+            else {
+                mBarrierCondition.wait(lock, [this, nbThreads] { return mNbThreadsAtBarrier >= nbThreads; });
+            }
+        }
+
+        /// Create a world and step it for the warmup and measured frames (called by each thread)
+        void runWorld(WorldRun& run, const std::string& sceneName, decimal scale, uint32 nbThreads) const {
+
+            const auto creationStart = std::chrono::high_resolution_clock::now();
+
+            run.scene = createScalabilityScene(sceneName);
+            run.physicsCommon.reset(new PhysicsCommon());
+
+            PhysicsWorld::WorldSettings settings;
+            settings.worldName = sceneName;
+            run.world = run.physicsCommon->createPhysicsWorld(settings);
+            run.world->setIsStepTimingEnabled(true);
+
+            run.scene->create(*run.physicsCommon, run.world, scale);
+
+            run.stepTimes.reserve(mNbFrames);
+            run.stepStats.reserve(mNbFrames);
+
+            const auto creationEnd = std::chrono::high_resolution_clock::now();
+            run.creationTime = std::chrono::duration<double, std::milli>(creationEnd - creationStart).count();
+
+            for (uint32 i=0; i < mNbWarmupFrames; i++) {
+                run.world->update(mTimeStep);
+            }
+
+            // All the worlds are measured at the same time
+            waitAtBarrier(nbThreads);
+
+            for (uint32 i=0; i < mNbFrames; i++) {
+
+                const auto start = std::chrono::high_resolution_clock::now();
+
+                run.world->update(mTimeStep);
+
+                const auto end = std::chrono::high_resolution_clock::now();
+                run.stepTimes.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+                run.stepStats.push_back(run.world->getLastStepStats());
+            }
+        }
+
+        /// Return the mean of a member of the step statistics of all the worlds
+        template<typename T>
+        static double getMeanStat(const std::vector<WorldRun>& runs, T PhysicsWorld::StepStats::*member) {
+
+            double sum = 0;
+            size_t nbValues = 0;
+            for (const WorldRun& run : runs) {
+                for (const PhysicsWorld::StepStats& stats : run.stepStats) {
+                    sum += static_cast<double>(stats.*member);
+                    nbValues++;
+                }
+            }
+
+            return nbValues > 0 ? sum / nbValues : 0.0;
+        }
+
+        /// Run a scene with a given number of bodies and of concurrent worlds and write its results
+        void runScene(JsonWriter& writer, const std::string& sceneName, uint32 nbBodies, uint32 nbThreads) const {
+
+            const decimal scale = static_cast<decimal>(nbBodies) / NB_BODIES_AT_UNIT_SCALE;
+
+            // Create and step each world in its own thread
+            std::vector<WorldRun> runs(nbThreads);
+            mNbThreadsAtBarrier = 0;
+            if (nbThreads == 1) {
+                runWorld(runs[0], sceneName, scale, 1);
+            }
+            else {
+                std::vector<std::thread> threads;
+                for (WorldRun& run : runs) {
+                    threads.emplace_back(&ScalabilityBenchmark::runWorld, this, std::ref(run), std::cref(sceneName), scale, nbThreads);
+                }
+                for (std::thread& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            std::vector<double> stepTimes;
+            double creationTime = 0;
+            for (const WorldRun& run : runs) {
+                creationTime += run.creationTime;
+                stepTimes.insert(stepTimes.end(), run.stepTimes.begin(), run.stepTimes.end());
+            }
+            const double meanStepTime = std::accumulate(stepTimes.begin(), stepTimes.end(), 0.0) / stepTimes.size();
+            std::sort(stepTimes.begin(), stepTimes.end());
+
+            const uint32 nbWorldBodies = runs[0].world->getNbRigidBodies() + runs[0].world->getNbCollisionBodies();
+
+            writer.beginObject();
+            writer.write("name", sceneName);
+            writer.write("requested_bodies", nbBodies);
+            writer.write("nb_bodies", nbWorldBodies);
+            writer.write("threads", nbThreads);
+            writer.write("creation_time_ms", creationTime / nbThreads);
+            writer.write("memory_used_bytes", static_cast<uint64_t>(runs[0].world->getMemoryUsage().getTotal().usedBytes));
+
+            writer.beginObject("step_time_us");
+            writer.write("min", stepTimes.front());
+            writer.write("mean", meanStepTime);
+            writer.write("p50", getPercentile(stepTimes, 50));
+            writer.write("p90", getPercentile(stepTimes, 90));
+            writer.write("p99", getPercentile(stepTimes, 99));
+            writer.write("max", stepTimes.back());
+            writer.endObject();
+            writer.write("step_time_per_body_ns", meanStepTime * 1000.0 / std::max(nbWorldBodies, uint32(1)));
+            writer.write("world_steps_per_second", nbThreads * 1000000.0 / meanStepTime);
+
+            // Mean time of each stage of the step
+            writer.beginObject("stages_us");
+            writer.write("collision_detection", getMeanStat(runs, &PhysicsWorld::StepStats::collisionDetectionTime) * 1000.0);
+            writer.write("contacts", getMeanStat(runs, &PhysicsWorld::StepStats::contactsTime) * 1000.0);
+            writer.write("solver", getMeanStat(runs, &PhysicsWorld::StepStats::solverTime) * 1000.0);
+            writer.write("bodies_update", getMeanStat(runs, &PhysicsWorld::StepStats::bodiesUpdateTime) * 1000.0);
+            writer.write("sleeping", getMeanStat(runs, &PhysicsWorld::StepStats::sleepingTime) * 1000.0);
+            writer.write("total", getMeanStat(runs, &PhysicsWorld::StepStats::totalTime) * 1000.0);
+            writer.endObject();
+
+            // Mean number of objects processed by the stages at each step
+            writer.beginObject("counters");
+            writer.write("convex_pairs", getMeanStat(runs, &PhysicsWorld::StepStats::nbConvexPairs));
+            writer.write("concave_pairs", getMeanStat(runs, &PhysicsWorld::StepStats::nbConcavePairs));
+            writer.write("middle_phase_triangles", getMeanStat(runs, &PhysicsWorld::StepStats::nbMiddlePhaseTriangles));
+            writer.write("contact_manifolds", getMeanStat(runs, &PhysicsWorld::StepStats::nbContactManifolds));
+            writer.write("contact_points", getMeanStat(runs, &PhysicsWorld::StepStats::nbContactPoints));
+            writer.write("islands", getMeanStat(runs, &PhysicsWorld::StepStats::nbIslands));
+            writer.write("awake_bodies", getMeanStat(runs, &PhysicsWorld::StepStats::nbAwakeBodies));
+            writer.write("broad_phase_updates", getMeanStat(runs, &PhysicsWorld::StepStats::nbBroadPhaseUpdates));
+            writer.endObject();
+
+            writer.endObject();
+
+            // The physics common objects are destroyed before the scenes that own the mesh data
+            for (WorldRun& run : runs) {
+                run.physicsCommon.reset();
+            }
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        ScalabilityBenchmark(const std::vector<std::string>& sceneNames, const std::vector<uint32>& nbBodies,
+                             const std::vector<uint32>& nbThreads, uint32 nbFrames, uint32 nbWarmupFrames)
+            : mSceneNames(sceneNames), mNbBodies(nbBodies), mNbThreads(nbThreads), mNbFrames(std::max(nbFrames, uint32(1))),
+              mNbWarmupFrames(nbWarmupFrames), mNbThreadsAtBarrier(0) {
+
+        }
+
+        /// Run the benchmark and write the results in the JSON format
+        void run(std::ostream& stream) const {
+
+            JsonWriter writer(stream);
+
+            writer.beginObject();
+
+            writeBuildInfo(writer);
+
+            writer.write("frames", mNbFrames);
+            writer.write("warmup_frames", mNbWarmupFrames);
+            writer.write("time_step", static_cast<double>(mTimeStep));
+            writer.write("hardware_threads", static_cast<uint32>(std::thread::hardware_concurrency()));
+
+            writer.beginArray("runs");
+            for (const std::string& sceneName : mSceneNames) {
+                for (uint32 nbBodies : mNbBodies) {
+                    for (uint32 nbThreads : mNbThreads) {
+                        runScene(writer, sceneName, nbBodies, std::max(nbThreads, uint32(1)));
+                        stream.flush();
+                    }
+                }
+            }
+            writer.endArray();
+
+            writer.endObject();
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,259 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+
+#ifndef BENCHMARK_SCALABILITY_SCENES_H
+#define BENCHMARK_SCALABILITY_SCENES_H
+
+// Libraries
+#include "BenchmarkScene.h"
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class FallingBoxesScalabilityScene
+/**
+ * Scene of the scalability benchmark with layers of boxes falling on a floor. There are
+ * 1000 boxes for a scale factor of one and the floor grows with the number of boxes.
+ */
+class FallingBoxesScalabilityScene : public BenchmarkScene {
+
+    protected :
+
+        /// Create the bodies of the scene
+        virtual void createScene() override {
+
+            const uint32 nbBoxes = scaleCount(1000);
+            const uint32 nbLayers = 10;
+            const uint32 nbBoxesPerRow = static_cast<uint32>(std::ceil(std::sqrt(nbBoxes / double(nbLayers))));
+            const decimal spacing = decimal(2.5);
+            const decimal halfSize = nbBoxesPerRow * spacing * decimal(0.5);
+
+            BoxShape* boxShape = mPhysicsCommon->createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            BoxShape* floorShape = mPhysicsCommon->createBoxShape(Vector3(halfSize + 10, decimal(0.5), halfSize + 10));
+
+            for (uint32 i=0; i < nbBoxes; i++) {
+
+                const uint32 layer = i / (nbBoxesPerRow * nbBoxesPerRow);
+                const uint32 x = i % nbBoxesPerRow;
+                const uint32 z = (i / nbBoxesPerRow) % nbBoxesPerRow;
+                const Vector3 position(x * spacing - halfSize, 5 + layer * spacing, z * spacing - halfSize);
+                const Quaternion orientation = Quaternion::fromEulerAngles(decimal(0.1) * (i % 7), decimal(0.2) * (i % 5), 0);
+                createBody(boxShape, Transform(position, orientation));
+            }
+
+            createBody(floorShape, Transform(Vector3(0, decimal(-0.5), 0), Quaternion::identity()), BodyType::STATIC);
+        }
+
+    public :
+
+        /// Constructor
+        FallingBoxesScalabilityScene() : BenchmarkScene("fallingboxes") {
+
+        }
+};
+
+// Class RestingStacksScalabilityScene
+/**
+ * Scene of the scalability benchmark with stacks of ten boxes resting on a floor. There are
+ * 100 stacks for a scale factor of one. The bodies are not allowed to sleep so that the
+ * contacts of all the stacks are solved at each frame.
+ */
+class RestingStacksScalabilityScene : public BenchmarkScene {
+
+    protected :
+
+        /// Create the bodies of the scene
+        virtual void createScene() override {
+
+            const uint32 nbStacks = scaleCount(100);
+            const uint32 nbBoxesPerStack = 10;
+            const uint32 nbStacksPerRow = static_cast<uint32>(std::ceil(std::sqrt(double(nbStacks))));
+            const decimal spacing = 3;
+            const decimal halfSize = nbStacksPerRow * spacing * decimal(0.5);
+
+            mWorld->enableSleeping(false);
+
+            BoxShape* boxShape = mPhysicsCommon->createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            BoxShape* floorShape = mPhysicsCommon->createBoxShape(Vector3(halfSize + 10, decimal(0.5), halfSize + 10));
+
+            for (uint32 s=0; s < nbStacks; s++) {
+
+                const decimal x = (s % nbStacksPerRow) * spacing - halfSize;
+                const decimal z = (s / nbStacksPerRow) * spacing - halfSize;
+
+                for (uint32 i=0; i < nbBoxesPerStack; i++) {
+                    createBody(boxShape, Transform(Vector3(x, decimal(0.5) + i, z), Quaternion::identity()));
+                }
+            }
+
+            createBody(floorShape, Transform(Vector3(0, decimal(-0.5), 0), Quaternion::identity()), BodyType::STATIC);
+        }
+
+    public :
+
+        /// Constructor
+        RestingStacksScalabilityScene() : BenchmarkScene("restingstacks") {
+
+        }
+};
+
+// Class JointsChainsScalabilityScene
+/**
+ * Scene of the scalability benchmark with chains of twenty boxes linked with hinge joints
+ * and hanging from a static box. There are 50 chains for a scale factor of one.
+ */
+class JointsChainsScalabilityScene : public BenchmarkScene {
+
+    protected :
+
+        /// Create the bodies and joints of the scene
+        virtual void createScene() override {
+
+            const uint32 nbChains = scaleCount(50);
+            const uint32 nbBoxesPerChain = 20;
+            const uint32 nbChainsPerRow = static_cast<uint32>(std::ceil(std::sqrt(double(nbChains))));
+            const Vector3 boxSize(2, 1, 1);
+            const decimal space = decimal(0.3);
+            const decimal chainLength = nbBoxesPerChain * (boxSize.x + space);
+
+            BoxShape* boxShape = mPhysicsCommon->createBoxShape(boxSize * decimal(0.5));
+
+            for (uint32 c=0; c < nbChains; c++) {
+
+                const Vector3 chainPosition((c % nbChainsPerRow) * (chainLength + 5), 50, (c / nbChainsPerRow) * decimal(3.0));
+
+                RigidBody* previousBox = nullptr;
+                for (uint32 i=0; i < nbBoxesPerChain; i++) {
+
+                    const Vector3 position = chainPosition + Vector3(i * (boxSize.x + space), 0, 0);
+                    RigidBody* box = createBody(boxShape, Transform(position, Quaternion::identity()),
+                                                i == 0 ? BodyType::STATIC : BodyType::DYNAMIC);
+
+                    if (previousBox != nullptr) {
+                        const Vector3 anchor = previousBox->getTransform().getPosition() + Vector3(boxSize.x * decimal(0.5), 0, 0);
+                        HingeJointInfo jointInfo(previousBox, box, anchor, Vector3(0, 0, 1));
+                        jointInfo.isCollisionEnabled = false;
+                        mWorld->createJoint(jointInfo);
+                    }
+                    previousBox = box;
+                }
+            }
+        }
+
+    public :
+
+        /// Constructor
+        JointsChainsScalabilityScene() : BenchmarkScene("jointschains") {
+
+        }
+};
+
+// Class TerrainDebrisScalabilityScene
+/**
+ * Scene of the scalability benchmark with debris of all the convex shape types falling on
+ * a height field terrain. There are 1000 debris for a scale factor of one and the terrain
+ * grows with the number of debris.
+ */
+class TerrainDebrisScalabilityScene : public BenchmarkScene {
+
+    private :
+
+        /// Heights of the height field (they are not copied by the shape)
+        std::vector<float> mHeights;
+
+    protected :
+
+        /// Create the bodies of the scene
+        virtual void createScene() override {
+
+            const uint32 nbDebris = scaleCount(1000);
+            const uint32 nbLayers = 4;
+            const uint32 nbDebrisPerRow = static_cast<uint32>(std::ceil(std::sqrt(nbDebris / double(nbLayers))));
+            const decimal spacing = 3;
+            const decimal halfSize = nbDebrisPerRow * spacing * decimal(0.5);
+
+            BoxShape* boxShape = mPhysicsCommon->createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            SphereShape* sphereShape = mPhysicsCommon->createSphereShape(decimal(0.5));
+            CapsuleShape* capsuleShape = mPhysicsCommon->createCapsuleShape(decimal(0.4), decimal(0.8));
+            ConvexMeshShape* convexMeshShape = createConvexMeshShape(0.5f);
+            CollisionShape* debrisShapes[4] = {boxShape, sphereShape, capsuleShape, convexMeshShape};
+
+            for (uint32 i=0; i < nbDebris; i++) {
+
+                const uint32 layer = i / (nbDebrisPerRow * nbDebrisPerRow);
+                const uint32 x = i % nbDebrisPerRow;
+                const uint32 z = (i / nbDebrisPerRow) % nbDebrisPerRow;
+                const Vector3 position(x * spacing - halfSize, 4 + layer * spacing, z * spacing - halfSize);
+                createBody(debrisShapes[i % 4], Transform(position, Quaternion::identity()));
+            }
+
+            // Height field with one point every three meters around the debris
+            const int nbPoints = static_cast<int>(nbDebrisPerRow) + 8;
+            mHeights.resize(nbPoints * nbPoints);
+            float minHeight = 0;
+            float maxHeight = 0;
+            for (int j=0; j < nbPoints; j++) {
+                for (int i=0; i < nbPoints; i++) {
+                    const float height = 2.0f * std::sin(0.3f * i) * std::cos(0.25f * j);
+                    mHeights[j * nbPoints + i] = height;
+                    minHeight = std::min(minHeight, height);
+                    maxHeight = std::max(maxHeight, height);
+                }
+            }
+            HeightFieldShape* heightFieldShape = mPhysicsCommon->createHeightFieldShape(nbPoints, nbPoints, minHeight, maxHeight,
+                                                                                        mHeights.data(),
+                                                                                        HeightFieldShape::HeightDataType::HEIGHT_FLOAT_TYPE,
+                                                                                        1, 1, Vector3(spacing, 1, spacing));
+            createBody(heightFieldShape, Transform::identity(), BodyType::STATIC);
+        }
+
+    public :
+
+        /// Constructor
+        TerrainDebrisScalabilityScene() : BenchmarkScene("terraindebris") {
+
+        }
+};
+
+// Return the names of all the scenes of the scalability benchmark
+inline std::vector<std::string> getScalabilitySceneNames() {
+    return {"fallingboxes", "restingstacks", "jointschains", "terraindebris"};
+}
+
+// Create a scene of the scalability benchmark from its name (null if there is no scene with this name)
+inline std::unique_ptr<BenchmarkScene> createScalabilityScene(const std::string& name) {
+
+    if (name == "fallingboxes") return std::unique_ptr<BenchmarkScene>(new FallingBoxesScalabilityScene());
+    if (name == "restingstacks") return std::unique_ptr<BenchmarkScene>(new RestingStacksScalabilityScene());
+    if (name == "jointschains") return std::unique_ptr<BenchmarkScene>(new JointsChainsScalabilityScene());
+    if (name == "terraindebris") return std::unique_ptr<BenchmarkScene>(new TerrainDebrisScalabilityScene());
+
+    return nullptr;
+}
+
+}
+
+#endif
@@ -0,0 +1,204 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_SCENE_BENCHMARK_H
+#define BENCHMARK_SCENE_BENCHMARK_H
+
+// Libraries
+#include "BenchmarkScenes.h"
+#include "JsonWriter.h"
+#include "BuildInfo.h"
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class SceneBenchmark
+/**
+ * This benchmark rebuilds the testbed scenes headlessly, steps each of them for a fixed
+ * number of frames and writes the step time percentiles of each scene in the JSON format.
+ * When the library is compiled with the profiler, the time spent in each stage of the
+ * PhysicsWorld::update() method is also reported.
+ */
+class SceneBenchmark {
+
+    private :
+
+        // ---------- Attributes ---------- //
+
+        /// Names of the scenes to run
+        std::vector<std::string> mSceneNames;
+
+        /// Number of measured frames per scene
+        uint32 mNbFrames;
+
+        /// Number of frames taken before measuring
+        uint32 mNbWarmupFrames;
+
+        /// Scale factor of the number of objects in the scenes
+        decimal mScale;
+
+        /// Time step
+        const decimal mTimeStep = decimal(1.0) / decimal(60.0);
+
+        // ---------- Methods ---------- //
+
+        /// Return a percentile of sorted step times
+        static double getPercentile(const std::vector<double>& sortedTimes, double percentile) {
+
+            const size_t index = static_cast<size_t>(std::ceil(percentile / 100.0 * sortedTimes.size()));
+            return sortedTimes[std::min(sortedTimes.size() - 1, index == 0 ? 0 : index - 1)];
+        }
+
+        /// Write the average time per frame of each stage of the world update
+        void writeStageTimes(JsonWriter& writer, PhysicsWorld* world) const {
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            ProfileNodeIterator* iterator = world->getProfiler()->getIterator();
+
+            // Find the node of the PhysicsWorld::update() method
+            int index = 0;
+            for (iterator->first(); !iterator->isEnd(); iterator->next()) {
+                if (std::string(iterator->getCurrentName()) == "PhysicsWorld::update()") break;
+                index++;
+            }
+
+            if (!iterator->isEnd()) {
+
+                iterator->enterChild(index);
+
+                for (iterator->first(); !iterator->isEnd(); iterator->next()) {
+
+                    writer.beginObject();
+                    writer.write("name", iterator->getCurrentName());
+                    writer.write("mean_us", iterator->getCurrentTotalTime().count() * 1000.0 / mNbFrames);
+                    writer.write("calls_per_frame", static_cast<double>(iterator->getCurrentNbTotalCalls()) / mNbFrames);
+                    writer.endObject();
+                }
+            }
+
+            delete iterator;
+#else
+            (void)writer;
+            (void)world;
+#endif
+        }
+
+        /// Run a scene and write its results
+        void runScene(JsonWriter& writer, const std::string& sceneName) const {
+
+            std::unique_ptr<BenchmarkScene> scene = createBenchmarkScene(sceneName);
+
+            // The physics common must be destroyed before the scene that owns the mesh data
+            PhysicsCommon physicsCommon;
+
+            PhysicsWorld::WorldSettings settings;
+            settings.worldName = sceneName;
+            PhysicsWorld* world = physicsCommon.createPhysicsWorld(settings);
+
+            scene->create(physicsCommon, world, mScale);
+
+            for (uint32 i=0; i < mNbWarmupFrames; i++) {
+                world->update(mTimeStep);
+            }
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+            world->getProfiler()->reset();
+#endif
+
+            std::vector<double> stepTimes;
+            stepTimes.reserve(mNbFrames);
+
+            for (uint32 i=0; i < mNbFrames; i++) {
+
+                const auto start = std::chrono::high_resolution_clock::now();
+
+                world->update(mTimeStep);
+
+                const auto end = std::chrono::high_resolution_clock::now();
+                stepTimes.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            }
+
+            const double totalTime = std::accumulate(stepTimes.begin(), stepTimes.end(), 0.0);
+            std::sort(stepTimes.begin(), stepTimes.end());
+
+            writer.beginObject();
+            writer.write("name", sceneName);
+            writer.write("nb_bodies", world->getNbRigidBodies());
+            writer.beginObject("step_time_us");
+            writer.write("min", stepTimes.front());
+            writer.write("mean", totalTime / stepTimes.size());
+            writer.write("p50", getPercentile(stepTimes, 50));
+            writer.write("p90", getPercentile(stepTimes, 90));
+            writer.write("p95", getPercentile(stepTimes, 95));
+            writer.write("p99", getPercentile(stepTimes, 99));
+            writer.write("max", stepTimes.back());
+            writer.endObject();
+            writer.beginArray("stages");
+            writeStageTimes(writer, world);
+            writer.endArray();
+            writer.endObject();
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        SceneBenchmark(const std::vector<std::string>& sceneNames, uint32 nbFrames, uint32 nbWarmupFrames, decimal scale)
+            : mSceneNames(sceneNames), mNbFrames(std::max(nbFrames, uint32(1))), mNbWarmupFrames(nbWarmupFrames), mScale(scale) {
+
+        }
+
+        /// Run the benchmark and write the results in the JSON format
+        void run(std::ostream& stream) const {
+
+            JsonWriter writer(stream);
+
+            writer.beginObject();
+
+            writeBuildInfo(writer);
+
+            writer.write("frames", mNbFrames);
+            writer.write("warmup_frames", mNbWarmupFrames);
+            writer.write("scale", static_cast<double>(mScale));
+            writer.write("time_step", static_cast<double>(mTimeStep));
+
+            writer.beginArray("scenes");
+            for (const std::string& sceneName : mSceneNames) {
+                runScene(writer, sceneName);
+            }
+            writer.endArray();
+
+            writer.endObject();
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,175 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_STATIC_BODIES_H
+#define BENCHMARK_STATIC_BODIES_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class StaticBodiesBenchmark
+/**
+ * This benchmark measures the step time of a world with a fixed number of moving bodies
+ * while the number of parked props (static bodies and sleeping bodies) grows. The static
+ * and sleeping bodies are skipped by the per-frame systems of the world and the step time
+ * should therefore stay roughly flat.
+ */
+class StaticBodiesBenchmark {
+
+    private :
+
+        // ---------- Attributes ---------- //
+
+        /// Number of moving bodies in each world
+        static const uint32 NB_MOVING_BODIES = 200;
+
+        /// Number of steps that are measured
+        static const uint32 NB_MEASURED_STEPS = 200;
+
+        /// Number of steps taken before measuring
+        static const uint32 NB_WARMUP_STEPS = 20;
+
+        /// Time step
+        const decimal mTimeStep = decimal(1.0) / decimal(60.0);
+
+        /// Largest number of parked props
+        uint32 mMaxNbProps;
+
+        // ---------- Methods ---------- //
+
+        /// Create the parked props of the world. Half of them are static and half of them
+        /// are dynamic bodies that are put to sleep. The props do not touch each other.
+        void createProps(PhysicsWorld* world, BoxShape* shape, uint32 nbProps) const {
+
+            const uint32 nbPropsPerRow = 500;
+
+            for (uint32 i=0; i < nbProps; i++) {
+
+                const Vector3 position(decimal(i % nbPropsPerRow) * decimal(3.0) - decimal(750.0), decimal(0.5),
+                                       decimal(i / nbPropsPerRow) * decimal(3.0) + decimal(50.0));
+                RigidBody* body = world->createRigidBody(Transform(position, Quaternion::identity()));
+                body->addCollider(shape, Transform::identity());
+
+                if (i % 2 == 0) {
+                    body->setType(BodyType::STATIC);
+                }
+                else {
+                    body->setIsSleeping(true);
+                }
+            }
+        }
+
+        /// Create the moving bodies falling on the floor
+        void createMovingBodies(PhysicsWorld* world, BoxShape* shape) const {
+
+            for (uint32 i=0; i < NB_MOVING_BODIES; i++) {
+
+                const Vector3 position(decimal(i % 10) * decimal(1.5) - decimal(7.5), decimal(2.0) + decimal(i / 10) * decimal(1.5), 0);
+                RigidBody* body = world->createRigidBody(Transform(position, Quaternion::identity()));
+                body->addCollider(shape, Transform::identity());
+                body->setIsAllowedToSleep(false);
+            }
+        }
+
+        /// Return the median step time (in microseconds) of a world with a given number of props
+        double measureStepTime(PhysicsCommon& physicsCommon, uint32 nbProps) const {
+
+            PhysicsWorld* world = physicsCommon.createPhysicsWorld();
+            BoxShape* boxShape = physicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            BoxShape* floorShape = physicsCommon.createBoxShape(Vector3(20, decimal(0.5), 20));
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, decimal(-0.5), 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(floorShape, Transform::identity());
+
+            createProps(world, boxShape, nbProps);
+            createMovingBodies(world, boxShape);
+
+            for (uint32 i=0; i < NB_WARMUP_STEPS; i++) {
+                world->update(mTimeStep);
+            }
+
+            std::vector<double> stepTimes;
+            stepTimes.reserve(NB_MEASURED_STEPS);
+
+            for (uint32 i=0; i < NB_MEASURED_STEPS; i++) {
+
+                const auto start = std::chrono::high_resolution_clock::now();
+
+                world->update(mTimeStep);
+
+                const auto end = std::chrono::high_resolution_clock::now();
+                stepTimes.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            }
+
+            physicsCommon.destroyPhysicsWorld(world);
+            physicsCommon.destroyBoxShape(boxShape);
+            physicsCommon.destroyBoxShape(floorShape);
+
+            // We use the median step time because it is less sensitive to the noise of the machine
+            std::sort(stepTimes.begin(), stepTimes.end());
+            return stepTimes[stepTimes.size() / 2];
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        StaticBodiesBenchmark(uint32 maxNbProps) : mMaxNbProps(maxNbProps) {
+
+        }
+
+        /// Run the benchmark and print the results
+        void run() const {
+
+            PhysicsCommon physicsCommon;
+
+            std::cout << "Static and sleeping bodies benchmark (" << NB_MOVING_BODIES << " moving bodies)" << std::endl;
+            std::cout << std::setw(12) << "props" << std::setw(25) << "median step time (us)" << std::endl;
+
+            uint32 nbProps = 0;
+            while (true) {
+
+                const double stepTime = measureStepTime(physicsCommon, nbProps);
+                std::cout << std::setw(12) << nbProps << std::setw(25) << std::fixed << std::setprecision(1) << stepTime << std::endl;
+
+                if (nbProps >= mMaxNbProps) break;
+                nbProps = nbProps == 0 ? 1000 : std::min(nbProps * 10, mMaxNbProps);
+            }
+        }
+};
+
+}
+
+#endif
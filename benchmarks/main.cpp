@@ -0,0 +1,213 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "StaticBodiesBenchmark.h"
+#include "SceneBenchmark.h"
+#include "ScalabilityBenchmark.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace reactphysics3d;
+
+// Print the usage of the benchmarks executable
+static void printUsage() {
+
+    std::cerr << "Usage: rp3d_benchmarks [--scenes <name,name,...|all>] [--frames <n>] [--warmup <n>]" << std::endl;
+    std::cerr << "                       [--scale <factor>] [--output <file.json>]" << std::endl;
+    std::cerr << "       rp3d_benchmarks --static-bodies [max number of static and sleeping props]" << std::endl;
+    std::cerr << "       rp3d_benchmarks --scalability [--scenes <name,name,...|all>] [--bodies <n,n,...>]" << std::endl;
+    std::cerr << "                       [--threads <n,n,...>] [--frames <n>] [--warmup <n>] [--output <file.json>]" << std::endl;
+    std::cerr << "Scenes:";
+    for (const std::string& name : getBenchmarkSceneNames()) {
+        std::cerr << " " << name;
+    }
+    std::cerr << std::endl;
+    std::cerr << "Scalability scenes:";
+    for (const std::string& name : getScalabilitySceneNames()) {
+        std::cerr << " " << name;
+    }
+    std::cerr << std::endl;
+}
+
+// Split a comma separated list of scene names
+static std::vector<std::string> parseSceneNames(const std::string& list, const std::vector<std::string>& allNames) {
+
+    if (list == "all") return allNames;
+
+    std::vector<std::string> names;
+    std::stringstream stream(list);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        if (!name.empty()) names.push_back(name);
+    }
+
+    return names;
+}
+
+// Split a comma separated list of positive numbers
+static std::vector<uint32> parseNumbers(const std::string& list) {
+
+    std::vector<uint32> numbers;
+    std::stringstream stream(list);
+    std::string number;
+    while (std::getline(stream, number, ',')) {
+        const int value = std::atoi(number.c_str());
+        if (value > 0) numbers.push_back(static_cast<uint32>(value));
+    }
+
+    return numbers;
+}
+
+// Write the results of a benchmark into the standard output or into a file
+template<typename Benchmark>
+static int runBenchmark(const Benchmark& benchmark, const std::string& outputFile) {
+
+    if (outputFile.empty()) {
+        benchmark.run(std::cout);
+    }
+    else {
+        std::ofstream file(outputFile);
+        if (!file.is_open()) {
+            std::cerr << "Cannot open the output file: " << outputFile << std::endl;
+            return 1;
+        }
+        benchmark.run(file);
+    }
+
+    return 0;
+}
+
+// Run the benchmark of the step time versus the number of bodies and of concurrent worlds
+static int runScalabilityBenchmark(int argc, char** argv) {
+
+    std::vector<std::string> sceneNames = getScalabilitySceneNames();
+    std::vector<uint32> nbBodies = {1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000};
+    std::vector<uint32> nbThreads = {1};
+    uint32 nbFrames = 60;
+    uint32 nbWarmupFrames = 30;
+    std::string outputFile;
+
+    for (int i=2; i < argc; i++) {
+
+        const std::string argument = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+
+        const std::string value = argv[++i];
+        if (argument == "--scenes") sceneNames = parseSceneNames(value, getScalabilitySceneNames());
+        else if (argument == "--bodies") nbBodies = parseNumbers(value);
+        else if (argument == "--threads") nbThreads = parseNumbers(value);
+        else if (argument == "--frames") nbFrames = static_cast<uint32>(std::atoi(value.c_str()));
+        else if (argument == "--warmup") nbWarmupFrames = static_cast<uint32>(std::atoi(value.c_str()));
+        else if (argument == "--output") outputFile = value;
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    for (const std::string& name : sceneNames) {
+        if (createScalabilityScene(name) == nullptr) {
+            std::cerr << "Unknown scene: " << name << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (nbBodies.empty() || nbThreads.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    ScalabilityBenchmark scalabilityBenchmark(sceneNames, nbBodies, nbThreads, nbFrames, nbWarmupFrames);
+
+    return runBenchmark(scalabilityBenchmark, outputFile);
+}
+
+int main(int argc, char** argv) {
+
+    // Benchmark of the static and sleeping bodies
+    if (argc > 1 && std::strcmp(argv[1], "--static-bodies") == 0) {
+
+        uint32 maxNbProps = 100000;
+        if (argc > 2) {
+            maxNbProps = static_cast<uint32>(std::atoi(argv[2]));
+        }
+
+        StaticBodiesBenchmark staticBodiesBenchmark(maxNbProps);
+        staticBodiesBenchmark.run();
+
+        return 0;
+    }
+
+    // Benchmark of the step time versus the number of bodies
+    if (argc > 1 && std::strcmp(argv[1], "--scalability") == 0) {
+        return runScalabilityBenchmark(argc, argv);
+    }
+
+    // Benchmark of the testbed scenes
+    std::vector<std::string> sceneNames = getBenchmarkSceneNames();
+    uint32 nbFrames = 600;
+    uint32 nbWarmupFrames = 60;
+    decimal scale = decimal(1.0);
+    std::string outputFile;
+
+    for (int i=1; i < argc; i++) {
+
+        const std::string argument = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+
+        const std::string value = argv[++i];
+        if (argument == "--scenes") sceneNames = parseSceneNames(value, getBenchmarkSceneNames());
+        else if (argument == "--frames") nbFrames = static_cast<uint32>(std::atoi(value.c_str()));
+        else if (argument == "--warmup") nbWarmupFrames = static_cast<uint32>(std::atoi(value.c_str()));
+        else if (argument == "--scale") scale = static_cast<decimal>(std::atof(value.c_str()));
+        else if (argument == "--output") outputFile = value;
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    for (const std::string& name : sceneNames) {
+        if (createBenchmarkScene(name) == nullptr) {
+            std::cerr << "Unknown scene: " << name << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    SceneBenchmark sceneBenchmark(sceneNames, nbFrames, nbWarmupFrames, scale);
+
+    return runBenchmark(sceneBenchmark, outputFile);
+}
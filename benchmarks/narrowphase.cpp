@@ -0,0 +1,116 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "NarrowPhaseBenchmark.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+using namespace reactphysics3d;
+
+// Print the usage of the narrow-phase benchmarks executable
+static void printUsage(const std::vector<std::string>& caseNames) {
+
+    std::cerr << "Usage: rp3d_narrowphase_benchmarks [--cases <name,name,...|all>] [--pairs <n>] [--repeats <n>]" << std::endl;
+    std::cerr << "                                   [--overlap-ratio <ratio>] [--max-penetration <distance>]" << std::endl;
+    std::cerr << "                                   [--max-separation <distance>] [--seed <n>] [--output <file.json>]" << std::endl;
+    std::cerr << "Cases:";
+    for (const std::string& name : caseNames) {
+        std::cerr << " " << name;
+    }
+    std::cerr << std::endl;
+}
+
+// Split a comma separated list of case names
+static std::vector<std::string> parseCaseNames(const std::string& list, const std::vector<std::string>& allCaseNames) {
+
+    if (list == "all") return allCaseNames;
+
+    std::vector<std::string> names;
+    std::stringstream stream(list);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        if (!name.empty()) names.push_back(name);
+    }
+
+    return names;
+}
+
+int main(int argc, char** argv) {
+
+    NarrowPhaseBenchmark::PairsSettings settings;
+    std::string casesList = "all";
+    std::string outputFile;
+
+    for (int i=1; i < argc; i++) {
+
+        const std::string argument = argv[i];
+        if (i + 1 >= argc) {
+            printUsage(NarrowPhaseBenchmark(settings).getCaseNames());
+            return 1;
+        }
+
+        const std::string value = argv[++i];
+        if (argument == "--cases") casesList = value;
+        else if (argument == "--pairs") settings.nbPairs = static_cast<uint32>(std::atoi(value.c_str()));
+        else if (argument == "--repeats") settings.nbRepeats = static_cast<uint32>(std::atoi(value.c_str()));
+        else if (argument == "--overlap-ratio") settings.overlapRatio = std::atof(value.c_str());
+        else if (argument == "--max-penetration") settings.maxPenetration = static_cast<decimal>(std::atof(value.c_str()));
+        else if (argument == "--max-separation") settings.maxSeparation = static_cast<decimal>(std::atof(value.c_str()));
+        else if (argument == "--seed") settings.seed = static_cast<uint32>(std::atoi(value.c_str()));
+        else if (argument == "--output") outputFile = value;
+        else {
+            printUsage(NarrowPhaseBenchmark(settings).getCaseNames());
+            return 1;
+        }
+    }
+
+    NarrowPhaseBenchmark narrowPhaseBenchmark(settings);
+
+    const std::vector<std::string> allCaseNames = narrowPhaseBenchmark.getCaseNames();
+    const std::vector<std::string> caseNames = parseCaseNames(casesList, allCaseNames);
+    for (const std::string& name : caseNames) {
+        if (std::find(allCaseNames.begin(), allCaseNames.end(), name) == allCaseNames.end()) {
+            std::cerr << "Unknown case: " << name << std::endl;
+            printUsage(allCaseNames);
+            return 1;
+        }
+    }
+
+    if (outputFile.empty()) {
+        narrowPhaseBenchmark.run(std::cout, caseNames);
+    }
+    else {
+        std::ofstream file(outputFile);
+        if (!file.is_open()) {
+            std::cerr << "Cannot open the output file: " << outputFile << std::endl;
+            return 1;
+        }
+        narrowPhaseBenchmark.run(file, caseNames);
+    }
+
+    return 0;
+}
@@ -112,6 +112,12 @@ class CollisionBody {
         /// Set whether or not the body is active
         virtual void setIsActive(bool isActive);
 
+        /// Return true if the colliders of the body share a single broad-phase proxy
+        bool isCompound() const;
+
+        /// Set whether or not the colliders of the body share a single broad-phase proxy
+        void setIsCompound(bool isCompound);
+
         /// Return the current position and orientation
         const Transform& getTransform() const;
 
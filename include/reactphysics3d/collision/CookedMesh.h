@@ -0,0 +1,180 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_COOKED_MESH_H
+#define REACTPHYSICS3D_COOKED_MESH_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+
+namespace reactphysics3d {
+
+// Structures describing the binary layout of a cooked mesh. A cooked mesh is a
+// versioned blob (in the native endianness of the machine that cooked it) made of a
+// CookedMeshHeader followed by a mesh description and the mesh data sections. Every
+// section offset is relative to the start of the blob and aligned on COOKED_MESH_ALIGNMENT
+// bytes so that the data can be used in place from a memory-mapped file.
+
+/// Magic number at the beginning of a cooked mesh ("RP3C")
+constexpr uint32 COOKED_MESH_MAGIC = 0x43335052;
+
+/// Version of the cooked mesh format
+constexpr uint32 COOKED_MESH_VERSION = 1;
+
+/// Alignment (in bytes) of every section of a cooked mesh
+constexpr uint32 COOKED_MESH_ALIGNMENT = 16;
+
+/// Type of mesh stored in a cooked mesh
+enum class CookedMeshType : uint32 {TRIANGLE_MESH = 1, POLYHEDRON_MESH = 2};
+
+// Structure CookedMeshHeader
+/**
+ * Header at the beginning of every cooked mesh
+ */
+struct CookedMeshHeader {
+
+    /// Magic number (COOKED_MESH_MAGIC)
+    uint32 magic;
+
+    /// Version of the format (COOKED_MESH_VERSION)
+    uint32 version;
+
+    /// Type of the cooked mesh
+    CookedMeshType type;
+
+    /// Size (in bytes) of a decimal value when the mesh has been cooked
+    uint32 decimalSize;
+
+    /// Size (in bytes) of a tree node when the mesh has been cooked
+    uint32 treeNodeSize;
+
+    /// Unused
+    uint32 padding;
+
+    /// Total size (in bytes) of the cooked mesh
+    uint64 totalSize;
+};
+
+// Structure CookedTriangleMeshInfo
+/**
+ * Description of a cooked triangle mesh (follows the header)
+ */
+struct CookedTriangleMeshInfo {
+
+    /// Number of sub-parts in the mesh
+    uint32 nbSubparts;
+
+    /// Number of nodes of the BVH
+    int32 bvhNbNodes;
+
+    /// ID of the root node of the BVH
+    int32 bvhRootNodeID;
+
+    /// Unused
+    uint32 padding;
+
+    /// Offset of the BVH nodes array
+    uint64 bvhNodesOffset;
+};
+
+// Structure CookedTriangleSubpart
+/**
+ * Description of a sub-part of a cooked triangle mesh. The vertices and normals
+ * are stored as three decimal values and the indices as three uint32 per triangle.
+ */
+struct CookedTriangleSubpart {
+
+    /// Number of vertices of the sub-part
+    uint32 nbVertices;
+
+    /// Number of triangles of the sub-part
+    uint32 nbTriangles;
+
+    /// Offset of the vertices array
+    uint64 verticesOffset;
+
+    /// Offset of the vertices normals array
+    uint64 normalsOffset;
+
+    /// Offset of the triangles indices array
+    uint64 indicesOffset;
+};
+
+// Structure CookedPolyhedronMeshInfo
+/**
+ * Description of a cooked polyhedron mesh (follows the header)
+ */
+struct CookedPolyhedronMeshInfo {
+
+    /// Number of vertices
+    uint32 nbVertices;
+
+    /// Number of faces
+    uint32 nbFaces;
+
+    /// Number of half-edges
+    uint32 nbHalfEdges;
+
+    /// Total number of vertex indices of all the faces
+    uint32 nbFacesIndices;
+
+    /// Centroid of the polyhedron
+    decimal centroid[3];
+
+    /// Offset of the vertices array (three decimal values per vertex)
+    uint64 verticesOffset;
+
+    /// Offset of the polygon faces array (PolygonVertexArray::PolygonFace)
+    uint64 facesOffset;
+
+    /// Offset of the faces vertex indices array (uint32)
+    uint64 facesIndicesOffset;
+
+    /// Offset of the array with one half-edge index per face (uint32)
+    uint64 facesEdgesOffset;
+
+    /// Offset of the array with one half-edge index per vertex (uint32)
+    uint64 verticesEdgesOffset;
+
+    /// Offset of the half-edges array (HalfEdgeStructure::Edge)
+    uint64 halfEdgesOffset;
+
+    /// Offset of the faces normals array (three decimal values per face)
+    uint64 facesNormalsOffset;
+};
+
+// Return an offset (in bytes) rounded up to the alignment of the cooked mesh sections
+RP3D_FORCE_INLINE uint64 alignCookedMeshOffset(uint64 offset) {
+    return (offset + COOKED_MESH_ALIGNMENT - 1) & ~static_cast<uint64>(COOKED_MESH_ALIGNMENT - 1);
+}
+
+// Return true if a section of "size" bytes at "offset" fits in a cooked mesh of "totalSize" bytes
+RP3D_FORCE_INLINE bool isCookedMeshSectionValid(uint64 offset, uint64 size, uint64 totalSize) {
+    return offset % COOKED_MESH_ALIGNMENT == 0 && offset <= totalSize && size <= totalSize - offset;
+}
+
+}
+
+#endif
@@ -123,6 +123,9 @@ class HalfEdgeStructure {
         /// Return a given vertex
         const Vertex& getVertex(uint32 index) const;
 
+        // ---------- Friendship ---------- //
+
+        friend class PolyhedronMesh;
 };
 
 // Add a vertex
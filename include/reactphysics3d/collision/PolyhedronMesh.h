@@ -30,12 +30,12 @@
 #include <reactphysics3d/mathematics/mathematics.h>
 #include <reactphysics3d/containers/Array.h>
 #include "HalfEdgeStructure.h"
+#include <reactphysics3d/collision/QuickHull.h>
 
 namespace reactphysics3d {
 
 // Declarations
 class DefaultAllocator;
-class PolygonVertexArray;
 
 // Class PolyhedronMesh
 /**
@@ -64,6 +64,15 @@ class PolyhedronMesh {
         /// Centroid of the polyhedron
         Vector3 mCentroid;
 
+        /// True if the polygon vertex array has been created by the mesh (from cooked data or convex hull)
+        bool mIsOwningPolygonVertexArray;
+
+        /// Vertices and faces data owned by the mesh (only for a mesh created from a convex hull)
+        void* mOwnedData;
+
+        /// Size (in bytes) of the data owned by the mesh
+        size_t mOwnedDataSize;
+
         // -------------------- Methods -------------------- //
 
         /// Constructor
@@ -84,6 +93,18 @@ class PolyhedronMesh {
         /// Static factory method to create a polyhedron mesh
         static PolyhedronMesh* create(PolygonVertexArray* polygonVertexArray, MemoryAllocator& polyhedronMeshAllocator, MemoryAllocator& dataAllocator);
 
+        /// Static factory method to create a polyhedron mesh from the convex hull of a point cloud
+        static PolyhedronMesh* createConvexHull(const void* points, uint32 nbPoints, uint32 pointsStride,
+                                                PolygonVertexArray::VertexDataType pointsDataType, const QuickHull::Settings& settings,
+                                                MemoryAllocator& polyhedronMeshAllocator, MemoryAllocator& dataAllocator);
+
+        /// Serialize the mesh into a cooked binary blob
+        size_t cook(void* outData, size_t outDataSize) const;
+
+        /// Static factory method to create a polyhedron mesh from cooked data
+        static PolyhedronMesh* createFromCookedData(const void* cookedData, size_t cookedDataSize,
+                                                    MemoryAllocator& polyhedronMeshAllocator, MemoryAllocator& dataAllocator);
+
     public:
 
         // -------------------- Methods -------------------- //
@@ -0,0 +1,196 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_QUICK_HULL_H
+#define REACTPHYSICS3D_QUICK_HULL_H
+
+// Libraries
+#include <reactphysics3d/mathematics/mathematics.h>
+#include <reactphysics3d/containers/Array.h>
+#include <reactphysics3d/containers/Stack.h>
+#include <reactphysics3d/collision/PolygonVertexArray.h>
+
+namespace reactphysics3d {
+
+// Class QuickHull
+/**
+ * This class computes the convex hull of a point cloud using the Quickhull algorithm
+ * ("The Quickhull Algorithm for Convex Hulls" by Barber, Dobkin and Huhdanpaa). The
+ * number of vertices and faces of the hull can be limited. In this case, the furthest
+ * points are always added first so that the hull is the best approximation of the
+ * point cloud with the given budget. The triangles of the hull that are coplanar can
+ * be merged into polygon faces.
+ */
+class QuickHull {
+
+    public:
+
+        /// Settings of the convex hull computation
+        struct Settings {
+
+            /// Maximum number of vertices of the hull (zero for no limit)
+            uint32 maxNbVertices;
+
+            /// Maximum number of triangle faces of the hull before merging the
+            /// coplanar faces (zero for no limit)
+            uint32 maxNbFaces;
+
+            /// True if the coplanar triangle faces of the hull must be merged into polygons
+            bool mergeCoplanarFaces;
+
+            /// Maximum angle (in radians) between the normals of two faces to merge them
+            decimal coplanarFacesAngleTolerance;
+
+            /// Constructor
+            Settings() : maxNbVertices(0), maxNbFaces(0), mergeCoplanarFaces(true),
+                         coplanarFacesAngleTolerance(decimal(0.0175)) {}
+        };
+
+    private:
+
+        /// Triangle face of the hull during its construction
+        struct HullFace {
+
+            /// Indices of the three vertices (in the input points array)
+            uint32 vertices[3];
+
+            /// Index of the neighbor face across the edge (vertices[i], vertices[i+1])
+            uint32 neighbors[3];
+
+            /// Unit normal of the face (pointing outside the hull)
+            Vector3 normal;
+
+            /// Distance of the plane of the face from the origin
+            decimal planeOffset;
+
+            /// Index of the first point of the outside set of the face (or -1)
+            int32 firstOutsidePoint;
+
+            /// Index of the furthest point of the outside set (or -1)
+            int32 furthestPoint;
+
+            /// Distance of the furthest point of the outside set to the face
+            decimal furthestPointDistance;
+
+            /// True if the face is part of the hull
+            bool isAlive;
+
+            /// Index of the face in the array of alive faces (if the face is alive)
+            uint32 aliveFaceIndex;
+        };
+
+        /// Edge of the horizon seen from a point added into the hull
+        struct HorizonEdge {
+
+            /// Start vertex of the edge
+            uint32 start;
+
+            /// End vertex of the edge
+            uint32 end;
+
+            /// Face on the other side of the edge (not visible from the point)
+            uint32 neighborFace;
+        };
+
+        // -------------------- Attributes -------------------- //
+
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        /// Input points
+        const Array<Vector3>& mPoints;
+
+        /// Distance tolerance
+        decimal mEpsilon;
+
+        /// Faces of the hull (alive or not)
+        Array<HullFace> mFaces;
+
+        /// Indices of the alive faces of the hull
+        Array<uint32> mAliveFaces;
+
+        /// For each face, true if it is visible from the point being added into the hull
+        /// (reset after each point is added)
+        Array<bool> mIsFaceVisible;
+
+        /// Faces visible from the point being added into the hull
+        Array<uint32> mVisibleFaces;
+
+        /// Horizon edges seen from the point being added into the hull
+        Array<HorizonEdge> mHorizon;
+
+        /// Stack used to find the faces visible from the point being added into the hull
+        Stack<uint32> mFacesStack;
+
+        /// Next point in the outside set of a face for each point (or -1)
+        Array<int32> mNextOutsidePoint;
+
+        /// Number of alive faces that use each point as a vertex
+        Array<uint32> mVertexNbFaces;
+
+        /// Number of vertices of the hull
+        uint32 mNbHullVertices;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        QuickHull(const Array<Vector3>& points, MemoryAllocator& allocator);
+
+        /// Create the initial tetrahedron (return false if the points are degenerate)
+        bool createInitialTetrahedron(Array<uint32>& outTetrahedronVertices);
+
+        /// Create a new face and return its index
+        uint32 createFace(uint32 v0, uint32 v1, uint32 v2);
+
+        /// Remove a face from the hull
+        void removeFace(uint32 faceIndex);
+
+        /// Return the signed distance between a point and the plane of a face
+        decimal getDistanceToFace(const HullFace& face, const Vector3& point) const;
+
+        /// Assign a point to the outside set of the first face (among a range of faces) it is in front of
+        void assignPointToFaces(uint32 pointIndex, uint32 firstFace, uint32 endFace);
+
+        /// Add a point of the outside set of a face into the hull
+        void addPointToHull(uint32 faceIndex);
+
+        /// Build the hull
+        bool build(const Settings& settings);
+
+        /// Compute the output polygon faces of the hull
+        void computeOutput(const Settings& settings, Array<Vector3>& outVertices, Array<uint32>& outIndices,
+                           Array<PolygonVertexArray::PolygonFace>& outFaces);
+
+    public:
+
+        /// Compute the convex hull of a set of points
+        static bool computeConvexHull(const Array<Vector3>& points, const Settings& settings, MemoryAllocator& allocator,
+                                      Array<Vector3>& outVertices, Array<uint32>& outIndices,
+                                      Array<PolygonVertexArray::PolygonFace>& outFaces);
+};
+
+}
+
+#endif
@@ -35,6 +35,8 @@ namespace reactphysics3d {
 
 // Declarations
 class TriangleVertexArray;
+class DynamicAABBTree;
+struct TreeNode;
 
 // Class TriangleMesh
 /**
@@ -48,12 +50,39 @@ class TriangleMesh {
 
     protected:
 
+        /// Reference to the memory allocator
+        MemoryAllocator& mAllocator;
+
         /// All the triangle arrays of the mesh (one triangle array per part)
         Array<TriangleVertexArray*> mTriangleArrays;
 
+        /// Number of triangle arrays created by the mesh from cooked data. Those arrays are
+        /// the first ones of mTriangleArrays. The arrays added later belong to the user.
+        uint32 mNbOwnedTriangleArrays;
+
+        /// Pointer to the nodes of the BVH of the triangles (only if the mesh has been
+        /// created from cooked data)
+        const TreeNode* mCookedBVHNodes;
+
+        /// Number of nodes of the cooked BVH
+        int32 mCookedBVHNbNodes;
+
+        /// ID of the root node of the cooked BVH
+        int32 mCookedBVHRootNodeID;
+
         /// Constructor
         TriangleMesh(reactphysics3d::MemoryAllocator& allocator);
 
+        /// Insert all the triangles of the mesh into a dynamic AABB tree
+        void insertTrianglesIntoTree(DynamicAABBTree& tree) const;
+
+        /// Serialize the mesh into a cooked binary blob
+        size_t cook(void* outData, size_t outDataSize) const;
+
+        /// Static factory method to create a triangle mesh from cooked data
+        static TriangleMesh* createFromCookedData(const void* cookedData, size_t cookedDataSize,
+                                                  MemoryAllocator& triangleMeshAllocator, MemoryAllocator& dataAllocator);
+
     public:
 
         /// Destructor
@@ -68,10 +97,13 @@ class TriangleMesh {
         /// Return the number of subparts of the mesh
         uint32 getNbSubparts() const;
 
+        /// Return true if the mesh contains a BVH loaded from cooked data
+        bool hasCookedBVH() const;
 
         // ---------- Friendship ---------- //
 
         friend class PhysicsCommon;
+        friend class ConcaveMeshShape;
 };
 
 // Add a subpart of the mesh
@@ -80,6 +112,9 @@ class TriangleMesh {
  */
 RP3D_FORCE_INLINE void TriangleMesh::addSubpart(TriangleVertexArray* triangleVertexArray) {
     mTriangleArrays.add(triangleVertexArray );
+
+    // The cooked BVH does not contain the triangles of the new sub-part anymore
+    mCookedBVHNodes = nullptr;
 }
 
 // Return a pointer to a given subpart (triangle vertex array) of the mesh
@@ -100,6 +135,14 @@ RP3D_FORCE_INLINE uint32 TriangleMesh::getNbSubparts() const {
     return static_cast<uint32>(mTriangleArrays.size());
 }
 
+// Return true if the mesh contains a BVH loaded from cooked data
+/**
+ * @return True if the BVH of the mesh will be used in place instead of being computed
+ */
+RP3D_FORCE_INLINE bool TriangleMesh::hasCookedBVH() const {
+    return mCookedBVHNodes != nullptr;
+}
+
 }
 
 #endif
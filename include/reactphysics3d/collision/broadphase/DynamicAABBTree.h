@@ -141,8 +141,90 @@ class DynamicAABBTreeRaycastCallback {
  */
 class DynamicAABBTree {
 
+    public:
+
+        /// Structure QualityMetrics
+        /**
+         * This structure describes the quality of the tree. The SAH cost is the sum of the surface
+         * areas of the internal nodes divided by the surface area of the root node. It is proportional
+         * to the expected number of internal nodes visited by a query and grows when the tree degrades
+         * after many updates. The cost ratio compares it with the cost of the tree built from scratch
+         * by the rebuild() method. The counters of the updates are accumulated since the creation
+         * of the tree or the last call to resetUpdateCounters().
+         */
+        struct QualityMetrics {
+
+            /// Number of leaf nodes (objects) in the tree
+            uint32 nbLeafNodes;
+
+            /// Height of the tree
+            int height;
+
+            /// Surface area heuristic (SAH) cost of the tree
+            decimal sahCost;
+
+            /// SAH cost of the tree that would be obtained with a full rebuild
+            decimal rebuiltSahCost;
+
+            /// Ratio between the SAH cost of the tree and the cost of a rebuilt tree (one for an optimal tree)
+            decimal sahCostRatio;
+
+            /// Number of calls to updateObject()
+            uint64 nbObjectUpdates;
+
+            /// Number of updates where the new AABB was still inside the fat AABB of the node
+            uint64 nbFatAABBHits;
+
+            /// Number of updates where the node has been removed and inserted again in the tree
+            uint64 nbReinsertions;
+
+            /// Constructor
+            QualityMetrics() {
+
+                nbLeafNodes = 0;
+                height = 0;
+                sahCost = 0;
+                rebuiltSahCost = 0;
+                sahCostRatio = 1;
+                nbObjectUpdates = 0;
+                nbFatAABBHits = 0;
+                nbReinsertions = 0;
+            }
+
+            /// Return the ratio of the updates that did not modify the tree
+            decimal getFatAABBHitRate() const {
+                return nbObjectUpdates > 0 ? decimal(nbFatAABBHits) / decimal(nbObjectUpdates) : decimal(1.0);
+            }
+        };
+
     private:
 
+        // -------------------- Constants -------------------- //
+
+        /// Number of nodes allocated at the beginning
+        static const int32 INIT_NB_ALLOCATED_NODES = 8;
+
+        /// Number of bins used to find the best split of the nodes during a rebuild
+        static const uint32 NB_SAH_BINS = 16;
+
+        // -------------------- Structures -------------------- //
+
+        /// Range of leaf nodes from which a sub-tree is built during a rebuild
+        struct SubTreeRange {
+
+            /// Index of the first leaf node of the range
+            uint32 startIndex;
+
+            /// Index after the last leaf node of the range
+            uint32 endIndex;
+
+            /// ID of the parent node of the sub-tree
+            int32 parentNodeID;
+
+            /// Index of the sub-tree in the children of the parent node
+            int childIndex;
+        };
+
         // -------------------- Attributes -------------------- //
 
         /// Memory allocator
@@ -163,9 +245,25 @@ class DynamicAABBTree {
         /// Number of nodes in the tree
         int32 mNbNodes;
 
+        /// Largest number of nodes in the tree so far
+        int32 mPeakNbNodes;
+
         /// The fat AABB is the initial AABB inflated by a given percentage of its size.
         decimal mFatAABBInflatePercentage;
 
+        /// True if the nodes are stored in an external memory buffer that is not
+        /// owned by the tree (nodes loaded from cooked mesh data for instance)
+        bool mIsNodesMemoryExternal;
+
+        /// Number of calls to updateObject()
+        uint64 mNbObjectUpdates;
+
+        /// Number of updates where the new AABB was still inside the fat AABB of the node
+        uint64 mNbFatAABBHits;
+
+        /// Number of updates where the node has been reinserted in the tree
+        uint64 mNbReinsertions;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Pointer to the profiler
@@ -199,6 +297,18 @@ class DynamicAABBTree {
         /// Initialize the tree
         void init();
 
+        /// Copy the external nodes into memory owned by the tree before a modification
+        void copyExternalNodes();
+
+        /// Return the IDs of all the leaf nodes of the tree
+        void getLeafNodes(Array<int32>& outLeafNodes) const;
+
+        /// Split a range of leaf nodes in two using the binned surface area heuristic
+        uint32 splitLeafNodes(Array<int32>& leafNodes, uint32 startIndex, uint32 endIndex, AABB& outAABB) const;
+
+        /// Compute the SAH cost of the tree that would be built by the rebuild() method
+        decimal computeRebuiltSAHCost() const;
+
 #ifndef NDEBUG
 
         /// Check if the tree structure is valid (for debugging purpose)
@@ -253,12 +363,54 @@ class DynamicAABBTree {
         /// Compute the height of the tree
         int computeHeight();
 
+        /// Compute the surface area heuristic (SAH) cost of the tree
+        decimal computeSAHCost() const;
+
+        /// Compute the metrics describing the quality of the tree
+        QualityMetrics computeQualityMetrics() const;
+
+        /// Rebuild the whole tree from its leaf nodes using the surface area heuristic
+        void rebuild();
+
+        /// Return the number of calls to updateObject()
+        uint64 getNbObjectUpdates() const;
+
+        /// Return the number of updates where the node has been reinserted in the tree
+        uint64 getNbReinsertions() const;
+
+        /// Reset the counters of the updates of the objects
+        void resetUpdateCounters();
+
         /// Return the root AABB of the tree
         AABB getRootAABB() const;
 
         /// Clear all the nodes and reset the tree
         void reset();
 
+        /// Make sure there is enough allocated memory for a given number of nodes
+        void reserve(int32 nbNodes);
+
+        /// Move the nodes at the beginning of a memory buffer that fits them in depth-first order
+        void compact(Array<int32>& outNewNodeIDs);
+
+        /// Initialize the tree with nodes stored in an external memory buffer (no copy)
+        void initWithExternalNodes(const TreeNode* nodes, int32 nbNodes, int32 rootNodeID);
+
+        /// Return a pointer to the array of nodes of the tree
+        const TreeNode* getNodes() const;
+
+        /// Return the number of nodes in the tree
+        int32 getNbNodes() const;
+
+        /// Return the number of allocated nodes (used and free) in the tree
+        int32 getNbAllocatedNodes() const;
+
+        /// Return the ID of the root node of the tree
+        int32 getRootNodeID() const;
+
+        /// Return the memory usage of the nodes of the tree
+        MemoryUsage getMemoryUsage() const;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -298,6 +450,43 @@ RP3D_FORCE_INLINE AABB DynamicAABBTree::getRootAABB() const {
     return getFatAABB(mRootNodeID);
 }
 
+// Return a pointer to the array of nodes of the tree
+RP3D_FORCE_INLINE const TreeNode* DynamicAABBTree::getNodes() const {
+    return mNodes;
+}
+
+// Return the number of nodes in the tree
+RP3D_FORCE_INLINE int32 DynamicAABBTree::getNbNodes() const {
+    return mNbNodes;
+}
+
+// Return the number of allocated nodes (used and free) in the tree
+RP3D_FORCE_INLINE int32 DynamicAABBTree::getNbAllocatedNodes() const {
+    return mNbAllocatedNodes;
+}
+
+// Return the ID of the root node of the tree
+RP3D_FORCE_INLINE int32 DynamicAABBTree::getRootNodeID() const {
+    return mRootNodeID;
+}
+
+// Return the number of calls to updateObject()
+RP3D_FORCE_INLINE uint64 DynamicAABBTree::getNbObjectUpdates() const {
+    return mNbObjectUpdates;
+}
+
+// Return the number of updates where the node has been reinserted in the tree
+RP3D_FORCE_INLINE uint64 DynamicAABBTree::getNbReinsertions() const {
+    return mNbReinsertions;
+}
+
+// Reset the counters of the updates of the objects
+RP3D_FORCE_INLINE void DynamicAABBTree::resetUpdateCounters() {
+    mNbObjectUpdates = 0;
+    mNbFatAABBHits = 0;
+    mNbReinsertions = 0;
+}
+
 // Add an object into the tree. This method creates a new leaf node in the tree and
 // returns the ID of the corresponding node.
 RP3D_FORCE_INLINE int32 DynamicAABBTree::addObject(const AABB& aabb, int32 data1, int32 data2) {
@@ -29,6 +29,8 @@
 // Libraries
 #include <reactphysics3d/engine/OverlappingPairs.h>
 #include <reactphysics3d/collision/ContactPointInfo.h>
+#include <reactphysics3d/collision/shapes/ConcaveShape.h>
+#include <reactphysics3d/collision/shapes/TriangleShape.h>
 #include <reactphysics3d/configuration.h>
 
 /// Namespace ReactPhysics3D
@@ -61,9 +63,6 @@ struct NarrowPhaseInfoBatch {
         /// Collision info of the previous frame
         LastFrameCollisionInfo* lastFrameCollisionInfo;
 
-        /// Memory allocator for the collision shape (Used to release TriangleShape memory in destructor)
-        MemoryAllocator* collisionShapeAllocator;
-
         /// Shape local to world transform of sphere 1
         Transform shape1ToWorldTransform;
 
@@ -76,6 +75,13 @@ struct NarrowPhaseInfoBatch {
         /// Pointer to the second collision shapes to test collision with
         CollisionShape* collisionShape2;
 
+        /// Triangle to test if one of the two collision shapes is a concave shape. The triangle
+        /// shape is only built by the narrow-phase algorithms (see NarrowPhaseConvexShapes)
+        TriangleReference triangle;
+
+        /// Index of the first contact point of this test in the contact points array of the batch
+        uint32 contactPointsIndex;
+
         /// True if we need to report contacts (false for triggers for instance)
         bool reportContacts;
 
@@ -85,17 +91,14 @@ struct NarrowPhaseInfoBatch {
         /// Number of contact points
         uint8 nbContactPoints;
 
-        /// Array of contact points created during the narrow-phase
-        ContactPointInfo contactPoints[NB_MAX_CONTACT_POINTS_IN_NARROWPHASE_INFO];
-
         /// Constructor
-        NarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator,
+        NarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, LastFrameCollisionInfo* lastFrameInfo,
                              const Transform& shape1ToWorldTransform, const Transform& shape2ToWorldTransform, CollisionShape* shape1,
-                             CollisionShape* shape2, bool needToReportContacts)
+                             CollisionShape* shape2, const TriangleReference& triangle, bool needToReportContacts)
                       : overlappingPairId(pairId), colliderEntity1(collider1), colliderEntity2(collider2), lastFrameCollisionInfo(lastFrameInfo),
-                         collisionShapeAllocator(&shapeAllocator), shape1ToWorldTransform(shape1ToWorldTransform),
+                         shape1ToWorldTransform(shape1ToWorldTransform),
                          shape2ToWorldTransform(shape2ToWorldTransform), collisionShape1(shape1),
-                        collisionShape2(shape2), reportContacts(needToReportContacts), isColliding(false), nbContactPoints(0) {
+                        collisionShape2(shape2), triangle(triangle), contactPointsIndex(0), reportContacts(needToReportContacts), isColliding(false), nbContactPoints(0) {
 
         }
     };
@@ -111,11 +114,19 @@ struct NarrowPhaseInfoBatch {
         /// Cached capacity
         uint32 mCachedCapacity = 0;
 
+        /// Cached capacity of the contact points array
+        uint32 mCachedContactPointsCapacity = 0;
+
     public:
 
         /// For each collision test, we keep some meta data
         Array<NarrowPhaseInfo> narrowPhaseInfos;
 
+        /// Contact points of all the collision tests of the batch. Most of the tested pairs are not
+        /// colliding. Therefore, the contact points are only stored here when a collision is found
+        /// and each narrow-phase info refers to a range of this array.
+        Array<ContactPointInfo> contactPoints;
+
         /// Constructor
         NarrowPhaseInfoBatch(OverlappingPairs& overlappingPairs, MemoryAllocator& allocator);
 
@@ -125,7 +136,8 @@ struct NarrowPhaseInfoBatch {
         /// Add shapes to be tested during narrow-phase collision detection into the batch
         void addNarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
                                                       CollisionShape* shape2, const Transform& shape1Transform, const Transform& shape2Transform,
-                                                      bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator);
+                                                      const TriangleReference& triangle, bool needToReportContacts,
+                                                      LastFrameCollisionInfo* lastFrameInfo);
 
         /// Return the number of objects in the batch
         uint32 getNbObjects() const;
@@ -134,6 +146,9 @@ struct NarrowPhaseInfoBatch {
         void addContactPoint(uint32 index, const Vector3& contactNormal, decimal penDepth,
                              const Vector3& localPt1, const Vector3& localPt2);
 
+        /// Return a contact point of a given collision test
+        ContactPointInfo& getContactPoint(uint32 index, uint32 contactPointIndex);
+
         /// Reset the remaining contact points
         void resetContactPoints(uint32 index);
 
@@ -142,6 +157,49 @@ struct NarrowPhaseInfoBatch {
 
         /// Clear all the objects in the batch
         void clear();
+
+        // -------------------- Friendship -------------------- //
+
+        friend class NarrowPhaseConvexShapes;
+};
+
+// Class NarrowPhaseConvexShapes
+/**
+ * This class gives the two convex shapes of a collision test of a narrow-phase batch. When a
+ * collider of the test has a concave shape, the middle-phase only stores a reference to the
+ * triangle of the concave shape to test. In this case, the triangle shape is built here (in the
+ * stack frame of the narrow-phase algorithm) from the vertices of the concave shape. It is
+ * destroyed with this object. Therefore, no triangle shape needs to be allocated.
+ */
+class NarrowPhaseConvexShapes {
+
+    private:
+
+        /// Memory of the triangle shape of the test (if any)
+        alignas(TriangleShape) unsigned char mTriangleShapeMemory[sizeof(TriangleShape)];
+
+        /// Triangle shape of the test (nullptr if the two shapes of the test are convex)
+        TriangleShape* mTriangleShape;
+
+    public:
+
+        /// First convex shape of the test
+        const ConvexShape* shape1;
+
+        /// Second convex shape of the test
+        const ConvexShape* shape2;
+
+        /// Constructor
+        NarrowPhaseConvexShapes(const NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex);
+
+        /// Destructor
+        ~NarrowPhaseConvexShapes();
+
+        /// Deleted copy-constructor
+        NarrowPhaseConvexShapes(const NarrowPhaseConvexShapes& shapes) = delete;
+
+        /// Deleted assignment operator
+        NarrowPhaseConvexShapes& operator=(const NarrowPhaseConvexShapes& shapes) = delete;
 };
 
 /// Return the number of objects in the batch
@@ -152,10 +210,12 @@ RP3D_FORCE_INLINE uint32 NarrowPhaseInfoBatch::getNbObjects() const {
 // Add shapes to be tested during narrow-phase collision detection into the batch
 RP3D_FORCE_INLINE void NarrowPhaseInfoBatch::addNarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
                                               CollisionShape* shape2, const Transform& shape1Transform, const Transform& shape2Transform,
-                                              bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator) {
+                                              const TriangleReference& triangle, bool needToReportContacts,
+                                              LastFrameCollisionInfo* lastFrameInfo) {
 
     // Create a meta data object
-    narrowPhaseInfos.emplace(pairId, collider1, collider2, lastFrameInfo, shapeAllocator, shape1Transform, shape2Transform, shape1, shape2, needToReportContacts);
+    narrowPhaseInfos.emplace(pairId, collider1, collider2, lastFrameInfo, shape1Transform, shape2Transform, shape1, shape2, triangle,
+                             needToReportContacts);
 }
 
 // Add a new contact point
@@ -163,24 +223,93 @@ RP3D_FORCE_INLINE void NarrowPhaseInfoBatch::addContactPoint(uint32 index, const
 
     assert(penDepth > decimal(0.0));
 
-    if (narrowPhaseInfos[index].nbContactPoints < NB_MAX_CONTACT_POINTS_IN_NARROWPHASE_INFO) {
+    NarrowPhaseInfo& narrowPhaseInfo = narrowPhaseInfos[index];
+
+    if (narrowPhaseInfo.nbContactPoints < NB_MAX_CONTACT_POINTS_IN_NARROWPHASE_INFO) {
 
         assert(contactNormal.length() > 0.8f);
 
+        const uint32 nbContactPoints = static_cast<uint32>(contactPoints.size());
+
+        // If this is the first contact point of the test
+        if (narrowPhaseInfo.nbContactPoints == 0) {
+            narrowPhaseInfo.contactPointsIndex = nbContactPoints;
+        }
+        // If contact points of another test have been added after the ones of this test, we move
+        // the contact points of this test at the end of the array so that they stay contiguous
+        else if (narrowPhaseInfo.contactPointsIndex + narrowPhaseInfo.nbContactPoints != nbContactPoints) {
+
+            for (uint32 i=0; i < narrowPhaseInfo.nbContactPoints; i++) {
+                const ContactPointInfo contactPoint = contactPoints[narrowPhaseInfo.contactPointsIndex + i];
+                contactPoints.add(contactPoint);
+            }
+            narrowPhaseInfo.contactPointsIndex = nbContactPoints;
+        }
+
         // Add it into the array of contact points
-        narrowPhaseInfos[index].contactPoints[narrowPhaseInfos[index].nbContactPoints].normal = contactNormal;
-        narrowPhaseInfos[index].contactPoints[narrowPhaseInfos[index].nbContactPoints].penetrationDepth = penDepth;
-        narrowPhaseInfos[index].contactPoints[narrowPhaseInfos[index].nbContactPoints].localPoint1 = localPt1;
-        narrowPhaseInfos[index].contactPoints[narrowPhaseInfos[index].nbContactPoints].localPoint2 = localPt2;
-        narrowPhaseInfos[index].nbContactPoints++;
+        ContactPointInfo contactPoint;
+        contactPoint.normal = contactNormal;
+        contactPoint.penetrationDepth = penDepth;
+        contactPoint.localPoint1 = localPt1;
+        contactPoint.localPoint2 = localPt2;
+        contactPoints.add(contactPoint);
+
+        narrowPhaseInfo.nbContactPoints++;
     }
 }
 
+// Return a contact point of a given collision test
+RP3D_FORCE_INLINE ContactPointInfo& NarrowPhaseInfoBatch::getContactPoint(uint32 index, uint32 contactPointIndex) {
+
+    assert(contactPointIndex < narrowPhaseInfos[index].nbContactPoints);
+
+    return contactPoints[narrowPhaseInfos[index].contactPointsIndex + contactPointIndex];
+}
+
 // Reset the remaining contact points
 RP3D_FORCE_INLINE void NarrowPhaseInfoBatch::resetContactPoints(uint32 index) {
     narrowPhaseInfos[index].nbContactPoints = 0;
 }
 
+// Constructor
+RP3D_FORCE_INLINE NarrowPhaseConvexShapes::NarrowPhaseConvexShapes(const NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex)
+                 : mTriangleShape(nullptr) {
+
+    const NarrowPhaseInfoBatch::NarrowPhaseInfo& narrowPhaseInfo = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex];
+
+    // If one of the two shapes is concave, we build the triangle shape of the test
+    if (narrowPhaseInfo.collisionShape1->getType() == CollisionShapeType::CONCAVE_SHAPE) {
+
+        const ConcaveShape* concaveShape = static_cast<const ConcaveShape*>(narrowPhaseInfo.collisionShape1);
+        mTriangleShape = concaveShape->constructTriangleShape(mTriangleShapeMemory, narrowPhaseInfo.triangle, narrowPhaseInfoBatch.mMemoryAllocator);
+        shape1 = mTriangleShape;
+        shape2 = static_cast<const ConvexShape*>(narrowPhaseInfo.collisionShape2);
+    }
+    else if (narrowPhaseInfo.collisionShape2->getType() == CollisionShapeType::CONCAVE_SHAPE) {
+
+        const ConcaveShape* concaveShape = static_cast<const ConcaveShape*>(narrowPhaseInfo.collisionShape2);
+        mTriangleShape = concaveShape->constructTriangleShape(mTriangleShapeMemory, narrowPhaseInfo.triangle, narrowPhaseInfoBatch.mMemoryAllocator);
+        shape1 = static_cast<const ConvexShape*>(narrowPhaseInfo.collisionShape1);
+        shape2 = mTriangleShape;
+    }
+    else {
+
+        shape1 = static_cast<const ConvexShape*>(narrowPhaseInfo.collisionShape1);
+        shape2 = static_cast<const ConvexShape*>(narrowPhaseInfo.collisionShape2);
+    }
+
+    assert(shape1->isConvex());
+    assert(shape2->isConvex());
+}
+
+// Destructor
+RP3D_FORCE_INLINE NarrowPhaseConvexShapes::~NarrowPhaseConvexShapes() {
+
+    if (mTriangleShape != nullptr) {
+        mTriangleShape->~TriangleShape();
+    }
+}
+
 }
 
 #endif
@@ -53,6 +53,9 @@ class NarrowPhaseInput {
 
     private:
 
+        /// Number of convex vs triangle tests added since the last clear()
+        uint32 mNbTriangleTests = 0;
+
         NarrowPhaseInfoBatch mSphereVsSphereBatch;
         NarrowPhaseInfoBatch mSphereVsCapsuleBatch;
         NarrowPhaseInfoBatch mCapsuleVsCapsuleBatch;
@@ -60,16 +63,33 @@ class NarrowPhaseInput {
         NarrowPhaseInfoBatch mCapsuleVsConvexPolyhedronBatch;
         NarrowPhaseInfoBatch mConvexPolyhedronVsConvexPolyhedronBatch;
 
+        /// Add a test into the batch of the narrow-phase algorithm
+        void addNarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
+                                CollisionShape* shape2, const Transform& shape1Transform,
+                                const Transform& shape2Transform, const TriangleReference& triangle,
+                                NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts,
+                                LastFrameCollisionInfo* lastFrameInfo);
+
     public:
 
         /// Constructor
         NarrowPhaseInput(MemoryAllocator& allocator, OverlappingPairs& overlappingPairs);
 
+        /// Return the number of convex vs triangle tests of the convex vs concave pairs
+        uint32 getNbTriangleTests() const;
+
         /// Add shapes to be tested during narrow-phase collision detection into the batch
         void addNarrowPhaseTest(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
                         CollisionShape* shape2, const Transform& shape1Transform,
                         const Transform& shape2Transform, NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts,
-                        LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator);
+                        LastFrameCollisionInfo* lastFrameInfo);
+
+        /// Add a convex shape and a triangle of a concave shape to be tested during narrow-phase collision detection into the batch
+        void addNarrowPhaseTriangleTest(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
+                        CollisionShape* shape2, const Transform& shape1Transform,
+                        const Transform& shape2Transform, const TriangleReference& triangle,
+                        NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts,
+                        LastFrameCollisionInfo* lastFrameInfo);
 
         /// Get a reference to the sphere vs sphere batch
         NarrowPhaseInfoBatch& getSphereVsSphereBatch();
@@ -97,6 +117,11 @@ class NarrowPhaseInput {
 };
 
 
+// Return the number of convex vs triangle tests of the convex vs concave pairs
+RP3D_FORCE_INLINE uint32 NarrowPhaseInput::getNbTriangleTests() const {
+    return mNbTriangleTests;
+}
+
 // Get a reference to the sphere vs sphere batch contacts
 RP3D_FORCE_INLINE NarrowPhaseInfoBatch& NarrowPhaseInput::getSphereVsSphereBatch() {
     return mSphereVsSphereBatch;
@@ -130,27 +155,48 @@ RP3D_FORCE_INLINE NarrowPhaseInfoBatch &NarrowPhaseInput::getConvexPolyhedronVsC
 // Add shapes to be tested during narrow-phase collision detection into the batch
 RP3D_FORCE_INLINE void NarrowPhaseInput::addNarrowPhaseTest(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1, CollisionShape* shape2,
                                           const Transform& shape1Transform, const Transform& shape2Transform,
-                                          NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts, LastFrameCollisionInfo* lastFrameInfo,
-                                          MemoryAllocator& shapeAllocator) {
+                                          NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts, LastFrameCollisionInfo* lastFrameInfo) {
+
+    addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, TriangleReference(),
+                       narrowPhaseAlgorithmType, reportContacts, lastFrameInfo);
+}
+
+// Add a convex shape and a triangle of a concave shape to be tested during narrow-phase collision detection into the batch
+/// The concave shape is stored in the batch with the reference of the triangle. The narrow-phase
+/// algorithms read the vertices and normals of the triangle from the concave shape.
+RP3D_FORCE_INLINE void NarrowPhaseInput::addNarrowPhaseTriangleTest(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1, CollisionShape* shape2,
+                                          const Transform& shape1Transform, const Transform& shape2Transform, const TriangleReference& triangle,
+                                          NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts, LastFrameCollisionInfo* lastFrameInfo) {
+
+    mNbTriangleTests++;
+
+    addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, triangle,
+                       narrowPhaseAlgorithmType, reportContacts, lastFrameInfo);
+}
+
+// Add a test into the batch of the narrow-phase algorithm
+RP3D_FORCE_INLINE void NarrowPhaseInput::addNarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1, CollisionShape* shape2,
+                                          const Transform& shape1Transform, const Transform& shape2Transform, const TriangleReference& triangle,
+                                          NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts, LastFrameCollisionInfo* lastFrameInfo) {
 
     switch (narrowPhaseAlgorithmType) {
         case NarrowPhaseAlgorithmType::SphereVsSphere:
-            mSphereVsSphereBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mSphereVsSphereBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, triangle, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::SphereVsCapsule:
-            mSphereVsCapsuleBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mSphereVsCapsuleBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, triangle, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::CapsuleVsCapsule:
-            mCapsuleVsCapsuleBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mCapsuleVsCapsuleBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, triangle, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::SphereVsConvexPolyhedron:
-            mSphereVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mSphereVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, triangle, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::CapsuleVsConvexPolyhedron:
-            mCapsuleVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mCapsuleVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, triangle, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedron:
-            mConvexPolyhedronVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mConvexPolyhedronVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, triangle, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::None:
             // Must never happen
@@ -88,6 +88,9 @@ class AABB {
         /// Return the volume of the AABB
         decimal getVolume() const;
 
+        /// Return the surface area of the AABB
+        decimal getSurfaceArea() const;
+
         /// Merge the AABB in parameter with the current one
         void mergeWithAABB(const AABB& aabb);
 
@@ -112,6 +115,9 @@ class AABB {
         /// Apply a scale factor to the AABB
         void applyScale(const Vector3& scale);
 
+        /// Apply a transform to the AABB (the result bounds the transformed box)
+        void applyTransform(const Transform& transform);
+
         /// Create and return an AABB for a triangle
         static AABB createAABBForTriangle(const Vector3* trianglePoints);
 
@@ -174,6 +180,12 @@ RP3D_FORCE_INLINE decimal AABB::getVolume() const {
     return (diff.x * diff.y * diff.z);
 }
 
+// Return the surface area of the AABB
+RP3D_FORCE_INLINE decimal AABB::getSurfaceArea() const {
+    const Vector3 diff = mMaxCoordinates - mMinCoordinates;
+    return decimal(2.0) * (diff.x * diff.y + diff.y * diff.z + diff.z * diff.x);
+}
+
 // Return true if the AABB of a triangle intersects the AABB
 RP3D_FORCE_INLINE bool AABB::testCollisionTriangleAABB(const Vector3* trianglePoints) const {
 
@@ -202,6 +214,18 @@ RP3D_FORCE_INLINE void AABB::applyScale(const Vector3& scale) {
     mMaxCoordinates = mMaxCoordinates * scale;
 }
 
+// Apply a transform to the AABB (the result bounds the transformed box)
+RP3D_FORCE_INLINE void AABB::applyTransform(const Transform& transform) {
+
+    const Vector3 center = transform * getCenter();
+    const Vector3 halfExtent = decimal(0.5) * getExtent();
+    const Matrix3x3 absRotation = transform.getOrientation().getMatrix().getAbsoluteMatrix();
+    const Vector3 newHalfExtent = absRotation * halfExtent;
+
+    mMinCoordinates = center - newHalfExtent;
+    mMaxCoordinates = center + newHalfExtent;
+}
+
 // Merge the AABB in parameter with the current one
 RP3D_FORCE_INLINE void AABB::mergeWithAABB(const AABB& aabb) {
     mMinCoordinates.x = std::min(mMinCoordinates.x, aabb.mMinCoordinates.x);
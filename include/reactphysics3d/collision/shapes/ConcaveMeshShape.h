@@ -142,9 +142,6 @@ class ConcaveMeshShape : public ConcaveShape {
         /// if the user did not provide its own vertices normals)
         Vector3** mComputedVerticesNormals;
 
-        /// Reference to the triangle half-edge structure
-        HalfEdgeStructure& mTriangleHalfEdgeStructure;
-
         // -------------------- Methods -------------------- //
 
         /// Constructor
@@ -173,6 +170,14 @@ class ConcaveMeshShape : public ConcaveShape {
                                                  Array<Vector3> &triangleVerticesNormals, Array<uint32>& shapeIds,
                                                  MemoryAllocator& allocator) const override;
 
+        /// Compute the references to the triangles of the mesh that are overlapping with the AABB in parameter
+        virtual void computeOverlappingTriangleReferences(const AABB& localAABB, Array<TriangleReference>& outTriangles,
+                                                          MemoryAllocator& allocator) const override;
+
+        /// Return the three vertices and the three vertices normals of a triangle of the mesh
+        virtual void getTriangleVerticesAndNormals(const TriangleReference& triangle, Vector3* outTriangleVertices,
+                                                   Vector3* outVerticesNormals) const override;
+
         /// Destructor
         virtual ~ConcaveMeshShape() override = default;
 
@@ -50,6 +50,30 @@ class TriangleCallback {
 
 };
 
+// Struct TriangleReference
+/**
+ * This structure refers to a triangle of a concave shape without storing its vertices. The
+ * triangle is given by a part of the shape (a sub-part of a concave mesh or a grid cell of a
+ * height-field) and the index of the triangle in this part.
+ */
+struct TriangleReference {
+
+    /// Index of the part of the concave shape that contains the triangle
+    uint32 part;
+
+    /// Index of the triangle in its part
+    uint32 triangleIndex;
+
+    /// Identifier of the triangle inside the concave shape
+    uint32 shapeId;
+
+    /// Constructor
+    TriangleReference(uint32 part = 0, uint32 triangleIndex = 0, uint32 shapeId = 0)
+        : part(part), triangleIndex(triangleIndex), shapeId(shapeId) {
+
+    }
+};
+
 
 // Class ConcaveShape
 /**
@@ -68,6 +92,9 @@ class ConcaveShape : public CollisionShape {
         /// Scale of the shape
         Vector3 mScale;
 
+        /// Reference to the half-edge structure of the triangles
+        HalfEdgeStructure& mTriangleHalfEdgeStructure;
+
         // -------------------- Methods -------------------- //
 
         /// Return true if a point is inside the collision shape
@@ -78,7 +105,8 @@ class ConcaveShape : public CollisionShape {
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        ConcaveShape(CollisionShapeName name, MemoryAllocator& allocator, const Vector3& scaling);
+        ConcaveShape(CollisionShapeName name, MemoryAllocator& allocator, HalfEdgeStructure& triangleHalfEdgeStructure,
+                     const Vector3& scaling);
 
         /// Destructor
         virtual ~ConcaveShape() override = default;
@@ -115,6 +143,17 @@ class ConcaveShape : public CollisionShape {
                                                  Array<Vector3>& triangleVerticesNormals, Array<uint32>& shapeIds,
                                                  MemoryAllocator& allocator) const=0;
 
+        /// Compute the references to the triangles of the shape that are overlapping with an AABB
+        virtual void computeOverlappingTriangleReferences(const AABB& localAABB, Array<TriangleReference>& outTriangles,
+                                                          MemoryAllocator& allocator) const=0;
+
+        /// Return the three vertices and the three vertices normals of a triangle of the shape
+        virtual void getTriangleVerticesAndNormals(const TriangleReference& triangle, Vector3* outTriangleVertices,
+                                                   Vector3* outVerticesNormals) const=0;
+
+        /// Construct the triangle shape of a triangle of the shape in a given memory location
+        TriangleShape* constructTriangleShape(void* memory, const TriangleReference& triangle, MemoryAllocator& allocator) const;
+
         /// Compute and return the volume of the collision shape
         virtual decimal getVolume() const override;
 };
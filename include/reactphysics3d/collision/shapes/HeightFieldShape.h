@@ -91,9 +91,6 @@ class HeightFieldShape : public ConcaveShape {
         /// Local AABB of the height field (without scaling)
         AABB mAABB;
 
-        /// Reference to the half-edge structure
-        HalfEdgeStructure& mTriangleHalfEdgeStructure;
-
         // -------------------- Methods -------------------- //
 
         /// Constructor
@@ -120,6 +117,9 @@ class HeightFieldShape : public ConcaveShape {
         /// Compute the min/max grid coords corresponding to the intersection of the AABB of the height field and the AABB to collide
         void computeMinMaxGridCoordinates(int* minCoords, int* maxCoords, const AABB& aabbToCollide) const;
 
+        /// Compute the range of grid points of the height field whose cells overlap with an AABB
+        void computeOverlappingGridRange(const AABB& localAABB, int& iMin, int& iMax, int& jMin, int& jMax) const;
+
         /// Compute the shape Id for a given triangle
         uint32 computeTriangleShapeId(uint32 iIndex, uint32 jIndex, uint32 secondTriangleIncrement) const;
 
@@ -160,6 +160,14 @@ class HeightFieldShape : public ConcaveShape {
                                                    Array<Vector3>& triangleVerticesNormals, Array<uint32>& shapeIds,
                                                    MemoryAllocator& allocator) const override;
 
+        /// Compute the references to the triangles of the height field that are overlapping with an AABB
+        virtual void computeOverlappingTriangleReferences(const AABB& localAABB, Array<TriangleReference>& outTriangles,
+                                                          MemoryAllocator& allocator) const override;
+
+        /// Return the three vertices and the three vertices normals of a triangle of the height field
+        virtual void getTriangleVerticesAndNormals(const TriangleReference& triangle, Vector3* outTriangleVertices,
+                                                   Vector3* outVerticesNormals) const override;
+
         /// Return the string representation of the shape
         virtual std::string to_string() const override;
 
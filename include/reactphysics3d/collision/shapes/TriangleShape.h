@@ -186,7 +186,8 @@ class TriangleShape : public ConvexPolyhedronShape {
         friend class TriangleOverlapCallback;
         friend class MiddlePhaseTriangleCallback;
         friend class HeightFieldShape;
-        friend class CollisionDetectionSystem;
+        friend class ConcaveShape;
+        friend class NarrowPhaseConvexShapes;
 };
 
 // Return the number of bytes used by the collision shape
@@ -63,6 +63,10 @@ class CollisionBodyComponents : public Components {
         /// Array of boolean values to know if the body is active.
         bool* mIsActive;
 
+        /// Array of boolean values to know if the colliders of the body are grouped under a
+        /// single broad-phase proxy (compound mode)
+        bool* mIsCompound;
+
         /// Array of pointers that can be used to attach user data to the body
         void** mUserData;
 
@@ -122,6 +126,12 @@ class CollisionBodyComponents : public Components {
         /// Set the value to know if the body is active
         void setIsActive(Entity bodyEntity, bool isActive) const;
 
+        /// Return true if the body is in compound mode
+        bool getIsCompound(Entity bodyEntity) const;
+
+        /// Set the value to know if the body is in compound mode
+        void setIsCompound(Entity bodyEntity, bool isCompound) const;
+
         /// Return the user data associated with the body
         void* getUserData(Entity bodyEntity) const;
 
@@ -177,6 +187,22 @@ RP3D_FORCE_INLINE void CollisionBodyComponents::setIsActive(Entity bodyEntity, b
     mIsActive[mMapEntityToComponentIndex[bodyEntity]] = isActive;
 }
 
+// Return true if the body is in compound mode
+RP3D_FORCE_INLINE bool CollisionBodyComponents::getIsCompound(Entity bodyEntity) const {
+
+    assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+
+    return mIsCompound[mMapEntityToComponentIndex[bodyEntity]];
+}
+
+// Set the value to know if the body is in compound mode
+RP3D_FORCE_INLINE void CollisionBodyComponents::setIsCompound(Entity bodyEntity, bool isCompound) const {
+
+    assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+
+    mIsCompound[mMapEntityToComponentIndex[bodyEntity]] = isCompound;
+}
+
 // Return the user data associated with the body
 RP3D_FORCE_INLINE void* CollisionBodyComponents::getUserData(Entity bodyEntity) const {
 
@@ -29,7 +29,9 @@
 // Libraries
 #include <reactphysics3d/configuration.h>
 #include <reactphysics3d/engine/Entity.h>
-#include <reactphysics3d/containers/Map.h>
+#include <reactphysics3d/containers/OpenAddressingMap.h>
+#include <reactphysics3d/containers/Array.h>
+#include <cstdint>
 
 // ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -52,6 +54,9 @@ class Components {
         /// Number of components to allocated at the beginning
         const uint32 INIT_NB_ALLOCATED_COMPONENTS = 10;
 
+        /// Alignment (in bytes) of each array of components data (size of a cache line)
+        static const size_t COMPONENT_DATA_ALIGNMENT = 64;
+
         // -------------------- Attributes -------------------- //
 
         /// Memory allocator
@@ -63,14 +68,20 @@ class Components {
         /// Size (in bytes) of a single component
         size_t mComponentDataSize;
 
+        /// Number of arrays of data in a component
+        uint32 mNbComponentArrays;
+
         /// Number of allocated components
         uint32 mNbAllocatedComponents;
 
+        /// Largest number of components so far
+        uint32 mPeakNbComponents;
+
         /// Allocated memory for all the data of the components
         void* mBuffer;
 
         /// Map an entity to the index of its component in the array
-        Map<Entity, uint32> mMapEntityToComponentIndex;
+        LookupMap<Entity, uint32> mMapEntityToComponentIndex;
 
         /// Index of the first component of a disabled (sleeping or inactive) entity
         /// Disabled components are stored at the end of the components array
@@ -79,6 +90,13 @@ class Components {
         /// Compute the index where we need to insert the new component
         uint32 prepareAddComponent(bool isSleeping);
 
+        /// Return the size (in bytes) of the buffer for a given number of components
+        size_t computeBufferSize(uint32 nbComponents) const;
+
+        /// Return the first location after a given one that is aligned for an array of components data
+        template<typename T>
+        static T* alignComponentData(void* location);
+
         /// Allocate memory for a given number of components
         virtual void allocate(uint32 nbComponentsToAllocate)=0;
 
@@ -96,7 +114,7 @@ class Components {
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        Components(MemoryAllocator& allocator, size_t componentDataSize);
+        Components(MemoryAllocator& allocator, size_t componentDataSize, uint32 nbComponentArrays);
 
         /// Destructor
         virtual ~Components();
@@ -104,6 +122,18 @@ class Components {
         /// Remove a component
         void removeComponent(Entity entity);
 
+        /// Make sure there is enough allocated memory for a given number of components
+        void reserve(uint32 nbComponents);
+
+        /// Release the memory that is not used by the current components
+        void shrinkToFit();
+
+        /// Reorder the components to follow the order of an array of entities
+        void sortComponents(const Array<Entity>& entities);
+
+        /// Return the memory usage of the components
+        MemoryUsage getMemoryUsage() const;
+
         /// Return true if an entity is disabled
         bool getIsEntityDisabled(Entity entity) const;
 
@@ -126,6 +156,20 @@ class Components {
         uint32 getEntityIndex(Entity entity) const;
 };
 
+// Return the size (in bytes) of the buffer for a given number of components
+/// Each array of data starts on a cache line so we need some padding between the arrays.
+RP3D_FORCE_INLINE size_t Components::computeBufferSize(uint32 nbComponents) const {
+    return nbComponents * mComponentDataSize + (mNbComponentArrays - 1) * (COMPONENT_DATA_ALIGNMENT - 1);
+}
+
+// Return the first location after a given one that is aligned for an array of components data
+template<typename T>
+RP3D_FORCE_INLINE T* Components::alignComponentData(void* location) {
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(location);
+    const std::uintptr_t alignedAddress = (address + COMPONENT_DATA_ALIGNMENT - 1) & ~static_cast<std::uintptr_t>(COMPONENT_DATA_ALIGNMENT - 1);
+    return reinterpret_cast<T*>(alignedAddress);
+}
+
 // Return true if an entity is sleeping
 RP3D_FORCE_INLINE bool Components::getIsEntityDisabled(Entity entity) const {
     assert(hasComponent(entity));
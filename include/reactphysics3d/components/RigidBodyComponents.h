@@ -142,15 +142,12 @@ class RigidBodyComponents : public Components {
         /// True if the gravity needs to be applied to this component
         bool* mIsGravityEnabled;
 
-        /// Array with the boolean value to know if the body has already been added into an island
-        bool* mIsAlreadyInIsland;
+        /// For each body, index of the persistent island the body belongs to (NO_ISLAND for static bodies)
+        uint32* mIslandIds;
 
         /// For each body, the array of joints entities the body is part of
         Array<Entity>* mJoints;
 
-        /// For each body, the array of the indices of contact pairs in which the body is involved
-        Array<uint>* mContactPairs;
-
         /// For each body, the vector of lock translation vectors
         Vector3* mLinearLockAxisFactors;
 
@@ -315,8 +312,8 @@ class RigidBodyComponents : public Components {
         /// Return true if gravity is enabled for this entity
         bool getIsGravityEnabled(Entity bodyEntity) const;
 
-        /// Return true if the entity is already in an island
-        bool getIsAlreadyInIsland(Entity bodyEntity) const;
+        /// Return the index of the persistent island of an entity
+        uint32 getIslandId(Entity bodyEntity) const;
 
         /// Return the lock translation factor
         const Vector3& getLinearLockAxisFactor(Entity bodyEntity) const;
@@ -351,8 +348,8 @@ class RigidBodyComponents : public Components {
         /// Set the value to know if the gravity is enabled for this entity
         void setIsGravityEnabled(Entity bodyEntity, bool isGravityEnabled);
 
-        /// Set the value to know if the entity is already in an island
-        void setIsAlreadyInIsland(Entity bodyEntity, bool isAlreadyInIsland);
+        /// Set the index of the persistent island of an entity
+        void setIslandId(Entity bodyEntity, uint32 islandId);
 
         /// Set the linear lock axis factor
         void setLinearLockAxisFactor(Entity bodyEntity, const Vector3& linearLockAxisFactor);
@@ -369,9 +366,6 @@ class RigidBodyComponents : public Components {
         /// Remove a joint from a body component
         void removeJointFromBody(Entity bodyEntity, Entity jointEntity);
 
-        /// A an associated contact pairs into the contact pairs array of the body
-        void addContacPair(Entity bodyEntity, uint32 contactPairIndex);
-
         // -------------------- Friendship -------------------- //
 
         friend class PhysicsWorld;
@@ -764,12 +758,12 @@ RP3D_FORCE_INLINE bool RigidBodyComponents::getIsGravityEnabled(Entity bodyEntit
    return mIsGravityEnabled[mMapEntityToComponentIndex[bodyEntity]];
 }
 
-// Return true if the entity is already in an island
-RP3D_FORCE_INLINE bool RigidBodyComponents::getIsAlreadyInIsland(Entity bodyEntity) const {
+// Return the index of the persistent island of an entity
+RP3D_FORCE_INLINE uint32 RigidBodyComponents::getIslandId(Entity bodyEntity) const {
 
    assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
 
-   return mIsAlreadyInIsland[mMapEntityToComponentIndex[bodyEntity]];
+   return mIslandIds[mMapEntityToComponentIndex[bodyEntity]];
 }
 
 
@@ -797,11 +791,11 @@ RP3D_FORCE_INLINE void RigidBodyComponents::setIsGravityEnabled(Entity bodyEntit
    mIsGravityEnabled[mMapEntityToComponentIndex[bodyEntity]] = isGravityEnabled;
 }
 
-// Set the value to know if the entity is already in an island
-RP3D_FORCE_INLINE void RigidBodyComponents::setIsAlreadyInIsland(Entity bodyEntity, bool isAlreadyInIsland) {
+// Set the index of the persistent island of an entity
+RP3D_FORCE_INLINE void RigidBodyComponents::setIslandId(Entity bodyEntity, uint32 islandId) {
 
    assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
-   mIsAlreadyInIsland[mMapEntityToComponentIndex[bodyEntity]] = isAlreadyInIsland;
+   mIslandIds[mMapEntityToComponentIndex[bodyEntity]] = islandId;
 }
 
 // Set the linear lock axis factor
@@ -839,13 +833,6 @@ RP3D_FORCE_INLINE void RigidBodyComponents::removeJointFromBody(Entity bodyEntit
     mJoints[mMapEntityToComponentIndex[bodyEntity]].remove(jointEntity);
 }
 
-// A an associated contact pairs into the contact pairs array of the body
-RP3D_FORCE_INLINE void RigidBodyComponents::addContacPair(Entity bodyEntity, uint32 contactPairIndex) {
-
-    assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
-    mContactPairs[mMapEntityToComponentIndex[bodyEntity]].add(contactPairIndex);
-}
-
 }
 
 #endif
@@ -278,6 +278,35 @@ class Array {
             mCapacity = capacity;
         }
 
+        /// Release the memory that is not used by the elements of the array
+        void shrinkToFit() {
+
+            if (mSize == mCapacity) return;
+
+            if (mSize == 0) {
+                clear(true);
+                return;
+            }
+
+            // Allocate memory for the elements of the array
+            T* destination = static_cast<T*>(mAllocator.allocate(mSize * sizeof(T)));
+            assert(destination != nullptr);
+
+            // Copy the elements to the new allocated memory location
+            std::uninitialized_copy(mBuffer, mBuffer + mSize, destination);
+
+            // Destruct the previous items
+            for (uint64 i=0; i<mSize; i++) {
+                mBuffer[i].~T();
+            }
+
+            // Release the previously allocated memory
+            mAllocator.release(mBuffer, mCapacity * sizeof(T));
+
+            mBuffer = destination;
+            mCapacity = mSize;
+        }
+
         /// Add an element into the array
         void add(const T& element) {
 
@@ -431,6 +460,16 @@ class Array {
             return mCapacity;
         }
 
+        /// Return the size (in bytes) of the memory allocated by the array
+        size_t getAllocatedMemorySize() const {
+            return static_cast<size_t>(mCapacity) * sizeof(T);
+        }
+
+        /// Return the size (in bytes) of the memory used by the elements of the array
+        size_t getUsedMemorySize() const {
+            return static_cast<size_t>(mSize) * sizeof(T);
+        }
+
         /// Overloaded index operator
         T& operator[](const uint64 index) {
            assert(index >= 0 && index < mSize);
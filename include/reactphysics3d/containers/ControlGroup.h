@@ -0,0 +1,192 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_CONTROL_GROUP_H
+#define REACTPHYSICS3D_CONTROL_GROUP_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <cstddef>
+#include <cassert>
+
+// Use SSE2 instructions to match a group of control bytes when they are available
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define RP3D_CONTROL_GROUP_SSE2
+    #include <emmintrin.h>
+#endif
+
+#if defined(RP3D_COMPILER_VISUAL_STUDIO)
+    #include <intrin.h>
+#endif
+
+namespace reactphysics3d {
+
+// Class ControlGroup
+/**
+ * This class contains the control bytes operations of the open-addressing hash tables
+ * (OpenAddressingMap and OpenAddressingSet). Each slot of those tables has a control byte that
+ * is either EMPTY, DELETED or contains the 7 low bits of the hash of the key stored in the slot.
+ * The slots are probed by groups of GROUP_SIZE control bytes and all the control bytes of a
+ * group are compared with a single SIMD instruction (when SSE2 is available). The result of a
+ * match is a bit mask where bit i is set if the control byte i of the group matches.
+ */
+class ControlGroup {
+
+    public:
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of control bytes in a group
+        static constexpr uint32 GROUP_SIZE = 16;
+
+        /// Control byte of an empty slot
+        static constexpr int8 EMPTY = -128;
+
+        /// Control byte of a slot whose item has been removed (tombstone)
+        static constexpr int8 DELETED = -2;
+
+        // -------------------- Methods -------------------- //
+
+        /// Return a well distributed hash from the hash code of a key
+        static uint64 mixHash(size_t hashCode) {
+
+            // Some hash functions (std::hash of integers for instance) return the key itself.
+            // We need the bits of the hash to be well distributed because the low bits are
+            // stored in the control bytes and the high bits select the group to probe
+            uint64 hash = static_cast<uint64>(hashCode) * 0x9E3779B97F4A7C15ull;
+            return hash ^ (hash >> 32);
+        }
+
+        /// Return the part of the hash that selects the first group to probe
+        static uint64 h1(uint64 hash) {
+            return hash >> 7;
+        }
+
+        /// Return the part of the hash that is stored in the control byte of a slot
+        static int8 h2(uint64 hash) {
+            return static_cast<int8>(hash & 0x7F);
+        }
+
+        /// Return true if a control byte is the one of a slot that contains an item
+        static bool isFull(int8 control) {
+            return control >= 0;
+        }
+
+        /// Return the bit mask of the control bytes of a group that are equal to a given hash part
+        static uint32 match(const int8* group, int8 h2) {
+
+#ifdef RP3D_CONTROL_GROUP_SSE2
+            const __m128i controls = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+            return static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8(h2))));
+#else
+            uint32 mask = 0;
+            for (uint32 i=0; i < GROUP_SIZE; i++) {
+                mask |= static_cast<uint32>(group[i] == h2) << i;
+            }
+            return mask;
+#endif
+        }
+
+        /// Return the bit mask of the empty control bytes of a group
+        static uint32 matchEmpty(const int8* group) {
+            return match(group, EMPTY);
+        }
+
+        /// Return the bit mask of the empty or deleted control bytes of a group
+        static uint32 matchEmptyOrDeleted(const int8* group) {
+
+#ifdef RP3D_CONTROL_GROUP_SSE2
+            const __m128i controls = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+            return static_cast<uint32>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), controls)));
+#else
+            uint32 mask = 0;
+            for (uint32 i=0; i < GROUP_SIZE; i++) {
+                mask |= static_cast<uint32>(group[i] < -1) << i;
+            }
+            return mask;
+#endif
+        }
+
+        /// Return the bit mask of the control bytes of a group whose slots contain an item
+        static uint32 matchFull(const int8* group) {
+
+#ifdef RP3D_CONTROL_GROUP_SSE2
+            const __m128i controls = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+            return static_cast<uint32>(~_mm_movemask_epi8(controls)) & 0xFFFF;
+#else
+            uint32 mask = 0;
+            for (uint32 i=0; i < GROUP_SIZE; i++) {
+                mask |= static_cast<uint32>(group[i] >= 0) << i;
+            }
+            return mask;
+#endif
+        }
+
+        /// Return the index of the lowest bit set in a non-zero bit mask
+        static uint32 lowestBitIndex(uint32 mask) {
+
+            assert(mask != 0);
+
+#if defined(RP3D_COMPILER_VISUAL_STUDIO)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<uint32>(index);
+#elif defined(RP3D_COMPILER_GCC) || defined(RP3D_COMPILER_CLANG)
+            return static_cast<uint32>(__builtin_ctz(mask));
+#else
+            uint32 index = 0;
+            while ((mask & 1) == 0) {
+                mask >>= 1;
+                index++;
+            }
+            return index;
+#endif
+        }
+
+        /// Return the maximum number of items in a table with a given number of slots (7/8 load factor)
+        static uint64 getMaxNbItems(uint64 nbSlots) {
+            return nbSlots - nbSlots / 8;
+        }
+
+        /// Return true if a full table needs more slots or false if rehashing it with the same number of
+        /// slots (to remove its deleted slots) leaves enough empty slots for the next insertions
+        static bool needToGrow(uint64 nbItems, uint64 nbSlots) {
+            return nbItems * 32 > nbSlots * 25;
+        }
+
+        /// Return the smallest number of slots (power of two) of a table that can hold a given number of items
+        static uint64 computeNbSlots(uint64 nbItems) {
+
+            uint64 nbSlots = GROUP_SIZE;
+            while (getMaxNbItems(nbSlots) < nbItems) {
+                nbSlots *= 2;
+            }
+            return nbSlots;
+        }
+};
+
+}
+
+#endif
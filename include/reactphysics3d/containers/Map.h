@@ -343,6 +343,82 @@ class Map {
             assert(mFreeIndex != INVALID_INDEX);
         }
 
+        /// Release the memory that is not needed by the current number of elements
+        /// (the entries are packed at the beginning of the new memory)
+        void shrinkToFit() {
+
+            if (mNbEntries == 0) {
+                clear(true);
+                return;
+            }
+
+            // Compute the smallest hash size that can hold the current entries
+            uint64 capacity = 16;
+            while (static_cast<uint64>(capacity * double(DEFAULT_LOAD_FACTOR)) < mNbEntries) {
+                capacity *= 2;
+            }
+
+            if (capacity >= mHashSize) return;
+
+            // Allocate memory for the buckets and the entries
+            uint64* newBuckets = static_cast<uint64*>(mAllocator.allocate(capacity * sizeof(uint64)));
+            const uint64 nbAllocatedEntries = static_cast<uint64>(capacity * double(DEFAULT_LOAD_FACTOR));
+            Pair<K, V>* newEntries = static_cast<Pair<K, V>*>(mAllocator.allocate(nbAllocatedEntries * sizeof(Pair<K, V>)));
+            uint64* newNextEntries = static_cast<uint64*>(mAllocator.allocate(nbAllocatedEntries * sizeof(uint64)));
+
+            assert(newEntries != nullptr);
+            assert(newNextEntries != nullptr);
+
+            // Initialize the new buckets
+            for (uint64 i=0; i<capacity; i++) {
+                newBuckets[i] = INVALID_INDEX;
+            }
+
+            // Move the entries at the beginning of the new entries array
+            uint64 newEntryIndex = 0;
+            for (uint64 i=0; i<mHashSize; i++) {
+
+                uint64 entryIndex = mBuckets[i];
+                while(entryIndex != INVALID_INDEX) {
+
+                    // Get the corresponding bucket
+                    const size_t hashCode = Hash()(mEntries[entryIndex].first);
+                    const size_t divider = capacity - 1;
+                    const uint64 bucketIndex = static_cast<uint64>(hashCode & divider);
+
+                    newNextEntries[newEntryIndex] = newBuckets[bucketIndex];
+                    newBuckets[bucketIndex] = newEntryIndex;
+
+                    // Copy the entry to the new location and destroy the previous one
+                    new (newEntries + newEntryIndex) Pair<K, V>(mEntries[entryIndex]);
+                    mEntries[entryIndex].~Pair<K,V>();
+
+                    newEntryIndex++;
+                    entryIndex = mNextEntries[entryIndex];
+                }
+            }
+
+            assert(newEntryIndex == mNbEntries);
+
+            // Release previously allocated memory
+            mAllocator.release(mBuckets, mHashSize * sizeof(uint64));
+            mAllocator.release(mEntries, mNbAllocatedEntries * sizeof(Pair<K, V>));
+            mAllocator.release(mNextEntries, mNbAllocatedEntries * sizeof(uint64));
+
+            // Add the remaining entries to the free list
+            mFreeIndex = INVALID_INDEX;
+            for (uint64 i=nbAllocatedEntries; i > mNbEntries; i--) {
+                newNextEntries[i - 1] = mFreeIndex;
+                mFreeIndex = i - 1;
+            }
+
+            mHashSize = capacity;
+            mNbAllocatedEntries = nbAllocatedEntries;
+            mBuckets = newBuckets;
+            mEntries = newEntries;
+            mNextEntries = newNextEntries;
+        }
+
         /// Return true if the map contains an item with the given key
         bool containsKey(const K& key) const {
             return findEntry(key) != INVALID_INDEX;
@@ -517,6 +593,7 @@ class Map {
 
                 mNbAllocatedEntries = 0;
                 mHashSize = 0;
+                mFreeIndex = INVALID_INDEX;
             }
 
             mNbEntries = 0;
@@ -532,6 +609,16 @@ class Map {
             return mHashSize;
         }
 
+        /// Return the size (in bytes) of the memory allocated by the map
+        size_t getAllocatedMemorySize() const {
+            return static_cast<size_t>(mHashSize) * sizeof(uint64) + static_cast<size_t>(mNbAllocatedEntries) * (sizeof(Pair<K, V>) + sizeof(uint64));
+        }
+
+        /// Return the size (in bytes) of the memory used by the buckets and the entries of the map
+        size_t getUsedMemorySize() const {
+            return static_cast<size_t>(mHashSize) * sizeof(uint64) + static_cast<size_t>(mNbEntries) * (sizeof(Pair<K, V>) + sizeof(uint64));
+        }
+
         /// Try to find an item of the map given a key.
         /// The method returns an iterator to the found item or
         /// an iterator pointing to the end if not found
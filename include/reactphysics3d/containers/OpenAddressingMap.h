@@ -0,0 +1,614 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_OPEN_ADDRESSING_MAP_H
+#define REACTPHYSICS3D_OPEN_ADDRESSING_MAP_H
+
+// Libraries
+#include <reactphysics3d/memory/MemoryAllocator.h>
+#include <reactphysics3d/mathematics/mathematics_functions.h>
+#include <reactphysics3d/containers/Pair.h>
+#include <reactphysics3d/containers/Map.h>
+#include <reactphysics3d/containers/ControlGroup.h>
+#include <cstring>
+#include <stdexcept>
+#include <functional>
+#include <limits>
+
+namespace reactphysics3d {
+
+// Class OpenAddressingMap
+/**
+ * This class represents a generic associative map implemented with an open-addressing
+ * hash table. It has the same interface as the Map class. The key/value pairs are stored
+ * directly in the slots of the table and each slot has a control byte with 7 bits of the
+ * hash of its key. A lookup compares the control bytes of a whole group of slots at once
+ * and only compares the keys of the slots whose control byte matches. Therefore, a lookup
+ * does not follow a chain of entries and does not recompute the hash of the stored keys.
+ * Note that the reserve() method of this map takes the number of items to store and
+ * that the capacity() method returns the number of slots of the table.
+  */
+template<typename K, typename V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class OpenAddressingMap {
+
+    private:
+
+        // -------------------- Constants -------------------- //
+
+        /// Invalid index in the array
+        static constexpr uint64 INVALID_INDEX = -1;
+
+        // -------------------- Attributes -------------------- //
+
+        /// Number of slots of the table (zero or a power of two larger or equal to the group size)
+        uint64 mNbSlots;
+
+        /// Number of items in the map
+        uint64 mNbEntries;
+
+        /// Number of items that can still be inserted into empty slots before the table needs to grow
+        uint64 mNbGrowthLeft;
+
+        /// Array with all the slots (the control bytes are stored in the same memory block after the slots)
+        Pair<K, V>* mSlots;
+
+        /// Array with the control byte of each slot
+        int8* mControls;
+
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        // -------------------- Methods -------------------- //
+
+        /// Return the size (in bytes) of the memory block for a given number of slots
+        static size_t getMemoryBlockSize(uint64 nbSlots) {
+            return static_cast<size_t>(nbSlots) * (sizeof(Pair<K, V>) + sizeof(int8));
+        }
+
+        /// Return the index of the first empty or deleted slot in the probe sequence of a hash
+        static uint64 findInsertSlot(const int8* controls, uint64 nbSlots, uint64 hash) {
+
+            const uint64 groupsMask = nbSlots / ControlGroup::GROUP_SIZE - 1;
+            uint64 group = ControlGroup::h1(hash) & groupsMask;
+
+            for (uint64 step = 1; ; step++) {
+
+                const uint64 firstSlot = group * ControlGroup::GROUP_SIZE;
+                const uint32 mask = ControlGroup::matchEmptyOrDeleted(controls + firstSlot);
+                if (mask != 0) {
+                    return firstSlot + ControlGroup::lowestBitIndex(mask);
+                }
+
+                // Triangular probing (visits all the groups because the number of groups is a power of two)
+                group = (group + step) & groupsMask;
+            }
+        }
+
+        /// Return the index of the slot with a given key or INVALID_INDEX if there is no item with this key
+        uint64 findSlot(const K& key, uint64 hash) const {
+
+            if (mNbSlots > 0) {
+
+                const int8 h2 = ControlGroup::h2(hash);
+                const uint64 groupsMask = mNbSlots / ControlGroup::GROUP_SIZE - 1;
+                uint64 group = ControlGroup::h1(hash) & groupsMask;
+                auto keyEqual = KeyEqual();
+
+                for (uint64 step = 1; ; step++) {
+
+                    const uint64 firstSlot = group * ControlGroup::GROUP_SIZE;
+                    const int8* controls = mControls + firstSlot;
+
+                    // Compare the keys of the slots with a matching control byte
+                    uint32 mask = ControlGroup::match(controls, h2);
+                    while (mask != 0) {
+                        const uint64 slot = firstSlot + ControlGroup::lowestBitIndex(mask);
+                        if (keyEqual(mSlots[slot].first, key)) {
+                            return slot;
+                        }
+                        mask &= mask - 1;
+                    }
+
+                    // An item is never stored after a group that has an empty slot
+                    if (ControlGroup::matchEmpty(controls) != 0) {
+                        return INVALID_INDEX;
+                    }
+
+                    group = (group + step) & groupsMask;
+                }
+            }
+
+            return INVALID_INDEX;
+        }
+
+        /// Return the index of the slot with a given key or INVALID_INDEX if there is no item with this key
+        uint64 findEntry(const K& key) const {
+            return findSlot(key, ControlGroup::mixHash(Hash()(key)));
+        }
+
+        /// Return the index of the first slot with an item starting at a given slot (or the number of slots if none)
+        uint64 findNextFullSlot(uint64 slot) const {
+
+            while (slot < mNbSlots && !ControlGroup::isFull(mControls[slot])) {
+                slot++;
+            }
+
+            return slot;
+        }
+
+        /// Move all the items into a new table with a given number of slots
+        void rehash(uint64 nbSlots) {
+
+            assert(isPowerOfTwo(nbSlots));
+            assert(nbSlots >= ControlGroup::GROUP_SIZE);
+            assert(ControlGroup::getMaxNbItems(nbSlots) >= mNbEntries);
+
+            // Allocate the slots and the control bytes in a single memory block
+            Pair<K, V>* newSlots = static_cast<Pair<K, V>*>(mAllocator.allocate(getMemoryBlockSize(nbSlots)));
+            int8* newControls = reinterpret_cast<int8*>(newSlots + nbSlots);
+            assert(newSlots != nullptr);
+
+            std::memset(newControls, ControlGroup::EMPTY, static_cast<size_t>(nbSlots));
+
+            // Move the items into the new table
+            for (uint64 i=0; i < mNbSlots; i++) {
+
+                if (ControlGroup::isFull(mControls[i])) {
+
+                    const uint64 hash = ControlGroup::mixHash(Hash()(mSlots[i].first));
+                    const uint64 slot = findInsertSlot(newControls, nbSlots, hash);
+
+                    // Copy the item to the new location and destroy the previous one
+                    newControls[slot] = ControlGroup::h2(hash);
+                    new (newSlots + slot) Pair<K, V>(mSlots[i]);
+                    mSlots[i].~Pair<K, V>();
+                }
+            }
+
+            if (mNbSlots > 0) {
+
+                // Release previously allocated memory
+                mAllocator.release(mSlots, getMemoryBlockSize(mNbSlots));
+            }
+
+            mNbSlots = nbSlots;
+            mSlots = newSlots;
+            mControls = newControls;
+            mNbGrowthLeft = ControlGroup::getMaxNbItems(nbSlots) - mNbEntries;
+        }
+
+        /// Copy the table of another map (the current map must not have allocated memory)
+        void copyTable(const OpenAddressingMap& map) {
+
+            assert(mNbSlots == 0);
+
+            mNbSlots = map.mNbSlots;
+            mNbEntries = map.mNbEntries;
+            mNbGrowthLeft = map.mNbGrowthLeft;
+
+            if (mNbSlots > 0) {
+
+                mSlots = static_cast<Pair<K, V>*>(mAllocator.allocate(getMemoryBlockSize(mNbSlots)));
+                mControls = reinterpret_cast<int8*>(mSlots + mNbSlots);
+
+                // Copy the control bytes
+                std::memcpy(mControls, map.mControls, static_cast<size_t>(mNbSlots));
+
+                // Copy the items
+                for (uint64 i=0; i < mNbSlots; i++) {
+                    if (ControlGroup::isFull(mControls[i])) {
+                        new (mSlots + i) Pair<K, V>(map.mSlots[i]);
+                    }
+                }
+            }
+        }
+
+    public:
+
+        /// Class Iterator
+        /**
+         * This class represents an iterator for the OpenAddressingMap.
+         */
+        class Iterator {
+
+            private:
+
+                /// Pointer to the map
+                const OpenAddressingMap* mMap;
+
+                /// Index of the current slot
+                uint64 mCurrentSlotIndex;
+
+                /// Advance the iterator
+                void advance() {
+
+                    assert(mCurrentSlotIndex < mMap->mNbSlots);
+
+                    mCurrentSlotIndex = mMap->findNextFullSlot(mCurrentSlotIndex + 1);
+                }
+
+            public:
+
+                // Iterator traits
+                using value_type = Pair<K,V>;
+                using difference_type = std::ptrdiff_t;
+                using pointer = Pair<K, V>*;
+                using reference = Pair<K,V>&;
+                using iterator_category = std::forward_iterator_tag;
+
+                /// Constructor
+                Iterator() = default;
+
+                /// Constructor
+                Iterator(const OpenAddressingMap* map, uint64 slotIndex)
+                     :mMap(map), mCurrentSlotIndex(slotIndex) {
+
+                }
+
+                /// Deferencable
+                reference operator*() const {
+                    assert(mCurrentSlotIndex < mMap->mNbSlots);
+                    assert(ControlGroup::isFull(mMap->mControls[mCurrentSlotIndex]));
+                    return mMap->mSlots[mCurrentSlotIndex];
+                }
+
+                /// Deferencable
+                pointer operator->() const {
+                    assert(mCurrentSlotIndex < mMap->mNbSlots);
+                    assert(ControlGroup::isFull(mMap->mControls[mCurrentSlotIndex]));
+                    return &(mMap->mSlots[mCurrentSlotIndex]);
+                }
+
+                /// Pre increment (++it)
+                Iterator& operator++() {
+                    advance();
+                    return *this;
+                }
+
+                /// Post increment (it++)
+                Iterator operator++(int) {
+                    Iterator tmp = *this;
+                    advance();
+                    return tmp;
+                }
+
+                /// Equality operator (it == end())
+                bool operator==(const Iterator& iterator) const {
+                    return mCurrentSlotIndex == iterator.mCurrentSlotIndex && mMap == iterator.mMap;
+                }
+
+                /// Inequality operator (it != end())
+                bool operator!=(const Iterator& iterator) const {
+                    return !(*this == iterator);
+                }
+        };
+
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        OpenAddressingMap(MemoryAllocator& allocator, uint64 capacity = 0)
+            : mNbSlots(0), mNbEntries(0), mNbGrowthLeft(0), mSlots(nullptr), mControls(nullptr), mAllocator(allocator) {
+
+            if (capacity > 0) {
+
+               reserve(capacity);
+            }
+        }
+
+        /// Copy constructor
+        OpenAddressingMap(const OpenAddressingMap& map)
+          :mNbSlots(0), mNbEntries(0), mNbGrowthLeft(0), mSlots(nullptr), mControls(nullptr), mAllocator(map.mAllocator) {
+
+            copyTable(map);
+        }
+
+        /// Destructor
+        ~OpenAddressingMap() {
+
+            clear(true);
+        }
+
+        /// Allocate memory for a given number of elements
+        void reserve(uint64 capacity) {
+
+            if (capacity <= ControlGroup::getMaxNbItems(mNbSlots)) return;
+
+            rehash(ControlGroup::computeNbSlots(capacity));
+        }
+
+        /// Release the memory that is not needed by the current number of elements
+        void shrinkToFit() {
+
+            if (mNbEntries == 0) {
+                clear(true);
+                return;
+            }
+
+            const uint64 nbSlots = ControlGroup::computeNbSlots(mNbEntries);
+            if (nbSlots < mNbSlots) {
+                rehash(nbSlots);
+            }
+        }
+
+        /// Return true if the map contains an item with the given key
+        bool containsKey(const K& key) const {
+            return findEntry(key) != INVALID_INDEX;
+        }
+
+        /// Add an element into the map
+        /// Returns true if the item has been inserted and false otherwise.
+        bool add(const Pair<K,V>& keyValue, bool insertIfAlreadyPresent = false) {
+
+            // Compute the hash code of the key
+            const uint64 hash = ControlGroup::mixHash(Hash()(keyValue.first));
+
+            // Check if the item is already in the map
+            const uint64 existingSlot = findSlot(keyValue.first, hash);
+            if (existingSlot != INVALID_INDEX) {
+
+                if (insertIfAlreadyPresent) {
+
+                    // Destruct the previous key/value
+                    mSlots[existingSlot].~Pair<K, V>();
+
+                    // Copy construct the new key/value
+                    new (mSlots + existingSlot) Pair<K,V>(keyValue);
+
+                    return true;
+                }
+                else {
+                    assert(false);
+                    throw std::runtime_error("The key and value pair already exists in the map");
+                }
+            }
+
+            if (mNbSlots == 0) {
+                rehash(ControlGroup::GROUP_SIZE);
+            }
+
+            uint64 slot = findInsertSlot(mControls, mNbSlots, hash);
+
+            // If the item needs an empty slot but the table is full
+            if (mNbGrowthLeft == 0 && mControls[slot] == ControlGroup::EMPTY) {
+
+                // If enough of the used slots are deleted ones, we only need to rehash the
+                // table to remove them. Otherwise, we need to allocate more memory
+                rehash(ControlGroup::needToGrow(mNbEntries, mNbSlots) ? mNbSlots * 2 : mNbSlots);
+
+                slot = findInsertSlot(mControls, mNbSlots, hash);
+            }
+
+            if (mControls[slot] == ControlGroup::EMPTY) {
+                assert(mNbGrowthLeft > 0);
+                mNbGrowthLeft--;
+            }
+
+            mControls[slot] = ControlGroup::h2(hash);
+            new (mSlots + slot) Pair<K, V>(keyValue);
+            mNbEntries++;
+
+            return true;
+        }
+
+        /// Remove the element pointed by some iterator
+        /// This method returns an iterator pointing to the element after
+        /// the one that has been removed
+        Iterator remove(const Iterator& it) {
+
+            const K& key = it->first;
+            return remove(key);
+        }
+
+        /// Remove the element from the map with a given key
+        /// This method returns an iterator pointing to the element after
+        /// the one that has been removed
+        Iterator remove(const K& key) {
+
+            const uint64 slot = findEntry(key);
+            if (slot == INVALID_INDEX) {
+                return end();
+            }
+
+            mSlots[slot].~Pair<K, V>();
+            mNbEntries--;
+
+            // If the group of the slot has an empty slot, no probe sequence goes through this
+            // group and the slot can become empty again. Otherwise, we need to leave a deleted
+            // marker to keep the probe sequences of the items stored after this group
+            const uint64 firstSlotOfGroup = slot & ~static_cast<uint64>(ControlGroup::GROUP_SIZE - 1);
+            if (ControlGroup::matchEmpty(mControls + firstSlotOfGroup) != 0) {
+                mControls[slot] = ControlGroup::EMPTY;
+                mNbGrowthLeft++;
+            }
+            else {
+                mControls[slot] = ControlGroup::DELETED;
+            }
+
+            return Iterator(this, findNextFullSlot(slot + 1));
+        }
+
+        /// Clear the map
+        void clear(bool releaseMemory = false) {
+
+            for (uint64 i=0; i < mNbSlots; i++) {
+                if (ControlGroup::isFull(mControls[i])) {
+
+                    // Destroy the item
+                    mSlots[i].~Pair<K,V>();
+                }
+            }
+
+            if (releaseMemory && mNbSlots > 0) {
+
+                // Release previously allocated memory
+                mAllocator.release(mSlots, getMemoryBlockSize(mNbSlots));
+
+                mSlots = nullptr;
+                mControls = nullptr;
+                mNbSlots = 0;
+            }
+
+            if (mNbSlots > 0) {
+                std::memset(mControls, ControlGroup::EMPTY, static_cast<size_t>(mNbSlots));
+            }
+
+            mNbEntries = 0;
+            mNbGrowthLeft = ControlGroup::getMaxNbItems(mNbSlots);
+       }
+
+        /// Return the number of elements in the map
+        uint64 size() const {
+            return mNbEntries;
+        }
+
+        /// Return the capacity of the map (number of slots of the table)
+        uint64 capacity() const {
+            return mNbSlots;
+        }
+
+        /// Return the size (in bytes) of the memory allocated by the map
+        size_t getAllocatedMemorySize() const {
+            return mNbSlots > 0 ? getMemoryBlockSize(mNbSlots) : 0;
+        }
+
+        /// Return the size (in bytes) of the memory used by the control bytes and the items of the map
+        size_t getUsedMemorySize() const {
+            return static_cast<size_t>(mNbSlots) * sizeof(int8) + static_cast<size_t>(mNbEntries) * sizeof(Pair<K, V>);
+        }
+
+        /// Try to find an item of the map given a key.
+        /// The method returns an iterator to the found item or
+        /// an iterator pointing to the end if not found
+        Iterator find(const K& key) const {
+
+            const uint64 slot = findEntry(key);
+
+            if (slot == INVALID_INDEX) {
+                return end();
+            }
+
+            return Iterator(this, slot);
+        }
+
+        /// Overloaded index operator
+        V& operator[](const K& key) {
+
+            const uint64 slot = findEntry(key);
+
+            if (slot == INVALID_INDEX) {
+                assert(false);
+                throw std::runtime_error("No item with given key has been found in the map");
+            }
+
+            return mSlots[slot].second;
+        }
+
+        /// Overloaded index operator
+        const V& operator[](const K& key) const {
+
+            const uint64 slot = findEntry(key);
+
+            if (slot == INVALID_INDEX) {
+                assert(false);
+                throw std::runtime_error("No item with given key has been found in the map");
+            }
+
+            return mSlots[slot].second;
+        }
+
+        /// Overloaded equality operator
+        bool operator==(const OpenAddressingMap& map) const {
+
+            if (size() != map.size()) return false;
+
+            for (auto it = begin(); it != end(); ++it) {
+                auto it2 = map.find(it->first);
+                if (it2 == map.end() || it2->second != it->second) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// Overloaded not equal operator
+        bool operator!=(const OpenAddressingMap& map) const {
+
+            return !((*this) == map);
+        }
+
+        /// Overloaded assignment operator
+        OpenAddressingMap& operator=(const OpenAddressingMap& map) {
+
+            // Check for self assignment
+            if (this != &map) {
+
+                // Clear the map
+                clear(true);
+
+                copyTable(map);
+            }
+
+            return *this;
+        }
+
+        /// Return a begin iterator
+        Iterator begin() const {
+
+            // If the map is empty
+            if (size() == 0) {
+
+                // Return an iterator to the end
+                return end();
+            }
+
+            return Iterator(this, findNextFullSlot(0));
+        }
+
+        /// Return a end iterator
+        Iterator end() const {
+            return Iterator(this, mNbSlots);
+        }
+
+        // ---------- Friendship ---------- //
+
+        friend class Iterator;
+};
+
+// Map used by the engine for its most frequent lookups (entity to component index, pair id to pair index, ...).
+// This is an OpenAddressingMap if the library has been compiled with the RP3D_OPEN_ADDRESSING_MAPS_ENABLED
+// option and a Map otherwise
+#ifdef IS_RP3D_OPEN_ADDRESSING_MAPS_ENABLED
+template<typename K, typename V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+using LookupMap = OpenAddressingMap<K, V, Hash, KeyEqual>;
+#else
+template<typename K, typename V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+using LookupMap = Map<K, V, Hash, KeyEqual>;
+#endif
+
+}
+
+#endif
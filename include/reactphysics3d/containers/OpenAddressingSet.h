@@ -0,0 +1,568 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_OPEN_ADDRESSING_SET_H
+#define REACTPHYSICS3D_OPEN_ADDRESSING_SET_H
+
+// Libraries
+#include <reactphysics3d/memory/MemoryAllocator.h>
+#include <reactphysics3d/mathematics/mathematics_functions.h>
+#include <reactphysics3d/containers/Array.h>
+#include <reactphysics3d/containers/ControlGroup.h>
+#include <cstring>
+#include <stdexcept>
+#include <functional>
+#include <limits>
+
+namespace reactphysics3d {
+
+// Class OpenAddressingSet
+/**
+ * This class represents a simple generic set implemented with an open-addressing hash
+ * table. It has the same interface as the Set class. The values are stored directly in the
+ * slots of the table and each slot has a control byte with 7 bits of the hash of its value
+ * (see the OpenAddressingMap class). Note that the reserve() method of this set takes the
+ * number of items to store and that the capacity() method returns the number of slots of the table.
+  */
+template<typename V, class Hash = std::hash<V>, class KeyEqual = std::equal_to<V>>
+class OpenAddressingSet {
+
+    private:
+
+        // -------------------- Constants -------------------- //
+
+        /// Invalid index in the array
+        static constexpr uint64 INVALID_INDEX = -1;
+
+        // -------------------- Attributes -------------------- //
+
+        /// Number of slots of the table (zero or a power of two larger or equal to the group size)
+        uint64 mNbSlots;
+
+        /// Number of items in the set
+        uint64 mNbEntries;
+
+        /// Number of items that can still be inserted into empty slots before the table needs to grow
+        uint64 mNbGrowthLeft;
+
+        /// Array with all the slots (the control bytes are stored in the same memory block after the slots)
+        V* mSlots;
+
+        /// Array with the control byte of each slot
+        int8* mControls;
+
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        // -------------------- Methods -------------------- //
+
+        /// Return the size (in bytes) of the memory block for a given number of slots
+        static size_t getMemoryBlockSize(uint64 nbSlots) {
+            return static_cast<size_t>(nbSlots) * (sizeof(V) + sizeof(int8));
+        }
+
+        /// Return the index of the first empty or deleted slot in the probe sequence of a hash
+        static uint64 findInsertSlot(const int8* controls, uint64 nbSlots, uint64 hash) {
+
+            const uint64 groupsMask = nbSlots / ControlGroup::GROUP_SIZE - 1;
+            uint64 group = ControlGroup::h1(hash) & groupsMask;
+
+            for (uint64 step = 1; ; step++) {
+
+                const uint64 firstSlot = group * ControlGroup::GROUP_SIZE;
+                const uint32 mask = ControlGroup::matchEmptyOrDeleted(controls + firstSlot);
+                if (mask != 0) {
+                    return firstSlot + ControlGroup::lowestBitIndex(mask);
+                }
+
+                // Triangular probing (visits all the groups because the number of groups is a power of two)
+                group = (group + step) & groupsMask;
+            }
+        }
+
+        /// Return the index of the slot with a given value or INVALID_INDEX if there is no item with this value
+        uint64 findSlot(const V& value, uint64 hash) const {
+
+            if (mNbSlots > 0) {
+
+                const int8 h2 = ControlGroup::h2(hash);
+                const uint64 groupsMask = mNbSlots / ControlGroup::GROUP_SIZE - 1;
+                uint64 group = ControlGroup::h1(hash) & groupsMask;
+                auto keyEqual = KeyEqual();
+
+                for (uint64 step = 1; ; step++) {
+
+                    const uint64 firstSlot = group * ControlGroup::GROUP_SIZE;
+                    const int8* controls = mControls + firstSlot;
+
+                    // Compare the values of the slots with a matching control byte
+                    uint32 mask = ControlGroup::match(controls, h2);
+                    while (mask != 0) {
+                        const uint64 slot = firstSlot + ControlGroup::lowestBitIndex(mask);
+                        if (keyEqual(mSlots[slot], value)) {
+                            return slot;
+                        }
+                        mask &= mask - 1;
+                    }
+
+                    // An item is never stored after a group that has an empty slot
+                    if (ControlGroup::matchEmpty(controls) != 0) {
+                        return INVALID_INDEX;
+                    }
+
+                    group = (group + step) & groupsMask;
+                }
+            }
+
+            return INVALID_INDEX;
+        }
+
+        /// Return the index of the slot with a given value or INVALID_INDEX if there is no item with this value
+        uint64 findEntry(const V& value) const {
+            return findSlot(value, ControlGroup::mixHash(Hash()(value)));
+        }
+
+        /// Return the index of the first slot with an item starting at a given slot (or the number of slots if none)
+        uint64 findNextFullSlot(uint64 slot) const {
+
+            while (slot < mNbSlots && !ControlGroup::isFull(mControls[slot])) {
+                slot++;
+            }
+
+            return slot;
+        }
+
+        /// Move all the items into a new table with a given number of slots
+        void rehash(uint64 nbSlots) {
+
+            assert(isPowerOfTwo(nbSlots));
+            assert(nbSlots >= ControlGroup::GROUP_SIZE);
+            assert(ControlGroup::getMaxNbItems(nbSlots) >= mNbEntries);
+
+            // Allocate the slots and the control bytes in a single memory block
+            V* newSlots = static_cast<V*>(mAllocator.allocate(getMemoryBlockSize(nbSlots)));
+            int8* newControls = reinterpret_cast<int8*>(newSlots + nbSlots);
+            assert(newSlots != nullptr);
+
+            std::memset(newControls, ControlGroup::EMPTY, static_cast<size_t>(nbSlots));
+
+            // Move the items into the new table
+            for (uint64 i=0; i < mNbSlots; i++) {
+
+                if (ControlGroup::isFull(mControls[i])) {
+
+                    const uint64 hash = ControlGroup::mixHash(Hash()(mSlots[i]));
+                    const uint64 slot = findInsertSlot(newControls, nbSlots, hash);
+
+                    // Copy the item to the new location and destroy the previous one
+                    newControls[slot] = ControlGroup::h2(hash);
+                    new (newSlots + slot) V(mSlots[i]);
+                    mSlots[i].~V();
+                }
+            }
+
+            if (mNbSlots > 0) {
+
+                // Release previously allocated memory
+                mAllocator.release(mSlots, getMemoryBlockSize(mNbSlots));
+            }
+
+            mNbSlots = nbSlots;
+            mSlots = newSlots;
+            mControls = newControls;
+            mNbGrowthLeft = ControlGroup::getMaxNbItems(nbSlots) - mNbEntries;
+        }
+
+        /// Copy the table of another set (the current set must not have allocated memory)
+        void copyTable(const OpenAddressingSet& set) {
+
+            assert(mNbSlots == 0);
+
+            mNbSlots = set.mNbSlots;
+            mNbEntries = set.mNbEntries;
+            mNbGrowthLeft = set.mNbGrowthLeft;
+
+            if (mNbSlots > 0) {
+
+                mSlots = static_cast<V*>(mAllocator.allocate(getMemoryBlockSize(mNbSlots)));
+                mControls = reinterpret_cast<int8*>(mSlots + mNbSlots);
+
+                // Copy the control bytes
+                std::memcpy(mControls, set.mControls, static_cast<size_t>(mNbSlots));
+
+                // Copy the items
+                for (uint64 i=0; i < mNbSlots; i++) {
+                    if (ControlGroup::isFull(mControls[i])) {
+                        new (mSlots + i) V(set.mSlots[i]);
+                    }
+                }
+            }
+        }
+
+    public:
+
+        /// Class Iterator
+        /**
+         * This class represents an iterator for the OpenAddressingSet.
+         */
+        class Iterator {
+
+            private:
+
+                /// Pointer to the set
+                const OpenAddressingSet* mSet;
+
+                /// Index of the current slot
+                uint64 mCurrentSlotIndex;
+
+                /// Advance the iterator
+                void advance() {
+
+                    assert(mCurrentSlotIndex < mSet->mNbSlots);
+
+                    mCurrentSlotIndex = mSet->findNextFullSlot(mCurrentSlotIndex + 1);
+                }
+
+            public:
+
+                // Iterator traits
+                using value_type = V;
+                using difference_type = std::ptrdiff_t;
+                using pointer = V*;
+                using reference = V&;
+                using iterator_category = std::forward_iterator_tag;
+
+                /// Constructor
+                Iterator() = default;
+
+                /// Constructor
+                Iterator(const OpenAddressingSet* set, uint64 slotIndex)
+                     :mSet(set), mCurrentSlotIndex(slotIndex) {
+
+                }
+
+                /// Deferencable
+                reference operator*() const {
+                    assert(mCurrentSlotIndex < mSet->mNbSlots);
+                    assert(ControlGroup::isFull(mSet->mControls[mCurrentSlotIndex]));
+                    return mSet->mSlots[mCurrentSlotIndex];
+                }
+
+                /// Deferencable
+                pointer operator->() const {
+                    assert(mCurrentSlotIndex < mSet->mNbSlots);
+                    assert(ControlGroup::isFull(mSet->mControls[mCurrentSlotIndex]));
+                    return &(mSet->mSlots[mCurrentSlotIndex]);
+                }
+
+                /// Pre increment (++it)
+                Iterator& operator++() {
+                    advance();
+                    return *this;
+                }
+
+                /// Post increment (it++)
+                Iterator operator++(int) {
+                    Iterator tmp = *this;
+                    advance();
+                    return tmp;
+                }
+
+                /// Equality operator (it == end())
+                bool operator==(const Iterator& iterator) const {
+                    return mCurrentSlotIndex == iterator.mCurrentSlotIndex && mSet == iterator.mSet;
+                }
+
+                /// Inequality operator (it != end())
+                bool operator!=(const Iterator& iterator) const {
+                    return !(*this == iterator);
+                }
+        };
+
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        OpenAddressingSet(MemoryAllocator& allocator, uint64 capacity = 0)
+            : mNbSlots(0), mNbEntries(0), mNbGrowthLeft(0), mSlots(nullptr), mControls(nullptr), mAllocator(allocator) {
+
+            if (capacity > 0) {
+
+               reserve(capacity);
+            }
+        }
+
+        /// Copy constructor
+        OpenAddressingSet(const OpenAddressingSet& set)
+          :mNbSlots(0), mNbEntries(0), mNbGrowthLeft(0), mSlots(nullptr), mControls(nullptr), mAllocator(set.mAllocator) {
+
+            copyTable(set);
+        }
+
+        /// Destructor
+        ~OpenAddressingSet() {
+
+            clear(true);
+        }
+
+        /// Allocate memory for a given number of elements
+        void reserve(uint64 capacity) {
+
+            if (capacity <= ControlGroup::getMaxNbItems(mNbSlots)) return;
+
+            rehash(ControlGroup::computeNbSlots(capacity));
+        }
+
+        /// Release the memory that is not needed by the current number of elements
+        void shrinkToFit() {
+
+            if (mNbEntries == 0) {
+                clear(true);
+                return;
+            }
+
+            const uint64 nbSlots = ControlGroup::computeNbSlots(mNbEntries);
+            if (nbSlots < mNbSlots) {
+                rehash(nbSlots);
+            }
+        }
+
+        /// Return true if the set contains a given value
+        bool contains(const V& value) const {
+            return findEntry(value) != INVALID_INDEX;
+        }
+
+        /// Add a value into the set.
+        /// Returns true if the item has been inserted and false otherwise.
+        bool add(const V& value) {
+
+            // Compute the hash code of the value
+            const uint64 hash = ControlGroup::mixHash(Hash()(value));
+
+            // Check if the item is already in the set
+            if (findSlot(value, hash) != INVALID_INDEX) {
+                return false;
+            }
+
+            if (mNbSlots == 0) {
+                rehash(ControlGroup::GROUP_SIZE);
+            }
+
+            uint64 slot = findInsertSlot(mControls, mNbSlots, hash);
+
+            // If the item needs an empty slot but the table is full
+            if (mNbGrowthLeft == 0 && mControls[slot] == ControlGroup::EMPTY) {
+
+                // If enough of the used slots are deleted ones, we only need to rehash the
+                // table to remove them. Otherwise, we need to allocate more memory
+                rehash(ControlGroup::needToGrow(mNbEntries, mNbSlots) ? mNbSlots * 2 : mNbSlots);
+
+                slot = findInsertSlot(mControls, mNbSlots, hash);
+            }
+
+            if (mControls[slot] == ControlGroup::EMPTY) {
+                assert(mNbGrowthLeft > 0);
+                mNbGrowthLeft--;
+            }
+
+            mControls[slot] = ControlGroup::h2(hash);
+            new (mSlots + slot) V(value);
+            mNbEntries++;
+
+            return true;
+        }
+
+        /// Remove the element pointed by some iterator
+        /// This method returns an iterator pointing to the element after
+        /// the one that has been removed
+        Iterator remove(const Iterator& it) {
+
+            return remove(*it);
+        }
+
+        /// Remove the element from the set with a given value
+        /// This method returns an iterator pointing to the element after
+        /// the one that has been removed
+        Iterator remove(const V& value) {
+
+            const uint64 slot = findEntry(value);
+            if (slot == INVALID_INDEX) {
+                return end();
+            }
+
+            mSlots[slot].~V();
+            mNbEntries--;
+
+            // If the group of the slot has an empty slot, no probe sequence goes through this
+            // group and the slot can become empty again. Otherwise, we need to leave a deleted
+            // marker to keep the probe sequences of the items stored after this group
+            const uint64 firstSlotOfGroup = slot & ~static_cast<uint64>(ControlGroup::GROUP_SIZE - 1);
+            if (ControlGroup::matchEmpty(mControls + firstSlotOfGroup) != 0) {
+                mControls[slot] = ControlGroup::EMPTY;
+                mNbGrowthLeft++;
+            }
+            else {
+                mControls[slot] = ControlGroup::DELETED;
+            }
+
+            return Iterator(this, findNextFullSlot(slot + 1));
+        }
+
+        /// Clear the set
+        void clear(bool releaseMemory = false) {
+
+            for (uint64 i=0; i < mNbSlots; i++) {
+                if (ControlGroup::isFull(mControls[i])) {
+
+                    // Destroy the item
+                    mSlots[i].~V();
+                }
+            }
+
+            if (releaseMemory && mNbSlots > 0) {
+
+                // Release previously allocated memory
+                mAllocator.release(mSlots, getMemoryBlockSize(mNbSlots));
+
+                mSlots = nullptr;
+                mControls = nullptr;
+                mNbSlots = 0;
+            }
+
+            if (mNbSlots > 0) {
+                std::memset(mControls, ControlGroup::EMPTY, static_cast<size_t>(mNbSlots));
+            }
+
+            mNbEntries = 0;
+            mNbGrowthLeft = ControlGroup::getMaxNbItems(mNbSlots);
+       }
+
+        /// Return the number of elements in the set
+        uint64 size() const {
+            return mNbEntries;
+        }
+
+        /// Return the capacity of the set (number of slots of the table)
+        uint64 capacity() const {
+            return mNbSlots;
+        }
+
+        /// Return the size (in bytes) of the memory allocated by the set
+        size_t getAllocatedMemorySize() const {
+            return mNbSlots > 0 ? getMemoryBlockSize(mNbSlots) : 0;
+        }
+
+        /// Return the size (in bytes) of the memory used by the control bytes and the items of the set
+        size_t getUsedMemorySize() const {
+            return static_cast<size_t>(mNbSlots) * sizeof(int8) + static_cast<size_t>(mNbEntries) * sizeof(V);
+        }
+
+        /// Try to find an item of the set given a value.
+        /// The method returns an iterator to the found item or
+        /// an iterator pointing to the end if not found
+        Iterator find(const V& value) const {
+
+            const uint64 slot = findEntry(value);
+
+            if (slot == INVALID_INDEX) {
+                return end();
+            }
+
+            return Iterator(this, slot);
+        }
+
+        /// Return an array with all the values of the set
+        Array<V> toArray(MemoryAllocator& arrayAllocator) const {
+
+            Array<V> array(arrayAllocator, mNbEntries);
+
+            for (auto it = begin(); it != end(); ++it) {
+                array.add(*it);
+            }
+
+           return array;
+        }
+
+        /// Overloaded equality operator
+        bool operator==(const OpenAddressingSet& set) const {
+
+            if (size() != set.size()) return false;
+
+            for (auto it = begin(); it != end(); ++it) {
+                if(!set.contains(*it)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// Overloaded not equal operator
+        bool operator!=(const OpenAddressingSet& set) const {
+
+            return !((*this) == set);
+        }
+
+        /// Overloaded assignment operator
+        OpenAddressingSet& operator=(const OpenAddressingSet& set) {
+
+            // Check for self assignment
+            if (this != &set) {
+
+                // Clear the set
+                clear(true);
+
+                copyTable(set);
+            }
+
+            return *this;
+        }
+
+        /// Return a begin iterator
+        Iterator begin() const {
+
+            // If the set is empty
+            if (size() == 0) {
+
+                // Return an iterator to the end
+                return end();
+            }
+
+            return Iterator(this, findNextFullSlot(0));
+        }
+
+        /// Return a end iterator
+        Iterator end() const {
+            return Iterator(this, mNbSlots);
+        }
+
+        // ---------- Friendship ---------- //
+
+        friend class Iterator;
+};
+
+}
+
+#endif
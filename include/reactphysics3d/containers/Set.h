@@ -342,6 +342,82 @@ class Set {
             assert(mFreeIndex != INVALID_INDEX);
         }
 
+        /// Release the memory that is not needed by the current number of elements
+        /// (the entries are packed at the beginning of the new memory)
+        void shrinkToFit() {
+
+            if (mNbEntries == 0) {
+                clear(true);
+                return;
+            }
+
+            // Compute the smallest hash size that can hold the current entries
+            uint64 capacity = 16;
+            while (static_cast<uint64>(capacity * double(DEFAULT_LOAD_FACTOR)) < mNbEntries) {
+                capacity *= 2;
+            }
+
+            if (capacity >= mHashSize) return;
+
+            // Allocate memory for the buckets and the entries
+            uint64* newBuckets = static_cast<uint64*>(mAllocator.allocate(capacity * sizeof(uint64)));
+            const uint64 nbAllocatedEntries = static_cast<uint64>(capacity * double(DEFAULT_LOAD_FACTOR));
+            V* newEntries = static_cast<V*>(mAllocator.allocate(nbAllocatedEntries * sizeof(V)));
+            uint64* newNextEntries = static_cast<uint64*>(mAllocator.allocate(nbAllocatedEntries * sizeof(uint64)));
+
+            assert(newEntries != nullptr);
+            assert(newNextEntries != nullptr);
+
+            // Initialize the new buckets
+            for (uint64 i=0; i<capacity; i++) {
+                newBuckets[i] = INVALID_INDEX;
+            }
+
+            // Move the entries at the beginning of the new entries array
+            uint64 newEntryIndex = 0;
+            for (uint64 i=0; i<mHashSize; i++) {
+
+                uint64 entryIndex = mBuckets[i];
+                while(entryIndex != INVALID_INDEX) {
+
+                    // Get the corresponding bucket
+                    const size_t hashCode = Hash()(mEntries[entryIndex]);
+                    const size_t divider = capacity - 1;
+                    const uint64 bucketIndex = static_cast<uint64>(hashCode & divider);
+
+                    newNextEntries[newEntryIndex] = newBuckets[bucketIndex];
+                    newBuckets[bucketIndex] = newEntryIndex;
+
+                    // Copy the entry to the new location and destroy the previous one
+                    new (newEntries + newEntryIndex) V(mEntries[entryIndex]);
+                    mEntries[entryIndex].~V();
+
+                    newEntryIndex++;
+                    entryIndex = mNextEntries[entryIndex];
+                }
+            }
+
+            assert(newEntryIndex == mNbEntries);
+
+            // Release previously allocated memory
+            mAllocator.release(mBuckets, mHashSize * sizeof(uint64));
+            mAllocator.release(mEntries, mNbAllocatedEntries * sizeof(V));
+            mAllocator.release(mNextEntries, mNbAllocatedEntries * sizeof(uint64));
+
+            // Add the remaining entries to the free list
+            mFreeIndex = INVALID_INDEX;
+            for (uint64 i=nbAllocatedEntries; i > mNbEntries; i--) {
+                newNextEntries[i - 1] = mFreeIndex;
+                mFreeIndex = i - 1;
+            }
+
+            mHashSize = capacity;
+            mNbAllocatedEntries = nbAllocatedEntries;
+            mBuckets = newBuckets;
+            mEntries = newEntries;
+            mNextEntries = newNextEntries;
+        }
+
         /// Return true if the set contains a given value
         bool contains(const V& value) const {
             return findEntry(value) != INVALID_INDEX;
@@ -470,7 +546,7 @@ class Set {
         /// Return an array with all the values of the set
         Array<V> toArray(MemoryAllocator& arrayAllocator) const {
 
-            Array<V> array(arrayAllocator);
+            Array<V> array(arrayAllocator, mNbEntries);
 
             for (auto it = begin(); it != end(); ++it) {
                 array.add(*it);
@@ -515,6 +591,7 @@ class Set {
 
                 mNbAllocatedEntries = 0;
                 mHashSize = 0;
+                mFreeIndex = INVALID_INDEX;
             }
 
             mNbEntries = 0;
@@ -530,6 +607,16 @@ class Set {
             return mHashSize;
         }
 
+        /// Return the size (in bytes) of the memory allocated by the set
+        size_t getAllocatedMemorySize() const {
+            return static_cast<size_t>(mHashSize) * sizeof(uint64) + static_cast<size_t>(mNbAllocatedEntries) * (sizeof(V) + sizeof(uint64));
+        }
+
+        /// Return the size (in bytes) of the memory used by the buckets and the entries of the set
+        size_t getUsedMemorySize() const {
+            return static_cast<size_t>(mHashSize) * sizeof(uint64) + static_cast<size_t>(mNbEntries) * (sizeof(V) + sizeof(uint64));
+        }
+
         /// Try to find an item of the set given a key.
         /// The method returns an iterator to the found item or
         /// an iterator pointing to the end if not found
@@ -66,6 +66,9 @@ class EntityManager {
         /// Destroy an entity
         void destroyEntity(Entity entity);
 
+        /// Reserve memory for a given number of entities
+        void reserve(uint32 nbEntities);
+
         /// Return true if the entity is still valid (not destroyed)
         bool isValid(Entity entity) const;
 };
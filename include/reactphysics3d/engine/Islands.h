@@ -78,13 +78,17 @@ struct Islands {
         /// For each island, total number of bodies in the island
         Array<uint32> nbBodiesInIsland;
 
+        /// For each island, index of the corresponding persistent island
+        Array<uint32> persistentIslandIndices;
+
         // -------------------- Methods -------------------- //
 
         /// Constructor
         Islands(MemoryAllocator& allocator)
             :mNbIslandsPreviousFrame(16), mNbBodyEntitiesPreviousFrame(32), mNbMaxBodiesInIslandPreviousFrame(0), mNbMaxBodiesInIslandCurrentFrame(0),
              contactManifoldsIndices(allocator), nbContactManifolds(allocator),
-             bodyEntities(allocator), startBodyEntitiesIndex(allocator), nbBodiesInIsland(allocator) {
+             bodyEntities(allocator), startBodyEntitiesIndex(allocator), nbBodiesInIsland(allocator),
+             persistentIslandIndices(allocator) {
 
         }
 
@@ -103,7 +107,7 @@ struct Islands {
         }
 
         /// Add an island and return its index
-        uint32 addIsland(uint32 contactManifoldStartIndex) {
+        uint32 addIsland(uint32 contactManifoldStartIndex, uint32 persistentIslandIndex) {
 
             const uint32 islandIndex = static_cast<uint32>(contactManifoldsIndices.size());
 
@@ -111,6 +115,7 @@ struct Islands {
             nbContactManifolds.add(0);
             startBodyEntitiesIndex.add(static_cast<uint32>(bodyEntities.size()));
             nbBodiesInIsland.add(0);
+            persistentIslandIndices.add(persistentIslandIndex);
 
             if (islandIndex > 0 && nbBodiesInIsland[islandIndex-1] > mNbMaxBodiesInIslandCurrentFrame) {
                 mNbMaxBodiesInIslandCurrentFrame = nbBodiesInIsland[islandIndex-1];
@@ -135,6 +140,7 @@ struct Islands {
             nbContactManifolds.reserve(mNbIslandsPreviousFrame);
             startBodyEntitiesIndex.reserve(mNbIslandsPreviousFrame);
             nbBodiesInIsland.reserve(mNbIslandsPreviousFrame);
+            persistentIslandIndices.reserve(mNbIslandsPreviousFrame);
 
             bodyEntities.reserve(mNbBodyEntitiesPreviousFrame);
         }
@@ -158,6 +164,7 @@ struct Islands {
             bodyEntities.clear(true);
             startBodyEntitiesIndex.clear(true);
             nbBodiesInIsland.clear(true);
+            persistentIslandIndices.clear(true);
         }
 
         uint32 getNbMaxBodiesInIslandPreviousFrame() const {
@@ -28,7 +28,7 @@
 
 // Libraries
 #include <reactphysics3d/collision/Collider.h>
-#include <reactphysics3d/containers/Map.h>
+#include <reactphysics3d/containers/OpenAddressingMap.h>
 #include <reactphysics3d/containers/Pair.h>
 #include <reactphysics3d/containers/Set.h>
 #include <reactphysics3d/containers/containers_common.h>
@@ -182,7 +182,7 @@ class OverlappingPairs {
                 /// If two convex shapes overlap, we have a single collision data but if one shape is concave,
                 /// we might have collision data for several overlapping triangles. The key in the map is the
                 /// shape Ids of the two collision shapes.
-                Map<uint64, LastFrameCollisionInfo*> lastFrameCollisionInfos;
+                LookupMap<uint64, LastFrameCollisionInfo*> lastFrameCollisionInfos;
 
                 /// Constructor
                 ConcaveOverlappingPair(uint64 pairId, int32 broadPhaseId1, int32 broadPhaseId2, Entity collider1, Entity collider2,
@@ -286,10 +286,13 @@ class OverlappingPairs {
         Array<ConcaveOverlappingPair> mConcavePairs;
 
         /// Map a pair id to the internal array index
-        Map<uint64, uint64> mMapConvexPairIdToPairIndex;
+        LookupMap<uint64, uint64> mMapConvexPairIdToPairIndex;
 
         /// Map a pair id to the internal array index
-        Map<uint64, uint64> mMapConcavePairIdToPairIndex;
+        LookupMap<uint64, uint64> mMapConcavePairIdToPairIndex;
+
+        /// Largest memory (in bytes) used by the pairs so far
+        size_t mPeakUsedMemory;
 
         /// Reference to the colliders components
         ColliderComponents& mColliderComponents;
@@ -321,6 +324,13 @@ class OverlappingPairs {
         /// Swap two pairs in the array
         void swapPairs(uint64 index1, uint64 index2);
 
+        /// Return the memory (in bytes) currently used by the pairs
+        size_t computeUsedMemory() const;
+
+        /// Update the broad-phase IDs and the ID of a pair after the broad-phase nodes have moved
+        void updatePairBroadPhaseIds(OverlappingPair& pair, const Array<int32>& newNodeIds,
+                                     Map<uint64, uint64>& outNewPairIds);
+
     public:
 
         // -------------------- Methods -------------------- //
@@ -349,6 +359,18 @@ class OverlappingPairs {
         /// Remove a pair
         void removePair(uint64 pairIndex, bool isConvexVsConvex);
 
+        /// Reserve memory for a given number of convex vs convex pairs
+        void reserve(uint32 nbPairs);
+
+        /// Update the pairs after the nodes of the broad-phase tree have moved
+        void updateBroadPhaseIds(const Array<int32>& newNodeIds, Map<uint64, uint64>& outNewPairIds);
+
+        /// Release the memory that is not used by the current pairs
+        void shrinkToFit();
+
+        /// Return the memory usage of the overlapping pairs
+        MemoryUsage getMemoryUsage() const;
+
         /// Delete all the obsolete last frame collision info
         void clearObsoleteLastFrameCollisionInfos();
 
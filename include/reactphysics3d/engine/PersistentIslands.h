@@ -0,0 +1,157 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_PERSISTENT_ISLANDS_H
+#define REACTPHYSICS3D_PERSISTENT_ISLANDS_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/containers/Array.h>
+#include <reactphysics3d/engine/Entity.h>
+
+namespace reactphysics3d {
+
+/// Island index of a body that does not belong to any island (static body)
+constexpr uint32 NO_ISLAND = 0xffffffff;
+
+// Structure PersistentIslands
+/**
+ * This structure contains the islands of bodies that are kept from one frame to the next.
+ * Every non-static rigid body belongs to exactly one persistent island. Islands are merged
+ * when a contact or a joint connects two of them and are only split lazily, when some of
+ * their bodies are ready to go to sleep after a contact or a joint has been removed.
+ * At each frame, the awake persistent islands are copied into the Islands structure used
+ * by the solver.
+ */
+struct PersistentIslands {
+
+    public:
+
+        /// A persistent island
+        struct Island {
+
+            /// Entities of the bodies of the island
+            Array<Entity> bodyEntities;
+
+            /// Index of the island in the Islands structure of the current frame (NO_ISLAND if not awake)
+            uint32 frameIslandIndex;
+
+            /// True if a contact or a joint has been removed between bodies of the island since
+            /// the island has been built. In this case, the island might need to be split
+            bool isSplitCandidate;
+
+            /// True if the island is currently in use (not in the free list)
+            bool isUsed;
+
+            /// Constructor
+            Island(MemoryAllocator& allocator)
+                :bodyEntities(allocator), frameIslandIndex(NO_ISLAND), isSplitCandidate(false), isUsed(true) {
+
+            }
+        };
+
+    private:
+
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        /// Number of islands currently in use
+        uint32 mNbUsedIslands;
+
+    public:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Array of all the islands (some of them might be unused)
+        Array<Island> islands;
+
+        /// Indices of the unused islands that can be recycled
+        Array<uint32> freeIslands;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        PersistentIslands(MemoryAllocator& allocator)
+            :mAllocator(allocator), mNbUsedIslands(0), islands(allocator), freeIslands(allocator) {
+
+        }
+
+        /// Destructor
+        ~PersistentIslands() = default;
+
+        /// Assignment operator
+        PersistentIslands& operator=(const PersistentIslands& islands) = delete;
+
+        /// Copy-constructor
+        PersistentIslands(const PersistentIslands& islands) = delete;
+
+        /// Return the number of islands currently in use
+        uint32 getNbIslands() const {
+            return mNbUsedIslands;
+        }
+
+        /// Create a new empty island and return its index
+        uint32 createIsland() {
+
+            mNbUsedIslands++;
+
+            // Recycle an unused island if possible
+            if (freeIslands.size() > 0) {
+
+                const uint32 islandIndex = freeIslands[freeIslands.size() - 1];
+                freeIslands.removeAt(freeIslands.size() - 1);
+
+                Island& island = islands[islandIndex];
+                assert(!island.isUsed);
+                assert(island.bodyEntities.size() == 0);
+                island.frameIslandIndex = NO_ISLAND;
+                island.isSplitCandidate = false;
+                island.isUsed = true;
+
+                return islandIndex;
+            }
+
+            islands.add(Island(mAllocator));
+
+            return static_cast<uint32>(islands.size()) - 1;
+        }
+
+        /// Destroy an island (its bodies must have been moved to other islands before)
+        void destroyIsland(uint32 islandIndex) {
+
+            assert(islands[islandIndex].isUsed);
+            assert(mNbUsedIslands > 0);
+
+            islands[islandIndex].bodyEntities.clear(true);
+            islands[islandIndex].isUsed = false;
+            freeIslands.add(islandIndex);
+
+            mNbUsedIslands--;
+        }
+};
+
+}
+
+#endif
@@ -36,6 +36,7 @@
 #include <reactphysics3d/collision/shapes/ConvexMeshShape.h>
 #include <reactphysics3d/collision/shapes/ConcaveMeshShape.h>
 #include <reactphysics3d/collision/TriangleMesh.h>
+#include <reactphysics3d/collision/CookedMesh.h>
 #include <reactphysics3d/utils/DefaultLogger.h>
 
 /// ReactPhysics3D namespace
@@ -127,6 +128,9 @@ class PhysicsCommon {
         /// Delete a concave mesh shape
         void deleteConcaveMeshShape(ConcaveMeshShape* concaveMeshShape);
 
+        /// Remove the cached debug tessellations of a collision shape that is destroyed
+        void removeShapeFromDebugRenderers(const CollisionShape* collisionShape);
+
         /// Delete a polyhedron mesh
         void deletePolyhedronMesh(PolyhedronMesh* polyhedronMesh);
 
@@ -161,7 +165,8 @@ class PhysicsCommon {
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        PhysicsCommon(MemoryAllocator* baseMemoryAllocator = nullptr);
+        PhysicsCommon(MemoryAllocator* baseMemoryAllocator = nullptr,
+                      MemoryManager::HeapAllocatorType heapAllocatorType = MemoryManager::HeapAllocatorType::TLSF);
 
         /// Destructor
         ~PhysicsCommon();
@@ -214,15 +219,38 @@ class PhysicsCommon {
         /// Create a polyhedron mesh
         PolyhedronMesh* createPolyhedronMesh(PolygonVertexArray* polygonVertexArray);
 
+        /// Create a polyhedron mesh from the convex hull of a point cloud
+        PolyhedronMesh* createConvexHullMesh(const void* points, uint32 nbPoints, uint32 pointsStride,
+                                             PolygonVertexArray::VertexDataType pointsDataType,
+                                             const QuickHull::Settings& settings = QuickHull::Settings());
+
+        /// Serialize a polyhedron mesh into a cooked binary blob
+        size_t cookPolyhedronMesh(const PolyhedronMesh* polyhedronMesh, void* outData, size_t outDataSize);
+
+        /// Create a polyhedron mesh from cooked data
+        PolyhedronMesh* createPolyhedronMeshFromCookedData(const void* cookedData, size_t cookedDataSize);
+
         /// Destroy a polyhedron mesh
         void destroyPolyhedronMesh(PolyhedronMesh* polyhedronMesh);
 
         /// Create a triangle mesh
         TriangleMesh* createTriangleMesh();
 
+        /// Serialize a triangle mesh into a cooked binary blob
+        size_t cookTriangleMesh(const TriangleMesh* triangleMesh, void* outData, size_t outDataSize);
+
+        /// Create a triangle mesh from cooked data
+        TriangleMesh* createTriangleMeshFromCookedData(const void* cookedData, size_t cookedDataSize);
+
         /// Destroy a triangle mesh
         void destroyTriangleMesh(TriangleMesh* triangleMesh);
 
+        /// Return the memory usage of the allocator of a given type
+        MemoryUsage getMemoryUsage(MemoryManager::AllocationType allocationType) const;
+
+        /// Return the memory usage of the BVH of all the concave mesh shapes
+        MemoryUsage getConcaveMeshesMemoryUsage() const;
+
         /// Create and return a new default logger
         DefaultLogger* createDefaultLogger();
 
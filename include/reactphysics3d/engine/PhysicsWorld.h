@@ -50,8 +50,10 @@
 #include <reactphysics3d/systems/ContactSolverSystem.h>
 #include <reactphysics3d/systems/DynamicsSystem.h>
 #include <reactphysics3d/engine/Islands.h>
+#include <reactphysics3d/engine/PersistentIslands.h>
 #include <reactphysics3d/utils/DebugRenderer.h>
 #include <sstream>
+#include <chrono>
 
 /// Namespace ReactPhysics3D
 namespace reactphysics3d {
@@ -119,6 +121,29 @@ class PhysicsWorld {
             /// than the value bellow, the manifold are considered to be similar.
             decimal cosAngleSimilarContactManifold;
 
+            /// Expected number of bodies in the world. Memory for this number of bodies is
+            /// reserved when the world is created (zero means no reservation)
+            uint32 bodiesCapacity;
+
+            /// Expected number of colliders in the world (zero means no reservation)
+            uint32 collidersCapacity;
+
+            /// Expected number of joints in the world (zero means no reservation)
+            uint32 jointsCapacity;
+
+            /// Expected number of overlapping pairs in the broad-phase (zero means no reservation)
+            uint32 overlappingPairsCapacity;
+
+            /// Expected number of contact points per frame (zero means no reservation)
+            uint32 contactsCapacity;
+
+            /// The broad-phase tree is rebuilt when the ratio between its SAH cost and the cost
+            /// of a rebuilt tree is larger than this value (zero means never)
+            decimal broadPhaseRebuildCostRatio;
+
+            /// Number of steps between two checks of the quality of the broad-phase tree
+            uint32 broadPhaseQualityCheckInterval;
+
             WorldSettings() {
 
                 worldName = "";
@@ -134,6 +159,13 @@ class PhysicsWorld {
                 defaultSleepLinearVelocity = decimal(0.02);
                 defaultSleepAngularVelocity = decimal(3.0) * (PI_RP3D / decimal(180.0));
                 cosAngleSimilarContactManifold = decimal(0.95);
+                bodiesCapacity = 0;
+                collidersCapacity = 0;
+                jointsCapacity = 0;
+                overlappingPairsCapacity = 0;
+                contactsCapacity = 0;
+                broadPhaseRebuildCostRatio = 0;
+                broadPhaseQualityCheckInterval = 60;
             }
 
             ~WorldSettings() = default;
@@ -156,6 +188,217 @@ class PhysicsWorld {
                 ss << "defaultSleepLinearVelocity=" << defaultSleepLinearVelocity << std::endl;
                 ss << "defaultSleepAngularVelocity=" << defaultSleepAngularVelocity << std::endl;
                 ss << "cosAngleSimilarContactManifold=" << cosAngleSimilarContactManifold << std::endl;
+                ss << "bodiesCapacity=" << bodiesCapacity << std::endl;
+                ss << "collidersCapacity=" << collidersCapacity << std::endl;
+                ss << "jointsCapacity=" << jointsCapacity << std::endl;
+                ss << "overlappingPairsCapacity=" << overlappingPairsCapacity << std::endl;
+                ss << "contactsCapacity=" << contactsCapacity << std::endl;
+                ss << "broadPhaseRebuildCostRatio=" << broadPhaseRebuildCostRatio << std::endl;
+                ss << "broadPhaseQualityCheckInterval=" << broadPhaseQualityCheckInterval << std::endl;
+
+                return ss.str();
+            }
+        };
+
+        /// Structure WorldMemoryUsage
+        /**
+         * This structure describes the memory used by the main parts of a physics world.
+         * The memory of the allocators that are shared by all the worlds of a PhysicsCommon
+         * is available with the MemoryManager::getMemoryUsage() method.
+         */
+        struct WorldMemoryUsage {
+
+            /// Memory of the components of the bodies, colliders and joints (the peak is the sum of
+            /// the peaks of each type of components)
+            MemoryUsage components;
+
+            /// Memory of the nodes of the broad-phase tree
+            MemoryUsage broadPhase;
+
+            /// Memory of the overlapping pairs of colliders
+            MemoryUsage overlappingPairs;
+
+            /// Memory of the contact pairs, manifolds and points
+            MemoryUsage contacts;
+
+            /// Return the sum of the memory usages of the world
+            MemoryUsage getTotal() const {
+
+                return MemoryUsage(components.reservedBytes + broadPhase.reservedBytes + overlappingPairs.reservedBytes + contacts.reservedBytes,
+                                   components.usedBytes + broadPhase.usedBytes + overlappingPairs.usedBytes + contacts.usedBytes,
+                                   components.peakUsedBytes + broadPhase.peakUsedBytes + overlappingPairs.peakUsedBytes + contacts.peakUsedBytes);
+            }
+
+            /// Return a string with the memory usage
+            std::string to_string() const {
+
+                std::stringstream ss;
+
+                ss << "components: " << components.to_string() << std::endl;
+                ss << "broadPhase: " << broadPhase.to_string() << std::endl;
+                ss << "overlappingPairs: " << overlappingPairs.to_string() << std::endl;
+                ss << "contacts: " << contacts.to_string() << std::endl;
+
+                return ss.str();
+            }
+        };
+
+        /// Structure StepStats
+        /**
+         * This structure contains counters about the work done during the last call to the
+         * PhysicsWorld::update() method. The counters are always computed. The time of each stage
+         * of the step is only measured if it has been enabled with the
+         * PhysicsWorld::setIsStepTimingEnabled() method.
+         */
+        struct StepStats {
+
+            /// Number of convex vs convex overlapping pairs of colliders in the broad-phase
+            uint32 nbConvexPairs;
+
+            /// Number of convex vs concave overlapping pairs of colliders in the broad-phase
+            uint32 nbConcavePairs;
+
+            /// Number of triangles of the concave shapes tested by the middle-phase
+            uint32 nbMiddlePhaseTriangles;
+
+            /// Number of sphere vs sphere narrow-phase tests
+            uint32 nbSphereVsSphereTests;
+
+            /// Number of sphere vs capsule narrow-phase tests
+            uint32 nbSphereVsCapsuleTests;
+
+            /// Number of capsule vs capsule narrow-phase tests
+            uint32 nbCapsuleVsCapsuleTests;
+
+            /// Number of sphere vs convex polyhedron narrow-phase tests
+            uint32 nbSphereVsConvexPolyhedronTests;
+
+            /// Number of capsule vs convex polyhedron narrow-phase tests
+            uint32 nbCapsuleVsConvexPolyhedronTests;
+
+            /// Number of convex polyhedron vs convex polyhedron narrow-phase tests
+            uint32 nbConvexPolyhedronVsConvexPolyhedronTests;
+
+            /// Number of contact pairs (pairs of colliders in contact)
+            uint32 nbContactPairs;
+
+            /// Number of contact manifolds
+            uint32 nbContactManifolds;
+
+            /// Number of contact points
+            uint32 nbContactPoints;
+
+            /// Number of islands of awake bodies
+            uint32 nbIslands;
+
+            /// Number of awake non-static bodies at the end of the step
+            uint32 nbAwakeBodies;
+
+            /// Number of iterations of the velocity solver
+            uint32 nbVelocitySolverIterations;
+
+            /// Number of iterations of the position solver
+            uint32 nbPositionSolverIterations;
+
+            /// Number of updates of the colliders in the broad-phase tree since the previous step
+            uint32 nbBroadPhaseUpdates;
+
+            /// Number of colliders reinserted in the broad-phase tree since the previous step
+            /// because they have moved out of their fat AABB
+            uint32 nbBroadPhaseReinsertions;
+
+            /// True if the broad-phase tree has been rebuilt during the step
+            bool isBroadPhaseTreeRebuilt;
+
+            /// True if the time of the stages of the step has been measured
+            bool isTimingEnabled;
+
+            /// Time of the broad-phase, middle-phase and narrow-phase collision detection (in milliseconds)
+            double collisionDetectionTime;
+
+            /// Time of the creation of the islands and of the contacts and of the contacts
+            /// reporting (in milliseconds)
+            double contactsTime;
+
+            /// Time of the integration of the bodies and of the contacts and joints solver (in milliseconds)
+            double solverTime;
+
+            /// Time of the update of the state of the bodies and of their colliders in the
+            /// broad-phase (in milliseconds)
+            double bodiesUpdateTime;
+
+            /// Time to put the bodies to sleep (in milliseconds)
+            double sleepingTime;
+
+            /// Total time of the step (in milliseconds)
+            double totalTime;
+
+            StepStats() {
+
+                nbConvexPairs = 0;
+                nbConcavePairs = 0;
+                nbMiddlePhaseTriangles = 0;
+                nbSphereVsSphereTests = 0;
+                nbSphereVsCapsuleTests = 0;
+                nbCapsuleVsCapsuleTests = 0;
+                nbSphereVsConvexPolyhedronTests = 0;
+                nbCapsuleVsConvexPolyhedronTests = 0;
+                nbConvexPolyhedronVsConvexPolyhedronTests = 0;
+                nbContactPairs = 0;
+                nbContactManifolds = 0;
+                nbContactPoints = 0;
+                nbIslands = 0;
+                nbAwakeBodies = 0;
+                nbVelocitySolverIterations = 0;
+                nbPositionSolverIterations = 0;
+                nbBroadPhaseUpdates = 0;
+                nbBroadPhaseReinsertions = 0;
+                isBroadPhaseTreeRebuilt = false;
+                isTimingEnabled = false;
+                collisionDetectionTime = 0;
+                contactsTime = 0;
+                solverTime = 0;
+                bodiesUpdateTime = 0;
+                sleepingTime = 0;
+                totalTime = 0;
+            }
+
+            /// Return the total number of narrow-phase tests
+            uint32 getNbNarrowPhaseTests() const {
+                return nbSphereVsSphereTests + nbSphereVsCapsuleTests + nbCapsuleVsCapsuleTests + nbSphereVsConvexPolyhedronTests +
+                       nbCapsuleVsConvexPolyhedronTests + nbConvexPolyhedronVsConvexPolyhedronTests;
+            }
+
+            /// Return a string with the statistics of the step
+            std::string to_string() const {
+
+                std::stringstream ss;
+
+                ss << "nbConvexPairs=" << nbConvexPairs << std::endl;
+                ss << "nbConcavePairs=" << nbConcavePairs << std::endl;
+                ss << "nbMiddlePhaseTriangles=" << nbMiddlePhaseTriangles << std::endl;
+                ss << "nbSphereVsSphereTests=" << nbSphereVsSphereTests << std::endl;
+                ss << "nbSphereVsCapsuleTests=" << nbSphereVsCapsuleTests << std::endl;
+                ss << "nbCapsuleVsCapsuleTests=" << nbCapsuleVsCapsuleTests << std::endl;
+                ss << "nbSphereVsConvexPolyhedronTests=" << nbSphereVsConvexPolyhedronTests << std::endl;
+                ss << "nbCapsuleVsConvexPolyhedronTests=" << nbCapsuleVsConvexPolyhedronTests << std::endl;
+                ss << "nbConvexPolyhedronVsConvexPolyhedronTests=" << nbConvexPolyhedronVsConvexPolyhedronTests << std::endl;
+                ss << "nbContactPairs=" << nbContactPairs << std::endl;
+                ss << "nbContactManifolds=" << nbContactManifolds << std::endl;
+                ss << "nbContactPoints=" << nbContactPoints << std::endl;
+                ss << "nbIslands=" << nbIslands << std::endl;
+                ss << "nbAwakeBodies=" << nbAwakeBodies << std::endl;
+                ss << "nbVelocitySolverIterations=" << nbVelocitySolverIterations << std::endl;
+                ss << "nbPositionSolverIterations=" << nbPositionSolverIterations << std::endl;
+
+                if (isTimingEnabled) {
+                    ss << "collisionDetectionTime=" << collisionDetectionTime << std::endl;
+                    ss << "contactsTime=" << contactsTime << std::endl;
+                    ss << "solverTime=" << solverTime << std::endl;
+                    ss << "bodiesUpdateTime=" << bodiesUpdateTime << std::endl;
+                    ss << "sleepingTime=" << sleepingTime << std::endl;
+                    ss << "totalTime=" << totalTime << std::endl;
+                }
 
                 return ss.str();
             }
@@ -231,6 +474,9 @@ class PhysicsWorld {
         /// All the islands of bodies of the current frame
         Islands mIslands;
 
+        /// Islands of bodies that are kept from one frame to the next
+        PersistentIslands mPersistentIslands;
+
         /// Order in which to process the ContactPairs for contact creation such that
         /// all the contact manifolds and contact points of a given island are packed together
         /// This array contains the indices of the ContactPairs.
@@ -270,6 +516,21 @@ class PhysicsWorld {
         /// becomes smaller than the sleep velocity.
         decimal mTimeBeforeSleep;
 
+        /// Statistics of the last call to update()
+        StepStats mLastStepStats;
+
+        /// True if the time of the stages of update() is measured
+        bool mIsStepTimingEnabled;
+
+        /// Number of updates of the broad-phase tree at the end of the previous step
+        uint64 mNbBroadPhaseUpdatesAtLastStep;
+
+        /// Number of reinsertions in the broad-phase tree at the end of the previous step
+        uint64 mNbBroadPhaseReinsertionsAtLastStep;
+
+        /// Number of steps since the last check of the quality of the broad-phase tree
+        uint32 mNbStepsSinceBroadPhaseQualityCheck;
+
         // -------------------- Methods -------------------- //
 
         /// Constructor
@@ -278,6 +539,9 @@ class PhysicsWorld {
         /// Notify the world if a body is disabled (slepping or inactive) or not
         void setBodyDisabled(Entity entity, bool isDisabled);
 
+        /// Update the state of a static body in the rigid body components
+        void updateStaticBodyState(Entity bodyEntity);
+
         /// Notify the world whether a joint is disabled or not
         void setJointDisabled(Entity jointEntity, bool isDisabled);
 
@@ -296,6 +560,39 @@ class PhysicsWorld {
         /// Put bodies to sleep if needed.
         void updateSleepingBodies(decimal timeStep);
 
+        /// Split the islands of the current frame that might not be connected anymore (when sleeping is disabled)
+        void splitDisconnectedIslands();
+
+        /// Add a non-static body into a new persistent island
+        void addBodyToNewIsland(Entity bodyEntity);
+
+        /// Remove a body from its persistent island
+        void removeBodyFromIsland(Entity bodyEntity);
+
+        /// Record the counters of the collision detection in the statistics of the step
+        void updateCollisionDetectionStats();
+
+        /// Record the updates of the broad-phase tree and rebuild the tree if its quality is too low
+        void updateBroadPhaseTree();
+
+        /// Return the time elapsed since the start of a stage of the step (in milliseconds) and start the next stage
+        double measureStageTime(std::chrono::high_resolution_clock::time_point& stageStartTime) const;
+
+        /// Merge two persistent islands and return the index of the resulting island
+        uint32 mergeIslands(uint32 islandIndex1, uint32 islandIndex2);
+
+        /// Mark the persistent island of a body as a candidate for splitting
+        void markIslandAsSplitCandidate(Entity bodyEntity);
+
+        /// Mark the persistent islands of the lost contact pairs as candidates for splitting
+        void markIslandsWithLostContacts();
+
+        /// Split persistent islands into their connected groups of bodies
+        void splitIslands(const Array<uint32>& islandsToSplit, Array<uint32>& outIslands);
+
+        /// Return the root of a body in the disjoint sets forest used to split the islands
+        static uint32 findSplitRoot(Array<uint32>& parents, uint32 index);
+
         /// Add the joint to the array of joints of the two bodies involved in the joint
         void addJointToBodies(Entity body1, Entity body2, Entity joint);
 
@@ -342,9 +639,27 @@ class PhysicsWorld {
         /// Return a reference to the memory manager of the world
         MemoryManager& getMemoryManager();
 
+        /// Return the memory usage of the world
+        WorldMemoryUsage getMemoryUsage() const;
+
+        /// Return the statistics of the last call to update()
+        const StepStats& getLastStepStats() const;
+
+        /// Return true if the time of the stages of update() is measured
+        bool isStepTimingEnabled() const;
+
+        /// Enable or disable the measurement of the time of the stages of update()
+        void setIsStepTimingEnabled(bool isEnabled);
+
         /// Return the current world-space AABB of given collider
         AABB getWorldAABB(const Collider* collider) const;
 
+        /// Compute the metrics describing the quality of the broad-phase tree
+        DynamicAABBTree::QualityMetrics computeBroadPhaseQualityMetrics() const;
+
+        /// Rebuild the broad-phase tree from scratch
+        void rebuildBroadPhaseTree();
+
         /// Return the name of the world
         const std::string& getName() const;
 
@@ -357,6 +672,12 @@ class PhysicsWorld {
         /// Update the physics simulation
         void update(decimal timeStep);
 
+        /// Reserve memory for a given number of bodies, colliders, joints, overlapping pairs and contacts
+        void reserve(uint32 nbBodies, uint32 nbColliders, uint32 nbJoints, uint32 nbOverlappingPairs, uint32 nbContacts);
+
+        /// Release the memory that is not used anymore and reorder the components for locality
+        void compact();
+
         /// Get the number of iterations for the velocity constraint solver
         uint16 getNbIterationsVelocitySolver() const;
 
@@ -571,6 +892,30 @@ RP3D_FORCE_INLINE MemoryManager& PhysicsWorld::getMemoryManager() {
     return mMemoryManager;
 }
 
+// Return the statistics of the last call to update()
+/**
+ * @return A reference to the counters (and stage times if enabled) of the last step
+ */
+RP3D_FORCE_INLINE const PhysicsWorld::StepStats& PhysicsWorld::getLastStepStats() const {
+    return mLastStepStats;
+}
+
+// Return true if the time of the stages of update() is measured
+/**
+ * @return True if the stage times are measured at each step
+ */
+RP3D_FORCE_INLINE bool PhysicsWorld::isStepTimingEnabled() const {
+    return mIsStepTimingEnabled;
+}
+
+// Enable or disable the measurement of the time of the stages of update()
+/**
+ * @param isEnabled True if the time of the stages of the step must be measured
+ */
+RP3D_FORCE_INLINE void PhysicsWorld::setIsStepTimingEnabled(bool isEnabled) {
+    mIsStepTimingEnabled = isEnabled;
+}
+
 // Return the name of the world
 /**
  * @return Name of the world
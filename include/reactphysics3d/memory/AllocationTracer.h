@@ -0,0 +1,336 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+
+#ifndef REACTPHYSICS3D_ALLOCATION_TRACER_H
+#define REACTPHYSICS3D_ALLOCATION_TRACER_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/memory/MemoryManager.h>
+#include <reactphysics3d/containers/Array.h>
+#include <atomic>
+#include <mutex>
+#include <ostream>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class AllocationTracer
+/**
+ * This class records the allocations made by the memory allocators of the library in order
+ * to find the allocations that happen at each frame. It is compiled in with the CMake option
+ * RP3D_ALLOCATION_TRACING_ENABLED and must also be enabled at runtime with setIsEnabled().
+ * Each allocation is recorded with its size, the type of the allocator, the index of the
+ * frame (incremented at each call to PhysicsWorld::update()) and the tag of the innermost
+ * allocation tag scope of the thread. An allocation tag scope is opened by each stage
+ * measured by the Instrumentation and by the RP3D_ALLOCATION_TAG macro. Note that an
+ * allocation that a pool or frame allocator forwards to the heap allocator is recorded by
+ * both allocators and that the memory requested by the heap allocator to the base allocator
+ * is recorded as a base allocation.
+ */
+class AllocationTracer {
+
+    public :
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of types of allocators
+        static const uint32 NB_ALLOCATION_TYPES = 4;
+
+        /// Number of size classes of the histograms. The size class i contains the allocations
+        /// of at most (16 << i) bytes and the last size class contains the larger allocations.
+        static const uint32 NB_SIZE_CLASSES = 16;
+
+        /// Default maximum number of records
+        static const uint64 DEFAULT_MAX_NB_RECORDS = 1 << 20;
+
+        // -------------------- Internal Classes -------------------- //
+
+        // Structure AllocationRecord
+        /**
+         * A recorded allocation
+         */
+        struct AllocationRecord {
+
+            /// Index of the frame of the allocation
+            uint64 frameIndex;
+
+            /// Size of the allocation (in bytes)
+            size_t size;
+
+            /// Tag of the allocation (null if the allocation has no tag)
+            const char* tag;
+
+            /// Type of the allocator
+            MemoryManager::AllocationType allocationType;
+        };
+
+        // Structure TagCounters
+        /**
+         * Allocations of a frame with a given tag
+         */
+        struct TagCounters {
+
+            /// Tag of the allocations (null for the allocations without tag)
+            const char* tag;
+
+            /// Number of allocations
+            uint64 nbAllocations;
+
+            /// Number of allocated bytes
+            uint64 nbAllocatedBytes;
+        };
+
+        // Structure FrameHistogram
+        /**
+         * Histogram of the allocations of a frame per allocator type, size class and tag
+         */
+        struct FrameHistogram {
+
+            /// Index of the frame
+            uint64 frameIndex;
+
+            /// Number of allocations
+            uint64 nbAllocations;
+
+            /// Number of allocated bytes
+            uint64 nbAllocatedBytes;
+
+            /// Number of allocations of each allocator type
+            uint64 nbAllocationsPerType[NB_ALLOCATION_TYPES];
+
+            /// Number of allocated bytes of each allocator type
+            uint64 nbAllocatedBytesPerType[NB_ALLOCATION_TYPES];
+
+            /// Number of allocations of each size class
+            uint64 nbAllocationsPerSizeClass[NB_SIZE_CLASSES];
+
+            /// Allocations of each tag
+            Array<TagCounters> tags;
+
+            /// Constructor
+            FrameHistogram(MemoryAllocator& allocator) : tags(allocator) {
+                clear(0);
+            }
+
+            /// Clear the histogram
+            void clear(uint64 frame);
+
+            /// Add an allocation to the histogram
+            void addRecord(const AllocationRecord& record);
+
+            /// Return the counters of a given tag (null if there is no allocation with this tag)
+            const TagCounters* getTag(const char* tag) const;
+
+            /// Return the number of allocations of a given allocator type
+            uint64 getNbAllocations(MemoryManager::AllocationType allocationType) const {
+                return nbAllocationsPerType[static_cast<uint32>(allocationType)];
+            }
+        };
+
+    private :
+
+        // -------------------- Attributes -------------------- //
+
+        /// True if the allocations are recorded
+        static std::atomic<bool> mIsEnabled;
+
+        /// Index of the current frame
+        static std::atomic<uint64> mFrameIndex;
+
+        /// Allocator of the records (not traced)
+        static DefaultAllocator mAllocator;
+
+        /// Mutex to protect the records
+        static std::mutex mMutex;
+
+        /// Recorded allocations
+        static Array<AllocationRecord> mRecords;
+
+        /// Maximum number of records
+        static uint64 mMaxNbRecords;
+
+        /// Number of allocations that have not been recorded because there were too many records
+        static uint64 mNbDroppedRecords;
+
+        /// Tag of the innermost allocation tag scope of the current thread
+        static thread_local const char* mCurrentTag;
+
+        // -------------------- Methods -------------------- //
+
+        /// Record an allocation
+        static void addRecord(MemoryManager::AllocationType allocationType, size_t size);
+
+        /// Return true if a record belongs to an earlier frame than another record
+        static bool isRecordOfEarlierFrame(const AllocationRecord& record1, const AllocationRecord& record2);
+
+        /// Write a histogram into a stream
+        static void writeHistogram(std::ostream& stream, const FrameHistogram& histogram);
+
+        friend class AllocationTagScope;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Return true if the allocations are recorded
+        static bool isEnabled();
+
+        /// Enable or disable the recording of the allocations
+        static void setIsEnabled(bool isEnabled);
+
+        /// Record an allocation if the tracing is enabled
+        static void recordAllocation(MemoryManager::AllocationType allocationType, size_t size);
+
+        /// Start a new frame
+        static void nextFrame();
+
+        /// Return the index of the current frame
+        static uint64 getFrameIndex();
+
+        /// Return the tag of the allocations of the current thread
+        static const char* getCurrentTag();
+
+        /// Set the maximum number of records
+        static void setMaxNbRecords(uint64 maxNbRecords);
+
+        /// Return the number of recorded allocations
+        static uint64 getNbRecords();
+
+        /// Return the number of allocations that have not been recorded because there were too many records
+        static uint64 getNbDroppedRecords();
+
+        /// Copy the recorded allocations into an array
+        static void getRecords(Array<AllocationRecord>& outRecords);
+
+        /// Compute the histogram of the recorded allocations of a frame
+        static void computeFrameHistogram(uint64 frameIndex, FrameHistogram& outHistogram);
+
+        /// Write the histograms of the frames with recorded allocations into a stream
+        static void dumpFrameHistograms(std::ostream& stream, uint64 firstFrame = 0, uint64 lastFrame = ~uint64(0));
+
+        /// Remove all the recorded allocations
+        static void reset();
+
+        /// Return the name of an allocator type
+        static const char* getAllocationTypeName(MemoryManager::AllocationType allocationType);
+
+        /// Return the size class of an allocation size
+        static uint32 getSizeClass(size_t size);
+};
+
+// Class AllocationTagScope
+/**
+ * This class sets the tag of the allocations of the current thread between
+ * its construction and its destruction
+ */
+class AllocationTagScope {
+
+    private :
+
+        // -------------------- Attributes -------------------- //
+
+        /// Tag of the enclosing scope
+        const char* mPreviousTag;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        AllocationTagScope(const char* tag) : mPreviousTag(AllocationTracer::mCurrentTag) {
+            AllocationTracer::mCurrentTag = tag;
+        }
+
+        /// Destructor
+        ~AllocationTagScope() {
+            AllocationTracer::mCurrentTag = mPreviousTag;
+        }
+
+        /// Deleted copy-constructor
+        AllocationTagScope(const AllocationTagScope& scope) = delete;
+
+        /// Deleted assignment operator
+        AllocationTagScope& operator=(const AllocationTagScope& scope) = delete;
+};
+
+// Return true if the allocations are recorded
+RP3D_FORCE_INLINE bool AllocationTracer::isEnabled() {
+    return mIsEnabled.load(std::memory_order_relaxed);
+}
+
+// Record an allocation if the tracing is enabled
+/**
+ * @param allocationType Type of the allocator
+ * @param size Size of the allocation (in bytes)
+ */
+RP3D_FORCE_INLINE void AllocationTracer::recordAllocation(MemoryManager::AllocationType allocationType, size_t size) {
+    if (isEnabled()) {
+        addRecord(allocationType, size);
+    }
+}
+
+// Start a new frame
+RP3D_FORCE_INLINE void AllocationTracer::nextFrame() {
+    mFrameIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Return the index of the current frame
+/**
+ * @return The number of calls to nextFrame()
+ */
+RP3D_FORCE_INLINE uint64 AllocationTracer::getFrameIndex() {
+    return mFrameIndex.load(std::memory_order_relaxed);
+}
+
+// Return the tag of the allocations of the current thread
+/**
+ * @return The tag of the innermost allocation tag scope of the current thread (null if none)
+ */
+RP3D_FORCE_INLINE const char* AllocationTracer::getCurrentTag() {
+    return mCurrentTag;
+}
+
+}
+
+#ifdef IS_RP3D_ALLOCATION_TRACING_ENABLED
+
+// Use this macro to tag the allocations of the current thread until the end of the current scope
+#define RP3D_ALLOCATION_TAG(tag) reactphysics3d::AllocationTagScope allocationTagScope(tag)
+
+// Use this macro to record an allocation of a given allocator type
+#define RP3D_TRACE_ALLOCATION(allocationType, size) \
+    reactphysics3d::AllocationTracer::recordAllocation(reactphysics3d::MemoryManager::AllocationType::allocationType, size)
+
+#else
+
+// Empty macros in case the allocation tracing is not enabled
+#define RP3D_ALLOCATION_TAG(tag)
+#define RP3D_TRACE_ALLOCATION(allocationType, size)
+
+#endif
+
+#endif
@@ -29,6 +29,7 @@
 // Libraries
 #include <reactphysics3d/memory/MemoryAllocator.h>
 #include <cstdlib>
+#include <cstddef>
 #include <iostream>
 
 /// ReactPhysics3D namespace
@@ -59,6 +60,28 @@ class DefaultAllocator : public MemoryAllocator {
         virtual void release(void* pointer, size_t /*size*/) override {
             std::free(pointer);
         }
+
+        /// Allocate memory of a given size (in bytes) aligned on a given alignment.
+        /// The memory returned by malloc() is already aligned for the fundamental types.
+        virtual void* allocate(size_t size, size_t alignment) override {
+
+            if (alignment <= alignof(std::max_align_t)) {
+                return allocate(size);
+            }
+
+            return MemoryAllocator::allocate(size, alignment);
+        }
+
+        /// Release previously allocated memory with the allocate(size, alignment) method
+        virtual void release(void* pointer, size_t size, size_t alignment) override {
+
+            if (alignment <= alignof(std::max_align_t)) {
+                release(pointer, size);
+                return;
+            }
+
+            MemoryAllocator::release(pointer, size, alignment);
+        }
 };
 
 }
@@ -90,14 +90,23 @@ class HeapAllocator : public MemoryAllocator {
         // -------------------- Attributes -------------------- //
 
         // Mutex
-        std::mutex mMutex;
+        mutable std::mutex mMutex;
 
         /// Base memory allocator
         MemoryAllocator& mBaseAllocator;
 
+        /// Size (in bytes) of the memory to reserve on the first allocation
+        size_t mInitAllocatedMemory;
+
         /// Allocated memory (in bytes)
         size_t mAllocatedMemory;
 
+        /// Memory (in bytes) of the memory units that are currently allocated
+        size_t mUsedMemory;
+
+        /// Largest memory (in bytes) of the allocated memory units so far
+        size_t mPeakUsedMemory;
+
         /// Pointer to the first memory unit of the linked-list
         MemoryUnitHeader* mMemoryUnits;
 
@@ -143,6 +152,9 @@ class HeapAllocator : public MemoryAllocator {
 
         /// Release previously allocated memory.
         virtual void release(void* pointer, size_t size) override;
+
+        /// Return the memory usage of the allocator
+        virtual MemoryUsage getMemoryUsage() const override;
 };
 
 }
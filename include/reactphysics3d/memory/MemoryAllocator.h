@@ -28,6 +28,9 @@
 
 // Libraries
 #include <cstring>
+#include <cstdint>
+#include <cassert>
+#include <reactphysics3d/memory/MemoryUsage.h>
 
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -55,6 +58,38 @@ class MemoryAllocator {
 
         /// Release previously allocated memory.
         virtual void release(void* pointer, size_t size)=0;
+
+        /// Allocate memory of a given size (in bytes) aligned on a given alignment (power of two)
+        /// and return a pointer to the allocated memory. By default, a larger memory area is
+        /// allocated and the pointer to its beginning is stored just before the aligned memory.
+        virtual void* allocate(size_t size, size_t alignment) {
+
+            assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+            void* memory = allocate(size + alignment - 1 + sizeof(void*));
+            if (memory == nullptr) return nullptr;
+
+            const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory) + sizeof(void*);
+            void* alignedMemory = reinterpret_cast<void*>((address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1));
+            memcpy(static_cast<unsigned char*>(alignedMemory) - sizeof(void*), &memory, sizeof(void*));
+
+            return alignedMemory;
+        }
+
+        /// Release previously allocated memory with the allocate(size, alignment) method
+        virtual void release(void* pointer, size_t size, size_t alignment) {
+
+            void* memory;
+            memcpy(&memory, static_cast<unsigned char*>(pointer) - sizeof(void*), sizeof(void*));
+
+            release(memory, size + alignment - 1 + sizeof(void*));
+        }
+
+        /// Return the memory usage of the allocator. By default, the memory usage is not
+        /// tracked and zero is returned.
+        virtual MemoryUsage getMemoryUsage() const {
+            return MemoryUsage();
+        }
 };
 
 }
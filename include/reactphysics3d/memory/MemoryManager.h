@@ -30,6 +30,7 @@
 #include <reactphysics3d/memory/DefaultAllocator.h>
 #include <reactphysics3d/memory/PoolAllocator.h>
 #include <reactphysics3d/memory/HeapAllocator.h>
+#include <reactphysics3d/memory/TLSFHeapAllocator.h>
 #include <reactphysics3d/memory/SingleFrameAllocator.h>
 
 /// Namespace ReactPhysics3D
@@ -42,7 +43,9 @@ class MemoryAllocator;
 /**
  * The memory manager is used to store the different memory allocators that are used
  * by the library. The base allocator is either the default allocator (malloc/free) of a custom
- * allocated specified by the user. The HeapAllocator is used on top of the base allocator.
+ * allocated specified by the user. The heap allocator is used on top of the base allocator. It is
+ * either the TLSFHeapAllocator (constant time allocation and release, used by default) or the
+ * first-fit HeapAllocator.
  * The SingleFrameAllocator is used for memory that is allocated only during a frame and the PoolAllocator
  * is used to allocated objects of small size. Both SingleFrameAllocator and PoolAllocator will fall back to
  * HeapAllocator if an allocation request cannot be fulfilled.
@@ -57,8 +60,14 @@ class MemoryManager {
        /// Pointer to the base memory allocator to use
        MemoryAllocator* mBaseAllocator;
 
-       /// Memory heap allocator
-       HeapAllocator mHeapAllocator;
+       /// First-fit memory heap allocator
+       HeapAllocator mFirstFitHeapAllocator;
+
+       /// Two-level segregated fit memory heap allocator
+       TLSFHeapAllocator mTLSFHeapAllocator;
+
+       /// Selected memory heap allocator
+       MemoryAllocator& mHeapAllocator;
 
        /// Memory pool allocator
        PoolAllocator mPoolAllocator;
@@ -68,6 +77,12 @@ class MemoryManager {
 
     public:
 
+       /// Type of the memory heap allocator
+       enum class HeapAllocatorType {
+           FirstFit,    // First-fit heap allocator with a linear search of free memory
+           TLSF,        // Two-level segregated fit heap allocator with constant time operations
+       };
+
         /// Memory allocation types
        enum class AllocationType {
            Base, 	// Base memory allocator
@@ -77,7 +92,8 @@ class MemoryManager {
        };
 
        /// Constructor
-       MemoryManager(MemoryAllocator* baseAllocator, size_t initAllocatedMemory = 0);
+       MemoryManager(MemoryAllocator* baseAllocator, HeapAllocatorType heapAllocatorType = HeapAllocatorType::TLSF,
+                     size_t initAllocatedMemory = 0);
 
        /// Destructor
        ~MemoryManager() = default;
@@ -95,10 +111,13 @@ class MemoryManager {
         SingleFrameAllocator& getSingleFrameAllocator();
 
         /// Return the heap allocator
-        HeapAllocator& getHeapAllocator();
+        MemoryAllocator& getHeapAllocator();
 
         /// Reset the single frame allocator
         void resetFrameAllocator();
+
+        /// Return the memory usage of the allocator of a given type
+        MemoryUsage getMemoryUsage(AllocationType allocationType) const;
 };
 
 // Allocate memory of a given type
@@ -136,7 +155,7 @@ RP3D_FORCE_INLINE SingleFrameAllocator& MemoryManager::getSingleFrameAllocator()
 }
 
 // Return the heap allocator
-RP3D_FORCE_INLINE HeapAllocator& MemoryManager::getHeapAllocator() {
+RP3D_FORCE_INLINE MemoryAllocator& MemoryManager::getHeapAllocator() {
    return mHeapAllocator;
 }
 
@@ -145,6 +164,21 @@ RP3D_FORCE_INLINE void MemoryManager::resetFrameAllocator() {
    mSingleFrameAllocator.reset();
 }
 
+// Return the memory usage of the allocator of a given type
+/// The memory usage of the base allocator is only available if it overrides the
+/// MemoryAllocator::getMemoryUsage() method (this is not the case of the default allocator).
+RP3D_FORCE_INLINE MemoryUsage MemoryManager::getMemoryUsage(AllocationType allocationType) const {
+
+    switch (allocationType) {
+       case AllocationType::Base: return mBaseAllocator->getMemoryUsage();
+       case AllocationType::Pool: return mPoolAllocator.getMemoryUsage();
+       case AllocationType::Heap: return mHeapAllocator.getMemoryUsage();
+       case AllocationType::Frame: return mSingleFrameAllocator.getMemoryUsage();
+    }
+
+    return MemoryUsage();
+}
+
 }
 
 #endif
@@ -0,0 +1,72 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_MEMORY_USAGE_H
+#define REACTPHYSICS3D_MEMORY_USAGE_H
+
+// Libraries
+#include <cstddef>
+#include <string>
+#include <sstream>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Structure MemoryUsage
+/**
+ * This structure describes the memory used by a memory allocator or by a part of the
+ * library. The reserved memory is the memory obtained from the underlying allocator
+ * and the used memory is the part of it that currently holds data. The peak used
+ * memory is the largest used memory observed so far (high-water mark).
+ */
+struct MemoryUsage {
+
+    /// Memory (in bytes) reserved from the underlying allocator
+    size_t reservedBytes;
+
+    /// Memory (in bytes) currently used
+    size_t usedBytes;
+
+    /// Largest memory (in bytes) used so far
+    size_t peakUsedBytes;
+
+    /// Constructor
+    MemoryUsage(size_t reserved = 0, size_t used = 0, size_t peakUsed = 0)
+        : reservedBytes(reserved), usedBytes(used), peakUsedBytes(peakUsed) {
+
+    }
+
+    /// Return a string with the memory usage
+    std::string to_string() const {
+
+        std::stringstream ss;
+        ss << "reserved=" << reservedBytes << " used=" << usedBytes << " peakUsed=" << peakUsedBytes;
+        return ss.str();
+    }
+};
+
+}
+
+#endif
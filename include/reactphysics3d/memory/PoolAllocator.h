@@ -29,7 +29,9 @@
 // Libraries
 #include <reactphysics3d/configuration.h>
 #include <reactphysics3d/memory/MemoryAllocator.h>
+#include <atomic>
 #include <mutex>
+#include <thread>
 
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -40,11 +42,36 @@ namespace reactphysics3d {
  * It allows us to allocate small blocks of memory (smaller or equal to 1024 bytes)
  * efficiently. This implementation is inspired by the small block allocator
  * described here : http://www.codeproject.com/useritems/Small_Block_Allocator.asp
+ * Each thread that uses the allocator has its own cache (magazine) of free memory
+ * units for each heap. Memory units are allocated from and released into this cache
+ * without any lock. The shared heaps are only locked to refill a cache or to take
+ * back memory units from a cache that holds too many of them, by batches of units.
  */
 class PoolAllocator : public MemoryAllocator {
 
     private :
 
+        // -------------------- Constants -------------------- //
+
+        /// Number of heaps
+        static const int NB_HEAPS = 128;
+
+        /// Maximum memory unit size. An allocation request of a size smaller or equal to
+        /// this size will be handled using the small block allocator. However, for an
+        /// allocation request larger than the maximum block size, the standard malloc()
+        /// will be used.
+        static const size_t MAX_UNIT_SIZE = 1024;
+
+        /// Size a memory chunk
+        static const size_t BLOCK_SIZE = 16 * MAX_UNIT_SIZE;
+
+        /// Number of memory units moved at once between a thread cache and a shared heap
+        static const uint32 NB_UNITS_PER_BATCH = 32;
+
+        /// Maximum number of threads with their own cache. Other threads
+        /// directly use the shared heaps.
+        static const uint32 MAX_NB_THREAD_CACHES = 16;
+
         // -------------------- Internal Classes -------------------- //
 
         // Structure MemoryUnit
@@ -76,19 +103,38 @@ class PoolAllocator : public MemoryAllocator {
                 MemoryUnit* memoryUnits;
         };
 
-        // -------------------- Constants -------------------- //
+        // Structure ThreadCache
+        /**
+         * Cache of free memory units of each heap used by a single thread
+         */
+        struct ThreadCache {
 
-        /// Number of heaps
-        static const int NB_HEAPS = 128;
+            public :
 
-        /// Maximum memory unit size. An allocation request of a size smaller or equal to
-        /// this size will be handled using the small block allocator. However, for an
-        /// allocation request larger than the maximum block size, the standard malloc()
-        /// will be used.
-        static const size_t MAX_UNIT_SIZE = 1024;
+                /// Pointers to the first free memory unit of the cache for each heap
+                MemoryUnit* freeMemoryUnits[NB_HEAPS];
 
-        /// Size a memory chunk
-        static const size_t BLOCK_SIZE = 16 * MAX_UNIT_SIZE;
+                /// Number of free memory units in the cache for each heap
+                uint32 nbFreeMemoryUnits[NB_HEAPS];
+
+                /// Memory (in bytes) allocated by the thread minus the memory it has released. This
+                /// is only modified by the owner thread but can be read by any thread. It can wrap
+                /// around if the thread releases memory allocated by other threads.
+                std::atomic<size_t> usedMemory;
+        };
+
+        // Structure ThreadCacheIndex
+        /**
+         * Cache of the current thread in the last pool allocator it has used
+         */
+        struct ThreadCacheIndex {
+
+            /// Unique identifier of the allocator
+            uint64 allocatorId;
+
+            /// Index of the cache of the thread in this allocator
+            uint32 cacheIndex;
+        };
 
         // -------------------- Attributes -------------------- //
 
@@ -99,11 +145,12 @@ class PoolAllocator : public MemoryAllocator {
         /// corresponding heap we will use for the allocation.
         static int mMapSizeToHeapIndex[MAX_UNIT_SIZE + 1];
 
-        /// True if the mMapSizeToHeapIndex array has already been initialized
-        static bool isMapSizeToHeadIndexInitialized;
+        /// Flag used to initialize the mUnitSizes and mMapSizeToHeapIndex arrays only once
+        /// (allocators can be created concurrently by several threads)
+        static std::once_flag mStaticTablesInitFlag;
 
         /// Mutex
-        std::mutex mMutex;
+        mutable std::mutex mMutex;
 
         /// Base memory allocator
         MemoryAllocator& mBaseAllocator;
@@ -120,14 +167,64 @@ class PoolAllocator : public MemoryAllocator {
         /// Current number of used memory blocks
         uint mNbCurrentMemoryBlocks;
 
+        /// Memory (in bytes) of the memory units allocated by the threads without cache
+        size_t mSharedUsedMemory;
+
+        /// Memory (in bytes) of the allocations larger than the maximum memory unit size
+        std::atomic<size_t> mLargeAllocatedMemory;
+
+        /// Largest used memory (in bytes) observed so far
+        mutable size_t mPeakUsedMemory;
+
+        /// Unique identifier of this allocator
+        const uint64 mId;
+
+        /// Caches of the threads
+        ThreadCache* mThreadCaches[MAX_NB_THREAD_CACHES];
+
+        /// Threads that own the caches
+        std::atomic<std::thread::id> mThreadCacheOwners[MAX_NB_THREAD_CACHES];
+
+        /// Number of caches that have been given to a thread
+        std::atomic<uint32> mNbUsedThreadCaches;
+
+        /// Number of allocators created so far (used to create unique identifiers)
+        static std::atomic<uint64> mNbCreatedAllocators;
+
+        /// Cache of the current thread
+        static thread_local ThreadCacheIndex mThreadCacheIndex;
+
 #ifndef NDEBUG
         /// This variable is incremented by one when the allocate() method has been
         /// called and decreased by one when the release() method has been called.
         /// This variable is used in debug mode to check that the allocate() and release()
         /// methods are called the same number of times
-        int mNbTimesAllocateMethodCalled;
+        std::atomic<int> mNbTimesAllocateMethodCalled;
 #endif
 
+        // -------------------- Methods -------------------- //
+
+        /// Initialize the static tables of the unit sizes and of the heap index of each size
+        static void initStaticTables();
+
+        /// Return the cache of the current thread (or nullptr if there is no cache left)
+        ThreadCache* getThreadCache();
+
+        /// Find or create the cache of the current thread
+        ThreadCache* findThreadCache();
+
+        /// Allocate a new memory block and add its memory units into the free units of a heap
+        void allocateMemoryBlock(int indexHeap);
+
+        /// Move a batch of free memory units from a shared heap into a thread cache
+        void refillThreadCache(ThreadCache* cache, int indexHeap);
+
+        /// Move a batch of free memory units from a thread cache back into a shared heap
+        void flushThreadCache(ThreadCache* cache, int indexHeap);
+
+        /// Compute the memory currently used and update the largest used memory
+        size_t updateUsedMemory() const;
+
     public :
 
         // -------------------- Methods -------------------- //
@@ -147,8 +244,28 @@ class PoolAllocator : public MemoryAllocator {
 
         /// Release previously allocated memory.
         virtual void release(void* pointer, size_t size) override;
+
+        /// Allocate memory of a given size (in bytes) aligned on a given alignment
+        virtual void* allocate(size_t size, size_t alignment) override;
+
+        /// Release previously allocated memory with the allocate(size, alignment) method
+        virtual void release(void* pointer, size_t size, size_t alignment) override;
+
+        /// Return the memory usage of the allocator
+        virtual MemoryUsage getMemoryUsage() const override;
 };
 
+// Return the cache of the current thread (or nullptr if there is no cache left)
+RP3D_FORCE_INLINE PoolAllocator::ThreadCache* PoolAllocator::getThreadCache() {
+
+    // Fast path: the thread has already used this allocator last time
+    if (mThreadCacheIndex.allocatorId == mId) {
+        return mThreadCacheIndex.cacheIndex < MAX_NB_THREAD_CACHES ? mThreadCaches[mThreadCacheIndex.cacheIndex] : nullptr;
+    }
+
+    return findThreadCache();
+}
+
 }
 
 #endif
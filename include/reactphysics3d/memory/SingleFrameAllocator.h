@@ -29,7 +29,9 @@
 // Libraries
 #include <reactphysics3d/memory/MemoryAllocator.h>
 #include <reactphysics3d/configuration.h>
-#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <thread>
 
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -37,44 +39,143 @@ namespace reactphysics3d {
 // Class SingleFrameAllocator
 /**
  * This class represent a memory allocator used to efficiently allocate
- * memory on the heap that is used during a single frame.
+ * memory on the heap that is used during a single frame. Each thread that
+ * allocates memory gets its own arena where memory is allocated by simply
+ * bumping a pointer, without any lock. When the buffer of an arena is full,
+ * a new chunk of memory is allocated with the base allocator and pushed
+ * into a lock-free list of chunks shared by all the arenas. All the
+ * memory of a frame is released at once with the reset() method that also
+ * resizes the buffers of the arenas according to the memory used during
+ * the frame. The reset() method must not be called while other threads
+ * allocate memory from this allocator.
  */
 class SingleFrameAllocator : public MemoryAllocator {
 
     private :
 
+        // -------------------- Internal Classes -------------------- //
+
+        // Structure FrameArena
+        /**
+         * Bump allocation arena used by a single thread. Each arena is aligned
+         * on its own cache line to limit false sharing between threads.
+         */
+        struct alignas(64) FrameArena {
+
+            /// Thread that owns this arena
+            std::atomic<std::thread::id> ownerThread;
+
+            /// Pointer to the beginning of the buffer of the arena
+            char* memoryBufferStart;
+
+            /// Total size (in bytes) of the buffer of the arena
+            size_t totalSizeBytes;
+
+            /// Next available memory location in the current buffer or chunk
+            char* currentLocation;
+
+            /// End of the current buffer or chunk
+            char* endLocation;
+
+            /// Number of bytes allocated in this arena since the last reset
+            size_t nbAllocatedBytes;
+
+            /// Current number of frames since we detected too much memory
+            /// is allocated
+            size_t nbFramesTooMuchAllocated;
+        };
+
+        static_assert(alignof(FrameArena) == 64, "A frame arena must be aligned on a cache line");
+        static_assert(sizeof(FrameArena) == 64, "A frame arena must fit in a single cache line");
+
+        // Structure ChunkHeader
+        /**
+         * Header of a chunk of memory allocated when an arena is full
+         */
+        struct alignas(16) ChunkHeader {
+
+            /// Next chunk in the list of chunks
+            ChunkHeader* nextChunk;
+
+            /// Total size (in bytes) of the chunk (including this header)
+            size_t size;
+        };
+
+        // Structure ThreadArenaCache
+        /**
+         * Arena of the current thread in the last allocator it has used
+         */
+        struct ThreadArenaCache {
+
+            /// Unique identifier of the allocator
+            uint64 allocatorId;
+
+            /// Index of the arena of the thread in this allocator
+            uint32 arenaIndex;
+        };
+
         // -------------------- Constants -------------------- //
 
         /// Number of frames to wait before shrinking the allocated
         /// memory if too much is allocated
         static const int NB_FRAMES_UNTIL_SHRINK = 120;
 
-        /// Initial size (in bytes) of the single frame allocator
+        /// Maximum number of threads with their own arena. Other threads
+        /// allocate each memory request in a new chunk.
+        static const uint32 MAX_NB_ARENAS = 16;
+
+        /// Alignment (in bytes) of all the allocated memory
+        static const size_t ALIGNMENT = 16;
+
+        /// Initial size (in bytes) of the buffer of an arena
         size_t INIT_SINGLE_FRAME_ALLOCATOR_NB_BYTES = 1048576; // 1Mb
 
         // -------------------- Attributes -------------------- //
 
-        /// Mutex
-        std::mutex mMutex;
-
         /// Reference to the base memory allocator
         MemoryAllocator& mBaseAllocator;
 
-        /// Total size (in bytes) of memory of the allocator
-        size_t mTotalSizeBytes;
+        /// Unique identifier of this allocator
+        const uint64 mId;
 
-        /// Pointer to the beginning of the allocated memory block
-        char* mMemoryBufferStart;
+        /// Arenas of the threads (allocated aligned on a cache line because the
+        /// allocator itself is not necessarily aligned on a cache line)
+        FrameArena* mArenas;
 
-        /// Pointer to the next available memory location in the buffer
-        size_t mCurrentOffset;
+        /// Number of arenas that have been given to a thread
+        std::atomic<uint32> mNbUsedArenas;
 
-        /// Current number of frames since we detected too much memory
-        /// is allocated
-        size_t mNbFramesTooMuchAllocated;
+        /// Lock-free list of the chunks allocated during the current frame
+        std::atomic<ChunkHeader*> mChunks;
 
-        /// True if we need to allocate more memory in the next reset() call
-        bool mNeedToAllocatedMore;
+        /// Memory (in bytes) allocated during the current frame by the threads without arena
+        std::atomic<size_t> mChunksAllocatedBytes;
+
+        /// Largest memory (in bytes) allocated during a single frame so far
+        size_t mPeakUsedMemory;
+
+        /// Number of allocators created so far (used to create unique identifiers)
+        static std::atomic<uint64> mNbCreatedAllocators;
+
+        /// Arena of the current thread
+        static thread_local ThreadArenaCache mThreadArenaCache;
+
+        // -------------------- Methods -------------------- //
+
+        /// Return the arena of the current thread (or nullptr if there is no arena left)
+        FrameArena* getThreadArena();
+
+        /// Find or create the arena of the current thread
+        FrameArena* findThreadArena();
+
+        /// Allocate a new chunk of memory and add it into the list of chunks
+        char* allocateChunk(size_t size);
+
+        /// Return the first memory location after a given one with a given alignment
+        static char* alignLocation(char* location, size_t alignment);
+
+        /// Return the memory (in bytes) allocated during the current frame
+        size_t computeUsedMemory() const;
 
     public :
 
@@ -95,10 +196,36 @@ class SingleFrameAllocator : public MemoryAllocator {
         /// Release previously allocated memory.
         virtual void release(void* pointer, size_t size) override;
 
+        /// Allocate memory of a given size (in bytes) aligned on a given alignment
+        virtual void* allocate(size_t size, size_t alignment) override;
+
+        /// Release previously allocated memory with the allocate(size, alignment) method
+        virtual void release(void* pointer, size_t size, size_t alignment) override;
+
         /// Reset the marker of the current allocated memory
         virtual void reset();
+
+        /// Return the memory usage of the allocator
+        virtual MemoryUsage getMemoryUsage() const override;
 };
 
+// Return the arena of the current thread (or nullptr if there is no arena left)
+RP3D_FORCE_INLINE SingleFrameAllocator::FrameArena* SingleFrameAllocator::getThreadArena() {
+
+    // Fast path: the thread has already used this allocator last time
+    if (mThreadArenaCache.allocatorId == mId) {
+        return mThreadArenaCache.arenaIndex < MAX_NB_ARENAS ? &mArenas[mThreadArenaCache.arenaIndex] : nullptr;
+    }
+
+    return findThreadArena();
+}
+
+// Return the first memory location after a given one with a given alignment
+RP3D_FORCE_INLINE char* SingleFrameAllocator::alignLocation(char* location, size_t alignment) {
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(location);
+    return location + (((address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1)) - address);
+}
+
 }
 
 #endif
@@ -0,0 +1,259 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_TLSF_HEAP_ALLOCATOR_H
+#define REACTPHYSICS3D_TLSF_HEAP_ALLOCATOR_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/memory/MemoryAllocator.h>
+#include <cassert>
+#include <mutex>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class TLSFHeapAllocator
+/**
+ * This class is a heap allocator based on the Two-Level Segregated Fit (TLSF) algorithm.
+ * Free blocks are stored in segregated free lists indexed by a first level (power of two
+ * range of the size) and a second level (linear subdivision of this range). Two bitmaps
+ * tell which free lists are not empty so that a suitable free block is found with a couple
+ * of bit scan instructions. Allocation and release are therefore done in constant time,
+ * whatever the number of blocks in the heap. Released blocks are immediately merged with
+ * their free neighbour blocks to limit fragmentation. The memory is reserved by large chunks
+ * from the base allocator and only given back to it when the allocator is destroyed.
+ */
+class TLSFHeapAllocator : public MemoryAllocator {
+
+    private :
+
+        // -------------------- Internal Classes -------------------- //
+
+        // Structure BlockHeader
+        /**
+         * Represent the header of a memory block in the heap. The memory of
+         * the block immediately follows its header.
+         */
+        struct alignas(16) BlockHeader {
+
+            public :
+
+                // -------------------- Attributes -------------------- //
+
+                /// Size in bytes of the memory of the block (without the header)
+                size_t size;
+
+                /// Pointer to the previous block in the same chunk of memory
+                BlockHeader* previousPhysicalBlock;
+
+                /// Pointer to the next block in the same free list (if the block is free)
+                BlockHeader* nextFreeBlock;
+
+                /// Pointer to the previous block in the same free list (if the block is free)
+                BlockHeader* previousFreeBlock;
+
+                /// True if the block is currently free
+                bool isFree;
+
+                /// True if this is the last block of its chunk of memory
+                bool isLastPhysicalBlock;
+        };
+
+        // Structure ChunkHeader
+        /**
+         * Represent the header of a chunk of memory allocated with the base allocator
+         */
+        struct alignas(16) ChunkHeader {
+
+            /// Pointer to the next chunk
+            ChunkHeader* nextChunk;
+
+            /// Total size in bytes of the chunk (including this header)
+            size_t size;
+        };
+
+        // -------------------- Constants -------------------- //
+
+        /// Alignment (in bytes) of all the allocated memory blocks
+        static const size_t ALIGNMENT = 16;
+
+        /// Minimum size (in bytes) of a memory block
+        static const size_t MIN_BLOCK_SIZE = 16;
+
+        /// Log2 of the number of second level subdivisions
+        static const uint32 SL_INDEX_COUNT_LOG2 = 5;
+
+        /// Number of second level subdivisions
+        static const uint32 SL_INDEX_COUNT = 1 << SL_INDEX_COUNT_LOG2;
+
+        /// Log2 of the size below which blocks are all stored in the first level zero
+        static const uint32 FL_INDEX_SHIFT = SL_INDEX_COUNT_LOG2 + 4;
+
+        /// Blocks smaller than this size (in bytes) are stored in the first level zero
+        static const size_t SMALL_BLOCK_SIZE = size_t(1) << FL_INDEX_SHIFT;
+
+        /// Log2 of the largest supported block size
+        static const uint32 FL_INDEX_MAX = 30;
+
+        /// Number of first level ranges
+        static const uint32 FL_INDEX_COUNT = FL_INDEX_MAX - FL_INDEX_SHIFT + 1;
+
+        /// Allocations of this size or larger are directly forwarded to the base allocator
+        static const size_t LARGE_ALLOCATION_SIZE = size_t(1) << (FL_INDEX_MAX - 1);
+
+        /// Default size (in bytes) of the first chunk of memory
+        static const size_t INIT_ALLOCATED_SIZE = 5 * 1048576;
+
+        // -------------------- Attributes -------------------- //
+
+        /// Mutex
+        mutable std::mutex mMutex;
+
+        /// Base memory allocator
+        MemoryAllocator& mBaseAllocator;
+
+        /// Size (in bytes) of the first chunk of memory to reserve
+        size_t mInitAllocatedMemory;
+
+        /// Allocated memory (in bytes)
+        size_t mAllocatedMemory;
+
+        /// Memory (in bytes) of the large allocations forwarded to the base allocator
+        size_t mLargeAllocatedMemory;
+
+        /// Memory (in bytes) of the blocks that are currently allocated
+        size_t mUsedMemory;
+
+        /// Largest memory (in bytes) of the allocated blocks so far
+        size_t mPeakUsedMemory;
+
+        /// Linked-list of the chunks of memory allocated with the base allocator
+        ChunkHeader* mChunks;
+
+        /// Bitmap of the first level ranges that contain a non-empty free list
+        uint32 mFirstLevelBitmap;
+
+        /// Bitmaps of the non-empty free lists of each first level range
+        uint32 mSecondLevelBitmaps[FL_INDEX_COUNT];
+
+        /// Heads of the segregated free lists
+        BlockHeader* mFreeBlocks[FL_INDEX_COUNT][SL_INDEX_COUNT];
+
+#ifndef NDEBUG
+        /// This variable is incremented by one when the allocate() method has been
+        /// called and decreased by one when the release() method has been called.
+        /// This variable is used in debug mode to check that the allocate() and release()
+        /// methods are called the same number of times
+        int mNbTimesAllocateMethodCalled;
+#endif
+
+        // -------------------- Methods -------------------- //
+
+        /// Return the index of the least significant set bit of a non-zero value
+        static uint32 findFirstSetBit(uint32 value);
+
+        /// Return the index of the most significant set bit of a non-zero value
+        static uint32 findLastSetBit(size_t value);
+
+        /// Compute the first and second level indices of the free list of a given block size
+        static void computeFreeListIndices(size_t size, uint32& firstLevelIndex, uint32& secondLevelIndex);
+
+        /// Return a pointer to the memory of a block
+        static void* getBlockMemory(BlockHeader* block);
+
+        /// Return the block that physically follows a given block in its chunk
+        static BlockHeader* getNextPhysicalBlock(BlockHeader* block);
+
+        /// Insert a free block into its free list
+        void insertFreeBlock(BlockHeader* block);
+
+        /// Remove a free block from its free list
+        void removeFreeBlock(BlockHeader* block);
+
+        /// Find and remove a free block with a memory size of at least "size" bytes
+        BlockHeader* findFreeBlock(size_t size);
+
+        /// Split a block so that it keeps "size" bytes and put the left over space into a free block
+        void splitBlock(BlockHeader* block, size_t size);
+
+        /// Reserve a new chunk of memory that contains a free block of at least "size" bytes
+        void reserve(size_t size);
+
+        /// Update the largest used memory with the current used memory
+        void updatePeakUsedMemory();
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        TLSFHeapAllocator(MemoryAllocator& baseAllocator, size_t initAllocatedMemory = 0);
+
+        /// Destructor
+        virtual ~TLSFHeapAllocator() override;
+
+        /// Assignment operator
+        TLSFHeapAllocator& operator=(TLSFHeapAllocator& allocator) = delete;
+
+        /// Allocate memory of a given size (in bytes) and return a pointer to the
+        /// allocated memory.
+        virtual void* allocate(size_t size) override;
+
+        /// Release previously allocated memory.
+        virtual void release(void* pointer, size_t size) override;
+
+        /// Allocate memory of a given size (in bytes) aligned on a given alignment
+        virtual void* allocate(size_t size, size_t alignment) override;
+
+        /// Release previously allocated memory with the allocate(size, alignment) method
+        virtual void release(void* pointer, size_t size, size_t alignment) override;
+
+        /// Return the total size (in bytes) of the memory reserved from the base allocator
+        size_t getAllocatedMemory() const;
+
+        /// Return the memory usage of the allocator
+        virtual MemoryUsage getMemoryUsage() const override;
+};
+
+// Return a pointer to the memory of a block
+RP3D_FORCE_INLINE void* TLSFHeapAllocator::getBlockMemory(BlockHeader* block) {
+    return static_cast<void*>(reinterpret_cast<unsigned char*>(block) + sizeof(BlockHeader));
+}
+
+// Return the block that physically follows a given block in its chunk
+RP3D_FORCE_INLINE TLSFHeapAllocator::BlockHeader* TLSFHeapAllocator::getNextPhysicalBlock(BlockHeader* block) {
+    assert(!block->isLastPhysicalBlock);
+    return reinterpret_cast<BlockHeader*>(reinterpret_cast<unsigned char*>(block) + sizeof(BlockHeader) + block->size);
+}
+
+// Return the total size (in bytes) of the memory reserved from the base allocator
+RP3D_FORCE_INLINE size_t TLSFHeapAllocator::getAllocatedMemory() const {
+    return mAllocatedMemory;
+}
+
+}
+
+#endif
@@ -65,6 +65,8 @@
 #include <reactphysics3d/constraint/HingeJoint.h>
 #include <reactphysics3d/constraint/FixedJoint.h>
 #include <reactphysics3d/containers/Array.h>
+#include <reactphysics3d/utils/Instrumentation.h>
+#include <reactphysics3d/memory/AllocationTracer.h>
 
 /// Alias to the ReactPhysics3D namespace
 namespace rp3d = reactphysics3d;
@@ -30,6 +30,7 @@
 #include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
 #include <reactphysics3d/containers/LinkedList.h>
 #include <reactphysics3d/containers/Set.h>
+#include <reactphysics3d/containers/Map.h>
 #include <reactphysics3d/components/ColliderComponents.h>
 #include <reactphysics3d/components/TransformComponents.h>
 #include <reactphysics3d/components/RigidBodyComponents.h>
@@ -45,6 +46,7 @@ class CollisionBody;
 class Collider;
 class MemoryManager;
 class Profiler;
+struct CompoundBodyProxy;
 
 // class AABBOverlapCallback
 class AABBOverlapCallback : public DynamicAABBTreeOverlapCallback {
@@ -73,7 +75,7 @@ class BroadPhaseRaycastCallback : public DynamicAABBTreeRaycastCallback {
 
     private :
 
-        const DynamicAABBTree& mDynamicAABBTree;
+        const BroadPhaseSystem& mBroadPhaseSystem;
 
         unsigned short mRaycastWithCategoryMaskBits;
 
@@ -82,9 +84,9 @@ class BroadPhaseRaycastCallback : public DynamicAABBTreeRaycastCallback {
     public:
 
         // Constructor
-        BroadPhaseRaycastCallback(const DynamicAABBTree& dynamicAABBTree, unsigned short raycastWithCategoryMaskBits,
+        BroadPhaseRaycastCallback(const BroadPhaseSystem& broadPhaseSystem, unsigned short raycastWithCategoryMaskBits,
                                   RaycastTest& raycastTest)
-            : mDynamicAABBTree(dynamicAABBTree), mRaycastWithCategoryMaskBits(raycastWithCategoryMaskBits),
+            : mBroadPhaseSystem(broadPhaseSystem), mRaycastWithCategoryMaskBits(raycastWithCategoryMaskBits),
               mRaycastTest(raycastTest) {
 
         }
@@ -97,6 +99,106 @@ class BroadPhaseRaycastCallback : public DynamicAABBTreeRaycastCallback {
 
 };
 
+// Class CompoundRaycastCallback
+/**
+ * Callback called when the AABB of a leaf node of the local tree of a compound
+ * body is hit by a ray. The ray given to the callback is in the local-space of
+ * the body.
+ */
+class CompoundRaycastCallback : public DynamicAABBTreeRaycastCallback {
+
+    private :
+
+        const BroadPhaseSystem& mBroadPhaseSystem;
+
+        /// Local tree of the compound body
+        const DynamicAABBTree& mLocalTree;
+
+        /// Ray in world-space
+        const Ray& mWorldRay;
+
+        unsigned short mRaycastWithCategoryMaskBits;
+
+        RaycastTest& mRaycastTest;
+
+    public:
+
+        /// Smallest positive hit fraction reported (or -1 if no collider has been hit)
+        decimal mHitFraction;
+
+        /// True if the user asked to stop the raycasting
+        bool mIsStopped;
+
+        // Constructor
+        CompoundRaycastCallback(const BroadPhaseSystem& broadPhaseSystem, const DynamicAABBTree& localTree, const Ray& worldRay,
+                                unsigned short raycastWithCategoryMaskBits, RaycastTest& raycastTest)
+            : mBroadPhaseSystem(broadPhaseSystem), mLocalTree(localTree), mWorldRay(worldRay), mRaycastWithCategoryMaskBits(raycastWithCategoryMaskBits),
+              mRaycastTest(raycastTest), mHitFraction(decimal(-1.0)), mIsStopped(false) {
+
+        }
+
+        // Destructor
+        virtual ~CompoundRaycastCallback() override = default;
+
+        // Called for a collider of the compound body that has to be tested for raycast
+        virtual decimal raycastBroadPhaseShape(int32 nodeId, const Ray& ray) override;
+
+};
+
+// Structure CompoundColliderProxy
+/**
+ * Broad-phase data of a collider that belongs to a body in compound mode.
+ */
+struct CompoundColliderProxy {
+
+    /// Proxy of the body of the collider (nullptr if the slot is free)
+    CompoundBodyProxy* bodyProxy;
+
+    /// Pointer to the collider
+    Collider* collider;
+
+    /// ID of the node of the collider in the local tree of the body
+    int32 localNodeId;
+};
+
+// Structure CompoundBodyProxy
+/**
+ * Broad-phase data of a body in compound mode. The body is represented by a single
+ * node in the broad-phase tree of the world and its colliders are stored in a local
+ * tree with AABBs in the local-space of the body.
+ */
+struct CompoundBodyProxy {
+
+    /// Entity of the body
+    Entity bodyEntity;
+
+    /// ID of the node of the body in the broad-phase tree of the world
+    int32 broadPhaseNodeId;
+
+    /// Tree with the AABBs of the colliders in body-space (the node data is the
+    /// index of the collider in the compound colliders array)
+    DynamicAABBTree localTree;
+
+    /// Indices of the colliders of the body in the compound colliders array
+    Array<uint32> colliderIndices;
+
+    /// Transform of the body the last time the proxy has been updated
+    Transform lastTransform;
+
+    /// True if the local tree has changed since the last update of the proxy
+    bool isDirty;
+
+    /// True if the body has moved (or has changed) since the last broad-phase
+    bool hasMoved;
+
+    /// Constructor
+    CompoundBodyProxy(Entity bodyEntity, MemoryAllocator& allocator)
+        : bodyEntity(bodyEntity), broadPhaseNodeId(-1), localTree(allocator), colliderIndices(allocator),
+          isDirty(true), hasMoved(true) {
+
+    }
+};
+
 // Class BroadPhaseSystem
 /**
  * This class represents the broad-phase collision detection. The
@@ -131,6 +233,29 @@ class BroadPhaseSystem {
         /// Reference to the collision detection object
         CollisionDetectionSystem& mCollisionDetection;
 
+        /// Reference to the base memory allocator
+        MemoryAllocator& mAllocator;
+
+        /// Map a body entity to its proxy for the bodies in compound mode
+        Map<Entity, CompoundBodyProxy*> mCompoundBodies;
+
+        /// Map a node ID of the broad-phase tree to the corresponding compound body proxy
+        Map<int32, CompoundBodyProxy*> mMapNodeIdToCompoundBody;
+
+        /// Colliders of the bodies in compound mode. The broad-phase ID of such a collider
+        /// is its index in this array plus COMPOUND_BROADPHASE_ID_OFFSET
+        Array<CompoundColliderProxy> mCompoundColliders;
+
+        /// Free slots in the compound colliders array
+        Array<uint32> mFreeCompoundColliders;
+
+        /// Overlapping pairs of broad-phase nodes where at least one node is a compound
+        /// body. Those pairs are expanded into pairs of colliders using the local trees.
+        Array<Pair<int32, int32>> mCompoundNodePairs;
+
+        /// Set with the IDs of the pairs in mCompoundNodePairs
+        Set<uint64> mCompoundNodePairsIds;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Pointer to the profiler
@@ -146,8 +271,43 @@ class BroadPhaseSystem {
         /// Update the broad-phase state of some colliders components
         void updateCollidersComponents(uint32 startIndex, uint32 nbItems);
 
+        /// Add a collider of a body in compound mode
+        void addCompoundCollider(Collider* collider);
+
+        /// Remove a collider of a body in compound mode
+        void removeCompoundCollider(Collider* collider);
+
+        /// Update the local AABB of a collider of a body in compound mode
+        void updateCompoundCollider(uint32 colliderComponentIndex, bool forceReInsert);
+
+        /// Update the broad-phase node of a body in compound mode
+        void updateCompoundBody(CompoundBodyProxy* bodyProxy);
+
+        /// Remove the compound node pairs that involve a given broad-phase node
+        void removeCompoundNodePairs(int32 nodeId);
+
+        /// Expand the overlapping node pairs involving compound bodies into collider pairs
+        void computeCompoundOverlappingPairs(MemoryManager& memoryManager, Array<Pair<int32, int32>>& overlappingNodes);
+
+        /// Notify that the collider pairs of a compound node pair need to be tested for overlap
+        void notifyCompoundNodePairToTestOverlap(const CompoundBodyProxy* bodyProxy1, const CompoundBodyProxy* bodyProxy2,
+                                                 int32 otherNodeId);
+
+        /// Report the colliders of a compound body overlapping with an AABB given in the body-space
+        void reportCompoundCollidersOverlappingWithAABB(const CompoundBodyProxy* bodyProxy, const AABB& localAABB,
+                                                        int32 otherBroadPhaseId, Array<int>& localNodes,
+                                                        Array<Pair<int32, int32>>& overlappingNodes) const;
+
     public :
 
+        // -------------------- Constants -------------------- //
+
+        /// Offset of the broad-phase IDs of the colliders of the bodies in compound mode
+        static const int32 COMPOUND_BROADPHASE_ID_OFFSET;
+
+        /// Minimum capacity of the set of moved shapes before its memory can be released
+        static const uint64 MOVED_SHAPES_MIN_CAPACITY_TO_RELEASE;
+
         // -------------------- Methods -------------------- //
 
         /// Constructor
@@ -155,7 +315,7 @@ class BroadPhaseSystem {
                          TransformComponents& transformComponents, RigidBodyComponents& rigidBodyComponents);
 
         /// Destructor
-        ~BroadPhaseSystem() = default;
+        ~BroadPhaseSystem();
 
         /// Deleted copy-constructor
         BroadPhaseSystem(const BroadPhaseSystem& algorithm) = delete;
@@ -169,11 +329,20 @@ class BroadPhaseSystem {
         /// Remove a collider from the broad-phase collision detection
         void removeCollider(Collider* collider);
 
+        /// Reserve memory for a given number of colliders
+        void reserve(uint32 nbColliders);
+
+        /// Compact the nodes of the broad-phase tree and update the broad-phase IDs
+        void compact(Array<int32>& outNewNodeIds);
+
+        /// Return the colliders in the order of their nodes in the broad-phase tree
+        void getCollidersInTreeOrder(Array<Entity>& outColliders) const;
+
         /// Update the broad-phase state of a single collider
         void updateCollider(Entity colliderEntity);
 
-        /// Update the broad-phase state of all the enabled colliders
-        void updateColliders();
+        /// Update the broad-phase state of the colliders that have moved
+        void updateColliders(const Array<Entity>& movedColliders);
 
         /// Add a collider in the array of colliders that have moved in the last simulation step
         /// and that need to be tested again for broad-phase overlapping.
@@ -193,11 +362,41 @@ class BroadPhaseSystem {
         bool testOverlappingShapes(int32 shape1BroadPhaseId, int32 shape2BroadPhaseId) const;
 
         /// Return the fat AABB of a given broad-phase shape
-        const AABB& getFatAABB(int broadPhaseId) const;
+        AABB getFatAABB(int broadPhaseId) const;
+
+        /// Return true if a broad-phase ID is the one of a collider of a body in compound mode
+        static bool isCompoundBroadPhaseId(int broadPhaseId);
+
+        /// Return the number of nodes in the broad-phase tree
+        uint32 getNbBroadPhaseNodes() const;
+
+        /// Return the memory usage of the nodes of the broad-phase tree
+        MemoryUsage getMemoryUsage() const;
+
+        /// Compute the metrics describing the quality of the broad-phase tree
+        DynamicAABBTree::QualityMetrics computeTreeQualityMetrics() const;
+
+        /// Return the number of nodes reinserted in the broad-phase tree since its creation
+        uint64 getNbTreeReinsertions() const;
+
+        /// Return the number of updates of the nodes of the broad-phase tree since its creation
+        uint64 getNbTreeUpdates() const;
+
+        /// Rebuild the broad-phase tree from scratch
+        void rebuildTree();
 
         /// Ray casting method
         void raycast(const Ray& ray, RaycastTest& raycastTest, unsigned short raycastWithCategoryMaskBits) const;
 
+        /// Ray casting against the colliders of a compound body
+        decimal raycastCompoundBody(int32 nodeId, const Ray& ray, RaycastTest& raycastTest,
+                                    unsigned short raycastWithCategoryMaskBits) const;
+
+        // -------------------- Friendship -------------------- //
+
+        friend class BroadPhaseRaycastCallback;
+        friend class CompoundRaycastCallback;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -207,9 +406,42 @@ class BroadPhaseSystem {
 
 };
 
-// Return the fat AABB of a given broad-phase shape
-RP3D_FORCE_INLINE const AABB& BroadPhaseSystem::getFatAABB(int broadPhaseId) const  {
-    return mDynamicAABBTree.getFatAABB(broadPhaseId);
+// Return true if a broad-phase ID is the one of a collider of a body in compound mode
+RP3D_FORCE_INLINE bool BroadPhaseSystem::isCompoundBroadPhaseId(int broadPhaseId) {
+    return broadPhaseId >= COMPOUND_BROADPHASE_ID_OFFSET;
+}
+
+// Return the number of nodes in the broad-phase tree
+RP3D_FORCE_INLINE uint32 BroadPhaseSystem::getNbBroadPhaseNodes() const {
+    return static_cast<uint32>(mDynamicAABBTree.getNbNodes());
+}
+
+// Return the memory usage of the nodes of the broad-phase tree
+/// The local trees of the bodies in compound mode are not included.
+RP3D_FORCE_INLINE MemoryUsage BroadPhaseSystem::getMemoryUsage() const {
+    return mDynamicAABBTree.getMemoryUsage();
+}
+
+// Compute the metrics describing the quality of the broad-phase tree
+/// The local trees of the bodies in compound mode are not included.
+RP3D_FORCE_INLINE DynamicAABBTree::QualityMetrics BroadPhaseSystem::computeTreeQualityMetrics() const {
+    return mDynamicAABBTree.computeQualityMetrics();
+}
+
+// Return the number of nodes reinserted in the broad-phase tree since its creation
+RP3D_FORCE_INLINE uint64 BroadPhaseSystem::getNbTreeReinsertions() const {
+    return mDynamicAABBTree.getNbReinsertions();
+}
+
+// Return the number of updates of the nodes of the broad-phase tree since its creation
+RP3D_FORCE_INLINE uint64 BroadPhaseSystem::getNbTreeUpdates() const {
+    return mDynamicAABBTree.getNbObjectUpdates();
+}
+
+// Rebuild the broad-phase tree from scratch
+/// The broad-phase IDs of the colliders do not change.
+RP3D_FORCE_INLINE void BroadPhaseSystem::rebuildTree() {
+    mDynamicAABBTree.rebuild();
 }
 
 // Remove a collider from the array of colliders that have moved in the last simulation step
@@ -222,6 +454,11 @@ RP3D_FORCE_INLINE void BroadPhaseSystem::removeMovedCollider(int broadPhaseID) {
 
 // Return the collider corresponding to the broad-phase node id in parameter
 RP3D_FORCE_INLINE Collider* BroadPhaseSystem::getColliderForBroadPhaseId(int broadPhaseId) const {
+
+    if (isCompoundBroadPhaseId(broadPhaseId)) {
+        return mCompoundColliders[static_cast<uint32>(broadPhaseId - COMPOUND_BROADPHASE_ID_OFFSET)].collider;
+    }
+
     return static_cast<Collider*>(mDynamicAABBTree.getNodeDataPointer(broadPhaseId));
 }
 
@@ -169,8 +169,8 @@ class CollisionDetectionSystem {
         /// Number of potential contact points in the previous frame
         uint32 mNbPreviousPotentialContactPoints;
 
-        /// Reference to the half-edge structure of the triangle polyhedron
-        HalfEdgeStructure& mTriangleHalfEdgeStructure;
+        /// Largest memory (in bytes) used by the contact pairs, manifolds and points of a frame so far
+        size_t mPeakContactsUsedMemory;
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -243,7 +243,7 @@ class CollisionDetectionSystem {
         /// Create the actual contact manifolds and contacts points (from potential contacts) for a given contact pair
         void createContacts();
 
-        /// Add the contact pairs to the corresponding bodies
+        /// Add the contact pairs involving a CollisionBody into the array of pairs that are not part of islands
         void addContactPairsToBodies();
 
         /// Compute the map from contact pairs ids to contact pair for the next frame
@@ -301,7 +301,7 @@ class CollisionDetectionSystem {
         /// Constructor
         CollisionDetectionSystem(PhysicsWorld* world, ColliderComponents& collidersComponents,
                            TransformComponents& transformComponents, CollisionBodyComponents& collisionBodyComponents, RigidBodyComponents& rigidBodyComponents,
-                           MemoryManager& memoryManager, HalfEdgeStructure& triangleHalfEdgeStructure);
+                           MemoryManager& memoryManager);
 
         /// Destructor
         ~CollisionDetectionSystem() = default;
@@ -321,11 +321,17 @@ class CollisionDetectionSystem {
         /// Remove a collider from the collision detection
         void removeCollider(Collider* collider);
 
+        /// Reserve memory for a given number of colliders, overlapping pairs and contact points
+        void reserve(uint32 nbColliders, uint32 nbOverlappingPairs, uint32 nbContacts);
+
+        /// Compact the broad-phase tree and release the memory that is not used by the pairs and contacts
+        void compact();
+
         /// Update a collider (that has moved for instance)
         void updateCollider(Entity colliderEntity);
 
-        /// Update all the enabled colliders
-        void updateColliders();
+        /// Update the colliders that have moved during the last simulation step
+        void updateColliders(const Array<Entity>& movedColliders);
 
         /// Add a pair of bodies that cannot collide with each other
         void addNoCollisionPair(Entity body1Entity, Entity body2Entity);
@@ -376,6 +382,15 @@ class CollisionDetectionSystem {
         /// Return the world event listener
         EventListener* getWorldEventListener();
 
+        /// Return the memory usage of the broad-phase
+        MemoryUsage getBroadPhaseMemoryUsage() const;
+
+        /// Return the memory usage of the overlapping pairs
+        MemoryUsage getOverlappingPairsMemoryUsage() const;
+
+        /// Return the memory usage of the contact pairs, manifolds and points
+        MemoryUsage getContactsMemoryUsage() const;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -445,9 +460,12 @@ RP3D_FORCE_INLINE void CollisionDetectionSystem::updateCollider(Entity colliderE
     mBroadPhaseSystem.updateCollider(colliderEntity);
 }
 
-// Update all the enabled colliders
-RP3D_FORCE_INLINE void CollisionDetectionSystem::updateColliders() {
-    mBroadPhaseSystem.updateColliders();
+// Update the colliders that have moved during the last simulation step
+/**
+ * @param movedColliders Entities of the colliders of the bodies that have moved
+ */
+RP3D_FORCE_INLINE void CollisionDetectionSystem::updateColliders(const Array<Entity>& movedColliders) {
+    mBroadPhaseSystem.updateColliders(movedColliders);
 }
 
 #ifdef IS_RP3D_PROFILING_ENABLED
@@ -69,6 +69,10 @@ class DynamicsSystem {
         /// Reference to the world gravity vector
         Vector3& mGravity;
 
+        /// Entities of the colliders of the bodies that have moved during the last call
+        /// to updateBodiesState(). Only those colliders need to be updated in the broad-phase.
+        Array<Entity> mMovedColliders;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
         /// Pointer to the profiler
@@ -80,7 +84,7 @@ class DynamicsSystem {
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        DynamicsSystem(PhysicsWorld& world, CollisionBodyComponents& collisionBodyComponents,
+        DynamicsSystem(PhysicsWorld& world, MemoryAllocator& allocator, CollisionBodyComponents& collisionBodyComponents,
                        RigidBodyComponents& rigidBodyComponents, TransformComponents& transformComponents,
                        ColliderComponents& colliderComponents, bool& isGravityEnabled, Vector3& gravity);
 
@@ -109,8 +113,19 @@ class DynamicsSystem {
         /// Reset the split velocities of the bodies
         void resetSplitVelocities();
 
+        /// Return the colliders of the bodies that have moved during the last update of the bodies state
+        const Array<Entity>& getMovedColliders() const;
+
+        /// Reserve memory for a given number of colliders
+        void reserve(uint32 nbColliders);
+
 };
 
+// Return the colliders of the bodies that have moved during the last update of the bodies state
+RP3D_FORCE_INLINE const Array<Entity>& DynamicsSystem::getMovedColliders() const {
+    return mMovedColliders;
+}
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 // Set the profiler
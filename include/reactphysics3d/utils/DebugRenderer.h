@@ -30,6 +30,8 @@
 #include <reactphysics3d/containers/Array.h>
 #include <reactphysics3d/containers/Map.h>
 #include <reactphysics3d/mathematics/mathematics.h>
+#include <reactphysics3d/collision/shapes/AABB.h>
+#include <reactphysics3d/collision/shapes/CollisionShape.h>
 #include <reactphysics3d/engine/EventListener.h>
 #include <string>
 
@@ -37,8 +39,10 @@
 namespace reactphysics3d {
 
 // Forward declarations
+class ConcaveShape;
 class ConcaveMeshShape;
 class ConvexMeshShape;
+class CapsuleShape;
 class HeightFieldShape;
 class Collider;
 class PhysicsWorld;
@@ -51,6 +55,9 @@ class PhysicsWorld;
  * You can use this to render physics debug information in your simulation on top of your object. Note that
  * you should use this only for debugging purpose and you should disable it when you compile the final release
  * version of your application because computing/rendering phyiscs debug information can be expensive.
+ * To reduce this cost, the primitives can be restricted to a view AABB and written directly into packed
+ * vertex buffers provided by the user. The tessellations of the capsule, convex mesh, concave mesh and
+ * height field shapes are cached and only re-transformed at each frame.
  */
 class DebugRenderer : public EventListener {
 
@@ -138,8 +145,46 @@ class DebugRenderer : public EventListener {
             uint32 color3;
 		};
 
+		/// Structure that represents a vertex of the packed vertex buffers of the DebugRenderer
+		struct DebugVertex {
+
+            /// Coordinates of the vertex
+            float x, y, z;
+
+            /// Color of the vertex
+            uint32 color;
+		};
+
     private:
 
+        /// Tessellation of a collision shape in the local-space of the shape
+        struct ShapeTessellation {
+
+            /// Name of the tessellated collision shape
+            CollisionShapeName shapeName;
+
+            /// Minimum local bound of the shape when it has been tessellated
+            Vector3 localMin;
+
+            /// Maximum local bound of the shape when it has been tessellated
+            Vector3 localMax;
+
+            /// Vertices of the tessellation in the local-space of the shape
+            Array<Vector3> vertices;
+
+            /// Indices of the three vertices of each triangle
+            Array<uint32> indices;
+
+            /// True if the tessellation has been used since the last removal of unused tessellations
+            bool isUsed;
+
+            /// Constructor
+            ShapeTessellation(CollisionShapeName shapeName, MemoryAllocator& allocator)
+                :shapeName(shapeName), vertices(allocator), indices(allocator), isUsed(true) {
+
+            }
+        };
+
 		// -------------------- Constants -------------------- //
 
 		/// Number of sectors used to draw a sphere or a capsule
@@ -177,8 +222,53 @@ class DebugRenderer : public EventListener {
         /// Lenght of contact normal
         decimal mContactNormalLength;
 
+        /// True if only the objects overlapping the view AABB are displayed
+        bool mIsViewAABBEnabled;
+
+        /// World-space AABB outside of which nothing is displayed (if enabled)
+        AABB mViewAABB;
+
+        /// Tessellation of a sphere of radius one centered at the origin
+        ShapeTessellation mUnitSphereTessellation;
+
+        /// Map a collision shape with its cached tessellation
+        Map<const CollisionShape*, ShapeTessellation*> mShapeTessellations;
+
+        /// Vertices of the tessellation being drawn, transformed into world-space
+        Array<Vector3> mTransformedVertices;
+
+        /// User buffer where the vertices of the lines are written (null to use the array of lines)
+        DebugVertex* mLinesBuffer;
+
+        /// Maximum number of lines in the lines buffer
+        uint32 mLinesBufferCapacity;
+
+        /// Number of lines written into the lines buffer
+        uint32 mNbBufferLines;
+
+        /// User buffer where the vertices of the triangles are written (null to use the array of triangles)
+        DebugVertex* mTrianglesBuffer;
+
+        /// Maximum number of triangles in the triangles buffer
+        uint32 mTrianglesBufferCapacity;
+
+        /// Number of triangles written into the triangles buffer
+        uint32 mNbBufferTriangles;
+
+        /// Number of lines and triangles that did not fit into the user buffers
+        uint32 mNbDroppedPrimitives;
+
         // -------------------- Methods -------------------- //
 
+        /// Add a line to the output
+        void addLine(const Vector3& point1, const Vector3& point2, uint32 color);
+
+        /// Add a triangle to the output
+        void addTriangle(const Vector3& point1, const Vector3& point2, const Vector3& point3, uint32 color);
+
+        /// Add the triangles of a tessellation whose vertices have been transformed
+        void addTransformedTriangles(const ShapeTessellation& tessellation, uint32 color);
+
 		/// Draw an AABB
 		void drawAABB(const AABB& aabb, uint32 color);
 
@@ -188,20 +278,38 @@ class DebugRenderer : public EventListener {
 		/// Draw a sphere
 		void drawSphere(const Vector3& position, decimal radius, uint32 color);
 
-		/// Draw a capsule
-		void drawCapsule(const Transform& transform, decimal radius, decimal height, uint32 color);
+        /// Draw a cached tessellation with a given local-to-world transform
+        void drawTessellation(const ShapeTessellation& tessellation, const Transform& transform, uint32 color);
 
-		/// Draw a convex mesh
-		void drawConvexMesh(const Transform& transform, const ConvexMeshShape* convexMesh, uint32 color);
+        /// Draw only the triangles of a concave shape that overlap the view AABB
+        void drawConcaveShapeInView(const Transform& transform, const ConcaveShape* concaveShape, uint32 color);
 
-		/// Draw a concave mesh shape
-		void drawConcaveMeshShape(const Transform& transform, const ConcaveMeshShape* concaveMeshShape, uint32 color);
+		/// Draw the collision shape of a collider
+		void drawCollisionShapeOfCollider(const Collider* collider, const AABB& worldAABB, uint32 color);
 
-		/// Draw a height field shape
-		void drawHeightFieldShape(const Transform& transform, const HeightFieldShape* heightFieldShape, uint32 color);
+        /// Compute the tessellation of a sphere of radius one
+        void tessellateUnitSphere(ShapeTessellation& tessellation) const;
 
-		/// Draw the collision shape of a collider
-		void drawCollisionShapeOfCollider(const Collider* collider, uint32 color);
+        /// Compute the tessellation of a capsule
+        void tessellateCapsule(const CapsuleShape* capsuleShape, ShapeTessellation& tessellation) const;
+
+        /// Compute the tessellation of a convex mesh
+        void tessellateConvexMesh(const ConvexMeshShape* convexMesh, ShapeTessellation& tessellation) const;
+
+        /// Compute the tessellation of a concave mesh shape
+        void tessellateConcaveMeshShape(const ConcaveMeshShape* concaveMeshShape, ShapeTessellation& tessellation) const;
+
+        /// Compute the tessellation of a height field shape
+        void tessellateHeightFieldShape(const HeightFieldShape* heightFieldShape, ShapeTessellation& tessellation) const;
+
+        /// Return the cached tessellation of a collision shape (computed again if the shape has changed)
+        const ShapeTessellation& getShapeTessellation(const CollisionShape* collisionShape);
+
+        /// Destroy the cached tessellations that have not been used since the last call
+        void removeUnusedTessellations();
+
+        /// Destroy the cached tessellation of a collision shape (if any)
+        void removeShapeTessellation(const CollisionShape* collisionShape);
 
     public :
 
@@ -249,6 +357,33 @@ class DebugRenderer : public EventListener {
         /// Return the length of contact normal
         void setContactNormalLength(decimal contactNormalLength);
 
+        /// Only display the colliders and contact points that overlap a given world-space AABB
+        void setViewAABB(const AABB& viewAABB);
+
+        /// Display all the colliders and contact points again
+        void disableViewAABB();
+
+        /// Return true if only the objects overlapping the view AABB are displayed
+        bool isViewAABBEnabled() const;
+
+        /// Return the view AABB
+        const AABB& getViewAABB() const;
+
+        /// Write the lines and triangles into packed vertex buffers provided by the user
+        void setOutputBuffers(DebugVertex* linesVertices, uint32 maxNbLines, DebugVertex* trianglesVertices, uint32 maxNbTriangles);
+
+        /// Write the lines and triangles into the arrays of the debug renderer again
+        void removeOutputBuffers();
+
+        /// Return true if the lines and triangles are written into buffers provided by the user
+        bool isUsingOutputBuffers() const;
+
+        /// Return the number of lines and triangles that did not fit into the output buffers
+        uint32 getNbDroppedPrimitives() const;
+
+        /// Return the number of cached collision shape tessellations
+        uint32 getNbCachedTessellations() const;
+
         /// Generate the rendering primitives (triangles, lines, ...) of a physics world
 		void computeDebugRenderingPrimitives(const PhysicsWorld& world);
 
@@ -257,14 +392,18 @@ class DebugRenderer : public EventListener {
 
         /// Called when some contacts occur
         virtual void onContact(const CollisionCallback::CallbackData& callbackData) override;
+
+        // ---------- Friendship ---------- //
+
+        friend class PhysicsCommon;
 };
 
 // Return the number of lines
 /**
- * @return The number of lines in the array of lines to draw
+ * @return The number of lines to draw (in the output buffer if one is used)
  */
 RP3D_FORCE_INLINE uint32 DebugRenderer::getNbLines() const {
-    return static_cast<uint32>(mLines.size());
+    return mLinesBuffer != nullptr ? mNbBufferLines : static_cast<uint32>(mLines.size());
 }
 
 // Return a reference to the array of lines
@@ -285,10 +424,10 @@ RP3D_FORCE_INLINE const DebugRenderer::DebugLine* DebugRenderer::getLinesArray()
 
 // Return the number of triangles
 /**
- * @return The number of triangles in the array of triangles to draw
+ * @return The number of triangles to draw (in the output buffer if one is used)
  */
 RP3D_FORCE_INLINE uint32 DebugRenderer::getNbTriangles() const {
-    return static_cast<uint32>(mTriangles.size());
+    return mTrianglesBuffer != nullptr ? mNbBufferTriangles : static_cast<uint32>(mTriangles.size());
 }
 
 // Return a reference to the array of triangles
@@ -364,6 +503,97 @@ RP3D_FORCE_INLINE void DebugRenderer::setContactNormalLength(decimal contactNorm
     mContactNormalLength = contactNormalLength;
 }
 
+// Only display the colliders and contact points that overlap a given world-space AABB
+/**
+ * The colliders whose world AABB does not overlap the view AABB are skipped and only the
+ * triangles of the concave meshes and height fields that overlap the view are generated.
+ * @param viewAABB The world-space AABB of the region to display
+ */
+RP3D_FORCE_INLINE void DebugRenderer::setViewAABB(const AABB& viewAABB) {
+    mViewAABB = viewAABB;
+    mIsViewAABBEnabled = true;
+}
+
+// Display all the colliders and contact points again
+RP3D_FORCE_INLINE void DebugRenderer::disableViewAABB() {
+    mIsViewAABBEnabled = false;
+}
+
+// Return true if only the objects overlapping the view AABB are displayed
+/**
+ * @return True if the view AABB filter is enabled
+ */
+RP3D_FORCE_INLINE bool DebugRenderer::isViewAABBEnabled() const {
+    return mIsViewAABBEnabled;
+}
+
+// Return the view AABB
+/**
+ * @return The world-space AABB of the region to display
+ */
+RP3D_FORCE_INLINE const AABB& DebugRenderer::getViewAABB() const {
+    return mViewAABB;
+}
+
+// Return true if the lines and triangles are written into buffers provided by the user
+/**
+ * @return True if the output buffers are used instead of the arrays of lines and triangles
+ */
+RP3D_FORCE_INLINE bool DebugRenderer::isUsingOutputBuffers() const {
+    return mLinesBuffer != nullptr;
+}
+
+// Return the number of lines and triangles that did not fit into the output buffers
+/**
+ * @return The number of primitives dropped since the last call to reset()
+ */
+RP3D_FORCE_INLINE uint32 DebugRenderer::getNbDroppedPrimitives() const {
+    return mNbDroppedPrimitives;
+}
+
+// Return the number of cached collision shape tessellations
+/**
+ * @return The number of collision shapes whose tessellation is cached
+ */
+RP3D_FORCE_INLINE uint32 DebugRenderer::getNbCachedTessellations() const {
+    return static_cast<uint32>(mShapeTessellations.size());
+}
+
+// Add a line to the output
+RP3D_FORCE_INLINE void DebugRenderer::addLine(const Vector3& point1, const Vector3& point2, uint32 color) {
+
+    if (mLinesBuffer == nullptr) {
+        mLines.add(DebugLine(point1, point2, color));
+    }
+    else if (mNbBufferLines < mLinesBufferCapacity) {
+        DebugVertex* vertices = mLinesBuffer + 2 * mNbBufferLines;
+        vertices[0] = {static_cast<float>(point1.x), static_cast<float>(point1.y), static_cast<float>(point1.z), color};
+        vertices[1] = {static_cast<float>(point2.x), static_cast<float>(point2.y), static_cast<float>(point2.z), color};
+        mNbBufferLines++;
+    }
+    else {
+        mNbDroppedPrimitives++;
+    }
+}
+
+// Add a triangle to the output
+RP3D_FORCE_INLINE void DebugRenderer::addTriangle(const Vector3& point1, const Vector3& point2, const Vector3& point3, uint32 color) {
+
+    if (mTrianglesBuffer == nullptr) {
+        mTriangles.add(DebugTriangle(point1, point2, point3, color));
+    }
+    else if (mNbBufferTriangles < mTrianglesBufferCapacity) {
+        DebugVertex* vertices = mTrianglesBuffer + 3 * mNbBufferTriangles;
+        vertices[0] = {static_cast<float>(point1.x), static_cast<float>(point1.y), static_cast<float>(point1.z), color};
+        vertices[1] = {static_cast<float>(point2.x), static_cast<float>(point2.y), static_cast<float>(point2.z), color};
+        vertices[2] = {static_cast<float>(point3.x), static_cast<float>(point3.y), static_cast<float>(point3.z), color};
+        mNbBufferTriangles++;
+    }
+    else {
+        mNbDroppedPrimitives++;
+    }
+}
+
 }
 
 // Hash function for a DebugItem
@@ -36,6 +36,10 @@
 #include <sstream>
 #include <iomanip>
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <ctime>
 
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -44,11 +48,18 @@ namespace reactphysics3d {
 /**
  * This class is the default logger class used to log information, warnings
  * or errors during the execution of the library code for easier debugging.
+ * By default, the messages are formatted and written by the thread that logs
+ * them. In asynchronous mode, the messages are pushed into a bounded lock-free
+ * queue and a background thread formats and writes them. A message is dropped
+ * (instead of blocking the calling thread) when the queue is full.
  */
 class DefaultLogger : public Logger {
 
     public:
 
+        /// Default capacity of the queue of messages of the asynchronous mode
+        static const uint32 DEFAULT_QUEUE_CAPACITY = 1024;
+
         /// Log verbosity level
         enum class Format {Text, HTML};
 
@@ -439,6 +450,34 @@ class DefaultLogger : public Logger {
 
     protected:
 
+        /// Message in the queue of the asynchronous mode
+        struct LogRecord {
+
+            /// Sequence number used to synchronize the threads that push and pop the record
+            std::atomic<uint64> sequence;
+
+            /// Time of the message
+            time_t time;
+
+            /// Level of the message
+            Level level;
+
+            /// Category of the message
+            Category category;
+
+            /// Source file name (a string literal that does not need to be copied)
+            const char* filename;
+
+            /// Line number in the source file
+            int lineNumber;
+
+            /// Name of the physics world (the memory of the string is reused by the next records)
+            std::string physicsWorldName;
+
+            /// Message (the memory of the string is reused by the next records)
+            std::string message;
+        };
+
         // -------------------- Attributes -------------------- //
 
         /// Memory allocator
@@ -450,14 +489,64 @@ class DefaultLogger : public Logger {
         /// Map a log format to the given formatter object
         Map<Format, Formatter*> mFormatters;
 
-        /// Mutex
+        /// Mutex that protects the destinations
         std::mutex mMutex;
 
+        /// Largest maximum level of the destinations (the messages above it are ignored)
+        std::atomic<uint> mMaxLevelFlag;
+
+        /// True if the messages are written by the background thread
+        std::atomic<bool> mIsAsynchronous;
+
+        /// Ring buffer of records of the asynchronous mode
+        LogRecord* mQueue;
+
+        /// Number of records of the ring buffer (a power of two)
+        uint64 mQueueCapacity;
+
+        /// Position of the next record to push into the queue
+        std::atomic<uint64> mPushPosition;
+
+        /// Position of the next record to pop from the queue
+        std::atomic<uint64> mPopPosition;
+
+        /// Number of messages dropped because the queue was full
+        std::atomic<uint64> mNbDroppedMessages;
+
+        /// Number of dropped messages already reported in the destinations
+        uint64 mNbReportedDroppedMessages;
+
+        /// Background thread of the asynchronous mode
+        std::thread mThread;
+
+        /// True when the background thread must stop
+        bool mIsThreadStopping;
+
+        /// Condition variable used to wake up the background thread
+        std::condition_variable mWakeUpCondition;
+
+        /// Condition variable notified when the background thread has written the queued messages
+        std::condition_variable mWrittenCondition;
+
         // -------------------- Methods -------------------- //
 
         /// Return the corresponding formatter
         Formatter* getFormatter(Format format) const;
 
+        /// Write a message into all the destinations
+        void writeToDestinations(const time_t& time, const std::string& physicsWorldName, const std::string& message,
+                                 Level level, Category category, const char* filename, int lineNumber);
+
+        /// Push a message into the queue of the asynchronous mode
+        void pushRecord(const time_t& time, const std::string& physicsWorldName, const std::string& message,
+                        Level level, Category category, const char* filename, int lineNumber);
+
+        /// Pop and write all the records of the queue
+        void writeQueuedRecords();
+
+        /// Main loop of the background thread
+        void runBackgroundThread();
+
         /// Constructor
         DefaultLogger(MemoryAllocator& allocator);
 
@@ -477,6 +566,21 @@ class DefaultLogger : public Logger {
         /// Remove all logs destination previously set
         void removeAllDestinations();
 
+        /// Enable the asynchronous mode where the messages are written by a background thread
+        void enableAsynchronousMode(uint32 queueCapacity = DEFAULT_QUEUE_CAPACITY);
+
+        /// Write the pending messages and disable the asynchronous mode
+        void disableAsynchronousMode();
+
+        /// Return true if the asynchronous mode is enabled
+        bool isAsynchronousModeEnabled() const;
+
+        /// Wait until the messages logged before this call have been written
+        void flush();
+
+        /// Return the number of messages dropped because the queue of the asynchronous mode was full
+        uint64 getNbDroppedMessages() const;
+
         /// Log something
         virtual void log(Level level, const std::string& physicsWorldName, Category category, const std::string& message, const char* filename, int lineNumber) override;
 
@@ -485,6 +589,16 @@ class DefaultLogger : public Logger {
         friend class PhysicsCommon;
 };
 
+// Return true if the asynchronous mode is enabled
+RP3D_FORCE_INLINE bool DefaultLogger::isAsynchronousModeEnabled() const {
+    return mIsAsynchronous.load(std::memory_order_relaxed);
+}
+
+// Return the number of messages dropped because the queue of the asynchronous mode was full
+RP3D_FORCE_INLINE uint64 DefaultLogger::getNbDroppedMessages() const {
+    return mNbDroppedMessages.load(std::memory_order_relaxed);
+}
+
 }
 
 // Hash function for struct VerticesPair
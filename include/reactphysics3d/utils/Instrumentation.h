@@ -0,0 +1,263 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_INSTRUMENTATION_H
+#define REACTPHYSICS3D_INSTRUMENTATION_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/memory/AllocationTracer.h>
+#include <atomic>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Enumeration InstrumentationStage
+/**
+ * Top-level stages of the library measured by the instrumentation
+ */
+enum class InstrumentationStage {
+    Step,
+    CollisionDetection,
+    BroadPhase,
+    MiddlePhase,
+    NarrowPhase,
+    CreateContacts,
+    ReportContacts,
+    Islands,
+    IntegrateVelocities,
+    ContactSolverInit,
+    ContactSolver,
+    JointsSolverInit,
+    JointsVelocitySolver,
+    JointsPositionSolver,
+    IntegratePositions,
+    UpdateBodiesState,
+    UpdateColliders,
+    Sleeping,
+    DebugRendering,
+    Raycast,
+    TestOverlap,
+    TestCollision,
+    NbStages
+};
+
+// Class Instrumentation
+/**
+ * This class is a lightweight alternative to the Profiler that can stay enabled in
+ * production. Only a fixed set of top-level stages is measured. Each thread accumulates
+ * the number of calls and the elapsed ticks (time stamp counter when available or
+ * steady clock otherwise) of each stage in its own fixed-size counters, without lock
+ * nor memory allocation. The instrumentation is compiled in with the CMake option
+ * RP3D_INSTRUMENTATION_ENABLED but it is disabled at runtime by default. When it is
+ * disabled, a measured stage only costs the load of a flag. The counters of all the
+ * threads can be sampled at any time with getSnapshot().
+ */
+class Instrumentation {
+
+    public :
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of measured stages
+        static const uint32 NB_STAGES = static_cast<uint32>(InstrumentationStage::NbStages);
+
+        /// Maximum number of threads with their own counters. Other threads
+        /// share a single set of counters.
+        static const uint32 MAX_NB_THREADS = 64;
+
+        // -------------------- Internal Classes -------------------- //
+
+        // Structure StageCounters
+        /**
+         * Counters of a stage in a snapshot of the instrumentation
+         */
+        struct StageCounters {
+
+            /// Number of times the stage has been executed
+            uint64 nbCalls;
+
+            /// Number of elapsed ticks in the stage
+            uint64 nbTicks;
+
+            /// Elapsed time in the stage (in seconds)
+            double time;
+        };
+
+        // Structure Snapshot
+        /**
+         * Counters of all the stages summed over all the threads. The counters are
+         * cumulative since the last reset of the instrumentation. Two snapshots can
+         * be subtracted to get the counters over a period of time.
+         */
+        struct Snapshot {
+
+            /// Counters of each stage
+            StageCounters stages[NB_STAGES];
+
+            /// Number of threads that have recorded a stage
+            uint32 nbThreads;
+
+            /// Number of ticks per second used to convert the ticks into seconds
+            double ticksPerSecond;
+
+            /// Return the counters of a given stage
+            const StageCounters& getStage(InstrumentationStage stage) const {
+                return stages[static_cast<uint32>(stage)];
+            }
+        };
+
+    private :
+
+        // Structure ThreadCounters
+        /**
+         * Counters of each stage written by a single thread. They are aligned on a
+         * cache line to avoid false sharing between threads.
+         */
+        struct alignas(64) ThreadCounters {
+
+            /// Number of calls of each stage
+            std::atomic<uint64> nbCalls[NB_STAGES];
+
+            /// Number of elapsed ticks in each stage
+            std::atomic<uint64> nbTicks[NB_STAGES];
+        };
+
+        // -------------------- Attributes -------------------- //
+
+        /// True if the stages are measured
+        static std::atomic<bool> mIsEnabled;
+
+        /// Counters of the threads (the last ones are shared by the threads without their own counters)
+        static ThreadCounters mThreadsCounters[MAX_NB_THREADS + 1];
+
+        /// Number of threads that have been given their own counters
+        static std::atomic<uint32> mNbThreads;
+
+        /// Counters of the current thread
+        static thread_local ThreadCounters* mCurrentThreadCounters;
+
+        // -------------------- Methods -------------------- //
+
+        /// Return the counters of the current thread
+        static ThreadCounters* getThreadCounters();
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Return true if the stages are measured
+        static bool isEnabled();
+
+        /// Enable or disable the measure of the stages
+        static void setIsEnabled(bool isEnabled);
+
+        /// Return the current value of the ticks counter
+        static uint64 getTicks();
+
+        /// Return the number of ticks per second
+        static double getTicksPerSecond();
+
+        /// Add a call of a stage with its number of elapsed ticks into the counters of the current thread
+        static void addSample(InstrumentationStage stage, uint64 nbTicks);
+
+        /// Sum the counters of all the threads into a snapshot
+        static void getSnapshot(Snapshot& snapshot);
+
+        /// Reset the counters of all the threads
+        static void reset();
+
+        /// Return the name of a stage
+        static const char* getStageName(InstrumentationStage stage);
+};
+
+// Class InstrumentationScope
+/**
+ * This class measures the ticks elapsed between its construction and its
+ * destruction and adds them to a stage of the instrumentation
+ */
+class InstrumentationScope {
+
+    private :
+
+        // -------------------- Attributes -------------------- //
+
+        /// Measured stage
+        InstrumentationStage mStage;
+
+        /// True if the instrumentation was enabled when the scope started
+        bool mIsActive;
+
+        /// Value of the ticks counter when the scope started
+        uint64 mStartTicks;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        InstrumentationScope(InstrumentationStage stage)
+            : mStage(stage), mIsActive(Instrumentation::isEnabled()),
+              mStartTicks(mIsActive ? Instrumentation::getTicks() : 0) {
+
+        }
+
+        /// Destructor
+        ~InstrumentationScope() {
+
+            if (mIsActive) {
+                Instrumentation::addSample(mStage, Instrumentation::getTicks() - mStartTicks);
+            }
+        }
+
+        /// Deleted copy-constructor
+        InstrumentationScope(const InstrumentationScope& scope) = delete;
+
+        /// Deleted assignment operator
+        InstrumentationScope& operator=(const InstrumentationScope& scope) = delete;
+};
+
+// Return true if the stages are measured
+RP3D_FORCE_INLINE bool Instrumentation::isEnabled() {
+    return mIsEnabled.load(std::memory_order_relaxed);
+}
+
+}
+
+// The allocations made during a stage are tagged with the name of the stage
+#ifdef IS_RP3D_INSTRUMENTATION_ENABLED
+
+// Use this macro to measure a stage until the end of the current scope
+#define RP3D_INSTRUMENT(stage) reactphysics3d::InstrumentationScope instrumentationScope(reactphysics3d::InstrumentationStage::stage); \
+                               RP3D_ALLOCATION_TAG(#stage)
+
+#else
+
+// Empty macro in case instrumentation is not enabled
+#define RP3D_INSTRUMENT(stage) RP3D_ALLOCATION_TAG(#stage)
+
+#endif
+
+#endif
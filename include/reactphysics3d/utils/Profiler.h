@@ -187,8 +187,9 @@ class Profiler {
 
     public:
 
-        /// Format of the profiling data (text, ...)
-        enum class Format {Text};
+        /// Format of the profiling data (text report of the profiler tree or trace event
+        /// JSON of the last profiled blocks of code for chrome://tracing or Perfetto)
+        enum class Format {Text, ChromeTrace};
 
         /// Profile destination
         class Destination {
@@ -279,8 +280,56 @@ class Profiler {
 
     private :
 
+        /// Event of the trace of a profiled block of code
+        struct TraceEvent {
+
+            /// Name of the block of code
+            const char* name;
+
+            /// Starting time (in microseconds since the start/reset of the profiling)
+            double startTime;
+
+            /// Duration (in microseconds)
+            double duration;
+
+            /// Index of the frame
+            uint frame;
+
+            /// Identifier of the thread
+            uint threadId;
+        };
+
+        // -------------------- Constants -------------------- //
+
+        /// Default number of events kept in the trace
+        static const uint DEFAULT_TRACE_CAPACITY = 65536;
+
+        /// Maximum depth of nested blocks of code in the trace
+        static const uint MAX_TRACE_DEPTH = 64;
+
         // -------------------- Attributes -------------------- //
 
+        /// Ring buffer with the last trace events (null if the trace is disabled)
+        TraceEvent* mTraceEvents;
+
+        /// Maximum number of events in the trace ring buffer
+        uint mTraceCapacity;
+
+        /// Current number of events in the trace ring buffer
+        uint mNbTraceEvents;
+
+        /// Index of the next event to write in the trace ring buffer
+        uint mNextTraceEventIndex;
+
+        /// Names of the blocks of code that are currently open in the trace
+        const char* mTraceBlocksNames[MAX_TRACE_DEPTH];
+
+        /// Starting times of the blocks of code that are currently open in the trace
+        std::chrono::time_point<clock> mTraceBlocksStartingTimes[MAX_TRACE_DEPTH];
+
+        /// Current depth of nested blocks of code in the trace
+        uint mTraceDepth;
+
         /// Root node of the profiler tree
         ProfileNode mRootNode;
 
@@ -309,6 +358,13 @@ class Profiler {
 		/// Destroy a previously allocated iterator
 		void destroyIterator(ProfileNodeIterator* iterator);
 
+        /// Add an event for a profiled block of code into the trace ring buffer
+        void addTraceEvent(const char* name, const std::chrono::time_point<clock>& startingTime,
+                           const std::chrono::time_point<clock>& endTime);
+
+        /// Print the events of the trace in the trace event JSON format
+        void printTrace(std::ostream& outputStream);
+
 		/// Destroy the profiler (release the memory)
 		void destroy();
 
@@ -345,6 +401,15 @@ class Profiler {
         /// Return an iterator over the profiler tree starting at the root
         ProfileNodeIterator* getIterator();
 
+        /// Set the number of events kept in the trace (zero disables the trace)
+        void setTraceCapacity(uint nbEvents);
+
+        /// Return the maximum number of events kept in the trace
+        uint getTraceCapacity() const;
+
+        /// Return the number of events currently in the trace
+        uint getNbTraceEvents() const;
+
         // Allocate memory for the destinations
         void allocatedDestinations(uint nbDestinationsToAllocate);
 
@@ -501,6 +566,16 @@ RP3D_FORCE_INLINE ProfileNodeIterator* Profiler::getIterator() {
     return new ProfileNodeIterator(&mRootNode);
 }
 
+// Return the maximum number of events kept in the trace
+RP3D_FORCE_INLINE uint Profiler::getTraceCapacity() const {
+    return mTraceCapacity;
+}
+
+// Return the number of events currently in the trace
+RP3D_FORCE_INLINE uint Profiler::getNbTraceEvents() const {
+    return mNbTraceEvents;
+}
+
 // Destroy a previously allocated iterator
 RP3D_FORCE_INLINE void Profiler::destroyIterator(ProfileNodeIterator* iterator) {
     delete iterator;
@@ -287,6 +287,64 @@ void CollisionBody::setIsActive(bool isActive) {
              (isActive ? "true" : "false"),  __FILE__, __LINE__);
 }
 
+// Return true if the colliders of the body share a single broad-phase proxy
+/**
+ * @return True if the body is in compound mode
+ */
+bool CollisionBody::isCompound() const {
+    return mWorld.mCollisionBodyComponents.getIsCompound(mEntity);
+}
+
+// Set whether or not the colliders of the body share a single broad-phase proxy
+/// In compound mode, the body is represented by a single node in the broad-phase
+/// tree of the world and its colliders are stored in a local tree (in body-space) that
+/// is queried when the proxy of the body overlaps with another one. When the body moves,
+/// only the proxy of the body is updated instead of every collider. This is useful for
+/// bodies with a large number of colliders.
+/**
+ * @param isCompound True if the colliders of the body must be grouped under a single
+ *                   broad-phase proxy
+ */
+void CollisionBody::setIsCompound(bool isCompound) {
+
+    // If the state does not change
+    if (mWorld.mCollisionBodyComponents.getIsCompound(mEntity) == isCompound) return;
+
+    const Transform& transform = mWorld.mTransformComponents.getTransform(mEntity);
+    const Array<Entity>& colliderEntities = mWorld.mCollisionBodyComponents.getColliders(mEntity);
+
+    // Remove the colliders from the broad-phase
+    for (uint32 i=0; i < colliderEntities.size(); i++) {
+
+        Collider* collider = mWorld.mCollidersComponents.getCollider(colliderEntities[i]);
+
+        if (collider->getBroadPhaseId() != -1) {
+            mWorld.mCollisionDetection.removeCollider(collider);
+        }
+    }
+
+    mWorld.mCollisionBodyComponents.setIsCompound(mEntity, isCompound);
+
+    // Add the colliders back into the broad-phase if the body is active
+    if (mWorld.mCollisionBodyComponents.getIsActive(mEntity)) {
+
+        for (uint32 i=0; i < colliderEntities.size(); i++) {
+
+            Collider* collider = mWorld.mCollidersComponents.getCollider(colliderEntities[i]);
+
+            // Compute the world-space AABB of the collision shape
+            AABB aabb;
+            collider->getCollisionShape()->computeAABB(aabb, transform * mWorld.mCollidersComponents.getLocalToBodyTransform(collider->getEntity()));
+
+            mWorld.mCollisionDetection.addCollider(collider, aabb);
+        }
+    }
+
+    RP3D_LOG(mWorld.mConfig.worldName, Logger::Level::Information, Logger::Category::Body,
+             "Body " + std::to_string(mEntity.id) + ": Set isCompound=" +
+             (isCompound ? "true" : "false"),  __FILE__, __LINE__);
+}
+
 // Ask the broad-phase to test again the collision shapes of the body for collision
 // (as if the body has moved).
 void CollisionBody::askForBroadPhaseCollisionCheck() const {
@@ -66,10 +66,19 @@ BodyType RigidBody::getType() const {
  */
 void RigidBody::setType(BodyType type) {
 
-    if (mWorld.mRigidBodyComponents.getBodyType(mEntity) == type) return;
+    const BodyType previousType = mWorld.mRigidBodyComponents.getBodyType(mEntity);
+    if (previousType == type) return;
 
     mWorld.mRigidBodyComponents.setBodyType(mEntity, type);
 
+    // Static bodies do not belong to any island
+    if (type == BodyType::STATIC) {
+        mWorld.removeBodyFromIsland(mEntity);
+    }
+    else if (previousType == BodyType::STATIC) {
+        mWorld.addBodyToNewIsland(mEntity);
+    }
+
     // If it is a static body
     if (type == BodyType::STATIC) {
 
@@ -78,6 +87,12 @@ void RigidBody::setType(BodyType type) {
         mWorld.mRigidBodyComponents.setAngularVelocity(mEntity, Vector3::zero());
     }
 
+    // A static body is not integrated and is therefore moved into the disabled part of the
+    // rigid body components (the other components are not affected)
+    if (!mWorld.mCollisionBodyComponents.getIsEntityDisabled(mEntity)) {
+        mWorld.mRigidBodyComponents.setIsEntityDisabled(mEntity, type == BodyType::STATIC);
+    }
+
     // If it is a static or a kinematic body
     if (type == BodyType::STATIC || type == BodyType::KINEMATIC) {
 
@@ -114,6 +129,8 @@ void RigidBody::setType(BodyType type) {
     mWorld.mRigidBodyComponents.setExternalForce(mEntity, Vector3::zero());
     mWorld.mRigidBodyComponents.setExternalTorque(mEntity, Vector3::zero());
 
+    mWorld.updateStaticBodyState(mEntity);
+
     RP3D_LOG(mWorld.mConfig.worldName, Logger::Level::Information, Logger::Category::Body,
              "Body " + std::to_string(mEntity.id) + ": Set type=" +
              (type == BodyType::STATIC ? "Static" : (type == BodyType::DYNAMIC ? "Dynamic" : "Kinematic")),  __FILE__, __LINE__);
@@ -328,6 +345,7 @@ void RigidBody::setLocalCenterOfMass(const Vector3& centerOfMass) {
 
     // Compute the center of mass in world-space coordinates
     mWorld.mRigidBodyComponents.setCenterOfMassWorld(mEntity, mWorld.mTransformComponents.getTransform(mEntity) * centerOfMass);
+    mWorld.updateStaticBodyState(mEntity);
 
     // Update the linear velocity of the center of mass
     Vector3 linearVelocity = mWorld.mRigidBodyComponents.getLinearVelocity(mEntity);
@@ -365,6 +383,7 @@ void RigidBody::updateLocalCenterOfMassFromColliders() {
     // Set the center of mass
     mWorld.mRigidBodyComponents.setCenterOfMassLocal(mEntity, centerOfMassLocal);
     mWorld.mRigidBodyComponents.setCenterOfMassWorld(mEntity, centerOfMassWorld);
+    mWorld.updateStaticBodyState(mEntity);
 
     // Update the linear velocity of the center of mass
     Vector3 linearVelocity = mWorld.mRigidBodyComponents.getLinearVelocity(mEntity);
@@ -547,6 +566,7 @@ void RigidBody::updateMassPropertiesFromColliders() {
     // Set the center of mass
     mWorld.mRigidBodyComponents.setCenterOfMassLocal(mEntity, centerOfMassLocal);
     mWorld.mRigidBodyComponents.setCenterOfMassWorld(mEntity, centerOfMassWorld);
+    mWorld.updateStaticBodyState(mEntity);
 
     // If it is a dynamic body
     const BodyType type = mWorld.mRigidBodyComponents.getBodyType(mEntity);
@@ -716,6 +736,9 @@ void RigidBody::removeCollider(Collider* collider) {
 
     // Remove the collision shape
     CollisionBody::removeCollider(collider);
+
+    // The body might not be connected anymore to the other bodies of its island
+    mWorld.markIslandAsSplitCandidate(mEntity);
 }
 
 // Set the variable to know if the gravity is applied to this rigid body
@@ -833,10 +856,12 @@ void RigidBody::setTransform(const Transform& transform) {
     linearVelocity += angularVelocity.cross(centerOfMassWorld - oldCenterOfMass);
     mWorld.mRigidBodyComponents.setLinearVelocity(mEntity, linearVelocity);
 
+    // Awake the body if it is sleeping (before updating the broad-phase state of its colliders)
+    setIsSleeping(false);
+
     CollisionBody::setTransform(transform);
 
-    // Awake the body if it is sleeping
-    setIsSleeping(false);
+    mWorld.updateStaticBodyState(mEntity);
 }
 
 // Return the linear velocity
@@ -1087,6 +1112,11 @@ void RigidBody::setIsActive(bool isActive) {
     setIsSleeping(!isActive);
 
     CollisionBody::setIsActive(isActive);
+
+    // An inactive body is not connected anymore to the other bodies of its island
+    if (!isActive) {
+        mWorld.markIslandAsSplitCandidate(mEntity);
+    }
 }
 
 #ifdef IS_RP3D_PROFILING_ENABLED
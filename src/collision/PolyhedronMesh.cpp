@@ -29,7 +29,9 @@
 #include <reactphysics3d/collision/PolygonVertexArray.h>
 #include <reactphysics3d/utils/DefaultLogger.h>
 #include <reactphysics3d/engine/PhysicsCommon.h>
+#include <reactphysics3d/collision/CookedMesh.h>
 #include <cstdlib>
+#include <cstdint>
 
 using namespace reactphysics3d;
 
@@ -41,7 +43,8 @@ using namespace reactphysics3d;
  */
 PolyhedronMesh::PolyhedronMesh(PolygonVertexArray* polygonVertexArray, MemoryAllocator& allocator)
                : mMemoryAllocator(allocator), mHalfEdgeStructure(allocator, polygonVertexArray->getNbFaces(), polygonVertexArray->getNbVertices(),
-                                    (polygonVertexArray->getNbFaces() + polygonVertexArray->getNbVertices() - 2) * 2), mFacesNormals(nullptr) {
+                                    (polygonVertexArray->getNbFaces() + polygonVertexArray->getNbVertices() - 2) * 2), mFacesNormals(nullptr),
+                 mIsOwningPolygonVertexArray(false), mOwnedData(nullptr), mOwnedDataSize(0) {
 
    mPolygonVertexArray = polygonVertexArray;
 }
@@ -57,6 +60,16 @@ PolyhedronMesh::~PolyhedronMesh() {
 
         mMemoryAllocator.release(mFacesNormals, mHalfEdgeStructure.getNbFaces() * sizeof(Vector3));
     }
+
+    // If the polygon vertex array has been created from cooked data
+    if (mIsOwningPolygonVertexArray) {
+        mPolygonVertexArray->~PolygonVertexArray();
+        mMemoryAllocator.release(mPolygonVertexArray, sizeof(PolygonVertexArray));
+    }
+
+    if (mOwnedData != nullptr) {
+        mMemoryAllocator.release(mOwnedData, mOwnedDataSize);
+    }
 }
 
 /// Static factory method to create a polyhedron mesh. This methods returns null_ptr if the mesh is not valid
@@ -84,6 +97,85 @@ PolyhedronMesh* PolyhedronMesh::create(PolygonVertexArray* polygonVertexArray, M
     return mesh;
 }
 
+// Static factory method to create a polyhedron mesh from the convex hull of a point cloud
+/// The hull is computed with the Quickhull algorithm. The vertices and faces of the hull are
+/// owned by the mesh. This methods returns nullptr if the hull cannot be computed (less than four
+/// points or all the points are coplanar).
+PolyhedronMesh* PolyhedronMesh::createConvexHull(const void* points, uint32 nbPoints, uint32 pointsStride,
+                                                 PolygonVertexArray::VertexDataType pointsDataType, const QuickHull::Settings& settings,
+                                                 MemoryAllocator& polyhedronMeshAllocator, MemoryAllocator& dataAllocator) {
+
+    // Read the input points
+    Array<Vector3> inputPoints(dataAllocator, nbPoints);
+    const unsigned char* pointsStart = static_cast<const unsigned char*>(points);
+    for (uint32 i=0; i < nbPoints; i++) {
+        if (pointsDataType == PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE) {
+            const float* point = reinterpret_cast<const float*>(pointsStart + i * pointsStride);
+            inputPoints.add(Vector3(decimal(point[0]), decimal(point[1]), decimal(point[2])));
+        }
+        else {
+            const double* point = reinterpret_cast<const double*>(pointsStart + i * pointsStride);
+            inputPoints.add(Vector3(decimal(point[0]), decimal(point[1]), decimal(point[2])));
+        }
+    }
+
+    // Compute the convex hull
+    Array<Vector3> hullVertices(dataAllocator);
+    Array<uint32> hullIndices(dataAllocator);
+    Array<PolygonVertexArray::PolygonFace> hullFaces(dataAllocator);
+    if (!QuickHull::computeConvexHull(inputPoints, settings, dataAllocator, hullVertices, hullIndices, hullFaces)) {
+
+        RP3D_LOG("PhysicsCommon", Logger::Level::Error, Logger::Category::PhysicCommon,
+                 "Error when creating a convex hull PolyhedronMesh: the points are degenerate (less than four points or coplanar points)",
+                 __FILE__, __LINE__);
+
+        return nullptr;
+    }
+
+    // Copy the hull into a single memory block owned by the mesh
+    const size_t verticesSize = hullVertices.size() * 3 * sizeof(decimal);
+    const size_t indicesSize = hullIndices.size() * sizeof(uint32);
+    const size_t facesSize = hullFaces.size() * sizeof(PolygonVertexArray::PolygonFace);
+    const size_t dataSize = verticesSize + indicesSize + facesSize;
+    unsigned char* data = static_cast<unsigned char*>(dataAllocator.allocate(dataSize));
+    decimal* vertices = reinterpret_cast<decimal*>(data);
+    for (uint32 v=0; v < hullVertices.size(); v++) {
+        vertices[v * 3] = hullVertices[v].x;
+        vertices[v * 3 + 1] = hullVertices[v].y;
+        vertices[v * 3 + 2] = hullVertices[v].z;
+    }
+    uint32* indices = reinterpret_cast<uint32*>(data + verticesSize);
+    for (uint32 i=0; i < hullIndices.size(); i++) {
+        indices[i] = hullIndices[i];
+    }
+    PolygonVertexArray::PolygonFace* faces = reinterpret_cast<PolygonVertexArray::PolygonFace*>(data + verticesSize + indicesSize);
+    for (uint32 f=0; f < hullFaces.size(); f++) {
+        faces[f] = hullFaces[f];
+    }
+
+    const PolygonVertexArray::VertexDataType vertexDataType = sizeof(decimal) == sizeof(float) ?
+                PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE : PolygonVertexArray::VertexDataType::VERTEX_DOUBLE_TYPE;
+    PolygonVertexArray* polygonVertexArray = new (dataAllocator.allocate(sizeof(PolygonVertexArray)))
+            PolygonVertexArray(static_cast<uint32>(hullVertices.size()), vertices, 3 * sizeof(decimal), indices, sizeof(uint32),
+                               static_cast<uint32>(hullFaces.size()), faces, vertexDataType,
+                               PolygonVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+
+    PolyhedronMesh* mesh = create(polygonVertexArray, polyhedronMeshAllocator, dataAllocator);
+
+    if (mesh != nullptr) {
+        mesh->mIsOwningPolygonVertexArray = true;
+        mesh->mOwnedData = data;
+        mesh->mOwnedDataSize = dataSize;
+    }
+    else {
+        polygonVertexArray->~PolygonVertexArray();
+        dataAllocator.release(polygonVertexArray, sizeof(PolygonVertexArray));
+        dataAllocator.release(data, dataSize);
+    }
+
+    return mesh;
+}
+
 // Create the half-edge structure of the mesh
 /// This method returns true if the mesh is valid or false otherwise
 bool PolyhedronMesh::createHalfEdgeStructure() {
@@ -247,3 +339,234 @@ decimal PolyhedronMesh::getVolume() const {
 
     return std::abs(sum) / decimal(3.0);
 }
+
+// Serialize the mesh into a cooked binary blob
+/// The cooked data contains the vertices, the faces, the half-edge structure and the
+/// faces normals of the mesh. The method always returns the size (in bytes) of the cooked
+/// data. The data is only written if "outData" is not null and "outDataSize" is large enough.
+/// "outData" must be aligned on COOKED_MESH_ALIGNMENT bytes.
+size_t PolyhedronMesh::cook(void* outData, size_t outDataSize) const {
+
+    const uint32 nbVertices = getNbVertices();
+    const uint32 nbFaces = getNbFaces();
+    const uint32 nbHalfEdges = mHalfEdgeStructure.getNbHalfEdges();
+    uint32 nbFacesIndices = 0;
+    for (uint32 f=0; f < nbFaces; f++) {
+        nbFacesIndices += static_cast<uint32>(mHalfEdgeStructure.getFace(f).faceVertices.size());
+    }
+
+    // Compute the layout of the cooked data
+    CookedPolyhedronMeshInfo info;
+    info.nbVertices = nbVertices;
+    info.nbFaces = nbFaces;
+    info.nbHalfEdges = nbHalfEdges;
+    info.nbFacesIndices = nbFacesIndices;
+    info.centroid[0] = mCentroid.x;
+    info.centroid[1] = mCentroid.y;
+    info.centroid[2] = mCentroid.z;
+
+    const uint64 infoOffset = alignCookedMeshOffset(sizeof(CookedMeshHeader));
+    uint64 offset = alignCookedMeshOffset(infoOffset + sizeof(CookedPolyhedronMeshInfo));
+    info.verticesOffset = offset;
+    offset = alignCookedMeshOffset(offset + nbVertices * 3 * sizeof(decimal));
+    info.facesOffset = offset;
+    offset = alignCookedMeshOffset(offset + nbFaces * sizeof(PolygonVertexArray::PolygonFace));
+    info.facesIndicesOffset = offset;
+    offset = alignCookedMeshOffset(offset + nbFacesIndices * sizeof(uint32));
+    info.facesEdgesOffset = offset;
+    offset = alignCookedMeshOffset(offset + nbFaces * sizeof(uint32));
+    info.verticesEdgesOffset = offset;
+    offset = alignCookedMeshOffset(offset + nbVertices * sizeof(uint32));
+    info.halfEdgesOffset = offset;
+    offset = alignCookedMeshOffset(offset + nbHalfEdges * sizeof(HalfEdgeStructure::Edge));
+    info.facesNormalsOffset = offset;
+    offset = alignCookedMeshOffset(offset + nbFaces * 3 * sizeof(decimal));
+
+    const size_t totalSize = static_cast<size_t>(offset);
+
+    if (outData == nullptr || outDataSize < totalSize) {
+        return totalSize;
+    }
+
+    assert(reinterpret_cast<uintptr_t>(outData) % COOKED_MESH_ALIGNMENT == 0);
+
+    unsigned char* data = static_cast<unsigned char*>(outData);
+    std::memset(data, 0, totalSize);
+
+    // Write the vertices
+    decimal* vertices = reinterpret_cast<decimal*>(data + info.verticesOffset);
+    uint32* verticesEdges = reinterpret_cast<uint32*>(data + info.verticesEdgesOffset);
+    for (uint32 v=0; v < nbVertices; v++) {
+        const Vector3 vertex = getVertex(v);
+        vertices[v * 3] = vertex.x;
+        vertices[v * 3 + 1] = vertex.y;
+        vertices[v * 3 + 2] = vertex.z;
+        verticesEdges[v] = mHalfEdgeStructure.getVertex(v).edgeIndex;
+    }
+
+    // Write the faces
+    PolygonVertexArray::PolygonFace* faces = reinterpret_cast<PolygonVertexArray::PolygonFace*>(data + info.facesOffset);
+    uint32* facesIndices = reinterpret_cast<uint32*>(data + info.facesIndicesOffset);
+    uint32* facesEdges = reinterpret_cast<uint32*>(data + info.facesEdgesOffset);
+    decimal* facesNormals = reinterpret_cast<decimal*>(data + info.facesNormalsOffset);
+    uint32 indexBase = 0;
+    for (uint32 f=0; f < nbFaces; f++) {
+
+        const HalfEdgeStructure::Face& face = mHalfEdgeStructure.getFace(f);
+        const uint32 nbFaceVertices = static_cast<uint32>(face.faceVertices.size());
+
+        faces[f].nbVertices = nbFaceVertices;
+        faces[f].indexBase = indexBase;
+        for (uint32 v=0; v < nbFaceVertices; v++) {
+            facesIndices[indexBase + v] = face.faceVertices[v];
+        }
+        indexBase += nbFaceVertices;
+
+        facesEdges[f] = face.edgeIndex;
+        facesNormals[f * 3] = mFacesNormals[f].x;
+        facesNormals[f * 3 + 1] = mFacesNormals[f].y;
+        facesNormals[f * 3 + 2] = mFacesNormals[f].z;
+    }
+
+    // Write the half-edges
+    for (uint32 e=0; e < nbHalfEdges; e++) {
+        std::memcpy(data + info.halfEdgesOffset + e * sizeof(HalfEdgeStructure::Edge), &mHalfEdgeStructure.getHalfEdge(e),
+                    sizeof(HalfEdgeStructure::Edge));
+    }
+
+    // Write the header and the mesh description
+    CookedMeshHeader header;
+    header.magic = COOKED_MESH_MAGIC;
+    header.version = COOKED_MESH_VERSION;
+    header.type = CookedMeshType::POLYHEDRON_MESH;
+    header.decimalSize = sizeof(decimal);
+    header.treeNodeSize = 0;
+    header.padding = 0;
+    header.totalSize = totalSize;
+    std::memcpy(data, &header, sizeof(CookedMeshHeader));
+    std::memcpy(data + infoOffset, &info, sizeof(CookedPolyhedronMeshInfo));
+
+    return totalSize;
+}
+
+// Static factory method to create a polyhedron mesh from cooked data
+/// The vertices and faces of the mesh are used in place and are not copied. Therefore, the
+/// cooked data must remain valid during the lifetime of the mesh. The half-edge structure and
+/// the faces normals are loaded without being recomputed. This method returns nullptr if the
+/// cooked data is not valid.
+PolyhedronMesh* PolyhedronMesh::createFromCookedData(const void* cookedData, size_t cookedDataSize,
+                                                     MemoryAllocator& polyhedronMeshAllocator, MemoryAllocator& dataAllocator) {
+
+    const unsigned char* data = static_cast<const unsigned char*>(cookedData);
+
+    // Validate the header
+    bool isValid = data != nullptr && cookedDataSize >= sizeof(CookedMeshHeader) &&
+                   reinterpret_cast<uintptr_t>(data) % COOKED_MESH_ALIGNMENT == 0;
+    CookedMeshHeader header;
+    if (isValid) {
+        std::memcpy(&header, data, sizeof(CookedMeshHeader));
+        isValid = header.magic == COOKED_MESH_MAGIC && header.version == COOKED_MESH_VERSION &&
+                  header.type == CookedMeshType::POLYHEDRON_MESH && header.decimalSize == sizeof(decimal) &&
+                  header.totalSize <= cookedDataSize;
+    }
+
+    // Validate the mesh description and the sections
+    const uint64 infoOffset = alignCookedMeshOffset(sizeof(CookedMeshHeader));
+    const CookedPolyhedronMeshInfo* info = nullptr;
+    if (isValid) {
+        isValid = isCookedMeshSectionValid(infoOffset, sizeof(CookedPolyhedronMeshInfo), header.totalSize);
+    }
+    if (isValid) {
+        info = reinterpret_cast<const CookedPolyhedronMeshInfo*>(data + infoOffset);
+        const uint64 nbVertices = info->nbVertices;
+        const uint64 nbFaces = info->nbFaces;
+        isValid = nbVertices >= 4 && nbFaces >= 4 &&
+                  isCookedMeshSectionValid(info->verticesOffset, nbVertices * 3 * sizeof(decimal), header.totalSize) &&
+                  isCookedMeshSectionValid(info->facesOffset, nbFaces * sizeof(PolygonVertexArray::PolygonFace), header.totalSize) &&
+                  isCookedMeshSectionValid(info->facesIndicesOffset, info->nbFacesIndices * sizeof(uint32), header.totalSize) &&
+                  isCookedMeshSectionValid(info->facesEdgesOffset, nbFaces * sizeof(uint32), header.totalSize) &&
+                  isCookedMeshSectionValid(info->verticesEdgesOffset, nbVertices * sizeof(uint32), header.totalSize) &&
+                  isCookedMeshSectionValid(info->halfEdgesOffset, info->nbHalfEdges * sizeof(HalfEdgeStructure::Edge), header.totalSize) &&
+                  isCookedMeshSectionValid(info->facesNormalsOffset, nbFaces * 3 * sizeof(decimal), header.totalSize);
+    }
+
+    // Validate the indices of the faces and of the half-edges
+    const PolygonVertexArray::PolygonFace* faces = nullptr;
+    const uint32* facesIndices = nullptr;
+    if (isValid) {
+        faces = reinterpret_cast<const PolygonVertexArray::PolygonFace*>(data + info->facesOffset);
+        facesIndices = reinterpret_cast<const uint32*>(data + info->facesIndicesOffset);
+        for (uint32 f=0; f < info->nbFaces && isValid; f++) {
+            isValid = faces[f].nbVertices >= 3 && faces[f].indexBase <= info->nbFacesIndices &&
+                      faces[f].nbVertices <= info->nbFacesIndices - faces[f].indexBase;
+            for (uint32 v=0; v < faces[f].nbVertices && isValid; v++) {
+                isValid = facesIndices[faces[f].indexBase + v] < info->nbVertices;
+            }
+        }
+        for (uint32 e=0; e < info->nbHalfEdges && isValid; e++) {
+            HalfEdgeStructure::Edge edge;
+            std::memcpy(&edge, data + info->halfEdgesOffset + e * sizeof(HalfEdgeStructure::Edge), sizeof(HalfEdgeStructure::Edge));
+            isValid = edge.vertexIndex < info->nbVertices && edge.twinEdgeIndex < info->nbHalfEdges &&
+                      edge.faceIndex < info->nbFaces && edge.nextEdgeIndex < info->nbHalfEdges;
+        }
+        const uint32* verticesEdges = reinterpret_cast<const uint32*>(data + info->verticesEdgesOffset);
+        for (uint32 v=0; v < info->nbVertices && isValid; v++) {
+            isValid = verticesEdges[v] < info->nbHalfEdges;
+        }
+        const uint32* facesEdges = reinterpret_cast<const uint32*>(data + info->facesEdgesOffset);
+        for (uint32 f=0; f < info->nbFaces && isValid; f++) {
+            isValid = facesEdges[f] < info->nbHalfEdges;
+        }
+    }
+
+    if (!isValid) {
+
+        RP3D_LOG("PhysicsCommon", Logger::Level::Error, Logger::Category::PhysicCommon,
+                 "Error when creating a PolyhedronMesh: the cooked data is not valid", __FILE__, __LINE__);
+
+        return nullptr;
+    }
+
+    // Create a polygon vertex array that points to the cooked data
+    const PolygonVertexArray::VertexDataType vertexDataType = sizeof(decimal) == sizeof(float) ?
+                PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE : PolygonVertexArray::VertexDataType::VERTEX_DOUBLE_TYPE;
+    PolygonVertexArray* polygonVertexArray = new (dataAllocator.allocate(sizeof(PolygonVertexArray)))
+            PolygonVertexArray(info->nbVertices, data + info->verticesOffset, 3 * sizeof(decimal),
+                               facesIndices, sizeof(uint32), info->nbFaces, const_cast<PolygonVertexArray::PolygonFace*>(faces),
+                               vertexDataType, PolygonVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+
+    PolyhedronMesh* mesh = new (polyhedronMeshAllocator.allocate(sizeof(PolyhedronMesh))) PolyhedronMesh(polygonVertexArray, dataAllocator);
+    mesh->mIsOwningPolygonVertexArray = true;
+
+    // Load the half-edge structure
+    HalfEdgeStructure& halfEdgeStructure = mesh->mHalfEdgeStructure;
+    const uint32* verticesEdges = reinterpret_cast<const uint32*>(data + info->verticesEdgesOffset);
+    for (uint32 v=0; v < info->nbVertices; v++) {
+        halfEdgeStructure.addVertex(v);
+        halfEdgeStructure.mVertices[v].edgeIndex = verticesEdges[v];
+    }
+    const uint32* facesEdges = reinterpret_cast<const uint32*>(data + info->facesEdgesOffset);
+    for (uint32 f=0; f < info->nbFaces; f++) {
+        Array<uint32> faceVertices(dataAllocator, faces[f].nbVertices);
+        for (uint32 v=0; v < faces[f].nbVertices; v++) {
+            faceVertices.add(facesIndices[faces[f].indexBase + v]);
+        }
+        halfEdgeStructure.addFace(faceVertices);
+        halfEdgeStructure.mFaces[f].edgeIndex = facesEdges[f];
+    }
+    for (uint32 e=0; e < info->nbHalfEdges; e++) {
+        HalfEdgeStructure::Edge edge;
+        std::memcpy(&edge, data + info->halfEdgesOffset + e * sizeof(HalfEdgeStructure::Edge), sizeof(HalfEdgeStructure::Edge));
+        halfEdgeStructure.mEdges.add(edge);
+    }
+
+    // Load the faces normals and the centroid
+    const decimal* facesNormals = reinterpret_cast<const decimal*>(data + info->facesNormalsOffset);
+    mesh->mFacesNormals = new (dataAllocator.allocate(info->nbFaces * sizeof(Vector3))) Vector3[info->nbFaces];
+    for (uint32 f=0; f < info->nbFaces; f++) {
+        mesh->mFacesNormals[f] = Vector3(facesNormals[f * 3], facesNormals[f * 3 + 1], facesNormals[f * 3 + 2]);
+    }
+    mesh->mCentroid = Vector3(info->centroid[0], info->centroid[1], info->centroid[2]);
+
+    return mesh;
+}
@@ -0,0 +1,566 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/QuickHull.h>
+
+using namespace reactphysics3d;
+
+// Constructor
+QuickHull::QuickHull(const Array<Vector3>& points, MemoryAllocator& allocator)
+          : mAllocator(allocator), mPoints(points), mEpsilon(0), mFaces(allocator), mAliveFaces(allocator), mIsFaceVisible(allocator),
+            mVisibleFaces(allocator), mHorizon(allocator), mFacesStack(allocator), mNextOutsidePoint(allocator, points.size()),
+            mVertexNbFaces(allocator, points.size()), mNbHullVertices(0) {
+
+    // Compute the distance tolerance from the magnitude of the coordinates of the points
+    Vector3 maxAbsCoordinates(0, 0, 0);
+    for (uint32 i=0; i < mPoints.size(); i++) {
+        const Vector3 absPoint = mPoints[i].getAbsoluteVector();
+        maxAbsCoordinates = Vector3::max(maxAbsCoordinates, absPoint);
+        mNextOutsidePoint.add(-1);
+        mVertexNbFaces.add(0);
+    }
+    mEpsilon = decimal(3.0) * (maxAbsCoordinates.x + maxAbsCoordinates.y + maxAbsCoordinates.z) * MACHINE_EPSILON;
+}
+
+// Compute the convex hull of a set of points
+/// The method returns false if the hull cannot be computed (less than four points or all
+/// the points are coplanar). The output vertices are the vertices of the hull, the output
+/// faces are polygons (in counter-clockwise order as seen from outside the hull) that index
+/// into the output indices array.
+/**
+ * @param points Array with the input points
+ * @param settings Settings of the hull computation
+ * @param allocator Memory allocator for the temporary data
+ * @param[out] outVertices Vertices of the hull
+ * @param[out] outIndices Vertex indices of the faces of the hull
+ * @param[out] outFaces Polygon faces of the hull
+ * @return True if the hull has been computed
+ */
+bool QuickHull::computeConvexHull(const Array<Vector3>& points, const Settings& settings, MemoryAllocator& allocator,
+                                  Array<Vector3>& outVertices, Array<uint32>& outIndices,
+                                  Array<PolygonVertexArray::PolygonFace>& outFaces) {
+
+    QuickHull quickHull(points, allocator);
+
+    if (!quickHull.build(settings)) {
+        return false;
+    }
+
+    quickHull.computeOutput(settings, outVertices, outIndices, outFaces);
+
+    return true;
+}
+
+// Return the signed distance between a point and the plane of a face
+decimal QuickHull::getDistanceToFace(const HullFace& face, const Vector3& point) const {
+    return face.normal.dot(point) - face.planeOffset;
+}
+
+// Create a new face and return its index
+uint32 QuickHull::createFace(uint32 v0, uint32 v1, uint32 v2) {
+
+    HullFace face;
+    face.vertices[0] = v0;
+    face.vertices[1] = v1;
+    face.vertices[2] = v2;
+    face.neighbors[0] = face.neighbors[1] = face.neighbors[2] = 0;
+    face.normal = (mPoints[v1] - mPoints[v0]).cross(mPoints[v2] - mPoints[v0]);
+    const decimal normalLength = face.normal.length();
+    if (normalLength > MACHINE_EPSILON) {
+        face.normal /= normalLength;
+    }
+    face.planeOffset = face.normal.dot(mPoints[v0]);
+    face.firstOutsidePoint = -1;
+    face.furthestPoint = -1;
+    face.furthestPointDistance = 0;
+    face.isAlive = true;
+    face.aliveFaceIndex = static_cast<uint32>(mAliveFaces.size());
+
+    for (uint32 i=0; i < 3; i++) {
+        if (mVertexNbFaces[face.vertices[i]] == 0) {
+            mNbHullVertices++;
+        }
+        mVertexNbFaces[face.vertices[i]]++;
+    }
+
+    const uint32 faceIndex = static_cast<uint32>(mFaces.size());
+    mFaces.add(face);
+    mAliveFaces.add(faceIndex);
+    mIsFaceVisible.add(false);
+
+    return faceIndex;
+}
+
+// Remove a face from the hull
+/// The face is kept in the array of faces (its index is used by its outside points
+/// and neighbors until they are updated) but it is removed from the alive faces.
+void QuickHull::removeFace(uint32 faceIndex) {
+
+    HullFace& face = mFaces[faceIndex];
+    assert(face.isAlive);
+    face.isAlive = false;
+
+    for (uint32 i=0; i < 3; i++) {
+        mVertexNbFaces[face.vertices[i]]--;
+        if (mVertexNbFaces[face.vertices[i]] == 0) {
+            mNbHullVertices--;
+        }
+    }
+
+    // Replace the face by the last alive face
+    const uint32 lastAliveFace = mAliveFaces[mAliveFaces.size() - 1];
+    mAliveFaces[face.aliveFaceIndex] = lastAliveFace;
+    mFaces[lastAliveFace].aliveFaceIndex = face.aliveFaceIndex;
+    mAliveFaces.removeAt(mAliveFaces.size() - 1);
+}
+
+// Create the initial tetrahedron (return false if the points are degenerate)
+bool QuickHull::createInitialTetrahedron(Array<uint32>& outTetrahedronVertices) {
+
+    const uint32 nbPoints = static_cast<uint32>(mPoints.size());
+    if (nbPoints < 4) {
+        return false;
+    }
+
+    // Find the extreme points along each axis
+    uint32 minPoints[3] = {0, 0, 0};
+    uint32 maxPoints[3] = {0, 0, 0};
+    for (uint32 i=1; i < nbPoints; i++) {
+        for (int axis=0; axis < 3; axis++) {
+            if (mPoints[i][axis] < mPoints[minPoints[axis]][axis]) minPoints[axis] = i;
+            if (mPoints[i][axis] > mPoints[maxPoints[axis]][axis]) maxPoints[axis] = i;
+        }
+    }
+
+    // The first two points are the most distant pair of extreme points
+    uint32 p0 = minPoints[0];
+    uint32 p1 = maxPoints[0];
+    decimal maxDistanceSquare = (mPoints[p1] - mPoints[p0]).lengthSquare();
+    for (int axis=1; axis < 3; axis++) {
+        const decimal distanceSquare = (mPoints[maxPoints[axis]] - mPoints[minPoints[axis]]).lengthSquare();
+        if (distanceSquare > maxDistanceSquare) {
+            maxDistanceSquare = distanceSquare;
+            p0 = minPoints[axis];
+            p1 = maxPoints[axis];
+        }
+    }
+    if (maxDistanceSquare <= mEpsilon * mEpsilon) {
+        return false;
+    }
+
+    // The third point is the furthest point from the line (p0, p1)
+    const Vector3 lineDirection = (mPoints[p1] - mPoints[p0]).getUnit();
+    uint32 p2 = 0;
+    decimal maxDistance = 0;
+    for (uint32 i=0; i < nbPoints; i++) {
+        const decimal distance = (mPoints[i] - mPoints[p0]).cross(lineDirection).length();
+        if (distance > maxDistance) {
+            maxDistance = distance;
+            p2 = i;
+        }
+    }
+    if (maxDistance <= mEpsilon) {
+        return false;
+    }
+
+    // The fourth point is the furthest point from the plane (p0, p1, p2)
+    const Vector3 planeNormal = (mPoints[p1] - mPoints[p0]).cross(mPoints[p2] - mPoints[p0]).getUnit();
+    uint32 p3 = 0;
+    decimal maxSignedDistance = 0;
+    maxDistance = 0;
+    for (uint32 i=0; i < nbPoints; i++) {
+        const decimal signedDistance = planeNormal.dot(mPoints[i] - mPoints[p0]);
+        if (std::abs(signedDistance) > maxDistance) {
+            maxDistance = std::abs(signedDistance);
+            maxSignedDistance = signedDistance;
+            p3 = i;
+        }
+    }
+    if (maxDistance <= mEpsilon) {
+        return false;
+    }
+
+    // Make sure that the fourth point is behind the face (p0, p1, p2)
+    if (maxSignedDistance > 0) {
+        std::swap(p0, p1);
+    }
+
+    // Create the faces of the tetrahedron (with outward normals)
+    createFace(p0, p1, p2);
+    createFace(p0, p3, p1);
+    createFace(p1, p3, p2);
+    createFace(p2, p3, p0);
+
+    // Find the neighbors of each face
+    for (uint32 f=0; f < 4; f++) {
+        for (uint32 i=0; i < 3; i++) {
+            const uint32 u = mFaces[f].vertices[i];
+            const uint32 v = mFaces[f].vertices[(i + 1) % 3];
+            for (uint32 g=0; g < 4; g++) {
+                for (uint32 j=0; j < 3; j++) {
+                    if (mFaces[g].vertices[j] == v && mFaces[g].vertices[(j + 1) % 3] == u) {
+                        mFaces[f].neighbors[i] = g;
+                    }
+                }
+            }
+        }
+    }
+
+    outTetrahedronVertices.add(p0);
+    outTetrahedronVertices.add(p1);
+    outTetrahedronVertices.add(p2);
+    outTetrahedronVertices.add(p3);
+
+    return true;
+}
+
+// Assign a point to the outside set of the face (among a range of faces) it is the furthest in front of
+/// If the point is not in front of any face, it is inside the hull and is discarded.
+void QuickHull::assignPointToFaces(uint32 pointIndex, uint32 firstFace, uint32 endFace) {
+
+    int32 bestFace = -1;
+    decimal bestDistance = mEpsilon;
+    for (uint32 f=firstFace; f < endFace; f++) {
+        if (!mFaces[f].isAlive) continue;
+        const decimal distance = getDistanceToFace(mFaces[f], mPoints[pointIndex]);
+        if (distance > bestDistance) {
+            bestDistance = distance;
+            bestFace = static_cast<int32>(f);
+        }
+    }
+
+    if (bestFace < 0) {
+        return;
+    }
+
+    HullFace& face = mFaces[bestFace];
+    mNextOutsidePoint[pointIndex] = face.firstOutsidePoint;
+    face.firstOutsidePoint = static_cast<int32>(pointIndex);
+    if (bestDistance > face.furthestPointDistance) {
+        face.furthestPointDistance = bestDistance;
+        face.furthestPoint = static_cast<int32>(pointIndex);
+    }
+}
+
+// Add the furthest point of the outside set of a face into the hull
+void QuickHull::addPointToHull(uint32 faceIndex) {
+
+    assert(mFaces[faceIndex].furthestPoint >= 0);
+
+    const uint32 eyePoint = static_cast<uint32>(mFaces[faceIndex].furthestPoint);
+    const Vector3 eye = mPoints[eyePoint];
+
+    // Find all the faces visible from the eye point and the horizon edges
+    mVisibleFaces.clear();
+    mHorizon.clear();
+    mFacesStack.push(faceIndex);
+    mIsFaceVisible[faceIndex] = true;
+    while (mFacesStack.size() > 0) {
+
+        const uint32 f = mFacesStack.pop();
+        mVisibleFaces.add(f);
+
+        for (uint32 i=0; i < 3; i++) {
+            const uint32 neighbor = mFaces[f].neighbors[i];
+            if (mIsFaceVisible[neighbor]) continue;
+
+            if (getDistanceToFace(mFaces[neighbor], eye) > mEpsilon) {
+                mIsFaceVisible[neighbor] = true;
+                mFacesStack.push(neighbor);
+            }
+            else {
+                mHorizon.add({mFaces[f].vertices[i], mFaces[f].vertices[(i + 1) % 3], neighbor});
+            }
+        }
+    }
+
+    // Reset the visibility flags of the visible faces for the next point
+    for (uint32 k=0; k < mVisibleFaces.size(); k++) {
+        mIsFaceVisible[mVisibleFaces[k]] = false;
+    }
+
+    // Order the horizon edges into a loop
+    bool isHorizonValid = mHorizon.size() >= 3;
+    for (uint32 k=0; k + 1 < mHorizon.size() && isHorizonValid; k++) {
+        isHorizonValid = false;
+        for (uint32 l=k+1; l < mHorizon.size(); l++) {
+            if (mHorizon[l].start == mHorizon[k].end) {
+                std::swap(mHorizon[k + 1], mHorizon[l]);
+                isHorizonValid = true;
+                break;
+            }
+        }
+    }
+    isHorizonValid = isHorizonValid && mHorizon[mHorizon.size() - 1].end == mHorizon[0].start;
+
+    // If the horizon is not a simple loop (numerical issue), the eye point is
+    // discarded from the outside set of the face
+    if (!isHorizonValid) {
+
+        HullFace& face = mFaces[faceIndex];
+        int32 previous = -1;
+        for (int32 p = face.firstOutsidePoint; p != -1; p = mNextOutsidePoint[p]) {
+            if (static_cast<uint32>(p) == eyePoint) {
+                if (previous == -1) face.firstOutsidePoint = mNextOutsidePoint[p];
+                else mNextOutsidePoint[previous] = mNextOutsidePoint[p];
+                break;
+            }
+            previous = p;
+        }
+
+        // Recompute the furthest point of the face
+        face.furthestPoint = -1;
+        face.furthestPointDistance = 0;
+        for (int32 p = face.firstOutsidePoint; p != -1; p = mNextOutsidePoint[p]) {
+            const decimal distance = getDistanceToFace(face, mPoints[p]);
+            if (distance > face.furthestPointDistance) {
+                face.furthestPointDistance = distance;
+                face.furthestPoint = p;
+            }
+        }
+
+        return;
+    }
+
+    // Create the new faces between the horizon edges and the eye point
+    const uint32 firstNewFace = static_cast<uint32>(mFaces.size());
+    const uint32 nbHorizonEdges = static_cast<uint32>(mHorizon.size());
+    for (uint32 k=0; k < nbHorizonEdges; k++) {
+
+        const uint32 newFace = createFace(mHorizon[k].start, mHorizon[k].end, eyePoint);
+        mFaces[newFace].neighbors[0] = mHorizon[k].neighborFace;
+        mFaces[newFace].neighbors[1] = firstNewFace + (k + 1) % nbHorizonEdges;
+        mFaces[newFace].neighbors[2] = firstNewFace + (k + nbHorizonEdges - 1) % nbHorizonEdges;
+
+        // Update the neighbor of the face on the other side of the horizon edge
+        HullFace& neighbor = mFaces[mHorizon[k].neighborFace];
+        for (uint32 i=0; i < 3; i++) {
+            if (neighbor.vertices[i] == mHorizon[k].end && neighbor.vertices[(i + 1) % 3] == mHorizon[k].start) {
+                neighbor.neighbors[i] = newFace;
+            }
+        }
+    }
+    const uint32 endNewFace = static_cast<uint32>(mFaces.size());
+
+    // Remove the visible faces and reassign their outside points to the new faces
+    for (uint32 k=0; k < mVisibleFaces.size(); k++) {
+
+        removeFace(mVisibleFaces[k]);
+
+        HullFace& face = mFaces[mVisibleFaces[k]];
+
+        int32 point = face.firstOutsidePoint;
+        face.firstOutsidePoint = -1;
+        face.furthestPoint = -1;
+        while (point != -1) {
+            const int32 nextPoint = mNextOutsidePoint[point];
+            if (static_cast<uint32>(point) != eyePoint) {
+                assignPointToFaces(static_cast<uint32>(point), firstNewFace, endNewFace);
+            }
+            point = nextPoint;
+        }
+    }
+}
+
+// Build the hull
+bool QuickHull::build(const Settings& settings) {
+
+    Array<uint32> tetrahedronVertices(mAllocator, 4);
+    if (!createInitialTetrahedron(tetrahedronVertices)) {
+        return false;
+    }
+
+    // Assign all the other points to the outside sets of the faces
+    for (uint32 i=0; i < mPoints.size(); i++) {
+        if (tetrahedronVertices.find(i) == tetrahedronVertices.end()) {
+            assignPointToFaces(i, 0, 4);
+        }
+    }
+
+    const uint32 maxNbVertices = settings.maxNbVertices > 0 ? std::max(settings.maxNbVertices, uint32(4)) : 0;
+    const uint32 maxNbFaces = settings.maxNbFaces > 0 ? std::max(settings.maxNbFaces, uint32(4)) : 0;
+
+    while (true) {
+
+        // Stop if the budget of vertices or faces has been reached (adding a vertex
+        // to a triangulated hull adds two faces)
+        if (maxNbVertices > 0 && mNbHullVertices >= maxNbVertices) break;
+        if (maxNbFaces > 0 && mAliveFaces.size() + 2 > maxNbFaces) break;
+
+        // Find the furthest outside point of all the alive faces
+        int32 bestFace = -1;
+        decimal bestDistance = 0;
+        for (uint32 k=0; k < mAliveFaces.size(); k++) {
+            const HullFace& face = mFaces[mAliveFaces[k]];
+            if (face.furthestPoint >= 0 && face.furthestPointDistance > bestDistance) {
+                bestDistance = face.furthestPointDistance;
+                bestFace = static_cast<int32>(mAliveFaces[k]);
+            }
+        }
+
+        // If there are no more points outside the hull
+        if (bestFace < 0) break;
+
+        addPointToHull(static_cast<uint32>(bestFace));
+    }
+
+    return true;
+}
+
+// Compute the output polygon faces of the hull
+void QuickHull::computeOutput(const Settings& settings, Array<Vector3>& outVertices, Array<uint32>& outIndices,
+                              Array<PolygonVertexArray::PolygonFace>& outFaces) {
+
+    const decimal cosAngleTolerance = std::cos(settings.coplanarFacesAngleTolerance);
+
+    // Group the adjacent coplanar triangle faces into clusters
+    Array<int32> faceCluster(mAllocator, mFaces.size());
+    for (uint32 f=0; f < mFaces.size(); f++) {
+        faceCluster.add(-1);
+    }
+    Array<Array<uint32>> clusters(mAllocator);
+    Stack<uint32> stack(mAllocator);
+    for (uint32 f=0; f < mFaces.size(); f++) {
+
+        if (!mFaces[f].isAlive || faceCluster[f] != -1) continue;
+
+        const int32 clusterIndex = static_cast<int32>(clusters.size());
+        clusters.add(Array<uint32>(mAllocator));
+        faceCluster[f] = clusterIndex;
+        stack.push(f);
+        while (stack.size() > 0) {
+            const uint32 face = stack.pop();
+            clusters[clusterIndex].add(face);
+            if (!settings.mergeCoplanarFaces) continue;
+            for (uint32 i=0; i < 3; i++) {
+                const uint32 neighbor = mFaces[face].neighbors[i];
+                if (faceCluster[neighbor] == -1 && mFaces[neighbor].normal.dot(mFaces[f].normal) >= cosAngleTolerance) {
+                    faceCluster[neighbor] = clusterIndex;
+                    stack.push(neighbor);
+                }
+            }
+        }
+    }
+
+    // Compute the boundary polygon of each cluster
+    Array<Array<uint32>> polygons(mAllocator);
+    for (uint32 c=0; c < clusters.size(); c++) {
+
+        const Array<uint32>& cluster = clusters[c];
+
+        Array<uint32> polygon(mAllocator);
+        if (cluster.size() == 1) {
+            polygon.add(mFaces[cluster[0]].vertices[0]);
+            polygon.add(mFaces[cluster[0]].vertices[1]);
+            polygon.add(mFaces[cluster[0]].vertices[2]);
+            polygons.add(polygon);
+            continue;
+        }
+
+        // Collect the boundary edges of the cluster
+        Array<Pair<uint32, uint32>> boundaryEdges(mAllocator);
+        for (uint32 k=0; k < cluster.size(); k++) {
+            const HullFace& face = mFaces[cluster[k]];
+            for (uint32 i=0; i < 3; i++) {
+                if (faceCluster[face.neighbors[i]] != static_cast<int32>(c)) {
+                    boundaryEdges.add(Pair<uint32, uint32>(face.vertices[i], face.vertices[(i + 1) % 3]));
+                }
+            }
+        }
+
+        // Chain the boundary edges into a single loop
+        bool isLoopValid = boundaryEdges.size() >= 3;
+        for (uint32 k=0; k + 1 < boundaryEdges.size() && isLoopValid; k++) {
+            isLoopValid = false;
+            for (uint32 l=k+1; l < boundaryEdges.size(); l++) {
+                if (boundaryEdges[l].first == boundaryEdges[k].second) {
+                    std::swap(boundaryEdges[k + 1], boundaryEdges[l]);
+                    isLoopValid = true;
+                    break;
+                }
+            }
+        }
+        isLoopValid = isLoopValid && boundaryEdges[boundaryEdges.size() - 1].second == boundaryEdges[0].first;
+
+        if (isLoopValid) {
+            for (uint32 k=0; k < boundaryEdges.size(); k++) {
+                polygon.add(boundaryEdges[k].first);
+            }
+            polygons.add(polygon);
+        }
+        else {
+
+            // The cluster is not a simple polygon, we keep its triangles
+            for (uint32 k=0; k < cluster.size(); k++) {
+                Array<uint32> triangle(mAllocator, 3);
+                triangle.add(mFaces[cluster[k]].vertices[0]);
+                triangle.add(mFaces[cluster[k]].vertices[1]);
+                triangle.add(mFaces[cluster[k]].vertices[2]);
+                polygons.add(triangle);
+            }
+        }
+    }
+
+    // Create the output vertices and faces
+    Array<int32> outputVertexIndex(mAllocator, mPoints.size());
+    for (uint32 i=0; i < mPoints.size(); i++) {
+        outputVertexIndex.add(-1);
+    }
+    for (uint32 p=0; p < polygons.size(); p++) {
+
+        const Array<uint32>& polygon = polygons[p];
+        const uint32 nbPolygonVertices = static_cast<uint32>(polygon.size());
+
+        // Start the polygon at the vertex with the best conditioned corner because the
+        // face normal is computed with the first three vertices of the face
+        uint32 start = 0;
+        decimal maxCrossLength = -1;
+        for (uint32 k=0; k < nbPolygonVertices; k++) {
+            const Vector3& v0 = mPoints[polygon[k]];
+            const Vector3& v1 = mPoints[polygon[(k + 1) % nbPolygonVertices]];
+            const Vector3& v2 = mPoints[polygon[(k + 2) % nbPolygonVertices]];
+            const decimal crossLength = (v1 - v0).cross(v2 - v0).lengthSquare();
+            if (crossLength > maxCrossLength) {
+                maxCrossLength = crossLength;
+                start = k;
+            }
+        }
+
+        PolygonVertexArray::PolygonFace face;
+        face.nbVertices = nbPolygonVertices;
+        face.indexBase = static_cast<uint32>(outIndices.size());
+        outFaces.add(face);
+
+        for (uint32 k=0; k < nbPolygonVertices; k++) {
+            const uint32 pointIndex = polygon[(start + k) % nbPolygonVertices];
+            if (outputVertexIndex[pointIndex] == -1) {
+                outputVertexIndex[pointIndex] = static_cast<int32>(outVertices.size());
+                outVertices.add(mPoints[pointIndex]);
+            }
+            outIndices.add(static_cast<uint32>(outputVertexIndex[pointIndex]));
+        }
+    }
+}
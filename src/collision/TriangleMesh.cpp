@@ -25,15 +25,289 @@
 
 // Libraries
 #include <reactphysics3d/collision/TriangleMesh.h>
+#include <reactphysics3d/collision/TriangleVertexArray.h>
+#include <reactphysics3d/collision/CookedMesh.h>
+#include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
+#include <reactphysics3d/engine/PhysicsCommon.h>
+#include <cstdint>
 
 using namespace reactphysics3d;
 
 // Constructor
-TriangleMesh::TriangleMesh(MemoryAllocator& allocator) : mTriangleArrays(allocator) {
+TriangleMesh::TriangleMesh(MemoryAllocator& allocator)
+             : mAllocator(allocator), mTriangleArrays(allocator), mNbOwnedTriangleArrays(0),
+               mCookedBVHNodes(nullptr), mCookedBVHNbNodes(0), mCookedBVHRootNodeID(TreeNode::NULL_TREE_NODE) {
 
 }
 
 // Destructor
 TriangleMesh::~TriangleMesh() {
 
+    // Destroy the triangle arrays that have been created from cooked data
+    for (uint32 i=0; i < mNbOwnedTriangleArrays; i++) {
+        mTriangleArrays[i]->~TriangleVertexArray();
+        mAllocator.release(mTriangleArrays[i], sizeof(TriangleVertexArray));
+    }
+}
+
+// Insert all the triangles of the mesh into a dynamic AABB tree
+void TriangleMesh::insertTrianglesIntoTree(DynamicAABBTree& tree) const {
+
+    // TODO : Try to randomly add the triangles into the tree to obtain a better tree
+
+    // For each sub-part of the mesh
+    for (uint32 subPart=0; subPart < getNbSubparts(); subPart++) {
+
+        // Get the triangle vertex array of the current sub-part
+        TriangleVertexArray* triangleVertexArray = getSubpart(subPart);
+
+        // For each triangle of the concave mesh
+        for (uint32 triangleIndex=0; triangleIndex<triangleVertexArray->getNbTriangles(); triangleIndex++) {
+
+            Vector3 trianglePoints[3];
+
+            // Get the triangle vertices
+            triangleVertexArray->getTriangleVertices(triangleIndex, trianglePoints);
+
+            // Create the AABB for the triangle
+            AABB aabb = AABB::createAABBForTriangle(trianglePoints);
+
+            // Add the AABB with the index of the triangle into the dynamic AABB tree
+            tree.addObject(aabb, subPart, triangleIndex);
+        }
+    }
+}
+
+// Serialize the mesh into a cooked binary blob
+/// The cooked data contains the vertices, the vertices normals, the triangles indices
+/// and the BVH of the triangles. The method always returns the size (in bytes) of the cooked
+/// data. The data is only written if "outData" is not null and "outDataSize" is large enough.
+/// "outData" must be aligned on COOKED_MESH_ALIGNMENT bytes.
+size_t TriangleMesh::cook(void* outData, size_t outDataSize) const {
+
+    const uint32 nbSubparts = getNbSubparts();
+
+    // Compute the layout of the cooked data
+    uint64 offset = alignCookedMeshOffset(sizeof(CookedMeshHeader));
+    const uint64 infoOffset = offset;
+    offset = alignCookedMeshOffset(offset + sizeof(CookedTriangleMeshInfo));
+    const uint64 subpartsOffset = offset;
+    offset = alignCookedMeshOffset(offset + nbSubparts * sizeof(CookedTriangleSubpart));
+
+    Array<CookedTriangleSubpart> subparts(mAllocator, nbSubparts);
+    uint32 nbTotalTriangles = 0;
+    for (uint32 s=0; s < nbSubparts; s++) {
+
+        const TriangleVertexArray* array = mTriangleArrays[s];
+
+        CookedTriangleSubpart subpart;
+        subpart.nbVertices = array->getNbVertices();
+        subpart.nbTriangles = array->getNbTriangles();
+        subpart.verticesOffset = offset;
+        offset = alignCookedMeshOffset(offset + subpart.nbVertices * 3 * sizeof(decimal));
+        subpart.normalsOffset = offset;
+        offset = alignCookedMeshOffset(offset + subpart.nbVertices * 3 * sizeof(decimal));
+        subpart.indicesOffset = offset;
+        offset = alignCookedMeshOffset(offset + subpart.nbTriangles * 3 * sizeof(uint32));
+        subparts.add(subpart);
+
+        nbTotalTriangles += subpart.nbTriangles;
+    }
+
+    // A binary tree with N leaves has 2 * N - 1 nodes
+    CookedTriangleMeshInfo info;
+    info.nbSubparts = nbSubparts;
+    info.bvhNbNodes = nbTotalTriangles > 0 ? static_cast<int32>(2 * nbTotalTriangles - 1) : 0;
+    info.bvhRootNodeID = TreeNode::NULL_TREE_NODE;
+    info.padding = 0;
+    info.bvhNodesOffset = offset;
+    offset = alignCookedMeshOffset(offset + static_cast<uint64>(info.bvhNbNodes) * sizeof(TreeNode));
+
+    const size_t totalSize = static_cast<size_t>(offset);
+
+    if (outData == nullptr || outDataSize < totalSize) {
+        return totalSize;
+    }
+
+    assert(reinterpret_cast<uintptr_t>(outData) % COOKED_MESH_ALIGNMENT == 0);
+
+    unsigned char* data = static_cast<unsigned char*>(outData);
+    std::memset(data, 0, totalSize);
+
+    // Write the vertices, normals and indices of each sub-part
+    for (uint32 s=0; s < nbSubparts; s++) {
+
+        TriangleVertexArray* array = mTriangleArrays[s];
+        const CookedTriangleSubpart& subpart = subparts[s];
+
+        decimal* vertices = reinterpret_cast<decimal*>(data + subpart.verticesOffset);
+        decimal* normals = reinterpret_cast<decimal*>(data + subpart.normalsOffset);
+        for (uint32 v=0; v < subpart.nbVertices; v++) {
+
+            Vector3 vertex;
+            array->getVertex(v, &vertex);
+            Vector3 normal;
+            array->getNormal(v, &normal);
+
+            vertices[v * 3] = vertex.x;
+            vertices[v * 3 + 1] = vertex.y;
+            vertices[v * 3 + 2] = vertex.z;
+            normals[v * 3] = normal.x;
+            normals[v * 3 + 1] = normal.y;
+            normals[v * 3 + 2] = normal.z;
+        }
+
+        uint32* indices = reinterpret_cast<uint32*>(data + subpart.indicesOffset);
+        for (uint32 t=0; t < subpart.nbTriangles; t++) {
+            array->getTriangleVerticesIndices(t, indices + t * 3);
+        }
+    }
+
+    // Build the BVH of the triangles and write its nodes
+    if (info.bvhNbNodes > 0) {
+
+        DynamicAABBTree tree(mAllocator);
+        insertTrianglesIntoTree(tree);
+
+        // Nodes are never released while building the tree and therefore all the nodes are contiguous
+        assert(tree.getNbNodes() == info.bvhNbNodes);
+
+        info.bvhRootNodeID = tree.getRootNodeID();
+        std::memcpy(data + info.bvhNodesOffset, tree.getNodes(), static_cast<size_t>(info.bvhNbNodes) * sizeof(TreeNode));
+    }
+
+    // Write the header and the mesh description
+    CookedMeshHeader header;
+    header.magic = COOKED_MESH_MAGIC;
+    header.version = COOKED_MESH_VERSION;
+    header.type = CookedMeshType::TRIANGLE_MESH;
+    header.decimalSize = sizeof(decimal);
+    header.treeNodeSize = sizeof(TreeNode);
+    header.padding = 0;
+    header.totalSize = totalSize;
+    std::memcpy(data, &header, sizeof(CookedMeshHeader));
+    std::memcpy(data + infoOffset, &info, sizeof(CookedTriangleMeshInfo));
+    for (uint32 s=0; s < nbSubparts; s++) {
+        std::memcpy(data + subpartsOffset + s * sizeof(CookedTriangleSubpart), &subparts[s], sizeof(CookedTriangleSubpart));
+    }
+
+    return totalSize;
+}
+
+// Static factory method to create a triangle mesh from cooked data
+/// The vertices, normals, indices and BVH of the mesh are used in place and are not copied.
+/// Therefore, the cooked data must remain valid during the lifetime of the mesh. This method
+/// returns nullptr if the cooked data is not valid.
+TriangleMesh* TriangleMesh::createFromCookedData(const void* cookedData, size_t cookedDataSize,
+                                                 MemoryAllocator& triangleMeshAllocator, MemoryAllocator& dataAllocator) {
+
+    const unsigned char* data = static_cast<const unsigned char*>(cookedData);
+
+    // Validate the header
+    bool isValid = data != nullptr && cookedDataSize >= sizeof(CookedMeshHeader) &&
+                   reinterpret_cast<uintptr_t>(data) % COOKED_MESH_ALIGNMENT == 0;
+    CookedMeshHeader header;
+    if (isValid) {
+        std::memcpy(&header, data, sizeof(CookedMeshHeader));
+        isValid = header.magic == COOKED_MESH_MAGIC && header.version == COOKED_MESH_VERSION &&
+                  header.type == CookedMeshType::TRIANGLE_MESH && header.decimalSize == sizeof(decimal) &&
+                  header.treeNodeSize == sizeof(TreeNode) && header.totalSize <= cookedDataSize;
+    }
+
+    // Validate the mesh description and the sections
+    const uint64 infoOffset = alignCookedMeshOffset(sizeof(CookedMeshHeader));
+    const uint64 subpartsOffset = alignCookedMeshOffset(infoOffset + sizeof(CookedTriangleMeshInfo));
+    const CookedTriangleMeshInfo* info = nullptr;
+    const CookedTriangleSubpart* subparts = nullptr;
+    if (isValid) {
+        isValid = isCookedMeshSectionValid(infoOffset, sizeof(CookedTriangleMeshInfo), header.totalSize);
+    }
+    if (isValid) {
+        info = reinterpret_cast<const CookedTriangleMeshInfo*>(data + infoOffset);
+        isValid = info->bvhNbNodes >= 0 &&
+                  isCookedMeshSectionValid(subpartsOffset, static_cast<uint64>(info->nbSubparts) * sizeof(CookedTriangleSubpart), header.totalSize) &&
+                  isCookedMeshSectionValid(info->bvhNodesOffset, static_cast<uint64>(info->bvhNbNodes) * sizeof(TreeNode), header.totalSize) &&
+                  (info->bvhNbNodes == 0 || (info->bvhRootNodeID >= 0 && info->bvhRootNodeID < info->bvhNbNodes));
+    }
+    if (isValid) {
+        subparts = reinterpret_cast<const CookedTriangleSubpart*>(data + subpartsOffset);
+        for (uint32 s=0; s < info->nbSubparts && isValid; s++) {
+            const uint64 verticesSize = static_cast<uint64>(subparts[s].nbVertices) * 3 * sizeof(decimal);
+            const uint64 indicesSize = static_cast<uint64>(subparts[s].nbTriangles) * 3 * sizeof(uint32);
+            isValid = isCookedMeshSectionValid(subparts[s].verticesOffset, verticesSize, header.totalSize) &&
+                      isCookedMeshSectionValid(subparts[s].normalsOffset, verticesSize, header.totalSize) &&
+                      isCookedMeshSectionValid(subparts[s].indicesOffset, indicesSize, header.totalSize);
+        }
+    }
+
+    // Validate the triangle indices (they are used in place by the triangle vertex arrays)
+    if (isValid) {
+        for (uint32 s=0; s < info->nbSubparts && isValid; s++) {
+            const uint32* indices = reinterpret_cast<const uint32*>(data + subparts[s].indicesOffset);
+            const uint64 nbIndices = static_cast<uint64>(subparts[s].nbTriangles) * 3;
+            for (uint64 i=0; i < nbIndices && isValid; i++) {
+                isValid = indices[i] < subparts[s].nbVertices;
+            }
+        }
+    }
+
+    // Validate the BVH nodes (they are used in place by the dynamic AABB tree of the concave mesh shapes).
+    // All the nodes are in the tree. The children of an internal node must point back to it and must be
+    // lower in the tree, which also guarantees that the tree has no cycle.
+    if (isValid && info->bvhNbNodes > 0) {
+        const TreeNode* nodes = reinterpret_cast<const TreeNode*>(data + info->bvhNodesOffset);
+        isValid = nodes[info->bvhRootNodeID].parentID == TreeNode::NULL_TREE_NODE;
+        for (int32 n=0; n < info->bvhNbNodes && isValid; n++) {
+            const TreeNode& node = nodes[n];
+            isValid = node.height >= 0 && (n == info->bvhRootNodeID ||
+                                           (node.parentID >= 0 && node.parentID < info->bvhNbNodes));
+            if (isValid && node.isLeaf()) {
+                isValid = node.dataInt[0] >= 0 && static_cast<uint32>(node.dataInt[0]) < info->nbSubparts &&
+                          node.dataInt[1] >= 0 && static_cast<uint32>(node.dataInt[1]) < subparts[node.dataInt[0]].nbTriangles;
+            }
+            else if (isValid) {
+                for (int c=0; c < 2 && isValid; c++) {
+                    const int32 childID = node.children[c];
+                    isValid = childID >= 0 && childID < info->bvhNbNodes && nodes[childID].parentID == n &&
+                              nodes[childID].height < node.height;
+                }
+            }
+        }
+    }
+
+    if (!isValid) {
+
+        RP3D_LOG("PhysicsCommon", Logger::Level::Error, Logger::Category::PhysicCommon,
+                 "Error when creating a TriangleMesh: the cooked data is not valid", __FILE__, __LINE__);
+
+        return nullptr;
+    }
+
+    TriangleMesh* mesh = new (triangleMeshAllocator.allocate(sizeof(TriangleMesh))) TriangleMesh(dataAllocator);
+
+    const TriangleVertexArray::VertexDataType vertexDataType = sizeof(decimal) == sizeof(float) ?
+                TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE : TriangleVertexArray::VertexDataType::VERTEX_DOUBLE_TYPE;
+    const TriangleVertexArray::NormalDataType normalDataType = sizeof(decimal) == sizeof(float) ?
+                TriangleVertexArray::NormalDataType::NORMAL_FLOAT_TYPE : TriangleVertexArray::NormalDataType::NORMAL_DOUBLE_TYPE;
+
+    // Create a triangle vertex array that points to the cooked data for each sub-part
+    for (uint32 s=0; s < info->nbSubparts; s++) {
+
+        TriangleVertexArray* array = new (dataAllocator.allocate(sizeof(TriangleVertexArray)))
+                TriangleVertexArray(subparts[s].nbVertices, data + subparts[s].verticesOffset, 3 * sizeof(decimal),
+                                    data + subparts[s].normalsOffset, 3 * sizeof(decimal),
+                                    subparts[s].nbTriangles, data + subparts[s].indicesOffset, 3 * sizeof(uint32),
+                                    vertexDataType, normalDataType, TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+
+        mesh->mTriangleArrays.add(array);
+    }
+    mesh->mNbOwnedTriangleArrays = info->nbSubparts;
+
+    if (info->bvhNbNodes > 0) {
+        mesh->mCookedBVHNodes = reinterpret_cast<const TreeNode*>(data + info->bvhNodesOffset);
+        mesh->mCookedBVHNbNodes = info->bvhNbNodes;
+        mesh->mCookedBVHRootNodeID = info->bvhRootNodeID;
+    }
+
+    return mesh;
 }
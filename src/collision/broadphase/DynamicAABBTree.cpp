@@ -36,7 +36,8 @@ const int32 TreeNode::NULL_TREE_NODE = -1;
 
 // Constructor
 DynamicAABBTree::DynamicAABBTree(MemoryAllocator& allocator, decimal fatAABBInflatePercentage)
-                : mAllocator(allocator), mFatAABBInflatePercentage(fatAABBInflatePercentage) {
+                : mAllocator(allocator), mPeakNbNodes(0), mFatAABBInflatePercentage(fatAABBInflatePercentage), mIsNodesMemoryExternal(false),
+                  mNbObjectUpdates(0), mNbFatAABBHits(0), mNbReinsertions(0) {
 
     init();
 }
@@ -45,7 +46,9 @@ DynamicAABBTree::DynamicAABBTree(MemoryAllocator& allocator, decimal fatAABBInfl
 DynamicAABBTree::~DynamicAABBTree() {
 
     // Free the allocated memory for the nodes
-    mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
+    if (!mIsNodesMemoryExternal) {
+        mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
+    }
 }
 
 // Initialize the tree
@@ -53,7 +56,7 @@ void DynamicAABBTree::init() {
 
     mRootNodeID = TreeNode::NULL_TREE_NODE;
     mNbNodes = 0;
-    mNbAllocatedNodes = 8;
+    mNbAllocatedNodes = INIT_NB_ALLOCATED_NODES;
 
     // Allocate memory for the nodes of the tree
     mNodes = static_cast<TreeNode*>(mAllocator.allocate(static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode)));
@@ -77,18 +80,481 @@ void DynamicAABBTree::init() {
 // Clear all the nodes and reset the tree
 void DynamicAABBTree::reset() {
 
-    // Call the destructor of all the nodes
-    for (int32 i=0; i < mNbAllocatedNodes; i++) {
-        mNodes[i].~TreeNode();
+    if (!mIsNodesMemoryExternal) {
+
+        // Call the destructor of all the nodes
+        for (int32 i=0; i < mNbAllocatedNodes; i++) {
+            mNodes[i].~TreeNode();
+        }
+
+        // Free the allocated memory for the nodes
+        mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
     }
 
-    // Free the allocated memory for the nodes
-    mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
+    mIsNodesMemoryExternal = false;
+
+    resetUpdateCounters();
 
     // Initialize the tree
     init();
 }
 
+// Make sure there is enough allocated memory for a given number of nodes
+/// The new nodes are added at the front of the free nodes list.
+/**
+ * @param nbNodes The number of nodes that can be used without any new allocation
+ */
+void DynamicAABBTree::reserve(int32 nbNodes) {
+
+    if (nbNodes <= mNbAllocatedNodes) return;
+
+    if (mIsNodesMemoryExternal) {
+        copyExternalNodes();
+    }
+
+    int32 oldNbAllocatedNodes = mNbAllocatedNodes;
+    TreeNode* oldNodes = mNodes;
+    mNbAllocatedNodes = nbNodes;
+    mNodes = static_cast<TreeNode*>(mAllocator.allocate(static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode)));
+    assert(mNodes);
+
+    // Copy all the nodes (the free nodes are interleaved with the used ones)
+    std::uninitialized_copy(oldNodes, oldNodes + oldNbAllocatedNodes, mNodes);
+
+    mAllocator.release(oldNodes, static_cast<size_t>(oldNbAllocatedNodes) * sizeof(TreeNode));
+
+    // Initialize the allocated nodes and chain them in front of the current free nodes
+    for (int32 i=oldNbAllocatedNodes; i<mNbAllocatedNodes; i++) {
+        new (mNodes + i) TreeNode();
+        mNodes[i].nextNodeID = i + 1;
+        mNodes[i].height = -1;
+    }
+    mNodes[mNbAllocatedNodes - 1].nextNodeID = mFreeNodeID;
+    mFreeNodeID = oldNbAllocatedNodes;
+}
+
+// Move the nodes at the beginning of a memory buffer that fits them in depth-first order
+/// The IDs of the nodes change. The new ID of each previous node ID is returned in an array
+/// (TreeNode::NULL_TREE_NODE for the free nodes). After this call, the nodes that are close in
+/// the tree are also close in memory. The array is empty if the nodes have not been moved.
+/**
+ * @param outNewNodeIDs Array where the new ID of each previous node ID is stored
+ */
+void DynamicAABBTree::compact(Array<int32>& outNewNodeIDs) {
+
+    outNewNodeIDs.clear();
+
+    // The external nodes are already packed
+    if (mIsNodesMemoryExternal) return;
+
+    // We keep the initial number of allocated nodes
+    const int32 nbAllocatedNodes = mNbNodes > INIT_NB_ALLOCATED_NODES ? mNbNodes : INIT_NB_ALLOCATED_NODES;
+
+    // If the tree is empty, we simply reset it
+    if (mNbNodes == 0) {
+        if (mNbAllocatedNodes > nbAllocatedNodes) {
+            reset();
+        }
+        return;
+    }
+
+    // Compute the new ID of each node in depth-first order
+    outNewNodeIDs.reserve(static_cast<uint64>(mNbAllocatedNodes));
+    for (int32 i=0; i < mNbAllocatedNodes; i++) {
+        outNewNodeIDs.add(TreeNode::NULL_TREE_NODE);
+    }
+    Stack<int32> stack(mAllocator, 64);
+    stack.push(mRootNodeID);
+    int32 nextNodeID = 0;
+    while(stack.size() > 0) {
+
+        const int32 nodeID = stack.pop();
+        outNewNodeIDs[nodeID] = nextNodeID;
+        nextNodeID++;
+
+        if (!mNodes[nodeID].isLeaf()) {
+
+            // Push the right child first so that the left child is visited first
+            stack.push(mNodes[nodeID].children[1]);
+            stack.push(mNodes[nodeID].children[0]);
+        }
+    }
+    assert(nextNodeID == mNbNodes);
+
+    TreeNode* newNodes = static_cast<TreeNode*>(mAllocator.allocate(static_cast<size_t>(nbAllocatedNodes) * sizeof(TreeNode)));
+    assert(newNodes);
+
+    // Copy the nodes at their new location and update the links between them
+    for (int32 i=0; i < mNbAllocatedNodes; i++) {
+
+        const int32 newNodeID = outNewNodeIDs[i];
+        if (newNodeID == TreeNode::NULL_TREE_NODE) continue;
+
+        new (newNodes + newNodeID) TreeNode(mNodes[i]);
+        TreeNode& node = newNodes[newNodeID];
+        if (node.parentID != TreeNode::NULL_TREE_NODE) {
+            node.parentID = outNewNodeIDs[node.parentID];
+        }
+        if (!node.isLeaf()) {
+            node.children[0] = outNewNodeIDs[node.children[0]];
+            node.children[1] = outNewNodeIDs[node.children[1]];
+        }
+    }
+
+    // Call the destructor of all the previous nodes and release their memory
+    for (int32 i=0; i < mNbAllocatedNodes; i++) {
+        mNodes[i].~TreeNode();
+    }
+    mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
+
+    // Initialize the free nodes after the used ones
+    for (int32 i=mNbNodes; i < nbAllocatedNodes; i++) {
+        new (newNodes + i) TreeNode();
+        newNodes[i].nextNodeID = i + 1 < nbAllocatedNodes ? i + 1 : TreeNode::NULL_TREE_NODE;
+        newNodes[i].height = -1;
+    }
+
+    mNodes = newNodes;
+    mNbAllocatedNodes = nbAllocatedNodes;
+    mRootNodeID = outNewNodeIDs[mRootNodeID];
+    mFreeNodeID = mNbNodes < nbAllocatedNodes ? mNbNodes : TreeNode::NULL_TREE_NODE;
+}
+
+// Return the memory usage of the nodes of the tree
+/// The nodes stored in an external memory buffer are not reserved by the tree.
+MemoryUsage DynamicAABBTree::getMemoryUsage() const {
+
+    const size_t reservedMemory = mIsNodesMemoryExternal ? 0 : static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode);
+
+    return MemoryUsage(reservedMemory, static_cast<size_t>(mNbNodes) * sizeof(TreeNode),
+                       static_cast<size_t>(mPeakNbNodes) * sizeof(TreeNode));
+}
+
+// Compute the surface area heuristic (SAH) cost of the tree
+/// The cost is the sum of the surface areas of the internal nodes divided by the surface area
+/// of the root node. This is proportional to the expected number of internal nodes visited
+/// by a query. The cost of a tree with less than two leaf nodes is zero.
+decimal DynamicAABBTree::computeSAHCost() const {
+
+    if (mRootNodeID == TreeNode::NULL_TREE_NODE || mNodes[mRootNodeID].isLeaf()) return decimal(0.0);
+
+    const decimal rootArea = mNodes[mRootNodeID].aabb.getSurfaceArea();
+    if (rootArea <= MACHINE_EPSILON) return decimal(0.0);
+
+    // The free nodes have a negative height and the leaves a zero height
+    decimal internalNodesArea = 0;
+    for (int32 i=0; i < mNbAllocatedNodes; i++) {
+        if (mNodes[i].height > 0) {
+            internalNodesArea += mNodes[i].aabb.getSurfaceArea();
+        }
+    }
+
+    return internalNodesArea / rootArea;
+}
+
+// Compute the metrics describing the quality of the tree
+/// The cost of a rebuilt tree is computed without modifying the tree. The cost of this
+/// method is O(n log n) with the number n of objects in the tree.
+DynamicAABBTree::QualityMetrics DynamicAABBTree::computeQualityMetrics() const {
+
+    RP3D_PROFILE("DynamicAABBTree::computeQualityMetrics()", mProfiler);
+
+    QualityMetrics metrics;
+
+    metrics.nbLeafNodes = static_cast<uint32>(mNbNodes > 0 ? (mNbNodes + 1) / 2 : 0);
+    metrics.height = mRootNodeID != TreeNode::NULL_TREE_NODE ? mNodes[mRootNodeID].height : 0;
+    metrics.sahCost = computeSAHCost();
+    metrics.rebuiltSahCost = computeRebuiltSAHCost();
+    metrics.sahCostRatio = metrics.rebuiltSahCost > MACHINE_EPSILON ? metrics.sahCost / metrics.rebuiltSahCost : decimal(1.0);
+    metrics.nbObjectUpdates = mNbObjectUpdates;
+    metrics.nbFatAABBHits = mNbFatAABBHits;
+    metrics.nbReinsertions = mNbReinsertions;
+
+    return metrics;
+}
+
+// Return the IDs of all the leaf nodes of the tree
+/**
+ * @param outLeafNodes Array where the IDs of the leaf nodes are added
+ */
+void DynamicAABBTree::getLeafNodes(Array<int32>& outLeafNodes) const {
+
+    for (int32 i=0; i < mNbAllocatedNodes; i++) {
+        if (mNodes[i].isLeaf()) {
+            outLeafNodes.add(i);
+        }
+    }
+}
+
+// Split a range of leaf nodes in two using the binned surface area heuristic (SAH)
+/// The centers of the fat AABBs of the nodes are distributed in bins along the axis where
+/// they are the most spread and the split plane between two bins that minimizes the SAH cost
+/// of the two sub-trees is selected. The leaf nodes of the range are reordered so that the
+/// nodes of the first sub-tree come first.
+/**
+ * @param leafNodes Array with the IDs of the leaf nodes
+ * @param startIndex Index of the first leaf node of the range
+ * @param endIndex Index after the last leaf node of the range
+ * @param outAABB The AABB that contains all the leaf nodes of the range
+ * @return The index of the first leaf node of the second sub-tree
+ */
+uint32 DynamicAABBTree::splitLeafNodes(Array<int32>& leafNodes, uint32 startIndex, uint32 endIndex, AABB& outAABB) const {
+
+    assert(endIndex - startIndex >= 2);
+
+    // Compute the AABB of the nodes and the bounds of their centers
+    outAABB = mNodes[leafNodes[startIndex]].aabb;
+    Vector3 minCenter = outAABB.getCenter();
+    Vector3 maxCenter = minCenter;
+    for (uint32 i=startIndex + 1; i < endIndex; i++) {
+
+        const AABB& aabb = mNodes[leafNodes[i]].aabb;
+        outAABB.mergeWithAABB(aabb);
+        minCenter = Vector3::min(minCenter, aabb.getCenter());
+        maxCenter = Vector3::max(maxCenter, aabb.getCenter());
+    }
+
+    const int axis = (maxCenter - minCenter).getMaxAxis();
+    const decimal centersExtent = maxCenter[axis] - minCenter[axis];
+
+    // If all the centers are at the same position, we split the range in two halves
+    const uint32 middleIndex = startIndex + (endIndex - startIndex) / 2;
+    if (centersExtent <= MACHINE_EPSILON) return middleIndex;
+
+    // Distribute the nodes in the bins
+    const decimal binsScale = decimal(NB_SAH_BINS) / centersExtent;
+    AABB binsAABB[NB_SAH_BINS];
+    uint32 binsNbNodes[NB_SAH_BINS] = {};
+    for (uint32 i=startIndex; i < endIndex; i++) {
+
+        const AABB& aabb = mNodes[leafNodes[i]].aabb;
+        const uint32 bin = std::min(static_cast<uint32>((aabb.getCenter()[axis] - minCenter[axis]) * binsScale), NB_SAH_BINS - 1);
+        if (binsNbNodes[bin] == 0) {
+            binsAABB[bin] = aabb;
+        }
+        else {
+            binsAABB[bin].mergeWithAABB(aabb);
+        }
+        binsNbNodes[bin]++;
+    }
+
+    // Compute the area and the number of nodes on the right side of each split plane
+    decimal rightAreas[NB_SAH_BINS - 1];
+    uint32 rightNbNodes[NB_SAH_BINS - 1];
+    AABB rightAABB;
+    uint32 nbNodes = 0;
+    for (uint32 i=NB_SAH_BINS - 1; i > 0; i--) {
+        if (binsNbNodes[i] > 0) {
+            if (nbNodes == 0) {
+                rightAABB = binsAABB[i];
+            }
+            else {
+                rightAABB.mergeWithAABB(binsAABB[i]);
+            }
+            nbNodes += binsNbNodes[i];
+        }
+        rightAreas[i - 1] = nbNodes > 0 ? rightAABB.getSurfaceArea() : decimal(0.0);
+        rightNbNodes[i - 1] = nbNodes;
+    }
+
+    // Find the split plane with the smallest cost (the split plane i is after the bin i)
+    uint32 bestSplit = NB_SAH_BINS;
+    decimal bestCost = DECIMAL_LARGEST;
+    AABB leftAABB;
+    nbNodes = 0;
+    for (uint32 i=0; i < NB_SAH_BINS - 1; i++) {
+        if (binsNbNodes[i] > 0) {
+            if (nbNodes == 0) {
+                leftAABB = binsAABB[i];
+            }
+            else {
+                leftAABB.mergeWithAABB(binsAABB[i]);
+            }
+            nbNodes += binsNbNodes[i];
+        }
+        if (nbNodes == 0 || rightNbNodes[i] == 0) continue;
+
+        const decimal cost = leftAABB.getSurfaceArea() * decimal(nbNodes) + rightAreas[i] * decimal(rightNbNodes[i]);
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestSplit = i;
+        }
+    }
+
+    if (bestSplit == NB_SAH_BINS) return middleIndex;
+
+    // Move the nodes of the bins before the split plane at the beginning of the range
+    uint32 firstIndex = startIndex;
+    uint32 lastIndex = endIndex;
+    while (firstIndex < lastIndex) {
+
+        const AABB& aabb = mNodes[leafNodes[firstIndex]].aabb;
+        const uint32 bin = std::min(static_cast<uint32>((aabb.getCenter()[axis] - minCenter[axis]) * binsScale), NB_SAH_BINS - 1);
+        if (bin <= bestSplit) {
+            firstIndex++;
+        }
+        else {
+            lastIndex--;
+            std::swap(leafNodes[firstIndex], leafNodes[lastIndex]);
+        }
+    }
+
+    assert(firstIndex > startIndex && firstIndex < endIndex);
+
+    return firstIndex;
+}
+
+// Compute the SAH cost of the tree that would be built by the rebuild() method
+decimal DynamicAABBTree::computeRebuiltSAHCost() const {
+
+    if (mRootNodeID == TreeNode::NULL_TREE_NODE || mNodes[mRootNodeID].isLeaf()) return decimal(0.0);
+
+    Array<int32> leafNodes(mAllocator, static_cast<uint64>(mNbNodes / 2 + 1));
+    getLeafNodes(leafNodes);
+
+    // Build the sub-trees without creating their nodes
+    decimal rootArea = 0;
+    decimal internalNodesArea = 0;
+    Stack<SubTreeRange> stack(mAllocator, 64);
+    stack.push({0, static_cast<uint32>(leafNodes.size()), TreeNode::NULL_TREE_NODE, 0});
+    while (stack.size() > 0) {
+
+        const SubTreeRange range = stack.pop();
+        if (range.endIndex - range.startIndex < 2) continue;
+
+        AABB aabb;
+        const uint32 splitIndex = splitLeafNodes(leafNodes, range.startIndex, range.endIndex, aabb);
+        const decimal area = aabb.getSurfaceArea();
+        if (range.parentNodeID == TreeNode::NULL_TREE_NODE) {
+            rootArea = area;
+        }
+        internalNodesArea += area;
+
+        // The parent node of the sub-trees does not exist but must not be null
+        stack.push({range.startIndex, splitIndex, 0, 0});
+        stack.push({splitIndex, range.endIndex, 0, 1});
+    }
+
+    return rootArea > MACHINE_EPSILON ? internalNodesArea / rootArea : decimal(0.0);
+}
+
+// Rebuild the whole tree from its leaf nodes using the surface area heuristic (SAH)
+/// The incremental insertions and removals of the objects make the tree degrade over time.
+/// This method releases all the internal nodes and builds the tree again from the top with
+/// the binned SAH. The IDs and the fat AABBs of the leaf nodes (the broad-phase IDs of the
+/// colliders) do not change. The cost of this method is O(n log n) with the number n of
+/// objects in the tree.
+void DynamicAABBTree::rebuild() {
+
+    if (mRootNodeID == TreeNode::NULL_TREE_NODE || mNodes[mRootNodeID].isLeaf()) return;
+
+    RP3D_PROFILE("DynamicAABBTree::rebuild()", mProfiler);
+
+    if (mIsNodesMemoryExternal) {
+        copyExternalNodes();
+    }
+
+    Array<int32> leafNodes(mAllocator, static_cast<uint64>(mNbNodes / 2 + 1));
+    getLeafNodes(leafNodes);
+
+    // Release all the internal nodes (a rebuilt tree uses the same number of nodes)
+    for (int32 i=0; i < mNbAllocatedNodes; i++) {
+        if (mNodes[i].height > 0) {
+            releaseNode(i);
+        }
+    }
+
+    // Build the tree from the top. The internal nodes are created before their children.
+    Array<int32> internalNodes(mAllocator, leafNodes.size());
+    Stack<SubTreeRange> stack(mAllocator, 64);
+    stack.push({0, static_cast<uint32>(leafNodes.size()), TreeNode::NULL_TREE_NODE, 0});
+    while (stack.size() > 0) {
+
+        const SubTreeRange range = stack.pop();
+
+        int32 nodeID;
+        if (range.endIndex - range.startIndex == 1) {
+            nodeID = leafNodes[range.startIndex];
+        }
+        else {
+
+            AABB aabb;
+            const uint32 splitIndex = splitLeafNodes(leafNodes, range.startIndex, range.endIndex, aabb);
+
+            nodeID = allocateNode();
+            mNodes[nodeID].aabb = aabb;
+            mNodes[nodeID].height = 1;
+            internalNodes.add(nodeID);
+
+            stack.push({range.startIndex, splitIndex, nodeID, 0});
+            stack.push({splitIndex, range.endIndex, nodeID, 1});
+        }
+
+        // Link the node with its parent
+        mNodes[nodeID].parentID = range.parentNodeID;
+        if (range.parentNodeID == TreeNode::NULL_TREE_NODE) {
+            mRootNodeID = nodeID;
+        }
+        else {
+            mNodes[range.parentNodeID].children[range.childIndex] = nodeID;
+        }
+    }
+
+    // Compute the heights of the internal nodes from the bottom
+    for (uint64 i=internalNodes.size(); i > 0; i--) {
+
+        TreeNode& node = mNodes[internalNodes[i - 1]];
+        node.height = static_cast<int16>(1 + std::max(mNodes[node.children[0]].height, mNodes[node.children[1]].height));
+    }
+
+    assert(mNbNodes == 2 * static_cast<int32>(leafNodes.size()) - 1);
+}
+
+// Initialize the tree with nodes stored in an external memory buffer
+/// The nodes are not copied. The buffer must contain "nbNodes" contiguous nodes that are all
+/// part of the tree (no free nodes) and must remain valid during the lifetime of the tree.
+/// If the tree is modified later, the nodes are first copied into memory owned by the tree.
+/**
+ * @param nodes Pointer to the first node of the external buffer
+ * @param nbNodes Number of nodes in the external buffer
+ * @param rootNodeID ID of the root node of the tree
+ */
+void DynamicAABBTree::initWithExternalNodes(const TreeNode* nodes, int32 nbNodes, int32 rootNodeID) {
+
+    assert(nbNodes > 0);
+    assert(rootNodeID >= 0 && rootNodeID < nbNodes);
+
+    // Release the current nodes
+    if (!mIsNodesMemoryExternal) {
+        mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
+    }
+
+    // The external nodes are never written while the memory is not owned by the tree
+    mNodes = const_cast<TreeNode*>(nodes);
+    mNbNodes = nbNodes;
+    if (mNbNodes > mPeakNbNodes) {
+        mPeakNbNodes = mNbNodes;
+    }
+    mNbAllocatedNodes = nbNodes;
+    mRootNodeID = rootNodeID;
+    mFreeNodeID = TreeNode::NULL_TREE_NODE;
+    mIsNodesMemoryExternal = true;
+}
+
+// Copy the external nodes into memory owned by the tree before a modification
+void DynamicAABBTree::copyExternalNodes() {
+
+    assert(mIsNodesMemoryExternal);
+
+    const TreeNode* externalNodes = mNodes;
+    mNodes = static_cast<TreeNode*>(mAllocator.allocate(static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode)));
+    assert(mNodes);
+
+    std::uninitialized_copy(externalNodes, externalNodes + mNbAllocatedNodes, mNodes);
+
+    mIsNodesMemoryExternal = false;
+}
+
 // Allocate and return a new node in the tree
 int32 DynamicAABBTree::allocateNode() {
 
@@ -127,6 +593,10 @@ int32 DynamicAABBTree::allocateNode() {
     mNodes[freeNodeID].height = 0;
     mNbNodes++;
 
+    if (mNbNodes > mPeakNbNodes) {
+        mPeakNbNodes = mNbNodes;
+    }
+
     return freeNodeID;
 }
 
@@ -145,6 +615,10 @@ void DynamicAABBTree::releaseNode(int nodeID) {
 // Internally add an object into the tree
 int32 DynamicAABBTree::addObjectInternal(const AABB& aabb) {
 
+    if (mIsNodesMemoryExternal) {
+        copyExternalNodes();
+    }
+
     // Get the next available node (or allocate new ones if necessary)
     int32 nodeID = allocateNode();
 
@@ -172,6 +646,10 @@ void DynamicAABBTree::removeObject(int32 nodeID) {
     assert(nodeID >= 0 && nodeID < mNbAllocatedNodes);
     assert(mNodes[nodeID].isLeaf());
 
+    if (mIsNodesMemoryExternal) {
+        copyExternalNodes();
+    }
+
     // Remove the node from the tree
     removeLeafNode(nodeID);
     releaseNode(nodeID);
@@ -192,11 +670,20 @@ bool DynamicAABBTree::updateObject(int32 nodeID, const AABB& newAABB, bool force
     assert(mNodes[nodeID].isLeaf());
     assert(mNodes[nodeID].height >= 0);
 
+    mNbObjectUpdates++;
+
     // If the new AABB is still inside the fat AABB of the node
     if (!forceReinsert && mNodes[nodeID].aabb.contains(newAABB)) {
+        mNbFatAABBHits++;
         return false;
     }
 
+    mNbReinsertions++;
+
+    if (mIsNodesMemoryExternal) {
+        copyExternalNodes();
+    }
+
     // If the new AABB is outside the fat AABB, we remove the corresponding node
     removeLeafNode(nodeID);
 
@@ -71,11 +71,6 @@ bool CapsuleVsConvexPolyhedronAlgorithm::testCollision(NarrowPhaseInfoBatch& nar
         lastFrameCollisionInfo->wasUsingGJK = true;
         lastFrameCollisionInfo->wasUsingSAT = false;
 
-        assert(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1->getType() == CollisionShapeType::CONVEX_POLYHEDRON ||
-               narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2->getType() == CollisionShapeType::CONVEX_POLYHEDRON);
-        assert(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1->getType() == CollisionShapeType::CAPSULE ||
-               narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2->getType() == CollisionShapeType::CAPSULE);
-
         // If we have found a contact point inside the margins (shallow penetration)
         if (gjkResults[batchIndex] == GJKAlgorithm::GJKResult::COLLIDE_IN_MARGIN) {
 
@@ -88,15 +83,24 @@ bool CapsuleVsConvexPolyhedronAlgorithm::testCollision(NarrowPhaseInfoBatch& nar
                 // capsule inner segment and parallel to the contact point normal, we would like to create
                 // two contact points instead of a single one (as in the deep contact case with SAT algorithm)
 
-                // Get the contact point created by GJK
+                // Get the contact point created by GJK (copied because the contact points of the batch
+                // can be reallocated when new contact points are added)
                 assert(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].nbContactPoints > 0);
-                ContactPointInfo& contactPoint = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].contactPoints[0];
+                const ContactPointInfo contactPoint = narrowPhaseInfoBatch.getContactPoint(batchIndex, 0);
+
+                // Get the convex shapes of the test
+                NarrowPhaseConvexShapes shapes(narrowPhaseInfoBatch, batchIndex);
+
+                bool isCapsuleShape1 = shapes.shape1->getType() == CollisionShapeType::CAPSULE;
 
-                bool isCapsuleShape1 = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1->getType() == CollisionShapeType::CAPSULE;
+                assert(shapes.shape1->getType() == CollisionShapeType::CONVEX_POLYHEDRON ||
+                       shapes.shape2->getType() == CollisionShapeType::CONVEX_POLYHEDRON);
+                assert(shapes.shape1->getType() == CollisionShapeType::CAPSULE ||
+                       shapes.shape2->getType() == CollisionShapeType::CAPSULE);
 
                 // Get the collision shapes
-                const CapsuleShape* capsuleShape = static_cast<const CapsuleShape*>(isCapsuleShape1 ? narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1 : narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2);
-                const ConvexPolyhedronShape* polyhedron = static_cast<const ConvexPolyhedronShape*>(isCapsuleShape1 ? narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2 : narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1);
+                const CapsuleShape* capsuleShape = static_cast<const CapsuleShape*>(isCapsuleShape1 ? shapes.shape1 : shapes.shape2);
+                const ConvexPolyhedronShape* polyhedron = static_cast<const ConvexPolyhedronShape*>(isCapsuleShape1 ? shapes.shape2 : shapes.shape1);
 
                 // For each face of the polyhedron
                 for (uint32 f = 0; f < polyhedron->getNbFaces(); f++) {
@@ -143,7 +147,7 @@ bool CapsuleVsConvexPolyhedronAlgorithm::testCollision(NarrowPhaseInfoBatch& nar
                         }
 
                         // Compute and create two contact points
-                        bool contactsFound = satAlgorithm.computeCapsulePolyhedronFaceContactPoints(f, capsuleShape->getRadius(), polyhedron, contactPoint.penetrationDepth,
+                        bool contactsFound = satAlgorithm.computeCapsulePolyhedronFaceContactPoints(f, capsuleShape, polyhedron, contactPoint.penetrationDepth,
                                                                   polyhedronToCapsuleTransform, faceNormalWorld, separatingAxisCapsuleSpace,
                                                                   capsuleSegAPolyhedronSpace, capsuleSegBPolyhedronSpace,
                                                                   narrowPhaseInfoBatch, batchIndex, isCapsuleShape1);
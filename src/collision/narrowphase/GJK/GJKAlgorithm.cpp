@@ -64,11 +64,10 @@ void GJKAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uin
         decimal prevDistSquare;
         bool contactFound = false;
 
-        assert(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1->isConvex());
-        assert(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2->isConvex());
-
-        const ConvexShape* shape1 = static_cast<const ConvexShape*>(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1);
-        const ConvexShape* shape2 = static_cast<const ConvexShape*>(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2);
+        // Get the convex shapes of the test
+        NarrowPhaseConvexShapes shapes(narrowPhaseInfoBatch, batchIndex);
+        const ConvexShape* shape1 = shapes.shape1;
+        const ConvexShape* shape2 = shapes.shape2;
 
         // Get the local-space to world-space transforms
         const Transform& transform1 = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].shape1ToWorldTransform;
@@ -26,7 +26,6 @@
 // Libraries
 #include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
 #include <reactphysics3d/collision/ContactPointInfo.h>
-#include <reactphysics3d/collision/shapes/TriangleShape.h>
 #include <reactphysics3d/engine/OverlappingPairs.h>
 #include <iostream>
 
@@ -34,7 +33,8 @@ using namespace reactphysics3d;
 
 // Constructor
 NarrowPhaseInfoBatch::NarrowPhaseInfoBatch(OverlappingPairs& overlappingPairs, MemoryAllocator& allocator)
-                     : mMemoryAllocator(allocator), mOverlappingPairs(overlappingPairs), narrowPhaseInfos(allocator){
+                     : mMemoryAllocator(allocator), mOverlappingPairs(overlappingPairs), narrowPhaseInfos(allocator),
+                       contactPoints(allocator) {
 
 }
 
@@ -47,29 +47,21 @@ NarrowPhaseInfoBatch::~NarrowPhaseInfoBatch() {
 void NarrowPhaseInfoBatch::reserveMemory() {
 
     narrowPhaseInfos.reserve(mCachedCapacity);
+    contactPoints.reserve(mCachedContactPointsCapacity);
 }
 
 // Clear all the objects in the batch
 void NarrowPhaseInfoBatch::clear() {
 
+#ifndef NDEBUG
     const uint32 nbNarrowPhaseInfos = static_cast<uint32>(narrowPhaseInfos.size());
     for (uint32 i=0; i < nbNarrowPhaseInfos; i++) {
-
         assert(narrowPhaseInfos[i].nbContactPoints == 0);
-
-        // TODO OPTI : Better manage this
-
-        // Release the memory of the TriangleShape (this memory was allocated in the
-        // MiddlePhaseTriangleCallback::testTriangle() method)
-        if (narrowPhaseInfos[i].collisionShape1->getName() == CollisionShapeName::TRIANGLE) {
-            narrowPhaseInfos[i].collisionShape1->~CollisionShape();
-            narrowPhaseInfos[i].collisionShapeAllocator->release(narrowPhaseInfos[i].collisionShape1, sizeof(TriangleShape));
-        }
-        if (narrowPhaseInfos[i].collisionShape2->getName() == CollisionShapeName::TRIANGLE) {
-            narrowPhaseInfos[i].collisionShape2->~CollisionShape();
-            narrowPhaseInfos[i].collisionShapeAllocator->release(narrowPhaseInfos[i].collisionShape2, sizeof(TriangleShape));
-        }
     }
+#endif
+
+    // Note that the convex vs concave tests only store a reference to their triangle. The
+    // triangle shapes are built and destroyed by the narrow-phase algorithms
 
     // Note that we clear the following containers and we release their allocated memory. Therefore,
     // if the memory allocator is a single frame allocator, the memory is deallocated and will be
@@ -77,6 +69,8 @@ void NarrowPhaseInfoBatch::clear() {
     // location of the allocated memory of a single frame allocator might change between two frames)
 
     mCachedCapacity = static_cast<uint32>(narrowPhaseInfos.capacity());
+    mCachedContactPointsCapacity = static_cast<uint32>(contactPoints.capacity());
 
     narrowPhaseInfos.clear(true);
+    contactPoints.clear(true);
 }
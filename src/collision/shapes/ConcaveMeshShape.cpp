@@ -35,41 +35,27 @@ using namespace reactphysics3d;
 
 // Constructor
 ConcaveMeshShape::ConcaveMeshShape(TriangleMesh* triangleMesh, MemoryAllocator& allocator, HalfEdgeStructure& triangleHalfEdgeStructure, const Vector3& scaling)
-                 : ConcaveShape(CollisionShapeName::TRIANGLE_MESH, allocator, scaling), mDynamicAABBTree(allocator), mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
+                 : ConcaveShape(CollisionShapeName::TRIANGLE_MESH, allocator, triangleHalfEdgeStructure, scaling), mDynamicAABBTree(allocator) {
 
     mTriangleMesh = triangleMesh;
     mRaycastTestType = TriangleRaycastSide::FRONT;
 
-    // Insert all the triangles into the dynamic AABB tree
-    initBVHTree();
+    // If the BVH of the mesh has been cooked, we use it in place
+    if (mTriangleMesh->hasCookedBVH()) {
+        mDynamicAABBTree.initWithExternalNodes(mTriangleMesh->mCookedBVHNodes, mTriangleMesh->mCookedBVHNbNodes,
+                                               mTriangleMesh->mCookedBVHRootNodeID);
+    }
+    else {
+
+        // Insert all the triangles into the dynamic AABB tree
+        initBVHTree();
+    }
 }
 
 // Insert all the triangles into the dynamic AABB tree
 void ConcaveMeshShape::initBVHTree() {
 
-    // TODO : Try to randomly add the triangles into the tree to obtain a better tree
-
-    // For each sub-part of the mesh
-    for (uint32 subPart=0; subPart<mTriangleMesh->getNbSubparts(); subPart++) {
-
-        // Get the triangle vertex array of the current sub-part
-        TriangleVertexArray* triangleVertexArray = mTriangleMesh->getSubpart(subPart);
-
-        // For each triangle of the concave mesh
-        for (uint32 triangleIndex=0; triangleIndex<triangleVertexArray->getNbTriangles(); triangleIndex++) {
-
-            Vector3 trianglePoints[3];
-
-            // Get the triangle vertices
-            triangleVertexArray->getTriangleVertices(triangleIndex, trianglePoints);
-
-            // Create the AABB for the triangle
-            AABB aabb = AABB::createAABBForTriangle(trianglePoints);
-
-            // Add the AABB with the index of the triangle into the dynamic AABB tree
-            mDynamicAABBTree.addObject(aabb, subPart, triangleIndex);
-        }
-    }
+    mTriangleMesh->insertTrianglesIntoTree(mDynamicAABBTree);
 }
 
 // Return the three vertices coordinates (in the array outTriangleVertices) of a triangle
@@ -167,6 +153,42 @@ void ConcaveMeshShape::computeOverlappingTriangles(const AABB& localAABB, Array<
     }
 }
 
+// Compute the references to the triangles of the mesh that are overlapping with the AABB in parameter
+/// Contrary to computeOverlappingTriangles(), the vertices of the triangles are not gathered.
+/// They can be read later with getTriangleVerticesAndNormals().
+void ConcaveMeshShape::computeOverlappingTriangleReferences(const AABB& localAABB, Array<TriangleReference>& outTriangles,
+                                                            MemoryAllocator& allocator) const {
+
+    RP3D_PROFILE("ConcaveMeshShape::computeOverlappingTriangleReferences()", mProfiler);
+
+    // Scale the input AABB with the inverse scale of the concave mesh (because
+    // we store the vertices without scale inside the dynamic AABB tree
+    AABB aabb(localAABB);
+    aabb.applyScale(Vector3(decimal(1.0) / mScale.x, decimal(1.0) / mScale.y, decimal(1.0) / mScale.z));
+
+    // Compute the nodes of the internal AABB tree that are overlapping with the AABB
+    Array<int> overlappingNodes(allocator, 64);
+    mDynamicAABBTree.reportAllShapesOverlappingWithAABB(aabb, overlappingNodes);
+
+    // For each overlapping node
+    const uint32 nbOverlappingNodes = static_cast<uint32>(overlappingNodes.size());
+    for (uint32 i=0; i < nbOverlappingNodes; i++) {
+
+        // Get the node data (triangle index and mesh subpart index)
+        int32* data = mDynamicAABBTree.getNodeDataInt(overlappingNodes[i]);
+
+        outTriangles.add(TriangleReference(data[0], data[1], computeTriangleShapeId(data[0], data[1])));
+    }
+}
+
+// Return the three vertices and the three vertices normals of a triangle of the mesh
+void ConcaveMeshShape::getTriangleVerticesAndNormals(const TriangleReference& triangle, Vector3* outTriangleVertices,
+                                                     Vector3* outVerticesNormals) const {
+
+    getTriangleVertices(triangle.part, triangle.triangleIndex, outTriangleVertices);
+    getTriangleVerticesNormals(triangle.part, triangle.triangleIndex, outVerticesNormals);
+}
+
 // Raycast method with feedback information
 /// Note that only the first triangle hit by the ray in the mesh will be returned, even if
 /// the ray hits many triangles.
@@ -30,12 +30,40 @@
 using namespace reactphysics3d;
 
 // Constructor
-ConcaveShape::ConcaveShape(CollisionShapeName name, MemoryAllocator& allocator, const Vector3& scaling)
+ConcaveShape::ConcaveShape(CollisionShapeName name, MemoryAllocator& allocator, HalfEdgeStructure& triangleHalfEdgeStructure,
+                           const Vector3& scaling)
              : CollisionShape(name, CollisionShapeType::CONCAVE_SHAPE, allocator), mRaycastTestType(TriangleRaycastSide::FRONT),
-               mScale(scaling) {
+               mScale(scaling), mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
 
 }
 
+// Construct the triangle shape of a triangle of the shape in a given memory location
+/// This is used by the narrow-phase algorithms to build a triangle shape on the stack from a
+/// triangle reference of the middle-phase. The caller must destroy the returned triangle shape.
+/**
+ * @param memory Memory location (with the size and alignment of a TriangleShape) of the triangle shape
+ * @param triangle Reference to the triangle of the concave shape
+ * @param allocator Memory allocator given to the triangle shape
+ * @return A pointer to the constructed triangle shape
+ */
+TriangleShape* ConcaveShape::constructTriangleShape(void* memory, const TriangleReference& triangle, MemoryAllocator& allocator) const {
+
+    Vector3 triangleVertices[3];
+    Vector3 verticesNormals[3];
+    getTriangleVerticesAndNormals(triangle, triangleVertices, verticesNormals);
+
+    TriangleShape* triangleShape = new (memory) TriangleShape(triangleVertices, verticesNormals, triangle.shapeId,
+                                                              mTriangleHalfEdgeStructure, allocator);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+    triangleShape->setProfiler(mProfiler);
+
+#endif
+
+    return triangleShape;
+}
+
 // Compute and return the volume of the collision shape
 /// Note that we approximate the volume of a concave shape with the volume of its AABB
 decimal ConcaveShape::getVolume() const {
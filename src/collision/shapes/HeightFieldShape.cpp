@@ -46,10 +46,10 @@ HeightFieldShape::HeightFieldShape(int nbGridColumns, int nbGridRows, decimal mi
                                    const void* heightFieldData, HeightDataType dataType, MemoryAllocator& allocator,
                                    HalfEdgeStructure& triangleHalfEdgeStructure, int upAxis,
                                    decimal integerHeightScale, const Vector3& scaling)
-                 : ConcaveShape(CollisionShapeName::HEIGHTFIELD, allocator, scaling), mNbColumns(nbGridColumns), mNbRows(nbGridRows),
+                 : ConcaveShape(CollisionShapeName::HEIGHTFIELD, allocator, triangleHalfEdgeStructure, scaling), mNbColumns(nbGridColumns), mNbRows(nbGridRows),
                    mWidth(static_cast<decimal>(nbGridColumns - 1)), mLength(static_cast<decimal>(nbGridRows - 1)), mMinHeight(minHeight),
                    mMaxHeight(maxHeight), mUpAxis(upAxis), mIntegerHeightScale(integerHeightScale),
-                   mHeightDataType(dataType), mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
+                   mHeightDataType(dataType) {
 
     assert(nbGridColumns >= 2);
     assert(nbGridRows >= 2);
@@ -99,42 +99,12 @@ void HeightFieldShape::computeOverlappingTriangles(const AABB& localAABB, Array<
 
     RP3D_PROFILE("HeightFieldShape::computeOverlappingTriangles()", mProfiler);
 
-   // Compute the non-scaled AABB
-   Vector3 inverseScale(decimal(1.0) / mScale.x, decimal(1.0) / mScale.y, decimal(1.0) / mScale.z);
-   AABB aabb(localAABB.getMin() * inverseScale, localAABB.getMax() * inverseScale);
-
-   // Compute the integer grid coordinates inside the area we need to test for collision
-   int minGridCoords[3];
-   int maxGridCoords[3];
-   computeMinMaxGridCoordinates(minGridCoords, maxGridCoords, aabb);
-
-   // Compute the starting and ending coords of the sub-grid according to the up axis
+   // Compute the starting and ending coords of the sub-grid to test
    int iMin = 0;
    int iMax = 0;
    int jMin = 0;
    int jMax = 0;
-   switch(mUpAxis) {
-        case 0 : iMin = clamp(minGridCoords[1], 0, mNbColumns - 1);
-                 iMax = clamp(maxGridCoords[1], 0, mNbColumns - 1);
-                 jMin = clamp(minGridCoords[2], 0, mNbRows - 1);
-                 jMax = clamp(maxGridCoords[2], 0, mNbRows - 1);
-                 break;
-        case 1 : iMin = clamp(minGridCoords[0], 0, mNbColumns - 1);
-                 iMax = clamp(maxGridCoords[0], 0, mNbColumns - 1);
-                 jMin = clamp(minGridCoords[2], 0, mNbRows - 1);
-                 jMax = clamp(maxGridCoords[2], 0, mNbRows - 1);
-                 break;
-        case 2 : iMin = clamp(minGridCoords[0], 0, mNbColumns - 1);
-                 iMax = clamp(maxGridCoords[0], 0, mNbColumns - 1);
-                 jMin = clamp(minGridCoords[1], 0, mNbRows - 1);
-                 jMax = clamp(maxGridCoords[1], 0, mNbRows - 1);
-                 break;
-   }
-
-   assert(iMin >= 0 && iMin < mNbColumns);
-   assert(iMax >= 0 && iMax < mNbColumns);
-   assert(jMin >= 0 && jMin < mNbRows);
-   assert(jMax >= 0 && jMax < mNbRows);
+   computeOverlappingGridRange(localAABB, iMin, iMax, jMin, jMax);
 
    // For each sub-grid points (except the last ones one each dimension)
    for (int i = iMin; i < iMax; i++) {
@@ -193,6 +163,96 @@ void HeightFieldShape::computeOverlappingTriangles(const AABB& localAABB, Array<
    }
 }
 
+// Compute the references to the triangles of the height field that are overlapping with an AABB
+/// Contrary to computeOverlappingTriangles(), the vertices of the triangles are not computed.
+/// The part of a triangle is the index of its grid cell and the triangle index is 0 or 1 for
+/// the two triangles of the cell.
+void HeightFieldShape::computeOverlappingTriangleReferences(const AABB& localAABB, Array<TriangleReference>& outTriangles,
+                                                            MemoryAllocator& /*allocator*/) const {
+
+    RP3D_PROFILE("HeightFieldShape::computeOverlappingTriangleReferences()", mProfiler);
+
+    // Compute the starting and ending coords of the sub-grid to test
+    int iMin = 0;
+    int iMax = 0;
+    int jMin = 0;
+    int jMax = 0;
+    computeOverlappingGridRange(localAABB, iMin, iMax, jMin, jMax);
+
+    // For each cell of the sub-grid, we add its two triangles
+    for (int i = iMin; i < iMax; i++) {
+        for (int j = jMin; j < jMax; j++) {
+
+            const uint32 cellIndex = static_cast<uint32>(j * (mNbColumns - 1) + i);
+            outTriangles.add(TriangleReference(cellIndex, 0, computeTriangleShapeId(i, j, 0)));
+            outTriangles.add(TriangleReference(cellIndex, 1, computeTriangleShapeId(i, j, 1)));
+        }
+    }
+}
+
+// Return the three vertices and the three vertices normals of a triangle of the height field
+/// As in computeOverlappingTriangles(), the triangle face normal is used as vertices normals.
+void HeightFieldShape::getTriangleVerticesAndNormals(const TriangleReference& triangle, Vector3* outTriangleVertices,
+                                                     Vector3* outVerticesNormals) const {
+
+    const int i = static_cast<int>(triangle.part % static_cast<uint32>(mNbColumns - 1));
+    const int j = static_cast<int>(triangle.part / static_cast<uint32>(mNbColumns - 1));
+
+    if (triangle.triangleIndex == 0) {
+        outTriangleVertices[0] = getVertexAt(i, j);
+        outTriangleVertices[1] = getVertexAt(i, j + 1);
+        outTriangleVertices[2] = getVertexAt(i + 1, j);
+    }
+    else {
+        outTriangleVertices[0] = getVertexAt(i + 1, j);
+        outTriangleVertices[1] = getVertexAt(i, j + 1);
+        outTriangleVertices[2] = getVertexAt(i + 1, j + 1);
+    }
+
+    const Vector3 normal = (outTriangleVertices[1] - outTriangleVertices[0]).cross(outTriangleVertices[2] - outTriangleVertices[0]).getUnit();
+    outVerticesNormals[0] = normal;
+    outVerticesNormals[1] = normal;
+    outVerticesNormals[2] = normal;
+}
+
+// Compute the range of grid points of the height field whose cells overlap with an AABB
+/// The cells (i, j) with iMin <= i < iMax and jMin <= j < jMax overlap with the AABB.
+void HeightFieldShape::computeOverlappingGridRange(const AABB& localAABB, int& iMin, int& iMax, int& jMin, int& jMax) const {
+
+   // Compute the non-scaled AABB
+   Vector3 inverseScale(decimal(1.0) / mScale.x, decimal(1.0) / mScale.y, decimal(1.0) / mScale.z);
+   AABB aabb(localAABB.getMin() * inverseScale, localAABB.getMax() * inverseScale);
+
+   // Compute the integer grid coordinates inside the area we need to test for collision
+   int minGridCoords[3];
+   int maxGridCoords[3];
+   computeMinMaxGridCoordinates(minGridCoords, maxGridCoords, aabb);
+
+   // Compute the starting and ending coords of the sub-grid according to the up axis
+   switch(mUpAxis) {
+        case 0 : iMin = clamp(minGridCoords[1], 0, mNbColumns - 1);
+                 iMax = clamp(maxGridCoords[1], 0, mNbColumns - 1);
+                 jMin = clamp(minGridCoords[2], 0, mNbRows - 1);
+                 jMax = clamp(maxGridCoords[2], 0, mNbRows - 1);
+                 break;
+        case 1 : iMin = clamp(minGridCoords[0], 0, mNbColumns - 1);
+                 iMax = clamp(maxGridCoords[0], 0, mNbColumns - 1);
+                 jMin = clamp(minGridCoords[2], 0, mNbRows - 1);
+                 jMax = clamp(maxGridCoords[2], 0, mNbRows - 1);
+                 break;
+        case 2 : iMin = clamp(minGridCoords[0], 0, mNbColumns - 1);
+                 iMax = clamp(maxGridCoords[0], 0, mNbColumns - 1);
+                 jMin = clamp(minGridCoords[1], 0, mNbRows - 1);
+                 jMax = clamp(maxGridCoords[1], 0, mNbRows - 1);
+                 break;
+   }
+
+   assert(iMin >= 0 && iMin < mNbColumns);
+   assert(iMax >= 0 && iMax < mNbColumns);
+   assert(jMin >= 0 && jMin < mNbRows);
+   assert(jMax >= 0 && jMax < mNbRows);
+}
+
 // Compute the min/max grid coords corresponding to the intersection of the AABB of the height field and
 // the AABB to collide
 void HeightFieldShape::computeMinMaxGridCoordinates(int* minCoords, int* maxCoords, const AABB& aabbToCollide) const {
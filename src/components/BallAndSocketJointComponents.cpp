@@ -38,7 +38,7 @@ BallAndSocketJointComponents::BallAndSocketJointComponents(MemoryAllocator& allo
                                 sizeof(Vector3) + sizeof(Vector3) + sizeof(Vector3) +
                                 sizeof(Matrix3x3) + sizeof(Matrix3x3) + sizeof(Vector3) +
                                 sizeof(Matrix3x3) + sizeof(Vector3) + sizeof(bool) + sizeof(decimal) +
-                                sizeof(decimal) + sizeof(decimal) + sizeof(decimal) + sizeof(bool) + sizeof(Vector3)) {
+                                sizeof(decimal) + sizeof(decimal) + sizeof(decimal) + sizeof(bool) + sizeof(Vector3), 18) {
 
     // Allocate memory for the components data
     allocate(INIT_NB_ALLOCATED_COMPONENTS);
@@ -47,34 +47,34 @@ BallAndSocketJointComponents::BallAndSocketJointComponents(MemoryAllocator& allo
 // Allocate memory for a given number of components
 void BallAndSocketJointComponents::allocate(uint32 nbComponentsToAllocate) {
 
-    assert(nbComponentsToAllocate > mNbAllocatedComponents);
+    assert(nbComponentsToAllocate >= mNbComponents);
 
-    // Size for the data of a single component (in bytes)
-    const size_t totalSizeBytes = nbComponentsToAllocate * mComponentDataSize;
+    // Size (in bytes) of the buffer for the data of the components
+    const size_t totalSizeBytes = computeBufferSize(nbComponentsToAllocate);
 
     // Allocate memory
-    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes);
+    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes, COMPONENT_DATA_ALIGNMENT);
     assert(newBuffer != nullptr);
 
     // New pointers to components data
     Entity* newJointEntities = static_cast<Entity*>(newBuffer);
-    BallAndSocketJoint** newJoints = reinterpret_cast<BallAndSocketJoint**>(newJointEntities + nbComponentsToAllocate);
-    Vector3* newLocalAnchorPointBody1 = reinterpret_cast<Vector3*>(newJoints + nbComponentsToAllocate);
-    Vector3* newLocalAnchorPointBody2 = reinterpret_cast<Vector3*>(newLocalAnchorPointBody1 + nbComponentsToAllocate);
-    Vector3* newR1World = reinterpret_cast<Vector3*>(newLocalAnchorPointBody2 + nbComponentsToAllocate);
-    Vector3* newR2World = reinterpret_cast<Vector3*>(newR1World + nbComponentsToAllocate);
-    Matrix3x3* newI1 = reinterpret_cast<Matrix3x3*>(newR2World + nbComponentsToAllocate);
-    Matrix3x3* newI2 = reinterpret_cast<Matrix3x3*>(newI1 + nbComponentsToAllocate);
-    Vector3* newBiasVector = reinterpret_cast<Vector3*>(newI2 + nbComponentsToAllocate);
-    Matrix3x3* newInverseMassMatrix = reinterpret_cast<Matrix3x3*>(newBiasVector + nbComponentsToAllocate);
-    Vector3* newImpulse = reinterpret_cast<Vector3*>(newInverseMassMatrix + nbComponentsToAllocate);
-    bool* newIsConeLimitEnabled = reinterpret_cast<bool*>(newImpulse + nbComponentsToAllocate);
-    decimal* newConeLimitImpulse = reinterpret_cast<decimal*>(newIsConeLimitEnabled + nbComponentsToAllocate);
-    decimal* newConeLimitHalfAngle = reinterpret_cast<decimal*>(newConeLimitImpulse + nbComponentsToAllocate);
-    decimal* newInverseMassMatrixConeLimit = reinterpret_cast<decimal*>(newConeLimitHalfAngle + nbComponentsToAllocate);
-    decimal* newBConeLimit = reinterpret_cast<decimal*>(newInverseMassMatrixConeLimit + nbComponentsToAllocate);
-    bool* newIsConeLimitViolated = reinterpret_cast<bool*>(newBConeLimit + nbComponentsToAllocate);
-    Vector3* newConeLimitACrossB = reinterpret_cast<Vector3*>(newIsConeLimitViolated + nbComponentsToAllocate);
+    BallAndSocketJoint** newJoints = alignComponentData<BallAndSocketJoint*>(newJointEntities + nbComponentsToAllocate);
+    Vector3* newLocalAnchorPointBody1 = alignComponentData<Vector3>(newJoints + nbComponentsToAllocate);
+    Vector3* newLocalAnchorPointBody2 = alignComponentData<Vector3>(newLocalAnchorPointBody1 + nbComponentsToAllocate);
+    Vector3* newR1World = alignComponentData<Vector3>(newLocalAnchorPointBody2 + nbComponentsToAllocate);
+    Vector3* newR2World = alignComponentData<Vector3>(newR1World + nbComponentsToAllocate);
+    Matrix3x3* newI1 = alignComponentData<Matrix3x3>(newR2World + nbComponentsToAllocate);
+    Matrix3x3* newI2 = alignComponentData<Matrix3x3>(newI1 + nbComponentsToAllocate);
+    Vector3* newBiasVector = alignComponentData<Vector3>(newI2 + nbComponentsToAllocate);
+    Matrix3x3* newInverseMassMatrix = alignComponentData<Matrix3x3>(newBiasVector + nbComponentsToAllocate);
+    Vector3* newImpulse = alignComponentData<Vector3>(newInverseMassMatrix + nbComponentsToAllocate);
+    bool* newIsConeLimitEnabled = alignComponentData<bool>(newImpulse + nbComponentsToAllocate);
+    decimal* newConeLimitImpulse = alignComponentData<decimal>(newIsConeLimitEnabled + nbComponentsToAllocate);
+    decimal* newConeLimitHalfAngle = alignComponentData<decimal>(newConeLimitImpulse + nbComponentsToAllocate);
+    decimal* newInverseMassMatrixConeLimit = alignComponentData<decimal>(newConeLimitHalfAngle + nbComponentsToAllocate);
+    decimal* newBConeLimit = alignComponentData<decimal>(newInverseMassMatrixConeLimit + nbComponentsToAllocate);
+    bool* newIsConeLimitViolated = alignComponentData<bool>(newBConeLimit + nbComponentsToAllocate);
+    Vector3* newConeLimitACrossB = alignComponentData<Vector3>(newIsConeLimitViolated + nbComponentsToAllocate);
 
     // If there was already components before
     if (mNbComponents > 0) {
@@ -98,9 +98,11 @@ void BallAndSocketJointComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy(newBConeLimit, mBConeLimit, mNbComponents * sizeof(decimal));
         memcpy(newIsConeLimitViolated, mIsConeLimitViolated, mNbComponents * sizeof(bool));
         memcpy(newConeLimitACrossB, mConeLimitACrossB, mNbComponents * sizeof(Vector3));
+    }
 
-        // Deallocate previous memory
-        mMemoryAllocator.release(mBuffer, mNbAllocatedComponents * mComponentDataSize);
+    // Deallocate previous memory
+    if (mNbAllocatedComponents > 0) {
+        mMemoryAllocator.release(mBuffer, computeBufferSize(mNbAllocatedComponents), COMPONENT_DATA_ALIGNMENT);
     }
 
     mBuffer = newBuffer;
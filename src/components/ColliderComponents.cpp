@@ -38,7 +38,7 @@ ColliderComponents::ColliderComponents(MemoryAllocator& allocator)
                     :Components(allocator, sizeof(Entity) + sizeof(Entity) + sizeof(Collider*) + sizeof(int32) +
                 sizeof(Transform) + sizeof(CollisionShape*) + sizeof(unsigned short) +
                 sizeof(unsigned short) + sizeof(Transform) + sizeof(Array<uint64>) + sizeof(bool) +
-                sizeof(bool) + sizeof(Material)) {
+                sizeof(bool) + sizeof(Material), 13) {
 
     // Allocate memory for the components data
     allocate(INIT_NB_ALLOCATED_COMPONENTS);
@@ -47,29 +47,29 @@ ColliderComponents::ColliderComponents(MemoryAllocator& allocator)
 // Allocate memory for a given number of components
 void ColliderComponents::allocate(uint32 nbComponentsToAllocate) {
 
-    assert(nbComponentsToAllocate > mNbAllocatedComponents);
+    assert(nbComponentsToAllocate >= mNbComponents);
 
-    // Size for the data of a single component (in bytes)
-    const size_t totalSizeBytes = nbComponentsToAllocate * mComponentDataSize;
+    // Size (in bytes) of the buffer for the data of the components
+    const size_t totalSizeBytes = computeBufferSize(nbComponentsToAllocate);
 
     // Allocate memory
-    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes);
+    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes, COMPONENT_DATA_ALIGNMENT);
     assert(newBuffer != nullptr);
 
     // New pointers to components data
     Entity* newCollidersEntities = static_cast<Entity*>(newBuffer);
-    Entity* newBodiesEntities = reinterpret_cast<Entity*>(newCollidersEntities + nbComponentsToAllocate);
-    Collider** newColliders = reinterpret_cast<Collider**>(newBodiesEntities + nbComponentsToAllocate);
-    int32* newBroadPhaseIds = reinterpret_cast<int32*>(newColliders + nbComponentsToAllocate);
-    Transform* newLocalToBodyTransforms = reinterpret_cast<Transform*>(newBroadPhaseIds + nbComponentsToAllocate);
-    CollisionShape** newCollisionShapes = reinterpret_cast<CollisionShape**>(newLocalToBodyTransforms + nbComponentsToAllocate);
-    unsigned short* newCollisionCategoryBits = reinterpret_cast<unsigned short*>(newCollisionShapes + nbComponentsToAllocate);
-    unsigned short* newCollideWithMaskBits = reinterpret_cast<unsigned short*>(newCollisionCategoryBits + nbComponentsToAllocate);
-    Transform* newLocalToWorldTransforms = reinterpret_cast<Transform*>(newCollideWithMaskBits + nbComponentsToAllocate);
-    Array<uint64>* newOverlappingPairs = reinterpret_cast<Array<uint64>*>(newLocalToWorldTransforms + nbComponentsToAllocate);
-    bool* hasCollisionShapeChangedSize = reinterpret_cast<bool*>(newOverlappingPairs + nbComponentsToAllocate);
-    bool* isTrigger = reinterpret_cast<bool*>(hasCollisionShapeChangedSize + nbComponentsToAllocate);
-    Material* materials = reinterpret_cast<Material*>(isTrigger + nbComponentsToAllocate);
+    Entity* newBodiesEntities = alignComponentData<Entity>(newCollidersEntities + nbComponentsToAllocate);
+    Collider** newColliders = alignComponentData<Collider*>(newBodiesEntities + nbComponentsToAllocate);
+    int32* newBroadPhaseIds = alignComponentData<int32>(newColliders + nbComponentsToAllocate);
+    Transform* newLocalToBodyTransforms = alignComponentData<Transform>(newBroadPhaseIds + nbComponentsToAllocate);
+    CollisionShape** newCollisionShapes = alignComponentData<CollisionShape*>(newLocalToBodyTransforms + nbComponentsToAllocate);
+    unsigned short* newCollisionCategoryBits = alignComponentData<unsigned short>(newCollisionShapes + nbComponentsToAllocate);
+    unsigned short* newCollideWithMaskBits = alignComponentData<unsigned short>(newCollisionCategoryBits + nbComponentsToAllocate);
+    Transform* newLocalToWorldTransforms = alignComponentData<Transform>(newCollideWithMaskBits + nbComponentsToAllocate);
+    Array<uint64>* newOverlappingPairs = alignComponentData<Array<uint64>>(newLocalToWorldTransforms + nbComponentsToAllocate);
+    bool* hasCollisionShapeChangedSize = alignComponentData<bool>(newOverlappingPairs + nbComponentsToAllocate);
+    bool* isTrigger = alignComponentData<bool>(hasCollisionShapeChangedSize + nbComponentsToAllocate);
+    Material* materials = alignComponentData<Material>(isTrigger + nbComponentsToAllocate);
 
     // If there was already components before
     if (mNbComponents > 0) {
@@ -88,9 +88,11 @@ void ColliderComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy(hasCollisionShapeChangedSize, mHasCollisionShapeChangedSize, mNbComponents * sizeof(bool));
         memcpy(isTrigger, mIsTrigger, mNbComponents * sizeof(bool));
         memcpy(materials, mMaterials, mNbComponents * sizeof(Material));
+    }
 
-        // Deallocate previous memory
-        mMemoryAllocator.release(mBuffer, mNbAllocatedComponents * mComponentDataSize);
+    // Deallocate previous memory
+    if (mNbAllocatedComponents > 0) {
+        mMemoryAllocator.release(mBuffer, computeBufferSize(mNbAllocatedComponents), COMPONENT_DATA_ALIGNMENT);
     }
 
     mBuffer = newBuffer;
@@ -35,7 +35,7 @@ using namespace reactphysics3d;
 // Constructor
 CollisionBodyComponents::CollisionBodyComponents(MemoryAllocator& allocator)
                     :Components(allocator, sizeof(Entity) + sizeof(CollisionBody*) + sizeof(Array<Entity>) +
-                                sizeof(bool) + sizeof(void*)) {
+                                sizeof(bool) + sizeof(bool) + sizeof(void*), 6) {
 
     // Allocate memory for the components data
     allocate(INIT_NB_ALLOCATED_COMPONENTS);
@@ -44,21 +44,22 @@ CollisionBodyComponents::CollisionBodyComponents(MemoryAllocator& allocator)
 // Allocate memory for a given number of components
 void CollisionBodyComponents::allocate(uint32 nbComponentsToAllocate) {
 
-    assert(nbComponentsToAllocate > mNbAllocatedComponents);
+    assert(nbComponentsToAllocate >= mNbComponents);
 
-    // Size for the data of a single component (in bytes)
-    const size_t totalSizeBytes = nbComponentsToAllocate * mComponentDataSize;
+    // Size (in bytes) of the buffer for the data of the components
+    const size_t totalSizeBytes = computeBufferSize(nbComponentsToAllocate);
 
     // Allocate memory
-    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes);
+    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes, COMPONENT_DATA_ALIGNMENT);
     assert(newBuffer != nullptr);
 
     // New pointers to components data
     Entity* newBodiesEntities = static_cast<Entity*>(newBuffer);
-    CollisionBody** newBodies = reinterpret_cast<CollisionBody**>(newBodiesEntities + nbComponentsToAllocate);
-    Array<Entity>* newColliders = reinterpret_cast<Array<Entity>*>(newBodies + nbComponentsToAllocate);
-    bool* newIsActive = reinterpret_cast<bool*>(newColliders + nbComponentsToAllocate);
-    void** newUserData = reinterpret_cast<void**>(newIsActive + nbComponentsToAllocate);
+    CollisionBody** newBodies = alignComponentData<CollisionBody*>(newBodiesEntities + nbComponentsToAllocate);
+    Array<Entity>* newColliders = alignComponentData<Array<Entity>>(newBodies + nbComponentsToAllocate);
+    bool* newIsActive = alignComponentData<bool>(newColliders + nbComponentsToAllocate);
+    bool* newIsCompound = alignComponentData<bool>(newIsActive + nbComponentsToAllocate);
+    void** newUserData = alignComponentData<void*>(newIsCompound + nbComponentsToAllocate);
 
     // If there was already components before
     if (mNbComponents > 0) {
@@ -68,10 +69,13 @@ void CollisionBodyComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy(newBodies, mBodies, mNbComponents * sizeof(CollisionBody*));
         memcpy(newColliders, mColliders, mNbComponents * sizeof(Array<Entity>));
         memcpy(newIsActive, mIsActive, mNbComponents * sizeof(bool));
+        memcpy(newIsCompound, mIsCompound, mNbComponents * sizeof(bool));
         memcpy(newUserData, mUserData, mNbComponents * sizeof(void*));
+    }
 
-        // Deallocate previous memory
-        mMemoryAllocator.release(mBuffer, mNbAllocatedComponents * mComponentDataSize);
+    // Deallocate previous memory
+    if (mNbAllocatedComponents > 0) {
+        mMemoryAllocator.release(mBuffer, computeBufferSize(mNbAllocatedComponents), COMPONENT_DATA_ALIGNMENT);
     }
 
     mBuffer = newBuffer;
@@ -79,6 +83,7 @@ void CollisionBodyComponents::allocate(uint32 nbComponentsToAllocate) {
     mBodies = newBodies;
     mColliders = newColliders;
     mIsActive = newIsActive;
+    mIsCompound = newIsCompound;
     mUserData = newUserData;
     mNbAllocatedComponents = nbComponentsToAllocate;
 }
@@ -94,6 +99,7 @@ void CollisionBodyComponents::addComponent(Entity bodyEntity, bool isSleeping, c
     mBodies[index] = component.body;
     new (mColliders + index) Array<Entity>(mMemoryAllocator);
     mIsActive[index] = true;
+    mIsCompound[index] = false;
     mUserData[index] = nullptr;
 
     // Map the entity with the new component lookup index
@@ -116,6 +122,7 @@ void CollisionBodyComponents::moveComponentToIndex(uint32 srcIndex, uint32 destI
     mBodies[destIndex] = mBodies[srcIndex];
     new (mColliders + destIndex) Array<Entity>(mColliders[srcIndex]);
     mIsActive[destIndex] = mIsActive[srcIndex];
+    mIsCompound[destIndex] = mIsCompound[srcIndex];
     mUserData[destIndex] = mUserData[srcIndex];
 
     // Destroy the source component
@@ -137,6 +144,7 @@ void CollisionBodyComponents::swapComponents(uint32 index1, uint32 index2) {
     CollisionBody* body1 = mBodies[index1];
     Array<Entity> colliders1(mColliders[index1]);
     bool isActive1 = mIsActive[index1];
+    bool isCompound1 = mIsCompound[index1];
     void* userData1 = mUserData[index1];
 
     // Destroy component 1
@@ -149,6 +157,7 @@ void CollisionBodyComponents::swapComponents(uint32 index1, uint32 index2) {
     new (mColliders + index2) Array<Entity>(colliders1);
     mBodies[index2] = body1;
     mIsActive[index2] = isActive1;
+    mIsCompound[index2] = isCompound1;
     mUserData[index2] = userData1;
 
     // Update the entity to component index mapping
@@ -31,9 +31,9 @@
 using namespace reactphysics3d;
 
 // Constructor
-Components::Components(MemoryAllocator& allocator, size_t componentDataSize)
-    : mMemoryAllocator(allocator), mNbComponents(0), mComponentDataSize(componentDataSize),
-      mNbAllocatedComponents(0), mBuffer(nullptr), mMapEntityToComponentIndex(allocator),
+Components::Components(MemoryAllocator& allocator, size_t componentDataSize, uint32 nbComponentArrays)
+    : mMemoryAllocator(allocator), mNbComponents(0), mComponentDataSize(componentDataSize), mNbComponentArrays(nbComponentArrays),
+      mNbAllocatedComponents(0), mPeakNbComponents(0), mBuffer(nullptr), mMapEntityToComponentIndex(allocator),
       mDisabledStartIndex(0) {
 
 }
@@ -49,11 +49,11 @@ Components::~Components() {
             destroyComponent(i);
         }
 
-        // Size for the data of a single component (in bytes)
-        const size_t totalSizeBytes = mNbAllocatedComponents * mComponentDataSize;
+        // Size (in bytes) of the buffer for the data of the components
+        const size_t totalSizeBytes = computeBufferSize(mNbAllocatedComponents);
 
         // Release the allocated memory
-        mMemoryAllocator.release(mBuffer, totalSizeBytes);
+        mMemoryAllocator.release(mBuffer, totalSizeBytes, COMPONENT_DATA_ALIGNMENT);
     }
 }
 
@@ -65,6 +65,10 @@ uint32 Components::prepareAddComponent(bool isSleeping) {
         allocate(mNbAllocatedComponents * 2);
     }
 
+    if (mNbComponents + 1 > mPeakNbComponents) {
+        mPeakNbComponents = mNbComponents + 1;
+    }
+
     uint32 index;
 
     // If the component to add is part of a disabled entity or there are no disabled entity
@@ -91,6 +95,79 @@ uint32 Components::prepareAddComponent(bool isSleeping) {
     return index;
 }
 
+// Make sure there is enough allocated memory for a given number of components
+/**
+ * @param nbComponents The number of components that can be stored without any new allocation
+ */
+void Components::reserve(uint32 nbComponents) {
+
+    if (nbComponents > mNbAllocatedComponents) {
+        allocate(nbComponents);
+    }
+
+    mMapEntityToComponentIndex.reserve(nbComponents);
+}
+
+// Release the memory that is not used by the current components
+void Components::shrinkToFit() {
+
+    // We keep the initial number of allocated components
+    const uint32 nbComponentsToAllocate = mNbComponents > INIT_NB_ALLOCATED_COMPONENTS ? mNbComponents : INIT_NB_ALLOCATED_COMPONENTS;
+
+    if (nbComponentsToAllocate < mNbAllocatedComponents) {
+        allocate(nbComponentsToAllocate);
+    }
+
+    mMapEntityToComponentIndex.shrinkToFit();
+}
+
+// Reorder the components to follow the order of an array of entities
+/// The enabled and disabled components stay grouped together and are sorted separately.
+/// The entities without a component are ignored and the components whose entity is not in
+/// the array are moved after the sorted ones of the same group.
+/**
+ * @param entities Array with the entities in the order of their components after the call
+ */
+void Components::sortComponents(const Array<Entity>& entities) {
+
+    uint32 nextEnabledIndex = 0;
+    uint32 nextDisabledIndex = mDisabledStartIndex;
+
+    for (uint64 i=0; i < entities.size(); i++) {
+
+        uint32 index;
+        if (!hasComponentGetIndex(entities[i], index)) continue;
+
+        uint32& nextIndex = index < mDisabledStartIndex ? nextEnabledIndex : nextDisabledIndex;
+
+        // If the component has already been placed (entity present twice in the array)
+        if (index < nextIndex) continue;
+
+        if (index != nextIndex) {
+            swapComponents(index, nextIndex);
+        }
+
+        nextIndex++;
+    }
+}
+
+// Return the memory usage of the components
+/// The memory of the map from the entities to the components is included but not the
+/// memory that is allocated by the components themselves (arrays inside a component).
+MemoryUsage Components::getMemoryUsage() const {
+
+    // Size (in bytes) of a component with its item in the map from the entities to the components (with
+    // the index to the next entry of a Map or the control byte of an OpenAddressingMap)
+    const size_t componentWithMapItemSize = mComponentDataSize + sizeof(Pair<Entity, uint32>) + sizeof(uint64);
+
+    const size_t reservedMemory = (mNbAllocatedComponents > 0 ? computeBufferSize(mNbAllocatedComponents) : 0) +
+                                  mMapEntityToComponentIndex.getAllocatedMemorySize();
+    const size_t usedMemory = mNbComponents * mComponentDataSize + mMapEntityToComponentIndex.getUsedMemorySize();
+    const size_t peakUsedMemory = usedMemory + (mPeakNbComponents - mNbComponents) * componentWithMapItemSize;
+
+    return MemoryUsage(reservedMemory, usedMemory, peakUsedMemory);
+}
+
 // Destroy a component at a given index
 void Components::destroyComponent(uint32 index) {
 
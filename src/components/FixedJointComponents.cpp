@@ -38,7 +38,7 @@ FixedJointComponents::FixedJointComponents(MemoryAllocator& allocator)
                                 sizeof(Vector3) + sizeof(Vector3) + sizeof(Vector3) +
                                 sizeof(Matrix3x3) + sizeof(Matrix3x3) + sizeof(Vector3) +
                                 sizeof(Vector3) + sizeof(Matrix3x3) + sizeof(Matrix3x3) +
-                                sizeof(Vector3) + sizeof(Vector3) + sizeof(Quaternion)) {
+                                sizeof(Vector3) + sizeof(Vector3) + sizeof(Quaternion), 15) {
 
     // Allocate memory for the components data
     allocate(INIT_NB_ALLOCATED_COMPONENTS);
@@ -47,31 +47,31 @@ FixedJointComponents::FixedJointComponents(MemoryAllocator& allocator)
 // Allocate memory for a given number of components
 void FixedJointComponents::allocate(uint32 nbComponentsToAllocate) {
 
-    assert(nbComponentsToAllocate > mNbAllocatedComponents);
+    assert(nbComponentsToAllocate >= mNbComponents);
 
-    // Size for the data of a single component (in bytes)
-    const size_t totalSizeBytes = nbComponentsToAllocate * mComponentDataSize;
+    // Size (in bytes) of the buffer for the data of the components
+    const size_t totalSizeBytes = computeBufferSize(nbComponentsToAllocate);
 
     // Allocate memory
-    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes);
+    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes, COMPONENT_DATA_ALIGNMENT);
     assert(newBuffer != nullptr);
 
     // New pointers to components data
     Entity* newJointEntities = static_cast<Entity*>(newBuffer);
-    FixedJoint** newJoints = reinterpret_cast<FixedJoint**>(newJointEntities + nbComponentsToAllocate);
-    Vector3* newLocalAnchorPointBody1 = reinterpret_cast<Vector3*>(newJoints + nbComponentsToAllocate);
-    Vector3* newLocalAnchorPointBody2 = reinterpret_cast<Vector3*>(newLocalAnchorPointBody1 + nbComponentsToAllocate);
-    Vector3* newR1World = reinterpret_cast<Vector3*>(newLocalAnchorPointBody2 + nbComponentsToAllocate);
-    Vector3* newR2World = reinterpret_cast<Vector3*>(newR1World + nbComponentsToAllocate);
-    Matrix3x3* newI1 = reinterpret_cast<Matrix3x3*>(newR2World + nbComponentsToAllocate);
-    Matrix3x3* newI2 = reinterpret_cast<Matrix3x3*>(newI1 + nbComponentsToAllocate);
-    Vector3* newImpulseTranslation = reinterpret_cast<Vector3*>(newI2 + nbComponentsToAllocate);
-    Vector3* newImpulseRotation = reinterpret_cast<Vector3*>(newImpulseTranslation + nbComponentsToAllocate);
-    Matrix3x3* newInverseMassMatrixTranslation = reinterpret_cast<Matrix3x3*>(newImpulseRotation + nbComponentsToAllocate);
-    Matrix3x3* newInverseMassMatrixRotation = reinterpret_cast<Matrix3x3*>(newInverseMassMatrixTranslation + nbComponentsToAllocate);
-    Vector3* newBiasTranslation = reinterpret_cast<Vector3*>(newInverseMassMatrixRotation + nbComponentsToAllocate);
-    Vector3* newBiasRotation = reinterpret_cast<Vector3*>(newBiasTranslation + nbComponentsToAllocate);
-    Quaternion* newInitOrientationDifferenceInv = reinterpret_cast<Quaternion*>(newBiasRotation + nbComponentsToAllocate);
+    FixedJoint** newJoints = alignComponentData<FixedJoint*>(newJointEntities + nbComponentsToAllocate);
+    Vector3* newLocalAnchorPointBody1 = alignComponentData<Vector3>(newJoints + nbComponentsToAllocate);
+    Vector3* newLocalAnchorPointBody2 = alignComponentData<Vector3>(newLocalAnchorPointBody1 + nbComponentsToAllocate);
+    Vector3* newR1World = alignComponentData<Vector3>(newLocalAnchorPointBody2 + nbComponentsToAllocate);
+    Vector3* newR2World = alignComponentData<Vector3>(newR1World + nbComponentsToAllocate);
+    Matrix3x3* newI1 = alignComponentData<Matrix3x3>(newR2World + nbComponentsToAllocate);
+    Matrix3x3* newI2 = alignComponentData<Matrix3x3>(newI1 + nbComponentsToAllocate);
+    Vector3* newImpulseTranslation = alignComponentData<Vector3>(newI2 + nbComponentsToAllocate);
+    Vector3* newImpulseRotation = alignComponentData<Vector3>(newImpulseTranslation + nbComponentsToAllocate);
+    Matrix3x3* newInverseMassMatrixTranslation = alignComponentData<Matrix3x3>(newImpulseRotation + nbComponentsToAllocate);
+    Matrix3x3* newInverseMassMatrixRotation = alignComponentData<Matrix3x3>(newInverseMassMatrixTranslation + nbComponentsToAllocate);
+    Vector3* newBiasTranslation = alignComponentData<Vector3>(newInverseMassMatrixRotation + nbComponentsToAllocate);
+    Vector3* newBiasRotation = alignComponentData<Vector3>(newBiasTranslation + nbComponentsToAllocate);
+    Quaternion* newInitOrientationDifferenceInv = alignComponentData<Quaternion>(newBiasRotation + nbComponentsToAllocate);
 
     // If there was already components before
     if (mNbComponents > 0) {
@@ -92,9 +92,11 @@ void FixedJointComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy(newBiasTranslation, mBiasTranslation, mNbComponents * sizeof(Vector3));
         memcpy(newBiasRotation, mBiasRotation, mNbComponents * sizeof(Vector3));
         memcpy(newInitOrientationDifferenceInv, mInitOrientationDifferenceInv, mNbComponents * sizeof(Quaternion));
+    }
 
-        // Deallocate previous memory
-        mMemoryAllocator.release(mBuffer, mNbAllocatedComponents * mComponentDataSize);
+    // Deallocate previous memory
+    if (mNbAllocatedComponents > 0) {
+        mMemoryAllocator.release(mBuffer, computeBufferSize(mNbAllocatedComponents), COMPONENT_DATA_ALIGNMENT);
     }
 
     mBuffer = newBuffer;
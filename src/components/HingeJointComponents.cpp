@@ -43,7 +43,7 @@ HingeJointComponents::HingeJointComponents(MemoryAllocator& allocator)
                                 sizeof(Vector3) + sizeof(decimal) + sizeof(decimal) + sizeof(decimal) +
                                 sizeof(decimal) + sizeof(decimal) + sizeof(decimal) + sizeof(decimal) +
                                 sizeof(bool) + sizeof(bool) + sizeof(decimal) + sizeof(decimal) +
-                                sizeof(bool) + sizeof(bool) + sizeof(decimal) + sizeof(decimal)) {
+                                sizeof(bool) + sizeof(bool) + sizeof(decimal) + sizeof(decimal), 35) {
 
     // Allocate memory for the components data
     allocate(INIT_NB_ALLOCATED_COMPONENTS);
@@ -52,51 +52,51 @@ HingeJointComponents::HingeJointComponents(MemoryAllocator& allocator)
 // Allocate memory for a given number of components
 void HingeJointComponents::allocate(uint32 nbComponentsToAllocate) {
 
-    assert(nbComponentsToAllocate > mNbAllocatedComponents);
+    assert(nbComponentsToAllocate >= mNbComponents);
 
-    // Size for the data of a single component (in bytes)
-    const size_t totalSizeBytes = nbComponentsToAllocate * mComponentDataSize;
+    // Size (in bytes) of the buffer for the data of the components
+    const size_t totalSizeBytes = computeBufferSize(nbComponentsToAllocate);
 
     // Allocate memory
-    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes);
+    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes, COMPONENT_DATA_ALIGNMENT);
     assert(newBuffer != nullptr);
 
     // New pointers to components data
     Entity* newJointEntities = static_cast<Entity*>(newBuffer);
-    HingeJoint** newJoints = reinterpret_cast<HingeJoint**>(newJointEntities + nbComponentsToAllocate);
-    Vector3* newLocalAnchorPointBody1 = reinterpret_cast<Vector3*>(newJoints + nbComponentsToAllocate);
-    Vector3* newLocalAnchorPointBody2 = reinterpret_cast<Vector3*>(newLocalAnchorPointBody1 + nbComponentsToAllocate);
-    Vector3* newR1World = reinterpret_cast<Vector3*>(newLocalAnchorPointBody2 + nbComponentsToAllocate);
-    Vector3* newR2World = reinterpret_cast<Vector3*>(newR1World + nbComponentsToAllocate);
-    Matrix3x3* newI1 = reinterpret_cast<Matrix3x3*>(newR2World + nbComponentsToAllocate);
-    Matrix3x3* newI2 = reinterpret_cast<Matrix3x3*>(newI1 + nbComponentsToAllocate);
-    Vector3* newImpulseTranslation = reinterpret_cast<Vector3*>(newI2 + nbComponentsToAllocate);
-    Vector2* newImpulseRotation = reinterpret_cast<Vector2*>(newImpulseTranslation + nbComponentsToAllocate);
-    Matrix3x3* newInverseMassMatrixTranslation = reinterpret_cast<Matrix3x3*>(newImpulseRotation + nbComponentsToAllocate);
-    Matrix2x2* newInverseMassMatrixRotation = reinterpret_cast<Matrix2x2*>(newInverseMassMatrixTranslation + nbComponentsToAllocate);
-    Vector3* newBiasTranslation = reinterpret_cast<Vector3*>(newInverseMassMatrixRotation + nbComponentsToAllocate);
-    Vector2* newBiasRotation = reinterpret_cast<Vector2*>(newBiasTranslation + nbComponentsToAllocate);
-    Quaternion* newInitOrientationDifferenceInv = reinterpret_cast<Quaternion*>(newBiasRotation + nbComponentsToAllocate);
-    Vector3* newHingeLocalAxisBody1 = reinterpret_cast<Vector3*>(newInitOrientationDifferenceInv + nbComponentsToAllocate);
-    Vector3* newHingeLocalAxisBody2 = reinterpret_cast<Vector3*>(newHingeLocalAxisBody1 + nbComponentsToAllocate);
-    Vector3* newA1 = reinterpret_cast<Vector3*>(newHingeLocalAxisBody2 + nbComponentsToAllocate);
-    Vector3* newB2CrossA1 = reinterpret_cast<Vector3*>(newA1 + nbComponentsToAllocate);
-    Vector3* newC2CrossA1 = reinterpret_cast<Vector3*>(newB2CrossA1 + nbComponentsToAllocate);
-    decimal* newImpulseLowerLimit = reinterpret_cast<decimal*>(newC2CrossA1 + nbComponentsToAllocate);
-    decimal* newImpulseUpperLimit = reinterpret_cast<decimal*>(newImpulseLowerLimit + nbComponentsToAllocate);
-    decimal* newImpulseMotor = reinterpret_cast<decimal*>(newImpulseUpperLimit + nbComponentsToAllocate);
-    decimal* newInverseMassMatrixLimitMotor = reinterpret_cast<decimal*>(newImpulseMotor + nbComponentsToAllocate);
-    decimal* newInverseMassMatrixMotor = reinterpret_cast<decimal*>(newInverseMassMatrixLimitMotor + nbComponentsToAllocate);
-    decimal* newBLowerLimit = reinterpret_cast<decimal*>(newInverseMassMatrixMotor + nbComponentsToAllocate);
-    decimal* newBUpperLimit = reinterpret_cast<decimal*>(newBLowerLimit + nbComponentsToAllocate);
-    bool* newIsLimitEnabled = reinterpret_cast<bool*>(newBUpperLimit + nbComponentsToAllocate);
-    bool* newIsMotorEnabled = reinterpret_cast<bool*>(newIsLimitEnabled + nbComponentsToAllocate);
-    decimal* newLowerLimit = reinterpret_cast<decimal*>(newIsMotorEnabled + nbComponentsToAllocate);
-    decimal* newUpperLimit = reinterpret_cast<decimal*>(newLowerLimit + nbComponentsToAllocate);
-    bool* newIsLowerLimitViolated = reinterpret_cast<bool*>(newUpperLimit + nbComponentsToAllocate);
-    bool* newIsUpperLimitViolated = reinterpret_cast<bool*>(newIsLowerLimitViolated + nbComponentsToAllocate);
-    decimal* newMotorSpeed = reinterpret_cast<decimal*>(newIsUpperLimitViolated + nbComponentsToAllocate);
-    decimal* newMaxMotorTorque = reinterpret_cast<decimal*>(newMotorSpeed + nbComponentsToAllocate);
+    HingeJoint** newJoints = alignComponentData<HingeJoint*>(newJointEntities + nbComponentsToAllocate);
+    Vector3* newLocalAnchorPointBody1 = alignComponentData<Vector3>(newJoints + nbComponentsToAllocate);
+    Vector3* newLocalAnchorPointBody2 = alignComponentData<Vector3>(newLocalAnchorPointBody1 + nbComponentsToAllocate);
+    Vector3* newR1World = alignComponentData<Vector3>(newLocalAnchorPointBody2 + nbComponentsToAllocate);
+    Vector3* newR2World = alignComponentData<Vector3>(newR1World + nbComponentsToAllocate);
+    Matrix3x3* newI1 = alignComponentData<Matrix3x3>(newR2World + nbComponentsToAllocate);
+    Matrix3x3* newI2 = alignComponentData<Matrix3x3>(newI1 + nbComponentsToAllocate);
+    Vector3* newImpulseTranslation = alignComponentData<Vector3>(newI2 + nbComponentsToAllocate);
+    Vector2* newImpulseRotation = alignComponentData<Vector2>(newImpulseTranslation + nbComponentsToAllocate);
+    Matrix3x3* newInverseMassMatrixTranslation = alignComponentData<Matrix3x3>(newImpulseRotation + nbComponentsToAllocate);
+    Matrix2x2* newInverseMassMatrixRotation = alignComponentData<Matrix2x2>(newInverseMassMatrixTranslation + nbComponentsToAllocate);
+    Vector3* newBiasTranslation = alignComponentData<Vector3>(newInverseMassMatrixRotation + nbComponentsToAllocate);
+    Vector2* newBiasRotation = alignComponentData<Vector2>(newBiasTranslation + nbComponentsToAllocate);
+    Quaternion* newInitOrientationDifferenceInv = alignComponentData<Quaternion>(newBiasRotation + nbComponentsToAllocate);
+    Vector3* newHingeLocalAxisBody1 = alignComponentData<Vector3>(newInitOrientationDifferenceInv + nbComponentsToAllocate);
+    Vector3* newHingeLocalAxisBody2 = alignComponentData<Vector3>(newHingeLocalAxisBody1 + nbComponentsToAllocate);
+    Vector3* newA1 = alignComponentData<Vector3>(newHingeLocalAxisBody2 + nbComponentsToAllocate);
+    Vector3* newB2CrossA1 = alignComponentData<Vector3>(newA1 + nbComponentsToAllocate);
+    Vector3* newC2CrossA1 = alignComponentData<Vector3>(newB2CrossA1 + nbComponentsToAllocate);
+    decimal* newImpulseLowerLimit = alignComponentData<decimal>(newC2CrossA1 + nbComponentsToAllocate);
+    decimal* newImpulseUpperLimit = alignComponentData<decimal>(newImpulseLowerLimit + nbComponentsToAllocate);
+    decimal* newImpulseMotor = alignComponentData<decimal>(newImpulseUpperLimit + nbComponentsToAllocate);
+    decimal* newInverseMassMatrixLimitMotor = alignComponentData<decimal>(newImpulseMotor + nbComponentsToAllocate);
+    decimal* newInverseMassMatrixMotor = alignComponentData<decimal>(newInverseMassMatrixLimitMotor + nbComponentsToAllocate);
+    decimal* newBLowerLimit = alignComponentData<decimal>(newInverseMassMatrixMotor + nbComponentsToAllocate);
+    decimal* newBUpperLimit = alignComponentData<decimal>(newBLowerLimit + nbComponentsToAllocate);
+    bool* newIsLimitEnabled = alignComponentData<bool>(newBUpperLimit + nbComponentsToAllocate);
+    bool* newIsMotorEnabled = alignComponentData<bool>(newIsLimitEnabled + nbComponentsToAllocate);
+    decimal* newLowerLimit = alignComponentData<decimal>(newIsMotorEnabled + nbComponentsToAllocate);
+    decimal* newUpperLimit = alignComponentData<decimal>(newLowerLimit + nbComponentsToAllocate);
+    bool* newIsLowerLimitViolated = alignComponentData<bool>(newUpperLimit + nbComponentsToAllocate);
+    bool* newIsUpperLimitViolated = alignComponentData<bool>(newIsLowerLimitViolated + nbComponentsToAllocate);
+    decimal* newMotorSpeed = alignComponentData<decimal>(newIsUpperLimitViolated + nbComponentsToAllocate);
+    decimal* newMaxMotorTorque = alignComponentData<decimal>(newMotorSpeed + nbComponentsToAllocate);
 
     // If there was already components before
     if (mNbComponents > 0) {
@@ -137,9 +137,11 @@ void HingeJointComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy(newIsUpperLimitViolated, mIsUpperLimitViolated, mNbComponents * sizeof(bool));
         memcpy(newMotorSpeed, mMotorSpeed, mNbComponents * sizeof(decimal));
         memcpy(newMaxMotorTorque, mMaxMotorTorque, mNbComponents * sizeof(decimal));
+    }
 
-        // Deallocate previous memory
-        mMemoryAllocator.release(mBuffer, mNbAllocatedComponents * mComponentDataSize);
+    // Deallocate previous memory
+    if (mNbAllocatedComponents > 0) {
+        mMemoryAllocator.release(mBuffer, computeBufferSize(mNbAllocatedComponents), COMPONENT_DATA_ALIGNMENT);
     }
 
     mBuffer = newBuffer;
@@ -34,8 +34,7 @@ using namespace reactphysics3d;
 // Constructor
 JointComponents::JointComponents(MemoryAllocator& allocator)
                     :Components(allocator, sizeof(Entity) + sizeof(Entity) + sizeof(Entity) + sizeof(Joint*) +
-                                sizeof(JointType) + sizeof(JointsPositionCorrectionTechnique) + sizeof(bool) +
-                                sizeof(bool)) {
+                                sizeof(JointType) + sizeof(JointsPositionCorrectionTechnique) + sizeof(bool), 7) {
 
     // Allocate memory for the components data
     allocate(INIT_NB_ALLOCATED_COMPONENTS);
@@ -44,24 +43,23 @@ JointComponents::JointComponents(MemoryAllocator& allocator)
 // Allocate memory for a given number of components
 void JointComponents::allocate(uint32 nbComponentsToAllocate) {
 
-    assert(nbComponentsToAllocate > mNbAllocatedComponents);
+    assert(nbComponentsToAllocate >= mNbComponents);
 
-    // Size for the data of a single component (in bytes)
-    const size_t totalSizeBytes = nbComponentsToAllocate * mComponentDataSize;
+    // Size (in bytes) of the buffer for the data of the components
+    const size_t totalSizeBytes = computeBufferSize(nbComponentsToAllocate);
 
     // Allocate memory
-    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes);
+    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes, COMPONENT_DATA_ALIGNMENT);
     assert(newBuffer != nullptr);
 
     // New pointers to components data
     Entity* newJointsEntities = static_cast<Entity*>(newBuffer);
-    Entity* newBody1Entities = reinterpret_cast<Entity*>(newJointsEntities + nbComponentsToAllocate);
-    Entity* newBody2Entities = reinterpret_cast<Entity*>(newBody1Entities + nbComponentsToAllocate);
-    Joint** newJoints = reinterpret_cast<Joint**>(newBody2Entities + nbComponentsToAllocate);
-    JointType* newTypes = reinterpret_cast<JointType*>(newJoints + nbComponentsToAllocate);
-    JointsPositionCorrectionTechnique* newPositionCorrectionTechniques = reinterpret_cast<JointsPositionCorrectionTechnique*>(newTypes + nbComponentsToAllocate);
-    bool* newIsCollisionEnabled = reinterpret_cast<bool*>(newPositionCorrectionTechniques + nbComponentsToAllocate);
-    bool* newIsAlreadyInIsland = reinterpret_cast<bool*>(newIsCollisionEnabled + nbComponentsToAllocate);
+    Entity* newBody1Entities = alignComponentData<Entity>(newJointsEntities + nbComponentsToAllocate);
+    Entity* newBody2Entities = alignComponentData<Entity>(newBody1Entities + nbComponentsToAllocate);
+    Joint** newJoints = alignComponentData<Joint*>(newBody2Entities + nbComponentsToAllocate);
+    JointType* newTypes = alignComponentData<JointType>(newJoints + nbComponentsToAllocate);
+    JointsPositionCorrectionTechnique* newPositionCorrectionTechniques = alignComponentData<JointsPositionCorrectionTechnique>(newTypes + nbComponentsToAllocate);
+    bool* newIsCollisionEnabled = alignComponentData<bool>(newPositionCorrectionTechniques + nbComponentsToAllocate);
 
     // If there was already components before
     if (mNbComponents > 0) {
@@ -74,10 +72,11 @@ void JointComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy(newTypes, mTypes, mNbComponents * sizeof(JointType));
         memcpy(newPositionCorrectionTechniques, mPositionCorrectionTechniques, mNbComponents * sizeof(JointsPositionCorrectionTechnique));
         memcpy(newIsCollisionEnabled, mIsCollisionEnabled, mNbComponents * sizeof(bool));
-        memcpy(newIsAlreadyInIsland, mIsAlreadyInIsland, mNbComponents * sizeof(bool));
+    }
 
-        // Deallocate previous memory
-        mMemoryAllocator.release(mBuffer, mNbAllocatedComponents * mComponentDataSize);
+    // Deallocate previous memory
+    if (mNbAllocatedComponents > 0) {
+        mMemoryAllocator.release(mBuffer, computeBufferSize(mNbAllocatedComponents), COMPONENT_DATA_ALIGNMENT);
     }
 
     mBuffer = newBuffer;
@@ -89,7 +88,6 @@ void JointComponents::allocate(uint32 nbComponentsToAllocate) {
     mTypes = newTypes;
     mPositionCorrectionTechniques = newPositionCorrectionTechniques;
     mIsCollisionEnabled = newIsCollisionEnabled;
-    mIsAlreadyInIsland = newIsAlreadyInIsland;
 }
 
 // Add a component
@@ -106,7 +104,6 @@ void JointComponents::addComponent(Entity jointEntity, bool isSleeping, const Jo
     new (mTypes + index) JointType(component.jointType);
     new (mPositionCorrectionTechniques + index) JointsPositionCorrectionTechnique(component.positionCorrectionTechnique);
     mIsCollisionEnabled[index] = component.isCollisionEnabled;
-    mIsAlreadyInIsland[index] = false;
 
     // Map the entity with the new component lookup index
     mMapEntityToComponentIndex.add(Pair<Entity, uint32>(jointEntity, index));
@@ -131,7 +128,6 @@ void JointComponents::moveComponentToIndex(uint32 srcIndex, uint32 destIndex) {
     new (mTypes + destIndex) JointType(mTypes[srcIndex]);
     new (mPositionCorrectionTechniques + destIndex) JointsPositionCorrectionTechnique(mPositionCorrectionTechniques[srcIndex]);
     mIsCollisionEnabled[destIndex] = mIsCollisionEnabled[srcIndex];
-    mIsAlreadyInIsland[destIndex] = mIsAlreadyInIsland[srcIndex];
 
     // Destroy the source component
     destroyComponent(srcIndex);
@@ -155,7 +151,6 @@ void JointComponents::swapComponents(uint32 index1, uint32 index2) {
     JointType jointType1(mTypes[index1]);
     JointsPositionCorrectionTechnique positionCorrectionTechnique1(mPositionCorrectionTechniques[index1]);
     bool isCollisionEnabled1 = mIsCollisionEnabled[index1];
-    bool isAlreadyInIsland = mIsAlreadyInIsland[index1];
 
     // Destroy component 1
     destroyComponent(index1);
@@ -170,7 +165,6 @@ void JointComponents::swapComponents(uint32 index1, uint32 index2) {
     new (mTypes + index2) JointType(jointType1);
     new (mPositionCorrectionTechniques + index2) JointsPositionCorrectionTechnique(positionCorrectionTechnique1);
     mIsCollisionEnabled[index2] = isCollisionEnabled1;
-    mIsAlreadyInIsland[index2] = isAlreadyInIsland;
 
     // Update the entity to component index mapping
     mMapEntityToComponentIndex.add(Pair<Entity, uint32>(jointEntity1, index2));
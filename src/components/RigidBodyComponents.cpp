@@ -27,6 +27,7 @@
 #include <reactphysics3d/components/RigidBodyComponents.h>
 #include <reactphysics3d/engine/EntityManager.h>
 #include <reactphysics3d/body/RigidBody.h>
+#include <reactphysics3d/engine/PersistentIslands.h>
 #include <cassert>
 #include <random>
 
@@ -43,8 +44,8 @@ RigidBodyComponents::RigidBodyComponents(MemoryAllocator& allocator)
                                 sizeof(Vector3) + + sizeof(Matrix3x3) + sizeof(Vector3) + sizeof(Vector3) +
                                 sizeof(Vector3) + sizeof(Vector3) + sizeof(Vector3) +
                                 sizeof(Quaternion) + sizeof(Vector3) + sizeof(Vector3) +
-                                sizeof(bool) + sizeof(bool) + sizeof(Array<Entity>) + sizeof(Array<uint>) +
-                                sizeof(Vector3) + sizeof(Vector3)) {
+                                sizeof(bool) + sizeof(uint32) + sizeof(Array<Entity>) +
+                                sizeof(Vector3) + sizeof(Vector3), 30) {
 
     // Allocate memory for the components data
     allocate(INIT_NB_ALLOCATED_COMPONENTS);
@@ -53,47 +54,46 @@ RigidBodyComponents::RigidBodyComponents(MemoryAllocator& allocator)
 // Allocate memory for a given number of components
 void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
 
-    assert(nbComponentsToAllocate > mNbAllocatedComponents);
+    assert(nbComponentsToAllocate >= mNbComponents);
 
-    // Size for the data of a single component (in bytes)
-    const size_t totalSizeBytes = nbComponentsToAllocate * mComponentDataSize;
+    // Size (in bytes) of the buffer for the data of the components
+    const size_t totalSizeBytes = computeBufferSize(nbComponentsToAllocate);
 
     // Allocate memory
-    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes);
+    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes, COMPONENT_DATA_ALIGNMENT);
     assert(newBuffer != nullptr);
 
     // New pointers to components data
     Entity* newBodiesEntities = static_cast<Entity*>(newBuffer);
-    RigidBody** newBodies = reinterpret_cast<RigidBody**>(newBodiesEntities + nbComponentsToAllocate);
-    bool* newIsAllowedToSleep = reinterpret_cast<bool*>(newBodies + nbComponentsToAllocate);
-    bool* newIsSleeping = reinterpret_cast<bool*>(newIsAllowedToSleep + nbComponentsToAllocate);
-    decimal* newSleepTimes = reinterpret_cast<decimal*>(newIsSleeping + nbComponentsToAllocate);
-    BodyType* newBodyTypes = reinterpret_cast<BodyType*>(newSleepTimes + nbComponentsToAllocate);
-    Vector3* newLinearVelocities = reinterpret_cast<Vector3*>(newBodyTypes + nbComponentsToAllocate);
-    Vector3* newAngularVelocities = reinterpret_cast<Vector3*>(newLinearVelocities + nbComponentsToAllocate);
-    Vector3* newExternalForces = reinterpret_cast<Vector3*>(newAngularVelocities + nbComponentsToAllocate);
-    Vector3* newExternalTorques = reinterpret_cast<Vector3*>(newExternalForces + nbComponentsToAllocate);
-    decimal* newLinearDampings = reinterpret_cast<decimal*>(newExternalTorques + nbComponentsToAllocate);
-    decimal* newAngularDampings = reinterpret_cast<decimal*>(newLinearDampings + nbComponentsToAllocate);
-    decimal* newMasses = reinterpret_cast<decimal*>(newAngularDampings + nbComponentsToAllocate);
-    decimal* newInverseMasses = reinterpret_cast<decimal*>(newMasses + nbComponentsToAllocate);
-    Vector3* newInertiaTensorLocal = reinterpret_cast<Vector3*>(newInverseMasses + nbComponentsToAllocate);
-    Vector3* newInertiaTensorLocalInverses = reinterpret_cast<Vector3*>(newInertiaTensorLocal + nbComponentsToAllocate);
-    Matrix3x3* newInertiaTensorWorldInverses = reinterpret_cast<Matrix3x3*>(newInertiaTensorLocalInverses + nbComponentsToAllocate);
-    Vector3* newConstrainedLinearVelocities = reinterpret_cast<Vector3*>(newInertiaTensorWorldInverses + nbComponentsToAllocate);
-    Vector3* newConstrainedAngularVelocities = reinterpret_cast<Vector3*>(newConstrainedLinearVelocities + nbComponentsToAllocate);
-    Vector3* newSplitLinearVelocities = reinterpret_cast<Vector3*>(newConstrainedAngularVelocities + nbComponentsToAllocate);
-    Vector3* newSplitAngularVelocities = reinterpret_cast<Vector3*>(newSplitLinearVelocities + nbComponentsToAllocate);
-    Vector3* newConstrainedPositions = reinterpret_cast<Vector3*>(newSplitAngularVelocities + nbComponentsToAllocate);
-    Quaternion* newConstrainedOrientations = reinterpret_cast<Quaternion*>(newConstrainedPositions + nbComponentsToAllocate);
-    Vector3* newCentersOfMassLocal = reinterpret_cast<Vector3*>(newConstrainedOrientations + nbComponentsToAllocate);
-    Vector3* newCentersOfMassWorld = reinterpret_cast<Vector3*>(newCentersOfMassLocal + nbComponentsToAllocate);
-    bool* newIsGravityEnabled = reinterpret_cast<bool*>(newCentersOfMassWorld + nbComponentsToAllocate);
-    bool* newIsAlreadyInIsland = reinterpret_cast<bool*>(newIsGravityEnabled + nbComponentsToAllocate);
-    Array<Entity>* newJoints = reinterpret_cast<Array<Entity>*>(newIsAlreadyInIsland + nbComponentsToAllocate);
-    Array<uint>* newContactPairs = reinterpret_cast<Array<uint>*>(newJoints + nbComponentsToAllocate);
-    Vector3* newLinearLockAxisFactors = reinterpret_cast<Vector3*>(newContactPairs + nbComponentsToAllocate);
-    Vector3* newAngularLockAxisFactors = reinterpret_cast<Vector3*>(newLinearLockAxisFactors + nbComponentsToAllocate);
+    RigidBody** newBodies = alignComponentData<RigidBody*>(newBodiesEntities + nbComponentsToAllocate);
+    bool* newIsAllowedToSleep = alignComponentData<bool>(newBodies + nbComponentsToAllocate);
+    bool* newIsSleeping = alignComponentData<bool>(newIsAllowedToSleep + nbComponentsToAllocate);
+    decimal* newSleepTimes = alignComponentData<decimal>(newIsSleeping + nbComponentsToAllocate);
+    BodyType* newBodyTypes = alignComponentData<BodyType>(newSleepTimes + nbComponentsToAllocate);
+    Vector3* newLinearVelocities = alignComponentData<Vector3>(newBodyTypes + nbComponentsToAllocate);
+    Vector3* newAngularVelocities = alignComponentData<Vector3>(newLinearVelocities + nbComponentsToAllocate);
+    Vector3* newExternalForces = alignComponentData<Vector3>(newAngularVelocities + nbComponentsToAllocate);
+    Vector3* newExternalTorques = alignComponentData<Vector3>(newExternalForces + nbComponentsToAllocate);
+    decimal* newLinearDampings = alignComponentData<decimal>(newExternalTorques + nbComponentsToAllocate);
+    decimal* newAngularDampings = alignComponentData<decimal>(newLinearDampings + nbComponentsToAllocate);
+    decimal* newMasses = alignComponentData<decimal>(newAngularDampings + nbComponentsToAllocate);
+    decimal* newInverseMasses = alignComponentData<decimal>(newMasses + nbComponentsToAllocate);
+    Vector3* newInertiaTensorLocal = alignComponentData<Vector3>(newInverseMasses + nbComponentsToAllocate);
+    Vector3* newInertiaTensorLocalInverses = alignComponentData<Vector3>(newInertiaTensorLocal + nbComponentsToAllocate);
+    Matrix3x3* newInertiaTensorWorldInverses = alignComponentData<Matrix3x3>(newInertiaTensorLocalInverses + nbComponentsToAllocate);
+    Vector3* newConstrainedLinearVelocities = alignComponentData<Vector3>(newInertiaTensorWorldInverses + nbComponentsToAllocate);
+    Vector3* newConstrainedAngularVelocities = alignComponentData<Vector3>(newConstrainedLinearVelocities + nbComponentsToAllocate);
+    Vector3* newSplitLinearVelocities = alignComponentData<Vector3>(newConstrainedAngularVelocities + nbComponentsToAllocate);
+    Vector3* newSplitAngularVelocities = alignComponentData<Vector3>(newSplitLinearVelocities + nbComponentsToAllocate);
+    Vector3* newConstrainedPositions = alignComponentData<Vector3>(newSplitAngularVelocities + nbComponentsToAllocate);
+    Quaternion* newConstrainedOrientations = alignComponentData<Quaternion>(newConstrainedPositions + nbComponentsToAllocate);
+    Vector3* newCentersOfMassLocal = alignComponentData<Vector3>(newConstrainedOrientations + nbComponentsToAllocate);
+    Vector3* newCentersOfMassWorld = alignComponentData<Vector3>(newCentersOfMassLocal + nbComponentsToAllocate);
+    bool* newIsGravityEnabled = alignComponentData<bool>(newCentersOfMassWorld + nbComponentsToAllocate);
+    uint32* newIslandIds = alignComponentData<uint32>(newIsGravityEnabled + nbComponentsToAllocate);
+    Array<Entity>* newJoints = alignComponentData<Array<Entity>>(newIslandIds + nbComponentsToAllocate);
+    Vector3* newLinearLockAxisFactors = alignComponentData<Vector3>(newJoints + nbComponentsToAllocate);
+    Vector3* newAngularLockAxisFactors = alignComponentData<Vector3>(newLinearLockAxisFactors + nbComponentsToAllocate);
 
     // If there was already components before
     if (mNbComponents > 0) {
@@ -125,14 +125,15 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy(newCentersOfMassLocal, mCentersOfMassLocal, mNbComponents * sizeof(Vector3));
         memcpy(newCentersOfMassWorld, mCentersOfMassWorld, mNbComponents * sizeof(Vector3));
         memcpy(newIsGravityEnabled, mIsGravityEnabled, mNbComponents * sizeof(bool));
-        memcpy(newIsAlreadyInIsland, mIsAlreadyInIsland, mNbComponents * sizeof(bool));
+        memcpy(newIslandIds, mIslandIds, mNbComponents * sizeof(uint32));
         memcpy(newJoints, mJoints, mNbComponents * sizeof(Array<Entity>));
-        memcpy(newContactPairs, mContactPairs, mNbComponents * sizeof(Array<uint>));
         memcpy(newLinearLockAxisFactors, mLinearLockAxisFactors, mNbComponents * sizeof(Vector3));
         memcpy(newAngularLockAxisFactors, mAngularLockAxisFactors, mNbComponents * sizeof(Vector3));
+    }
 
-        // Deallocate previous memory
-        mMemoryAllocator.release(mBuffer, mNbAllocatedComponents * mComponentDataSize);
+    // Deallocate previous memory
+    if (mNbAllocatedComponents > 0) {
+        mMemoryAllocator.release(mBuffer, computeBufferSize(mNbAllocatedComponents), COMPONENT_DATA_ALIGNMENT);
     }
 
     mBuffer = newBuffer;
@@ -163,9 +164,8 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
     mCentersOfMassLocal = newCentersOfMassLocal;
     mCentersOfMassWorld = newCentersOfMassWorld;
     mIsGravityEnabled = newIsGravityEnabled;
-    mIsAlreadyInIsland = newIsAlreadyInIsland;
+    mIslandIds = newIslandIds;
     mJoints = newJoints;
-    mContactPairs = newContactPairs;
     mLinearLockAxisFactors = newLinearLockAxisFactors;
     mAngularLockAxisFactors = newAngularLockAxisFactors;
 }
@@ -203,9 +203,8 @@ void RigidBodyComponents::addComponent(Entity bodyEntity, bool isSleeping, const
     new (mCentersOfMassLocal + index) Vector3(0, 0, 0);
     new (mCentersOfMassWorld + index) Vector3(component.worldPosition);
     mIsGravityEnabled[index] = true;
-    mIsAlreadyInIsland[index] = false;
+    mIslandIds[index] = NO_ISLAND;
     new (mJoints + index) Array<Entity>(mMemoryAllocator);
-    new (mContactPairs + index) Array<uint>(mMemoryAllocator);
     new (mLinearLockAxisFactors + index) Vector3(1, 1, 1);
     new (mAngularLockAxisFactors + index) Vector3(1, 1, 1);
 
@@ -251,9 +250,8 @@ void RigidBodyComponents::moveComponentToIndex(uint32 srcIndex, uint32 destIndex
     new (mCentersOfMassLocal + destIndex) Vector3(mCentersOfMassLocal[srcIndex]);
     new (mCentersOfMassWorld + destIndex) Vector3(mCentersOfMassWorld[srcIndex]);
     mIsGravityEnabled[destIndex] = mIsGravityEnabled[srcIndex];
-    mIsAlreadyInIsland[destIndex] = mIsAlreadyInIsland[srcIndex];
+    mIslandIds[destIndex] = mIslandIds[srcIndex];
     new (mJoints + destIndex) Array<Entity>(mJoints[srcIndex]);
-    new (mContactPairs + destIndex) Array<uint>(mContactPairs[srcIndex]);
     new (mLinearLockAxisFactors + destIndex) Vector3(mLinearLockAxisFactors[srcIndex]);
     new (mAngularLockAxisFactors + destIndex) Vector3(mAngularLockAxisFactors[srcIndex]);
 
@@ -298,9 +296,8 @@ void RigidBodyComponents::swapComponents(uint32 index1, uint32 index2) {
     Vector3 centerOfMassLocal1 = mCentersOfMassLocal[index1];
     Vector3 centerOfMassWorld1 = mCentersOfMassWorld[index1];
     bool isGravityEnabled1 = mIsGravityEnabled[index1];
-    bool isAlreadyInIsland1 = mIsAlreadyInIsland[index1];
+    uint32 islandId1 = mIslandIds[index1];
     Array<Entity> joints1 = mJoints[index1];
-    Array<uint> contactPairs1 = mContactPairs[index1];
     Vector3 linearLockAxisFactor1(mLinearLockAxisFactors[index1]);
     Vector3 angularLockAxisFactor1(mAngularLockAxisFactors[index1]);
 
@@ -336,9 +333,8 @@ void RigidBodyComponents::swapComponents(uint32 index1, uint32 index2) {
     mCentersOfMassLocal[index2] = centerOfMassLocal1;
     mCentersOfMassWorld[index2] = centerOfMassWorld1;
     mIsGravityEnabled[index2] = isGravityEnabled1;
-    mIsAlreadyInIsland[index2] = isAlreadyInIsland1;
+    mIslandIds[index2] = islandId1;
     new (mJoints + index2) Array<Entity>(joints1);
-    new (mContactPairs + index2) Array<uint>(contactPairs1);
     new (mLinearLockAxisFactors + index2) Vector3(linearLockAxisFactor1);
     new (mAngularLockAxisFactors + index2) Vector3(angularLockAxisFactor1);
 
@@ -377,7 +373,6 @@ void RigidBodyComponents::destroyComponent(uint32 index) {
     mCentersOfMassLocal[index].~Vector3();
     mCentersOfMassWorld[index].~Vector3();
     mJoints[index].~Array<Entity>();
-    mContactPairs[index].~Array<uint>();
     mLinearLockAxisFactors[index].~Vector3();
     mAngularLockAxisFactors[index].~Vector3();
 }
@@ -45,7 +45,7 @@ SliderJointComponents::SliderJointComponents(MemoryAllocator& allocator)
                                 sizeof(bool) + sizeof(bool) + sizeof(decimal) + sizeof(decimal)  +
                                 sizeof(bool) + sizeof(bool) + sizeof(decimal) + sizeof(decimal) +
                                 sizeof(Vector3) + sizeof(Vector3) + sizeof(Vector3) + sizeof(Vector3) +
-                                sizeof(Vector3) + sizeof(Vector3)) {
+                                sizeof(Vector3) + sizeof(Vector3), 40) {
 
     // Allocate memory for the components data
     allocate(INIT_NB_ALLOCATED_COMPONENTS);
@@ -54,56 +54,56 @@ SliderJointComponents::SliderJointComponents(MemoryAllocator& allocator)
 // Allocate memory for a given number of components
 void SliderJointComponents::allocate(uint32 nbComponentsToAllocate) {
 
-    assert(nbComponentsToAllocate > mNbAllocatedComponents);
+    assert(nbComponentsToAllocate >= mNbComponents);
 
-    // Size for the data of a single component (in bytes)
-    const size_t totalSizeBytes = nbComponentsToAllocate * mComponentDataSize;
+    // Size (in bytes) of the buffer for the data of the components
+    const size_t totalSizeBytes = computeBufferSize(nbComponentsToAllocate);
 
     // Allocate memory
-    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes);
+    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes, COMPONENT_DATA_ALIGNMENT);
     assert(newBuffer != nullptr);
 
     // New pointers to components data
     Entity* newJointEntities = static_cast<Entity*>(newBuffer);
-    SliderJoint** newJoints = reinterpret_cast<SliderJoint**>(newJointEntities + nbComponentsToAllocate);
-    Vector3* newLocalAnchorPointBody1 = reinterpret_cast<Vector3*>(newJoints + nbComponentsToAllocate);
-    Vector3* newLocalAnchorPointBody2 = reinterpret_cast<Vector3*>(newLocalAnchorPointBody1 + nbComponentsToAllocate);
-    Matrix3x3* newI1 = reinterpret_cast<Matrix3x3*>(newLocalAnchorPointBody2 + nbComponentsToAllocate);
-    Matrix3x3* newI2 = reinterpret_cast<Matrix3x3*>(newI1 + nbComponentsToAllocate);
-    Vector2* newImpulseTranslation = reinterpret_cast<Vector2*>(newI2 + nbComponentsToAllocate);
-    Vector3* newImpulseRotation = reinterpret_cast<Vector3*>(newImpulseTranslation + nbComponentsToAllocate);
-    Matrix2x2* newInverseMassMatrixTranslation = reinterpret_cast<Matrix2x2*>(newImpulseRotation + nbComponentsToAllocate);
-    Matrix3x3* newInverseMassMatrixRotation = reinterpret_cast<Matrix3x3*>(newInverseMassMatrixTranslation + nbComponentsToAllocate);
-    Vector2* newBiasTranslation = reinterpret_cast<Vector2*>(newInverseMassMatrixRotation + nbComponentsToAllocate);
-    Vector3* newBiasRotation = reinterpret_cast<Vector3*>(newBiasTranslation + nbComponentsToAllocate);
-    Quaternion* newInitOrientationDifferenceInv = reinterpret_cast<Quaternion*>(newBiasRotation + nbComponentsToAllocate);
-    Vector3* newSliderAxisBody1 = reinterpret_cast<Vector3*>(newInitOrientationDifferenceInv + nbComponentsToAllocate);
-    Vector3* newSliderAxisWorld = reinterpret_cast<Vector3*>(newSliderAxisBody1 + nbComponentsToAllocate);
-    Vector3* newR1 = reinterpret_cast<Vector3*>(newSliderAxisWorld + nbComponentsToAllocate);
-    Vector3* newR2 = reinterpret_cast<Vector3*>(newR1 + nbComponentsToAllocate);
-    Vector3* newN1 = reinterpret_cast<Vector3*>(newR2 + nbComponentsToAllocate);
-    Vector3* newN2 = reinterpret_cast<Vector3*>(newN1 + nbComponentsToAllocate);
-    decimal* newImpulseLowerLimit = reinterpret_cast<decimal*>(newN2 + nbComponentsToAllocate);
-    decimal* newImpulseUpperLimit = reinterpret_cast<decimal*>(newImpulseLowerLimit + nbComponentsToAllocate);
-    decimal* newImpulseMotor = reinterpret_cast<decimal*>(newImpulseUpperLimit + nbComponentsToAllocate);
-    decimal* newInverseMassMatrixLimit = reinterpret_cast<decimal*>(newImpulseMotor + nbComponentsToAllocate);
-    decimal* newInverseMassMatrixMotor = reinterpret_cast<decimal*>(newInverseMassMatrixLimit + nbComponentsToAllocate);
-    decimal* newBLowerLimit = reinterpret_cast<decimal*>(newInverseMassMatrixMotor + nbComponentsToAllocate);
-    decimal* newBUpperLimit = reinterpret_cast<decimal*>(newBLowerLimit + nbComponentsToAllocate);
-    bool* newIsLimitEnabled = reinterpret_cast<bool*>(newBUpperLimit + nbComponentsToAllocate);
-    bool* newIsMotorEnabled = reinterpret_cast<bool*>(newIsLimitEnabled + nbComponentsToAllocate);
-    decimal* newLowerLimit = reinterpret_cast<decimal*>(newIsMotorEnabled + nbComponentsToAllocate);
-    decimal* newUpperLimit = reinterpret_cast<decimal*>(newLowerLimit + nbComponentsToAllocate);
-    bool* newIsLowerLimitViolated = reinterpret_cast<bool*>(newUpperLimit + nbComponentsToAllocate);
-    bool* newIsUpperLimitViolated = reinterpret_cast<bool*>(newIsLowerLimitViolated + nbComponentsToAllocate);
-    decimal* newMotorSpeed = reinterpret_cast<decimal*>(newIsUpperLimitViolated + nbComponentsToAllocate);
-    decimal* newMaxMotorForce = reinterpret_cast<decimal*>(newMotorSpeed + nbComponentsToAllocate);
-    Vector3* newR2CrossN1 = reinterpret_cast<Vector3*>(newMaxMotorForce + nbComponentsToAllocate);
-    Vector3* newR2CrossN2 = reinterpret_cast<Vector3*>(newR2CrossN1 + nbComponentsToAllocate);
-    Vector3* newR2CrossSliderAxis = reinterpret_cast<Vector3*>(newR2CrossN2 + nbComponentsToAllocate);
-    Vector3* newR1PlusUCrossN1 = reinterpret_cast<Vector3*>(newR2CrossSliderAxis + nbComponentsToAllocate);
-    Vector3* newR1PlusUCrossN2 = reinterpret_cast<Vector3*>(newR1PlusUCrossN1 + nbComponentsToAllocate);
-    Vector3* newR1PlusUCrossSliderAxis = reinterpret_cast<Vector3*>(newR1PlusUCrossN2 + nbComponentsToAllocate);
+    SliderJoint** newJoints = alignComponentData<SliderJoint*>(newJointEntities + nbComponentsToAllocate);
+    Vector3* newLocalAnchorPointBody1 = alignComponentData<Vector3>(newJoints + nbComponentsToAllocate);
+    Vector3* newLocalAnchorPointBody2 = alignComponentData<Vector3>(newLocalAnchorPointBody1 + nbComponentsToAllocate);
+    Matrix3x3* newI1 = alignComponentData<Matrix3x3>(newLocalAnchorPointBody2 + nbComponentsToAllocate);
+    Matrix3x3* newI2 = alignComponentData<Matrix3x3>(newI1 + nbComponentsToAllocate);
+    Vector2* newImpulseTranslation = alignComponentData<Vector2>(newI2 + nbComponentsToAllocate);
+    Vector3* newImpulseRotation = alignComponentData<Vector3>(newImpulseTranslation + nbComponentsToAllocate);
+    Matrix2x2* newInverseMassMatrixTranslation = alignComponentData<Matrix2x2>(newImpulseRotation + nbComponentsToAllocate);
+    Matrix3x3* newInverseMassMatrixRotation = alignComponentData<Matrix3x3>(newInverseMassMatrixTranslation + nbComponentsToAllocate);
+    Vector2* newBiasTranslation = alignComponentData<Vector2>(newInverseMassMatrixRotation + nbComponentsToAllocate);
+    Vector3* newBiasRotation = alignComponentData<Vector3>(newBiasTranslation + nbComponentsToAllocate);
+    Quaternion* newInitOrientationDifferenceInv = alignComponentData<Quaternion>(newBiasRotation + nbComponentsToAllocate);
+    Vector3* newSliderAxisBody1 = alignComponentData<Vector3>(newInitOrientationDifferenceInv + nbComponentsToAllocate);
+    Vector3* newSliderAxisWorld = alignComponentData<Vector3>(newSliderAxisBody1 + nbComponentsToAllocate);
+    Vector3* newR1 = alignComponentData<Vector3>(newSliderAxisWorld + nbComponentsToAllocate);
+    Vector3* newR2 = alignComponentData<Vector3>(newR1 + nbComponentsToAllocate);
+    Vector3* newN1 = alignComponentData<Vector3>(newR2 + nbComponentsToAllocate);
+    Vector3* newN2 = alignComponentData<Vector3>(newN1 + nbComponentsToAllocate);
+    decimal* newImpulseLowerLimit = alignComponentData<decimal>(newN2 + nbComponentsToAllocate);
+    decimal* newImpulseUpperLimit = alignComponentData<decimal>(newImpulseLowerLimit + nbComponentsToAllocate);
+    decimal* newImpulseMotor = alignComponentData<decimal>(newImpulseUpperLimit + nbComponentsToAllocate);
+    decimal* newInverseMassMatrixLimit = alignComponentData<decimal>(newImpulseMotor + nbComponentsToAllocate);
+    decimal* newInverseMassMatrixMotor = alignComponentData<decimal>(newInverseMassMatrixLimit + nbComponentsToAllocate);
+    decimal* newBLowerLimit = alignComponentData<decimal>(newInverseMassMatrixMotor + nbComponentsToAllocate);
+    decimal* newBUpperLimit = alignComponentData<decimal>(newBLowerLimit + nbComponentsToAllocate);
+    bool* newIsLimitEnabled = alignComponentData<bool>(newBUpperLimit + nbComponentsToAllocate);
+    bool* newIsMotorEnabled = alignComponentData<bool>(newIsLimitEnabled + nbComponentsToAllocate);
+    decimal* newLowerLimit = alignComponentData<decimal>(newIsMotorEnabled + nbComponentsToAllocate);
+    decimal* newUpperLimit = alignComponentData<decimal>(newLowerLimit + nbComponentsToAllocate);
+    bool* newIsLowerLimitViolated = alignComponentData<bool>(newUpperLimit + nbComponentsToAllocate);
+    bool* newIsUpperLimitViolated = alignComponentData<bool>(newIsLowerLimitViolated + nbComponentsToAllocate);
+    decimal* newMotorSpeed = alignComponentData<decimal>(newIsUpperLimitViolated + nbComponentsToAllocate);
+    decimal* newMaxMotorForce = alignComponentData<decimal>(newMotorSpeed + nbComponentsToAllocate);
+    Vector3* newR2CrossN1 = alignComponentData<Vector3>(newMaxMotorForce + nbComponentsToAllocate);
+    Vector3* newR2CrossN2 = alignComponentData<Vector3>(newR2CrossN1 + nbComponentsToAllocate);
+    Vector3* newR2CrossSliderAxis = alignComponentData<Vector3>(newR2CrossN2 + nbComponentsToAllocate);
+    Vector3* newR1PlusUCrossN1 = alignComponentData<Vector3>(newR2CrossSliderAxis + nbComponentsToAllocate);
+    Vector3* newR1PlusUCrossN2 = alignComponentData<Vector3>(newR1PlusUCrossN1 + nbComponentsToAllocate);
+    Vector3* newR1PlusUCrossSliderAxis = alignComponentData<Vector3>(newR1PlusUCrossN2 + nbComponentsToAllocate);
 
     // If there was already components before
     if (mNbComponents > 0) {
@@ -149,9 +149,11 @@ void SliderJointComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy(newR1PlusUCrossN1, mR1PlusUCrossN1, mNbComponents * sizeof(decimal));
         memcpy(newR1PlusUCrossN2, mR1PlusUCrossN2, mNbComponents * sizeof(decimal));
         memcpy(newR1PlusUCrossSliderAxis, mR1PlusUCrossSliderAxis, mNbComponents * sizeof(decimal));
+    }
 
-        // Deallocate previous memory
-        mMemoryAllocator.release(mBuffer, mNbAllocatedComponents * mComponentDataSize);
+    // Deallocate previous memory
+    if (mNbAllocatedComponents > 0) {
+        mMemoryAllocator.release(mBuffer, computeBufferSize(mNbAllocatedComponents), COMPONENT_DATA_ALIGNMENT);
     }
 
     mBuffer = newBuffer;
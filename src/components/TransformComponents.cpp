@@ -35,7 +35,7 @@ using namespace reactphysics3d;
 
 // Constructor
 TransformComponents::TransformComponents(MemoryAllocator& allocator)
-                    :Components(allocator, sizeof(Entity) + sizeof(Transform)) {
+                    :Components(allocator, sizeof(Entity) + sizeof(Transform), 2) {
 
     // Allocate memory for the components data
     allocate(INIT_NB_ALLOCATED_COMPONENTS);
@@ -44,18 +44,18 @@ TransformComponents::TransformComponents(MemoryAllocator& allocator)
 // Allocate memory for a given number of components
 void TransformComponents::allocate(uint32 nbComponentsToAllocate) {
 
-    assert(nbComponentsToAllocate > mNbAllocatedComponents);
+    assert(nbComponentsToAllocate >= mNbComponents);
 
-    // Size for the data of a single component (in bytes)
-    const size_t totalSizeBytes = nbComponentsToAllocate * mComponentDataSize;
+    // Size (in bytes) of the buffer for the data of the components
+    const size_t totalSizeBytes = computeBufferSize(nbComponentsToAllocate);
 
     // Allocate memory
-    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes);
+    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes, COMPONENT_DATA_ALIGNMENT);
     assert(newBuffer != nullptr);
 
     // New pointers to components data
     Entity* newEntities = static_cast<Entity*>(newBuffer);
-    Transform* newTransforms = reinterpret_cast<Transform*>(newEntities + nbComponentsToAllocate);
+    Transform* newTransforms = alignComponentData<Transform>(newEntities + nbComponentsToAllocate);
 
     // If there was already components before
     if (mNbComponents > 0) {
@@ -63,9 +63,11 @@ void TransformComponents::allocate(uint32 nbComponentsToAllocate) {
         // Copy component data from the previous buffer to the new one
         memcpy(newTransforms, mTransforms, mNbComponents * sizeof(Transform));
         memcpy(newEntities, mBodies, mNbComponents * sizeof(Entity));
+    }
 
-        // Deallocate previous memory
-        mMemoryAllocator.release(mBuffer, mNbAllocatedComponents * mComponentDataSize);
+    // Deallocate previous memory
+    if (mNbAllocatedComponents > 0) {
+        mMemoryAllocator.release(mBuffer, computeBufferSize(mNbAllocatedComponents), COMPONENT_DATA_ALIGNMENT);
     }
 
     mBuffer = newBuffer;
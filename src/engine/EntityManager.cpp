@@ -73,3 +73,11 @@ void EntityManager::destroyEntity(Entity entity) {
     // Add the index into the deque of free indices
     mFreeIndices.addBack(index);
 }
+
+// Reserve memory for a given number of entities
+/**
+ * @param nbEntities The number of entities that can be created without any new allocation
+ */
+void EntityManager::reserve(uint32 nbEntities) {
+    mGenerations.reserve(nbEntities);
+}
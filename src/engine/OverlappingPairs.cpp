@@ -31,6 +31,7 @@
 #include <reactphysics3d/collision/narrowphase/NarrowPhaseAlgorithm.h>
 #include <reactphysics3d/collision/narrowphase/CollisionDispatch.h>
 #include <reactphysics3d/memory/MemoryManager.h>
+#include <reactphysics3d/systems/BroadPhaseSystem.h>
 
 using namespace reactphysics3d;
 
@@ -39,11 +40,98 @@ OverlappingPairs::OverlappingPairs(MemoryManager& memoryManager, ColliderCompone
                                    CollisionBodyComponents& collisionBodyComponents, RigidBodyComponents& rigidBodyComponents, Set<bodypair> &noCollisionPairs, CollisionDispatch &collisionDispatch)
                 : mPoolAllocator(memoryManager.getPoolAllocator()), mHeapAllocator(memoryManager.getHeapAllocator()), mConvexPairs(memoryManager.getHeapAllocator()),
                   mConcavePairs(memoryManager.getHeapAllocator()), mMapConvexPairIdToPairIndex(memoryManager.getHeapAllocator()), mMapConcavePairIdToPairIndex(memoryManager.getHeapAllocator()),
-                  mColliderComponents(colliderComponents), mCollisionBodyComponents(collisionBodyComponents),
+                  mPeakUsedMemory(0), mColliderComponents(colliderComponents), mCollisionBodyComponents(collisionBodyComponents),
                   mRigidBodyComponents(rigidBodyComponents), mNoCollisionPairs(noCollisionPairs), mCollisionDispatch(collisionDispatch) {
     
 }
 
+// Reserve memory for a given number of convex vs convex pairs
+/**
+ * @param nbPairs The number of pairs that can be added without any new allocation
+ */
+void OverlappingPairs::reserve(uint32 nbPairs) {
+
+    mConvexPairs.reserve(nbPairs);
+    mMapConvexPairIdToPairIndex.reserve(nbPairs);
+}
+
+// Update the pairs after the nodes of the broad-phase tree have moved
+/// The ID of a pair is computed from the broad-phase IDs of its colliders. Therefore, the IDs of
+/// the pairs change when the broad-phase tree is compacted.
+/**
+ * @param newNodeIds The new ID of each previous node ID of the broad-phase tree
+ * @param outNewPairIds Map where the new ID of each previous pair ID is stored
+ */
+void OverlappingPairs::updateBroadPhaseIds(const Array<int32>& newNodeIds, Map<uint64, uint64>& outNewPairIds) {
+
+    // Clear the pairs of the colliders (their pair IDs are added again below)
+    for (uint64 i=0; i < mConvexPairs.size(); i++) {
+        mColliderComponents.getOverlappingPairs(mConvexPairs[i].collider1).clear();
+        mColliderComponents.getOverlappingPairs(mConvexPairs[i].collider2).clear();
+    }
+    for (uint64 i=0; i < mConcavePairs.size(); i++) {
+        mColliderComponents.getOverlappingPairs(mConcavePairs[i].collider1).clear();
+        mColliderComponents.getOverlappingPairs(mConcavePairs[i].collider2).clear();
+    }
+
+    mMapConvexPairIdToPairIndex.clear();
+    for (uint64 i=0; i < mConvexPairs.size(); i++) {
+        updatePairBroadPhaseIds(mConvexPairs[i], newNodeIds, outNewPairIds);
+        mMapConvexPairIdToPairIndex.add(Pair<uint64, uint64>(mConvexPairs[i].pairID, i));
+    }
+
+    mMapConcavePairIdToPairIndex.clear();
+    for (uint64 i=0; i < mConcavePairs.size(); i++) {
+        updatePairBroadPhaseIds(mConcavePairs[i], newNodeIds, outNewPairIds);
+        mMapConcavePairIdToPairIndex.add(Pair<uint64, uint64>(mConcavePairs[i].pairID, i));
+    }
+}
+
+// Update the broad-phase IDs and the ID of a pair after the broad-phase nodes have moved
+void OverlappingPairs::updatePairBroadPhaseIds(OverlappingPair& pair, const Array<int32>& newNodeIds,
+                                               Map<uint64, uint64>& outNewPairIds) {
+
+    // The broad-phase IDs of the colliders of bodies in compound mode do not change
+    if (!BroadPhaseSystem::isCompoundBroadPhaseId(pair.broadPhaseId1)) {
+        pair.broadPhaseId1 = newNodeIds[pair.broadPhaseId1];
+    }
+    if (!BroadPhaseSystem::isCompoundBroadPhaseId(pair.broadPhaseId2)) {
+        pair.broadPhaseId2 = newNodeIds[pair.broadPhaseId2];
+    }
+
+    const uint64 newPairId = pairNumbers(std::max(pair.broadPhaseId1, pair.broadPhaseId2), std::min(pair.broadPhaseId1, pair.broadPhaseId2));
+    outNewPairIds.add(Pair<uint64, uint64>(pair.pairID, newPairId));
+    pair.pairID = newPairId;
+
+    mColliderComponents.getOverlappingPairs(pair.collider1).add(newPairId);
+    mColliderComponents.getOverlappingPairs(pair.collider2).add(newPairId);
+}
+
+// Release the memory that is not used by the current pairs
+void OverlappingPairs::shrinkToFit() {
+
+    mConvexPairs.shrinkToFit();
+    mConcavePairs.shrinkToFit();
+    mMapConvexPairIdToPairIndex.shrinkToFit();
+    mMapConcavePairIdToPairIndex.shrinkToFit();
+}
+
+// Return the memory (in bytes) currently used by the pairs
+size_t OverlappingPairs::computeUsedMemory() const {
+    return mConvexPairs.getUsedMemorySize() + mConcavePairs.getUsedMemorySize() +
+           mMapConvexPairIdToPairIndex.getUsedMemorySize() + mMapConcavePairIdToPairIndex.getUsedMemorySize();
+}
+
+// Return the memory usage of the overlapping pairs
+/// The memory allocated by each concave pair for its last frame collision infos is not included.
+MemoryUsage OverlappingPairs::getMemoryUsage() const {
+
+    const size_t reservedMemory = mConvexPairs.getAllocatedMemorySize() + mConcavePairs.getAllocatedMemorySize() +
+                                  mMapConvexPairIdToPairIndex.getAllocatedMemorySize() + mMapConcavePairIdToPairIndex.getAllocatedMemorySize();
+
+    return MemoryUsage(reservedMemory, computeUsedMemory(), mPeakUsedMemory);
+}
+
 // Destructor
 OverlappingPairs::~OverlappingPairs() {
 
@@ -186,6 +274,11 @@ uint64 OverlappingPairs::addPair(uint32 collider1Index, uint32 collider2Index, b
     mColliderComponents.mOverlappingPairs[collider1Index].add(pairId);
     mColliderComponents.mOverlappingPairs[collider2Index].add(pairId);
 
+    const size_t usedMemory = computeUsedMemory();
+    if (usedMemory > mPeakUsedMemory) {
+        mPeakUsedMemory = usedMemory;
+    }
+
     return pairId;
 }
 
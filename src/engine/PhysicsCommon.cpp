@@ -34,9 +34,10 @@ Logger* PhysicsCommon::mLogger = nullptr;
 /// Constructor
 /**
  * @param baseMemoryAllocator Pointer to a user custom memory allocator
+ * @param heapAllocatorType Type of the heap allocator used on top of the base allocator
  */
-PhysicsCommon::PhysicsCommon(MemoryAllocator* baseMemoryAllocator)
-              : mMemoryManager(baseMemoryAllocator),
+PhysicsCommon::PhysicsCommon(MemoryAllocator* baseMemoryAllocator, MemoryManager::HeapAllocatorType heapAllocatorType)
+              : mMemoryManager(baseMemoryAllocator, heapAllocatorType),
                 mPhysicsWorlds(mMemoryManager.getHeapAllocator()), mSphereShapes(mMemoryManager.getHeapAllocator()),
                 mBoxShapes(mMemoryManager.getHeapAllocator()), mCapsuleShapes(mMemoryManager.getHeapAllocator()),
                 mConvexMeshShapes(mMemoryManager.getHeapAllocator()), mConcaveMeshShapes(mMemoryManager.getHeapAllocator()),
@@ -405,6 +406,8 @@ void PhysicsCommon::deleteCapsuleShape(CapsuleShape* capsuleShape) {
                  "Error when destroying the CapsuleShape because it is still used by some colliders",  __FILE__, __LINE__);
     }
 
+   removeShapeFromDebugRenderers(capsuleShape);
+
    // Call the destructor of the shape
    capsuleShape->~CapsuleShape();
 
@@ -451,6 +454,8 @@ void PhysicsCommon::deleteConvexMeshShape(ConvexMeshShape* convexMeshShape) {
                  "Error when destroying the ConvexMeshShape because it is still used by some colliders",  __FILE__, __LINE__);
     }
 
+   removeShapeFromDebugRenderers(convexMeshShape);
+
    // Call the destructor of the shape
    convexMeshShape->~ConvexMeshShape();
 
@@ -506,6 +511,8 @@ void PhysicsCommon::deleteHeightFieldShape(HeightFieldShape* heightFieldShape) {
                  "Error when destroying the HeightFieldShape because it is still used by some colliders",  __FILE__, __LINE__);
     }
 
+   removeShapeFromDebugRenderers(heightFieldShape);
+
    // Call the destructor of the shape
    heightFieldShape->~HeightFieldShape();
 
@@ -553,6 +560,8 @@ void PhysicsCommon::deleteConcaveMeshShape(ConcaveMeshShape* concaveMeshShape) {
                  "Error when destroying the ConcaveMeshShape because it is still used by some colliders",  __FILE__, __LINE__);
     }
 
+   removeShapeFromDebugRenderers(concaveMeshShape);
+
    // Call the destructor of the shape
    concaveMeshShape->~ConcaveMeshShape();
 
@@ -560,6 +569,17 @@ void PhysicsCommon::deleteConcaveMeshShape(ConcaveMeshShape* concaveMeshShape) {
    mMemoryManager.release(MemoryManager::AllocationType::Pool, concaveMeshShape, sizeof(ConcaveMeshShape));
 }
 
+// Remove the cached debug tessellations of a collision shape that is destroyed
+/**
+ * @param collisionShape A pointer to the collision shape that is destroyed
+ */
+void PhysicsCommon::removeShapeFromDebugRenderers(const CollisionShape* collisionShape) {
+
+    for (auto it = mPhysicsWorlds.begin(); it != mPhysicsWorlds.end(); ++it) {
+        (*it)->getDebugRenderer().removeShapeTessellation(collisionShape);
+    }
+}
+
 // Create a polyhedron mesh
 /**
  * @param polygonVertexArray A pointer to the polygon vertex array to use to create the polyhedron mesh
@@ -579,6 +599,70 @@ PolyhedronMesh* PhysicsCommon::createPolyhedronMesh(PolygonVertexArray* polygonV
     return mesh;
 }
 
+// Create a polyhedron mesh from the convex hull of a point cloud
+/// The convex hull is computed with the Quickhull algorithm. The number of vertices and faces
+/// of the hull can be limited in the settings, in which case the hull approximates the point
+/// cloud with the furthest points. The input points are not referenced by the mesh after this call.
+/**
+ * @param points Pointer to the first point (three float or double values per point)
+ * @param nbPoints Number of points
+ * @param pointsStride Number of bytes between the beginning of two consecutive points
+ * @param pointsDataType Data type of the points (float or double)
+ * @param settings Settings of the convex hull computation
+ * @return A pointer to the created polyhedron mesh or nullptr if the points are degenerate
+ */
+PolyhedronMesh* PhysicsCommon::createConvexHullMesh(const void* points, uint32 nbPoints, uint32 pointsStride,
+                                                    PolygonVertexArray::VertexDataType pointsDataType,
+                                                    const QuickHull::Settings& settings) {
+
+    PolyhedronMesh* mesh = PolyhedronMesh::createConvexHull(points, nbPoints, pointsStride, pointsDataType, settings,
+                                                            mMemoryManager.getPoolAllocator(), mMemoryManager.getHeapAllocator());
+
+    // If the mesh is valid
+    if (mesh != nullptr) {
+
+        mPolyhedronMeshes.add(mesh);
+    }
+
+    return mesh;
+}
+
+// Serialize a polyhedron mesh into a cooked binary blob
+/// The cooked data can be saved offline and later be used to create the polyhedron mesh with
+/// the createPolyhedronMeshFromCookedData() method without recomputing its half-edge structure.
+/// Call this method a first time with a null buffer to get the required size of the buffer.
+/**
+ * @param polyhedronMesh A pointer to the polyhedron mesh to cook
+ * @param outData Pointer to the output buffer (aligned on COOKED_MESH_ALIGNMENT bytes) or nullptr
+ * @param outDataSize Size (in bytes) of the output buffer
+ * @return The size (in bytes) of the cooked data
+ */
+size_t PhysicsCommon::cookPolyhedronMesh(const PolyhedronMesh* polyhedronMesh, void* outData, size_t outDataSize) {
+    return polyhedronMesh->cook(outData, outDataSize);
+}
+
+// Create a polyhedron mesh from cooked data
+/// The cooked data is used in place (it can be a memory-mapped file for instance) and must
+/// remain valid during the lifetime of the polyhedron mesh.
+/**
+ * @param cookedData Pointer to the cooked data (aligned on COOKED_MESH_ALIGNMENT bytes)
+ * @param cookedDataSize Size (in bytes) of the cooked data
+ * @return A pointer to the created polyhedron mesh or nullptr if the cooked data is not valid
+ */
+PolyhedronMesh* PhysicsCommon::createPolyhedronMeshFromCookedData(const void* cookedData, size_t cookedDataSize) {
+
+    PolyhedronMesh* mesh = PolyhedronMesh::createFromCookedData(cookedData, cookedDataSize, mMemoryManager.getPoolAllocator(),
+                                                                mMemoryManager.getHeapAllocator());
+
+    // If the mesh is valid
+    if (mesh != nullptr) {
+
+        mPolyhedronMeshes.add(mesh);
+    }
+
+    return mesh;
+}
+
 // Destroy a polyhedron mesh
 /**
  * @param polyhedronMesh A pointer to the polyhedron mesh to destroy
@@ -616,6 +700,44 @@ TriangleMesh* PhysicsCommon::createTriangleMesh() {
     return mesh;
 }
 
+// Serialize a triangle mesh into a cooked binary blob
+/// The cooked data contains the vertices, normals and the BVH of the triangles of the mesh. It
+/// can be saved offline and later be used to create the triangle mesh with the
+/// createTriangleMeshFromCookedData() method. Call this method a first time with a null buffer
+/// to get the required size of the buffer.
+/**
+ * @param triangleMesh A pointer to the triangle mesh to cook
+ * @param outData Pointer to the output buffer (aligned on COOKED_MESH_ALIGNMENT bytes) or nullptr
+ * @param outDataSize Size (in bytes) of the output buffer
+ * @return The size (in bytes) of the cooked data
+ */
+size_t PhysicsCommon::cookTriangleMesh(const TriangleMesh* triangleMesh, void* outData, size_t outDataSize) {
+    return triangleMesh->cook(outData, outDataSize);
+}
+
+// Create a triangle mesh from cooked data
+/// The cooked data is used in place (it can be a memory-mapped file for instance) and must
+/// remain valid during the lifetime of the triangle mesh. A ConcaveMeshShape created with this
+/// mesh uses the cooked BVH instead of building it.
+/**
+ * @param cookedData Pointer to the cooked data (aligned on COOKED_MESH_ALIGNMENT bytes)
+ * @param cookedDataSize Size (in bytes) of the cooked data
+ * @return A pointer to the created triangle mesh or nullptr if the cooked data is not valid
+ */
+TriangleMesh* PhysicsCommon::createTriangleMeshFromCookedData(const void* cookedData, size_t cookedDataSize) {
+
+    TriangleMesh* mesh = TriangleMesh::createFromCookedData(cookedData, cookedDataSize, mMemoryManager.getPoolAllocator(),
+                                                            mMemoryManager.getHeapAllocator());
+
+    // If the mesh is valid
+    if (mesh != nullptr) {
+
+        mTriangleMeshes.add(mesh);
+    }
+
+    return mesh;
+}
+
 // Destroy a triangle mesh
 /**
  * @param A pointer to the triangle mesh to destroy
@@ -640,6 +762,35 @@ void PhysicsCommon::deleteTriangleMesh(TriangleMesh* triangleMesh) {
    mMemoryManager.release(MemoryManager::AllocationType::Pool, triangleMesh, sizeof(TriangleMesh));
 }
 
+// Return the memory usage of the allocator of a given type
+/**
+ * @param allocationType The type of the allocator
+ * @return The memory reserved and used by the allocator with its high-water mark
+ */
+MemoryUsage PhysicsCommon::getMemoryUsage(MemoryManager::AllocationType allocationType) const {
+    return mMemoryManager.getMemoryUsage(allocationType);
+}
+
+// Return the memory usage of the BVH of all the concave mesh shapes
+/**
+ * @return The sum of the memory reserved and used by the BVH of the concave mesh shapes (the
+ *         peak is the sum of the peaks of each BVH)
+ */
+MemoryUsage PhysicsCommon::getConcaveMeshesMemoryUsage() const {
+
+    MemoryUsage memoryUsage;
+
+    for (auto it = mConcaveMeshShapes.begin(); it != mConcaveMeshShapes.end(); ++it) {
+
+        const MemoryUsage treeMemoryUsage = (*it)->mDynamicAABBTree.getMemoryUsage();
+        memoryUsage.reservedBytes += treeMemoryUsage.reservedBytes;
+        memoryUsage.usedBytes += treeMemoryUsage.usedBytes;
+        memoryUsage.peakUsedBytes += treeMemoryUsage.peakUsedBytes;
+    }
+
+    return memoryUsage;
+}
+
 // Create and return a new logger
 /**
  * @return A pointer to the created default logger
@@ -31,6 +31,7 @@
 #include <reactphysics3d/constraint/HingeJoint.h>
 #include <reactphysics3d/constraint/FixedJoint.h>
 #include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/utils/Instrumentation.h>
 #include <reactphysics3d/engine/EventListener.h>
 #include <reactphysics3d/engine/Island.h>
 #include <reactphysics3d/collision/ContactManifold.h>
@@ -62,20 +63,23 @@ PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, PhysicsCommon& physicsC
                 mJointsComponents(mMemoryManager.getHeapAllocator()), mBallAndSocketJointsComponents(mMemoryManager.getHeapAllocator()),
                 mFixedJointsComponents(mMemoryManager.getHeapAllocator()), mHingeJointsComponents(mMemoryManager.getHeapAllocator()),
                 mSliderJointsComponents(mMemoryManager.getHeapAllocator()), mCollisionDetection(this, mCollidersComponents, mTransformComponents, mCollisionBodyComponents, mRigidBodyComponents,
-                                        mMemoryManager, physicsCommon.mTriangleShapeHalfEdgeStructure),
+                                        mMemoryManager),
                 mCollisionBodies(mMemoryManager.getHeapAllocator()), mEventListener(nullptr),
-                mName(worldSettings.worldName),  mIslands(mMemoryManager.getSingleFrameAllocator()), mProcessContactPairsOrderIslands(mMemoryManager.getSingleFrameAllocator()),
+                mName(worldSettings.worldName),  mIslands(mMemoryManager.getSingleFrameAllocator()),
+                mPersistentIslands(mMemoryManager.getHeapAllocator()), mProcessContactPairsOrderIslands(mMemoryManager.getSingleFrameAllocator()),
                 mContactSolverSystem(mMemoryManager, *this, mIslands, mCollisionBodyComponents, mRigidBodyComponents,
                                mCollidersComponents, mConfig.restitutionVelocityThreshold),
                 mConstraintSolverSystem(*this, mIslands, mRigidBodyComponents, mTransformComponents, mJointsComponents,
                                         mBallAndSocketJointsComponents, mFixedJointsComponents, mHingeJointsComponents,
                                         mSliderJointsComponents),
-                mDynamicsSystem(*this, mCollisionBodyComponents, mRigidBodyComponents, mTransformComponents, mCollidersComponents, mIsGravityEnabled, mConfig.gravity),
+                mDynamicsSystem(*this, mMemoryManager.getHeapAllocator(), mCollisionBodyComponents, mRigidBodyComponents, mTransformComponents, mCollidersComponents, mIsGravityEnabled, mConfig.gravity),
                 mNbVelocitySolverIterations(mConfig.defaultVelocitySolverNbIterations),
                 mNbPositionSolverIterations(mConfig.defaultPositionSolverNbIterations), 
                 mIsSleepingEnabled(mConfig.isSleepingEnabled), mRigidBodies(mMemoryManager.getPoolAllocator()),
                 mIsGravityEnabled(true), mSleepLinearVelocity(mConfig.defaultSleepLinearVelocity),
-                mSleepAngularVelocity(mConfig.defaultSleepAngularVelocity), mTimeBeforeSleep(mConfig.defaultTimeBeforeSleep) {
+                mSleepAngularVelocity(mConfig.defaultSleepAngularVelocity), mTimeBeforeSleep(mConfig.defaultTimeBeforeSleep),
+                mIsStepTimingEnabled(false), mNbBroadPhaseUpdatesAtLastStep(0), mNbBroadPhaseReinsertionsAtLastStep(0),
+                mNbStepsSinceBroadPhaseQualityCheck(0) {
 
     // Automatically generate a name for the world
     if (mName == "") {
@@ -106,6 +110,10 @@ PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, PhysicsCommon& physicsC
 
     mNbWorlds++;
 
+    // Reserve memory for the expected number of objects in the world
+    reserve(mConfig.bodiesCapacity, mConfig.collidersCapacity, mConfig.jointsCapacity,
+            mConfig.overlappingPairsCapacity, mConfig.contactsCapacity);
+
     RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
              "Physics World: Physics world " + mName + " has been created",  __FILE__, __LINE__);
     RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
@@ -244,7 +252,10 @@ void PhysicsWorld::setBodyDisabled(Entity bodyEntity, bool isDisabled) {
 
     assert(mRigidBodyComponents.hasComponent(bodyEntity));
 
-    mRigidBodyComponents.setIsEntityDisabled(bodyEntity, isDisabled);
+    // A static body is never integrated and therefore always stays in the disabled
+    // part of the rigid body components
+    const bool isStatic = mRigidBodyComponents.getBodyType(bodyEntity) == BodyType::STATIC;
+    mRigidBodyComponents.setIsEntityDisabled(bodyEntity, isDisabled || isStatic);
 
     // For each collider of the body
     const Array<Entity>& collidersEntities = mCollisionBodyComponents.getColliders(bodyEntity);
@@ -252,9 +263,37 @@ void PhysicsWorld::setBodyDisabled(Entity bodyEntity, bool isDisabled) {
     for (uint32 i=0; i < nbColliderEntities; i++) {
 
         mCollidersComponents.setIsEntityDisabled(collidersEntities[i], isDisabled);
+
+        // If the size of the collision shape has changed while the body was disabled,
+        // we update the collider in the broad-phase now
+        if (!isDisabled && mCollidersComponents.getHasCollisionShapeChangedSize(collidersEntities[i])) {
+            mCollisionDetection.updateCollider(collidersEntities[i]);
+        }
     }
 }
 
+// Update the state of a static body in the rigid body components
+/// A static body is never integrated. Its velocities are kept to zero and its
+/// constrained position and orientation (used by the constraint solvers) are kept
+/// equal to its current center of mass and orientation.
+/**
+ * @param bodyEntity Entity of the rigid body
+ */
+void PhysicsWorld::updateStaticBodyState(Entity bodyEntity) {
+
+    if (mRigidBodyComponents.getBodyType(bodyEntity) != BodyType::STATIC) return;
+
+    const uint32 index = mRigidBodyComponents.getEntityIndex(bodyEntity);
+
+    mRigidBodyComponents.mConstrainedLinearVelocities[index].setToZero();
+    mRigidBodyComponents.mConstrainedAngularVelocities[index].setToZero();
+    mRigidBodyComponents.mSplitLinearVelocities[index].setToZero();
+    mRigidBodyComponents.mSplitAngularVelocities[index].setToZero();
+    mRigidBodyComponents.mInverseInertiaTensorsWorld[index].setToZero();
+    mRigidBodyComponents.mConstrainedPositions[index] = mRigidBodyComponents.mCentersOfMassWorld[index];
+    mRigidBodyComponents.mConstrainedOrientations[index] = mTransformComponents.getTransform(bodyEntity).getOrientation();
+}
+
 // Notify the world whether a joint is disabled or not
 void PhysicsWorld::setJointDisabled(Entity jointEntity, bool isDisabled) {
 
@@ -302,6 +341,25 @@ AABB PhysicsWorld::getWorldAABB(const Collider* collider) const {
    return mCollisionDetection.getWorldAABB(collider);
 }
 
+// Compute the metrics describing the quality of the broad-phase tree
+/// The SAH cost of the tree is compared with the cost of the tree that would be obtained with
+/// rebuildBroadPhaseTree(). The counters of the updates are accumulated since the creation of
+/// the world. The cost of this method is O(n log n) with the number n of colliders.
+DynamicAABBTree::QualityMetrics PhysicsWorld::computeBroadPhaseQualityMetrics() const {
+    return mCollisionDetection.mBroadPhaseSystem.computeTreeQualityMetrics();
+}
+
+// Rebuild the broad-phase tree from scratch
+/// The broad-phase tree degrades over time when the colliders move. It can be automatically
+/// rebuilt with the WorldSettings::broadPhaseRebuildCostRatio setting. This method must not
+/// be called during the update() method.
+void PhysicsWorld::rebuildBroadPhaseTree() {
+
+    RP3D_PROFILE("PhysicsWorld::rebuildBroadPhaseTree()", mProfiler);
+
+    mCollisionDetection.mBroadPhaseSystem.rebuildTree();
+}
+
 // Update the physics simulation
 /**
  * @param timeStep The amount of time to step the simulation by (in seconds)
@@ -314,7 +372,21 @@ void PhysicsWorld::update(decimal timeStep) {
     mProfiler->incrementFrameCounter();
 #endif
 
+#ifdef IS_RP3D_ALLOCATION_TRACING_ENABLED
+
+    // The allocations of the step are recorded in a new frame
+    AllocationTracer::nextFrame();
+#endif
+
     RP3D_PROFILE("PhysicsWorld::update()", mProfiler);
+    RP3D_INSTRUMENT(Step);
+
+    // Start measuring the time of the stages of the step (if enabled)
+    std::chrono::high_resolution_clock::time_point stepStartTime;
+    if (mIsStepTimingEnabled) {
+        stepStartTime = std::chrono::high_resolution_clock::now();
+    }
+    std::chrono::high_resolution_clock::time_point stageStartTime = stepStartTime;
 
     // Reset the debug renderer
     if (mIsDebugRenderingEnabled) {
@@ -324,15 +396,28 @@ void PhysicsWorld::update(decimal timeStep) {
     // Compute the collision detection
     mCollisionDetection.computeCollisionDetection();
 
+    updateCollisionDetectionStats();
+    mLastStepStats.isTimingEnabled = mIsStepTimingEnabled;
+    if (mIsStepTimingEnabled) mLastStepStats.collisionDetectionTime = measureStageTime(stageStartTime);
+
     // Create the islands
     createIslands();
 
+    mLastStepStats.nbIslands = mIslands.getNbIslands();
+
     // Create the actual narrow-phase contacts
     mCollisionDetection.createContacts();
 
+    // The islands that have lost contacts might need to be split
+    markIslandsWithLostContacts();
+
     // Report the contacts to the user
     mCollisionDetection.reportContactsAndTriggers();
 
+    mLastStepStats.nbContactManifolds = static_cast<uint32>(mCollisionDetection.mCurrentContactManifolds->size());
+    mLastStepStats.nbContactPoints = static_cast<uint32>(mCollisionDetection.mCurrentContactPoints->size());
+    if (mIsStepTimingEnabled) mLastStepStats.contactsTime = measureStageTime(stageStartTime);
+
     // Recompute the inverse inertia tensors of rigid bodies
     updateBodiesInverseWorldInertiaTensors();
 
@@ -351,13 +436,29 @@ void PhysicsWorld::update(decimal timeStep) {
     // Solve the position correction for constraints
     solvePositionCorrection();
 
+    mLastStepStats.nbVelocitySolverIterations = mNbVelocitySolverIterations;
+    mLastStepStats.nbPositionSolverIterations = mNbPositionSolverIterations;
+    if (mIsStepTimingEnabled) mLastStepStats.solverTime = measureStageTime(stageStartTime);
+
     // Update the state (positions and velocities) of the bodies
     mDynamicsSystem.updateBodiesState();
 
     // Update the colliders components
-    mCollisionDetection.updateColliders();
+    mCollisionDetection.updateColliders(mDynamicsSystem.getMovedColliders());
+
+    updateBroadPhaseTree();
 
-    if (mIsSleepingEnabled) updateSleepingBodies(timeStep);
+    if (mIsStepTimingEnabled) mLastStepStats.bodiesUpdateTime = measureStageTime(stageStartTime);
+
+    if (mIsSleepingEnabled) {
+        updateSleepingBodies(timeStep);
+    }
+    else {
+        splitDisconnectedIslands();
+    }
+
+    mLastStepStats.nbAwakeBodies = mRigidBodyComponents.getNbEnabledComponents();
+    if (mIsStepTimingEnabled) mLastStepStats.sleepingTime = measureStageTime(stageStartTime);
 
     // Reset the external force and torque applied to the bodies
     mDynamicsSystem.resetBodiesForceAndTorque();
@@ -374,6 +475,77 @@ void PhysicsWorld::update(decimal timeStep) {
 
     // Reset the single frame memory allocator
     mMemoryManager.resetFrameAllocator();
+
+    if (mIsStepTimingEnabled) {
+        mLastStepStats.totalTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - stepStartTime).count();
+    }
+}
+
+// Record the counters of the collision detection in the statistics of the step
+/// This method must be called after the narrow-phase and before the narrow-phase input is cleared.
+void PhysicsWorld::updateCollisionDetectionStats() {
+
+    NarrowPhaseInput& narrowPhaseInput = mCollisionDetection.mNarrowPhaseInput;
+
+    mLastStepStats.nbConvexPairs = static_cast<uint32>(mCollisionDetection.mOverlappingPairs.mConvexPairs.size());
+    mLastStepStats.nbConcavePairs = static_cast<uint32>(mCollisionDetection.mOverlappingPairs.mConcavePairs.size());
+    mLastStepStats.nbMiddlePhaseTriangles = narrowPhaseInput.getNbTriangleTests();
+    mLastStepStats.nbSphereVsSphereTests = narrowPhaseInput.getSphereVsSphereBatch().getNbObjects();
+    mLastStepStats.nbSphereVsCapsuleTests = narrowPhaseInput.getSphereVsCapsuleBatch().getNbObjects();
+    mLastStepStats.nbCapsuleVsCapsuleTests = narrowPhaseInput.getCapsuleVsCapsuleBatch().getNbObjects();
+    mLastStepStats.nbSphereVsConvexPolyhedronTests = narrowPhaseInput.getSphereVsConvexPolyhedronBatch().getNbObjects();
+    mLastStepStats.nbCapsuleVsConvexPolyhedronTests = narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch().getNbObjects();
+    mLastStepStats.nbConvexPolyhedronVsConvexPolyhedronTests = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch().getNbObjects();
+    mLastStepStats.nbContactPairs = static_cast<uint32>(mCollisionDetection.mCurrentContactPairs->size());
+}
+
+// Record the updates of the broad-phase tree and rebuild the tree if its quality is too low
+/// The updates of the colliders done by the user between two steps are also counted. The quality
+/// of the tree is only checked every WorldSettings::broadPhaseQualityCheckInterval steps because
+/// computing the cost of a rebuilt tree is O(n log n) with the number n of colliders.
+void PhysicsWorld::updateBroadPhaseTree() {
+
+    BroadPhaseSystem& broadPhase = mCollisionDetection.mBroadPhaseSystem;
+
+    const uint64 nbUpdates = broadPhase.getNbTreeUpdates();
+    const uint64 nbReinsertions = broadPhase.getNbTreeReinsertions();
+    mLastStepStats.nbBroadPhaseUpdates = static_cast<uint32>(nbUpdates - mNbBroadPhaseUpdatesAtLastStep);
+    mLastStepStats.nbBroadPhaseReinsertions = static_cast<uint32>(nbReinsertions - mNbBroadPhaseReinsertionsAtLastStep);
+    mNbBroadPhaseUpdatesAtLastStep = nbUpdates;
+    mNbBroadPhaseReinsertionsAtLastStep = nbReinsertions;
+    mLastStepStats.isBroadPhaseTreeRebuilt = false;
+
+    // If the automatic rebuild of the tree is disabled
+    if (mConfig.broadPhaseRebuildCostRatio <= decimal(0.0)) return;
+
+    mNbStepsSinceBroadPhaseQualityCheck++;
+    if (mNbStepsSinceBroadPhaseQualityCheck < mConfig.broadPhaseQualityCheckInterval) return;
+    mNbStepsSinceBroadPhaseQualityCheck = 0;
+
+    const DynamicAABBTree::QualityMetrics metrics = broadPhase.computeTreeQualityMetrics();
+    if (metrics.sahCostRatio > mConfig.broadPhaseRebuildCostRatio) {
+
+        broadPhase.rebuildTree();
+        mLastStepStats.isBroadPhaseTreeRebuilt = true;
+
+        RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
+                 "Physics World: Broad-phase tree rebuilt (SAH cost " + std::to_string(metrics.sahCost) +
+                 ", rebuilt cost " + std::to_string(metrics.rebuiltSahCost) + ")",  __FILE__, __LINE__);
+    }
+}
+
+// Return the time elapsed since the start of a stage of the step (in milliseconds) and start the next stage
+/**
+ * @param stageStartTime The start time of the current stage. It is set to the current time.
+ * @return The duration of the stage (in milliseconds)
+ */
+double PhysicsWorld::measureStageTime(std::chrono::high_resolution_clock::time_point& stageStartTime) const {
+
+    const std::chrono::high_resolution_clock::time_point currentTime = std::chrono::high_resolution_clock::now();
+    const double stageTime = std::chrono::duration<double, std::milli>(currentTime - stageStartTime).count();
+    stageStartTime = currentTime;
+
+    return stageTime;
 }
 
 // Update the world inverse inertia tensors of rigid bodies
@@ -496,6 +668,9 @@ RigidBody* PhysicsWorld::createRigidBody(const Transform& transform) {
     // Compute the inverse mass
     mRigidBodyComponents.setMassInverse(entity, decimal(1.0) / mRigidBodyComponents.getMass(entity));
 
+    // Add the body into its own island
+    addBodyToNewIsland(entity);
+
     // Add the rigid body to the physics world
     mRigidBodies.add(rigidBody);
 
@@ -529,6 +704,9 @@ void PhysicsWorld::destroyRigidBody(RigidBody* rigidBody) {
         destroyJoint(mJointsComponents.getJoint(joints[0]));
     }
 
+    // Remove the body from its island
+    removeBodyFromIsland(rigidBody->getEntity());
+
     // Destroy the corresponding entity and its components
     mCollisionBodyComponents.removeComponent(rigidBody->getEntity());
     mRigidBodyComponents.removeComponent(rigidBody->getEntity());
@@ -557,8 +735,8 @@ Joint* PhysicsWorld::createJoint(const JointInfo& jointInfo) {
 
     Joint* newJoint = nullptr;
 
-    const bool isJointDisabled = mRigidBodyComponents.getIsEntityDisabled(jointInfo.body1->getEntity()) &&
-                                 mRigidBodyComponents.getIsEntityDisabled(jointInfo.body2->getEntity());
+    const bool isJointDisabled = mCollisionBodyComponents.getIsEntityDisabled(jointInfo.body1->getEntity()) &&
+                                 mCollisionBodyComponents.getIsEntityDisabled(jointInfo.body2->getEntity());
 
     // Allocate memory to create the new joint
     switch(jointInfo.type) {
@@ -665,6 +843,13 @@ Joint* PhysicsWorld::createJoint(const JointInfo& jointInfo) {
     // Add the joint into the joint array of the bodies involved in the joint
     addJointToBodies(jointInfo.body1->getEntity(), jointInfo.body2->getEntity(), entity);
 
+    // Merge the islands of the two bodies (if they are not static)
+    const uint32 island1Index = mRigidBodyComponents.getIslandId(jointInfo.body1->getEntity());
+    const uint32 island2Index = mRigidBodyComponents.getIslandId(jointInfo.body2->getEntity());
+    if (island1Index != NO_ISLAND && island2Index != NO_ISLAND && island1Index != island2Index) {
+        mergeIslands(island1Index, island2Index);
+    }
+
     // Return the pointer to the created joint
     return newJoint;
 }
@@ -698,6 +883,10 @@ void PhysicsWorld::destroyJoint(Joint* joint) {
     mRigidBodyComponents.removeJointFromBody(body1->getEntity(), joint->getEntity());
     mRigidBodyComponents.removeJointFromBody(body2->getEntity(), joint->getEntity());
 
+    // The island of the two bodies might need to be split
+    markIslandAsSplitCandidate(body1->getEntity());
+    markIslandAsSplitCandidate(body2->getEntity());
+
     size_t nbBytes = joint->getSizeInBytes();
 
     Entity jointEntity = joint->getEntity();
@@ -725,6 +914,125 @@ void PhysicsWorld::destroyJoint(Joint* joint) {
     mMemoryManager.release(MemoryManager::AllocationType::Pool, joint, nbBytes);
 }
 
+// Reserve memory for a given number of bodies, colliders, joints, overlapping pairs and contacts
+/// This method can be called before loading a level in order to avoid the reallocations
+/// of the internal arrays while the bodies, colliders and joints are created. The memory
+/// that is already allocated is never released by this method.
+/**
+ * @param nbBodies The expected number of bodies in the world
+ * @param nbColliders The expected number of colliders in the world
+ * @param nbJoints The expected number of joints in the world
+ * @param nbOverlappingPairs The expected number of overlapping pairs in the broad-phase
+ * @param nbContacts The expected number of contact points per frame
+ */
+void PhysicsWorld::reserve(uint32 nbBodies, uint32 nbColliders, uint32 nbJoints, uint32 nbOverlappingPairs, uint32 nbContacts) {
+
+    // Each body, collider and joint is an entity
+    mEntityManager.reserve(nbBodies + nbColliders + nbJoints);
+
+    mCollisionBodyComponents.reserve(nbBodies);
+    mRigidBodyComponents.reserve(nbBodies);
+    mTransformComponents.reserve(nbBodies);
+    mCollisionBodies.reserve(nbBodies);
+    mRigidBodies.reserve(nbBodies);
+
+    mCollidersComponents.reserve(nbColliders);
+    mDynamicsSystem.reserve(nbColliders);
+
+    mJointsComponents.reserve(nbJoints);
+
+    mCollisionDetection.reserve(nbColliders, nbOverlappingPairs, nbContacts);
+
+    RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
+             "Physics World: Reserve memory for " + std::to_string(nbBodies) + " bodies, " + std::to_string(nbColliders) +
+             " colliders, " + std::to_string(nbJoints) + " joints, " + std::to_string(nbOverlappingPairs) + " overlapping pairs and " +
+             std::to_string(nbContacts) + " contacts",  __FILE__, __LINE__);
+}
+
+// Release the memory that is not used anymore and reorder the components for locality
+/// The memory of the world only grows during the simulation. This method can be called after
+/// the destruction of many bodies (between two calls to update()) to shrink the components,
+/// the broad-phase tree, the overlapping pairs and the contacts to their current size. The
+/// components of the colliders are also sorted in the order of the broad-phase tree and the
+/// components of the bodies in the order of their colliders so that the bodies that are close
+/// in space are also close in memory. The cost of this method is linear in the number of bodies
+/// and colliders of the world and the broad-phase IDs of the colliders change.
+void PhysicsWorld::compact() {
+
+    RP3D_PROFILE("PhysicsWorld::compact()", mProfiler);
+
+    const MemoryUsage previousMemoryUsage = getMemoryUsage().getTotal();
+
+    // Compact the broad-phase tree (in depth-first order), the overlapping pairs and the contacts
+    mCollisionDetection.compact();
+
+    // Sort the colliders in the order of the broad-phase tree
+    Array<Entity> colliders(mMemoryManager.getHeapAllocator(), mCollidersComponents.getNbComponents());
+    mCollisionDetection.mBroadPhaseSystem.getCollidersInTreeOrder(colliders);
+    mCollidersComponents.sortComponents(colliders);
+
+    // Sort the bodies in the order of their first collider
+    Array<Entity> bodies(mMemoryManager.getHeapAllocator(), mCollisionBodyComponents.getNbComponents());
+    Set<Entity> sortedBodies(mMemoryManager.getHeapAllocator(), mCollisionBodyComponents.getNbComponents());
+    for (uint64 i=0; i < colliders.size(); i++) {
+
+        const Entity bodyEntity = mCollidersComponents.getBody(colliders[i]);
+        if (!sortedBodies.contains(bodyEntity)) {
+            sortedBodies.add(bodyEntity);
+            bodies.add(bodyEntity);
+        }
+    }
+    mCollisionBodyComponents.sortComponents(bodies);
+    mRigidBodyComponents.sortComponents(bodies);
+    mTransformComponents.sortComponents(bodies);
+
+    // Release the memory of the components that is not used
+    mCollisionBodyComponents.shrinkToFit();
+    mRigidBodyComponents.shrinkToFit();
+    mTransformComponents.shrinkToFit();
+    mCollidersComponents.shrinkToFit();
+    mJointsComponents.shrinkToFit();
+    mBallAndSocketJointsComponents.shrinkToFit();
+    mFixedJointsComponents.shrinkToFit();
+    mHingeJointsComponents.shrinkToFit();
+    mSliderJointsComponents.shrinkToFit();
+
+    mCollisionBodies.shrinkToFit();
+    mRigidBodies.shrinkToFit();
+
+    const MemoryUsage memoryUsage = getMemoryUsage().getTotal();
+
+    RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
+             "Physics World: Compact the world (reserved memory from " + std::to_string(previousMemoryUsage.reservedBytes) +
+             " to " + std::to_string(memoryUsage.reservedBytes) + " bytes)",  __FILE__, __LINE__);
+}
+
+// Return the memory usage of the world
+/**
+ * @return The memory reserved and used by the components, the broad-phase, the overlapping pairs
+ *         and the contacts of the world, with their high-water marks
+ */
+PhysicsWorld::WorldMemoryUsage PhysicsWorld::getMemoryUsage() const {
+
+    WorldMemoryUsage memoryUsage;
+
+    const Components* components[] = {&mCollisionBodyComponents, &mRigidBodyComponents, &mTransformComponents,
+                                      &mCollidersComponents, &mJointsComponents, &mBallAndSocketJointsComponents,
+                                      &mFixedJointsComponents, &mHingeJointsComponents, &mSliderJointsComponents};
+    for (const Components* component : components) {
+
+        const MemoryUsage componentsMemoryUsage = component->getMemoryUsage();
+        memoryUsage.components.reservedBytes += componentsMemoryUsage.reservedBytes;
+        memoryUsage.components.usedBytes += componentsMemoryUsage.usedBytes;
+        memoryUsage.components.peakUsedBytes += componentsMemoryUsage.peakUsedBytes;
+    }
+
+    memoryUsage.broadPhase = mCollisionDetection.getBroadPhaseMemoryUsage();
+    memoryUsage.overlappingPairs = mCollisionDetection.getOverlappingPairsMemoryUsage();
+    memoryUsage.contacts = mCollisionDetection.getContactsMemoryUsage();
+
+    return memoryUsage;
+}
 
 // Set the number of iterations for the velocity constraint solver
 /**
@@ -757,186 +1065,172 @@ void PhysicsWorld::addJointToBodies(Entity body1, Entity body2, Entity joint) {
 /// the contact manifolds and contact points of the same island
 /// to be packed together into linear arrays of manifolds and contacts for better caching.
 /// An island is an isolated group of rigid bodies that have constraints (joints or contacts)
-/// between each other. This method computes the islands at each time step as follows: For each
-/// awake rigid body, we run a Depth First Search (DFS) through the constraint graph of that body
-/// (graph where nodes are the bodies and where the edges are the constraints between the bodies) to
-/// find all the bodies that are connected with it (the bodies that share joints or contacts with
-/// it). Then, we create an island with this group of connected bodies.
+/// between each other. The islands are persistent across frames: each non-static body always
+/// belongs to a persistent island. Here, we merge the persistent islands of the bodies that
+/// are in contact, then we create an island of the current frame for each persistent island
+/// that contains an awake body. Islands are never split here. They are split lazily when some
+/// of their bodies are ready to go to sleep (see updateSleepingBodies()) or at the end of each
+/// step when the sleeping is disabled (see splitDisconnectedIslands()).
 void PhysicsWorld::createIslands() {
 
     RP3D_PROFILE("PhysicsWorld::createIslands()", mProfiler);
+    RP3D_INSTRUMENT(Islands);
 
     assert(mProcessContactPairsOrderIslands.size() == 0);
 
-    // Reset all the isAlreadyInIsland variables of bodies and joints
-    const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbComponents();
-    for (uint32 b=0; b < nbRigidBodyComponents; b++) {
-        mRigidBodyComponents.mIsAlreadyInIsland[b] = false;
-    }
-    const uint32 nbJointsComponents = mJointsComponents.getNbComponents();
-    for (uint32 i=0; i < nbJointsComponents; i++) {
-        mJointsComponents.mIsAlreadyInIsland[i] = false;
-    }
-
     // Reserve memory for the islands
     mIslands.reserveMemory();
 
-    // Create a stack for the bodies to visit during the Depth First Search
-    Stack<Entity> bodyEntitiesToVisit(mMemoryManager.getSingleFrameAllocator(), mIslands.getNbMaxBodiesInIslandPreviousFrame());
+    MemoryAllocator& allocator = mMemoryManager.getSingleFrameAllocator();
 
-    // Array of static bodies added to the current island (used to reset the isAlreadyInIsland variable of static bodies)
-    Array<Entity> staticBodiesAddedToIsland(mMemoryManager.getSingleFrameAllocator(), 16);
+    Array<ContactPair>& contactPairs = *(mCollisionDetection.mCurrentContactPairs);
+    const uint32 nbContactPairs = static_cast<uint32>(contactPairs.size());
 
-    uint32 nbTotalManifolds = 0;
+    // Indices of the contact pairs between two rigid bodies that have to be solved and, for each
+    // of those pairs, the entity of a non-static body of the pair
+    Array<uint32> islandContactPairs(allocator, nbContactPairs);
+    Array<Entity> islandContactPairsBodies(allocator, nbContactPairs);
 
-    // For each rigid body component
-    for (uint32 b=0; b < mRigidBodyComponents.getNbEnabledComponents(); b++) {
-
-        // If the body has already been added to an island, we go to the next body
-        if (mRigidBodyComponents.mIsAlreadyInIsland[b]) continue;
+    // For each contact pair
+    for (uint32 p=0; p < nbContactPairs; p++) {
 
-        // If the body is static, we go to the next body
-        if (mRigidBodyComponents.mBodyTypes[b] == BodyType::STATIC) continue;
+        ContactPair& pair = contactPairs[p];
 
-        // Reset the stack of bodies to visit
-        bodyEntitiesToVisit.clear();
+        // Triggers do not generate contacts
+        if (pair.isTrigger) continue;
 
-        // Add the body into the stack of bodies to visit
-        mRigidBodyComponents.mIsAlreadyInIsland[b] = true;
-        bodyEntitiesToVisit.push(mRigidBodyComponents.mBodiesEntities[b]);
-
-        // Create the new island
-        uint32 islandIndex = mIslands.addIsland(nbTotalManifolds);
-
-        // While there are still some bodies to visit in the stack
-        while (bodyEntitiesToVisit.size() > 0) {
-
-            // Get the body entity
-            const Entity bodyToVisitEntity = bodyEntitiesToVisit.pop();
-
-            // Add the body into the island
-            mIslands.addBodyToIsland(bodyToVisitEntity);
-
-            RigidBody* rigidBodyToVisit = mRigidBodyComponents.getRigidBody(bodyToVisitEntity);
-
-            // Awake the body if it is sleeping (note that this called might change the body index in the mRigidBodyComponents array)
-            rigidBodyToVisit->setIsSleeping(false);
-
-            // Compute the body index in the array (Note that it could have changed because of the previous call to rigidBodyToVisit->setIsSleeping(false))
-            const uint32 bodyToVisitIndex = mRigidBodyComponents.getEntityIndex(bodyToVisitEntity);
+        // If one of the two bodies is a CollisionBody (and not a RigidBody)
+        uint32 body1Index, body2Index;
+        if (!mRigidBodyComponents.hasComponentGetIndex(pair.body1Entity, body1Index) ||
+            !mRigidBodyComponents.hasComponentGetIndex(pair.body2Entity, body2Index)) {
+            continue;
+        }
 
-            // If the current body is static, we do not want to perform the DFS search across that body
-            if (mRigidBodyComponents.mBodyTypes[bodyToVisitIndex] == BodyType::STATIC) {
+        const uint32 island1Index = mRigidBodyComponents.mIslandIds[body1Index];
+        const uint32 island2Index = mRigidBodyComponents.mIslandIds[body2Index];
 
-                staticBodiesAddedToIsland.add(bodyToVisitEntity);
+        // Static bodies do not belong to any island
+        if (island1Index == NO_ISLAND && island2Index == NO_ISLAND) continue;
 
-                // Go to the next body
-                continue;
-            }
+        assert(pair.nbPotentialContactManifolds > 0);
 
-            // If the body is involved in contacts with other bodies
-            // For each contact pair in which the current body is involded
-            const uint32 nbBodyContactPairs = static_cast<uint32>(mRigidBodyComponents.mContactPairs[bodyToVisitIndex].size());
-            for (uint32 p=0; p < nbBodyContactPairs; p++) {
+        islandContactPairs.add(p);
+        islandContactPairsBodies.add(island1Index != NO_ISLAND ? pair.body1Entity : pair.body2Entity);
 
-                const uint32 contactPairIndex = mRigidBodyComponents.mContactPairs[bodyToVisitIndex][p];
-                ContactPair& pair = (*mCollisionDetection.mCurrentContactPairs)[contactPairIndex];
+        // If the two bodies are not static and not in the same island yet, we merge their islands
+        if (island1Index != NO_ISLAND && island2Index != NO_ISLAND && island1Index != island2Index) {
+            mergeIslands(island1Index, island2Index);
+        }
+    }
 
-                // Check if the current contact pair has already been added into an island
-                if (pair.isAlreadyInIsland) continue;
+    // For each enabled rigid body component (note that the number of enabled components
+    // might increase during the loop because sleeping bodies are awaken)
+    for (uint32 b=0; b < mRigidBodyComponents.getNbEnabledComponents(); b++) {
 
-                const Entity otherBodyEntity = pair.body1Entity == bodyToVisitEntity ? pair.body2Entity : pair.body1Entity;
+        const uint32 persistentIslandIndex = mRigidBodyComponents.mIslandIds[b];
 
-                // If the colliding body is a RigidBody (and not a CollisionBody) and is not a trigger
-                uint32 otherBodyIndex;
-                if (mRigidBodyComponents.hasComponentGetIndex(otherBodyEntity, otherBodyIndex)
-                    && !mCollidersComponents.getIsTrigger(pair.collider1Entity) && !mCollidersComponents.getIsTrigger(pair.collider2Entity)) {
+        // If the body is static, we go to the next body
+        if (persistentIslandIndex == NO_ISLAND) continue;
 
-                    mProcessContactPairsOrderIslands.add(contactPairIndex);
+        // If the island of the body has already been added for this frame, we go to the next body
+        if (mPersistentIslands.islands[persistentIslandIndex].frameIslandIndex != NO_ISLAND) continue;
 
-                    assert(pair.nbPotentialContactManifolds > 0);
-                    nbTotalManifolds += pair.nbPotentialContactManifolds;
+        // Create the island of the current frame
+        const uint32 islandIndex = mIslands.addIsland(0, persistentIslandIndex);
+        mPersistentIslands.islands[persistentIslandIndex].frameIslandIndex = islandIndex;
 
-                    // Add the contact manifold into the island
-                    mIslands.nbContactManifolds[islandIndex] += pair.nbPotentialContactManifolds;
-                    pair.isAlreadyInIsland = true;
+        // For each body of the persistent island
+        const Array<Entity>& islandBodies = mPersistentIslands.islands[persistentIslandIndex].bodyEntities;
+        const uint32 nbIslandBodies = static_cast<uint32>(islandBodies.size());
+        for (uint32 i=0; i < nbIslandBodies; i++) {
 
-                    // Check if the other body has already been added to the island
-                    if (mRigidBodyComponents.mIsAlreadyInIsland[otherBodyIndex]) continue;
+            RigidBody* body = mRigidBodyComponents.getRigidBody(islandBodies[i]);
 
-                    // Insert the other body into the stack of bodies to visit
-                    bodyEntitiesToVisit.push(otherBodyEntity);
-                    mRigidBodyComponents.mIsAlreadyInIsland[otherBodyIndex] = true;
-                }
-                else {
+            // Inactive bodies are not simulated
+            if (!body->isActive()) continue;
 
-                    // Add the contact pair index in the array of contact pairs that won't be part of islands
-                    pair.isAlreadyInIsland = true;
-                }
-            }
+            // Add the body into the island
+            mIslands.addBodyToIsland(islandBodies[i]);
 
-            // For each joint in which the current body is involved
-            const Array<Entity>& joints = mRigidBodyComponents.getJoints(rigidBodyToVisit->getEntity());
-            const uint32 nbBodyJoints = static_cast<uint32>(joints.size());
-            for (uint32 i=0; i < nbBodyJoints; i++) {
+            // Awake the body if it is sleeping (note that this call might change the body index in the mRigidBodyComponents array)
+            body->setIsSleeping(false);
+        }
+    }
 
-                const uint32 jointComponentIndex = mJointsComponents.getEntityIndex(joints[i]);
+    const uint32 nbIslands = mIslands.getNbIslands();
+    const uint32 nbIslandContactPairs = static_cast<uint32>(islandContactPairs.size());
 
-                // Check if the current joint has already been added into an island
-                if (mJointsComponents.mIsAlreadyInIsland[jointComponentIndex]) continue;
+    // For each island, number of contact pairs in the island
+    Array<uint32> islandsPairsIndices(allocator, nbIslands);
+    islandsPairsIndices.addWithoutInit(nbIslands);
+    for (uint32 i=0; i < nbIslands; i++) {
+        islandsPairsIndices[i] = 0;
+    }
 
-                // Add the joint into the island
-                mJointsComponents.mIsAlreadyInIsland[jointComponentIndex] = true;
+    // Compute the island of each contact pair and count the contact manifolds of each island
+    Array<uint32> contactPairsIslands(allocator, nbIslandContactPairs);
+    for (uint32 p=0; p < nbIslandContactPairs; p++) {
 
-                const Entity body1Entity = mJointsComponents.mBody1Entities[jointComponentIndex];
-                const Entity body2Entity = mJointsComponents.mBody2Entities[jointComponentIndex];
-                const Entity otherBodyEntity = body1Entity == bodyToVisitEntity ? body2Entity : body1Entity;
+        const uint32 persistentIslandIndex = mRigidBodyComponents.getIslandId(islandContactPairsBodies[p]);
+        const uint32 islandIndex = mPersistentIslands.islands[persistentIslandIndex].frameIslandIndex;
+        assert(islandIndex != NO_ISLAND);
 
-                const uint32 otherBodyIndex = mRigidBodyComponents.getEntityIndex(otherBodyEntity);
+        const ContactPair& pair = contactPairs[islandContactPairs[p]];
+        mIslands.nbContactManifolds[islandIndex] += pair.nbPotentialContactManifolds;
+        islandsPairsIndices[islandIndex]++;
+        contactPairsIslands.add(islandIndex);
+    }
 
-                // Check if the other body has already been added to the island
-                if (mRigidBodyComponents.mIsAlreadyInIsland[otherBodyIndex]) continue;
+    // Compute the start index of the contact manifolds and contact pairs of each island
+    uint32 nbTotalManifolds = 0;
+    uint32 nbTotalPairs = 0;
+    for (uint32 i=0; i < nbIslands; i++) {
 
-                // Insert the other body into the stack of bodies to visit
-                bodyEntitiesToVisit.push(otherBodyEntity);
-                mRigidBodyComponents.mIsAlreadyInIsland[otherBodyIndex] = true;
-            }
-        }
+        mIslands.contactManifoldsIndices[i] = nbTotalManifolds;
+        nbTotalManifolds += mIslands.nbContactManifolds[i];
 
-        // Reset the isAlreadyIsland variable of the static bodies so that they
-        // can also be included in the other islands
-        const uint32 nbStaticBodiesAddedToIsland = static_cast<uint32>(staticBodiesAddedToIsland.size());
-        for (uint32 j=0; j < nbStaticBodiesAddedToIsland; j++) {
+        const uint32 nbIslandPairs = islandsPairsIndices[i];
+        islandsPairsIndices[i] = nbTotalPairs;
+        nbTotalPairs += nbIslandPairs;
+    }
 
-            assert(mRigidBodyComponents.getBodyType(staticBodiesAddedToIsland[j]) == BodyType::STATIC);
-            mRigidBodyComponents.setIsAlreadyInIsland(staticBodiesAddedToIsland[j], false);
-        }
+    // Sort the contact pairs by island
+    mProcessContactPairsOrderIslands.addWithoutInit(nbIslandContactPairs);
+    for (uint32 p=0; p < nbIslandContactPairs; p++) {
 
-        staticBodiesAddedToIsland.clear();
+        const uint32 islandIndex = contactPairsIslands[p];
+        mProcessContactPairsOrderIslands[islandsPairsIndices[islandIndex]] = islandContactPairs[p];
+        islandsPairsIndices[islandIndex]++;
     }
 
-    // Clear the associated contacts pairs of rigid bodies
-    const uint32 nbRigidBodyEnabledComponents = mRigidBodyComponents.getNbEnabledComponents();
-    for (uint32 b=0; b < nbRigidBodyEnabledComponents; b++) {
-        mRigidBodyComponents.mContactPairs[b].clear();
+    // Reset the frame island index of the persistent islands
+    for (uint32 i=0; i < nbIslands; i++) {
+        mPersistentIslands.islands[mIslands.persistentIslandIndices[i]].frameIslandIndex = NO_ISLAND;
     }
 }
 
 // Put bodies to sleep if needed.
 /// For each island, if all the bodies have been almost still for a long enough period of
-/// time, we put all the bodies of the island to sleep.
+/// time, we put all the bodies of the island to sleep. If only some bodies of an island
+/// are ready to sleep and a contact or a joint has been removed from the island, we split
+/// the island into its connected groups of bodies and put to sleep the groups that are ready.
 void PhysicsWorld::updateSleepingBodies(decimal timeStep) {
 
     RP3D_PROFILE("PhysicsWorld::updateSleepingBodies()", mProfiler);
+    RP3D_INSTRUMENT(Sleeping);
 
     const decimal sleepLinearVelocitySquare = mSleepLinearVelocity * mSleepLinearVelocity;
     const decimal sleepAngularVelocitySquare = mSleepAngularVelocity * mSleepAngularVelocity;
 
+    // Persistent islands that have to be split
+    Array<uint32> islandsToSplit(mMemoryManager.getSingleFrameAllocator());
+
     // For each island of the world
     const uint32 nbIslands = mIslands.getNbIslands();
     for (uint32 i=0; i < nbIslands; i++) {
 
         decimal minSleepTime = DECIMAL_LARGEST;
+        bool isBodyReadyToSleep = false;
 
         // For each body of the island
         for (uint32 b=0; b < mIslands.nbBodiesInIsland[i]; b++) {
@@ -963,6 +1257,9 @@ void PhysicsWorld::updateSleepingBodies(decimal timeStep) {
                 if (mRigidBodyComponents.mSleepTimes[bodyIndex] < minSleepTime) {
                     minSleepTime = mRigidBodyComponents.mSleepTimes[bodyIndex];
                 }
+                if (mRigidBodyComponents.mSleepTimes[bodyIndex] >= mTimeBeforeSleep) {
+                    isBodyReadyToSleep = true;
+                }
             }
         }
 
@@ -979,6 +1276,302 @@ void PhysicsWorld::updateSleepingBodies(decimal timeStep) {
                 body->setIsSleeping(true);
             }
         }
+        else if (isBodyReadyToSleep) {
+
+            // If some constraints have been removed from the island, the bodies that
+            // are ready to sleep might not be connected anymore to the other ones
+            const uint32 persistentIslandIndex = mIslands.persistentIslandIndices[i];
+            if (mPersistentIslands.islands[persistentIslandIndex].isSplitCandidate) {
+                islandsToSplit.add(persistentIslandIndex);
+            }
+        }
+    }
+
+    if (islandsToSplit.size() == 0) return;
+
+    // Split the islands
+    Array<uint32> newIslands(mMemoryManager.getSingleFrameAllocator());
+    splitIslands(islandsToSplit, newIslands);
+
+    // For each island resulting from the split
+    const uint32 nbNewIslands = static_cast<uint32>(newIslands.size());
+    for (uint32 i=0; i < nbNewIslands; i++) {
+
+        const Array<Entity>& islandBodies = mPersistentIslands.islands[newIslands[i]].bodyEntities;
+        const uint32 nbIslandBodies = static_cast<uint32>(islandBodies.size());
+
+        // Check if all the active bodies of the island are ready to sleep
+        bool isIslandReadyToSleep = true;
+        for (uint32 b=0; b < nbIslandBodies; b++) {
+
+            const uint32 bodyIndex = mRigidBodyComponents.getEntityIndex(islandBodies[b]);
+
+            if (!mRigidBodyComponents.mRigidBodies[bodyIndex]->isActive()) continue;
+
+            if (mRigidBodyComponents.mSleepTimes[bodyIndex] < mTimeBeforeSleep) {
+                isIslandReadyToSleep = false;
+                break;
+            }
+        }
+
+        if (isIslandReadyToSleep) {
+
+            // Put all the bodies of the island to sleep
+            for (uint32 b=0; b < nbIslandBodies; b++) {
+                mRigidBodyComponents.getRigidBody(islandBodies[b])->setIsSleeping(true);
+            }
+        }
+    }
+}
+
+// Split the islands of the current frame that might not be connected anymore (when sleeping is disabled)
+/// When the sleeping is enabled, the islands are split lazily in updateSleepingBodies(). Without
+/// sleeping, an island from which a contact or a joint has been removed is split right away.
+/// Otherwise, the islands would only be merged and would grow without bound.
+void PhysicsWorld::splitDisconnectedIslands() {
+
+    // Persistent islands that have to be split
+    Array<uint32> islandsToSplit(mMemoryManager.getSingleFrameAllocator());
+
+    const uint32 nbIslands = mIslands.getNbIslands();
+    for (uint32 i=0; i < nbIslands; i++) {
+
+        const uint32 persistentIslandIndex = mIslands.persistentIslandIndices[i];
+        if (mPersistentIslands.islands[persistentIslandIndex].isSplitCandidate) {
+            islandsToSplit.add(persistentIslandIndex);
+        }
+    }
+
+    if (islandsToSplit.size() == 0) return;
+
+    Array<uint32> newIslands(mMemoryManager.getSingleFrameAllocator());
+    splitIslands(islandsToSplit, newIslands);
+}
+
+// Add a non-static body into a new persistent island
+/// The new island is merged with the islands of the bodies connected to this body by a joint.
+void PhysicsWorld::addBodyToNewIsland(Entity bodyEntity) {
+
+    assert(mRigidBodyComponents.getBodyType(bodyEntity) != BodyType::STATIC);
+    assert(mRigidBodyComponents.getIslandId(bodyEntity) == NO_ISLAND);
+
+    uint32 islandIndex = mPersistentIslands.createIsland();
+    mPersistentIslands.islands[islandIndex].bodyEntities.add(bodyEntity);
+    mRigidBodyComponents.setIslandId(bodyEntity, islandIndex);
+
+    // For each joint of the body
+    const Array<Entity>& joints = mRigidBodyComponents.getJoints(bodyEntity);
+    const uint32 nbJoints = static_cast<uint32>(joints.size());
+    for (uint32 i=0; i < nbJoints; i++) {
+
+        const uint32 jointIndex = mJointsComponents.getEntityIndex(joints[i]);
+        const Entity body1Entity = mJointsComponents.mBody1Entities[jointIndex];
+        const Entity otherBodyEntity = body1Entity == bodyEntity ? mJointsComponents.mBody2Entities[jointIndex] : body1Entity;
+
+        const uint32 otherIslandIndex = mRigidBodyComponents.getIslandId(otherBodyEntity);
+        if (otherIslandIndex != NO_ISLAND && otherIslandIndex != islandIndex) {
+            islandIndex = mergeIslands(islandIndex, otherIslandIndex);
+        }
+    }
+}
+
+// Remove a body from its persistent island
+void PhysicsWorld::removeBodyFromIsland(Entity bodyEntity) {
+
+    const uint32 islandIndex = mRigidBodyComponents.getIslandId(bodyEntity);
+    if (islandIndex == NO_ISLAND) return;
+
+    PersistentIslands::Island& island = mPersistentIslands.islands[islandIndex];
+    island.bodyEntities.remove(bodyEntity);
+    mRigidBodyComponents.setIslandId(bodyEntity, NO_ISLAND);
+
+    if (island.bodyEntities.size() == 0) {
+        mPersistentIslands.destroyIsland(islandIndex);
+    }
+    else {
+
+        // The remaining bodies might not be connected anymore
+        island.isSplitCandidate = true;
+    }
+}
+
+// Merge two persistent islands and return the index of the resulting island
+/// The bodies of the smallest island are moved into the largest one.
+uint32 PhysicsWorld::mergeIslands(uint32 islandIndex1, uint32 islandIndex2) {
+
+    assert(islandIndex1 != islandIndex2);
+
+    if (mPersistentIslands.islands[islandIndex1].bodyEntities.size() < mPersistentIslands.islands[islandIndex2].bodyEntities.size()) {
+        const uint32 tmpIslandIndex = islandIndex1;
+        islandIndex1 = islandIndex2;
+        islandIndex2 = tmpIslandIndex;
+    }
+
+    PersistentIslands::Island& island1 = mPersistentIslands.islands[islandIndex1];
+    PersistentIslands::Island& island2 = mPersistentIslands.islands[islandIndex2];
+
+    // Move the bodies of the second island into the first one
+    const uint32 nbBodies = static_cast<uint32>(island2.bodyEntities.size());
+    for (uint32 b=0; b < nbBodies; b++) {
+        mRigidBodyComponents.setIslandId(island2.bodyEntities[b], islandIndex1);
+        island1.bodyEntities.add(island2.bodyEntities[b]);
+    }
+
+    island1.isSplitCandidate = island1.isSplitCandidate || island2.isSplitCandidate;
+
+    mPersistentIslands.destroyIsland(islandIndex2);
+
+    return islandIndex1;
+}
+
+// Mark the persistent island of a body as a candidate for splitting
+void PhysicsWorld::markIslandAsSplitCandidate(Entity bodyEntity) {
+
+    uint32 bodyIndex;
+    if (mRigidBodyComponents.hasComponentGetIndex(bodyEntity, bodyIndex)) {
+
+        const uint32 islandIndex = mRigidBodyComponents.mIslandIds[bodyIndex];
+        if (islandIndex != NO_ISLAND) {
+            mPersistentIslands.islands[islandIndex].isSplitCandidate = true;
+        }
+    }
+}
+
+// Mark the persistent islands of the lost contact pairs as candidates for splitting
+void PhysicsWorld::markIslandsWithLostContacts() {
+
+    const Array<ContactPair>& lostContactPairs = mCollisionDetection.mLostContactPairs;
+    const uint32 nbLostContactPairs = static_cast<uint32>(lostContactPairs.size());
+    for (uint32 p=0; p < nbLostContactPairs; p++) {
+
+        if (lostContactPairs[p].isTrigger) continue;
+
+        markIslandAsSplitCandidate(lostContactPairs[p].body1Entity);
+        markIslandAsSplitCandidate(lostContactPairs[p].body2Entity);
+    }
+}
+
+// Return the root of a body in the disjoint sets forest used to split the islands
+uint32 PhysicsWorld::findSplitRoot(Array<uint32>& parents, uint32 index) {
+
+    while (parents[index] != index) {
+
+        // Path halving
+        parents[index] = parents[parents[index]];
+        index = parents[index];
+    }
+
+    return index;
+}
+
+// Split persistent islands into their connected groups of bodies
+/// The connectivity of the bodies is computed with the contact pairs of the current frame
+/// and the joints. The first group of bodies of an island keeps the index of the island and
+/// the other groups are moved into new islands. The indices of all the resulting islands
+/// are added into the "outIslands" array.
+void PhysicsWorld::splitIslands(const Array<uint32>& islandsToSplit, Array<uint32>& outIslands) {
+
+    RP3D_PROFILE("PhysicsWorld::splitIslands()", mProfiler);
+    RP3D_INSTRUMENT(Islands);
+
+    MemoryAllocator& allocator = mMemoryManager.getSingleFrameAllocator();
+
+    // Bodies of the islands to split with their island index and their parent in the disjoint sets forest
+    Map<Entity, uint32> mapBodyToSplitIndex(allocator);
+    Array<Entity> bodies(allocator);
+    Array<uint32> bodiesIslands(allocator);
+    Array<uint32> parents(allocator);
+
+    // For each island to split
+    const uint32 nbIslandsToSplit = static_cast<uint32>(islandsToSplit.size());
+    for (uint32 i=0; i < nbIslandsToSplit; i++) {
+
+        PersistentIslands::Island& island = mPersistentIslands.islands[islandsToSplit[i]];
+
+        // The same island might appear twice in the array
+        if (!island.isUsed || !island.isSplitCandidate) continue;
+        island.isSplitCandidate = false;
+
+        const uint32 nbIslandBodies = static_cast<uint32>(island.bodyEntities.size());
+        for (uint32 b=0; b < nbIslandBodies; b++) {
+
+            const uint32 splitIndex = static_cast<uint32>(bodies.size());
+            mapBodyToSplitIndex.add(Pair<Entity, uint32>(island.bodyEntities[b], splitIndex));
+            bodies.add(island.bodyEntities[b]);
+            bodiesIslands.add(islandsToSplit[i]);
+            parents.add(splitIndex);
+        }
+
+        // The bodies will be added back into the islands below
+        island.bodyEntities.clear();
+    }
+
+    // Connect the bodies that are in contact
+    const Array<ContactPair>& contactPairs = *(mCollisionDetection.mCurrentContactPairs);
+    const uint32 nbContactPairs = static_cast<uint32>(contactPairs.size());
+    for (uint32 p=0; p < nbContactPairs; p++) {
+
+        const ContactPair& pair = contactPairs[p];
+
+        if (pair.isTrigger) continue;
+
+        auto it1 = mapBodyToSplitIndex.find(pair.body1Entity);
+        if (it1 == mapBodyToSplitIndex.end()) continue;
+        auto it2 = mapBodyToSplitIndex.find(pair.body2Entity);
+        if (it2 == mapBodyToSplitIndex.end()) continue;
+
+        if (bodiesIslands[it1->second] != bodiesIslands[it2->second]) continue;
+
+        parents[findSplitRoot(parents, it1->second)] = findSplitRoot(parents, it2->second);
+    }
+
+    // Connect the bodies that share a joint
+    const uint32 nbBodies = static_cast<uint32>(bodies.size());
+    for (uint32 b=0; b < nbBodies; b++) {
+
+        const Array<Entity>& joints = mRigidBodyComponents.getJoints(bodies[b]);
+        const uint32 nbJoints = static_cast<uint32>(joints.size());
+        for (uint32 j=0; j < nbJoints; j++) {
+
+            const uint32 jointIndex = mJointsComponents.getEntityIndex(joints[j]);
+            const Entity body1Entity = mJointsComponents.mBody1Entities[jointIndex];
+            const Entity otherBodyEntity = body1Entity == bodies[b] ? mJointsComponents.mBody2Entities[jointIndex] : body1Entity;
+
+            auto it = mapBodyToSplitIndex.find(otherBodyEntity);
+            if (it == mapBodyToSplitIndex.end() || bodiesIslands[it->second] != bodiesIslands[b]) continue;
+
+            parents[findSplitRoot(parents, b)] = findSplitRoot(parents, it->second);
+        }
+    }
+
+    // For each root body, index of the island of its group
+    Array<uint32> rootsIslands(allocator, nbBodies);
+    rootsIslands.addWithoutInit(nbBodies);
+    for (uint32 b=0; b < nbBodies; b++) {
+        rootsIslands[b] = NO_ISLAND;
+    }
+
+    // Add each body into the island of its group
+    for (uint32 b=0; b < nbBodies; b++) {
+
+        const uint32 root = findSplitRoot(parents, b);
+        uint32 islandIndex = rootsIslands[root];
+
+        // If this is the first body of the group
+        if (islandIndex == NO_ISLAND) {
+
+            // The first group of an island keeps the index of the island
+            islandIndex = bodiesIslands[b];
+            if (mPersistentIslands.islands[islandIndex].bodyEntities.size() > 0) {
+                islandIndex = mPersistentIslands.createIsland();
+            }
+
+            rootsIslands[root] = islandIndex;
+            outIslands.add(islandIndex);
+        }
+
+        mPersistentIslands.islands[islandIndex].bodyEntities.add(bodies[b]);
+        mRigidBodyComponents.setIslandId(bodies[b], islandIndex);
     }
 }
 
@@ -0,0 +1,300 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+
+// Libraries
+#include <reactphysics3d/memory/AllocationTracer.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace reactphysics3d;
+
+// Initialization of static variables
+std::atomic<bool> AllocationTracer::mIsEnabled(false);
+std::atomic<uint64> AllocationTracer::mFrameIndex(0);
+DefaultAllocator AllocationTracer::mAllocator;
+std::mutex AllocationTracer::mMutex;
+Array<AllocationTracer::AllocationRecord> AllocationTracer::mRecords(AllocationTracer::mAllocator);
+uint64 AllocationTracer::mMaxNbRecords = AllocationTracer::DEFAULT_MAX_NB_RECORDS;
+uint64 AllocationTracer::mNbDroppedRecords = 0;
+thread_local const char* AllocationTracer::mCurrentTag = nullptr;
+
+// Clear the histogram
+/**
+ * @param frame Index of the frame of the histogram
+ */
+void AllocationTracer::FrameHistogram::clear(uint64 frame) {
+
+    frameIndex = frame;
+    nbAllocations = 0;
+    nbAllocatedBytes = 0;
+    for (uint32 i=0; i < NB_ALLOCATION_TYPES; i++) {
+        nbAllocationsPerType[i] = 0;
+        nbAllocatedBytesPerType[i] = 0;
+    }
+    for (uint32 i=0; i < NB_SIZE_CLASSES; i++) {
+        nbAllocationsPerSizeClass[i] = 0;
+    }
+    tags.clear();
+}
+
+// Add an allocation to the histogram
+void AllocationTracer::FrameHistogram::addRecord(const AllocationRecord& record) {
+
+    const uint32 typeIndex = static_cast<uint32>(record.allocationType);
+
+    nbAllocations++;
+    nbAllocatedBytes += record.size;
+    nbAllocationsPerType[typeIndex]++;
+    nbAllocatedBytesPerType[typeIndex] += record.size;
+    nbAllocationsPerSizeClass[getSizeClass(record.size)]++;
+
+    // The tags are compared by name because the same tag can have different addresses
+    for (uint64 i=0; i < tags.size(); i++) {
+
+        const bool isSameTag = tags[i].tag == record.tag ||
+                               (tags[i].tag != nullptr && record.tag != nullptr && std::strcmp(tags[i].tag, record.tag) == 0);
+        if (isSameTag) {
+            tags[i].nbAllocations++;
+            tags[i].nbAllocatedBytes += record.size;
+            return;
+        }
+    }
+
+    TagCounters tagCounters;
+    tagCounters.tag = record.tag;
+    tagCounters.nbAllocations = 1;
+    tagCounters.nbAllocatedBytes = record.size;
+    tags.add(tagCounters);
+}
+
+// Return the counters of a given tag (null if there is no allocation with this tag)
+/**
+ * @param tag A tag (null for the allocations without tag)
+ * @return A pointer to the counters of the tag or null if there is no allocation with this tag
+ */
+const AllocationTracer::TagCounters* AllocationTracer::FrameHistogram::getTag(const char* tag) const {
+
+    for (uint64 i=0; i < tags.size(); i++) {
+        if (tags[i].tag == tag || (tags[i].tag != nullptr && tag != nullptr && std::strcmp(tags[i].tag, tag) == 0)) {
+            return &(tags[i]);
+        }
+    }
+
+    return nullptr;
+}
+
+// Enable or disable the recording of the allocations
+/**
+ * @param isEnabled True if the allocations must be recorded
+ */
+void AllocationTracer::setIsEnabled(bool isEnabled) {
+    mIsEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+// Record an allocation
+void AllocationTracer::addRecord(MemoryManager::AllocationType allocationType, size_t size) {
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (mRecords.size() >= mMaxNbRecords) {
+        mNbDroppedRecords++;
+        return;
+    }
+
+    AllocationRecord record;
+    record.frameIndex = getFrameIndex();
+    record.size = size;
+    record.tag = mCurrentTag;
+    record.allocationType = allocationType;
+    mRecords.add(record);
+}
+
+// Set the maximum number of records
+/**
+ * The allocations are not recorded anymore when this number of records is reached
+ * @param maxNbRecords Maximum number of recorded allocations
+ */
+void AllocationTracer::setMaxNbRecords(uint64 maxNbRecords) {
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMaxNbRecords = maxNbRecords;
+}
+
+// Return the number of recorded allocations
+uint64 AllocationTracer::getNbRecords() {
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mRecords.size();
+}
+
+// Return the number of allocations that have not been recorded because there were too many records
+uint64 AllocationTracer::getNbDroppedRecords() {
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mNbDroppedRecords;
+}
+
+// Copy the recorded allocations into an array
+/**
+ * @param outRecords Array where the recorded allocations are added (in the order of the allocations)
+ */
+void AllocationTracer::getRecords(Array<AllocationRecord>& outRecords) {
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    outRecords.addRange(mRecords);
+}
+
+// Compute the histogram of the recorded allocations of a frame
+/**
+ * @param frameIndex Index of a frame
+ * @param outHistogram Histogram of the allocations of the frame
+ */
+void AllocationTracer::computeFrameHistogram(uint64 frameIndex, FrameHistogram& outHistogram) {
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    outHistogram.clear(frameIndex);
+    for (uint64 i=0; i < mRecords.size(); i++) {
+        if (mRecords[i].frameIndex == frameIndex) {
+            outHistogram.addRecord(mRecords[i]);
+        }
+    }
+}
+
+// Write the histograms of the frames with recorded allocations into a stream
+/**
+ * The frames without any recorded allocation are skipped
+ * @param stream Output stream
+ * @param firstFrame Index of the first frame to write
+ * @param lastFrame Index of the last frame to write
+ */
+void AllocationTracer::dumpFrameHistograms(std::ostream& stream, uint64 firstFrame, uint64 lastFrame) {
+
+    // Copy the records of the frames and sort them by frame. The records are already
+    // almost sorted because they are added in the order of the allocations.
+    Array<AllocationRecord> records(mAllocator);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (uint64 i=0; i < mRecords.size(); i++) {
+            if (mRecords[i].frameIndex >= firstFrame && mRecords[i].frameIndex <= lastFrame) {
+                records.add(mRecords[i]);
+            }
+        }
+    }
+
+    if (records.size() == 0) return;
+
+    std::stable_sort(&(records[0]), &(records[0]) + records.size(), isRecordOfEarlierFrame);
+
+    FrameHistogram histogram(mAllocator);
+    histogram.clear(records[0].frameIndex);
+    for (uint64 i=0; i < records.size(); i++) {
+
+        if (records[i].frameIndex != histogram.frameIndex) {
+            writeHistogram(stream, histogram);
+            histogram.clear(records[i].frameIndex);
+        }
+
+        histogram.addRecord(records[i]);
+    }
+    writeHistogram(stream, histogram);
+}
+
+// Return true if a record belongs to an earlier frame than another record
+bool AllocationTracer::isRecordOfEarlierFrame(const AllocationRecord& record1, const AllocationRecord& record2) {
+    return record1.frameIndex < record2.frameIndex;
+}
+
+// Write a histogram into a stream
+void AllocationTracer::writeHistogram(std::ostream& stream, const FrameHistogram& histogram) {
+
+    stream << "Frame " << histogram.frameIndex << ": " << histogram.nbAllocations << " allocations, "
+           << histogram.nbAllocatedBytes << " bytes" << std::endl;
+
+    // Allocator types
+    for (uint32 i=0; i < NB_ALLOCATION_TYPES; i++) {
+        if (histogram.nbAllocationsPerType[i] > 0) {
+            stream << "    " << getAllocationTypeName(static_cast<MemoryManager::AllocationType>(i)) << ": "
+                   << histogram.nbAllocationsPerType[i] << " allocations, " << histogram.nbAllocatedBytesPerType[i] << " bytes" << std::endl;
+        }
+    }
+
+    // Size classes
+    stream << "    Sizes:";
+    for (uint32 i=0; i < NB_SIZE_CLASSES; i++) {
+        if (histogram.nbAllocationsPerSizeClass[i] > 0) {
+            if (i < NB_SIZE_CLASSES - 1) {
+                stream << " <=" << (uint64(16) << i) << ": " << histogram.nbAllocationsPerSizeClass[i];
+            }
+            else {
+                stream << " >" << (uint64(16) << (i - 1)) << ": " << histogram.nbAllocationsPerSizeClass[i];
+            }
+        }
+    }
+    stream << std::endl;
+
+    // Tags
+    for (uint64 i=0; i < histogram.tags.size(); i++) {
+        stream << "    Tag " << (histogram.tags[i].tag != nullptr ? histogram.tags[i].tag : "(none)") << ": "
+               << histogram.tags[i].nbAllocations << " allocations, " << histogram.tags[i].nbAllocatedBytes << " bytes" << std::endl;
+    }
+}
+
+// Remove all the recorded allocations
+void AllocationTracer::reset() {
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRecords.clear(true);
+    mNbDroppedRecords = 0;
+}
+
+// Return the name of an allocator type
+const char* AllocationTracer::getAllocationTypeName(MemoryManager::AllocationType allocationType) {
+
+    switch (allocationType) {
+        case MemoryManager::AllocationType::Base: return "Base";
+        case MemoryManager::AllocationType::Pool: return "Pool";
+        case MemoryManager::AllocationType::Heap: return "Heap";
+        case MemoryManager::AllocationType::Frame: return "Frame";
+    }
+
+    return "Unknown";
+}
+
+// Return the size class of an allocation size
+/**
+ * @param size Size of an allocation (in bytes)
+ * @return The index of the smallest size class (16 << index bytes) that contains the size
+ */
+uint32 AllocationTracer::getSizeClass(size_t size) {
+
+    uint32 sizeClass = 0;
+    while (sizeClass < NB_SIZE_CLASSES - 1 && size > (size_t(16) << sizeClass)) {
+        sizeClass++;
+    }
+
+    return sizeClass;
+}
@@ -26,6 +26,7 @@
 // Libraries
 #include <reactphysics3d/memory/HeapAllocator.h>
 #include <reactphysics3d/memory/MemoryManager.h>
+#include <reactphysics3d/memory/AllocationTracer.h>
 #include <cstdlib>
 #include <cassert>
 #include <iostream>
@@ -36,13 +37,12 @@ size_t HeapAllocator::INIT_ALLOCATED_SIZE = 5 * 1048576;    // 5 Mb
 
 // Constructor
 HeapAllocator::HeapAllocator(MemoryAllocator& baseAllocator, size_t initAllocatedMemory)
-              : mBaseAllocator(baseAllocator), mAllocatedMemory(0), mMemoryUnits(nullptr), mCachedFreeUnit(nullptr) {
+              : mBaseAllocator(baseAllocator), mInitAllocatedMemory(initAllocatedMemory == 0 ? INIT_ALLOCATED_SIZE : initAllocatedMemory),
+                mAllocatedMemory(0), mUsedMemory(0), mPeakUsedMemory(0), mMemoryUnits(nullptr), mCachedFreeUnit(nullptr) {
 
 #ifndef NDEBUG
         mNbTimesAllocateMethodCalled = 0;
 #endif
-
-    reserve(initAllocatedMemory == 0 ? INIT_ALLOCATED_SIZE : initAllocatedMemory);
 }
 
 // Destructor
@@ -109,6 +109,8 @@ void HeapAllocator::splitMemoryUnit(MemoryUnitHeader* unit, size_t size) {
 // allocated memory.
 void* HeapAllocator::allocate(size_t size) {
 
+    RP3D_TRACE_ALLOCATION(Heap, size);
+
     // Lock the method with a mutex
     std::lock_guard<std::mutex> lock(mMutex);
 
@@ -121,6 +123,11 @@ void* HeapAllocator::allocate(size_t size) {
         mNbTimesAllocateMethodCalled++;
 #endif
 
+    // The memory is only reserved on the first allocation so that an unused allocator does not hold any memory
+    if (mMemoryUnits == nullptr) {
+        reserve(mInitAllocatedMemory);
+    }
+
     MemoryUnitHeader* currentUnit = mMemoryUnits;
     assert(mMemoryUnits->previousUnit == nullptr);
 
@@ -169,6 +176,11 @@ void* HeapAllocator::allocate(size_t size) {
 
     currentUnit->isAllocated = true;
 
+    mUsedMemory += currentUnit->size;
+    if (mUsedMemory > mPeakUsedMemory) {
+        mPeakUsedMemory = mUsedMemory;
+    }
+
     // Cache the next memory unit if it is not allocated
     if (currentUnit->nextUnit != nullptr && !currentUnit->nextUnit->isAllocated) {
         mCachedFreeUnit = currentUnit->nextUnit;
@@ -198,6 +210,9 @@ void HeapAllocator::release(void* pointer, size_t size) {
     assert(unit->isAllocated);
     unit->isAllocated = false;
 
+    assert(mUsedMemory >= unit->size);
+    mUsedMemory -= unit->size;
+
     MemoryUnitHeader* currentUnit = unit;
 
     // If the previous unit is not allocated and memory is contiguous to the current unit
@@ -248,6 +263,7 @@ void HeapAllocator::mergeUnits(MemoryUnitHeader* unit1, MemoryUnitHeader* unit2)
 void HeapAllocator::reserve(size_t sizeToAllocate) {
 
     // Allocate memory
+    RP3D_TRACE_ALLOCATION(Base, sizeToAllocate + sizeof(MemoryUnitHeader));
     void* memory = mBaseAllocator.allocate(sizeToAllocate + sizeof(MemoryUnitHeader));
     assert(memory != nullptr);
 
@@ -265,3 +281,14 @@ void HeapAllocator::reserve(size_t sizeToAllocate) {
 
     mAllocatedMemory += sizeToAllocate;
 }
+
+// Return the memory usage of the allocator
+/// The reserved memory is the memory obtained from the base allocator and the used
+/// memory is the memory of the units that are currently allocated.
+MemoryUsage HeapAllocator::getMemoryUsage() const {
+
+    // Lock the method with a mutex
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    return MemoryUsage(mAllocatedMemory, mUsedMemory, mPeakUsedMemory);
+}
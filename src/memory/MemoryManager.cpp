@@ -29,9 +29,12 @@
 using namespace reactphysics3d;
 
 // Constructor
-MemoryManager::MemoryManager(MemoryAllocator* baseAllocator, size_t initAllocatedMemory) :
+MemoryManager::MemoryManager(MemoryAllocator* baseAllocator, HeapAllocatorType heapAllocatorType, size_t initAllocatedMemory) :
                mBaseAllocator(baseAllocator == nullptr ? &mDefaultAllocator : baseAllocator),
-               mHeapAllocator(*mBaseAllocator, initAllocatedMemory),
+               mFirstFitHeapAllocator(*mBaseAllocator, initAllocatedMemory),
+               mTLSFHeapAllocator(*mBaseAllocator, initAllocatedMemory),
+               mHeapAllocator(heapAllocatorType == HeapAllocatorType::FirstFit ? static_cast<MemoryAllocator&>(mFirstFitHeapAllocator) :
+                                                                                 static_cast<MemoryAllocator&>(mTLSFHeapAllocator)),
                mPoolAllocator(mHeapAllocator),
                mSingleFrameAllocator(mHeapAllocator) {
 
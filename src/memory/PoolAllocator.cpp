@@ -26,18 +26,24 @@
 // Libraries
 #include <reactphysics3d/memory/PoolAllocator.h>
 #include <reactphysics3d/memory/MemoryManager.h>
+#include <reactphysics3d/memory/AllocationTracer.h>
 #include <cstdlib>
 #include <cassert>
+#include <new>
 
 using namespace reactphysics3d;
 
 // Initialization of static variables
-bool PoolAllocator::isMapSizeToHeadIndexInitialized = false;
+std::once_flag PoolAllocator::mStaticTablesInitFlag;
 size_t PoolAllocator::mUnitSizes[NB_HEAPS];
 int PoolAllocator::mMapSizeToHeapIndex[MAX_UNIT_SIZE + 1];
+std::atomic<uint64> PoolAllocator::mNbCreatedAllocators(0);
+thread_local PoolAllocator::ThreadCacheIndex PoolAllocator::mThreadCacheIndex = {0, 0};
 
 // Constructor
-PoolAllocator::PoolAllocator(MemoryAllocator& baseAllocator) : mBaseAllocator(baseAllocator) {
+PoolAllocator::PoolAllocator(MemoryAllocator& baseAllocator) : mBaseAllocator(baseAllocator),
+                             mSharedUsedMemory(0), mLargeAllocatedMemory(0), mPeakUsedMemory(0),
+                             mId(mNbCreatedAllocators.fetch_add(1) + 1), mNbUsedThreadCaches(0) {
 
     // Allocate some memory to manage the blocks
     mNbAllocatedMemoryBlocks = 64;
@@ -47,40 +53,53 @@ PoolAllocator::PoolAllocator(MemoryAllocator& baseAllocator) : mBaseAllocator(ba
     memset(mMemoryBlocks, 0, sizeToAllocate);
     memset(mFreeMemoryUnits, 0, sizeof(mFreeMemoryUnits));
 
+    for (uint32 i = 0; i < MAX_NB_THREAD_CACHES; i++) {
+        mThreadCaches[i] = nullptr;
+        mThreadCacheOwners[i].store(std::thread::id());
+    }
+
 #ifndef NDEBUG
         mNbTimesAllocateMethodCalled = 0;
 #endif
 
-    // If the mMapSizeToHeapIndex has not been initialized yet
-    if (!isMapSizeToHeadIndexInitialized) {
+    // Initialize the static tables if it has not been done yet
+    std::call_once(mStaticTablesInitFlag, initStaticTables);
+}
 
-        // Initialize the array that contains the sizes of the memory units that will
-        // be allocated in each different heap
-        for (uint i=0; i < NB_HEAPS; i++) {
-            mUnitSizes[i] = (i+1) * 8;
-        }
+// Initialize the static tables of the unit sizes and of the heap index of each size
+void PoolAllocator::initStaticTables() {
 
-        // Initialize the lookup table that maps the size to allocated to the
-        // corresponding heap we will use for the allocation
-        uint j = 0;
-        mMapSizeToHeapIndex[0] = -1;    // This element should not be used
-        for (uint i=1; i <= MAX_UNIT_SIZE; i++) {
-            if (i <= mUnitSizes[j]) {
-                mMapSizeToHeapIndex[i] = j;
-            }
-            else {
-                j++;
-                mMapSizeToHeapIndex[i] = j;
-            }
-        }
+    // Initialize the array that contains the sizes of the memory units that will
+    // be allocated in each different heap
+    for (uint i=0; i < NB_HEAPS; i++) {
+        mUnitSizes[i] = (i+1) * 8;
+    }
 
-        isMapSizeToHeadIndexInitialized = true;
+    // Initialize the lookup table that maps the size to allocated to the
+    // corresponding heap we will use for the allocation
+    uint j = 0;
+    mMapSizeToHeapIndex[0] = -1;    // This element should not be used
+    for (uint i=1; i <= MAX_UNIT_SIZE; i++) {
+        if (i <= mUnitSizes[j]) {
+            mMapSizeToHeapIndex[i] = j;
+        }
+        else {
+            j++;
+            mMapSizeToHeapIndex[i] = j;
+        }
     }
 }
 
 // Destructor
 PoolAllocator::~PoolAllocator() {
 
+    // Release the caches of the threads (their memory units belong to the memory blocks)
+    for (uint32 i = 0; i < MAX_NB_THREAD_CACHES; i++) {
+        if (mThreadCaches[i] != nullptr) {
+            mBaseAllocator.release(mThreadCaches[i], sizeof(ThreadCache));
+        }
+    }
+
     // Release the memory allocated for each block
     for (uint i=0; i<mNbCurrentMemoryBlocks; i++) {
         mBaseAllocator.release(mMemoryBlocks[i].memoryUnits, BLOCK_SIZE);
@@ -96,18 +115,149 @@ PoolAllocator::~PoolAllocator() {
 
 }
 
+// Find or create the cache of the current thread
+PoolAllocator::ThreadCache* PoolAllocator::findThreadCache() {
+
+    const std::thread::id threadId = std::this_thread::get_id();
+
+    // Look for a cache that has already been given to this thread
+    uint32 nbCaches = mNbUsedThreadCaches.load(std::memory_order_acquire);
+    if (nbCaches > MAX_NB_THREAD_CACHES) nbCaches = MAX_NB_THREAD_CACHES;
+    for (uint32 i = 0; i < nbCaches; i++) {
+        if (mThreadCacheOwners[i].load(std::memory_order_acquire) == threadId) {
+            mThreadCacheIndex = {mId, i};
+            return mThreadCaches[i];
+        }
+    }
+
+    // Give a new cache to this thread
+    const uint32 cacheIndex = mNbUsedThreadCaches.fetch_add(1, std::memory_order_acq_rel);
+    if (cacheIndex >= MAX_NB_THREAD_CACHES) {
+
+        // There is no cache left, this thread will directly use the shared heaps
+        mThreadCacheIndex = {mId, MAX_NB_THREAD_CACHES};
+        return nullptr;
+    }
+
+    void* cacheMemory = mBaseAllocator.allocate(sizeof(ThreadCache));
+    assert(cacheMemory != nullptr);
+    ThreadCache* cache = new (cacheMemory) ThreadCache();
+    mThreadCaches[cacheIndex] = cache;
+    mThreadCacheOwners[cacheIndex].store(threadId, std::memory_order_release);
+
+    mThreadCacheIndex = {mId, cacheIndex};
+
+    return cache;
+}
+
+// Allocate a new memory block and add its memory units into the free units of a heap
+/// The mutex must be locked when this method is called.
+void PoolAllocator::allocateMemoryBlock(int indexHeap) {
+
+    assert(mFreeMemoryUnits[indexHeap] == nullptr);
+
+    // If we need to allocate more memory to contains the blocks
+    if (mNbCurrentMemoryBlocks == mNbAllocatedMemoryBlocks) {
+
+        // Allocate more memory to contain the blocks
+        MemoryBlock* currentMemoryBlocks = mMemoryBlocks;
+        mNbAllocatedMemoryBlocks += 64;
+        mMemoryBlocks = static_cast<MemoryBlock*>(mBaseAllocator.allocate(mNbAllocatedMemoryBlocks * sizeof(MemoryBlock)));
+        memcpy(mMemoryBlocks, currentMemoryBlocks, mNbCurrentMemoryBlocks * sizeof(MemoryBlock));
+        memset(mMemoryBlocks + mNbCurrentMemoryBlocks, 0, 64 * sizeof(MemoryBlock));
+        mBaseAllocator.release(currentMemoryBlocks, mNbCurrentMemoryBlocks * sizeof(MemoryBlock));
+    }
+
+    // Allocate a new memory blocks for the corresponding heap and divide it in many
+    // memory units
+    MemoryBlock* newBlock = mMemoryBlocks + mNbCurrentMemoryBlocks;
+    newBlock->memoryUnits = static_cast<MemoryUnit*>(mBaseAllocator.allocate(BLOCK_SIZE));
+    assert(newBlock->memoryUnits != nullptr);
+    size_t unitSize = mUnitSizes[indexHeap];
+    size_t nbUnits = BLOCK_SIZE / unitSize;
+    assert(nbUnits * unitSize <= BLOCK_SIZE);
+    void* memoryUnitsStart = static_cast<void*>(newBlock->memoryUnits);
+    char* memoryUnitsStartChar = static_cast<char*>(memoryUnitsStart);
+    for (size_t i=0; i < nbUnits - 1; i++) {
+        void* unitPointer = static_cast<void*>(memoryUnitsStartChar + unitSize * i);
+        void* nextUnitPointer = static_cast<void*>(memoryUnitsStartChar + unitSize * (i+1));
+        MemoryUnit* unit = static_cast<MemoryUnit*>(unitPointer);
+        MemoryUnit* nextUnit = static_cast<MemoryUnit*>(nextUnitPointer);
+        unit->nextUnit = nextUnit;
+    }
+    void* lastUnitPointer = static_cast<void*>(memoryUnitsStartChar + unitSize*(nbUnits-1));
+    MemoryUnit* lastUnit = static_cast<MemoryUnit*>(lastUnitPointer);
+    lastUnit->nextUnit = nullptr;
+
+    // Add the new allocated block into the list of free memory units in the heap
+    mFreeMemoryUnits[indexHeap] = newBlock->memoryUnits;
+    mNbCurrentMemoryBlocks++;
+}
+
+// Move a batch of free memory units from a shared heap into a thread cache
+void PoolAllocator::refillThreadCache(ThreadCache* cache, int indexHeap) {
+
+    assert(cache->nbFreeMemoryUnits[indexHeap] == 0);
+
+    // Lock the shared heaps with a mutex
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // If there is no more free memory units in the corresponding heap
+    if (mFreeMemoryUnits[indexHeap] == nullptr) {
+        allocateMemoryBlock(indexHeap);
+    }
+
+    // Move the first free memory units of the heap into the cache
+    MemoryUnit* firstUnit = mFreeMemoryUnits[indexHeap];
+    MemoryUnit* lastUnit = firstUnit;
+    uint32 nbUnits = 1;
+    while (nbUnits < NB_UNITS_PER_BATCH && lastUnit->nextUnit != nullptr) {
+        lastUnit = lastUnit->nextUnit;
+        nbUnits++;
+    }
+    mFreeMemoryUnits[indexHeap] = lastUnit->nextUnit;
+    lastUnit->nextUnit = nullptr;
+
+    cache->freeMemoryUnits[indexHeap] = firstUnit;
+    cache->nbFreeMemoryUnits[indexHeap] = nbUnits;
+
+    // The largest used memory is sampled each time a cache needs more memory units
+    updateUsedMemory();
+}
+
+// Move a batch of free memory units from a thread cache back into a shared heap
+void PoolAllocator::flushThreadCache(ThreadCache* cache, int indexHeap) {
+
+    assert(cache->nbFreeMemoryUnits[indexHeap] > NB_UNITS_PER_BATCH);
+
+    // Detach the first free memory units of the cache (without lock)
+    MemoryUnit* firstUnit = cache->freeMemoryUnits[indexHeap];
+    MemoryUnit* lastUnit = firstUnit;
+    for (uint32 i = 1; i < NB_UNITS_PER_BATCH; i++) {
+        lastUnit = lastUnit->nextUnit;
+    }
+    cache->freeMemoryUnits[indexHeap] = lastUnit->nextUnit;
+    cache->nbFreeMemoryUnits[indexHeap] -= NB_UNITS_PER_BATCH;
+
+    // Lock the shared heaps with a mutex
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Insert the batch of units into the list of free memory units of the heap
+    lastUnit->nextUnit = mFreeMemoryUnits[indexHeap];
+    mFreeMemoryUnits[indexHeap] = firstUnit;
+}
+
 // Allocate memory of a given size (in bytes) and return a pointer to the
 // allocated memory.
 void* PoolAllocator::allocate(size_t size) {
 
-    // Lock the method with a mutex
-    std::lock_guard<std::mutex> lock(mMutex);
-
     assert(size > 0);
 
     // We cannot allocate zero bytes
     if (size == 0) return nullptr;
 
+    RP3D_TRACE_ALLOCATION(Pool, size);
+
 #ifndef NDEBUG
         mNbTimesAllocateMethodCalled++;
 #endif
@@ -115,6 +265,8 @@ void* PoolAllocator::allocate(size_t size) {
     // If we need to allocate more than the maximum memory unit size
     if (size > MAX_UNIT_SIZE) {
 
+        mLargeAllocatedMemory.fetch_add(size, std::memory_order_relaxed);
+
         // Allocate memory using default allocation
         return mBaseAllocator.allocate(size);
     }
@@ -123,64 +275,44 @@ void* PoolAllocator::allocate(size_t size) {
     int indexHeap = mMapSizeToHeapIndex[size];
     assert(indexHeap >= 0 && indexHeap < NB_HEAPS);
 
-    // If there still are free memory units in the corresponding heap
-    if (mFreeMemoryUnits[indexHeap] != nullptr) {
+    ThreadCache* cache = getThreadCache();
 
-        // Return a pointer to the memory unit
-        MemoryUnit* unit = mFreeMemoryUnits[indexHeap];
-        mFreeMemoryUnits[indexHeap] = unit->nextUnit;
-        return unit;
-    }
-    else {  // If there is no more free memory units in the corresponding heap
+    // If the thread does not have a cache, we directly use the shared heap
+    if (cache == nullptr) {
 
-        // If we need to allocate more memory to contains the blocks
-        if (mNbCurrentMemoryBlocks == mNbAllocatedMemoryBlocks) {
+        // Lock the shared heaps with a mutex
+        std::lock_guard<std::mutex> lock(mMutex);
 
-            // Allocate more memory to contain the blocks
-            MemoryBlock* currentMemoryBlocks = mMemoryBlocks;
-            mNbAllocatedMemoryBlocks += 64;
-            mMemoryBlocks = static_cast<MemoryBlock*>(mBaseAllocator.allocate(mNbAllocatedMemoryBlocks * sizeof(MemoryBlock)));
-            memcpy(mMemoryBlocks, currentMemoryBlocks, mNbCurrentMemoryBlocks * sizeof(MemoryBlock));
-            memset(mMemoryBlocks + mNbCurrentMemoryBlocks, 0, 64 * sizeof(MemoryBlock));
-            mBaseAllocator.release(currentMemoryBlocks, mNbCurrentMemoryBlocks * sizeof(MemoryBlock));
+        // If there is no more free memory units in the corresponding heap
+        if (mFreeMemoryUnits[indexHeap] == nullptr) {
+            allocateMemoryBlock(indexHeap);
         }
 
-        // Allocate a new memory blocks for the corresponding heap and divide it in many
-        // memory units
-        MemoryBlock* newBlock = mMemoryBlocks + mNbCurrentMemoryBlocks;
-        newBlock->memoryUnits = static_cast<MemoryUnit*>(mBaseAllocator.allocate(BLOCK_SIZE));
-        assert(newBlock->memoryUnits != nullptr);
-        size_t unitSize = mUnitSizes[indexHeap];
-        size_t nbUnits = BLOCK_SIZE / unitSize;
-        assert(nbUnits * unitSize <= BLOCK_SIZE);
-        void* memoryUnitsStart = static_cast<void*>(newBlock->memoryUnits);
-        char* memoryUnitsStartChar = static_cast<char*>(memoryUnitsStart);
-        for (size_t i=0; i < nbUnits - 1; i++) {
-            void* unitPointer = static_cast<void*>(memoryUnitsStartChar + unitSize * i);
-            void* nextUnitPointer = static_cast<void*>(memoryUnitsStartChar + unitSize * (i+1));
-            MemoryUnit* unit = static_cast<MemoryUnit*>(unitPointer);
-            MemoryUnit* nextUnit = static_cast<MemoryUnit*>(nextUnitPointer);
-            unit->nextUnit = nextUnit;
-        }
-        void* lastUnitPointer = static_cast<void*>(memoryUnitsStartChar + unitSize*(nbUnits-1));
-        MemoryUnit* lastUnit = static_cast<MemoryUnit*>(lastUnitPointer);
-        lastUnit->nextUnit = nullptr;
+        mSharedUsedMemory += mUnitSizes[indexHeap];
+        updateUsedMemory();
 
-        // Add the new allocated block into the list of free memory units in the heap
-        mFreeMemoryUnits[indexHeap] = newBlock->memoryUnits->nextUnit;
-        mNbCurrentMemoryBlocks++;
+        // Return a pointer to the memory unit
+        MemoryUnit* unit = mFreeMemoryUnits[indexHeap];
+        mFreeMemoryUnits[indexHeap] = unit->nextUnit;
+        return unit;
+    }
 
-        // Return the pointer to the first memory unit of the new allocated block
-        return newBlock->memoryUnits;
+    // If the cache of the thread is empty, we refill it from the shared heap
+    if (cache->nbFreeMemoryUnits[indexHeap] == 0) {
+        refillThreadCache(cache, indexHeap);
     }
+
+    // Return a pointer to the memory unit
+    MemoryUnit* unit = cache->freeMemoryUnits[indexHeap];
+    cache->freeMemoryUnits[indexHeap] = unit->nextUnit;
+    cache->nbFreeMemoryUnits[indexHeap]--;
+    cache->usedMemory.store(cache->usedMemory.load(std::memory_order_relaxed) + mUnitSizes[indexHeap], std::memory_order_relaxed);
+    return unit;
 }
 
 // Release previously allocated memory.
 void PoolAllocator::release(void* pointer, size_t size) {
 
-    // Lock the method with a mutex
-    std::lock_guard<std::mutex> lock(mMutex);
-
     assert(size > 0);
 
     // Cannot release a 0-byte allocated memory
@@ -193,6 +325,8 @@ void PoolAllocator::release(void* pointer, size_t size) {
     // If the size is larger than the maximum memory unit size
     if (size > MAX_UNIT_SIZE) {
 
+        mLargeAllocatedMemory.fetch_sub(size, std::memory_order_relaxed);
+
         // Release the memory using the default deallocation
         mBaseAllocator.release(pointer, size);
         return;
@@ -202,9 +336,119 @@ void PoolAllocator::release(void* pointer, size_t size) {
     int indexHeap = mMapSizeToHeapIndex[size];
     assert(indexHeap >= 0 && indexHeap < NB_HEAPS);
 
-    // Insert the released memory unit into the list of free memory units of the
-    // corresponding heap
     MemoryUnit* releasedUnit = static_cast<MemoryUnit*>(pointer);
-    releasedUnit->nextUnit = mFreeMemoryUnits[indexHeap];
-    mFreeMemoryUnits[indexHeap] = releasedUnit;
+
+    ThreadCache* cache = getThreadCache();
+
+    // If the thread does not have a cache, we directly use the shared heap
+    if (cache == nullptr) {
+
+        // Lock the shared heaps with a mutex
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mSharedUsedMemory -= mUnitSizes[indexHeap];
+
+        // Insert the released memory unit into the list of free memory units of the
+        // corresponding heap
+        releasedUnit->nextUnit = mFreeMemoryUnits[indexHeap];
+        mFreeMemoryUnits[indexHeap] = releasedUnit;
+        return;
+    }
+
+    // Insert the released memory unit into the cache of the thread
+    releasedUnit->nextUnit = cache->freeMemoryUnits[indexHeap];
+    cache->freeMemoryUnits[indexHeap] = releasedUnit;
+    cache->nbFreeMemoryUnits[indexHeap]++;
+    cache->usedMemory.store(cache->usedMemory.load(std::memory_order_relaxed) - mUnitSizes[indexHeap], std::memory_order_relaxed);
+
+    // If the cache holds too many free memory units, we give a batch back to the shared heap
+    if (cache->nbFreeMemoryUnits[indexHeap] > 2 * NB_UNITS_PER_BATCH) {
+        flushThreadCache(cache, indexHeap);
+    }
+}
+
+// Allocate memory of a given size (in bytes) aligned on a given alignment
+/**
+ * @param size Size (in bytes) of the memory to allocate
+ * @param alignment Alignment (in bytes, power of two) of the memory to allocate
+ * @return A pointer to the allocated memory
+ */
+void* PoolAllocator::allocate(size_t size, size_t alignment) {
+
+    // If the size is larger than the maximum memory unit size, the base allocator
+    // takes care of the alignment
+    if (size > MAX_UNIT_SIZE) {
+
+#ifndef NDEBUG
+        mNbTimesAllocateMethodCalled++;
+#endif
+
+        mLargeAllocatedMemory.fetch_add(size, std::memory_order_relaxed);
+
+        RP3D_TRACE_ALLOCATION(Pool, size);
+
+        return mBaseAllocator.allocate(size, alignment);
+    }
+
+    return MemoryAllocator::allocate(size, alignment);
+}
+
+// Release previously allocated memory with the allocate(size, alignment) method
+void PoolAllocator::release(void* pointer, size_t size, size_t alignment) {
+
+    if (size > MAX_UNIT_SIZE) {
+
+#ifndef NDEBUG
+        mNbTimesAllocateMethodCalled--;
+#endif
+
+        mLargeAllocatedMemory.fetch_sub(size, std::memory_order_relaxed);
+
+        mBaseAllocator.release(pointer, size, alignment);
+        return;
+    }
+
+    MemoryAllocator::release(pointer, size, alignment);
+}
+
+// Compute the memory currently used and update the largest used memory
+/// The mutex must be locked when this method is called. The memory units in the caches of the
+/// threads are counted as used by their own thread, so the result is only exact when no
+/// other thread allocates or releases memory at the same time.
+size_t PoolAllocator::updateUsedMemory() const {
+
+    size_t usedMemory = mSharedUsedMemory + mLargeAllocatedMemory.load(std::memory_order_relaxed);
+
+    uint32 nbCaches = mNbUsedThreadCaches.load(std::memory_order_acquire);
+    if (nbCaches > MAX_NB_THREAD_CACHES) nbCaches = MAX_NB_THREAD_CACHES;
+    for (uint32 i = 0; i < nbCaches; i++) {
+
+        // The cache can only be read once its owner has been published
+        if (mThreadCacheOwners[i].load(std::memory_order_acquire) != std::thread::id()) {
+            usedMemory += mThreadCaches[i]->usedMemory.load(std::memory_order_relaxed);
+        }
+    }
+
+    if (usedMemory > mPeakUsedMemory) {
+        mPeakUsedMemory = usedMemory;
+    }
+
+    return usedMemory;
+}
+
+// Return the memory usage of the allocator
+/// The reserved memory is the memory of the blocks obtained from the base allocator and the used
+/// memory is the memory of the units that are currently allocated. The allocations larger than the
+/// maximum memory unit size are counted in both. The largest used memory is sampled when a thread
+/// needs more memory units from the shared heaps. Therefore, it can miss the memory units that
+/// were already in the cache of a thread.
+MemoryUsage PoolAllocator::getMemoryUsage() const {
+
+    // Lock the shared heaps with a mutex
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const size_t usedMemory = updateUsedMemory();
+    const size_t reservedMemory = mNbCurrentMemoryBlocks * BLOCK_SIZE + mLargeAllocatedMemory.load(std::memory_order_relaxed);
+
+    return MemoryUsage(reservedMemory, usedMemory, mPeakUsedMemory);
 }
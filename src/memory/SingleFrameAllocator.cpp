@@ -26,119 +26,291 @@
 // Libraries
 #include <reactphysics3d/memory/SingleFrameAllocator.h>
 #include <reactphysics3d/memory/MemoryManager.h>
+#include <reactphysics3d/memory/AllocationTracer.h>
 #include <cstdlib>
 #include <cassert>
+#include <algorithm>
+#include <new>
 
 using namespace reactphysics3d;
 
+// Static variables
+std::atomic<uint64> SingleFrameAllocator::mNbCreatedAllocators(0);
+thread_local SingleFrameAllocator::ThreadArenaCache SingleFrameAllocator::mThreadArenaCache = {0, 0};
+
 // Constructor
 SingleFrameAllocator::SingleFrameAllocator(MemoryAllocator& baseAllocator) : mBaseAllocator(baseAllocator),
-                                           mTotalSizeBytes(INIT_SINGLE_FRAME_ALLOCATOR_NB_BYTES),
-                                           mCurrentOffset(0), mNbFramesTooMuchAllocated(0), mNeedToAllocatedMore(false) {
-
-    // Allocate a whole block of memory at the beginning
-    mMemoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(mTotalSizeBytes));
-    assert(mMemoryBufferStart != nullptr);
+                                           mId(mNbCreatedAllocators.fetch_add(1) + 1), mNbUsedArenas(0), mChunks(nullptr),
+                                           mChunksAllocatedBytes(0), mPeakUsedMemory(0) {
+
+    mArenas = static_cast<FrameArena*>(mBaseAllocator.allocate(MAX_NB_ARENAS * sizeof(FrameArena), alignof(FrameArena)));
+
+    for (uint32 i = 0; i < MAX_NB_ARENAS; i++) {
+        new (mArenas + i) FrameArena();
+        mArenas[i].ownerThread.store(std::thread::id());
+        mArenas[i].memoryBufferStart = nullptr;
+        mArenas[i].totalSizeBytes = 0;
+        mArenas[i].currentLocation = nullptr;
+        mArenas[i].endLocation = nullptr;
+        mArenas[i].nbAllocatedBytes = 0;
+        mArenas[i].nbFramesTooMuchAllocated = 0;
+    }
 }
 
 // Destructor
 SingleFrameAllocator::~SingleFrameAllocator() {
 
-    // Release the memory allocated at the beginning
-    mBaseAllocator.release(mMemoryBufferStart, mTotalSizeBytes);
+    // Release the chunks and the buffers of the arenas
+    reset();
+
+    uint32 nbArenas = mNbUsedArenas.load();
+    if (nbArenas > MAX_NB_ARENAS) nbArenas = MAX_NB_ARENAS;
+    for (uint32 i = 0; i < nbArenas; i++) {
+        mBaseAllocator.release(mArenas[i].memoryBufferStart, mArenas[i].totalSizeBytes);
+    }
+
+    for (uint32 i = 0; i < MAX_NB_ARENAS; i++) {
+        mArenas[i].~FrameArena();
+    }
+    mBaseAllocator.release(mArenas, MAX_NB_ARENAS * sizeof(FrameArena), alignof(FrameArena));
 }
 
+// Find or create the arena of the current thread
+SingleFrameAllocator::FrameArena* SingleFrameAllocator::findThreadArena() {
+
+    const std::thread::id threadId = std::this_thread::get_id();
+
+    // Look for an arena that has already been given to this thread
+    uint32 nbArenas = mNbUsedArenas.load(std::memory_order_acquire);
+    if (nbArenas > MAX_NB_ARENAS) nbArenas = MAX_NB_ARENAS;
+    for (uint32 i = 0; i < nbArenas; i++) {
+        if (mArenas[i].ownerThread.load(std::memory_order_acquire) == threadId) {
+            mThreadArenaCache = {mId, i};
+            return &mArenas[i];
+        }
+    }
+
+    // Give a new arena to this thread
+    const uint32 arenaIndex = mNbUsedArenas.fetch_add(1, std::memory_order_acq_rel);
+    if (arenaIndex >= MAX_NB_ARENAS) {
+
+        // There is no arena left, the allocations of this thread will use chunks
+        mThreadArenaCache = {mId, MAX_NB_ARENAS};
+        return nullptr;
+    }
+
+    FrameArena& arena = mArenas[arenaIndex];
+    arena.totalSizeBytes = INIT_SINGLE_FRAME_ALLOCATOR_NB_BYTES;
+    arena.memoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(arena.totalSizeBytes));
+    assert(arena.memoryBufferStart != nullptr);
+    arena.currentLocation = arena.memoryBufferStart;
+    arena.endLocation = arena.memoryBufferStart + arena.totalSizeBytes;
+    arena.ownerThread.store(threadId, std::memory_order_release);
+
+    mThreadArenaCache = {mId, arenaIndex};
+
+    return &arena;
+}
+
+// Allocate a new chunk of memory and add it into the list of chunks
+/**
+ * @param size Size (in bytes) of usable memory in the chunk
+ * @return A pointer to the usable memory of the chunk
+ */
+char* SingleFrameAllocator::allocateChunk(size_t size) {
+
+    const size_t chunkSize = sizeof(ChunkHeader) + size;
+    void* memory = mBaseAllocator.allocate(chunkSize);
+    assert(memory != nullptr);
+
+    ChunkHeader* chunk = new (memory) ChunkHeader();
+    chunk->size = chunkSize;
+
+    // Push the chunk at the beginning of the list of chunks without lock
+    chunk->nextChunk = mChunks.load(std::memory_order_relaxed);
+    while (!mChunks.compare_exchange_weak(chunk->nextChunk, chunk, std::memory_order_release, std::memory_order_relaxed)) {}
+
+    return reinterpret_cast<char*>(chunk) + sizeof(ChunkHeader);
+}
 
 // Allocate memory of a given size (in bytes) and return a pointer to the
 // allocated memory.
 void* SingleFrameAllocator::allocate(size_t size) {
+    return allocate(size, ALIGNMENT);
+}
+
+// Allocate memory of a given size (in bytes) aligned on a given alignment
+/**
+ * @param size Size (in bytes) of the memory to allocate
+ * @param alignment Alignment (in bytes, power of two) of the memory to allocate
+ * @return A pointer to the allocated memory
+ */
+void* SingleFrameAllocator::allocate(size_t size, size_t alignment) {
+
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    RP3D_TRACE_ALLOCATION(Frame, size);
+
+    if (alignment < ALIGNMENT) {
+        alignment = ALIGNMENT;
+    }
+
+    // Round up the size to keep all the allocations aligned
+    size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    FrameArena* arena = getThreadArena();
+
+    // If the thread does not have an arena, the memory is allocated in a new chunk
+    if (arena == nullptr) {
+        mChunksAllocatedBytes.fetch_add(size + alignment - 1, std::memory_order_relaxed);
+        return alignLocation(allocateChunk(size + alignment - 1), alignment);
+    }
 
-    // Lock the method with a mutex
-    std::lock_guard<std::mutex> lock(mMutex);
+    char* location = alignLocation(arena->currentLocation, alignment);
 
     // Check that there is enough remaining memory in the buffer
-    if (mCurrentOffset + size > mTotalSizeBytes) {
+    if (location > arena->endLocation || size > static_cast<size_t>(arena->endLocation - location)) {
 
-        // We need to allocate more memory next time reset() is called
-        mNeedToAllocatedMore = true;
+        // Continue the allocations of this frame into a new chunk
+        const size_t chunkSize = std::max(size + alignment - 1, arena->totalSizeBytes);
+        arena->currentLocation = allocateChunk(chunkSize);
+        arena->endLocation = arena->currentLocation + chunkSize;
 
-        // Return default memory allocation
-        return mBaseAllocator.allocate(size);
+        location = alignLocation(arena->currentLocation, alignment);
     }
 
-    // Next available memory location
-    void* nextAvailableMemory = mMemoryBufferStart + mCurrentOffset;
+    arena->nbAllocatedBytes += static_cast<size_t>(location - arena->currentLocation) + size;
 
-    // Increment the offset
-    mCurrentOffset += size;
+    // Increment the current location
+    arena->currentLocation = location + size;
 
-    // Return the next available memory location
-    return nextAvailableMemory;
+    // Return the aligned memory location
+    return location;
 }
 
 // Release previously allocated memory.
-void SingleFrameAllocator::release(void* pointer, size_t size) {
+/// The memory is actually released for the whole frame in the reset() method.
+void SingleFrameAllocator::release(void* /*pointer*/, size_t /*size*/) {
 
-    // Lock the method with a mutex
-    std::lock_guard<std::mutex> lock(mMutex);
+}
 
-    // If allocated memory is not within the single frame allocation range
-    char* p = static_cast<char*>(pointer);
-    if (p < mMemoryBufferStart || p > mMemoryBufferStart + mTotalSizeBytes) {
+// Release previously allocated memory with the allocate(size, alignment) method
+/// The memory is actually released for the whole frame in the reset() method.
+void SingleFrameAllocator::release(void* /*pointer*/, size_t /*size*/, size_t /*alignment*/) {
 
-        // Use default deallocation
-        mBaseAllocator.release(pointer, size);
-    }
 }
 
 // Reset the marker of the current allocated memory
 void SingleFrameAllocator::reset() {
 
-    // Lock the method with a mutex
-    std::lock_guard<std::mutex> lock(mMutex);
+    // Update the largest memory allocated during a frame
+    const size_t usedMemory = computeUsedMemory();
+    if (usedMemory > mPeakUsedMemory) {
+        mPeakUsedMemory = usedMemory;
+    }
+    mChunksAllocatedBytes.store(0, std::memory_order_relaxed);
 
-    // If too much memory is allocated
-    if (mCurrentOffset < mTotalSizeBytes / 2) {
+    // Release the chunks allocated during the frame
+    ChunkHeader* chunk = mChunks.exchange(nullptr, std::memory_order_acquire);
+    while (chunk != nullptr) {
 
-        mNbFramesTooMuchAllocated++;
+        ChunkHeader* nextChunk = chunk->nextChunk;
+        const size_t chunkSize = chunk->size;
 
-        if (mNbFramesTooMuchAllocated > NB_FRAMES_UNTIL_SHRINK) {
+        chunk->~ChunkHeader();
+        mBaseAllocator.release(static_cast<void*>(chunk), chunkSize);
 
-            // Release the memory allocated at the beginning
-            mBaseAllocator.release(mMemoryBufferStart, mTotalSizeBytes);
+        chunk = nextChunk;
+    }
+
+    uint32 nbArenas = mNbUsedArenas.load(std::memory_order_acquire);
+    if (nbArenas > MAX_NB_ARENAS) nbArenas = MAX_NB_ARENAS;
+    for (uint32 i = 0; i < nbArenas; i++) {
+
+        FrameArena& arena = mArenas[i];
+
+        // If the buffer was too small for the frame
+        if (arena.nbAllocatedBytes > arena.totalSizeBytes) {
 
-            // Divide the total memory to allocate by two
-            mTotalSizeBytes /= 2;
-            if (mTotalSizeBytes == 0) mTotalSizeBytes = 1;
+            // Release the buffer
+            mBaseAllocator.release(arena.memoryBufferStart, arena.totalSizeBytes);
 
-            // Allocate a whole block of memory at the beginning
-            mMemoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(mTotalSizeBytes));
-            assert(mMemoryBufferStart != nullptr);
+            // Multiply the size of the buffer by two until the whole frame fits in it
+            while (arena.totalSizeBytes < arena.nbAllocatedBytes) {
+                arena.totalSizeBytes *= 2;
+            }
 
-            mNbFramesTooMuchAllocated = 0;
+            // Allocate a new buffer
+            arena.memoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(arena.totalSizeBytes));
+            assert(arena.memoryBufferStart != nullptr);
+
+            arena.nbFramesTooMuchAllocated = 0;
         }
+        // If too much memory is allocated
+        else if (arena.nbAllocatedBytes < arena.totalSizeBytes / 2) {
+
+            arena.nbFramesTooMuchAllocated++;
+
+            if (arena.nbFramesTooMuchAllocated > NB_FRAMES_UNTIL_SHRINK && arena.totalSizeBytes > ALIGNMENT) {
+
+                // Release the buffer
+                mBaseAllocator.release(arena.memoryBufferStart, arena.totalSizeBytes);
+
+                // Divide the size of the buffer by two
+                arena.totalSizeBytes /= 2;
+
+                // Allocate a new buffer
+                arena.memoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(arena.totalSizeBytes));
+                assert(arena.memoryBufferStart != nullptr);
+
+                arena.nbFramesTooMuchAllocated = 0;
+            }
+        }
+        else {
+            arena.nbFramesTooMuchAllocated = 0;
+        }
+
+        // Reset the current location at the beginning of the buffer
+        arena.currentLocation = arena.memoryBufferStart;
+        arena.endLocation = arena.memoryBufferStart + arena.totalSizeBytes;
+        arena.nbAllocatedBytes = 0;
     }
-    else {
-        mNbFramesTooMuchAllocated = 0;
+}
+
+// Return the memory (in bytes) allocated during the current frame
+size_t SingleFrameAllocator::computeUsedMemory() const {
+
+    size_t usedMemory = mChunksAllocatedBytes.load(std::memory_order_relaxed);
+
+    uint32 nbArenas = mNbUsedArenas.load(std::memory_order_acquire);
+    if (nbArenas > MAX_NB_ARENAS) nbArenas = MAX_NB_ARENAS;
+    for (uint32 i = 0; i < nbArenas; i++) {
+        usedMemory += mArenas[i].nbAllocatedBytes;
     }
 
-    // If we need to allocate more memory
-    if (mNeedToAllocatedMore) {
+    return usedMemory;
+}
 
-        // Release the memory allocated at the beginning
-        mBaseAllocator.release(mMemoryBufferStart, mTotalSizeBytes);
+// Return the memory usage of the allocator
+/// The reserved memory is the memory of the buffers of the arenas and of the chunks allocated
+/// during the current frame. The used memory is the memory allocated during the current frame
+/// and the peak used memory is the largest memory allocated during a single frame. Like the
+/// reset() method, this method must not be called while other threads allocate memory.
+MemoryUsage SingleFrameAllocator::getMemoryUsage() const {
 
-        // Multiply the total memory to allocate by two
-        mTotalSizeBytes *= 2;
+    size_t reservedMemory = 0;
 
-        // Allocate a whole block of memory at the beginning
-        mMemoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(mTotalSizeBytes));
-        assert(mMemoryBufferStart != nullptr);
+    uint32 nbArenas = mNbUsedArenas.load(std::memory_order_acquire);
+    if (nbArenas > MAX_NB_ARENAS) nbArenas = MAX_NB_ARENAS;
+    for (uint32 i = 0; i < nbArenas; i++) {
+        reservedMemory += mArenas[i].totalSizeBytes;
+    }
 
-        mNeedToAllocatedMore = false;
-        mNbFramesTooMuchAllocated = 0;
+    for (ChunkHeader* chunk = mChunks.load(std::memory_order_acquire); chunk != nullptr; chunk = chunk->nextChunk) {
+        reservedMemory += chunk->size;
     }
 
-    // Reset the current offset at the beginning of the block
-    mCurrentOffset = 0;
+    const size_t usedMemory = computeUsedMemory();
+
+    return MemoryUsage(reservedMemory, usedMemory, usedMemory > mPeakUsedMemory ? usedMemory : mPeakUsedMemory);
 }
@@ -0,0 +1,468 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/memory/TLSFHeapAllocator.h>
+#include <reactphysics3d/memory/AllocationTracer.h>
+#include <new>
+
+#if defined(RP3D_COMPILER_VISUAL_STUDIO)
+    #include <intrin.h>
+#endif
+
+using namespace reactphysics3d;
+
+// Constructor
+TLSFHeapAllocator::TLSFHeapAllocator(MemoryAllocator& baseAllocator, size_t initAllocatedMemory)
+                  : mBaseAllocator(baseAllocator), mInitAllocatedMemory(initAllocatedMemory == 0 ? INIT_ALLOCATED_SIZE : initAllocatedMemory),
+                    mAllocatedMemory(0), mLargeAllocatedMemory(0), mUsedMemory(0), mPeakUsedMemory(0),
+                    mChunks(nullptr), mFirstLevelBitmap(0) {
+
+#ifndef NDEBUG
+        mNbTimesAllocateMethodCalled = 0;
+#endif
+
+    for (uint32 i = 0; i < FL_INDEX_COUNT; i++) {
+        mSecondLevelBitmaps[i] = 0;
+        for (uint32 j = 0; j < SL_INDEX_COUNT; j++) {
+            mFreeBlocks[i][j] = nullptr;
+        }
+    }
+}
+
+// Destructor
+TLSFHeapAllocator::~TLSFHeapAllocator() {
+
+#ifndef NDEBUG
+        // Check that the allocate() and release() methods have been called the same
+        // number of times to avoid memory leaks.
+        assert(mNbTimesAllocateMethodCalled == 0);
+#endif
+
+    // Release the chunks of memory
+    ChunkHeader* chunk = mChunks;
+    while (chunk != nullptr) {
+
+        ChunkHeader* nextChunk = chunk->nextChunk;
+        const size_t chunkSize = chunk->size;
+
+        chunk->~ChunkHeader();
+        mBaseAllocator.release(static_cast<void*>(chunk), chunkSize);
+
+        chunk = nextChunk;
+    }
+}
+
+// Return the index of the least significant set bit of a non-zero value
+uint32 TLSFHeapAllocator::findFirstSetBit(uint32 value) {
+
+    assert(value != 0);
+
+#if defined(RP3D_COMPILER_VISUAL_STUDIO)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return static_cast<uint32>(index);
+#elif defined(RP3D_COMPILER_GCC) || defined(RP3D_COMPILER_CLANG)
+    return static_cast<uint32>(__builtin_ctz(value));
+#else
+    uint32 index = 0;
+    while ((value & 1) == 0) {
+        value >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+// Return the index of the most significant set bit of a non-zero value
+uint32 TLSFHeapAllocator::findLastSetBit(size_t value) {
+
+    assert(value != 0);
+
+#if defined(RP3D_COMPILER_GCC) || defined(RP3D_COMPILER_CLANG)
+    return static_cast<uint32>(sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(static_cast<unsigned long long>(value)));
+#else
+    uint32 index = 0;
+    while (value >>= 1) {
+        index++;
+    }
+    return index;
+#endif
+}
+
+// Compute the first and second level indices of the free list of a given block size
+/**
+ * @param size Size (in bytes) of the block
+ * @param[out] firstLevelIndex First level index of the free list
+ * @param[out] secondLevelIndex Second level index of the free list
+ */
+void TLSFHeapAllocator::computeFreeListIndices(size_t size, uint32& firstLevelIndex, uint32& secondLevelIndex) {
+
+    // Small blocks are linearly distributed in the first level zero
+    if (size < SMALL_BLOCK_SIZE) {
+        firstLevelIndex = 0;
+        secondLevelIndex = static_cast<uint32>(size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT));
+    }
+    else {
+        const uint32 lastSetBit = findLastSetBit(size);
+        secondLevelIndex = static_cast<uint32>(size >> (lastSetBit - SL_INDEX_COUNT_LOG2)) ^ SL_INDEX_COUNT;
+        firstLevelIndex = lastSetBit - (FL_INDEX_SHIFT - 1);
+    }
+
+    assert(firstLevelIndex < FL_INDEX_COUNT);
+    assert(secondLevelIndex < SL_INDEX_COUNT);
+}
+
+// Insert a free block into its free list
+void TLSFHeapAllocator::insertFreeBlock(BlockHeader* block) {
+
+    assert(block->isFree);
+
+    uint32 firstLevelIndex, secondLevelIndex;
+    computeFreeListIndices(block->size, firstLevelIndex, secondLevelIndex);
+
+    BlockHeader* head = mFreeBlocks[firstLevelIndex][secondLevelIndex];
+    block->previousFreeBlock = nullptr;
+    block->nextFreeBlock = head;
+    if (head != nullptr) {
+        head->previousFreeBlock = block;
+    }
+    mFreeBlocks[firstLevelIndex][secondLevelIndex] = block;
+
+    mFirstLevelBitmap |= (1u << firstLevelIndex);
+    mSecondLevelBitmaps[firstLevelIndex] |= (1u << secondLevelIndex);
+}
+
+// Remove a free block from its free list
+void TLSFHeapAllocator::removeFreeBlock(BlockHeader* block) {
+
+    assert(block->isFree);
+
+    uint32 firstLevelIndex, secondLevelIndex;
+    computeFreeListIndices(block->size, firstLevelIndex, secondLevelIndex);
+
+    if (block->previousFreeBlock != nullptr) {
+        block->previousFreeBlock->nextFreeBlock = block->nextFreeBlock;
+    }
+    else {
+        assert(mFreeBlocks[firstLevelIndex][secondLevelIndex] == block);
+        mFreeBlocks[firstLevelIndex][secondLevelIndex] = block->nextFreeBlock;
+
+        // If the free list is now empty, we clear its bit in the bitmaps
+        if (block->nextFreeBlock == nullptr) {
+            mSecondLevelBitmaps[firstLevelIndex] &= ~(1u << secondLevelIndex);
+            if (mSecondLevelBitmaps[firstLevelIndex] == 0) {
+                mFirstLevelBitmap &= ~(1u << firstLevelIndex);
+            }
+        }
+    }
+    if (block->nextFreeBlock != nullptr) {
+        block->nextFreeBlock->previousFreeBlock = block->previousFreeBlock;
+    }
+
+    block->nextFreeBlock = nullptr;
+    block->previousFreeBlock = nullptr;
+}
+
+// Find and remove a free block with a memory size of at least "size" bytes
+/**
+ * @param size Requested size (in bytes)
+ * @return A pointer to the free block or nullptr if there is no large enough free block
+ */
+TLSFHeapAllocator::BlockHeader* TLSFHeapAllocator::findFreeBlock(size_t size) {
+
+    // Round up the size to the next free list so that any block of this
+    // free list is large enough for the request
+    if (size >= SMALL_BLOCK_SIZE) {
+        size += (size_t(1) << (findLastSetBit(size) - SL_INDEX_COUNT_LOG2)) - 1;
+    }
+
+    uint32 firstLevelIndex, secondLevelIndex;
+    computeFreeListIndices(size, firstLevelIndex, secondLevelIndex);
+
+    // Look for a non-empty free list in the same first level range
+    uint32 secondLevelMap = mSecondLevelBitmaps[firstLevelIndex] & (~0u << secondLevelIndex);
+    if (secondLevelMap == 0) {
+
+        // Look for a non-empty free list in a larger first level range
+        const uint32 firstLevelMap = firstLevelIndex + 1 < 32 ? mFirstLevelBitmap & (~0u << (firstLevelIndex + 1)) : 0;
+        if (firstLevelMap == 0) {
+            return nullptr;
+        }
+
+        firstLevelIndex = findFirstSetBit(firstLevelMap);
+        secondLevelMap = mSecondLevelBitmaps[firstLevelIndex];
+    }
+
+    secondLevelIndex = findFirstSetBit(secondLevelMap);
+
+    BlockHeader* block = mFreeBlocks[firstLevelIndex][secondLevelIndex];
+    assert(block != nullptr);
+
+    removeFreeBlock(block);
+
+    return block;
+}
+
+// Split a block so that it keeps "size" bytes and put the left over space into a free block
+void TLSFHeapAllocator::splitBlock(BlockHeader* block, size_t size) {
+
+    assert(block->size >= size);
+
+    // If the left over space is too small to hold another block, we keep it in the block
+    if (block->size - size < sizeof(BlockHeader) + MIN_BLOCK_SIZE) {
+        return;
+    }
+
+    // Create a new free block with the left over space
+    unsigned char* newBlockLocation = static_cast<unsigned char*>(getBlockMemory(block)) + size;
+    BlockHeader* newBlock = new (static_cast<void*>(newBlockLocation)) BlockHeader();
+    newBlock->size = block->size - size - sizeof(BlockHeader);
+    newBlock->previousPhysicalBlock = block;
+    newBlock->isFree = true;
+    newBlock->isLastPhysicalBlock = block->isLastPhysicalBlock;
+    if (!newBlock->isLastPhysicalBlock) {
+        getNextPhysicalBlock(newBlock)->previousPhysicalBlock = newBlock;
+    }
+
+    block->size = size;
+    block->isLastPhysicalBlock = false;
+
+    insertFreeBlock(newBlock);
+}
+
+// Reserve a new chunk of memory that contains a free block of at least "size" bytes
+void TLSFHeapAllocator::reserve(size_t size) {
+
+    // The heap grows geometrically with the allocated memory
+    size_t blockSize = mAllocatedMemory == 0 ? mInitAllocatedMemory : mAllocatedMemory;
+    if (blockSize < size) {
+        blockSize = size;
+    }
+
+    // A single block cannot be larger than the largest free list
+    const size_t maxBlockSize = (size_t(1) << FL_INDEX_MAX) - ALIGNMENT;
+    if (blockSize > maxBlockSize) {
+        blockSize = maxBlockSize;
+    }
+    blockSize = (blockSize + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    assert(blockSize >= size);
+
+    const size_t chunkSize = sizeof(ChunkHeader) + sizeof(BlockHeader) + blockSize;
+
+    // Allocate memory
+    RP3D_TRACE_ALLOCATION(Base, chunkSize);
+    void* memory = mBaseAllocator.allocate(chunkSize);
+    assert(memory != nullptr);
+
+    // Add the chunk at the beginning of the linked-list of chunks
+    ChunkHeader* chunk = new (memory) ChunkHeader();
+    chunk->nextChunk = mChunks;
+    chunk->size = chunkSize;
+    mChunks = chunk;
+
+    // Create a single free block with the memory of the chunk
+    BlockHeader* block = new (static_cast<void*>(reinterpret_cast<unsigned char*>(chunk) + sizeof(ChunkHeader))) BlockHeader();
+    block->size = blockSize;
+    block->previousPhysicalBlock = nullptr;
+    block->isFree = true;
+    block->isLastPhysicalBlock = true;
+
+    insertFreeBlock(block);
+
+    mAllocatedMemory += chunkSize;
+}
+
+// Allocate memory of a given size (in bytes) and return a pointer to the
+// allocated memory.
+void* TLSFHeapAllocator::allocate(size_t size) {
+
+    assert(size > 0);
+
+    // We cannot allocate zero bytes
+    if (size == 0) return nullptr;
+
+    RP3D_TRACE_ALLOCATION(Heap, size);
+
+    // Lock the method with a mutex
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Very large allocations are directly forwarded to the base allocator
+    if (size >= LARGE_ALLOCATION_SIZE) {
+        mLargeAllocatedMemory += size;
+        updatePeakUsedMemory();
+        RP3D_TRACE_ALLOCATION(Base, size);
+        return mBaseAllocator.allocate(size);
+    }
+
+#ifndef NDEBUG
+        mNbTimesAllocateMethodCalled++;
+#endif
+
+    // Round up the size to keep all the blocks aligned
+    size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    if (size < MIN_BLOCK_SIZE) {
+        size = MIN_BLOCK_SIZE;
+    }
+
+    BlockHeader* block = findFreeBlock(size);
+
+    // If there is no large enough free block, we need to reserve more memory
+    if (block == nullptr) {
+
+        reserve(size + (size >= SMALL_BLOCK_SIZE ? (size_t(1) << (findLastSetBit(size) - SL_INDEX_COUNT_LOG2)) : 0));
+
+        block = findFreeBlock(size);
+        assert(block != nullptr);
+    }
+
+    assert(block->size >= size);
+
+    splitBlock(block, size);
+
+    block->isFree = false;
+
+    mUsedMemory += block->size;
+    updatePeakUsedMemory();
+
+    return getBlockMemory(block);
+}
+
+// Release previously allocated memory.
+void TLSFHeapAllocator::release(void* pointer, size_t size) {
+
+    assert(size > 0);
+
+    // Cannot release a 0-byte allocated memory
+    if (size == 0) return;
+
+    // Lock the method with a mutex
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Very large allocations have been directly allocated with the base allocator
+    if (size >= LARGE_ALLOCATION_SIZE) {
+        assert(mLargeAllocatedMemory >= size);
+        mLargeAllocatedMemory -= size;
+        mBaseAllocator.release(pointer, size);
+        return;
+    }
+
+#ifndef NDEBUG
+        mNbTimesAllocateMethodCalled--;
+#endif
+
+    BlockHeader* block = reinterpret_cast<BlockHeader*>(static_cast<unsigned char*>(pointer) - sizeof(BlockHeader));
+    assert(!block->isFree);
+    assert(block->size >= size);
+    block->isFree = true;
+
+    assert(mUsedMemory >= block->size);
+    mUsedMemory -= block->size;
+
+    // Merge the block with the previous physical block if it is free
+    BlockHeader* previousBlock = block->previousPhysicalBlock;
+    if (previousBlock != nullptr && previousBlock->isFree) {
+
+        removeFreeBlock(previousBlock);
+
+        previousBlock->size += sizeof(BlockHeader) + block->size;
+        previousBlock->isLastPhysicalBlock = block->isLastPhysicalBlock;
+        if (!previousBlock->isLastPhysicalBlock) {
+            getNextPhysicalBlock(previousBlock)->previousPhysicalBlock = previousBlock;
+        }
+
+        block->~BlockHeader();
+        block = previousBlock;
+    }
+
+    // Merge the block with the next physical block if it is free
+    if (!block->isLastPhysicalBlock) {
+
+        BlockHeader* nextBlock = getNextPhysicalBlock(block);
+        if (nextBlock->isFree) {
+
+            removeFreeBlock(nextBlock);
+
+            block->size += sizeof(BlockHeader) + nextBlock->size;
+            block->isLastPhysicalBlock = nextBlock->isLastPhysicalBlock;
+            if (!block->isLastPhysicalBlock) {
+                getNextPhysicalBlock(block)->previousPhysicalBlock = block;
+            }
+
+            nextBlock->~BlockHeader();
+        }
+    }
+
+    insertFreeBlock(block);
+}
+
+// Allocate memory of a given size (in bytes) aligned on a given alignment
+/**
+ * @param size Size (in bytes) of the memory to allocate
+ * @param alignment Alignment (in bytes, power of two) of the memory to allocate
+ * @return A pointer to the allocated memory
+ */
+void* TLSFHeapAllocator::allocate(size_t size, size_t alignment) {
+
+    // The memory of the blocks is already aligned on ALIGNMENT bytes
+    if (alignment <= ALIGNMENT) {
+        return allocate(size);
+    }
+
+    return MemoryAllocator::allocate(size, alignment);
+}
+
+// Release previously allocated memory with the allocate(size, alignment) method
+void TLSFHeapAllocator::release(void* pointer, size_t size, size_t alignment) {
+
+    if (alignment <= ALIGNMENT) {
+        release(pointer, size);
+        return;
+    }
+
+    MemoryAllocator::release(pointer, size, alignment);
+}
+
+// Update the largest used memory with the current used memory
+/// The mutex must be locked when this method is called.
+void TLSFHeapAllocator::updatePeakUsedMemory() {
+
+    const size_t usedMemory = mUsedMemory + mLargeAllocatedMemory;
+    if (usedMemory > mPeakUsedMemory) {
+        mPeakUsedMemory = usedMemory;
+    }
+}
+
+// Return the memory usage of the allocator
+/// The reserved memory is the memory of the chunks obtained from the base allocator and the
+/// used memory is the memory of the allocated blocks. The large allocations that are forwarded
+/// to the base allocator are counted in both.
+MemoryUsage TLSFHeapAllocator::getMemoryUsage() const {
+
+    // Lock the method with a mutex
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    return MemoryUsage(mAllocatedMemory + mLargeAllocatedMemory, mUsedMemory + mLargeAllocatedMemory, mPeakUsedMemory);
+}
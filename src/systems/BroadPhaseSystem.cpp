@@ -27,6 +27,7 @@
 #include <reactphysics3d/systems/BroadPhaseSystem.h>
 #include <reactphysics3d/systems/CollisionDetectionSystem.h>
 #include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/utils/Instrumentation.h>
 #include <reactphysics3d/collision/RaycastInfo.h>
 #include <reactphysics3d/memory/MemoryManager.h>
 #include <reactphysics3d/engine/PhysicsWorld.h>
@@ -34,13 +35,19 @@
 // We want to use the ReactPhysics3D namespace
 using namespace reactphysics3d;
 
+// Static members
+const int32 BroadPhaseSystem::COMPOUND_BROADPHASE_ID_OFFSET = 1 << 29;
+const uint64 BroadPhaseSystem::MOVED_SHAPES_MIN_CAPACITY_TO_RELEASE = 1024;
+
 // Constructor
 BroadPhaseSystem::BroadPhaseSystem(CollisionDetectionSystem& collisionDetection, ColliderComponents& collidersComponents,
                                    TransformComponents& transformComponents, RigidBodyComponents& rigidBodyComponents)
                     :mDynamicAABBTree(collisionDetection.getMemoryManager().getHeapAllocator(), DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE),
                      mCollidersComponents(collidersComponents), mTransformsComponents(transformComponents),
                      mRigidBodyComponents(rigidBodyComponents), mMovedShapes(collisionDetection.getMemoryManager().getHeapAllocator()),
-                     mCollisionDetection(collisionDetection) {
+                     mCollisionDetection(collisionDetection), mAllocator(collisionDetection.getMemoryManager().getHeapAllocator()),
+                     mCompoundBodies(mAllocator), mMapNodeIdToCompoundBody(mAllocator), mCompoundColliders(mAllocator),
+                     mFreeCompoundColliders(mAllocator), mCompoundNodePairs(mAllocator), mCompoundNodePairsIds(mAllocator) {
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -51,6 +58,120 @@ BroadPhaseSystem::BroadPhaseSystem(CollisionDetectionSystem& collisionDetection,
 
 }
 
+// Destructor
+BroadPhaseSystem::~BroadPhaseSystem() {
+
+    // Release the remaining compound body proxies
+    for (auto it = mCompoundBodies.begin(); it != mCompoundBodies.end(); ++it) {
+
+        CompoundBodyProxy* bodyProxy = it->second;
+        bodyProxy->~CompoundBodyProxy();
+        mAllocator.release(bodyProxy, sizeof(CompoundBodyProxy));
+    }
+}
+
+// Reserve memory for a given number of colliders
+/**
+ * @param nbColliders The number of colliders that can be added without any new allocation of tree nodes
+ */
+void BroadPhaseSystem::reserve(uint32 nbColliders) {
+
+    // A binary tree with n leaves has 2n - 1 nodes
+    if (nbColliders > 0) {
+        mDynamicAABBTree.reserve(static_cast<int32>(2 * nbColliders - 1));
+    }
+}
+
+// Compact the nodes of the broad-phase tree and update the broad-phase IDs
+/// The nodes of the tree are moved into memory that fits them (see DynamicAABBTree::compact()).
+/// Therefore, the broad-phase IDs of the colliders change. The new ID of each previous node ID is
+/// returned so that the overlapping pairs can be updated. The broad-phase IDs of the colliders of
+/// bodies in compound mode do not change.
+/**
+ * @param outNewNodeIds Array where the new ID of each previous node ID is stored (empty if the IDs have not changed)
+ */
+void BroadPhaseSystem::compact(Array<int32>& outNewNodeIds) {
+
+    mDynamicAABBTree.compact(outNewNodeIds);
+
+    if (outNewNodeIds.size() > 0) {
+
+        // Update the broad-phase IDs of the colliders
+        for (uint32 i=0; i < mCollidersComponents.getNbComponents(); i++) {
+
+            const int32 broadPhaseId = mCollidersComponents.mBroadPhaseIds[i];
+            if (broadPhaseId != -1 && !isCompoundBroadPhaseId(broadPhaseId)) {
+                mCollidersComponents.mBroadPhaseIds[i] = outNewNodeIds[broadPhaseId];
+            }
+        }
+
+        // Update the moved shapes
+        Array<int> movedShapes = mMovedShapes.toArray(mAllocator);
+        mMovedShapes.clear(true);
+        for (uint64 i=0; i < movedShapes.size(); i++) {
+            mMovedShapes.add(outNewNodeIds[movedShapes[i]]);
+        }
+
+        // Update the nodes of the bodies in compound mode
+        mMapNodeIdToCompoundBody.clear();
+        for (auto it = mCompoundBodies.begin(); it != mCompoundBodies.end(); ++it) {
+
+            CompoundBodyProxy* bodyProxy = it->second;
+            if (bodyProxy->broadPhaseNodeId != -1) {
+                bodyProxy->broadPhaseNodeId = outNewNodeIds[bodyProxy->broadPhaseNodeId];
+                mMapNodeIdToCompoundBody.add(Pair<int32, CompoundBodyProxy*>(bodyProxy->broadPhaseNodeId, bodyProxy));
+            }
+        }
+
+        // Update the node pairs involving compound bodies
+        mCompoundNodePairsIds.clear();
+        for (uint64 i=0; i < mCompoundNodePairs.size(); i++) {
+
+            const int32 nodeId1 = outNewNodeIds[mCompoundNodePairs[i].first];
+            const int32 nodeId2 = outNewNodeIds[mCompoundNodePairs[i].second];
+            const int32 maxNodeId = std::max(nodeId1, nodeId2);
+            const int32 minNodeId = std::min(nodeId1, nodeId2);
+            mCompoundNodePairs[i] = Pair<int32, int32>(maxNodeId, minNodeId);
+            mCompoundNodePairsIds.add(pairNumbers(static_cast<uint32>(maxNodeId), static_cast<uint32>(minNodeId)));
+        }
+    }
+
+    mMovedShapes.shrinkToFit();
+    mMapNodeIdToCompoundBody.shrinkToFit();
+    mCompoundNodePairs.shrinkToFit();
+    mCompoundNodePairsIds.shrinkToFit();
+}
+
+// Return the colliders in the order of their nodes in the broad-phase tree
+/// After a call to compact(), the nodes are in depth-first order and the colliders that are
+/// close in space are also close in this order. The colliders of a body in compound mode are
+/// returned together at the location of the node of the body.
+/**
+ * @param outColliders Array where the entities of the colliders are added
+ */
+void BroadPhaseSystem::getCollidersInTreeOrder(Array<Entity>& outColliders) const {
+
+    const TreeNode* nodes = mDynamicAABBTree.getNodes();
+    const int32 nbAllocatedNodes = mDynamicAABBTree.getNbAllocatedNodes();
+    for (int32 nodeId=0; nodeId < nbAllocatedNodes; nodeId++) {
+
+        // If the node is not a leaf (or is a free node)
+        if (!nodes[nodeId].isLeaf()) continue;
+
+        auto it = mMapNodeIdToCompoundBody.find(nodeId);
+        if (it != mMapNodeIdToCompoundBody.end()) {
+
+            const CompoundBodyProxy* bodyProxy = it->second;
+            for (uint64 i=0; i < bodyProxy->colliderIndices.size(); i++) {
+                outColliders.add(mCompoundColliders[bodyProxy->colliderIndices[i]].collider->getEntity());
+            }
+        }
+        else {
+            outColliders.add(static_cast<Collider*>(nodes[nodeId].dataPointer)->getEntity());
+        }
+    }
+}
+
 // Return true if the two broad-phase collision shapes are overlapping
 bool BroadPhaseSystem::testOverlappingShapes(int32 shape1BroadPhaseId, int32 shape2BroadPhaseId) const {
 
@@ -58,6 +179,11 @@ bool BroadPhaseSystem::testOverlappingShapes(int32 shape1BroadPhaseId, int32 sha
 
     assert(shape1BroadPhaseId != -1 && shape2BroadPhaseId != -1);
 
+    // The AABB of a collider of a compound body has to be computed from the local tree of the body
+    if (isCompoundBroadPhaseId(shape1BroadPhaseId) || isCompoundBroadPhaseId(shape2BroadPhaseId)) {
+        return getFatAABB(shape1BroadPhaseId).testCollision(getFatAABB(shape2BroadPhaseId));
+    }
+
     // Get the two AABBs of the collision shapes
     const AABB& aabb1 = mDynamicAABBTree.getFatAABB(shape1BroadPhaseId);
     const AABB& aabb2 = mDynamicAABBTree.getFatAABB(shape2BroadPhaseId);
@@ -71,7 +197,7 @@ void BroadPhaseSystem::raycast(const Ray& ray, RaycastTest& raycastTest, unsigne
 
     RP3D_PROFILE("BroadPhaseSystem::raycast()", mProfiler);
 
-    BroadPhaseRaycastCallback broadPhaseRaycastCallback(mDynamicAABBTree, raycastWithCategoryMaskBits, raycastTest);
+    BroadPhaseRaycastCallback broadPhaseRaycastCallback(*this, raycastWithCategoryMaskBits, raycastTest);
 
     // Compute the inverse ray direction
     const Vector3 rayDirection = ray.point2 - ray.point1;
@@ -85,6 +211,12 @@ void BroadPhaseSystem::addCollider(Collider* collider, const AABB& aabb) {
 
     assert(collider->getBroadPhaseId() == -1);
 
+    // If the body of the collider is in compound mode
+    if (collider->getBody()->isCompound()) {
+        addCompoundCollider(collider);
+        return;
+    }
+
     // Add the collision shape into the dynamic AABB tree and get its broad-phase ID
     int nodeId = mDynamicAABBTree.addObject(aabb, collider);
 
@@ -103,8 +235,19 @@ void BroadPhaseSystem::removeCollider(Collider* collider) {
 
     int broadPhaseID = collider->getBroadPhaseId();
 
+    // If the collider belongs to a body in compound mode
+    if (isCompoundBroadPhaseId(broadPhaseID)) {
+        removeCompoundCollider(collider);
+        return;
+    }
+
     mCollidersComponents.setBroadPhaseId(collider->getEntity(), -1);
 
+    // Remove the pairs between this collider and compound bodies
+    if (mCompoundNodePairs.size() > 0) {
+        removeCompoundNodePairs(broadPhaseID);
+    }
+
     // Remove the collision shape from the dynamic AABB tree
     mDynamicAABBTree.removeObject(broadPhaseID);
 
@@ -121,18 +264,66 @@ void BroadPhaseSystem::updateCollider(Entity colliderEntity) {
     // Get the index of the collider component in the array
     uint32 index = mCollidersComponents.mMapEntityToComponentIndex[colliderEntity];
 
+    // If the collider belongs to a body in compound mode
+    if (isCompoundBroadPhaseId(mCollidersComponents.mBroadPhaseIds[index])) {
+
+        // Update the local AABB of the collider and the broad-phase node of its body
+        updateCompoundCollider(index, mCollidersComponents.mHasCollisionShapeChangedSize[index]);
+        updateCompoundBody(mCompoundColliders[static_cast<uint32>(mCollidersComponents.mBroadPhaseIds[index] - COMPOUND_BROADPHASE_ID_OFFSET)].bodyProxy);
+        mCollidersComponents.mHasCollisionShapeChangedSize[index] = false;
+
+        return;
+    }
+
     // Update the collider component
     updateCollidersComponents(index, 1);
 }
 
-// Update the broad-phase state of all the enabled colliders
-void BroadPhaseSystem::updateColliders() {
+// Update the broad-phase state of the colliders that have moved
+/// Only the colliders of the bodies that have been moved by the dynamics during the
+/// last step are updated here. The static bodies, the sleeping bodies and the bodies that
+/// did not move are skipped. The colliders moved by the user (setTransform(), ...) are
+/// updated immediately with updateCollider().
+/**
+ * @param movedColliders Entities of the colliders of the bodies that have moved
+ */
+void BroadPhaseSystem::updateColliders(const Array<Entity>& movedColliders) {
 
     RP3D_PROFILE("BroadPhaseSystem::updateColliders()", mProfiler);
+    RP3D_INSTRUMENT(UpdateColliders);
+
+    const uint32 nbMovedColliders = static_cast<uint32>(movedColliders.size());
+    for (uint32 i=0; i < nbMovedColliders; i++) {
+
+        const uint32 index = mCollidersComponents.getEntityIndex(movedColliders[i]);
+        const int32 broadPhaseId = mCollidersComponents.mBroadPhaseIds[index];
 
-    // Update all the enabled collider components
-    if (mCollidersComponents.getNbEnabledComponents() > 0) {
-        updateCollidersComponents(0, mCollidersComponents.getNbEnabledComponents());
+        // If the collider belongs to a body in compound mode, we update the broad-phase
+        // node of the body (this does nothing if the node is already up-to-date)
+        if (isCompoundBroadPhaseId(broadPhaseId)) {
+
+            if (mCollidersComponents.mHasCollisionShapeChangedSize[index]) {
+                updateCompoundCollider(index, true);
+                mCollidersComponents.mHasCollisionShapeChangedSize[index] = false;
+            }
+
+            updateCompoundBody(mCompoundColliders[static_cast<uint32>(broadPhaseId - COMPOUND_BROADPHASE_ID_OFFSET)].bodyProxy);
+        }
+        else if (broadPhaseId != -1) {
+
+            // Recompute the world-space AABB of the collision shape
+            AABB aabb;
+            mCollidersComponents.mCollisionShapes[index]->computeAABB(aabb, mCollidersComponents.mLocalToWorldTransforms[index]);
+
+            // If the size of the collision shape has been changed by the user,
+            // we need to reset the broad-phase AABB to its new size
+            const bool forceReInsert = mCollidersComponents.mHasCollisionShapeChangedSize[index];
+
+            // Update the broad-phase state of the collider
+            updateColliderInternal(broadPhaseId, mCollidersComponents.mColliders[index], aabb, forceReInsert);
+
+            mCollidersComponents.mHasCollisionShapeChangedSize[index] = false;
+        }
     }
 }
 
@@ -173,7 +364,18 @@ void BroadPhaseSystem::updateCollidersComponents(uint32 startIndex, uint32 nbIte
     for (uint32 i = startIndex; i < startIndex + nbItems; i++) {
 
         const int32 broadPhaseId = mCollidersComponents.mBroadPhaseIds[i];
-        if (broadPhaseId != -1) {
+
+        // The colliders of the bodies in compound mode are not moved with the body. Only the
+        // broad-phase node of the body is updated (see updateCompoundBody()).
+        if (isCompoundBroadPhaseId(broadPhaseId)) {
+
+            // If the size of the collision shape has been changed by the user
+            if (mCollidersComponents.mHasCollisionShapeChangedSize[i]) {
+                updateCompoundCollider(i, true);
+                mCollidersComponents.mHasCollisionShapeChangedSize[i] = false;
+            }
+        }
+        else if (broadPhaseId != -1) {
 
             const Entity& bodyEntity = mCollidersComponents.mBodiesEntities[i];
             const Transform& transform = mTransformsComponents.getTransform(bodyEntity);
@@ -201,8 +403,18 @@ void BroadPhaseSystem::addMovedCollider(int broadPhaseID, Collider* collider) {
 
     assert(broadPhaseID != -1);
 
-    // Store the broad-phase ID into the array of shapes that have moved
-    mMovedShapes.add(broadPhaseID);
+    // If the collider belongs to a body in compound mode, the node of the body has to be tested
+    if (isCompoundBroadPhaseId(broadPhaseID)) {
+
+        CompoundBodyProxy* bodyProxy = mCompoundColliders[static_cast<uint32>(broadPhaseID - COMPOUND_BROADPHASE_ID_OFFSET)].bodyProxy;
+        mMovedShapes.add(bodyProxy->broadPhaseNodeId);
+        bodyProxy->hasMoved = true;
+    }
+    else {
+
+        // Store the broad-phase ID into the array of shapes that have moved
+        mMovedShapes.add(broadPhaseID);
+    }
 
     // Notify that the overlapping pairs where this shape is involved need to be tested for overlap
     mCollisionDetection.notifyOverlappingPairsToTestOverlap(collider);
@@ -214,14 +426,397 @@ void BroadPhaseSystem::computeOverlappingPairs(MemoryManager& memoryManager, Arr
     RP3D_PROFILE("BroadPhaseSystem::computeOverlappingPairs()", mProfiler);
 
     // Get the array of the colliders that have moved or have been created in the last frame
-    Array<int> shapesToTest = mMovedShapes.toArray(memoryManager.getHeapAllocator());
+    Array<int> shapesToTest = mMovedShapes.toArray(memoryManager.getSingleFrameAllocator());
 
     // Ask the dynamic AABB tree to report all collision shapes that overlap with the shapes to test
     mDynamicAABBTree.reportAllShapesOverlappingWithShapes(shapesToTest, 0, static_cast<uint32>(shapesToTest.size()), overlappingNodes);
 
     // Reset the array of collision shapes that have move (or have been created) during the
-    // last simulation step
-    mMovedShapes.clear();
+    // last simulation step. Clearing and iterating the set costs time proportional to its
+    // capacity. Therefore, if the set has grown much larger than what is now needed (after
+    // the creation of many bodies for instance), we release its memory.
+    const bool releaseMemory = mMovedShapes.capacity() > MOVED_SHAPES_MIN_CAPACITY_TO_RELEASE &&
+                               mMovedShapes.size() * 8 < mMovedShapes.capacity();
+    mMovedShapes.clear(releaseMemory);
+
+    // Expand the overlapping pairs involving compound bodies into pairs of colliders
+    if (mCompoundBodies.size() > 0) {
+        computeCompoundOverlappingPairs(memoryManager, overlappingNodes);
+    }
+}
+
+// Add a collider of a body in compound mode
+void BroadPhaseSystem::addCompoundCollider(Collider* collider) {
+
+    const Entity bodyEntity = collider->getBody()->getEntity();
+
+    // Get or create the proxy of the body
+    CompoundBodyProxy* bodyProxy;
+    auto it = mCompoundBodies.find(bodyEntity);
+    if (it != mCompoundBodies.end()) {
+        bodyProxy = it->second;
+    }
+    else {
+
+        bodyProxy = new (mAllocator.allocate(sizeof(CompoundBodyProxy))) CompoundBodyProxy(bodyEntity, mAllocator);
+        mCompoundBodies.add(Pair<Entity, CompoundBodyProxy*>(bodyEntity, bodyProxy));
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        bodyProxy->localTree.setProfiler(mProfiler);
+
+#endif
+
+    }
+
+    // Get a free slot in the array of compound colliders
+    uint32 colliderIndex;
+    if (mFreeCompoundColliders.size() > 0) {
+        colliderIndex = mFreeCompoundColliders[mFreeCompoundColliders.size() - 1];
+        mFreeCompoundColliders.removeAt(mFreeCompoundColliders.size() - 1);
+    }
+    else {
+        colliderIndex = static_cast<uint32>(mCompoundColliders.size());
+        mCompoundColliders.add(CompoundColliderProxy());
+    }
+
+    // Add the body-space AABB of the collider into the local tree of the body
+    const uint32 componentIndex = mCollidersComponents.getEntityIndex(collider->getEntity());
+    AABB localAABB;
+    mCollidersComponents.mCollisionShapes[componentIndex]->computeAABB(localAABB, mCollidersComponents.mLocalToBodyTransforms[componentIndex]);
+
+    CompoundColliderProxy& colliderProxy = mCompoundColliders[colliderIndex];
+    colliderProxy.bodyProxy = bodyProxy;
+    colliderProxy.collider = collider;
+    colliderProxy.localNodeId = bodyProxy->localTree.addObject(localAABB, static_cast<int32>(colliderIndex), 0);
+    bodyProxy->colliderIndices.add(colliderIndex);
+    bodyProxy->isDirty = true;
+
+    // Set the broad-phase ID of the collider
+    mCollidersComponents.setBroadPhaseId(collider->getEntity(), COMPOUND_BROADPHASE_ID_OFFSET + static_cast<int32>(colliderIndex));
+
+    // Create or update the broad-phase node of the body
+    if (bodyProxy->broadPhaseNodeId == -1) {
+
+        const Transform& transform = mTransformsComponents.getTransform(bodyEntity);
+        AABB aabb = bodyProxy->localTree.getRootAABB();
+        aabb.applyTransform(transform);
+
+        bodyProxy->broadPhaseNodeId = mDynamicAABBTree.addObject(aabb, bodyProxy);
+        bodyProxy->lastTransform = transform;
+        bodyProxy->isDirty = false;
+        mMapNodeIdToCompoundBody.add(Pair<int32, CompoundBodyProxy*>(bodyProxy->broadPhaseNodeId, bodyProxy));
+    }
+    else {
+        updateCompoundBody(bodyProxy);
+    }
+
+    // The node of the body has to be tested again for overlap in order to find the pairs
+    // with the new collider
+    mMovedShapes.add(bodyProxy->broadPhaseNodeId);
+    bodyProxy->hasMoved = true;
+}
+
+// Remove a collider of a body in compound mode
+void BroadPhaseSystem::removeCompoundCollider(Collider* collider) {
+
+    const int32 broadPhaseId = collider->getBroadPhaseId();
+    assert(isCompoundBroadPhaseId(broadPhaseId));
+
+    const uint32 colliderIndex = static_cast<uint32>(broadPhaseId - COMPOUND_BROADPHASE_ID_OFFSET);
+    CompoundColliderProxy& colliderProxy = mCompoundColliders[colliderIndex];
+    CompoundBodyProxy* bodyProxy = colliderProxy.bodyProxy;
+    assert(colliderProxy.collider == collider);
+
+    mCollidersComponents.setBroadPhaseId(collider->getEntity(), -1);
+
+    // Remove the collider from the local tree of the body
+    bodyProxy->localTree.removeObject(colliderProxy.localNodeId);
+    bodyProxy->colliderIndices.remove(colliderIndex);
+    bodyProxy->isDirty = true;
+
+    // Release the slot of the collider
+    colliderProxy.bodyProxy = nullptr;
+    colliderProxy.collider = nullptr;
+    colliderProxy.localNodeId = -1;
+    mFreeCompoundColliders.add(colliderIndex);
+
+    // If the body does not have any collider anymore, we remove its broad-phase node
+    if (bodyProxy->colliderIndices.size() == 0) {
+
+        const int32 nodeId = bodyProxy->broadPhaseNodeId;
+
+        removeCompoundNodePairs(nodeId);
+        mMapNodeIdToCompoundBody.remove(nodeId);
+        mDynamicAABBTree.removeObject(nodeId);
+        removeMovedCollider(nodeId);
+
+        mCompoundBodies.remove(bodyProxy->bodyEntity);
+        bodyProxy->~CompoundBodyProxy();
+        mAllocator.release(bodyProxy, sizeof(CompoundBodyProxy));
+    }
+    else {
+
+        // Shrink the broad-phase node of the body now because it is only refit
+        // later if the body moves
+        updateCompoundBody(bodyProxy);
+    }
+}
+
+// Update the local AABB of a collider of a body in compound mode
+void BroadPhaseSystem::updateCompoundCollider(uint32 colliderComponentIndex, bool forceReInsert) {
+
+    const int32 broadPhaseId = mCollidersComponents.mBroadPhaseIds[colliderComponentIndex];
+    assert(isCompoundBroadPhaseId(broadPhaseId));
+
+    CompoundColliderProxy& colliderProxy = mCompoundColliders[static_cast<uint32>(broadPhaseId - COMPOUND_BROADPHASE_ID_OFFSET)];
+
+    // Recompute the body-space AABB of the collision shape
+    AABB localAABB;
+    mCollidersComponents.mCollisionShapes[colliderComponentIndex]->computeAABB(localAABB, mCollidersComponents.mLocalToBodyTransforms[colliderComponentIndex]);
+
+    if (colliderProxy.bodyProxy->localTree.updateObject(colliderProxy.localNodeId, localAABB, forceReInsert)) {
+        colliderProxy.bodyProxy->isDirty = true;
+    }
+}
+
+// Update the broad-phase node of a body in compound mode
+void BroadPhaseSystem::updateCompoundBody(CompoundBodyProxy* bodyProxy) {
+
+    const Transform& transform = mTransformsComponents.getTransform(bodyProxy->bodyEntity);
+
+    // If the body has not moved and its colliders have not changed, there is nothing to do
+    if (!bodyProxy->isDirty && transform == bodyProxy->lastTransform) return;
+
+    // Compute the world-space AABB of the body from the root of its local tree
+    AABB aabb = bodyProxy->localTree.getRootAABB();
+    aabb.applyTransform(transform);
+
+    // Update the node of the body in the broad-phase tree
+    if (mDynamicAABBTree.updateObject(bodyProxy->broadPhaseNodeId, aabb)) {
+        mMovedShapes.add(bodyProxy->broadPhaseNodeId);
+    }
+
+    // The pairs of colliders of this body are tested again for overlap in computeCompoundOverlappingPairs()
+    // but only for the node pairs of the body (see notifyCompoundNodePairToTestOverlap())
+    bodyProxy->lastTransform = transform;
+    bodyProxy->isDirty = false;
+    bodyProxy->hasMoved = true;
+}
+
+// Remove the compound node pairs that involve a given broad-phase node
+void BroadPhaseSystem::removeCompoundNodePairs(int32 nodeId) {
+
+    for (uint64 i=0; i < mCompoundNodePairs.size(); i++) {
+
+        const Pair<int32, int32>& nodePair = mCompoundNodePairs[i];
+        if (nodePair.first == nodeId || nodePair.second == nodeId) {
+
+            mCompoundNodePairsIds.remove(pairNumbers(static_cast<uint32>(nodePair.first), static_cast<uint32>(nodePair.second)));
+
+            mCompoundNodePairs.removeAtAndReplaceByLast(i);
+            i--;
+        }
+    }
+}
+
+// Expand the overlapping node pairs involving compound bodies into collider pairs
+/// The broad-phase tree reports overlapping pairs of nodes where a node can be the proxy of
+/// a whole compound body. Those pairs are kept between frames as long as the fat AABBs of the two
+/// nodes overlap. Each time such a pair is reported again or one of its compound bodies has moved,
+/// the local tree of the compound body is queried to find the pairs of colliders that overlap.
+void BroadPhaseSystem::computeCompoundOverlappingPairs(MemoryManager& memoryManager, Array<Pair<int32, int32>>& overlappingNodes) {
+
+    RP3D_PROFILE("BroadPhaseSystem::computeCompoundOverlappingPairs()", mProfiler);
+
+    // Node pairs involving compound bodies that have been reported in this frame
+    Set<uint64> reportedPairs(memoryManager.getSingleFrameAllocator());
+
+    // Move the node pairs involving compound bodies from the array of overlapping nodes
+    // into the array of compound node pairs
+    for (uint64 i=0; i < overlappingNodes.size(); i++) {
+
+        const Pair<int32, int32> nodePair = overlappingNodes[i];
+
+        const bool isNode1Compound = mMapNodeIdToCompoundBody.containsKey(nodePair.first);
+        const bool isNode2Compound = mMapNodeIdToCompoundBody.containsKey(nodePair.second);
+        if (isNode1Compound || isNode2Compound) {
+
+            if (nodePair.first != nodePair.second) {
+
+                const int32 maxNodeId = std::max(nodePair.first, nodePair.second);
+                const int32 minNodeId = std::min(nodePair.first, nodePair.second);
+                const uint64 pairId = pairNumbers(static_cast<uint32>(maxNodeId), static_cast<uint32>(minNodeId));
+
+                if (!mCompoundNodePairsIds.contains(pairId)) {
+                    mCompoundNodePairsIds.add(pairId);
+                    mCompoundNodePairs.add(Pair<int32, int32>(maxNodeId, minNodeId));
+                }
+
+                reportedPairs.add(pairId);
+            }
+
+            overlappingNodes.removeAtAndReplaceByLast(i);
+            i--;
+        }
+    }
+
+    Array<int> localNodes(memoryManager.getSingleFrameAllocator());
+
+    // For each node pair involving a compound body
+    for (uint64 i=0; i < mCompoundNodePairs.size(); i++) {
+
+        const Pair<int32, int32> nodePair = mCompoundNodePairs[i];
+        const uint64 pairId = pairNumbers(static_cast<uint32>(nodePair.first), static_cast<uint32>(nodePair.second));
+
+        auto it1 = mMapNodeIdToCompoundBody.find(nodePair.first);
+        auto it2 = mMapNodeIdToCompoundBody.find(nodePair.second);
+        CompoundBodyProxy* bodyProxy1 = it1 != mMapNodeIdToCompoundBody.end() ? it1->second : nullptr;
+        CompoundBodyProxy* bodyProxy2 = it2 != mMapNodeIdToCompoundBody.end() ? it2->second : nullptr;
+        assert(bodyProxy1 != nullptr || bodyProxy2 != nullptr);
+
+        // Make sure that the first proxy is a compound body
+        if (bodyProxy1 == nullptr) {
+            bodyProxy1 = bodyProxy2;
+            bodyProxy2 = nullptr;
+        }
+
+        const int32 otherNodeId = bodyProxy1->broadPhaseNodeId == nodePair.first ? nodePair.second : nodePair.first;
+
+        // If the two nodes are not overlapping anymore, we remove the pair
+        if (!mDynamicAABBTree.getFatAABB(nodePair.first).testCollision(mDynamicAABBTree.getFatAABB(nodePair.second))) {
+
+            // The pairs of colliders between the two nodes might not overlap anymore
+            notifyCompoundNodePairToTestOverlap(bodyProxy1, bodyProxy2, otherNodeId);
+
+            mCompoundNodePairsIds.remove(pairId);
+            mCompoundNodePairs.removeAtAndReplaceByLast(i);
+            i--;
+
+            continue;
+        }
+
+        // If the pair has not been reported in this frame and no compound body of the pair has moved,
+        // the pairs of colliders found previously are still valid
+        const bool hasMoved = bodyProxy1->hasMoved || (bodyProxy2 != nullptr && bodyProxy2->hasMoved);
+        if (!hasMoved && !reportedPairs.contains(pairId)) continue;
+
+        // The pairs of colliders between the two nodes that are not reported again by the
+        // query of the local tree below need to be tested for overlap
+        if (hasMoved) {
+            notifyCompoundNodePairToTestOverlap(bodyProxy1, bodyProxy2, otherNodeId);
+        }
+
+        const Transform& transform1 = mTransformsComponents.getTransform(bodyProxy1->bodyEntity);
+        const Transform worldToBody1 = transform1.getInverse();
+
+        // If the other node is a regular collider
+        if (bodyProxy2 == nullptr) {
+
+            // Query the local tree of the compound body with the AABB of the collider in body-space
+            AABB localAABB = mDynamicAABBTree.getFatAABB(otherNodeId);
+            localAABB.applyTransform(worldToBody1);
+            reportCompoundCollidersOverlappingWithAABB(bodyProxy1, localAABB, otherNodeId, localNodes, overlappingNodes);
+        }
+        else {  // If the two nodes are compound bodies
+
+            // Query the local tree of the body with the most colliders with the colliders of the other body
+            if (bodyProxy2->colliderIndices.size() > bodyProxy1->colliderIndices.size()) {
+                std::swap(bodyProxy1, bodyProxy2);
+            }
+
+            const Transform body2ToBody1 = mTransformsComponents.getTransform(bodyProxy1->bodyEntity).getInverse() *
+                                           mTransformsComponents.getTransform(bodyProxy2->bodyEntity);
+
+            for (uint32 j=0; j < bodyProxy2->colliderIndices.size(); j++) {
+
+                const uint32 colliderIndex2 = bodyProxy2->colliderIndices[j];
+
+                AABB localAABB = bodyProxy2->localTree.getFatAABB(mCompoundColliders[colliderIndex2].localNodeId);
+                localAABB.applyTransform(body2ToBody1);
+                reportCompoundCollidersOverlappingWithAABB(bodyProxy1, localAABB, COMPOUND_BROADPHASE_ID_OFFSET + static_cast<int32>(colliderIndex2),
+                                                           localNodes, overlappingNodes);
+            }
+        }
+    }
+
+    // Reset the moved state of the compound bodies
+    for (auto it = mCompoundBodies.begin(); it != mCompoundBodies.end(); ++it) {
+        it->second->hasMoved = false;
+    }
+}
+
+// Notify that the collider pairs of a compound node pair need to be tested for overlap
+/// The pairs of colliders between the two nodes are all in the overlapping pairs of the colliders
+/// of one of the nodes. Therefore, we only notify the pairs of the node with the fewest colliders
+/// instead of the pairs of all the colliders of the compound body.
+void BroadPhaseSystem::notifyCompoundNodePairToTestOverlap(const CompoundBodyProxy* bodyProxy1, const CompoundBodyProxy* bodyProxy2,
+                                                           int32 otherNodeId) {
+
+    // If the other node is a regular collider
+    if (bodyProxy2 == nullptr) {
+        mCollisionDetection.notifyOverlappingPairsToTestOverlap(static_cast<Collider*>(mDynamicAABBTree.getNodeDataPointer(otherNodeId)));
+        return;
+    }
+
+    const CompoundBodyProxy* smallestBodyProxy = bodyProxy2->colliderIndices.size() < bodyProxy1->colliderIndices.size() ?
+                                                 bodyProxy2 : bodyProxy1;
+    for (uint32 i=0; i < smallestBodyProxy->colliderIndices.size(); i++) {
+        mCollisionDetection.notifyOverlappingPairsToTestOverlap(mCompoundColliders[smallestBodyProxy->colliderIndices[i]].collider);
+    }
+}
+
+// Report the colliders of a compound body overlapping with an AABB given in the body-space
+void BroadPhaseSystem::reportCompoundCollidersOverlappingWithAABB(const CompoundBodyProxy* bodyProxy, const AABB& localAABB,
+                                                                 int32 otherBroadPhaseId, Array<int>& localNodes,
+                                                                 Array<Pair<int32, int32>>& overlappingNodes) const {
+
+    localNodes.clear();
+    bodyProxy->localTree.reportAllShapesOverlappingWithAABB(localAABB, localNodes);
+
+    for (uint64 k=0; k < localNodes.size(); k++) {
+
+        const int32 colliderIndex = bodyProxy->localTree.getNodeDataInt(localNodes[k])[0];
+        overlappingNodes.add(Pair<int32, int32>(COMPOUND_BROADPHASE_ID_OFFSET + colliderIndex, otherBroadPhaseId));
+    }
+}
+
+// Return the fat AABB of a given broad-phase shape
+AABB BroadPhaseSystem::getFatAABB(int broadPhaseId) const {
+
+    // If the collider belongs to a body in compound mode, we compute its world-space AABB
+    // from its AABB in the local tree of the body
+    if (isCompoundBroadPhaseId(broadPhaseId)) {
+
+        const CompoundColliderProxy& colliderProxy = mCompoundColliders[static_cast<uint32>(broadPhaseId - COMPOUND_BROADPHASE_ID_OFFSET)];
+        AABB aabb = colliderProxy.bodyProxy->localTree.getFatAABB(colliderProxy.localNodeId);
+        aabb.applyTransform(mTransformsComponents.getTransform(colliderProxy.bodyProxy->bodyEntity));
+
+        return aabb;
+    }
+
+    return mDynamicAABBTree.getFatAABB(broadPhaseId);
+}
+
+// Ray casting against the colliders of a compound body
+decimal BroadPhaseSystem::raycastCompoundBody(int32 nodeId, const Ray& ray, RaycastTest& raycastTest,
+                                              unsigned short raycastWithCategoryMaskBits) const {
+
+    const CompoundBodyProxy* bodyProxy = mMapNodeIdToCompoundBody[nodeId];
+
+    // Convert the ray into the local-space of the body
+    const Transform worldToBody = mTransformsComponents.getTransform(bodyProxy->bodyEntity).getInverse();
+    const Ray localRay(worldToBody * ray.point1, worldToBody * ray.point2, ray.maxFraction);
+
+    CompoundRaycastCallback compoundRaycastCallback(*this, bodyProxy->localTree, ray, raycastWithCategoryMaskBits, raycastTest);
+    bodyProxy->localTree.raycast(localRay, compoundRaycastCallback);
+
+    // If the user asked to stop the raycasting
+    if (compoundRaycastCallback.mIsStopped) {
+        return decimal(0.0);
+    }
+
+    return compoundRaycastCallback.mHitFraction;
 }
 
 // Called when a overlapping node has been found during the call to
@@ -235,8 +830,13 @@ decimal BroadPhaseRaycastCallback::raycastBroadPhaseShape(int32 nodeId, const Ra
 
     decimal hitFraction = decimal(-1.0);
 
+    // If the node is the proxy of a compound body, we raycast against its colliders
+    if (mBroadPhaseSystem.mCompoundBodies.size() > 0 && mBroadPhaseSystem.mMapNodeIdToCompoundBody.containsKey(nodeId)) {
+        return mBroadPhaseSystem.raycastCompoundBody(nodeId, ray, mRaycastTest, mRaycastWithCategoryMaskBits);
+    }
+
     // Get the collider from the node
-    Collider* collider = static_cast<Collider*>(mDynamicAABBTree.getNodeDataPointer(nodeId));
+    Collider* collider = static_cast<Collider*>(mBroadPhaseSystem.mDynamicAABBTree.getNodeDataPointer(nodeId));
 
     // Check if the raycast filtering mask allows raycast against this shape
     if ((mRaycastWithCategoryMaskBits & collider->getCollisionCategoryBits()) != 0) {
@@ -249,3 +849,31 @@ decimal BroadPhaseRaycastCallback::raycastBroadPhaseShape(int32 nodeId, const Ra
 
     return hitFraction;
 }
+
+// Called for a collider of the compound body that has to be tested for raycast
+decimal CompoundRaycastCallback::raycastBroadPhaseShape(int32 nodeId, const Ray& ray) {
+
+    decimal hitFraction = decimal(-1.0);
+
+    // Get the collider from the node of the local tree
+    const int32 colliderIndex = mLocalTree.getNodeDataInt(nodeId)[0];
+    Collider* collider = mBroadPhaseSystem.mCompoundColliders[static_cast<uint32>(colliderIndex)].collider;
+
+    // Check if the raycast filtering mask allows raycast against this shape
+    if ((mRaycastWithCategoryMaskBits & collider->getCollisionCategoryBits()) != 0) {
+
+        // The hit fraction is the same in local-space and in world-space
+        const Ray worldRay(mWorldRay.point1, mWorldRay.point2, ray.maxFraction);
+
+        hitFraction = mRaycastTest.raycastAgainstShape(collider, worldRay);
+
+        if (hitFraction == decimal(0.0)) {
+            mIsStopped = true;
+        }
+        else if (hitFraction > decimal(0.0) && (mHitFraction < decimal(0.0) || hitFraction < mHitFraction)) {
+            mHitFraction = hitFraction;
+        }
+    }
+
+    return hitFraction;
+}
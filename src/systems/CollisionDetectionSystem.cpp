@@ -38,6 +38,7 @@
 #include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
 #include <reactphysics3d/collision/ContactManifold.h>
 #include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/utils/Instrumentation.h>
 #include <reactphysics3d/engine/EventListener.h>
 #include <reactphysics3d/collision/RaycastInfo.h>
 #include <reactphysics3d/containers/Pair.h>
@@ -51,7 +52,7 @@ using namespace std;
 // Constructor
 CollisionDetectionSystem::CollisionDetectionSystem(PhysicsWorld* world, ColliderComponents& collidersComponents,  TransformComponents& transformComponents,
                                                    CollisionBodyComponents& collisionBodyComponents, RigidBodyComponents& rigidBodyComponents,
-                                                   MemoryManager& memoryManager, HalfEdgeStructure& triangleHalfEdgeStructure)
+                                                   MemoryManager& memoryManager)
                    : mMemoryManager(memoryManager), mCollidersComponents(collidersComponents), mRigidBodyComponents(rigidBodyComponents),
                      mCollisionDispatch(mMemoryManager.getPoolAllocator()), mWorld(world),
                      mNoCollisionPairs(mMemoryManager.getPoolAllocator()),
@@ -68,7 +69,7 @@ CollisionDetectionSystem::CollisionDetectionSystem(PhysicsWorld* world, Collider
                      mPreviousContactManifolds(&mContactManifolds1), mCurrentContactManifolds(&mContactManifolds2),
                      mContactPoints1(mMemoryManager.getPoolAllocator()), mContactPoints2(mMemoryManager.getPoolAllocator()),
                      mPreviousContactPoints(&mContactPoints1), mCurrentContactPoints(&mContactPoints2), mCollisionBodyContactPairsIndices(mMemoryManager.getSingleFrameAllocator()),
-                     mNbPreviousPotentialContactManifolds(0), mNbPreviousPotentialContactPoints(0), mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
+                     mNbPreviousPotentialContactManifolds(0), mNbPreviousPotentialContactPoints(0), mPeakContactsUsedMemory(0) {
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -85,6 +86,7 @@ CollisionDetectionSystem::CollisionDetectionSystem(PhysicsWorld* world, Collider
 void CollisionDetectionSystem::computeCollisionDetection() {
 
     RP3D_PROFILE("CollisionDetectionSystem::computeCollisionDetection()", mProfiler);
+    RP3D_INSTRUMENT(CollisionDetection);
 	    
     // Compute the broad-phase collision detection
     computeBroadPhase();
@@ -100,6 +102,7 @@ void CollisionDetectionSystem::computeCollisionDetection() {
 void CollisionDetectionSystem::computeBroadPhase() {
 
     RP3D_PROFILE("CollisionDetectionSystem::computeBroadPhase()", mProfiler);
+    RP3D_INSTRUMENT(BroadPhase);
 
     assert(mBroadPhaseOverlappingNodes.size() == 0);
 
@@ -326,6 +329,7 @@ void CollisionDetectionSystem::updateOverlappingPairs(const Array<Pair<int32, in
 void CollisionDetectionSystem::computeMiddlePhase(NarrowPhaseInput& narrowPhaseInput, bool needToReportContacts) {
 
     RP3D_PROFILE("CollisionDetectionSystem::computeMiddlePhase()", mProfiler);
+    RP3D_INSTRUMENT(MiddlePhase);
 
     // Reserve memory for the narrow-phase input using cached capacity from previous frame
     narrowPhaseInput.reserveMemory();
@@ -364,8 +368,7 @@ void CollisionDetectionSystem::computeMiddlePhase(NarrowPhaseInput& narrowPhaseI
         narrowPhaseInput.addNarrowPhaseTest(overlappingPair.pairID, collider1Entity, collider2Entity, collisionShape1, collisionShape2,
                                             mCollidersComponents.mLocalToWorldTransforms[collider1Index],
                                             mCollidersComponents.mLocalToWorldTransforms[collider2Index],
-                                            algorithmType, reportContacts, &overlappingPair.lastFrameCollisionInfo,
-                                            mMemoryManager.getSingleFrameAllocator());
+                                            algorithmType, reportContacts, &overlappingPair.lastFrameCollisionInfo);
 
         overlappingPair.collidingInCurrentFrame = false;
     }
@@ -427,7 +430,7 @@ void CollisionDetectionSystem::computeMiddlePhaseCollisionSnapshot(Array<uint64>
         narrowPhaseInput.addNarrowPhaseTest(pairId, collider1Entity, collider2Entity, collisionShape1, collisionShape2,
                                                   mCollidersComponents.mLocalToWorldTransforms[collider1Index],
                                                   mCollidersComponents.mLocalToWorldTransforms[collider2Index],
-                                                  algorithmType, reportContacts, &mOverlappingPairs.mConvexPairs[pairIndex].lastFrameCollisionInfo, mMemoryManager.getSingleFrameAllocator());
+                                                  algorithmType, reportContacts, &mOverlappingPairs.mConvexPairs[pairIndex].lastFrameCollisionInfo);
 
     }
 
@@ -484,62 +487,37 @@ void CollisionDetectionSystem::computeConvexVsConcaveMiddlePhase(OverlappingPair
     AABB aabb;
     convexShape->computeAABB(aabb, convexToConcaveTransform);
 
-    // Compute the concave shape triangles that are overlapping with the convex mesh AABB
-    Array<Vector3> triangleVertices(allocator, 64);
-    Array<Vector3> triangleVerticesNormals(allocator, 64);
-    Array<uint> shapeIds(allocator, 64);
-    concaveShape->computeOverlappingTriangles(aabb, triangleVertices, triangleVerticesNormals, shapeIds, allocator);
+    // Compute the references of the concave shape triangles that are overlapping with the convex mesh AABB
+    Array<TriangleReference> triangles(allocator, 64);
+    concaveShape->computeOverlappingTriangleReferences(aabb, triangles, allocator);
 
-    assert(triangleVertices.size() == triangleVerticesNormals.size());
-    assert(shapeIds.size() == triangleVertices.size() / 3);
-    assert(triangleVertices.size() % 3 == 0);
-    assert(triangleVerticesNormals.size() % 3 == 0);
+    const uint32 nbTriangles = static_cast<uint32>(triangles.size());
+    if (nbTriangles == 0) return;
 
     const bool isCollider1Trigger = mCollidersComponents.mIsTrigger[collider1Index];
     const bool isCollider2Trigger = mCollidersComponents.mIsTrigger[collider2Index];
     reportContacts = reportContacts && !isCollider1Trigger && !isCollider2Trigger;
 
-    CollisionShape* shape1;
-    CollisionShape* shape2;
-
-    if (overlappingPair.isShape1Convex) {
-        shape1 = convexShape;
-    }
-    else {
-        shape2 = convexShape;
-    }
+    // Note that no triangle shape is created here. The concave shape is given to the narrow-phase
+    // with the reference of the triangle and the narrow-phase algorithms read the vertices and
+    // normals of the triangle directly from the concave shape
+    CollisionShape* shape1 = mCollidersComponents.mCollisionShapes[collider1Index];
+    CollisionShape* shape2 = mCollidersComponents.mCollisionShapes[collider2Index];
 
     // For each overlapping triangle
-    const uint32 nbShapeIds = static_cast<uint32>(shapeIds.size());
-    for (uint32 i=0; i < nbShapeIds; i++) {
-
-        // Create a triangle collision shape (the allocated memory for the TriangleShape will be released in the
-        // destructor of the corresponding NarrowPhaseInfo.
-        TriangleShape* triangleShape = new (allocator.allocate(sizeof(TriangleShape)))
-                                       TriangleShape(&(triangleVertices[i * 3]), &(triangleVerticesNormals[i * 3]), shapeIds[i], mTriangleHalfEdgeStructure, allocator);
-
-    #ifdef IS_RP3D_PROFILING_ENABLED
+    for (uint32 i=0; i < nbTriangles; i++) {
 
+        const TriangleReference& triangle = triangles[i];
 
-        // Set the profiler to the triangle shape
-        triangleShape->setProfiler(mProfiler);
-
-    #endif
-
-        if (overlappingPair.isShape1Convex) {
-            shape2 = triangleShape;
-        }
-        else {
-            shape1 = triangleShape;
-        }
-
-        // Add a collision info for the two collision shapes into the overlapping pair (if not present yet)
-        LastFrameCollisionInfo* lastFrameInfo = overlappingPair.addLastFrameInfoIfNecessary(shape1->getId(), shape2->getId());
+        // Add a collision info for the convex shape and the triangle into the overlapping pair (if not present yet)
+        LastFrameCollisionInfo* lastFrameInfo = overlappingPair.isShape1Convex ?
+                                                    overlappingPair.addLastFrameInfoIfNecessary(convexShape->getId(), triangle.shapeId) :
+                                                    overlappingPair.addLastFrameInfoIfNecessary(triangle.shapeId, convexShape->getId());
 
         // Create a narrow phase info for the narrow-phase collision detection
-        narrowPhaseInput.addNarrowPhaseTest(overlappingPair.pairID, collider1, collider2, shape1, shape2,
-                                            shape1LocalToWorldTransform, shape2LocalToWorldTransform,
-                                            overlappingPair.narrowPhaseAlgorithmType, reportContacts, lastFrameInfo, allocator);
+        narrowPhaseInput.addNarrowPhaseTriangleTest(overlappingPair.pairID, collider1, collider2, shape1, shape2,
+                                                    shape1LocalToWorldTransform, shape2LocalToWorldTransform, triangle,
+                                                    overlappingPair.narrowPhaseAlgorithmType, reportContacts, lastFrameInfo);
     }
 }
 
@@ -620,6 +598,7 @@ void CollisionDetectionSystem::processAllPotentialContacts(NarrowPhaseInput& nar
 void CollisionDetectionSystem::computeNarrowPhase() {
 
     RP3D_PROFILE("CollisionDetectionSystem::computeNarrowPhase()", mProfiler);
+    RP3D_INSTRUMENT(NarrowPhase);
 
     MemoryAllocator& allocator = mMemoryManager.getSingleFrameAllocator();
 
@@ -646,7 +625,7 @@ void CollisionDetectionSystem::computeNarrowPhase() {
     assert(mCurrentContactPoints->size() == 0);
 }
 
-// Add the contact pairs to the corresponding bodies
+// Add the contact pairs involving a CollisionBody into the array of pairs that are not part of islands
 void CollisionDetectionSystem::addContactPairsToBodies() {
 
     const uint32 nbContactPairs = static_cast<uint32>(mCurrentContactPairs->size());
@@ -657,14 +636,6 @@ void CollisionDetectionSystem::addContactPairsToBodies() {
         const bool isBody1Rigid = mRigidBodyComponents.hasComponent(contactPair.body1Entity);
         const bool isBody2Rigid = mRigidBodyComponents.hasComponent(contactPair.body2Entity);
 
-        // Add the associated contact pair to both bodies of the pair (used to create islands later)
-        if (isBody1Rigid) {
-           mRigidBodyComponents.addContacPair(contactPair.body1Entity, p);
-        }
-        if (isBody2Rigid) {
-           mRigidBodyComponents.addContacPair(contactPair.body2Entity, p);
-        }
-
         // If at least of body is a CollisionBody
         if (!isBody1Rigid || !isBody2Rigid) {
 
@@ -849,6 +820,7 @@ void CollisionDetectionSystem::swapPreviousAndCurrentContacts() {
 void CollisionDetectionSystem::createContacts() {
 
     RP3D_PROFILE("CollisionDetectionSystem::createContacts()", mProfiler);
+    RP3D_INSTRUMENT(CreateContacts);
 
     mCurrentContactManifolds->reserve(mCurrentContactPairs->size());
     mCurrentContactPoints->reserve(mCurrentContactManifolds->size());
@@ -910,6 +882,12 @@ void CollisionDetectionSystem::createContacts() {
     mPreviousContactManifolds->clear();
     mPreviousContactPairs->clear();
 
+    const size_t contactsUsedMemory = mCurrentContactPairs->getUsedMemorySize() + mCurrentContactManifolds->getUsedMemorySize() +
+                                      mCurrentContactPoints->getUsedMemorySize();
+    if (contactsUsedMemory > mPeakContactsUsedMemory) {
+        mPeakContactsUsedMemory = contactsUsedMemory;
+    }
+
     mNbPreviousPotentialContactManifolds = static_cast<uint32>(mPotentialContactManifolds.capacity());
     mNbPreviousPotentialContactPoints = static_cast<uint32>(mPotentialContactPoints.capacity());
 
@@ -1109,6 +1087,112 @@ void CollisionDetectionSystem::initContactsWithPreviousOnes() {
     }
 }
 
+// Reserve memory for a given number of colliders, overlapping pairs and contact points
+/**
+ * @param nbColliders The expected number of colliders
+ * @param nbOverlappingPairs The expected number of overlapping pairs in the broad-phase
+ * @param nbContacts The expected number of contact points per frame
+ */
+void CollisionDetectionSystem::reserve(uint32 nbColliders, uint32 nbOverlappingPairs, uint32 nbContacts) {
+
+    mMapBroadPhaseIdToColliderEntity.reserve(nbColliders);
+    mBroadPhaseSystem.reserve(nbColliders);
+    mOverlappingPairs.reserve(nbOverlappingPairs);
+
+    // A contact pair usually has a single contact manifold
+    mContactPairs1.reserve(nbOverlappingPairs);
+    mContactPairs2.reserve(nbOverlappingPairs);
+    mContactManifolds1.reserve(nbOverlappingPairs);
+    mContactManifolds2.reserve(nbOverlappingPairs);
+    mContactPoints1.reserve(nbContacts);
+    mContactPoints2.reserve(nbContacts);
+
+    // The potential contacts arrays are allocated each frame with the capacity of the previous frame
+    if (nbOverlappingPairs > mNbPreviousPotentialContactManifolds) {
+        mNbPreviousPotentialContactManifolds = nbOverlappingPairs;
+    }
+    if (nbContacts > mNbPreviousPotentialContactPoints) {
+        mNbPreviousPotentialContactPoints = nbContacts;
+    }
+}
+
+// Compact the broad-phase tree and release the memory that is not used by the pairs and contacts
+/// This method must not be called during a simulation step. The broad-phase IDs of the colliders
+/// and the IDs of the overlapping pairs change. The contact pairs of the last frame are updated
+/// so that their contacts are still used to warm start the next frame.
+void CollisionDetectionSystem::compact() {
+
+    Array<int32> newNodeIds(mMemoryManager.getHeapAllocator());
+    mBroadPhaseSystem.compact(newNodeIds);
+
+    // If the nodes of the broad-phase tree have moved
+    if (newNodeIds.size() > 0) {
+
+        // Update the map from the broad-phase IDs to the colliders
+        mMapBroadPhaseIdToColliderEntity.clear();
+        for (uint32 i=0; i < mCollidersComponents.getNbComponents(); i++) {
+
+            const int32 broadPhaseId = mCollidersComponents.mBroadPhaseIds[i];
+            if (broadPhaseId != -1) {
+                mMapBroadPhaseIdToColliderEntity.add(Pair<int, Entity>(broadPhaseId, mCollidersComponents.mCollidersEntities[i]));
+            }
+        }
+
+        // Update the IDs of the overlapping pairs
+        Map<uint64, uint64> newPairIds(mMemoryManager.getHeapAllocator());
+        mOverlappingPairs.updateBroadPhaseIds(newNodeIds, newPairIds);
+
+        // Update the IDs of the contact pairs of the last frame. The contact pairs whose
+        // overlapping pair does not exist anymore cannot be matched in the next frame.
+        mPreviousMapPairIdToContactPairIndex.clear();
+        for (uint32 i=0; i < mCurrentContactPairs->size(); i++) {
+
+            ContactPair& contactPair = (*mCurrentContactPairs)[i];
+            auto it = newPairIds.find(contactPair.pairId);
+            if (it != newPairIds.end()) {
+                contactPair.pairId = it->second;
+                mPreviousMapPairIdToContactPairIndex.add(Pair<uint64, uint>(contactPair.pairId, i));
+            }
+        }
+    }
+
+    mMapBroadPhaseIdToColliderEntity.shrinkToFit();
+    mOverlappingPairs.shrinkToFit();
+    mPreviousMapPairIdToContactPairIndex.shrinkToFit();
+
+    // The arrays of the previous frame are empty between two steps
+    mContactPairs1.shrinkToFit();
+    mContactPairs2.shrinkToFit();
+    mContactManifolds1.shrinkToFit();
+    mContactManifolds2.shrinkToFit();
+    mContactPoints1.shrinkToFit();
+    mContactPoints2.shrinkToFit();
+}
+
+// Return the memory usage of the broad-phase
+MemoryUsage CollisionDetectionSystem::getBroadPhaseMemoryUsage() const {
+    return mBroadPhaseSystem.getMemoryUsage();
+}
+
+// Return the memory usage of the overlapping pairs
+MemoryUsage CollisionDetectionSystem::getOverlappingPairsMemoryUsage() const {
+    return mOverlappingPairs.getMemoryUsage();
+}
+
+// Return the memory usage of the contact pairs, manifolds and points
+/// The arrays of the previous and current frames are both included in the reserved memory.
+MemoryUsage CollisionDetectionSystem::getContactsMemoryUsage() const {
+
+    const size_t reservedMemory = mContactPairs1.getAllocatedMemorySize() + mContactPairs2.getAllocatedMemorySize() +
+                                  mContactManifolds1.getAllocatedMemorySize() + mContactManifolds2.getAllocatedMemorySize() +
+                                  mContactPoints1.getAllocatedMemorySize() + mContactPoints2.getAllocatedMemorySize();
+    const size_t usedMemory = mContactPairs1.getUsedMemorySize() + mContactPairs2.getUsedMemorySize() +
+                              mContactManifolds1.getUsedMemorySize() + mContactManifolds2.getUsedMemorySize() +
+                              mContactPoints1.getUsedMemorySize() + mContactPoints2.getUsedMemorySize();
+
+    return MemoryUsage(reservedMemory, usedMemory, usedMemory > mPeakContactsUsedMemory ? usedMemory : mPeakContactsUsedMemory);
+}
+
 // Remove a body from the collision detection
 void CollisionDetectionSystem::removeCollider(Collider* collider) {
 
@@ -1137,6 +1221,7 @@ void CollisionDetectionSystem::removeCollider(Collider* collider) {
 void CollisionDetectionSystem::raycast(RaycastCallback* raycastCallback, const Ray& ray, unsigned short raycastWithCategoryMaskBits) const {
 
     RP3D_PROFILE("CollisionDetectionSystem::raycast()", mProfiler);
+    RP3D_INSTRUMENT(Raycast);
 
     RaycastTest rayCastTest(raycastCallback);
 
@@ -1222,7 +1307,7 @@ void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& na
                         contactManifoldInfo.nbPotentialContactPoints++;
 
                         // Add the contact point to the array of potential contact points
-                        const ContactPointInfo& contactPoint = narrowPhaseInfoBatch.narrowPhaseInfos[i].contactPoints[j];
+                        const ContactPointInfo& contactPoint = narrowPhaseInfoBatch.getContactPoint(i, j);
 
                         potentialContactPoints.add(contactPoint);
                     }
@@ -1266,7 +1351,7 @@ void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& na
                 // Add the potential contacts
                 for (uint32 j=0; j < narrowPhaseInfoBatch.narrowPhaseInfos[i].nbContactPoints; j++) {
 
-                    const ContactPointInfo& contactPoint = narrowPhaseInfoBatch.narrowPhaseInfos[i].contactPoints[j];
+                    const ContactPointInfo& contactPoint = narrowPhaseInfoBatch.getContactPoint(i, j);
 
                     // Add the contact point to the array of potential contact points
                     const uint32 contactPointIndex = static_cast<uint32>(potentialContactPoints.size());
@@ -1642,6 +1727,8 @@ void CollisionDetectionSystem::removeDuplicatedContactPointsInManifold(ContactMa
 // Report contacts and triggers
 void CollisionDetectionSystem::reportContactsAndTriggers() {
 
+    RP3D_INSTRUMENT(ReportContacts);
+
     // Report contacts and triggers to the user
     if (mWorld->mEventListener != nullptr) {
 
@@ -1709,6 +1796,8 @@ void CollisionDetectionSystem::reportDebugRenderingContacts(Array<ContactPair>*
 // Return true if two bodies overlap (collide)
 bool CollisionDetectionSystem::testOverlap(CollisionBody* body1, CollisionBody* body2) {
 
+    RP3D_INSTRUMENT(TestOverlap);
+
     NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
 
     // Compute the broad-phase collision detection
@@ -1734,6 +1823,8 @@ bool CollisionDetectionSystem::testOverlap(CollisionBody* body1, CollisionBody*
 // Report all the bodies that overlap (collide) in the world
 void CollisionDetectionSystem::testOverlap(OverlapCallback& callback) {
 
+    RP3D_INSTRUMENT(TestOverlap);
+
     NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
 
     // Compute the broad-phase collision detection
@@ -1749,6 +1840,8 @@ void CollisionDetectionSystem::testOverlap(OverlapCallback& callback) {
 // Report all the bodies that overlap (collide) with the body in parameter
 void CollisionDetectionSystem::testOverlap(CollisionBody* body, OverlapCallback& callback) {
 
+    RP3D_INSTRUMENT(TestOverlap);
+
     NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
 
     // Compute the broad-phase collision detection
@@ -1772,6 +1865,8 @@ void CollisionDetectionSystem::testOverlap(CollisionBody* body, OverlapCallback&
 // Test collision and report contacts between two bodies.
 void CollisionDetectionSystem::testCollision(CollisionBody* body1, CollisionBody* body2, CollisionCallback& callback) {
 
+    RP3D_INSTRUMENT(TestCollision);
+
     NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
 
     // Compute the broad-phase collision detection
@@ -1795,6 +1890,8 @@ void CollisionDetectionSystem::testCollision(CollisionBody* body1, CollisionBody
 // Test collision and report all the contacts involving the body in parameter
 void CollisionDetectionSystem::testCollision(CollisionBody* body, CollisionCallback& callback) {
 
+    RP3D_INSTRUMENT(TestCollision);
+
     NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
 
     // Compute the broad-phase collision detection
@@ -1818,6 +1915,8 @@ void CollisionDetectionSystem::testCollision(CollisionBody* body, CollisionCallb
 // Test collision and report contacts between each colliding bodies in the world
 void CollisionDetectionSystem::testCollision(CollisionCallback& callback) {
 
+    RP3D_INSTRUMENT(TestCollision);
+
     NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
 
     // Compute the broad-phase collision detection
@@ -28,6 +28,7 @@
 #include <reactphysics3d/components/JointComponents.h>
 #include <reactphysics3d/components/BallAndSocketJointComponents.h>
 #include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/utils/Instrumentation.h>
 #include <reactphysics3d/engine/Island.h>
 
 using namespace reactphysics3d;
@@ -60,6 +61,7 @@ ConstraintSolverSystem::ConstraintSolverSystem(PhysicsWorld& world, Islands& isl
 void ConstraintSolverSystem::initialize(decimal dt) {
 
     RP3D_PROFILE("ConstraintSolverSystem::initialize()", mProfiler);
+    RP3D_INSTRUMENT(JointsSolverInit);
 
     // Set the current time step
     mTimeStep = dt;
@@ -94,6 +96,7 @@ void ConstraintSolverSystem::initialize(decimal dt) {
 void ConstraintSolverSystem::solveVelocityConstraints() {
 
     RP3D_PROFILE("ConstraintSolverSystem::solveVelocityConstraints()", mProfiler);
+    RP3D_INSTRUMENT(JointsVelocitySolver);
 
     mSolveBallAndSocketJointSystem.solveVelocityConstraint();
     mSolveFixedJointSystem.solveVelocityConstraint();
@@ -105,6 +108,7 @@ void ConstraintSolverSystem::solveVelocityConstraints() {
 void ConstraintSolverSystem::solvePositionConstraints() {
 
     RP3D_PROFILE("ConstraintSolverSystem::solvePositionConstraints()", mProfiler);
+    RP3D_INSTRUMENT(JointsPositionSolver);
 
     mSolveBallAndSocketJointSystem.solvePositionConstraint();
     mSolveFixedJointSystem.solvePositionConstraint();
@@ -29,6 +29,7 @@
 #include <reactphysics3d/body/RigidBody.h>
 #include <reactphysics3d/constraint/ContactPoint.h>
 #include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/utils/Instrumentation.h>
 #include <reactphysics3d/engine/Island.h>
 #include <reactphysics3d/collision/Collider.h>
 #include <reactphysics3d/components/CollisionBodyComponents.h>
@@ -68,6 +69,7 @@ void ContactSolverSystem::init(Array<ContactManifold>* contactManifolds, Array<C
     mAllContactPoints = contactPoints;
 
     RP3D_PROFILE("ContactSolver::init()", mProfiler);
+    RP3D_INSTRUMENT(ContactSolverInit);
 
     mTimeStep = timeStep;
 
@@ -482,6 +484,7 @@ void ContactSolverSystem::warmStart() {
 void ContactSolverSystem::solve() {
 
     RP3D_PROFILE("ContactSolverSystem::solve()", mProfiler);
+    RP3D_INSTRUMENT(ContactSolver);
 
     decimal deltaLambda;
     decimal lambdaTemp;
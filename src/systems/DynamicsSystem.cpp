@@ -27,14 +27,15 @@
 #include <reactphysics3d/systems/DynamicsSystem.h>
 #include <reactphysics3d/body/RigidBody.h>
 #include <reactphysics3d/engine/PhysicsWorld.h>
+#include <reactphysics3d/utils/Instrumentation.h>
 
 using namespace reactphysics3d;
 
 // Constructor
-DynamicsSystem::DynamicsSystem(PhysicsWorld& world, CollisionBodyComponents& collisionBodyComponents, RigidBodyComponents& rigidBodyComponents,
+DynamicsSystem::DynamicsSystem(PhysicsWorld& world, MemoryAllocator& allocator, CollisionBodyComponents& collisionBodyComponents, RigidBodyComponents& rigidBodyComponents,
                                TransformComponents& transformComponents, ColliderComponents& colliderComponents, bool& isGravityEnabled, Vector3& gravity)
               :mWorld(world), mCollisionBodyComponents(collisionBodyComponents), mRigidBodyComponents(rigidBodyComponents), mTransformComponents(transformComponents), mColliderComponents(colliderComponents),
-               mIsGravityEnabled(isGravityEnabled), mGravity(gravity) {
+               mIsGravityEnabled(isGravityEnabled), mGravity(gravity), mMovedColliders(allocator) {
 
 }
 
@@ -44,6 +45,7 @@ DynamicsSystem::DynamicsSystem(PhysicsWorld& world, CollisionBodyComponents& col
 void DynamicsSystem::integrateRigidBodiesPositions(decimal timeStep, bool isSplitImpulseActive) {
 
     RP3D_PROFILE("DynamicsSystem::integrateRigidBodiesPositions()", mProfiler);
+    RP3D_INSTRUMENT(IntegratePositions);
 
     const decimal isSplitImpulseFactor = isSplitImpulseActive ? decimal(1.0) : decimal(0.0);
 
@@ -74,7 +76,12 @@ void DynamicsSystem::integrateRigidBodiesPositions(decimal timeStep, bool isSpli
 void DynamicsSystem::updateBodiesState() {
 
     RP3D_PROFILE("DynamicsSystem::updateBodiesState()", mProfiler);
+    RP3D_INSTRUMENT(UpdateBodiesState);
 
+    mMovedColliders.clear();
+
+    // Note that only the enabled rigid bodies are updated here. The static bodies and
+    // the sleeping bodies are in the disabled part of the rigid body components.
     const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbEnabledComponents();
     for (uint32 i=0; i < nbRigidBodyComponents; i++) {
 
@@ -85,27 +92,30 @@ void DynamicsSystem::updateBodiesState() {
         // Update the position of the center of mass of the body
         mRigidBodyComponents.mCentersOfMassWorld[i] = mRigidBodyComponents.mConstrainedPositions[i];
 
-        // Update the orientation of the body
-        const Quaternion& constrainedOrientation = mRigidBodyComponents.mConstrainedOrientations[i];
-        mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]).setOrientation(constrainedOrientation.getUnit());
-    }
+        Transform& transform = mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]);
+        const Transform previousTransform = transform;
 
-    // Update the position of the body (using the new center of mass and new orientation)
-    for (uint32 i=0; i < nbRigidBodyComponents; i++) {
+        // Update the orientation of the body
+        transform.setOrientation(mRigidBodyComponents.mConstrainedOrientations[i].getUnit());
 
-        Transform& transform = mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]);
+        // Update the position of the body (using the new center of mass and new orientation)
         const Vector3& centerOfMassWorld = mRigidBodyComponents.mCentersOfMassWorld[i];
         const Vector3& centerOfMassLocal = mRigidBodyComponents.mCentersOfMassLocal[i];
         transform.setPosition(centerOfMassWorld - transform.getOrientation() * centerOfMassLocal);
-    }
 
-    // Update the local-to-world transform of the colliders
-    const uint32 nbColliderComponents = mColliderComponents.getNbEnabledComponents();
-    for (uint32 i=0; i < nbColliderComponents; i++) {
+        // If the body has not moved, its colliders do not need to be updated
+        if (transform == previousTransform) continue;
+
+        // Update the local-to-world transform of the colliders of the body
+        const Array<Entity>& colliderEntities = mCollisionBodyComponents.getColliders(mRigidBodyComponents.mBodiesEntities[i]);
+        const uint32 nbColliderEntities = static_cast<uint32>(colliderEntities.size());
+        for (uint32 c=0; c < nbColliderEntities; c++) {
 
-        // Update the local-to-world transform of the collider
-        mColliderComponents.mLocalToWorldTransforms[i] = mTransformComponents.getTransform(mColliderComponents.mBodiesEntities[i]) *
-                                                           mColliderComponents.mLocalToBodyTransforms[i];
+            const uint32 colliderIndex = mColliderComponents.getEntityIndex(colliderEntities[c]);
+            mColliderComponents.mLocalToWorldTransforms[colliderIndex] = transform * mColliderComponents.mLocalToBodyTransforms[colliderIndex];
+
+            mMovedColliders.add(colliderEntities[c]);
+        }
     }
 }
 
@@ -117,6 +127,7 @@ void DynamicsSystem::updateBodiesState() {
 void DynamicsSystem::integrateRigidBodiesVelocities(decimal timeStep) {
 
     RP3D_PROFILE("DynamicsSystem::integrateRigidBodiesVelocities()", mProfiler);
+    RP3D_INSTRUMENT(IntegrateVelocities);
 
     // Reset the split velocities of the bodies
     resetSplitVelocities();
@@ -185,8 +196,9 @@ void DynamicsSystem::integrateRigidBodiesVelocities(decimal timeStep) {
 // Reset the external force and torque applied to the bodies
 void DynamicsSystem::resetBodiesForceAndTorque() {
 
-    // For each body of the world
-    const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbComponents();
+    // For each enabled body of the world (the forces of the static and sleeping bodies are
+    // already reset when they are disabled)
+    const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbEnabledComponents();
     for (uint32 i=0; i < nbRigidBodyComponents; i++) {
         mRigidBodyComponents.mExternalForces[i].setToZero();
         mRigidBodyComponents.mExternalTorques[i].setToZero();
@@ -203,3 +215,11 @@ void DynamicsSystem::resetSplitVelocities() {
     }
 }
 
+
+// Reserve memory for a given number of colliders
+/**
+ * @param nbColliders The number of colliders that can move in a frame without any new allocation
+ */
+void DynamicsSystem::reserve(uint32 nbColliders) {
+    mMovedColliders.reserve(nbColliders);
+}
@@ -63,8 +63,8 @@ void SolveHingeJointSystem::initBeforeSolve() {
         const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
         const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-        assert(!mRigidBodyComponents.getIsEntityDisabled(body1Entity));
-        assert(!mRigidBodyComponents.getIsEntityDisabled(body2Entity));
+        assert(!mRigidBodyComponents.getIsEntityDisabled(body1Entity) || mRigidBodyComponents.getBodyType(body1Entity) == BodyType::STATIC);
+        assert(!mRigidBodyComponents.getIsEntityDisabled(body2Entity) || mRigidBodyComponents.getBodyType(body2Entity) == BodyType::STATIC);
 
         // Get the inertia tensor of bodies
         mHingeJointComponents.mI1[i] = mRigidBodyComponents.mInverseInertiaTensorsWorld[componentIndexBody1];
@@ -36,24 +36,37 @@
 #include <reactphysics3d/collision/Collider.h>
 #include <reactphysics3d/engine/PhysicsWorld.h>
 #include <reactphysics3d/containers/Pair.h>
+#include <reactphysics3d/utils/Instrumentation.h>
 
 using namespace reactphysics3d;
 
 // Constructor
 DebugRenderer::DebugRenderer(MemoryAllocator& allocator)
               :mAllocator(allocator), mLines(allocator), mTriangles(allocator), mDisplayedDebugItems(0), mMapDebugItemWithColor(allocator),
-               mContactPointSphereRadius(DEFAULT_CONTACT_POINT_SPHERE_RADIUS), mContactNormalLength(DEFAULT_CONTACT_NORMAL_LENGTH) {
+               mContactPointSphereRadius(DEFAULT_CONTACT_POINT_SPHERE_RADIUS), mContactNormalLength(DEFAULT_CONTACT_NORMAL_LENGTH),
+               mIsViewAABBEnabled(false), mUnitSphereTessellation(CollisionShapeName::SPHERE, allocator), mShapeTessellations(allocator),
+               mTransformedVertices(allocator), mLinesBuffer(nullptr), mLinesBufferCapacity(0), mNbBufferLines(0),
+               mTrianglesBuffer(nullptr), mTrianglesBufferCapacity(0), mNbBufferTriangles(0), mNbDroppedPrimitives(0) {
 
     mMapDebugItemWithColor.add(Pair<DebugItem, uint32>(DebugItem::COLLIDER_AABB, static_cast<uint32>(DebugColor::MAGENTA)));
     mMapDebugItemWithColor.add(Pair<DebugItem, uint32>(DebugItem::COLLIDER_BROADPHASE_AABB, static_cast<uint32>(DebugColor::YELLOW)));
 	mMapDebugItemWithColor.add(Pair<DebugItem, uint32>(DebugItem::COLLISION_SHAPE, static_cast<uint32>(DebugColor::GREEN)));
     mMapDebugItemWithColor.add(Pair<DebugItem, uint32>(DebugItem::CONTACT_POINT, static_cast<uint32>(DebugColor::RED)));
     mMapDebugItemWithColor.add(Pair<DebugItem, uint32>(DebugItem::CONTACT_NORMAL, static_cast<uint32>(DebugColor::WHITE)));
+
+    // The sphere tessellation is shared by all the sphere shapes and contact points
+    tessellateUnitSphere(mUnitSphereTessellation);
 }
 
 // Destructor
 DebugRenderer::~DebugRenderer() {
 
+    // Destroy the cached tessellations
+    for (auto it = mShapeTessellations.begin(); it != mShapeTessellations.end(); ++it) {
+
+        it->second->~ShapeTessellation();
+        mAllocator.release(it->second, sizeof(ShapeTessellation));
+    }
 }
 
 // Clear all the debugging primitives (points, lines, triangles, ...)
@@ -61,6 +74,58 @@ void DebugRenderer::reset() {
 
 	mLines.clear();
 	mTriangles.clear();
+
+    mNbBufferLines = 0;
+    mNbBufferTriangles = 0;
+    mNbDroppedPrimitives = 0;
+}
+
+// Write the lines and triangles into packed vertex buffers provided by the user
+/**
+ * Each line is written as two consecutive vertices and each triangle as three consecutive
+ * vertices. The buffers must stay valid until removeOutputBuffers() is called. The primitives
+ * that do not fit into the buffers are dropped (see getNbDroppedPrimitives()).
+ * @param linesVertices Buffer with room for at least 2 * maxNbLines vertices
+ * @param maxNbLines Maximum number of lines that can be written into the lines buffer
+ * @param trianglesVertices Buffer with room for at least 3 * maxNbTriangles vertices
+ * @param maxNbTriangles Maximum number of triangles that can be written into the triangles buffer
+ */
+void DebugRenderer::setOutputBuffers(DebugVertex* linesVertices, uint32 maxNbLines, DebugVertex* trianglesVertices, uint32 maxNbTriangles) {
+
+    assert(linesVertices != nullptr);
+    assert(trianglesVertices != nullptr);
+
+    reset();
+
+    mLinesBuffer = linesVertices;
+    mLinesBufferCapacity = maxNbLines;
+    mTrianglesBuffer = trianglesVertices;
+    mTrianglesBufferCapacity = maxNbTriangles;
+}
+
+// Write the lines and triangles into the arrays of the debug renderer again
+void DebugRenderer::removeOutputBuffers() {
+
+    reset();
+
+    mLinesBuffer = nullptr;
+    mLinesBufferCapacity = 0;
+    mTrianglesBuffer = nullptr;
+    mTrianglesBufferCapacity = 0;
+}
+
+// Add the triangles of a tessellation whose vertices have been transformed
+/// The world-space vertices of the tessellation must be in the mTransformedVertices array
+void DebugRenderer::addTransformedTriangles(const ShapeTessellation& tessellation, uint32 color) {
+
+    assert(mTransformedVertices.size() == tessellation.vertices.size());
+
+    const uint64 nbIndices = tessellation.indices.size();
+    for (uint64 i = 0; i < nbIndices; i += 3) {
+
+        addTriangle(mTransformedVertices[tessellation.indices[i]], mTransformedVertices[tessellation.indices[i + 1]],
+                    mTransformedVertices[tessellation.indices[i + 2]], color);
+    }
 }
 
 // Draw an AABB
@@ -70,22 +135,22 @@ void DebugRenderer::drawAABB(const AABB& aabb, uint32 color) {
 	const Vector3& max = aabb.getMax();
 
 	// Bottom edges
-	mLines.add(DebugLine(Vector3(min.x, min.y, max.z), Vector3(max.x, min.y, max.z), color));
-	mLines.add(DebugLine(Vector3(max.x, min.y, max.z),  Vector3(max.x, min.y, min.z), color));
-	mLines.add(DebugLine(Vector3(max.x, min.y, min.z), Vector3(min.x, min.y, min.z), color));
-	mLines.add(DebugLine(Vector3(min.x, min.y, min.z), Vector3(min.x, min.y, max.z), color));
+	addLine(Vector3(min.x, min.y, max.z), Vector3(max.x, min.y, max.z), color);
+	addLine(Vector3(max.x, min.y, max.z),  Vector3(max.x, min.y, min.z), color);
+	addLine(Vector3(max.x, min.y, min.z), Vector3(min.x, min.y, min.z), color);
+	addLine(Vector3(min.x, min.y, min.z), Vector3(min.x, min.y, max.z), color);
 
 	// Top edges
-	mLines.add(DebugLine(Vector3(min.x, max.y, max.z), Vector3(max.x, max.y, max.z), color));
-	mLines.add(DebugLine(Vector3(max.x, max.y, max.z), Vector3(max.x, max.y, min.z), color));
-	mLines.add(DebugLine(Vector3(max.x, max.y, min.z), Vector3(min.x, max.y, min.z), color));
-	mLines.add(DebugLine(Vector3(min.x, max.y, min.z), Vector3(min.x, max.y, max.z), color));
+	addLine(Vector3(min.x, max.y, max.z), Vector3(max.x, max.y, max.z), color);
+	addLine(Vector3(max.x, max.y, max.z), Vector3(max.x, max.y, min.z), color);
+	addLine(Vector3(max.x, max.y, min.z), Vector3(min.x, max.y, min.z), color);
+	addLine(Vector3(min.x, max.y, min.z), Vector3(min.x, max.y, max.z), color);
 
 	// Side edges
-	mLines.add(DebugLine(Vector3(min.x, min.y, max.z), Vector3(min.x, max.y, max.z), color));
-	mLines.add(DebugLine(Vector3(max.x, min.y, max.z), Vector3(max.x, max.y, max.z), color));
-	mLines.add(DebugLine(Vector3(max.x, min.y, min.z), Vector3(max.x, max.y, min.z), color));
-	mLines.add(DebugLine(Vector3(min.x, min.y, min.z), Vector3(min.x, max.y, min.z), color));
+	addLine(Vector3(min.x, min.y, max.z), Vector3(min.x, max.y, max.z), color);
+	addLine(Vector3(max.x, min.y, max.z), Vector3(max.x, max.y, max.z), color);
+	addLine(Vector3(max.x, min.y, min.z), Vector3(max.x, max.y, min.z), color);
+	addLine(Vector3(min.x, min.y, min.z), Vector3(min.x, max.y, min.z), color);
 }
 
 // Draw a box
@@ -104,25 +169,74 @@ void DebugRenderer::drawBox(const Transform& transform, const Vector3& halfExten
 	vertices[7] = transform * Vector3(-halfExtents.x, halfExtents.y, -halfExtents.z);
 
 	// Triangle faces
-	mTriangles.add(DebugTriangle(vertices[0], vertices[1], vertices[5], color));
-	mTriangles.add(DebugTriangle(vertices[0], vertices[5], vertices[4], color));
-	mTriangles.add(DebugTriangle(vertices[1], vertices[2], vertices[6], color));
-	mTriangles.add(DebugTriangle(vertices[1], vertices[6], vertices[5], color));
-	mTriangles.add(DebugTriangle(vertices[2], vertices[3], vertices[6], color));
-	mTriangles.add(DebugTriangle(vertices[3], vertices[7], vertices[6], color));
-	mTriangles.add(DebugTriangle(vertices[0], vertices[7], vertices[3], color));
-	mTriangles.add(DebugTriangle(vertices[0], vertices[4], vertices[7], color));
-	mTriangles.add(DebugTriangle(vertices[0], vertices[2], vertices[1], color));
-	mTriangles.add(DebugTriangle(vertices[0], vertices[3], vertices[2], color));
-	mTriangles.add(DebugTriangle(vertices[5], vertices[6], vertices[4], color));
-	mTriangles.add(DebugTriangle(vertices[4], vertices[6], vertices[7], color));
+	addTriangle(vertices[0], vertices[1], vertices[5], color);
+	addTriangle(vertices[0], vertices[5], vertices[4], color);
+	addTriangle(vertices[1], vertices[2], vertices[6], color);
+	addTriangle(vertices[1], vertices[6], vertices[5], color);
+	addTriangle(vertices[2], vertices[3], vertices[6], color);
+	addTriangle(vertices[3], vertices[7], vertices[6], color);
+	addTriangle(vertices[0], vertices[7], vertices[3], color);
+	addTriangle(vertices[0], vertices[4], vertices[7], color);
+	addTriangle(vertices[0], vertices[2], vertices[1], color);
+	addTriangle(vertices[0], vertices[3], vertices[2], color);
+	addTriangle(vertices[5], vertices[6], vertices[4], color);
+	addTriangle(vertices[4], vertices[6], vertices[7], color);
 }
 
 /// Draw a sphere
 void DebugRenderer::drawSphere(const Vector3& position, decimal radius, uint32 color) {
 
-    Vector3 vertices[(NB_SECTORS_SPHERE + 1) * (NB_STACKS_SPHERE + 1) + (NB_SECTORS_SPHERE + 1)];
-	
+    // Scale and translate the vertices of the unit sphere
+    mTransformedVertices.clear();
+    const uint64 nbVertices = mUnitSphereTessellation.vertices.size();
+    for (uint64 v = 0; v < nbVertices; v++) {
+        mTransformedVertices.add(position + radius * mUnitSphereTessellation.vertices[v]);
+    }
+
+    addTransformedTriangles(mUnitSphereTessellation, color);
+}
+
+// Draw a cached tessellation with a given local-to-world transform
+void DebugRenderer::drawTessellation(const ShapeTessellation& tessellation, const Transform& transform, uint32 color) {
+
+    // Only the unique vertices of the tessellation are transformed
+    mTransformedVertices.clear();
+    const uint64 nbVertices = tessellation.vertices.size();
+    for (uint64 v = 0; v < nbVertices; v++) {
+        mTransformedVertices.add(transform * tessellation.vertices[v]);
+    }
+
+    addTransformedTriangles(tessellation, color);
+}
+
+// Draw only the triangles of a concave shape that overlap the view AABB
+void DebugRenderer::drawConcaveShapeInView(const Transform& transform, const ConcaveShape* concaveShape, uint32 color) {
+
+    // Compute the view AABB in the local-space of the shape
+    AABB localViewAABB = mViewAABB;
+    localViewAABB.applyTransform(transform.getInverse());
+
+    // Use the middle-phase tree of the shape to get the overlapping triangles
+    Array<Vector3> triangleVertices(mAllocator);
+    Array<Vector3> triangleVerticesNormals(mAllocator);
+    Array<uint32> shapeIds(mAllocator);
+    concaveShape->computeOverlappingTriangles(localViewAABB, triangleVertices, triangleVerticesNormals, shapeIds, mAllocator);
+
+    const uint64 nbVertices = triangleVertices.size();
+    for (uint64 v = 0; v < nbVertices; v += 3) {
+
+        // The middle-phase query is conservative so we also skip the triangles outside of the view
+        if (!localViewAABB.testCollisionTriangleAABB(&(triangleVertices[v]))) {
+            continue;
+        }
+
+        addTriangle(transform * triangleVertices[v], transform * triangleVertices[v + 1], transform * triangleVertices[v + 2], color);
+    }
+}
+
+// Compute the tessellation of a sphere of radius one
+void DebugRenderer::tessellateUnitSphere(ShapeTessellation& tessellation) const {
+
 	// Vertices
     const decimal sectorStep = 2 * PI_RP3D / NB_SECTORS_SPHERE;
     const decimal stackStep = PI_RP3D / NB_STACKS_SPHERE;
@@ -130,16 +244,16 @@ void DebugRenderer::drawSphere(const Vector3& position, decimal radius, uint32 c
     for (uint32 i = 0; i <= NB_STACKS_SPHERE; i++) {
 
         const decimal stackAngle = PI_RP3D / 2 - i * stackStep;
-		const decimal radiusCosStackAngle = radius * std::cos(stackAngle);
-		const decimal z = radius * std::sin(stackAngle);
+		const decimal cosStackAngle = std::cos(stackAngle);
+		const decimal z = std::sin(stackAngle);
 
         for (uint32 j = 0; j <= NB_SECTORS_SPHERE; j++) {
 		
 			const decimal sectorAngle = j * sectorStep;
-			const decimal x = radiusCosStackAngle * std::cos(sectorAngle);
-			const decimal y = radiusCosStackAngle * std::sin(sectorAngle);
+			const decimal x = cosStackAngle * std::cos(sectorAngle);
+			const decimal y = cosStackAngle * std::sin(sectorAngle);
 
-            vertices[i * (NB_SECTORS_SPHERE + 1) + j] = position + Vector3(x, y, z);
+            tessellation.vertices.add(Vector3(x, y, z));
 		}
 	}
 
@@ -155,23 +269,26 @@ void DebugRenderer::drawSphere(const Vector3& position, decimal radius, uint32 c
 
 			if (i != 0) {
 			
-				mTriangles.add(DebugTriangle(vertices[a1], vertices[a2], vertices[a1 + 1], color));
+                tessellation.indices.add(a1);
+                tessellation.indices.add(a2);
+                tessellation.indices.add(a1 + 1);
 			}
 
 			if (i != (NB_STACKS_SPHERE - 1)) {
 				
-				mTriangles.add(DebugTriangle(vertices[a1 + 1], vertices[a2], vertices[a2 + 1], color));
+                tessellation.indices.add(a1 + 1);
+                tessellation.indices.add(a2);
+                tessellation.indices.add(a2 + 1);
 			}
 		}
 	}
 }
 
-// Draw a capsule
-void DebugRenderer::drawCapsule(const Transform& transform, decimal radius, decimal height, uint32 color) {
+// Compute the tessellation of a capsule
+void DebugRenderer::tessellateCapsule(const CapsuleShape* capsuleShape, ShapeTessellation& tessellation) const {
 
-    Vector3 vertices[(NB_SECTORS_SPHERE + 1) * (NB_STACKS_SPHERE + 1) + (NB_SECTORS_SPHERE + 1)];
-
-    const decimal halfHeight = decimal(0.5) * height;
+    const decimal radius = capsuleShape->getRadius();
+    const decimal halfHeight = decimal(0.5) * capsuleShape->getHeight();
 
 	// Use an even number of stacks
     const uint32 nbStacks = NB_STACKS_SPHERE % 2 == 0 ? NB_STACKS_SPHERE : NB_STACKS_SPHERE - 1;
@@ -180,9 +297,7 @@ void DebugRenderer::drawCapsule(const Transform& transform, decimal radius, deci
 	// Vertices
     const decimal sectorStep = 2 * PI_RP3D / NB_SECTORS_SPHERE;
     const decimal stackStep = PI_RP3D / nbStacks;
-	
-    uint32 vertexIndex = 0;
-	
+
 	// Top cap sphere vertices
     for (uint32 i = 0; i <= nbHalfStacks; i++) {
 
@@ -196,10 +311,7 @@ void DebugRenderer::drawCapsule(const Transform& transform, decimal radius, deci
             const decimal x = radiusCosStackAngle * std::sin(sectorAngle);
             const decimal z = radiusCosStackAngle * std::cos(sectorAngle);
 
-            assert(vertexIndex < (NB_SECTORS_SPHERE + 1) * (nbStacks + 1) + (NB_SECTORS_SPHERE + 1));
-			vertices[vertexIndex] = transform * Vector3(x, y + halfHeight, z);
-
-			vertexIndex++;
+            tessellation.vertices.add(Vector3(x, y + halfHeight, z));
 		}
 	}
 
@@ -216,10 +328,7 @@ void DebugRenderer::drawCapsule(const Transform& transform, decimal radius, deci
             const decimal x = radiusCosStackAngle * std::sin(sectorAngle);
             const decimal z = radiusCosStackAngle * std::cos(sectorAngle);
 
-            assert(vertexIndex < (NB_SECTORS_SPHERE + 1) * (nbStacks + 1) + (NB_SECTORS_SPHERE + 1));
-            vertices[vertexIndex] = transform * Vector3(x, y - halfHeight, z);
-
-			vertexIndex++;
+            tessellation.vertices.add(Vector3(x, y - halfHeight, z));
 		}
 	}
 
@@ -235,10 +344,14 @@ void DebugRenderer::drawCapsule(const Transform& transform, decimal radius, deci
 
             if (i != 0) {
 
-                mTriangles.add(DebugTriangle(vertices[a1], vertices[a2], vertices[a1 + 1], color));
+                tessellation.indices.add(a1);
+                tessellation.indices.add(a2);
+                tessellation.indices.add(a1 + 1);
             }
 
-            mTriangles.add(DebugTriangle(vertices[a1 + 1], vertices[a2], vertices[a2 + 1], color));
+            tessellation.indices.add(a1 + 1);
+            tessellation.indices.add(a2);
+            tessellation.indices.add(a2 + 1);
         }
 	}
 
@@ -252,11 +365,15 @@ void DebugRenderer::drawCapsule(const Transform& transform, decimal radius, deci
 		
 			// 2 triangles per sector except for the last stack
 
-            mTriangles.add(DebugTriangle(vertices[a1], vertices[a2], vertices[a1 + 1], color));
+            tessellation.indices.add(a1);
+            tessellation.indices.add(a2);
+            tessellation.indices.add(a1 + 1);
 
             if (i != (nbHalfStacks - 1)) {
 
-                mTriangles.add(DebugTriangle(vertices[a1 + 1], vertices[a2], vertices[a2 + 1], color));
+                tessellation.indices.add(a1 + 1);
+                tessellation.indices.add(a2);
+                tessellation.indices.add(a2 + 1);
             }
         }
 	}
@@ -266,13 +383,23 @@ void DebugRenderer::drawCapsule(const Transform& transform, decimal radius, deci
     uint32 a2 = a1 + NB_SECTORS_SPHERE + 1;
     for (uint32 i = 0; i < NB_SECTORS_SPHERE; i++, a1++, a2++) {
 
-		mTriangles.add(DebugTriangle(vertices[a1 + 1], vertices[a2], vertices[a2 + 1], color));
-		mTriangles.add(DebugTriangle(vertices[a1], vertices[a2], vertices[a1 + 1], color));
+        tessellation.indices.add(a1 + 1);
+        tessellation.indices.add(a2);
+        tessellation.indices.add(a2 + 1);
+
+        tessellation.indices.add(a1);
+        tessellation.indices.add(a2);
+        tessellation.indices.add(a1 + 1);
 	}
 }
 
-// Draw a convex mesh
-void DebugRenderer::drawConvexMesh(const Transform& transform, const ConvexMeshShape* convexMesh, uint32 color) {
+// Compute the tessellation of a convex mesh
+void DebugRenderer::tessellateConvexMesh(const ConvexMeshShape* convexMesh, ShapeTessellation& tessellation) const {
+
+    // Vertices (with the scaling of the shape)
+    for (uint32 v = 0; v < convexMesh->getNbVertices(); v++) {
+        tessellation.vertices.add(convexMesh->getVertexPosition(v));
+    }
 
 	// For each face of the convex mesh
 	for (uint32 f = 0; f < convexMesh->getNbFaces(); f++) {
@@ -284,25 +411,15 @@ void DebugRenderer::drawConvexMesh(const Transform& transform, const ConvexMeshS
         const uint32 nbFaceVertices = static_cast<uint32>(face.faceVertices.size());
         for (uint32 v = 2; v < nbFaceVertices; v++) {
 
-            uint32 v1Index = face.faceVertices[v - 2];
-            uint32 v2Index = face.faceVertices[v - 1];
-            uint32 v3Index = face.faceVertices[v];
-
-            Vector3 v1 = convexMesh->getVertexPosition(v1Index);
-            Vector3 v2 = convexMesh->getVertexPosition(v2Index);
-            Vector3 v3 = convexMesh->getVertexPosition(v3Index);
-
-            v1 = transform * v1;
-            v2 = transform * v2;
-            v3 = transform * v3;
-
-            mTriangles.add(DebugTriangle(v1, v2, v3, color));
+            tessellation.indices.add(face.faceVertices[0]);
+            tessellation.indices.add(face.faceVertices[v - 1]);
+            tessellation.indices.add(face.faceVertices[v]);
 		}
 	}
 }
 
-// Draw a concave mesh shape
-void DebugRenderer::drawConcaveMeshShape(const Transform& transform, const ConcaveMeshShape* concaveMeshShape, uint32 color) {
+// Compute the tessellation of a concave mesh shape
+void DebugRenderer::tessellateConcaveMeshShape(const ConcaveMeshShape* concaveMeshShape, ShapeTessellation& tessellation) const {
 
 	// For each sub-part of the mesh
     for (uint32 p = 0; p < concaveMeshShape->getNbSubparts(); p++) {
@@ -313,78 +430,176 @@ void DebugRenderer::drawConcaveMeshShape(const Transform& transform, const Conca
 			Vector3 triangleVertices[3];
 			concaveMeshShape->getTriangleVertices(p, t, triangleVertices);
 
-            triangleVertices[0] = transform * triangleVertices[0];
-            triangleVertices[1] = transform * triangleVertices[1];
-            triangleVertices[2] = transform * triangleVertices[2];
-
-            mTriangles.add(DebugTriangle(triangleVertices[0], triangleVertices[1], triangleVertices[2], color));
+            const uint32 firstIndex = static_cast<uint32>(tessellation.vertices.size());
+            for (uint32 v = 0; v < 3; v++) {
+                tessellation.vertices.add(triangleVertices[v]);
+                tessellation.indices.add(firstIndex + v);
+            }
 		}
 	}
 }
 
-// Draw a height field shape
-void DebugRenderer::drawHeightFieldShape(const Transform& transform, const HeightFieldShape* heightFieldShape, uint32 color) {
+// Compute the tessellation of a height field shape
+void DebugRenderer::tessellateHeightFieldShape(const HeightFieldShape* heightFieldShape, ShapeTessellation& tessellation) const {
+
+    const int nbColumns = heightFieldShape->getNbColumns();
+    const int nbRows = heightFieldShape->getNbRows();
+
+    // Vertices of the grid
+    for (int i = 0; i < nbColumns; i++) {
+        for (int j = 0; j < nbRows; j++) {
+            tessellation.vertices.add(heightFieldShape->getVertexAt(i, j));
+        }
+    }
 
     // For each sub-grid points (except the last ones one each dimension)
-    for (int i = 0; i < heightFieldShape->getNbColumns() - 1; i++) {
-        for (int j = 0; j < heightFieldShape->getNbRows() - 1; j++) {
-
-            // Compute the four point of the current quad
-            Vector3 p1 = heightFieldShape->getVertexAt(i, j);
-            Vector3 p2 = heightFieldShape->getVertexAt(i, j + 1);
-            Vector3 p3 = heightFieldShape->getVertexAt(i + 1, j);
-            Vector3 p4 = heightFieldShape->getVertexAt(i + 1, j + 1);
-
-            p1 = transform * p1;
-            p2 = transform * p2;
-            p3 = transform * p3;
-            p4 = transform * p4;
-
-            mTriangles.add(DebugTriangle(p1, p2, p3, color));
-			mTriangles.add(DebugTriangle(p3, p2, p4, color));
+    for (int i = 0; i < nbColumns - 1; i++) {
+        for (int j = 0; j < nbRows - 1; j++) {
+
+            // Indices of the four point of the current quad
+            const uint32 p1 = static_cast<uint32>(i * nbRows + j);
+            const uint32 p2 = p1 + 1;
+            const uint32 p3 = p1 + static_cast<uint32>(nbRows);
+            const uint32 p4 = p3 + 1;
+
+            tessellation.indices.add(p1);
+            tessellation.indices.add(p2);
+            tessellation.indices.add(p3);
+
+            tessellation.indices.add(p3);
+            tessellation.indices.add(p2);
+            tessellation.indices.add(p4);
        }
    }
 }
 
+// Return the cached tessellation of a collision shape (computed again if the shape has changed)
+/**
+ * A cached tessellation is computed again if the name or the local bounds of the shape have
+ * changed (for instance when the radius of a capsule or the scaling of a mesh is modified)
+ */
+const DebugRenderer::ShapeTessellation& DebugRenderer::getShapeTessellation(const CollisionShape* collisionShape) {
+
+    Vector3 localMin, localMax;
+    collisionShape->getLocalBounds(localMin, localMax);
+
+    ShapeTessellation* tessellation;
+    auto it = mShapeTessellations.find(collisionShape);
+    if (it != mShapeTessellations.end()) {
+
+        tessellation = it->second;
+        tessellation->isUsed = true;
+
+        // If the shape has not changed
+        if (tessellation->shapeName == collisionShape->getName() && tessellation->localMin == localMin &&
+            tessellation->localMax == localMax) {
+            return *tessellation;
+        }
+
+        tessellation->shapeName = collisionShape->getName();
+        tessellation->vertices.clear();
+        tessellation->indices.clear();
+    }
+    else {
+
+        tessellation = new (mAllocator.allocate(sizeof(ShapeTessellation))) ShapeTessellation(collisionShape->getName(), mAllocator);
+        mShapeTessellations.add(Pair<const CollisionShape*, ShapeTessellation*>(collisionShape, tessellation));
+    }
+
+    tessellation->localMin = localMin;
+    tessellation->localMax = localMax;
+
+    switch (collisionShape->getName()) {
+
+        case CollisionShapeName::CAPSULE:
+            tessellateCapsule(static_cast<const CapsuleShape*>(collisionShape), *tessellation);
+            break;
+        case CollisionShapeName::CONVEX_MESH:
+            tessellateConvexMesh(static_cast<const ConvexMeshShape*>(collisionShape), *tessellation);
+            break;
+        case CollisionShapeName::TRIANGLE_MESH:
+            tessellateConcaveMeshShape(static_cast<const ConcaveMeshShape*>(collisionShape), *tessellation);
+            break;
+        case CollisionShapeName::HEIGHTFIELD:
+            tessellateHeightFieldShape(static_cast<const HeightFieldShape*>(collisionShape), *tessellation);
+            break;
+        default:
+            assert(false);
+    }
+
+    return *tessellation;
+}
+
+// Destroy the cached tessellations that have not been used since the last call
+void DebugRenderer::removeUnusedTessellations() {
+
+    for (auto it = mShapeTessellations.begin(); it != mShapeTessellations.end();) {
+
+        ShapeTessellation* tessellation = it->second;
+        if (tessellation->isUsed) {
+
+            tessellation->isUsed = false;
+            ++it;
+        }
+        else {
+
+            tessellation->~ShapeTessellation();
+            mAllocator.release(tessellation, sizeof(ShapeTessellation));
+            it = mShapeTessellations.remove(it);
+        }
+    }
+}
+
+// Destroy the cached tessellation of a collision shape (if any)
+/// This method is called when the collision shape is destroyed because the memory of the
+/// shape can be reused for a new shape that must not use the tessellation of the old one.
+void DebugRenderer::removeShapeTessellation(const CollisionShape* collisionShape) {
+
+    auto it = mShapeTessellations.find(collisionShape);
+    if (it != mShapeTessellations.end()) {
+
+        ShapeTessellation* tessellation = it->second;
+        tessellation->~ShapeTessellation();
+        mAllocator.release(tessellation, sizeof(ShapeTessellation));
+        mShapeTessellations.remove(it);
+    }
+}
+
 // Draw the collision shape of a collider
-void DebugRenderer::drawCollisionShapeOfCollider(const Collider* collider, uint32 color) {
+void DebugRenderer::drawCollisionShapeOfCollider(const Collider* collider, const AABB& worldAABB, uint32 color) {
 	
-    switch (collider->getCollisionShape()->getName()) {
+    const CollisionShape* collisionShape = collider->getCollisionShape();
+
+    switch (collisionShape->getName()) {
 		
         case CollisionShapeName::BOX:
         {
-            const BoxShape* boxShape = static_cast<const BoxShape*>(collider->getCollisionShape());
+            const BoxShape* boxShape = static_cast<const BoxShape*>(collisionShape);
             drawBox(collider->getLocalToWorldTransform(), boxShape->getHalfExtents(), color);
             break;
         }
         case CollisionShapeName::SPHERE:
         {
-            const SphereShape* sphereShape = static_cast<const SphereShape*>(collider->getCollisionShape());
+            const SphereShape* sphereShape = static_cast<const SphereShape*>(collisionShape);
             drawSphere(collider->getLocalToWorldTransform().getPosition(), sphereShape->getRadius(), color);
             break;
         }
         case CollisionShapeName::CAPSULE:
-        {
-            const CapsuleShape* capsuleShape = static_cast<const CapsuleShape*>(collider->getCollisionShape());
-            drawCapsule(collider->getLocalToWorldTransform(), capsuleShape->getRadius(), capsuleShape->getHeight(), color);
-            break;
-        }
         case CollisionShapeName::CONVEX_MESH:
         {
-            const ConvexMeshShape*  convexMeshShape = static_cast<const ConvexMeshShape*>(collider->getCollisionShape());
-            drawConvexMesh(collider->getLocalToWorldTransform(), convexMeshShape, color);
+            drawTessellation(getShapeTessellation(collisionShape), collider->getLocalToWorldTransform(), color);
             break;
         }
         case CollisionShapeName::TRIANGLE_MESH:
-        {
-            const ConcaveMeshShape* concaveMeshShape = static_cast<const ConcaveMeshShape*>(collider->getCollisionShape());
-            drawConcaveMeshShape(collider->getLocalToWorldTransform(), concaveMeshShape, color);
-            break;
-        }
         case CollisionShapeName::HEIGHTFIELD:
         {
-            const HeightFieldShape* heighFieldShape = static_cast<const HeightFieldShape*>(collider->getCollisionShape());
-            drawHeightFieldShape(collider->getLocalToWorldTransform(), heighFieldShape, color);
+            // If the concave shape is only partially visible, we only draw its triangles inside the view
+            if (mIsViewAABBEnabled && !mViewAABB.contains(worldAABB)) {
+                drawConcaveShapeInView(collider->getLocalToWorldTransform(), static_cast<const ConcaveShape*>(collisionShape), color);
+            }
+            else {
+                drawTessellation(getShapeTessellation(collisionShape), collider->getLocalToWorldTransform(), color);
+            }
             break;
         }
         default:
@@ -397,6 +612,8 @@ void DebugRenderer::drawCollisionShapeOfCollider(const Collider* collider, uint3
 // Generate the rendering primitives (triangles, lines, ...) of a physics world
 void DebugRenderer::computeDebugRenderingPrimitives(const PhysicsWorld& world) {
 
+	RP3D_INSTRUMENT(DebugRendering);
+
 	const bool drawColliderAABB = getIsDebugItemDisplayed(DebugItem::COLLIDER_AABB);
 	const bool drawColliderBroadphaseAABB = getIsDebugItemDisplayed(DebugItem::COLLIDER_BROADPHASE_AABB);
 	const bool drawCollisionShape = getIsDebugItemDisplayed(DebugItem::COLLISION_SHAPE);
@@ -418,10 +635,17 @@ void DebugRenderer::computeDebugRenderingPrimitives(const PhysicsWorld& world) {
                 // Get a collider
                 const Collider* collider = body->getCollider(c);
 
+                const AABB worldAABB = collider->getWorldAABB();
+
+                // Skip the colliders outside of the view
+                if (mIsViewAABBEnabled && !mViewAABB.testCollision(worldAABB)) {
+                    continue;
+                }
+
                 // If we need to draw the collider AABB
                 if (drawColliderAABB) {
 
-                    drawAABB(collider->getWorldAABB(), mMapDebugItemWithColor[DebugItem::COLLIDER_AABB]);
+                    drawAABB(worldAABB, mMapDebugItemWithColor[DebugItem::COLLIDER_AABB]);
                 }
 
                 // If we need to draw the collider broad-phase AABB
@@ -435,11 +659,14 @@ void DebugRenderer::computeDebugRenderingPrimitives(const PhysicsWorld& world) {
                 // If we need to draw the collision shape
                 if (drawCollisionShape) {
 
-                    drawCollisionShapeOfCollider(collider, mMapDebugItemWithColor[DebugItem::COLLISION_SHAPE]);
+                    drawCollisionShapeOfCollider(collider, worldAABB, mMapDebugItemWithColor[DebugItem::COLLISION_SHAPE]);
                 }
             }
         }
     }
+
+    // Release the tessellations of the shapes that are not displayed anymore
+    removeUnusedTessellations();
 }
 
 // Called when some contacts occur
@@ -462,6 +689,11 @@ void DebugRenderer::onContact(const CollisionCallback::CallbackData& callbackDat
 
                     Vector3 point = contactPair.getCollider1()->getLocalToWorldTransform() * contactPoint.getLocalPointOnCollider1();
 
+                    // Skip the contact points outside of the view
+                    if (mIsViewAABBEnabled && !mViewAABB.contains(point)) {
+                        continue;
+                    }
+
                     if (getIsDebugItemDisplayed(DebugItem::CONTACT_POINT)) {
 
                         // Contact point
@@ -471,7 +703,7 @@ void DebugRenderer::onContact(const CollisionCallback::CallbackData& callbackDat
                     if (getIsDebugItemDisplayed(DebugItem::CONTACT_NORMAL)) {
 
                         // Contact normal
-                        mLines.add(DebugLine(point,  point + contactPoint.getWorldNormal() * mContactNormalLength, mMapDebugItemWithColor[DebugItem::CONTACT_NORMAL]));
+                        addLine(point,  point + contactPoint.getWorldNormal() * mContactNormalLength, mMapDebugItemWithColor[DebugItem::CONTACT_NORMAL]);
                     }
                 }
             }
@@ -31,7 +31,9 @@ using namespace reactphysics3d;
 
 // Constructor
 DefaultLogger::DefaultLogger(MemoryAllocator& allocator)
-       : mAllocator(allocator), mDestinations(allocator), mFormatters(allocator)
+       : mAllocator(allocator), mDestinations(allocator), mFormatters(allocator), mMaxLevelFlag(0),
+         mIsAsynchronous(false), mQueue(nullptr), mQueueCapacity(0), mPushPosition(0), mPopPosition(0),
+         mNbDroppedMessages(0), mNbReportedDroppedMessages(0), mIsThreadStopping(false)
 {
     // Create the log formatters
     mFormatters.add(Pair<Format, Formatter*>(Format::Text, new TextFormatter()));
@@ -41,6 +43,8 @@ DefaultLogger::DefaultLogger(MemoryAllocator& allocator)
 // Destructor
 DefaultLogger::~DefaultLogger() {
 
+    disableAsynchronousMode();
+
     removeAllDestinations();
 
     // Remove all the formatters
@@ -64,20 +68,39 @@ DefaultLogger::Formatter* DefaultLogger::getFormatter(Format format) const {
 // Add a log file destination to the logger
 void DefaultLogger::addFileDestination(const std::string& filePath, uint logLevelFlag, Format format) {
 
+    std::lock_guard<std::mutex> lock(mMutex);
+
     FileDestination* destination = new (mAllocator.allocate(sizeof(FileDestination))) FileDestination(filePath, logLevelFlag, getFormatter(format));
     mDestinations.add(destination);
+
+    if (logLevelFlag > mMaxLevelFlag.load(std::memory_order_relaxed)) {
+        mMaxLevelFlag.store(logLevelFlag, std::memory_order_relaxed);
+    }
 }
 
 /// Add a stream destination to the logger
 void DefaultLogger::addStreamDestination(std::ostream& outputStream, uint logLevelFlag, Format format) {
 
+    std::lock_guard<std::mutex> lock(mMutex);
+
     StreamDestination* destination = new (mAllocator.allocate(sizeof(StreamDestination))) StreamDestination(outputStream, logLevelFlag, getFormatter(format));
     mDestinations.add(destination);
+
+    if (logLevelFlag > mMaxLevelFlag.load(std::memory_order_relaxed)) {
+        mMaxLevelFlag.store(logLevelFlag, std::memory_order_relaxed);
+    }
 }
 
 // Remove all logs destination previously set
+/// In asynchronous mode, the pending messages are written before the destinations are removed.
 void DefaultLogger::removeAllDestinations() {
 
+    flush();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mMaxLevelFlag.store(0, std::memory_order_relaxed);
+
     // Delete all the destinations
     for (uint32 i=0; i<mDestinations.size(); i++) {
 
@@ -91,20 +114,221 @@ void DefaultLogger::removeAllDestinations() {
     mDestinations.clear();
 }
 
+// Enable the asynchronous mode where the messages are written by a background thread
+/// The log() method then only copies the message into a record of a bounded lock-free queue
+/// and the background thread formats the queued messages and writes them into the destinations.
+/// When the queue is full, the messages are dropped instead of blocking the calling thread. The
+/// number of dropped messages is returned by getNbDroppedMessages() and reported in the
+/// destinations. This method must not be called while other threads are logging.
+/**
+ * @param queueCapacity Maximum number of messages waiting to be written (rounded up to a power of two)
+ */
+void DefaultLogger::enableAsynchronousMode(uint32 queueCapacity) {
+
+    if (mIsAsynchronous.load(std::memory_order_relaxed)) return;
+
+    mQueueCapacity = 2;
+    while (mQueueCapacity < queueCapacity) {
+        mQueueCapacity *= 2;
+    }
+
+    // Allocate the records of the queue. The sequence number of a free record is the
+    // position where it can be pushed.
+    mQueue = static_cast<LogRecord*>(mAllocator.allocate(static_cast<size_t>(mQueueCapacity) * sizeof(LogRecord)));
+    for (uint64 i=0; i < mQueueCapacity; i++) {
+        new (mQueue + i) LogRecord();
+        mQueue[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mPushPosition.store(0, std::memory_order_relaxed);
+    mPopPosition.store(0, std::memory_order_relaxed);
+    mNbReportedDroppedMessages = mNbDroppedMessages.load(std::memory_order_relaxed);
+
+    // Start the background thread
+    mIsThreadStopping = false;
+    mThread = std::thread(&DefaultLogger::runBackgroundThread, this);
+
+    mIsAsynchronous.store(true, std::memory_order_release);
+}
+
+// Write the pending messages and disable the asynchronous mode
+/// The messages are then written by the thread that logs them. This method must not be
+/// called while other threads are logging.
+void DefaultLogger::disableAsynchronousMode() {
+
+    if (!mIsAsynchronous.load(std::memory_order_relaxed)) return;
+
+    mIsAsynchronous.store(false, std::memory_order_release);
+
+    // Stop the background thread
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsThreadStopping = true;
+    }
+    mWakeUpCondition.notify_one();
+    mThread.join();
+
+    // Write the messages that have been pushed after the last wake up of the thread
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        writeQueuedRecords();
+    }
+
+    // Release the records of the queue
+    for (uint64 i=0; i < mQueueCapacity; i++) {
+        mQueue[i].~LogRecord();
+    }
+    mAllocator.release(mQueue, static_cast<size_t>(mQueueCapacity) * sizeof(LogRecord));
+    mQueue = nullptr;
+    mQueueCapacity = 0;
+}
+
+// Wait until the messages logged before this call have been written
+/// This method does nothing if the asynchronous mode is disabled.
+void DefaultLogger::flush() {
+
+    if (!mIsAsynchronous.load(std::memory_order_acquire)) return;
+
+    const uint64 lastPosition = mPushPosition.load(std::memory_order_acquire);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mWakeUpCondition.notify_one();
+    while (mPopPosition.load(std::memory_order_acquire) < lastPosition) {
+        mWrittenCondition.wait(lock);
+    }
+}
+
 // Log something
 void DefaultLogger::log(Level level, const std::string& physicsWorldName, Category category, const std::string& message, const char* filename, int lineNumber) {
 
+    // If no destination writes messages of this level
+    if (static_cast<uint>(level) > mMaxLevelFlag.load(std::memory_order_relaxed)) return;
+
     // Get current time
     auto now = std::chrono::system_clock::now();
     auto time = std::chrono::system_clock::to_time_t(now);
 
+    if (mIsAsynchronous.load(std::memory_order_acquire)) {
+        pushRecord(time, physicsWorldName, message, level, category, filename, lineNumber);
+        return;
+    }
+
     mMutex.lock();
 
+    writeToDestinations(time, physicsWorldName, message, level, category, filename, lineNumber);
+
+    mMutex.unlock();
+}
+
+// Write a message into all the destinations
+/// The mutex must be locked by the caller.
+void DefaultLogger::writeToDestinations(const time_t& time, const std::string& physicsWorldName, const std::string& message,
+                                        Level level, Category category, const char* filename, int lineNumber) {
+
     // For each destination
     for (auto it = mDestinations.begin(); it != mDestinations.end(); ++it) {
 
         (*it)->write(time, physicsWorldName, message, level, category, filename, lineNumber);
     }
+}
 
-    mMutex.unlock();
+// Push a message into the queue of the asynchronous mode
+/// This is a bounded multi-producer queue where each thread reserves a record by incrementing
+/// the push position with a compare-and-swap. The message is dropped if the queue is full.
+void DefaultLogger::pushRecord(const time_t& time, const std::string& physicsWorldName, const std::string& message,
+                               Level level, Category category, const char* filename, int lineNumber) {
+
+    // Reserve a record
+    uint64 position = mPushPosition.load(std::memory_order_relaxed);
+    LogRecord* record;
+    while (true) {
+
+        record = mQueue + (position & (mQueueCapacity - 1));
+        const uint64 sequence = record->sequence.load(std::memory_order_acquire);
+        const int64 difference = static_cast<int64>(sequence - position);
+
+        // If the record is free
+        if (difference == 0) {
+            if (mPushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (difference < 0) {
+
+            // The record has not been written by the background thread yet (the queue is full)
+            mNbDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else {
+
+            // Another thread has reserved this record
+            position = mPushPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Copy the message into the record (the memory of the strings of the record is reused)
+    record->time = time;
+    record->level = level;
+    record->category = category;
+    record->filename = filename;
+    record->lineNumber = lineNumber;
+    record->physicsWorldName = physicsWorldName;
+    record->message = message;
+
+    // Publish the record to the background thread
+    record->sequence.store(position + 1, std::memory_order_release);
+
+    // Wake up the background thread before the queue gets full
+    if (position + 1 - mPopPosition.load(std::memory_order_relaxed) == mQueueCapacity / 2) {
+        mWakeUpCondition.notify_one();
+    }
+}
+
+// Pop and write all the records of the queue
+/// The mutex must be locked by the caller. Only one thread pops the records at a time.
+void DefaultLogger::writeQueuedRecords() {
+
+    while (true) {
+
+        const uint64 position = mPopPosition.load(std::memory_order_relaxed);
+        LogRecord& record = mQueue[position & (mQueueCapacity - 1)];
+
+        // If the record has not been published yet
+        if (record.sequence.load(std::memory_order_acquire) != position + 1) break;
+
+        writeToDestinations(record.time, record.physicsWorldName, record.message, record.level, record.category,
+                            record.filename, record.lineNumber);
+
+        // The record can be pushed again once the producers have gone around the queue
+        record.sequence.store(position + mQueueCapacity, std::memory_order_release);
+        mPopPosition.store(position + 1, std::memory_order_release);
+    }
+
+    // Report the messages that have been dropped
+    const uint64 nbDroppedMessages = mNbDroppedMessages.load(std::memory_order_relaxed);
+    if (nbDroppedMessages > mNbReportedDroppedMessages) {
+
+        const time_t time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        writeToDestinations(time, "", "DefaultLogger: " + std::to_string(nbDroppedMessages - mNbReportedDroppedMessages) +
+                            " messages dropped because the queue of the asynchronous mode was full",
+                            Level::Warning, Category::PhysicCommon, __FILE__, __LINE__);
+        mNbReportedDroppedMessages = nbDroppedMessages;
+    }
+}
+
+// Main loop of the background thread
+/// The thread writes the queued messages and sleeps until it is woken up by a flush, by a
+/// queue that is half full or by a short timeout.
+void DefaultLogger::runBackgroundThread() {
+
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (true) {
+
+        writeQueuedRecords();
+        mWrittenCondition.notify_all();
+
+        if (mIsThreadStopping) break;
+
+        mWakeUpCondition.wait_for(lock, std::chrono::milliseconds(10));
+    }
 }
@@ -0,0 +1,193 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/utils/Instrumentation.h>
+#include <chrono>
+#include <cassert>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define RP3D_INSTRUMENTATION_USE_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <x86intrin.h>
+    #define RP3D_INSTRUMENTATION_USE_RDTSC
+#endif
+
+using namespace reactphysics3d;
+
+// Initialization of static variables
+std::atomic<bool> Instrumentation::mIsEnabled(false);
+Instrumentation::ThreadCounters Instrumentation::mThreadsCounters[MAX_NB_THREADS + 1];
+std::atomic<uint32> Instrumentation::mNbThreads(0);
+thread_local Instrumentation::ThreadCounters* Instrumentation::mCurrentThreadCounters = nullptr;
+
+namespace {
+
+    // Value of the ticks counter and of the steady clock when the library has been loaded.
+    // They are used to compute the frequency of the time stamp counter.
+    const uint64 gReferenceTicks = Instrumentation::getTicks();
+    const std::chrono::steady_clock::time_point gReferenceTime = std::chrono::steady_clock::now();
+
+    // Names of the stages
+    const char* const gStagesNames[] = {
+        "Step", "CollisionDetection", "BroadPhase", "MiddlePhase", "NarrowPhase", "CreateContacts",
+        "ReportContacts", "Islands", "IntegrateVelocities", "ContactSolverInit", "ContactSolver",
+        "JointsSolverInit", "JointsVelocitySolver", "JointsPositionSolver", "IntegratePositions",
+        "UpdateBodiesState", "UpdateColliders", "Sleeping", "DebugRendering", "Raycast",
+        "TestOverlap", "TestCollision"
+    };
+
+    static_assert(sizeof(gStagesNames) / sizeof(gStagesNames[0]) == Instrumentation::NB_STAGES,
+                  "A name is required for each instrumentation stage");
+}
+
+// Enable or disable the measure of the stages
+/**
+ * @param isEnabled True if the stages must be measured
+ */
+void Instrumentation::setIsEnabled(bool isEnabled) {
+    mIsEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+// Return the current value of the ticks counter
+/// This is the time stamp counter of the processor on x86 and the steady
+/// clock (in nanoseconds) on the other platforms.
+uint64 Instrumentation::getTicks() {
+
+#ifdef RP3D_INSTRUMENTATION_USE_RDTSC
+    return static_cast<uint64>(__rdtsc());
+#else
+    return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Return the number of ticks per second
+/// The frequency of the time stamp counter is measured against the steady clock
+/// since the library has been loaded. If the library has been loaded very recently,
+/// this method waits a few milliseconds to get a meaningful measure.
+double Instrumentation::getTicksPerSecond() {
+
+#ifdef RP3D_INSTRUMENTATION_USE_RDTSC
+
+    const std::chrono::steady_clock::duration minDuration = std::chrono::milliseconds(10);
+
+    std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+    while (time - gReferenceTime < minDuration) {
+        time = std::chrono::steady_clock::now();
+    }
+    const uint64 ticks = getTicks();
+
+    const double elapsedSeconds = std::chrono::duration<double>(time - gReferenceTime).count();
+    return static_cast<double>(ticks - gReferenceTicks) / elapsedSeconds;
+#else
+    return 1.0e9;
+#endif
+}
+
+// Return the counters of the current thread
+Instrumentation::ThreadCounters* Instrumentation::getThreadCounters() {
+
+    if (mCurrentThreadCounters == nullptr) {
+
+        // Give its own counters to this thread or the shared ones if there are none left
+        const uint32 index = mNbThreads.fetch_add(1, std::memory_order_relaxed);
+        mCurrentThreadCounters = &mThreadsCounters[index < MAX_NB_THREADS ? index : MAX_NB_THREADS];
+    }
+
+    return mCurrentThreadCounters;
+}
+
+// Add a call of a stage with its number of elapsed ticks into the counters of the current thread
+/**
+ * @param stage The measured stage
+ * @param nbTicks The number of ticks elapsed in the stage
+ */
+void Instrumentation::addSample(InstrumentationStage stage, uint64 nbTicks) {
+
+    const uint32 stageIndex = static_cast<uint32>(stage);
+    assert(stageIndex < NB_STAGES);
+
+    ThreadCounters* counters = getThreadCounters();
+
+    // The counters are only contended when several threads share the last counters
+    counters->nbCalls[stageIndex].fetch_add(1, std::memory_order_relaxed);
+    counters->nbTicks[stageIndex].fetch_add(nbTicks, std::memory_order_relaxed);
+}
+
+// Sum the counters of all the threads into a snapshot
+/// This method can be called from any thread while the stages are measured. The
+/// counters of a stage that is currently being updated might be off by one call.
+/**
+ * @param snapshot The snapshot where to write the counters
+ */
+void Instrumentation::getSnapshot(Snapshot& snapshot) {
+
+    const uint32 nbThreads = mNbThreads.load(std::memory_order_relaxed);
+    const uint32 nbThreadsCounters = nbThreads < MAX_NB_THREADS ? nbThreads : MAX_NB_THREADS + 1;
+
+    snapshot.nbThreads = nbThreads;
+    snapshot.ticksPerSecond = getTicksPerSecond();
+
+    for (uint32 s=0; s < NB_STAGES; s++) {
+
+        StageCounters& stageCounters = snapshot.stages[s];
+        stageCounters.nbCalls = 0;
+        stageCounters.nbTicks = 0;
+
+        for (uint32 t=0; t < nbThreadsCounters; t++) {
+            stageCounters.nbCalls += mThreadsCounters[t].nbCalls[s].load(std::memory_order_relaxed);
+            stageCounters.nbTicks += mThreadsCounters[t].nbTicks[s].load(std::memory_order_relaxed);
+        }
+
+        stageCounters.time = static_cast<double>(stageCounters.nbTicks) / snapshot.ticksPerSecond;
+    }
+}
+
+// Reset the counters of all the threads
+/// The samples added by other threads during the reset might be partially lost.
+void Instrumentation::reset() {
+
+    for (uint32 t=0; t < MAX_NB_THREADS + 1; t++) {
+        for (uint32 s=0; s < NB_STAGES; s++) {
+            mThreadsCounters[t].nbCalls[s].store(0, std::memory_order_relaxed);
+            mThreadsCounters[t].nbTicks[s].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Return the name of a stage
+/**
+ * @param stage A stage of the instrumentation
+ * @return The name of the stage
+ */
+const char* Instrumentation::getStageName(InstrumentationStage stage) {
+
+    const uint32 stageIndex = static_cast<uint32>(stage);
+    assert(stageIndex < NB_STAGES);
+
+    return gStagesNames[stageIndex];
+}
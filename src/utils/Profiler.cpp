@@ -30,6 +30,9 @@
 // Libraries
 #include <reactphysics3d/utils/Profiler.h>
 #include <string>
+#include <thread>
+#include <functional>
+#include <iomanip>
 #include <reactphysics3d/memory/MemoryManager.h>
 
 using namespace reactphysics3d;
@@ -156,7 +159,8 @@ void ProfileNodeIterator::enterParent() {
 }
 
 // Constructor
-Profiler::Profiler() :mRootNode("Root", nullptr) {
+Profiler::Profiler() :mTraceEvents(nullptr), mTraceCapacity(0), mNbTraceEvents(0), mNextTraceEventIndex(0),
+                      mTraceDepth(0), mRootNode("Root", nullptr) {
 
 	mCurrentNode = &mRootNode;
     mNbDestinations = 0;
@@ -172,6 +176,8 @@ Profiler::~Profiler() {
 
     removeAllDestinations();
 
+    setTraceCapacity(0);
+
 	destroy();
 }
 
@@ -197,12 +203,29 @@ void Profiler::startProfilingBlock(const char* name) {
 
     // Start profile the node
     mCurrentNode->enterBlockOfCode();
+
+    // Open the block of code in the trace
+    if (mTraceEvents != nullptr) {
+        if (mTraceDepth < MAX_TRACE_DEPTH) {
+            mTraceBlocksNames[mTraceDepth] = name;
+            mTraceBlocksStartingTimes[mTraceDepth] = clock::now();
+        }
+        mTraceDepth++;
+    }
 }
 
 // Method called at the end of the scope where the
 // startProfilingBlock() method has been called.
 void Profiler::stopProfilingBlock() {
 
+    // Close the block of code in the trace
+    if (mTraceEvents != nullptr && mTraceDepth > 0) {
+        mTraceDepth--;
+        if (mTraceDepth < MAX_TRACE_DEPTH) {
+            addTraceEvent(mTraceBlocksNames[mTraceDepth], mTraceBlocksStartingTimes[mTraceDepth], clock::now());
+        }
+    }
+
     // Go to the parent node unless if the current block
     // of code is recursing
     if (mCurrentNode->exitBlockOfCode()) {
@@ -216,6 +239,81 @@ void Profiler::reset() {
     mRootNode.enterBlockOfCode();
     mFrameCounter = 0;
     mProfilingStartTime = clock::now();
+
+    // The events of the trace are relative to the start of the profiling
+    mNbTraceEvents = 0;
+    mNextTraceEventIndex = 0;
+}
+
+// Set the number of events kept in the trace (zero disables the trace)
+/// The trace is a ring buffer with the last profiled blocks of code. When it is full,
+/// the oldest events are overwritten. Setting the capacity clears the trace.
+/**
+ * @param nbEvents Maximum number of events in the trace
+ */
+void Profiler::setTraceCapacity(uint nbEvents) {
+
+    if (mTraceEvents != nullptr) {
+        std::free(mTraceEvents);
+        mTraceEvents = nullptr;
+    }
+
+    mTraceCapacity = nbEvents;
+    mNbTraceEvents = 0;
+    mNextTraceEventIndex = 0;
+    mTraceDepth = 0;
+
+    if (nbEvents > 0) {
+        mTraceEvents = static_cast<TraceEvent*>(std::malloc(nbEvents * sizeof(TraceEvent)));
+    }
+}
+
+// Add an event for a profiled block of code into the trace ring buffer
+void Profiler::addTraceEvent(const char* name, const std::chrono::time_point<clock>& startingTime,
+                             const std::chrono::time_point<clock>& endTime) {
+
+    assert(mTraceEvents != nullptr);
+
+    TraceEvent& event = mTraceEvents[mNextTraceEventIndex];
+    event.name = name;
+    event.startTime = std::chrono::duration<double, std::micro>(startingTime - mProfilingStartTime).count();
+    event.duration = std::chrono::duration<double, std::micro>(endTime - startingTime).count();
+    event.frame = mFrameCounter;
+    event.threadId = static_cast<uint>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    mNextTraceEventIndex = (mNextTraceEventIndex + 1) % mTraceCapacity;
+    if (mNbTraceEvents < mTraceCapacity) {
+        mNbTraceEvents++;
+    }
+}
+
+// Print the events of the trace in the trace event JSON format
+/// The events are complete events ("ph":"X") with their starting time and duration in
+/// microseconds. The output can be opened in chrome://tracing or in Perfetto.
+void Profiler::printTrace(std::ostream& outputStream) {
+
+    const std::ios_base::fmtflags flags = outputStream.flags();
+    const std::streamsize precision = outputStream.precision();
+
+    outputStream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+    outputStream << std::fixed << std::setprecision(3);
+
+    // Print the events from the oldest one to the most recent one
+    const uint firstEventIndex = mNbTraceEvents < mTraceCapacity ? 0 : mNextTraceEventIndex;
+    for (uint i=0; i < mNbTraceEvents; i++) {
+
+        const TraceEvent& event = mTraceEvents[(firstEventIndex + i) % mTraceCapacity];
+
+        outputStream << "{\"name\":\"" << event.name << "\",\"cat\":\"rp3d\",\"ph\":\"X\",\"ts\":" << event.startTime <<
+                        ",\"dur\":" << event.duration << ",\"pid\":1,\"tid\":" << event.threadId <<
+                        ",\"args\":{\"frame\":" << event.frame << "}}";
+        outputStream << (i + 1 < mNbTraceEvents ? "," : "") << std::endl;
+    }
+
+    outputStream << "]}" << std::endl;
+
+    outputStream.flags(flags);
+    outputStream.precision(precision);
 }
 
 // Print the report of the profiler in a given output stream
@@ -224,6 +322,11 @@ void Profiler::printReport() {
     // For each destination
     for (uint i=0; i < mNbDestinations; i++) {
 
+        if (mDestinations[i]->format == Format::ChromeTrace) {
+            printTrace(mDestinations[i]->getOutputStream());
+            continue;
+        }
+
         ProfileNodeIterator* iterator = Profiler::getIterator();
 
         // Recursively print the report of each node of the profiler tree
@@ -241,6 +344,11 @@ void Profiler::addFileDestination(const std::string& filePath, Format format) {
         allocatedDestinations(mNbAllocatedDestinations * 2);
     }
 
+    // A trace destination needs the trace of the profiled blocks of code
+    if (format == Format::ChromeTrace && mTraceEvents == nullptr) {
+        setTraceCapacity(DEFAULT_TRACE_CAPACITY);
+    }
+
     FileDestination* destination = new FileDestination(filePath, format);
     mDestinations[mNbDestinations] = destination;
 
@@ -266,6 +374,11 @@ void Profiler::addStreamDestination(std::ostream& outputStream, Format format) {
         allocatedDestinations(mNbAllocatedDestinations * 2);
     }
 
+    // A trace destination needs the trace of the profiled blocks of code
+    if (format == Format::ChromeTrace && mTraceEvents == nullptr) {
+        setTraceCapacity(DEFAULT_TRACE_CAPACITY);
+    }
+
     StreamDestination* destination = new StreamDestination(outputStream, format);
     mDestinations[mNbDestinations] = destination;
 
@@ -39,12 +39,31 @@
 #include "tests/collision/TestDynamicAABBTree.h"
 #include "tests/collision/TestHalfEdgeStructure.h"
 #include "tests/collision/TestTriangleVertexArray.h"
+#include "tests/collision/TestCookedMesh.h"
+#include "tests/collision/TestQuickHull.h"
+#include "tests/collision/TestCompoundBody.h"
 #include "tests/containers/TestArray.h"
 #include "tests/containers/TestMap.h"
 #include "tests/containers/TestSet.h"
+#include "tests/containers/TestOpenAddressingMap.h"
+#include "tests/containers/TestOpenAddressingSet.h"
 #include "tests/containers/TestDeque.h"
 #include "tests/containers/TestStack.h"
+#include "tests/memory/TestHeapAllocator.h"
+#include "tests/memory/TestSingleFrameAllocator.h"
+#include "tests/memory/TestPoolAllocator.h"
+#include "tests/memory/TestAllocationTracer.h"
 #include "tests/engine/TestRigidBody.h"
+#include "tests/engine/TestIslands.h"
+#include "tests/engine/TestStaticBodies.h"
+#include "tests/engine/TestWorldReserve.h"
+#include "tests/engine/TestMemoryUsage.h"
+#include "tests/engine/TestWorldCompact.h"
+#include "tests/engine/TestStepStats.h"
+#include "tests/utils/TestProfiler.h"
+#include "tests/utils/TestInstrumentation.h"
+#include "tests/utils/TestDefaultLogger.h"
+#include "tests/utils/TestDebugRenderer.h"
 
 using namespace reactphysics3d;
 
@@ -57,9 +76,18 @@ int main() {
     testSuite.addTest(new TestSet("Set"));
     testSuite.addTest(new TestArray("Array"));
     testSuite.addTest(new TestMap("Map"));
+    testSuite.addTest(new TestOpenAddressingSet("OpenAddressingSet"));
+    testSuite.addTest(new TestOpenAddressingMap("OpenAddressingMap"));
     testSuite.addTest(new TestDeque("Deque"));
     testSuite.addTest(new TestStack("Stack"));
 
+    // ---------- Memory tests ---------- //
+
+    testSuite.addTest(new TestHeapAllocator("HeapAllocator"));
+    testSuite.addTest(new TestSingleFrameAllocator("SingleFrameAllocator"));
+    testSuite.addTest(new TestPoolAllocator("PoolAllocator"));
+    testSuite.addTest(new TestAllocationTracer("AllocationTracer"));
+
     // ---------- Mathematics tests ---------- //
 
     testSuite.addTest(new TestVector2("Vector2"));
@@ -79,11 +107,27 @@ int main() {
     testSuite.addTest(new TestCollisionWorld("CollisionWorld"));
     testSuite.addTest(new TestDynamicAABBTree("DynamicAABBTree"));
     testSuite.addTest(new TestHalfEdgeStructure("HalfEdgeStructure"));
+    testSuite.addTest(new TestCookedMesh("CookedMesh"));
+    testSuite.addTest(new TestQuickHull("QuickHull"));
+    testSuite.addTest(new TestCompoundBody("CompoundBody"));
 
 
     // ---------- Engine tests ---------- //
 
     testSuite.addTest(new TestRigidBody("RigidBody"));
+    testSuite.addTest(new TestIslands("Islands"));
+    testSuite.addTest(new TestStaticBodies("StaticBodies"));
+    testSuite.addTest(new TestWorldReserve("WorldReserve"));
+    testSuite.addTest(new TestMemoryUsage("MemoryUsage"));
+    testSuite.addTest(new TestWorldCompact("WorldCompact"));
+    testSuite.addTest(new TestStepStats("StepStats"));
+
+    // ---------- Utils tests ---------- //
+
+    testSuite.addTest(new TestProfiler("Profiler"));
+    testSuite.addTest(new TestInstrumentation("Instrumentation"));
+    testSuite.addTest(new TestDefaultLogger("DefaultLogger"));
+    testSuite.addTest(new TestDebugRenderer("DebugRenderer"));
 
     // Run the tests
     testSuite.run();
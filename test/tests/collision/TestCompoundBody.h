@@ -0,0 +1,319 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_COMPOUND_BODY_H
+#define TEST_COMPOUND_BODY_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class CompoundTestRaycastCallback
+/**
+ * Raycast callback that keeps the closest hit
+ */
+class CompoundTestRaycastCallback : public RaycastCallback {
+
+    public:
+
+        bool isHit = false;
+        Vector3 worldPoint;
+        Collider* collider = nullptr;
+
+        virtual decimal notifyRaycastHit(const RaycastInfo& info) override {
+            isHit = true;
+            worldPoint = info.worldPoint;
+            collider = info.collider;
+            return info.hitFraction;
+        }
+
+        void reset() {
+            isHit = false;
+            collider = nullptr;
+        }
+};
+
+// Class TestCompoundBody
+/**
+ * Unit test for the bodies in compound mode (single broad-phase proxy per body)
+ */
+class TestCompoundBody : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        PhysicsWorld* mWorld;
+
+        BoxShape* mBoxShape;
+
+        SphereShape* mSphereShape;
+
+        CollisionBody* mCompoundBody;
+
+        CollisionBody* mSphereBody;
+
+        Collider* mColliders[3];
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestCompoundBody(const std::string& name) : Test(name) {
+
+            mWorld = mPhysicsCommon.createPhysicsWorld();
+
+            mBoxShape = mPhysicsCommon.createBoxShape(Vector3(1, 1, 1));
+            mSphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+
+            // Body with three boxes at x=-4, x=0 and x=4
+            mCompoundBody = mWorld->createCollisionBody(Transform::identity());
+            mCompoundBody->setIsCompound(true);
+            for (int i=0; i < 3; i++) {
+                mColliders[i] = mCompoundBody->addCollider(mBoxShape, Transform(Vector3(decimal(-4 + 4 * i), 0, 0), Quaternion::identity()));
+            }
+
+            mSphereBody = mWorld->createCollisionBody(Transform(Vector3(0, 10, 0), Quaternion::identity()));
+            mSphereBody->addCollider(mSphereShape, Transform::identity());
+        }
+
+        /// Destructor
+        virtual ~TestCompoundBody() {
+
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+            mPhysicsCommon.destroyBoxShape(mBoxShape);
+            mPhysicsCommon.destroySphereShape(mSphereShape);
+        }
+
+        /// Run the tests
+        void run() {
+            testOverlap();
+            testRaycast();
+            testAddRemoveColliders();
+            testSimulation();
+            testPairsWhenCompoundBodyMoves();
+        }
+
+        /// Test overlap with the colliders of a compound body
+        void testOverlap() {
+
+            rp3d_test(mCompoundBody->isCompound());
+            rp3d_test(!mSphereBody->isCompound());
+
+            // The sphere is inside the box at x=4
+            mSphereBody->setTransform(Transform(Vector3(decimal(4.5), 0, 0), Quaternion::identity()));
+            rp3d_test(mWorld->testOverlap(mCompoundBody, mSphereBody));
+
+            // The sphere is between two boxes (inside the AABB of the body)
+            mSphereBody->setTransform(Transform(Vector3(2, 0, 0), Quaternion::identity()));
+            rp3d_test(!mWorld->testOverlap(mCompoundBody, mSphereBody));
+
+            // Move the compound body instead of the sphere
+            mCompoundBody->setTransform(Transform(Vector3(2, 0, 0), Quaternion::identity()));
+            rp3d_test(mWorld->testOverlap(mCompoundBody, mSphereBody));
+
+            // Rotate the compound body so that the boxes are along the z axis
+            mCompoundBody->setTransform(Transform(Vector3(2, 0, 0), Quaternion::fromEulerAngles(0, PI_RP3D * decimal(0.5), 0)));
+            rp3d_test(mWorld->testOverlap(mCompoundBody, mSphereBody));
+            mSphereBody->setTransform(Transform(Vector3(decimal(4.5), 0, 0), Quaternion::identity()));
+            rp3d_test(!mWorld->testOverlap(mCompoundBody, mSphereBody));
+            mSphereBody->setTransform(Transform(Vector3(2, 0, decimal(-4.5)), Quaternion::identity()));
+            rp3d_test(mWorld->testOverlap(mCompoundBody, mSphereBody));
+
+            // Same results without the compound mode
+            mCompoundBody->setIsCompound(false);
+            rp3d_test(!mCompoundBody->isCompound());
+            rp3d_test(mWorld->testOverlap(mCompoundBody, mSphereBody));
+            mSphereBody->setTransform(Transform(Vector3(decimal(4.5), 0, 0), Quaternion::identity()));
+            rp3d_test(!mWorld->testOverlap(mCompoundBody, mSphereBody));
+
+            mCompoundBody->setIsCompound(true);
+            rp3d_test(!mWorld->testOverlap(mCompoundBody, mSphereBody));
+            mSphereBody->setTransform(Transform(Vector3(2, 0, decimal(-4.5)), Quaternion::identity()));
+            rp3d_test(mWorld->testOverlap(mCompoundBody, mSphereBody));
+
+            // Two compound bodies
+            mSphereBody->setIsCompound(true);
+            rp3d_test(mWorld->testOverlap(mCompoundBody, mSphereBody));
+            mSphereBody->setTransform(Transform(Vector3(2, 0, decimal(-2)), Quaternion::identity()));
+            rp3d_test(!mWorld->testOverlap(mCompoundBody, mSphereBody));
+            mSphereBody->setIsCompound(false);
+
+            mCompoundBody->setTransform(Transform::identity());
+            mSphereBody->setTransform(Transform(Vector3(0, 10, 0), Quaternion::identity()));
+        }
+
+        /// Test raycasting against the colliders of a compound body
+        void testRaycast() {
+
+            CompoundTestRaycastCallback callback;
+
+            // The ray hits the first box
+            Ray ray1(Vector3(-10, 0, 0), Vector3(10, 0, 0));
+            mWorld->raycast(ray1, &callback);
+            rp3d_test(callback.isHit);
+            rp3d_test(callback.collider == mColliders[0]);
+            rp3d_test(approxEqual(callback.worldPoint, Vector3(-5, 0, 0), decimal(0.001)));
+
+            // The ray hits the last box
+            callback.reset();
+            Ray ray2(Vector3(10, 0, 0), Vector3(-10, 0, 0));
+            mWorld->raycast(ray2, &callback);
+            rp3d_test(callback.isHit);
+            rp3d_test(callback.collider == mColliders[2]);
+            rp3d_test(approxEqual(callback.worldPoint, Vector3(5, 0, 0), decimal(0.001)));
+
+            // The ray passes between two boxes
+            callback.reset();
+            Ray ray3(Vector3(2, -10, 0), Vector3(2, -5, 0));
+            mWorld->raycast(ray3, &callback);
+            rp3d_test(!callback.isHit);
+
+            // The ray hits the middle box from below
+            callback.reset();
+            Ray ray4(Vector3(0, -10, 0), Vector3(0, -5, 0), decimal(2.0));
+            mWorld->raycast(ray4, &callback);
+            rp3d_test(callback.isHit);
+            rp3d_test(callback.collider == mColliders[1]);
+            rp3d_test(approxEqual(callback.worldPoint, Vector3(0, -1, 0), decimal(0.001)));
+
+            // The collision category filtering still applies to the colliders
+            callback.reset();
+            mColliders[0]->setCollisionCategoryBits(0x0002);
+            mWorld->raycast(ray1, &callback, 0x0001);
+            rp3d_test(callback.isHit);
+            rp3d_test(callback.collider == mColliders[1]);
+            mColliders[0]->setCollisionCategoryBits(0x0001);
+        }
+
+        /// Test adding and removing colliders to a compound body
+        void testAddRemoveColliders() {
+
+            mSphereBody->setTransform(Transform(Vector3(0, 4, 0), Quaternion::identity()));
+            rp3d_test(!mWorld->testOverlap(mCompoundBody, mSphereBody));
+
+            // Add a collider under the sphere
+            Collider* collider = mCompoundBody->addCollider(mBoxShape, Transform(Vector3(0, 3, 0), Quaternion::identity()));
+            rp3d_test(collider->getBroadPhaseId() != -1);
+            rp3d_test(mWorld->testOverlap(mCompoundBody, mSphereBody));
+
+            // Remove the collider
+            mCompoundBody->removeCollider(collider);
+            rp3d_test(!mWorld->testOverlap(mCompoundBody, mSphereBody));
+
+            // Deactivate and reactivate the body
+            mSphereBody->setTransform(Transform(Vector3(4, 0, 0), Quaternion::identity()));
+            mCompoundBody->setIsActive(false);
+            rp3d_test(mColliders[0]->getBroadPhaseId() == -1);
+            rp3d_test(!mWorld->testOverlap(mCompoundBody, mSphereBody));
+            mCompoundBody->setIsActive(true);
+            rp3d_test(mColliders[0]->getBroadPhaseId() != -1);
+            rp3d_test(mWorld->testOverlap(mCompoundBody, mSphereBody));
+
+            mSphereBody->setTransform(Transform(Vector3(0, 10, 0), Quaternion::identity()));
+        }
+
+        /// Test a simulation with a dynamic body falling on a static compound body
+        void testSimulation() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+
+            // Static floor made of tiles
+            RigidBody* floor = world->createRigidBody(Transform::identity());
+            floor->setType(BodyType::STATIC);
+            floor->setIsCompound(true);
+            for (int x=-4; x <= 4; x++) {
+                for (int z=-4; z <= 4; z++) {
+                    floor->addCollider(mBoxShape, Transform(Vector3(decimal(x * 2), 0, decimal(z * 2)), Quaternion::identity()));
+                }
+            }
+
+            // Dynamic compound body made of two spheres
+            RigidBody* body = world->createRigidBody(Transform(Vector3(decimal(0.5), 5, decimal(0.5)), Quaternion::identity()));
+            body->setIsCompound(true);
+            body->addCollider(mSphereShape, Transform(Vector3(-1, 0, 0), Quaternion::identity()));
+            body->addCollider(mSphereShape, Transform(Vector3(1, 0, 0), Quaternion::identity()));
+
+            for (int i=0; i < 300; i++) {
+                world->update(decimal(1.0 / 60.0));
+            }
+
+            // The body must rest on the floor
+            const decimal y = body->getTransform().getPosition().y;
+            rp3d_test(y > decimal(1.3) && y < decimal(1.7));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        /// Test that the pairs of colliders of a compound body are removed when it moves away
+        void testPairsWhenCompoundBodyMoves() {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.isSleepingEnabled = false;
+            settings.gravity = Vector3::zero();
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            // Static floor made of tiles with gaps between them
+            RigidBody* floor = world->createRigidBody(Transform::identity());
+            floor->setType(BodyType::STATIC);
+            floor->setIsCompound(true);
+            for (int x=-2; x <= 2; x++) {
+                floor->addCollider(mBoxShape, Transform(Vector3(decimal(x * 4), 0, 0), Quaternion::identity()));
+            }
+
+            // Sphere resting on the tile at the center
+            RigidBody* sphere = world->createRigidBody(Transform(Vector3(0, decimal(1.5), 0), Quaternion::identity()));
+            sphere->addCollider(mSphereShape, Transform::identity());
+
+            world->update(decimal(1.0 / 60.0));
+            rp3d_test(world->getLastStepStats().nbConvexPairs == 1);
+
+            // Move the floor so that the sphere is above a gap (the node of the floor still overlaps the sphere)
+            floor->setTransform(Transform(Vector3(2, 0, 0), Quaternion::identity()));
+            world->update(decimal(1.0 / 60.0));
+            rp3d_test(world->getLastStepStats().nbConvexPairs == 0);
+
+            // Move the floor back under the sphere
+            floor->setTransform(Transform::identity());
+            world->update(decimal(1.0 / 60.0));
+            rp3d_test(world->getLastStepStats().nbConvexPairs == 1);
+
+            // Move the floor far away from the sphere
+            floor->setTransform(Transform(Vector3(0, -100, 0), Quaternion::identity()));
+            world->update(decimal(1.0 / 60.0));
+            rp3d_test(world->getLastStepStats().nbConvexPairs == 0);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,290 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_COOKED_MESH_H
+#define TEST_COOKED_MESH_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestCookedMesh
+/**
+ * Unit test for the cooked TriangleMesh and PolyhedronMesh data
+ */
+class TestCookedMesh : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        float mTriangleVertices[4 * 3];
+        uint32 mTriangleIndices[2 * 3];
+        TriangleVertexArray* mTriangleVertexArray;
+        TriangleMesh* mTriangleMesh;
+
+        float mCubeVertices[8 * 3];
+        uint32 mCubeIndices[24];
+        PolygonVertexArray::PolygonFace mCubeFaces[6];
+        PolygonVertexArray* mPolygonVertexArray;
+        PolyhedronMesh* mPolyhedronMesh;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestCookedMesh(const std::string& name) : Test(name) {
+
+            // Quad made of two triangles
+            const float triangleVertices[] = {-3, 0, -3,  3, 0, -3,  3, 0, 3,  -3, 0, 3};
+            const uint32 triangleIndices[] = {0, 2, 1,  0, 3, 2};
+            std::memcpy(mTriangleVertices, triangleVertices, sizeof(mTriangleVertices));
+            std::memcpy(mTriangleIndices, triangleIndices, sizeof(mTriangleIndices));
+            mTriangleVertexArray = new TriangleVertexArray(4, mTriangleVertices, 3 * sizeof(float), 2, mTriangleIndices, 3 * sizeof(uint32),
+                                                           TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                                           TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            mTriangleMesh = mPhysicsCommon.createTriangleMesh();
+            mTriangleMesh->addSubpart(mTriangleVertexArray);
+
+            // Cube
+            const float cubeVertices[] = {-1, -1, 1,  1, -1, 1,  1, 1, 1,  -1, 1, 1,
+                                          -1, -1, -1,  1, -1, -1,  1, 1, -1,  -1, 1, -1};
+            const uint32 cubeIndices[] = {0, 1, 2, 3,  1, 5, 6, 2,  5, 4, 7, 6,  4, 0, 3, 7,  4, 5, 1, 0,  2, 6, 7, 3};
+            std::memcpy(mCubeVertices, cubeVertices, sizeof(mCubeVertices));
+            std::memcpy(mCubeIndices, cubeIndices, sizeof(mCubeIndices));
+            for (uint32 f=0; f < 6; f++) {
+                mCubeFaces[f].nbVertices = 4;
+                mCubeFaces[f].indexBase = f * 4;
+            }
+            mPolygonVertexArray = new PolygonVertexArray(8, mCubeVertices, 3 * sizeof(float), mCubeIndices, sizeof(uint32), 6, mCubeFaces,
+                                                         PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                                         PolygonVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            mPolyhedronMesh = mPhysicsCommon.createPolyhedronMesh(mPolygonVertexArray);
+        }
+
+        /// Destructor
+        virtual ~TestCookedMesh() {
+            mPhysicsCommon.destroyTriangleMesh(mTriangleMesh);
+            mPhysicsCommon.destroyPolyhedronMesh(mPolyhedronMesh);
+            delete mTriangleVertexArray;
+            delete mPolygonVertexArray;
+        }
+
+        /// Run the tests
+        void run() {
+            testCookedTriangleMesh();
+            testCookedPolyhedronMesh();
+            testInvalidCookedData();
+        }
+
+        void testCookedTriangleMesh() {
+
+            const size_t size = mPhysicsCommon.cookTriangleMesh(mTriangleMesh, nullptr, 0);
+            rp3d_test(size > 0);
+
+            // Use 16 bytes aligned storage
+            std::vector<uint64> buffer(size / sizeof(uint64) + 1);
+            rp3d_test(mPhysicsCommon.cookTriangleMesh(mTriangleMesh, buffer.data(), size) == size);
+
+            TriangleMesh* cookedMesh = mPhysicsCommon.createTriangleMeshFromCookedData(buffer.data(), size);
+            rp3d_test(cookedMesh != nullptr);
+            rp3d_test(cookedMesh->hasCookedBVH());
+            rp3d_test(!mTriangleMesh->hasCookedBVH());
+            rp3d_test(cookedMesh->getNbSubparts() == 1);
+
+            TriangleVertexArray* original = mTriangleMesh->getSubpart(0);
+            TriangleVertexArray* cooked = cookedMesh->getSubpart(0);
+            rp3d_test(cooked->getNbVertices() == 4);
+            rp3d_test(cooked->getNbTriangles() == 2);
+            for (uint32 t=0; t < 2; t++) {
+                Vector3 originalVertices[3], cookedVertices[3];
+                Vector3 originalNormals[3], cookedNormals[3];
+                original->getTriangleVertices(t, originalVertices);
+                cooked->getTriangleVertices(t, cookedVertices);
+                original->getTriangleVerticesNormals(t, originalNormals);
+                cooked->getTriangleVerticesNormals(t, cookedNormals);
+                for (uint32 v=0; v < 3; v++) {
+                    rp3d_test(approxEqual(originalVertices[v], cookedVertices[v]));
+                    rp3d_test(approxEqual(originalNormals[v], cookedNormals[v]));
+                }
+            }
+
+            // The concave mesh shapes created from both meshes must behave the same
+            ConcaveMeshShape* shape = mPhysicsCommon.createConcaveMeshShape(mTriangleMesh);
+            ConcaveMeshShape* cookedShape = mPhysicsCommon.createConcaveMeshShape(cookedMesh);
+            Vector3 min, max, cookedMin, cookedMax;
+            shape->getLocalBounds(min, max);
+            cookedShape->getLocalBounds(cookedMin, cookedMax);
+            rp3d_test(approxEqual(min, cookedMin));
+            rp3d_test(approxEqual(max, cookedMax));
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            CollisionBody* body = world->createCollisionBody(Transform::identity());
+            Collider* collider = body->addCollider(cookedShape, Transform::identity());
+            RaycastInfo raycastInfo;
+            rp3d_test(collider->raycast(Ray(Vector3(1, 5, 1), Vector3(1, -5, 1)), raycastInfo));
+            rp3d_test(approxEqual(raycastInfo.worldPoint, Vector3(1, 0, 1), decimal(0.001)));
+            rp3d_test(!collider->raycast(Ray(Vector3(5, 5, 5), Vector3(5, -5, 5)), raycastInfo));
+            mPhysicsCommon.destroyPhysicsWorld(world);
+
+            mPhysicsCommon.destroyConcaveMeshShape(shape);
+            mPhysicsCommon.destroyConcaveMeshShape(cookedShape);
+            mPhysicsCommon.destroyTriangleMesh(cookedMesh);
+
+            // A sub-part added by the user to a cooked mesh still belongs to the user
+            cookedMesh = mPhysicsCommon.createTriangleMeshFromCookedData(buffer.data(), size);
+            rp3d_test(cookedMesh != nullptr);
+            cookedMesh->addSubpart(mTriangleVertexArray);
+            rp3d_test(cookedMesh->getNbSubparts() == 2);
+            rp3d_test(!cookedMesh->hasCookedBVH());
+            mPhysicsCommon.destroyTriangleMesh(cookedMesh);
+            rp3d_test(mTriangleVertexArray->getNbTriangles() == 2);
+        }
+
+        void testCookedPolyhedronMesh() {
+
+            rp3d_test(mPolyhedronMesh != nullptr);
+
+            const size_t size = mPhysicsCommon.cookPolyhedronMesh(mPolyhedronMesh, nullptr, 0);
+            rp3d_test(size > 0);
+
+            std::vector<uint64> buffer(size / sizeof(uint64) + 1);
+            rp3d_test(mPhysicsCommon.cookPolyhedronMesh(mPolyhedronMesh, buffer.data(), size) == size);
+
+            PolyhedronMesh* cookedMesh = mPhysicsCommon.createPolyhedronMeshFromCookedData(buffer.data(), size);
+            rp3d_test(cookedMesh != nullptr);
+            rp3d_test(cookedMesh->getNbVertices() == 8);
+            rp3d_test(cookedMesh->getNbFaces() == 6);
+            rp3d_test(cookedMesh->getHalfEdgeStructure().getNbHalfEdges() == mPolyhedronMesh->getHalfEdgeStructure().getNbHalfEdges());
+            rp3d_test(approxEqual(cookedMesh->getVolume(), decimal(8.0)));
+            rp3d_test(approxEqual(cookedMesh->getCentroid(), mPolyhedronMesh->getCentroid()));
+
+            for (uint32 v=0; v < 8; v++) {
+                rp3d_test(approxEqual(cookedMesh->getVertex(v), mPolyhedronMesh->getVertex(v)));
+            }
+            for (uint32 f=0; f < 6; f++) {
+                rp3d_test(approxEqual(cookedMesh->getFaceNormal(f), mPolyhedronMesh->getFaceNormal(f)));
+            }
+            const HalfEdgeStructure& halfEdges = mPolyhedronMesh->getHalfEdgeStructure();
+            const HalfEdgeStructure& cookedHalfEdges = cookedMesh->getHalfEdgeStructure();
+            for (uint32 e=0; e < halfEdges.getNbHalfEdges(); e++) {
+                rp3d_test(halfEdges.getHalfEdge(e).vertexIndex == cookedHalfEdges.getHalfEdge(e).vertexIndex);
+                rp3d_test(halfEdges.getHalfEdge(e).twinEdgeIndex == cookedHalfEdges.getHalfEdge(e).twinEdgeIndex);
+                rp3d_test(halfEdges.getHalfEdge(e).faceIndex == cookedHalfEdges.getHalfEdge(e).faceIndex);
+                rp3d_test(halfEdges.getHalfEdge(e).nextEdgeIndex == cookedHalfEdges.getHalfEdge(e).nextEdgeIndex);
+            }
+
+            // Create a convex mesh shape with the cooked mesh
+            ConvexMeshShape* shape = mPhysicsCommon.createConvexMeshShape(cookedMesh);
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            CollisionBody* body = world->createCollisionBody(Transform::identity());
+            Collider* collider = body->addCollider(shape, Transform::identity());
+            rp3d_test(collider->testPointInside(Vector3(0.5, 0.5, 0.5)));
+            rp3d_test(!collider->testPointInside(Vector3(1.5, 0.5, 0.5)));
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyConvexMeshShape(shape);
+
+            mPhysicsCommon.destroyPolyhedronMesh(cookedMesh);
+        }
+
+        void testInvalidCookedData() {
+
+            const size_t size = mPhysicsCommon.cookTriangleMesh(mTriangleMesh, nullptr, 0);
+            std::vector<uint64> buffer(size / sizeof(uint64) + 1);
+            mPhysicsCommon.cookTriangleMesh(mTriangleMesh, buffer.data(), size);
+
+            // Truncated data
+            rp3d_test(mPhysicsCommon.createTriangleMeshFromCookedData(buffer.data(), size / 2) == nullptr);
+
+            // Wrong type of mesh
+            rp3d_test(mPhysicsCommon.createPolyhedronMeshFromCookedData(buffer.data(), size) == nullptr);
+
+            // Wrong magic number
+            buffer[0] = 0;
+            rp3d_test(mPhysicsCommon.createTriangleMeshFromCookedData(buffer.data(), size) == nullptr);
+
+            unsigned char* data = reinterpret_cast<unsigned char*>(buffer.data());
+            const uint64 infoOffset = alignCookedMeshOffset(sizeof(CookedMeshHeader));
+            const uint64 subpartsOffset = alignCookedMeshOffset(infoOffset + sizeof(CookedTriangleMeshInfo));
+            const CookedTriangleMeshInfo* info = reinterpret_cast<const CookedTriangleMeshInfo*>(data + infoOffset);
+            const CookedTriangleSubpart* subpart = reinterpret_cast<const CookedTriangleSubpart*>(data + subpartsOffset);
+
+            // Triangle index out of the range of the vertices
+            mPhysicsCommon.cookTriangleMesh(mTriangleMesh, buffer.data(), size);
+            reinterpret_cast<uint32*>(data + subpart->indicesOffset)[1] = subpart->nbVertices;
+            rp3d_test(mPhysicsCommon.createTriangleMeshFromCookedData(buffer.data(), size) == nullptr);
+
+            // BVH child out of the range of the nodes
+            mPhysicsCommon.cookTriangleMesh(mTriangleMesh, buffer.data(), size);
+            rp3d_test(info->bvhNbNodes > 1);
+            TreeNode* nodes = reinterpret_cast<TreeNode*>(data + info->bvhNodesOffset);
+            nodes[info->bvhRootNodeID].children[1] = info->bvhNbNodes;
+            rp3d_test(mPhysicsCommon.createTriangleMeshFromCookedData(buffer.data(), size) == nullptr);
+
+            // BVH leaf with a triangle out of the range of the sub-part
+            mPhysicsCommon.cookTriangleMesh(mTriangleMesh, buffer.data(), size);
+            for (int32 n=0; n < info->bvhNbNodes; n++) {
+                if (nodes[n].isLeaf()) {
+                    nodes[n].dataInt[1] = static_cast<int32>(subpart->nbTriangles);
+                    break;
+                }
+            }
+            rp3d_test(mPhysicsCommon.createTriangleMeshFromCookedData(buffer.data(), size) == nullptr);
+
+            // Half-edge indices of the vertices and faces out of the range of the half-edges
+            const size_t polyhedronSize = mPhysicsCommon.cookPolyhedronMesh(mPolyhedronMesh, nullptr, 0);
+            std::vector<uint64> polyhedronBuffer(polyhedronSize / sizeof(uint64) + 1);
+            unsigned char* polyhedronData = reinterpret_cast<unsigned char*>(polyhedronBuffer.data());
+            const CookedPolyhedronMeshInfo* polyhedronInfo = reinterpret_cast<const CookedPolyhedronMeshInfo*>(polyhedronData + infoOffset);
+
+            mPhysicsCommon.cookPolyhedronMesh(mPolyhedronMesh, polyhedronBuffer.data(), polyhedronSize);
+            reinterpret_cast<uint32*>(polyhedronData + polyhedronInfo->verticesEdgesOffset)[2] = polyhedronInfo->nbHalfEdges;
+            rp3d_test(mPhysicsCommon.createPolyhedronMeshFromCookedData(polyhedronBuffer.data(), polyhedronSize) == nullptr);
+
+            mPhysicsCommon.cookPolyhedronMesh(mPolyhedronMesh, polyhedronBuffer.data(), polyhedronSize);
+            reinterpret_cast<uint32*>(polyhedronData + polyhedronInfo->facesEdgesOffset)[3] = polyhedronInfo->nbHalfEdges;
+            rp3d_test(mPhysicsCommon.createPolyhedronMeshFromCookedData(polyhedronBuffer.data(), polyhedronSize) == nullptr);
+
+            // The unmodified cooked data is still valid
+            mPhysicsCommon.cookPolyhedronMesh(mPolyhedronMesh, polyhedronBuffer.data(), polyhedronSize);
+            PolyhedronMesh* polyhedronMesh = mPhysicsCommon.createPolyhedronMeshFromCookedData(polyhedronBuffer.data(), polyhedronSize);
+            rp3d_test(polyhedronMesh != nullptr);
+            mPhysicsCommon.destroyPolyhedronMesh(polyhedronMesh);
+            mPhysicsCommon.cookTriangleMesh(mTriangleMesh, buffer.data(), size);
+            TriangleMesh* triangleMesh = mPhysicsCommon.createTriangleMeshFromCookedData(buffer.data(), size);
+            rp3d_test(triangleMesh != nullptr);
+            mPhysicsCommon.destroyTriangleMesh(triangleMesh);
+        }
+ };
+
+}
+
+#endif
@@ -136,6 +136,10 @@ class TestDynamicAABBTree : public Test {
             testBasicsMethods();
             testOverlapping();
             testRaycast();
+            testReserve();
+            testCompact();
+            testQualityMetrics();
+            testRebuild();
 
         }
 
@@ -560,6 +564,314 @@ class TestDynamicAABBTree : public Test {
             rp3d_test(mRaycastCallback.isHit(object4Id));
 
         }
+
+        void testReserve() {
+
+            // ------------- Create tree ----------- //
+
+            // Dynamic AABB Tree
+            DynamicAABBTree tree(mAllocator);
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            tree.setProfiler(mProfiler);
+#endif
+
+            int objectsData[64];
+            int objectsIds[64];
+
+            // Add some objects and remove some of them so that the free nodes are interleaved
+            for (int i=0; i < 16; i++) {
+                objectsData[i] = i;
+                objectsIds[i] = tree.addObject(AABB(Vector3(i * 3, 0, 0), Vector3(i * 3 + 1, 1, 1)), &objectsData[i]);
+            }
+            for (int i=0; i < 16; i += 2) {
+                tree.removeObject(objectsIds[i]);
+            }
+
+            // ---------- Tests ---------- //
+
+            tree.reserve(256);
+
+            // The remaining objects are still in the tree
+            for (int i=1; i < 16; i += 2) {
+                rp3d_test(*(int*)(tree.getNodeDataPointer(objectsIds[i])) == i);
+            }
+
+            // Add more objects (this uses the new nodes and the previously released ones)
+            for (int i=0; i < 16; i += 2) {
+                objectsIds[i] = tree.addObject(AABB(Vector3(i * 3, 0, 0), Vector3(i * 3 + 1, 1, 1)), &objectsData[i]);
+            }
+            for (int i=16; i < 64; i++) {
+                objectsData[i] = i;
+                objectsIds[i] = tree.addObject(AABB(Vector3(i * 3, 0, 0), Vector3(i * 3 + 1, 1, 1)), &objectsData[i]);
+            }
+
+            // Reserving less nodes than the allocated ones does nothing
+            tree.reserve(8);
+
+            Array<int> overlappingNodes(mAllocator);
+            for (int i=0; i < 64; i++) {
+
+                rp3d_test(*(int*)(tree.getNodeDataPointer(objectsIds[i])) == i);
+
+                overlappingNodes.clear();
+                tree.reportAllShapesOverlappingWithAABB(AABB(Vector3(i * 3 + decimal(0.25), decimal(0.25), decimal(0.25)),
+                                                             Vector3(i * 3 + decimal(0.75), decimal(0.75), decimal(0.75))), overlappingNodes);
+                rp3d_test(overlappingNodes.size() == 1);
+                rp3d_test(isOverlapping(objectsIds[i], overlappingNodes));
+            }
+        }
+
+        void testCompact() {
+
+            // ------------- Create tree ----------- //
+
+            // Dynamic AABB Tree
+            DynamicAABBTree tree(mAllocator);
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            tree.setProfiler(mProfiler);
+#endif
+
+            int objectsData[256];
+            int objectsIds[256];
+
+            for (int i=0; i < 256; i++) {
+                objectsData[i] = i;
+                objectsIds[i] = tree.addObject(AABB(Vector3(i * 3, 0, 0), Vector3(i * 3 + 1, 1, 1)), &objectsData[i]);
+            }
+
+            // Remove most of the objects
+            for (int i=0; i < 256; i++) {
+                if (i % 32 != 0) {
+                    tree.removeObject(objectsIds[i]);
+                }
+            }
+
+            const size_t reservedMemory = tree.getMemoryUsage().reservedBytes;
+
+            // ---------- Tests ---------- //
+
+            Array<int32> newNodeIds(mAllocator);
+            tree.compact(newNodeIds);
+
+            // The memory only fits the remaining nodes
+            rp3d_test(tree.getNbNodes() == 2 * 8 - 1);
+            rp3d_test(tree.getMemoryUsage().reservedBytes < reservedMemory);
+            rp3d_test(tree.getMemoryUsage().reservedBytes == tree.getMemoryUsage().usedBytes);
+
+            // The root node is the first one and the nodes are in depth-first order
+            rp3d_test(newNodeIds.size() > 0);
+            rp3d_test(tree.getRootNodeID() == 0);
+            const TreeNode* nodes = tree.getNodes();
+            for (int32 i=0; i < tree.getNbNodes(); i++) {
+                if (!nodes[i].isLeaf()) {
+                    rp3d_test(nodes[i].children[0] == i + 1);
+                    rp3d_test(nodes[nodes[i].children[0]].parentID == i);
+                    rp3d_test(nodes[nodes[i].children[1]].parentID == i);
+                }
+            }
+
+            Array<int> overlappingNodes(mAllocator);
+            for (int i=0; i < 256; i += 32) {
+
+                // The objects can be found with their new IDs
+                objectsIds[i] = newNodeIds[objectsIds[i]];
+                rp3d_test(*(int*)(tree.getNodeDataPointer(objectsIds[i])) == i);
+
+                overlappingNodes.clear();
+                tree.reportAllShapesOverlappingWithAABB(AABB(Vector3(i * 3 + decimal(0.25), decimal(0.25), decimal(0.25)),
+                                                             Vector3(i * 3 + decimal(0.75), decimal(0.75), decimal(0.75))), overlappingNodes);
+                rp3d_test(overlappingNodes.size() == 1);
+                rp3d_test(isOverlapping(objectsIds[i], overlappingNodes));
+            }
+
+            // Objects can still be added and removed
+            for (int i=0; i < 256; i++) {
+                if (i % 32 != 0) {
+                    objectsIds[i] = tree.addObject(AABB(Vector3(i * 3, 0, 0), Vector3(i * 3 + 1, 1, 1)), &objectsData[i]);
+                }
+            }
+            rp3d_test(tree.getNbNodes() == 2 * 256 - 1);
+            for (int i=0; i < 256; i++) {
+                rp3d_test(*(int*)(tree.getNodeDataPointer(objectsIds[i])) == i);
+            }
+
+            // Compacting an empty tree resets it
+            for (int i=0; i < 256; i++) {
+                tree.removeObject(objectsIds[i]);
+            }
+            tree.compact(newNodeIds);
+            rp3d_test(newNodeIds.size() == 0);
+            rp3d_test(tree.getNbNodes() == 0);
+            rp3d_test(tree.getMemoryUsage().reservedBytes < reservedMemory);
+        }
+
+        void testQualityMetrics() {
+
+            // ------------- Create tree ----------- //
+
+            // Dynamic AABB Tree with fat AABBs inflated by 50%
+            DynamicAABBTree tree(mAllocator, decimal(0.5));
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            tree.setProfiler(mProfiler);
+#endif
+
+            // ---------- Tests ---------- //
+
+            // Empty tree
+            DynamicAABBTree::QualityMetrics metrics = tree.computeQualityMetrics();
+            rp3d_test(metrics.nbLeafNodes == 0);
+            rp3d_test(metrics.sahCost == 0);
+            rp3d_test(metrics.sahCostRatio == 1);
+            rp3d_test(metrics.getFatAABBHitRate() == 1);
+
+            int objectsData[4];
+            int objectsIds[4];
+            for (int i=0; i < 4; i++) {
+                objectsData[i] = i;
+                objectsIds[i] = tree.addObject(AABB(Vector3(i * 4, 0, 0), Vector3(i * 4 + 2, 2, 2)), &objectsData[i]);
+            }
+
+            // The cost of the tree is the sum of the areas of the internal nodes over the area of the root
+            const decimal rootArea = tree.getRootAABB().getSurfaceArea();
+            decimal internalNodesArea = 0;
+            const TreeNode* nodes = tree.getNodes();
+            for (int32 i=0; i < tree.getNbAllocatedNodes(); i++) {
+                if (nodes[i].height > 0) internalNodesArea += nodes[i].aabb.getSurfaceArea();
+            }
+            rp3d_test(approxEqual(tree.computeSAHCost(), internalNodesArea / rootArea));
+
+            metrics = tree.computeQualityMetrics();
+            rp3d_test(metrics.nbLeafNodes == 4);
+            rp3d_test(metrics.height == nodes[tree.getRootNodeID()].height);
+            rp3d_test(approxEqual(metrics.sahCost, tree.computeSAHCost()));
+            rp3d_test(metrics.rebuiltSahCost >= 1);
+            rp3d_test(metrics.nbObjectUpdates == 0);
+
+            // A small move stays in the fat AABB
+            rp3d_test(!tree.updateObject(objectsIds[0], AABB(Vector3(decimal(0.1), 0, 0), Vector3(decimal(2.1), 2, 2))));
+
+            // A large move or a forced update reinserts the node
+            rp3d_test(tree.updateObject(objectsIds[1], AABB(Vector3(20, 0, 0), Vector3(22, 2, 2))));
+            rp3d_test(tree.updateObject(objectsIds[2], AABB(Vector3(8, 0, 0), Vector3(10, 2, 2)), true));
+            rp3d_test(!tree.updateObject(objectsIds[3], AABB(Vector3(12, 0, 0), Vector3(14, 2, 2))));
+
+            metrics = tree.computeQualityMetrics();
+            rp3d_test(metrics.nbObjectUpdates == 4);
+            rp3d_test(metrics.nbFatAABBHits == 2);
+            rp3d_test(metrics.nbReinsertions == 2);
+            rp3d_test(approxEqual(metrics.getFatAABBHitRate(), decimal(0.5)));
+            rp3d_test(tree.getNbObjectUpdates() == 4);
+            rp3d_test(tree.getNbReinsertions() == 2);
+
+            tree.resetUpdateCounters();
+            metrics = tree.computeQualityMetrics();
+            rp3d_test(metrics.nbObjectUpdates == 0);
+            rp3d_test(metrics.nbFatAABBHits == 0);
+            rp3d_test(metrics.nbReinsertions == 0);
+        }
+
+        void testRebuild() {
+
+            // ------------- Create tree ----------- //
+
+            // Dynamic AABB Tree
+            DynamicAABBTree tree(mAllocator, decimal(0.1));
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            tree.setProfiler(mProfiler);
+#endif
+
+            // Objects on a 16x16 grid
+            int objectsData[256];
+            int objectsIds[256];
+            for (int i=0; i < 256; i++) {
+                objectsData[i] = i;
+                const Vector3 min(decimal((i % 16) * 3), 0, decimal((i / 16) * 3));
+                objectsIds[i] = tree.addObject(AABB(min, min + Vector3(1, 1, 1)), &objectsData[i]);
+            }
+
+            // Move the objects in a pseudo-random order to other cells of the grid to degrade the tree
+            for (int step=0; step < 8; step++) {
+                for (int i=0; i < 256; i++) {
+                    const int cell = (i * 97 + step * 31) % 256;
+                    const Vector3 min(decimal((cell % 16) * 3), 0, decimal((cell / 16) * 3));
+                    tree.updateObject(objectsIds[i], AABB(min, min + Vector3(1, 1, 1)));
+                }
+            }
+
+            const DynamicAABBTree::QualityMetrics degradedMetrics = tree.computeQualityMetrics();
+            rp3d_test(degradedMetrics.nbLeafNodes == 256);
+            rp3d_test(degradedMetrics.sahCostRatio > 1);
+
+            // ---------- Tests ---------- //
+
+            tree.rebuild();
+
+            // The cost of the tree is the one computed before the rebuild
+            const DynamicAABBTree::QualityMetrics metrics = tree.computeQualityMetrics();
+            rp3d_test(approxEqual(metrics.sahCost, degradedMetrics.rebuiltSahCost, decimal(0.0001)));
+            rp3d_test(approxEqual(metrics.sahCostRatio, decimal(1.0), decimal(0.0001)));
+            rp3d_test(metrics.sahCost < degradedMetrics.sahCost);
+            rp3d_test(metrics.nbObjectUpdates == degradedMetrics.nbObjectUpdates);
+
+            // The structure of the tree is valid
+            rp3d_test(tree.getNbNodes() == 2 * 256 - 1);
+            const TreeNode* nodes = tree.getNodes();
+            rp3d_test(metrics.height == nodes[tree.getRootNodeID()].height);
+            rp3d_test(nodes[tree.getRootNodeID()].parentID == TreeNode::NULL_TREE_NODE);
+            for (int32 i=0; i < tree.getNbAllocatedNodes(); i++) {
+                if (nodes[i].height > 0) {
+                    const TreeNode& leftChild = nodes[nodes[i].children[0]];
+                    const TreeNode& rightChild = nodes[nodes[i].children[1]];
+                    rp3d_test(leftChild.parentID == i);
+                    rp3d_test(rightChild.parentID == i);
+                    rp3d_test(nodes[i].height == 1 + std::max(leftChild.height, rightChild.height));
+                    rp3d_test(nodes[i].aabb.contains(leftChild.aabb));
+                    rp3d_test(nodes[i].aabb.contains(rightChild.aabb));
+                }
+            }
+
+            // The objects keep their IDs and can be found in the tree
+            Array<int> overlappingNodes(mAllocator);
+            for (int i=0; i < 256; i++) {
+
+                rp3d_test(*(int*)(tree.getNodeDataPointer(objectsIds[i])) == i);
+
+                const AABB& fatAABB = tree.getFatAABB(objectsIds[i]);
+                overlappingNodes.clear();
+                tree.reportAllShapesOverlappingWithAABB(AABB(fatAABB.getCenter() - Vector3(decimal(0.1), decimal(0.1), decimal(0.1)),
+                                                             fatAABB.getCenter() + Vector3(decimal(0.1), decimal(0.1), decimal(0.1))), overlappingNodes);
+                rp3d_test(overlappingNodes.size() == 1);
+                rp3d_test(isOverlapping(objectsIds[i], overlappingNodes));
+            }
+
+            // Objects can still be removed and added
+            for (int i=0; i < 256; i += 2) {
+                tree.removeObject(objectsIds[i]);
+            }
+            for (int i=0; i < 256; i += 2) {
+                objectsIds[i] = tree.addObject(AABB(Vector3(100, 0, decimal(i)), Vector3(101, 1, decimal(i) + decimal(0.5))), &objectsData[i]);
+            }
+            rp3d_test(tree.getNbNodes() == 2 * 256 - 1);
+            for (int i=0; i < 256; i++) {
+                rp3d_test(*(int*)(tree.getNodeDataPointer(objectsIds[i])) == i);
+            }
+
+            // Rebuilding a tree with a single object
+            DynamicAABBTree smallTree(mAllocator);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+            smallTree.setProfiler(mProfiler);
+#endif
+
+            const int smallTreeId = smallTree.addObject(AABB(Vector3(0, 0, 0), Vector3(1, 1, 1)), &objectsData[0]);
+            smallTree.rebuild();
+            rp3d_test(smallTree.getRootNodeID() == smallTreeId);
+            rp3d_test(smallTree.computeSAHCost() == 0);
+        }
  };
 
 }
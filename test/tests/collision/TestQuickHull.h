@@ -0,0 +1,183 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_QUICK_HULL_H
+#define TEST_QUICK_HULL_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <cstdlib>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestQuickHull
+/**
+ * Unit test for the QuickHull class
+ */
+class TestQuickHull : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestQuickHull(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+            testBoxPointCloud();
+            testVerticesBudget();
+            testDegeneratePoints();
+        }
+
+        void testBoxPointCloud() {
+
+            // Corners of a box, points on its faces and points inside it
+            float points[3 * 64];
+            uint32 nbPoints = 0;
+            for (int x=-1; x <= 1; x += 2) {
+                for (int y=-1; y <= 1; y += 2) {
+                    for (int z=-1; z <= 1; z += 2) {
+                        points[nbPoints * 3] = float(x) * 2.0f; points[nbPoints * 3 + 1] = float(y); points[nbPoints * 3 + 2] = float(z);
+                        nbPoints++;
+                    }
+                }
+            }
+            const float facePoints[] = {0, 1, 0,  0, -1, 0,  2, 0.5f, 0.5f,  -2, -0.2f, 0.3f,  1, 0, 1,  -1.5f, 0.5f, -1,
+                                        0, 0, 0,  0.5f, 0.2f, -0.3f,  -1, -0.5f, 0.5f};
+            for (uint32 i=0; i < 9; i++) {
+                points[nbPoints * 3] = facePoints[i * 3]; points[nbPoints * 3 + 1] = facePoints[i * 3 + 1]; points[nbPoints * 3 + 2] = facePoints[i * 3 + 2];
+                nbPoints++;
+            }
+
+            PolyhedronMesh* mesh = mPhysicsCommon.createConvexHullMesh(points, nbPoints, 3 * sizeof(float),
+                                                                        PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE);
+            rp3d_test(mesh != nullptr);
+            rp3d_test(mesh->getNbVertices() == 8);
+            rp3d_test(mesh->getNbFaces() == 6);
+            rp3d_test(approxEqual(mesh->getVolume(), decimal(16.0), decimal(0.0001)));
+            rp3d_test(approxEqual(mesh->getCentroid(), Vector3(0, 0, 0), decimal(0.0001)));
+
+            // The face normals must point outside the hull
+            for (uint32 f=0; f < mesh->getNbFaces(); f++) {
+                const HalfEdgeStructure::Face& face = mesh->getHalfEdgeStructure().getFace(f);
+                const Vector3 faceVertex = mesh->getVertex(face.faceVertices[0]);
+                rp3d_test(mesh->getFaceNormal(f).dot(faceVertex - mesh->getCentroid()) > decimal(0.0));
+            }
+
+            // Without merging the coplanar faces, the hull is made of triangles
+            QuickHull::Settings settings;
+            settings.mergeCoplanarFaces = false;
+            PolyhedronMesh* triangleMesh = mPhysicsCommon.createConvexHullMesh(points, nbPoints, 3 * sizeof(float),
+                                                                                PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE, settings);
+            rp3d_test(triangleMesh != nullptr);
+            rp3d_test(triangleMesh->getNbVertices() == 8);
+            rp3d_test(triangleMesh->getNbFaces() == 12);
+            rp3d_test(approxEqual(triangleMesh->getVolume(), decimal(16.0), decimal(0.0001)));
+
+            // The hull can be used to create a convex mesh shape
+            ConvexMeshShape* shape = mPhysicsCommon.createConvexMeshShape(mesh);
+            Vector3 min, max;
+            shape->getLocalBounds(min, max);
+            rp3d_test(approxEqual(min, Vector3(-2, -1, -1), decimal(0.0001)));
+            rp3d_test(approxEqual(max, Vector3(2, 1, 1), decimal(0.0001)));
+            mPhysicsCommon.destroyConvexMeshShape(shape);
+
+            mPhysicsCommon.destroyPolyhedronMesh(mesh);
+            mPhysicsCommon.destroyPolyhedronMesh(triangleMesh);
+        }
+
+        void testVerticesBudget() {
+
+            // Random points on a sphere
+            const uint32 nbPoints = 500;
+            double points[3 * nbPoints];
+            std::srand(42);
+            for (uint32 i=0; i < nbPoints; i++) {
+                Vector3 point(decimal(std::rand()) / RAND_MAX - decimal(0.5), decimal(std::rand()) / RAND_MAX - decimal(0.5),
+                              decimal(std::rand()) / RAND_MAX - decimal(0.5));
+                point = point.getUnit() * decimal(3.0);
+                points[i * 3] = point.x; points[i * 3 + 1] = point.y; points[i * 3 + 2] = point.z;
+            }
+
+            QuickHull::Settings settings;
+            settings.maxNbVertices = 24;
+            PolyhedronMesh* mesh = mPhysicsCommon.createConvexHullMesh(points, nbPoints, 3 * sizeof(double),
+                                                                        PolygonVertexArray::VertexDataType::VERTEX_DOUBLE_TYPE, settings);
+            rp3d_test(mesh != nullptr);
+            rp3d_test(mesh->getNbVertices() <= 24);
+            rp3d_test(mesh->getNbVertices() >= 20);
+
+            // The budgeted hull is inside the sphere but close to its volume
+            const decimal sphereVolume = decimal(4.0 / 3.0) * PI_RP3D * decimal(27.0);
+            rp3d_test(mesh->getVolume() < sphereVolume);
+            rp3d_test(mesh->getVolume() > decimal(0.6) * sphereVolume);
+
+            settings.maxNbVertices = 0;
+            settings.maxNbFaces = 30;
+            PolyhedronMesh* mesh2 = mPhysicsCommon.createConvexHullMesh(points, nbPoints, 3 * sizeof(double),
+                                                                         PolygonVertexArray::VertexDataType::VERTEX_DOUBLE_TYPE, settings);
+            rp3d_test(mesh2 != nullptr);
+            rp3d_test(mesh2->getNbFaces() <= 30);
+
+            // Full hull
+            settings.maxNbFaces = 0;
+            PolyhedronMesh* mesh3 = mPhysicsCommon.createConvexHullMesh(points, nbPoints, 3 * sizeof(double),
+                                                                         PolygonVertexArray::VertexDataType::VERTEX_DOUBLE_TYPE, settings);
+            rp3d_test(mesh3 != nullptr);
+            rp3d_test(mesh3->getNbVertices() > 24);
+            rp3d_test(mesh3->getVolume() > mesh->getVolume());
+
+            mPhysicsCommon.destroyPolyhedronMesh(mesh);
+            mPhysicsCommon.destroyPolyhedronMesh(mesh2);
+            mPhysicsCommon.destroyPolyhedronMesh(mesh3);
+        }
+
+        void testDegeneratePoints() {
+
+            // Coplanar points
+            const float planarPoints[] = {0, 0, 0,  1, 0, 0,  0, 0, 1,  1, 0, 1,  0.5f, 0, 0.5f};
+            rp3d_test(mPhysicsCommon.createConvexHullMesh(planarPoints, 5, 3 * sizeof(float),
+                                                          PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE) == nullptr);
+
+            // Not enough points
+            const float points[] = {0, 0, 0,  1, 0, 0,  0, 1, 0};
+            rp3d_test(mPhysicsCommon.createConvexHullMesh(points, 3, 3 * sizeof(float),
+                                                          PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE) == nullptr);
+        }
+ };
+
+}
+
+#endif
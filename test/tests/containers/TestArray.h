@@ -65,6 +65,7 @@ class TestArray : public Test {
             testFind();
             testEquality();
             testReserve();
+            testShrinkToFit();
             testIterators();
         }
 
@@ -382,6 +383,31 @@ class TestArray : public Test {
             rp3d_test(array1[1] == 2);
         }
 
+        void testShrinkToFit() {
+
+            Array<std::string> array1(mAllocator, 100);
+            array1.add("test1");
+            array1.add("test2");
+            array1.add("test3");
+            array1.shrinkToFit();
+            rp3d_test(array1.capacity() == 3);
+            rp3d_test(array1.size() == 3);
+            rp3d_test(array1[0] == "test1");
+            rp3d_test(array1[2] == "test3");
+
+            array1.add("test4");
+            rp3d_test(array1.size() == 4);
+            rp3d_test(array1[3] == "test4");
+
+            array1.clear();
+            array1.shrinkToFit();
+            rp3d_test(array1.capacity() == 0);
+
+            array1.add("test5");
+            rp3d_test(array1.size() == 1);
+            rp3d_test(array1[0] == "test5");
+        }
+
         void testIterators() {
 
             Array<int> array1(mAllocator);
@@ -84,6 +84,7 @@ class TestMap : public Test {
 
             testConstructors();
             testReserve();
+            testShrinkToFit();
             testAddRemoveClear();
             testContainsKey();
             testFind();
@@ -143,6 +144,47 @@ class TestMap : public Test {
             rp3d_test(map1[2] == "test2");
         }
 
+        void testShrinkToFit() {
+
+            Map<int, std::string> map1(mAllocator);
+            for (int i=0; i < 1000; i++) {
+                map1.add(Pair<int, std::string>(i, std::to_string(i)));
+            }
+            const uint64 capacity = map1.capacity();
+
+            // Remove most of the elements
+            for (int i=0; i < 990; i++) {
+                map1.remove(i);
+            }
+            map1.shrinkToFit();
+            rp3d_test(map1.capacity() < capacity);
+            rp3d_test(map1.size() == 10);
+            bool isValid = true;
+            for (int i=990; i < 1000; i++) {
+                if (!(map1[i] == std::to_string(i))) isValid = false;
+            }
+            rp3d_test(isValid);
+
+            // The map can still be used after the shrink
+            map1.add(Pair<int, std::string>(1000, "test"));
+            rp3d_test(map1.size() == 11);
+            for (int i=0; i < 100; i++) {
+                map1.add(Pair<int, std::string>(i, std::to_string(i)));
+            }
+            rp3d_test(map1.size() == 111);
+            isValid = true;
+            for (int i=0; i < 100; i++) {
+                if (!(map1[i] == std::to_string(i))) isValid = false;
+            }
+            rp3d_test(isValid);
+
+            map1.clear();
+            map1.shrinkToFit();
+            rp3d_test(map1.capacity() == 0);
+            map1.add(Pair<int, std::string>(1000, "test"));
+            rp3d_test(map1.size() == 1);
+        }
+
         void testAddRemoveClear() {
 
             // ----- Test add() ----- //
@@ -84,6 +84,7 @@ class TestSet : public Test {
 
             testConstructors();
             testReserve();
+            testShrinkToFit();
             testAddRemoveClear();
             testContains();
             testFind();
@@ -145,6 +146,47 @@ class TestSet : public Test {
             rp3d_test(set1.contains("test2"));
         }
 
+        void testShrinkToFit() {
+
+            Set<std::string> set1(mAllocator);
+            for (int i=0; i < 1000; i++) {
+                set1.add(std::to_string(i));
+            }
+            const uint64 capacity = set1.capacity();
+
+            // Remove most of the elements
+            for (int i=0; i < 990; i++) {
+                set1.remove(std::to_string(i));
+            }
+            set1.shrinkToFit();
+            rp3d_test(set1.capacity() < capacity);
+            rp3d_test(set1.size() == 10);
+            bool isValid = true;
+            for (int i=990; i < 1000; i++) {
+                if (!(set1.contains(std::to_string(i)))) isValid = false;
+            }
+            rp3d_test(isValid);
+
+            // The set can still be used after the shrink
+            set1.add("test");
+            rp3d_test(set1.size() == 11);
+            for (int i=0; i < 100; i++) {
+                set1.add(std::to_string(i));
+            }
+            rp3d_test(set1.size() == 111);
+            isValid = true;
+            for (int i=0; i < 100; i++) {
+                if (!(set1.contains(std::to_string(i)))) isValid = false;
+            }
+            rp3d_test(isValid);
+
+            set1.clear();
+            set1.shrinkToFit();
+            rp3d_test(set1.capacity() == 0);
+            set1.add("test");
+            rp3d_test(set1.size() == 1);
+        }
+
         void testAddRemoveClear() {
 
             // ----- Test add() ----- //
@@ -0,0 +1,213 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_ISLANDS_H
+#define TEST_ISLANDS_H
+
+// Libraries
+#include "WorldTestFixture.h"
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestIslands
+/**
+ * Unit test for the persistent islands of rigid bodies and the sleeping of bodies
+ */
+class TestIslands : public WorldTestFixture {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsWorld* mWorld;
+
+        RigidBody* mFloorBody;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestIslands(const std::string& name) : WorldTestFixture(name, 20) {
+
+            mWorld = mPhysicsCommon.createPhysicsWorld();
+            mFloorBody = createFloor(mWorld);
+        }
+
+        /// Destructor
+        virtual ~TestIslands() {
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+        }
+
+        /// Run the tests
+        void run() {
+            testSleepingStack();
+            testSplitAfterLostContact();
+            testSplitAfterJointDestroyed();
+            testBodyTypeChange();
+            testSplitWithoutSleeping();
+        }
+
+        /// Test that a stack of bodies and an isolated body go to sleep
+        void testSleepingStack() {
+
+            RigidBody* box1 = createBox(mWorld, Vector3(0, decimal(0.5), 0));
+            RigidBody* box2 = createBox(mWorld, Vector3(0, decimal(1.5), 0));
+            RigidBody* box3 = createBox(mWorld, Vector3(5, decimal(0.5), 0));
+
+            simulate(mWorld, 300);
+
+            rp3d_test(box1->isSleeping());
+            rp3d_test(box2->isSleeping());
+            rp3d_test(box3->isSleeping());
+
+            // The bodies did not fall through the floor
+            rp3d_test(box2->getTransform().getPosition().y > decimal(1.0));
+
+            mWorld->destroyRigidBody(box1);
+            mWorld->destroyRigidBody(box2);
+            mWorld->destroyRigidBody(box3);
+        }
+
+        /// Test that a body that is not in contact anymore with an awake body can sleep
+        void testSplitAfterLostContact() {
+
+            // The bottom box is never allowed to sleep and keeps the top box awake
+            RigidBody* bottomBox = createBox(mWorld, Vector3(0, decimal(0.5), 0));
+            bottomBox->setIsAllowedToSleep(false);
+            RigidBody* topBox = createBox(mWorld, Vector3(0, decimal(1.5), 0));
+
+            simulate(mWorld, 150);
+
+            rp3d_test(!bottomBox->isSleeping());
+            rp3d_test(!topBox->isSleeping());
+
+            // Move the bottom box away so that the top box falls on the floor
+            bottomBox->setTransform(Transform(Vector3(5, decimal(0.5), 0), Quaternion::identity()));
+
+            simulate(mWorld, 300);
+
+            rp3d_test(!bottomBox->isSleeping());
+            rp3d_test(topBox->isSleeping());
+
+            mWorld->destroyRigidBody(bottomBox);
+            mWorld->destroyRigidBody(topBox);
+        }
+
+        /// Test that a body that is not connected anymore by a joint to an awake body can sleep
+        void testSplitAfterJointDestroyed() {
+
+            RigidBody* box1 = createBox(mWorld, Vector3(-1, decimal(0.5), 0));
+            box1->setIsAllowedToSleep(false);
+            RigidBody* box2 = createBox(mWorld, Vector3(1, decimal(0.5), 0));
+
+            BallAndSocketJointInfo jointInfo(box1, box2, Vector3(0, decimal(0.5), 0));
+            Joint* joint = mWorld->createJoint(jointInfo);
+
+            simulate(mWorld, 150);
+
+            rp3d_test(!box1->isSleeping());
+            rp3d_test(!box2->isSleeping());
+
+            mWorld->destroyJoint(joint);
+
+            simulate(mWorld, 150);
+
+            rp3d_test(!box1->isSleeping());
+            rp3d_test(box2->isSleeping());
+
+            mWorld->destroyRigidBody(box1);
+            mWorld->destroyRigidBody(box2);
+        }
+
+        /// Test the islands when the type of a body changes
+        void testBodyTypeChange() {
+
+            RigidBody* box1 = createBox(mWorld, Vector3(0, decimal(0.5), 0));
+            box1->setIsAllowedToSleep(false);
+            RigidBody* box2 = createBox(mWorld, Vector3(0, decimal(1.5), 0));
+
+            simulate(mWorld, 60);
+
+            rp3d_test(!box2->isSleeping());
+
+            // A static body does not keep the bodies in contact with it awake
+            box1->setType(BodyType::STATIC);
+
+            simulate(mWorld, 150);
+
+            rp3d_test(box2->isSleeping());
+
+            // The dynamic body wakes up the body resting on it
+            box1->setType(BodyType::DYNAMIC);
+            box1->applyWorldForceAtCenterOfMass(Vector3(0, 100, 0));
+
+            simulate(mWorld, 2);
+
+            rp3d_test(!box1->isSleeping());
+            rp3d_test(!box2->isSleeping());
+
+            mWorld->destroyRigidBody(box1);
+            mWorld->destroyRigidBody(box2);
+        }
+
+        /// Test that the islands are split when the bodies separate and the sleeping is disabled
+        void testSplitWithoutSleeping() {
+
+            mWorld->enableSleeping(false);
+
+            RigidBody* box1 = createBox(mWorld, Vector3(0, decimal(0.5), 0));
+            RigidBody* box2 = createBox(mWorld, Vector3(5, decimal(0.5), 0));
+
+            simulate(mWorld, 10);
+
+            rp3d_test(mWorld->getLastStepStats().nbIslands == 2);
+
+            // The two bodies touch each other
+            box2->setTransform(Transform(Vector3(decimal(0.99), decimal(0.5), 0), Quaternion::identity()));
+
+            simulate(mWorld, 2);
+
+            rp3d_test(mWorld->getLastStepStats().nbIslands == 1);
+
+            // The two bodies are separated again
+            box2->setTransform(Transform(Vector3(5, decimal(0.5), 0), Quaternion::identity()));
+            box2->setLinearVelocity(Vector3::zero());
+
+            simulate(mWorld, 3);
+
+            rp3d_test(mWorld->getLastStepStats().nbIslands == 2);
+
+            mWorld->destroyRigidBody(box1);
+            mWorld->destroyRigidBody(box2);
+
+            mWorld->enableSleeping(true);
+        }
+};
+
+}
+
+#endif
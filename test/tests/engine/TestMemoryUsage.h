@@ -0,0 +1,172 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+#ifndef TEST_MEMORY_USAGE_H
+#define TEST_MEMORY_USAGE_H
+
+// Libraries
+#include "WorldTestFixture.h"
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestMemoryUsage
+/**
+ * Unit test for the memory usage reported by the allocators, the physics world
+ * and the concave mesh shapes
+ */
+class TestMemoryUsage : public WorldTestFixture {
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestMemoryUsage(const std::string& name) : WorldTestFixture(name, 50) {
+
+        }
+
+        /// Run the tests
+        void run() {
+            testAllocatorsMemoryUsage();
+            testWorldMemoryUsage();
+            testConcaveMeshesMemoryUsage();
+        }
+
+        /// Test the memory usage of the allocators of the memory manager
+        void testAllocatorsMemoryUsage() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+
+            // The memory usage of the default base allocator is not tracked
+            const MemoryUsage baseMemoryUsage = mPhysicsCommon.getMemoryUsage(MemoryManager::AllocationType::Base);
+            rp3d_test(baseMemoryUsage.reservedBytes == 0);
+            rp3d_test(baseMemoryUsage.usedBytes == 0);
+
+            const MemoryUsage heapMemoryUsage = mPhysicsCommon.getMemoryUsage(MemoryManager::AllocationType::Heap);
+            rp3d_test(heapMemoryUsage.usedBytes > 0);
+            rp3d_test(heapMemoryUsage.reservedBytes >= heapMemoryUsage.usedBytes);
+            rp3d_test(heapMemoryUsage.peakUsedBytes >= heapMemoryUsage.usedBytes);
+
+            RigidBody* body = world->createRigidBody(Transform::identity());
+            body->addCollider(mBoxShape, Transform::identity());
+
+            const MemoryUsage poolMemoryUsage = mPhysicsCommon.getMemoryUsage(MemoryManager::AllocationType::Pool);
+            rp3d_test(poolMemoryUsage.usedBytes > 0);
+            rp3d_test(poolMemoryUsage.reservedBytes >= poolMemoryUsage.usedBytes);
+
+            world->update(decimal(1.0) / decimal(60.0));
+
+            // The frame memory is released at the end of the step but its peak remains
+            const MemoryUsage frameMemoryUsage = mPhysicsCommon.getMemoryUsage(MemoryManager::AllocationType::Frame);
+            rp3d_test(frameMemoryUsage.usedBytes == 0);
+            rp3d_test(frameMemoryUsage.peakUsedBytes > 0);
+            rp3d_test(frameMemoryUsage.reservedBytes >= frameMemoryUsage.peakUsedBytes);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        /// Test the memory usage of the parts of a world
+        void testWorldMemoryUsage() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+
+            PhysicsWorld::WorldMemoryUsage initialMemoryUsage = world->getMemoryUsage();
+            rp3d_test(initialMemoryUsage.components.usedBytes == 0);
+            rp3d_test(initialMemoryUsage.components.reservedBytes > 0);
+            rp3d_test(initialMemoryUsage.broadPhase.usedBytes == 0);
+            rp3d_test(initialMemoryUsage.overlappingPairs.usedBytes == 0);
+            rp3d_test(initialMemoryUsage.contacts.usedBytes == 0);
+
+            createFloor(world);
+
+            std::vector<RigidBody*> boxes;
+            for (uint32 i = 0; i < 50; i++) {
+                boxes.push_back(createBox(world, Vector3(decimal(i) * 2 - 50, decimal(0.5), 0)));
+            }
+
+            simulate(world, 10);
+
+            // The boxes are resting on the floor
+            PhysicsWorld::WorldMemoryUsage memoryUsage = world->getMemoryUsage();
+            rp3d_test(memoryUsage.components.usedBytes > 0);
+            rp3d_test(memoryUsage.components.reservedBytes >= memoryUsage.components.usedBytes);
+            rp3d_test(memoryUsage.broadPhase.usedBytes == (2 * 51 - 1) * sizeof(TreeNode));
+            rp3d_test(memoryUsage.broadPhase.reservedBytes >= memoryUsage.broadPhase.usedBytes);
+            rp3d_test(memoryUsage.overlappingPairs.usedBytes > 0);
+            rp3d_test(memoryUsage.contacts.usedBytes > 0);
+            rp3d_test(memoryUsage.contacts.reservedBytes >= memoryUsage.contacts.usedBytes);
+
+            // Destroy the boxes
+            for (uint32 i = 0; i < boxes.size(); i++) {
+                world->destroyRigidBody(boxes[i]);
+            }
+            world->update(decimal(1.0) / decimal(60.0));
+
+            // The used memory decreases but the high-water marks remain
+            PhysicsWorld::WorldMemoryUsage finalMemoryUsage = world->getMemoryUsage();
+            rp3d_test(finalMemoryUsage.components.usedBytes < memoryUsage.components.usedBytes);
+            rp3d_test(finalMemoryUsage.components.peakUsedBytes >= memoryUsage.components.usedBytes);
+            rp3d_test(finalMemoryUsage.broadPhase.usedBytes == sizeof(TreeNode));
+            rp3d_test(finalMemoryUsage.broadPhase.peakUsedBytes == memoryUsage.broadPhase.usedBytes);
+            rp3d_test(finalMemoryUsage.overlappingPairs.usedBytes < memoryUsage.overlappingPairs.usedBytes);
+            rp3d_test(finalMemoryUsage.overlappingPairs.peakUsedBytes >= memoryUsage.overlappingPairs.usedBytes);
+            rp3d_test(finalMemoryUsage.contacts.usedBytes == 0);
+            rp3d_test(finalMemoryUsage.contacts.peakUsedBytes >= memoryUsage.contacts.usedBytes);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        /// Test the memory usage of the BVH of the concave mesh shapes
+        void testConcaveMeshesMemoryUsage() {
+
+            rp3d_test(mPhysicsCommon.getConcaveMeshesMemoryUsage().usedBytes == 0);
+
+            const float vertices[] = {-10, 0, -10, 10, 0, -10, 10, 0, 10, -10, 0, 10};
+            const uint32 indices[] = {0, 1, 2, 0, 2, 3};
+            TriangleVertexArray vertexArray(4, vertices, 3 * sizeof(float), 2, indices, 3 * sizeof(uint32),
+                                            TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                            TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+
+            TriangleMesh* triangleMesh = mPhysicsCommon.createTriangleMesh();
+            triangleMesh->addSubpart(&vertexArray);
+            ConcaveMeshShape* concaveMeshShape = mPhysicsCommon.createConcaveMeshShape(triangleMesh);
+
+            // The BVH of the mesh has one leaf per triangle and a root node
+            const MemoryUsage memoryUsage = mPhysicsCommon.getConcaveMeshesMemoryUsage();
+            rp3d_test(memoryUsage.usedBytes == 3 * sizeof(TreeNode));
+            rp3d_test(memoryUsage.reservedBytes >= memoryUsage.usedBytes);
+            rp3d_test(memoryUsage.peakUsedBytes == memoryUsage.usedBytes);
+
+            mPhysicsCommon.destroyConcaveMeshShape(concaveMeshShape);
+            mPhysicsCommon.destroyTriangleMesh(triangleMesh);
+
+            rp3d_test(mPhysicsCommon.getConcaveMeshesMemoryUsage().usedBytes == 0);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,209 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_STATIC_BODIES_H
+#define TEST_STATIC_BODIES_H
+
+// Libraries
+#include "WorldTestFixture.h"
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+/// Class StaticBodyRaycastCallback
+class StaticBodyRaycastCallback : public RaycastCallback {
+
+    public:
+
+        CollisionBody* hitBody = nullptr;
+
+        virtual decimal notifyRaycastHit(const RaycastInfo& info) override {
+            hitBody = info.body;
+            return info.hitFraction;
+        }
+};
+
+// Class TestStaticBodies
+/**
+ * Unit test for the static, sleeping and unmoved bodies that are skipped by
+ * the per-frame systems of the world
+ */
+class TestStaticBodies : public WorldTestFixture {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsWorld* mWorld;
+
+        RigidBody* mFloorBody;
+
+        // ---------- Methods ---------- //
+
+        /// Return the body hit by a ray cast along the z axis at a given position
+        CollisionBody* raycast(const Vector3& position) {
+
+            StaticBodyRaycastCallback callback;
+            Ray ray(position + Vector3(0, 0, 10), position - Vector3(0, 0, 10));
+            mWorld->raycast(ray, &callback);
+            return callback.hitBody;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestStaticBodies(const std::string& name) : WorldTestFixture(name, 20) {
+
+            mWorld = mPhysicsCommon.createPhysicsWorld();
+            mFloorBody = createFloor(mWorld);
+        }
+
+        /// Destructor
+        virtual ~TestStaticBodies() {
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+        }
+
+        /// Run the tests
+        void run() {
+            testRestingOnStaticBody();
+            testJointWithStaticBody();
+            testMoveStaticBody();
+            testResizeShapeOfStaticBody();
+            testMoveSleepingBody();
+        }
+
+        /// Test that a dynamic body falls and rests on a static body that is never moved
+        void testRestingOnStaticBody() {
+
+            RigidBody* box = createBox(mWorld, Vector3(0, 3, 0));
+
+            simulate(mWorld, 240);
+
+            rp3d_test(approxEqual(box->getTransform().getPosition().y, decimal(0.5), decimal(0.05)));
+            rp3d_test(mFloorBody->getTransform().getPosition() == Vector3(0, decimal(-0.5), 0));
+            rp3d_test(mFloorBody->getLinearVelocity() == Vector3::zero());
+
+            mWorld->destroyRigidBody(box);
+        }
+
+        /// Test a joint between a static body and a dynamic body
+        void testJointWithStaticBody() {
+
+            RigidBody* anchor = createBox(mWorld, Vector3(0, 10, 0));
+            anchor->setType(BodyType::STATIC);
+            RigidBody* box = createBox(mWorld, Vector3(2, 10, 0));
+
+            BallAndSocketJointInfo jointInfo(anchor, box, Vector3(0, 10, 0));
+            Joint* joint = mWorld->createJoint(jointInfo);
+
+            simulate(mWorld, 120);
+
+            // The box swings around the anchor point at a constant distance
+            const decimal distance = (box->getTransform().getPosition() - Vector3(0, 10, 0)).length();
+            rp3d_test(approxEqual(distance, decimal(2.0), decimal(0.1)));
+            rp3d_test(box->getTransform().getPosition().y < decimal(10.0));
+            rp3d_test(anchor->getTransform().getPosition() == Vector3(0, 10, 0));
+
+            // Move the static anchor, the box follows it
+            anchor->setTransform(Transform(Vector3(0, 20, 0), Quaternion::identity()));
+
+            simulate(mWorld, 120);
+
+            const decimal newDistance = (box->getTransform().getPosition() - Vector3(0, 20, 0)).length();
+            rp3d_test(approxEqual(newDistance, decimal(2.0), decimal(0.1)));
+
+            mWorld->destroyJoint(joint);
+            mWorld->destroyRigidBody(anchor);
+            mWorld->destroyRigidBody(box);
+        }
+
+        /// Test that the broad-phase is updated when a static body is moved by the user
+        void testMoveStaticBody() {
+
+            RigidBody* box = createBox(mWorld, Vector3(0, 5, 0));
+            box->setType(BodyType::STATIC);
+
+            simulate(mWorld, 2);
+
+            rp3d_test(raycast(Vector3(0, 5, 0)) == box);
+
+            box->setTransform(Transform(Vector3(10, 5, 0), Quaternion::identity()));
+
+            simulate(mWorld, 2);
+
+            rp3d_test(raycast(Vector3(0, 5, 0)) == nullptr);
+            rp3d_test(raycast(Vector3(10, 5, 0)) == box);
+
+            mWorld->destroyRigidBody(box);
+        }
+
+        /// Test that the broad-phase is updated when the shape of a static body is resized
+        void testResizeShapeOfStaticBody() {
+
+            BoxShape* shape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            RigidBody* body = mWorld->createRigidBody(Transform(Vector3(0, 5, 0), Quaternion::identity()));
+            body->setType(BodyType::STATIC);
+            body->addCollider(shape, Transform::identity());
+
+            simulate(mWorld, 2);
+
+            rp3d_test(raycast(Vector3(2, 5, 0)) == nullptr);
+
+            shape->setHalfExtents(Vector3(3, 3, 3));
+
+            simulate(mWorld, 2);
+
+            rp3d_test(raycast(Vector3(2, 5, 0)) == body);
+
+            mWorld->destroyRigidBody(body);
+            mPhysicsCommon.destroyBoxShape(shape);
+        }
+
+        /// Test that the broad-phase is updated when a sleeping body is moved by the user
+        void testMoveSleepingBody() {
+
+            RigidBody* box = createBox(mWorld, Vector3(0, decimal(0.5), 0));
+
+            simulate(mWorld, 300);
+
+            rp3d_test(box->isSleeping());
+            rp3d_test(raycast(Vector3(0, decimal(0.5), 0)) == box);
+
+            // Moving the body wakes it up
+            box->setTransform(Transform(Vector3(10, decimal(0.5), 0), Quaternion::identity()));
+
+            rp3d_test(!box->isSleeping());
+            rp3d_test(raycast(Vector3(0, decimal(0.5), 0)) == nullptr);
+            rp3d_test(raycast(Vector3(10, decimal(0.5), 0)) == box);
+
+            mWorld->destroyRigidBody(box);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,300 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_STEP_STATS_H
+#define TEST_STEP_STATS_H
+
+// Libraries
+#include "WorldTestFixture.h"
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestStepStats
+/**
+ * Unit test for the statistics of the last step of a physics world
+ */
+class TestStepStats : public WorldTestFixture {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        SphereShape* mSphereShape;
+
+        HeightFieldShape* mHeightFieldShape;
+
+        /// Heights of the height field (not copied by the shape)
+        float mHeights[25];
+
+        // ---------- Methods ---------- //
+
+        /// Create a world with two boxes and a sphere on a floor and a sphere on a height field
+        PhysicsWorld* createWorld() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+
+            createFloor(world);
+
+            createBox(world, Vector3(-3, decimal(0.5), 0));
+            createBox(world, Vector3(3, decimal(0.5), 0));
+            RigidBody* sphere = world->createRigidBody(Transform(Vector3(0, decimal(0.5), 0), Quaternion::identity()));
+            sphere->addCollider(mSphereShape, Transform::identity());
+
+            // The origin of the height field is in the middle of its height range
+            RigidBody* terrain = world->createRigidBody(Transform(Vector3(50, decimal(0.5), 0), Quaternion::identity()));
+            terrain->setType(BodyType::STATIC);
+            terrain->addCollider(mHeightFieldShape, Transform::identity());
+            RigidBody* terrainSphere = world->createRigidBody(Transform(Vector3(50, decimal(0.5), 0), Quaternion::identity()));
+            terrainSphere->addCollider(mSphereShape, Transform::identity());
+
+            return world;
+        }
+
+        /// Create a world with eight spheres falling on a floor
+        PhysicsWorld* createFallingSpheresWorld(const PhysicsWorld::WorldSettings& settings, RigidBody** outBodies) {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+            world->enableSleeping(false);
+
+            createFloor(world);
+
+            for (int i=0; i < 8; i++) {
+                outBodies[i] = world->createRigidBody(Transform(Vector3(decimal(i * 2 - 8), decimal(5.0), 0), Quaternion::identity()));
+                outBodies[i]->addCollider(mSphereShape, Transform::identity());
+            }
+
+            return world;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestStepStats(const std::string& name) : WorldTestFixture(name, 20) {
+
+            for (uint32 i=0; i < 25; i++) {
+                mHeights[i] = 0.0f;
+            }
+            mHeights[0] = 1.0f;
+
+            mSphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+            mHeightFieldShape = mPhysicsCommon.createHeightFieldShape(5, 5, 0, 1, mHeights, HeightFieldShape::HeightDataType::HEIGHT_FLOAT_TYPE);
+        }
+
+        /// Destructor
+        virtual ~TestStepStats() {
+
+            mPhysicsCommon.destroySphereShape(mSphereShape);
+            mPhysicsCommon.destroyHeightFieldShape(mHeightFieldShape);
+        }
+
+        /// Run the tests
+        void run() {
+            testEmptyWorld();
+            testCounters();
+            testSleepingBodies();
+            testTiming();
+            testBroadPhaseTree();
+        }
+
+        /// Test the statistics of a step of an empty world
+        void testEmptyWorld() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+
+            rp3d_test(!world->isStepTimingEnabled());
+            rp3d_test(world->getLastStepStats().nbAwakeBodies == 0);
+
+            simulate(world, 1);
+
+            const PhysicsWorld::StepStats& stats = world->getLastStepStats();
+            rp3d_test(stats.nbConvexPairs == 0);
+            rp3d_test(stats.nbConcavePairs == 0);
+            rp3d_test(stats.nbMiddlePhaseTriangles == 0);
+            rp3d_test(stats.getNbNarrowPhaseTests() == 0);
+            rp3d_test(stats.nbContactPairs == 0);
+            rp3d_test(stats.nbContactManifolds == 0);
+            rp3d_test(stats.nbContactPoints == 0);
+            rp3d_test(stats.nbIslands == 0);
+            rp3d_test(stats.nbAwakeBodies == 0);
+            rp3d_test(stats.nbVelocitySolverIterations == world->getNbIterationsVelocitySolver());
+            rp3d_test(stats.nbPositionSolverIterations == world->getNbIterationsPositionSolver());
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        /// Test the counters of the collision detection, contacts and islands
+        void testCounters() {
+
+            PhysicsWorld* world = createWorld();
+            world->enableSleeping(false);
+
+            simulate(world, 10);
+
+            const PhysicsWorld::StepStats& stats = world->getLastStepStats();
+
+            // Each body on the floor and the sphere on the height field
+            rp3d_test(stats.nbConvexPairs == 3);
+            rp3d_test(stats.nbConcavePairs == 1);
+            rp3d_test(stats.nbMiddlePhaseTriangles > 0);
+            rp3d_test(stats.nbConvexPolyhedronVsConvexPolyhedronTests == 2);
+            rp3d_test(stats.nbSphereVsConvexPolyhedronTests == 1 + stats.nbMiddlePhaseTriangles);
+            rp3d_test(stats.nbSphereVsSphereTests == 0);
+            rp3d_test(stats.nbSphereVsCapsuleTests == 0);
+            rp3d_test(stats.nbCapsuleVsCapsuleTests == 0);
+            rp3d_test(stats.nbCapsuleVsConvexPolyhedronTests == 0);
+            rp3d_test(stats.getNbNarrowPhaseTests() == 3 + stats.nbMiddlePhaseTriangles);
+
+            rp3d_test(stats.nbContactPairs == 4);
+            rp3d_test(stats.nbContactManifolds >= 4);
+            rp3d_test(stats.nbContactPoints >= stats.nbContactManifolds);
+
+            // The bodies only touch static bodies and each of them is in its own island
+            rp3d_test(stats.nbIslands == 4);
+            rp3d_test(stats.nbAwakeBodies == 4);
+
+            rp3d_test(!stats.isTimingEnabled);
+            rp3d_test(stats.totalTime == 0);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        /// Test that the sleeping bodies are not counted as awake
+        void testSleepingBodies() {
+
+            PhysicsWorld* world = createWorld();
+
+            simulate(world, 180);
+
+            const PhysicsWorld::StepStats& stats = world->getLastStepStats();
+            rp3d_test(stats.nbAwakeBodies == 0);
+            rp3d_test(stats.nbIslands == 0);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        /// Test the measurement of the time of the stages of the step
+        void testTiming() {
+
+            PhysicsWorld* world = createWorld();
+            world->setIsStepTimingEnabled(true);
+
+            rp3d_test(world->isStepTimingEnabled());
+
+            simulate(world, 5);
+
+            const PhysicsWorld::StepStats& stats = world->getLastStepStats();
+            rp3d_test(stats.isTimingEnabled);
+            rp3d_test(stats.totalTime > 0);
+            rp3d_test(stats.collisionDetectionTime >= 0);
+            rp3d_test(stats.contactsTime >= 0);
+            rp3d_test(stats.solverTime >= 0);
+            rp3d_test(stats.bodiesUpdateTime >= 0);
+            rp3d_test(stats.sleepingTime >= 0);
+
+            const double stagesTime = stats.collisionDetectionTime + stats.contactsTime + stats.solverTime +
+                                      stats.bodiesUpdateTime + stats.sleepingTime;
+            rp3d_test(stagesTime <= stats.totalTime + 1e-6);
+
+            world->setIsStepTimingEnabled(false);
+            simulate(world, 1);
+            rp3d_test(!world->getLastStepStats().isTimingEnabled);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        /// Test the counters of the broad-phase tree and its automatic rebuild
+        void testBroadPhaseTree() {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.broadPhaseRebuildCostRatio = decimal(0.5);
+            settings.broadPhaseQualityCheckInterval = 3;
+            RigidBody* bodies[8];
+            PhysicsWorld* world = createFallingSpheresWorld(settings, bodies);
+
+            // The falling bodies are updated in the tree at each step
+            simulate(world, 1);
+            const PhysicsWorld::StepStats& stats = world->getLastStepStats();
+            rp3d_test(stats.nbBroadPhaseUpdates == 8);
+            rp3d_test(stats.nbBroadPhaseReinsertions <= stats.nbBroadPhaseUpdates);
+            rp3d_test(!stats.isBroadPhaseTreeRebuilt);
+
+            // The quality is checked every three steps and any tree is worse than the rebuild threshold
+            simulate(world, 1);
+            rp3d_test(!stats.isBroadPhaseTreeRebuilt);
+            simulate(world, 1);
+            rp3d_test(stats.isBroadPhaseTreeRebuilt);
+            simulate(world, 1);
+            rp3d_test(!stats.isBroadPhaseTreeRebuilt);
+
+            // A moved body is reinserted in the tree
+            bodies[0]->setTransform(Transform(Vector3(0, 10, 10), Quaternion::identity()));
+            simulate(world, 1);
+            rp3d_test(stats.nbBroadPhaseUpdates == 9);
+            rp3d_test(stats.nbBroadPhaseReinsertions >= 1);
+
+            DynamicAABBTree::QualityMetrics metrics = world->computeBroadPhaseQualityMetrics();
+            rp3d_test(metrics.nbLeafNodes == 9);
+            rp3d_test(metrics.nbObjectUpdates >= 8 * 5);
+            rp3d_test(metrics.nbReinsertions + metrics.nbFatAABBHits == metrics.nbObjectUpdates);
+
+            // After a rebuild, the cost of the tree is the one of a rebuilt tree
+            world->rebuildBroadPhaseTree();
+            metrics = world->computeBroadPhaseQualityMetrics();
+            rp3d_test(approxEqual(metrics.sahCostRatio, decimal(1.0), decimal(0.0001)));
+
+            // The rebuilds of the tree do not change the simulation
+            RigidBody* referenceBodies[8];
+            PhysicsWorld* referenceWorld = createFallingSpheresWorld(PhysicsWorld::WorldSettings(), referenceBodies);
+            referenceBodies[0]->setTransform(bodies[0]->getTransform());
+            settings.broadPhaseQualityCheckInterval = 1;
+            PhysicsWorld* rebuiltWorld = createFallingSpheresWorld(settings, bodies);
+            bodies[0]->setTransform(referenceBodies[0]->getTransform());
+            uint32 nbContactPairs = 0;
+            for (int step=0; step < 120; step++) {
+
+                simulate(referenceWorld, 1);
+                simulate(rebuiltWorld, 1);
+
+                rp3d_test(rebuiltWorld->getLastStepStats().isBroadPhaseTreeRebuilt);
+                rp3d_test(rebuiltWorld->getLastStepStats().nbContactPairs == referenceWorld->getLastStepStats().nbContactPairs);
+                nbContactPairs += rebuiltWorld->getLastStepStats().nbContactPairs;
+            }
+            rp3d_test(nbContactPairs > 0);
+            for (int i=0; i < 8; i++) {
+                rp3d_test(approxEqual(bodies[i]->getTransform().getPosition(), referenceBodies[i]->getTransform().getPosition(), decimal(0.001)));
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyPhysicsWorld(referenceWorld);
+            mPhysicsCommon.destroyPhysicsWorld(rebuiltWorld);
+        }
+};
+
+}
+
+#endif
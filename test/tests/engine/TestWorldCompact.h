@@ -0,0 +1,211 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+#ifndef TEST_WORLD_COMPACT_H
+#define TEST_WORLD_COMPACT_H
+
+// Libraries
+#include "WorldTestFixture.h"
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class ContactEventsCounter
+/**
+ * Event listener that counts the contact events of each type
+ */
+class ContactEventsCounter : public EventListener {
+
+    public:
+
+        uint32 nbContactStart = 0;
+
+        uint32 nbContactStay = 0;
+
+        uint32 nbContactExit = 0;
+
+        void reset() {
+            nbContactStart = 0;
+            nbContactStay = 0;
+            nbContactExit = 0;
+        }
+
+        virtual void onContact(const CollisionCallback::CallbackData& callbackData) override {
+
+            for (uint32 i=0; i < callbackData.getNbContactPairs(); i++) {
+
+                switch (callbackData.getContactPair(i).getEventType()) {
+                    case CollisionCallback::ContactPair::EventType::ContactStart: nbContactStart++; break;
+                    case CollisionCallback::ContactPair::EventType::ContactStay: nbContactStay++; break;
+                    case CollisionCallback::ContactPair::EventType::ContactExit: nbContactExit++; break;
+                }
+            }
+        }
+};
+
+// Class TestWorldCompact
+/**
+ * Unit test for the PhysicsWorld::compact() method
+ */
+class TestWorldCompact : public WorldTestFixture {
+
+    private :
+
+        // ---------- Methods ---------- //
+
+        /// Return true if the box is resting on the floor
+        bool isOnFloor(RigidBody* box) const {
+            const decimal y = box->getTransform().getPosition().y;
+            return y > decimal(0.4) && y < decimal(0.6);
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestWorldCompact(const std::string& name) : WorldTestFixture(name, 100) {
+
+        }
+
+        /// Run the tests
+        void run() {
+            testCompactAfterDestruction();
+            testCompactEmptyWorld();
+        }
+
+        /// Test that the world still works after the destruction of most of the bodies and a compaction
+        void testCompactAfterDestruction() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            world->enableSleeping(false);
+
+            ContactEventsCounter eventsCounter;
+            world->setEventListener(&eventsCounter);
+
+            RigidBody* floor = createFloor(world);
+
+            // Create boxes resting on the floor
+            Array<RigidBody*> boxes(world->getMemoryManager().getHeapAllocator());
+            for (uint32 x=0; x < 20; x++) {
+                for (uint32 z=0; z < 20; z++) {
+                    const Vector3 position(decimal(x) * 4 - 40, decimal(0.5), decimal(z) * 4 - 40);
+                    boxes.add(createBox(world, position));
+                }
+            }
+
+            // Create a body in compound mode with two colliders resting on the floor
+            RigidBody* compoundBody = world->createRigidBody(Transform(Vector3(50, decimal(0.5), 50), Quaternion::identity()));
+            compoundBody->setIsCompound(true);
+            compoundBody->addCollider(mBoxShape, Transform(Vector3(-1, 0, 0), Quaternion::identity()));
+            compoundBody->addCollider(mBoxShape, Transform(Vector3(1, 0, 0), Quaternion::identity()));
+
+            simulate(world, 10);
+
+            // Destroy most of the boxes (the boxes in the middle of the remaining ones are destroyed
+            // so that the nodes of the remaining boxes are not at the beginning of the broad-phase tree)
+            Array<RigidBody*> remainingBoxes(world->getMemoryManager().getHeapAllocator());
+            for (uint32 i=0; i < boxes.size(); i++) {
+                if (i % 40 == 39) {
+                    remainingBoxes.add(boxes[i]);
+                }
+                else {
+                    world->destroyRigidBody(boxes[i]);
+                }
+            }
+            simulate(world, 1);
+
+            const PhysicsWorld::WorldMemoryUsage memoryUsage = world->getMemoryUsage();
+
+            world->compact();
+
+            // ---------- Tests ---------- //
+
+            const PhysicsWorld::WorldMemoryUsage compactMemoryUsage = world->getMemoryUsage();
+            rp3d_test(compactMemoryUsage.components.reservedBytes < memoryUsage.components.reservedBytes);
+            rp3d_test(compactMemoryUsage.broadPhase.reservedBytes < memoryUsage.broadPhase.reservedBytes);
+            rp3d_test(compactMemoryUsage.overlappingPairs.reservedBytes < memoryUsage.overlappingPairs.reservedBytes);
+            rp3d_test(compactMemoryUsage.contacts.reservedBytes <= memoryUsage.contacts.reservedBytes);
+            rp3d_test(compactMemoryUsage.broadPhase.usedBytes == memoryUsage.broadPhase.usedBytes);
+
+            // The contacts of the previous frame are still matched with the current ones (there
+            // is a contact pair for each collider of the compound body)
+            eventsCounter.reset();
+            simulate(world, 1);
+            rp3d_test(eventsCounter.nbContactStart == 0);
+            rp3d_test(eventsCounter.nbContactStay == remainingBoxes.size() + 2);
+            rp3d_test(eventsCounter.nbContactExit == 0);
+
+            // The remaining bodies are still colliding with the floor
+            simulate(world, 60);
+            bool areOnFloor = true;
+            bool areOverlapping = true;
+            for (uint32 i=0; i < remainingBoxes.size(); i++) {
+                if (!isOnFloor(remainingBoxes[i])) areOnFloor = false;
+                if (!world->testOverlap(remainingBoxes[i], floor)) areOverlapping = false;
+            }
+            rp3d_test(areOnFloor);
+            rp3d_test(areOverlapping);
+            rp3d_test(isOnFloor(compoundBody));
+            rp3d_test(world->testOverlap(compoundBody, floor));
+
+            // New bodies can be added after the compaction
+            RigidBody* newBox = createBox(world, Vector3(0, decimal(3.0), 0));
+            simulate(world, 120);
+            rp3d_test(isOnFloor(newBox));
+
+            // Bodies can be destroyed after the compaction
+            for (uint32 i=0; i < remainingBoxes.size(); i++) {
+                world->destroyRigidBody(remainingBoxes[i]);
+            }
+            simulate(world, 1);
+            rp3d_test(isOnFloor(newBox));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        /// Test the compaction of a world without bodies
+        void testCompactEmptyWorld() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+
+            world->compact();
+
+            RigidBody* box = createBox(world, Vector3::zero());
+            simulate(world, 1);
+
+            world->destroyRigidBody(box);
+            simulate(world, 1);
+
+            world->compact();
+            rp3d_test(world->getMemoryUsage().components.usedBytes == 0);
+            rp3d_test(world->getMemoryUsage().broadPhase.usedBytes == 0);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,149 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+#ifndef TEST_WORLD_RESERVE_H
+#define TEST_WORLD_RESERVE_H
+
+// Libraries
+#include "WorldTestFixture.h"
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestWorldReserve
+/**
+ * Unit test for the capacity hints of the world settings and the
+ * PhysicsWorld::reserve() method
+ */
+class TestWorldReserve : public WorldTestFixture {
+
+    private :
+
+        // ---------- Methods ---------- //
+
+        /// Create a grid of dynamic boxes starting at a given position along the x axis
+        void createBoxes(PhysicsWorld* world, Array<RigidBody*>& boxes, uint32 nbBoxesX, uint32 nbBoxesZ, decimal offsetX) {
+
+            for (uint32 x=0; x < nbBoxesX; x++) {
+                for (uint32 z=0; z < nbBoxesZ; z++) {
+
+                    const Vector3 position(decimal(x) * 2 + offsetX, decimal(2.0), decimal(z) * 2 - 20);
+                    boxes.add(createBox(world, position));
+                }
+            }
+        }
+
+        /// Return true if all the boxes are resting on the floor
+        bool areBoxesResting(const Array<RigidBody*>& boxes) const {
+
+            for (uint32 i=0; i < boxes.size(); i++) {
+                if (!approxEqual(boxes[i]->getTransform().getPosition().y, decimal(0.5), decimal(0.05))) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestWorldReserve(const std::string& name) : WorldTestFixture(name, 50) {
+
+        }
+
+        /// Run the tests
+        void run() {
+            testWorldSettingsCapacity();
+            testReserveWithExistingBodies();
+        }
+
+        /// Test a world created with capacity hints in its settings
+        void testWorldSettingsCapacity() {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.bodiesCapacity = 401;
+            settings.collidersCapacity = 401;
+            settings.jointsCapacity = 16;
+            settings.overlappingPairsCapacity = 1024;
+            settings.contactsCapacity = 4096;
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            rp3d_test(world->getNbRigidBodies() == 0);
+
+            createFloor(world);
+
+            Array<RigidBody*> boxes(world->getMemoryManager().getHeapAllocator());
+            createBoxes(world, boxes, 20, 20, decimal(-20.0));
+
+            rp3d_test(world->getNbRigidBodies() == 401);
+
+            simulate(world, 180);
+
+            rp3d_test(areBoxesResting(boxes));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        /// Test to reserve memory in a world that already contains some bodies
+        void testReserveWithExistingBodies() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+
+            createFloor(world);
+
+            Array<RigidBody*> boxes(world->getMemoryManager().getHeapAllocator());
+            createBoxes(world, boxes, 4, 4, decimal(-20.0));
+
+            simulate(world, 10);
+
+            // Destroy some bodies so that some entities and broad-phase nodes are free
+            for (uint32 i=0; i < 4; i++) {
+                world->destroyRigidBody(boxes[boxes.size() - 1]);
+                boxes.removeAt(boxes.size() - 1);
+            }
+
+            world->reserve(200, 200, 0, 512, 2048);
+
+            // Reserving less memory than already allocated does nothing
+            world->reserve(1, 1, 1, 1, 1);
+
+            createBoxes(world, boxes, 10, 10, decimal(10.0));
+
+            rp3d_test(world->getNbRigidBodies() == 113);
+
+            simulate(world, 240);
+
+            rp3d_test(areBoxesResting(boxes));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+};
+
+}
+
+#endif
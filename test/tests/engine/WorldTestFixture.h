@@ -0,0 +1,103 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_WORLD_TEST_FIXTURE_H
+#define TEST_WORLD_TEST_FIXTURE_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class WorldTestFixture
+/**
+ * Base class of the unit tests of the engine that simulate dynamic boxes on a
+ * static floor. It owns the physics common object and the shapes of the boxes
+ * and of the floor.
+ */
+class WorldTestFixture : public Test {
+
+    protected :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        /// Shape of the dynamic boxes (a cube with a size of one)
+        BoxShape* mBoxShape;
+
+        /// Shape of the floor (its top face is at y = 0)
+        BoxShape* mFloorShape;
+
+        // ---------- Methods ---------- //
+
+        /// Create a static floor in a world
+        RigidBody* createFloor(PhysicsWorld* world) {
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, decimal(-0.5), 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(mFloorShape, Transform::identity());
+            return floor;
+        }
+
+        /// Create a dynamic box at a given position in a world
+        RigidBody* createBox(PhysicsWorld* world, const Vector3& position) {
+
+            RigidBody* body = world->createRigidBody(Transform(position, Quaternion::identity()));
+            body->addCollider(mBoxShape, Transform::identity());
+            return body;
+        }
+
+        /// Take some simulation steps
+        void simulate(PhysicsWorld* world, uint32 nbSteps) {
+            for (uint32 i=0; i < nbSteps; i++) {
+                world->update(decimal(1.0) / decimal(60.0));
+            }
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        WorldTestFixture(const std::string& name, decimal floorHalfSize) : Test(name) {
+
+            mBoxShape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            mFloorShape = mPhysicsCommon.createBoxShape(Vector3(floorHalfSize, decimal(0.5), floorHalfSize));
+        }
+
+        /// Destructor
+        virtual ~WorldTestFixture() {
+
+            mPhysicsCommon.destroyBoxShape(mBoxShape);
+            mPhysicsCommon.destroyBoxShape(mFloorShape);
+        }
+};
+
+}
+
+#endif
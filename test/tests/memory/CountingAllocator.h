@@ -0,0 +1,61 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_COUNTING_ALLOCATOR_H
+#define TEST_COUNTING_ALLOCATOR_H
+
+// Libraries
+#include <reactphysics3d/memory/DefaultAllocator.h>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class CountingAllocator
+/**
+ * Base allocator that keeps track of the memory currently allocated
+ */
+class CountingAllocator : public DefaultAllocator {
+
+    public:
+
+        size_t allocatedMemory = 0;
+        size_t nbAllocations = 0;
+
+        virtual void* allocate(size_t size) override {
+            allocatedMemory += size;
+            nbAllocations++;
+            return DefaultAllocator::allocate(size);
+        }
+
+        virtual void release(void* pointer, size_t size) override {
+            allocatedMemory -= size;
+            nbAllocations--;
+            DefaultAllocator::release(pointer, size);
+        }
+};
+
+}
+
+#endif
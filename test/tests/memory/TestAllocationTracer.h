@@ -0,0 +1,347 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+
+#ifndef TEST_ALLOCATION_TRACER_H
+#define TEST_ALLOCATION_TRACER_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <sstream>
+#include <thread>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestAllocationTracer
+/**
+ * Unit test for the tracing of the allocations of the memory allocators
+ */
+class TestAllocationTracer : public Test {
+
+    private :
+
+        // ---------- Attributes ---------- //
+
+        /// Allocator of the histograms
+        DefaultAllocator mAllocator;
+
+        // ---------- Methods ---------- //
+
+        /// Record some pool allocations
+        static void recordPoolAllocations(uint32 nbAllocations) {
+            for (uint32 i=0; i < nbAllocations; i++) {
+                AllocationTracer::recordAllocation(MemoryManager::AllocationType::Pool, 16);
+            }
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestAllocationTracer(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testSizeClasses();
+            testTags();
+            testRecords();
+            testDump();
+            testThreads();
+
+#ifdef IS_RP3D_ALLOCATION_TRACING_ENABLED
+            testAllocatorsHooks();
+            testWorldFrames();
+#endif
+
+            AllocationTracer::setIsEnabled(false);
+            AllocationTracer::reset();
+        }
+
+        /// Test the size classes of the histograms
+        void testSizeClasses() {
+
+            rp3d_test(AllocationTracer::getSizeClass(1) == 0);
+            rp3d_test(AllocationTracer::getSizeClass(16) == 0);
+            rp3d_test(AllocationTracer::getSizeClass(17) == 1);
+            rp3d_test(AllocationTracer::getSizeClass(1024) == 6);
+            rp3d_test(AllocationTracer::getSizeClass(1025) == 7);
+            rp3d_test(AllocationTracer::getSizeClass(size_t(1) << 40) == AllocationTracer::NB_SIZE_CLASSES - 1);
+        }
+
+        /// Test the nested allocation tag scopes
+        void testTags() {
+
+            rp3d_test(AllocationTracer::getCurrentTag() == nullptr);
+            {
+                AllocationTagScope scope1("Outer");
+                rp3d_test(std::strcmp(AllocationTracer::getCurrentTag(), "Outer") == 0);
+                {
+                    AllocationTagScope scope2("Inner");
+                    rp3d_test(std::strcmp(AllocationTracer::getCurrentTag(), "Inner") == 0);
+                }
+                rp3d_test(std::strcmp(AllocationTracer::getCurrentTag(), "Outer") == 0);
+            }
+            rp3d_test(AllocationTracer::getCurrentTag() == nullptr);
+        }
+
+        /// Test the recorded allocations and the histograms of the frames
+        void testRecords() {
+
+            AllocationTracer::reset();
+
+            // Nothing is recorded when the tracing is disabled
+            AllocationTracer::setIsEnabled(false);
+            AllocationTracer::recordAllocation(MemoryManager::AllocationType::Heap, 64);
+            rp3d_test(AllocationTracer::getNbRecords() == 0);
+
+            AllocationTracer::setIsEnabled(true);
+            rp3d_test(AllocationTracer::isEnabled());
+
+            const uint64 frame = AllocationTracer::getFrameIndex();
+            {
+                AllocationTagScope scope("Test");
+                AllocationTracer::recordAllocation(MemoryManager::AllocationType::Pool, 24);
+                AllocationTracer::recordAllocation(MemoryManager::AllocationType::Heap, 1000);
+            }
+            AllocationTracer::nextFrame();
+            rp3d_test(AllocationTracer::getFrameIndex() == frame + 1);
+            AllocationTracer::recordAllocation(MemoryManager::AllocationType::Frame, 100000);
+
+            AllocationTracer::setIsEnabled(false);
+
+            rp3d_test(AllocationTracer::getNbRecords() == 3);
+            Array<AllocationTracer::AllocationRecord> records(mAllocator);
+            AllocationTracer::getRecords(records);
+            rp3d_test(records.size() == 3);
+            rp3d_test(records[0].frameIndex == frame);
+            rp3d_test(records[0].size == 24);
+            rp3d_test(records[0].allocationType == MemoryManager::AllocationType::Pool);
+            rp3d_test(std::strcmp(records[0].tag, "Test") == 0);
+            rp3d_test(records[2].frameIndex == frame + 1);
+            rp3d_test(records[2].tag == nullptr);
+
+            AllocationTracer::FrameHistogram histogram(mAllocator);
+            AllocationTracer::computeFrameHistogram(frame, histogram);
+            rp3d_test(histogram.frameIndex == frame);
+            rp3d_test(histogram.nbAllocations == 2);
+            rp3d_test(histogram.nbAllocatedBytes == 1024);
+            rp3d_test(histogram.getNbAllocations(MemoryManager::AllocationType::Pool) == 1);
+            rp3d_test(histogram.getNbAllocations(MemoryManager::AllocationType::Heap) == 1);
+            rp3d_test(histogram.getNbAllocations(MemoryManager::AllocationType::Frame) == 0);
+            rp3d_test(histogram.nbAllocatedBytesPerType[static_cast<uint32>(MemoryManager::AllocationType::Heap)] == 1000);
+            rp3d_test(histogram.nbAllocationsPerSizeClass[AllocationTracer::getSizeClass(24)] == 1);
+            rp3d_test(histogram.nbAllocationsPerSizeClass[AllocationTracer::getSizeClass(1000)] == 1);
+            rp3d_test(histogram.tags.size() == 1);
+            rp3d_test(histogram.getTag("Test") != nullptr);
+            rp3d_test(histogram.getTag("Test")->nbAllocations == 2);
+            rp3d_test(histogram.getTag("Test")->nbAllocatedBytes == 1024);
+            rp3d_test(histogram.getTag(nullptr) == nullptr);
+
+            AllocationTracer::computeFrameHistogram(frame + 1, histogram);
+            rp3d_test(histogram.nbAllocations == 1);
+            rp3d_test(histogram.getNbAllocations(MemoryManager::AllocationType::Frame) == 1);
+            rp3d_test(histogram.getTag(nullptr) != nullptr);
+            rp3d_test(histogram.getTag("Test") == nullptr);
+
+            AllocationTracer::computeFrameHistogram(frame + 2, histogram);
+            rp3d_test(histogram.nbAllocations == 0);
+
+            // The allocations are dropped when the maximum number of records is reached
+            AllocationTracer::setIsEnabled(true);
+            AllocationTracer::setMaxNbRecords(4);
+            recordPoolAllocations(3);
+            AllocationTracer::setIsEnabled(false);
+            rp3d_test(AllocationTracer::getNbRecords() == 4);
+            rp3d_test(AllocationTracer::getNbDroppedRecords() == 2);
+            AllocationTracer::setMaxNbRecords(AllocationTracer::DEFAULT_MAX_NB_RECORDS);
+
+            AllocationTracer::reset();
+            rp3d_test(AllocationTracer::getNbRecords() == 0);
+            rp3d_test(AllocationTracer::getNbDroppedRecords() == 0);
+        }
+
+        /// Test the dump of the histograms of the frames
+        void testDump() {
+
+            AllocationTracer::reset();
+            AllocationTracer::setIsEnabled(true);
+
+            const uint64 frame = AllocationTracer::getFrameIndex();
+            {
+                AllocationTagScope scope("Dump");
+                AllocationTracer::recordAllocation(MemoryManager::AllocationType::Heap, 48);
+            }
+            AllocationTracer::nextFrame();
+            AllocationTracer::nextFrame();
+            AllocationTracer::recordAllocation(MemoryManager::AllocationType::Pool, 8);
+
+            AllocationTracer::setIsEnabled(false);
+
+            std::stringstream stream;
+            AllocationTracer::dumpFrameHistograms(stream);
+            const std::string dump = stream.str();
+
+            std::stringstream expectedFirstFrame;
+            expectedFirstFrame << "Frame " << frame << ": 1 allocations, 48 bytes";
+            std::stringstream expectedLastFrame;
+            expectedLastFrame << "Frame " << (frame + 2) << ": 1 allocations, 8 bytes";
+            std::stringstream skippedFrame;
+            skippedFrame << "Frame " << (frame + 1) << ":";
+
+            rp3d_test(dump.find(expectedFirstFrame.str()) != std::string::npos);
+            rp3d_test(dump.find(expectedLastFrame.str()) != std::string::npos);
+            rp3d_test(dump.find(skippedFrame.str()) == std::string::npos);
+            rp3d_test(dump.find("Heap: 1 allocations, 48 bytes") != std::string::npos);
+            rp3d_test(dump.find("Tag Dump: 1 allocations, 48 bytes") != std::string::npos);
+            rp3d_test(dump.find("Tag (none): 1 allocations, 8 bytes") != std::string::npos);
+            rp3d_test(dump.find("<=64: 1") != std::string::npos);
+
+            // Dump of a range of frames
+            std::stringstream rangeStream;
+            AllocationTracer::dumpFrameHistograms(rangeStream, frame + 1, frame + 2);
+            rp3d_test(rangeStream.str().find(expectedFirstFrame.str()) == std::string::npos);
+            rp3d_test(rangeStream.str().find(expectedLastFrame.str()) != std::string::npos);
+
+            AllocationTracer::reset();
+        }
+
+        /// Test the allocations recorded by several threads
+        void testThreads() {
+
+            AllocationTracer::reset();
+            AllocationTracer::setIsEnabled(true);
+
+            std::thread thread1(recordPoolAllocations, 1000);
+            std::thread thread2(recordPoolAllocations, 1000);
+            thread1.join();
+            thread2.join();
+
+            AllocationTracer::setIsEnabled(false);
+
+            rp3d_test(AllocationTracer::getNbRecords() == 2000);
+
+            AllocationTracer::reset();
+        }
+
+#ifdef IS_RP3D_ALLOCATION_TRACING_ENABLED
+
+        /// Test the allocations recorded by the allocators of a memory manager
+        void testAllocatorsHooks() {
+
+            MemoryManager memoryManager(nullptr);
+
+            AllocationTracer::reset();
+            AllocationTracer::setIsEnabled(true);
+
+            void* poolMemory;
+            void* heapMemory;
+            {
+                RP3D_ALLOCATION_TAG("Hooks");
+                poolMemory = memoryManager.allocate(MemoryManager::AllocationType::Pool, 32);
+                heapMemory = memoryManager.allocate(MemoryManager::AllocationType::Heap, 300);
+                memoryManager.allocate(MemoryManager::AllocationType::Frame, 16);
+            }
+
+            AllocationTracer::setIsEnabled(false);
+
+            AllocationTracer::FrameHistogram histogram(mAllocator);
+            AllocationTracer::computeFrameHistogram(AllocationTracer::getFrameIndex(), histogram);
+            rp3d_test(histogram.getNbAllocations(MemoryManager::AllocationType::Pool) == 1);
+            rp3d_test(histogram.getNbAllocations(MemoryManager::AllocationType::Frame) == 1);
+
+            // The blocks of the pool allocator also come from the heap allocator
+            rp3d_test(histogram.getNbAllocations(MemoryManager::AllocationType::Heap) >= 1);
+            rp3d_test(histogram.getTag("Hooks") != nullptr);
+            rp3d_test(histogram.getTag("Hooks")->nbAllocations == histogram.nbAllocations);
+
+            memoryManager.release(MemoryManager::AllocationType::Pool, poolMemory, 32);
+            memoryManager.release(MemoryManager::AllocationType::Heap, heapMemory, 300);
+            memoryManager.resetFrameAllocator();
+
+            AllocationTracer::reset();
+        }
+
+        /// Test the frames and tags of the allocations recorded during the steps of a world
+        void testWorldFrames() {
+
+            PhysicsCommon physicsCommon;
+            PhysicsWorld* world = physicsCommon.createPhysicsWorld();
+
+            BoxShape* boxShape = physicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            BoxShape* floorShape = physicsCommon.createBoxShape(Vector3(10, decimal(0.5), 10));
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, decimal(-0.5), 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(floorShape, Transform::identity());
+            for (int i=0; i < 5; i++) {
+                RigidBody* box = world->createRigidBody(Transform(Vector3(i * 2 - 4, decimal(0.5), 0), Quaternion::identity()));
+                box->addCollider(boxShape, Transform::identity());
+            }
+
+            AllocationTracer::reset();
+            AllocationTracer::setIsEnabled(true);
+
+            const uint64 firstFrame = AllocationTracer::getFrameIndex() + 1;
+            for (int i=0; i < 10; i++) {
+                world->update(decimal(1.0) / decimal(60.0));
+            }
+            const uint64 lastFrame = AllocationTracer::getFrameIndex();
+
+            AllocationTracer::setIsEnabled(false);
+
+            // Each step is a new frame
+            rp3d_test(lastFrame == firstFrame + 9);
+
+            // The frame allocator is used at each step and the allocations are tagged with the stages
+            AllocationTracer::FrameHistogram histogram(mAllocator);
+            AllocationTracer::computeFrameHistogram(lastFrame, histogram);
+            rp3d_test(histogram.getNbAllocations(MemoryManager::AllocationType::Frame) > 0);
+            uint64 nbTaggedAllocations = 0;
+            for (uint64 i=0; i < histogram.tags.size(); i++) {
+                if (histogram.tags[i].tag != nullptr) {
+                    nbTaggedAllocations += histogram.tags[i].nbAllocations;
+                }
+            }
+            rp3d_test(nbTaggedAllocations > 0);
+
+            AllocationTracer::reset();
+
+            physicsCommon.destroyPhysicsWorld(world);
+            physicsCommon.destroyBoxShape(boxShape);
+            physicsCommon.destroyBoxShape(floorShape);
+        }
+
+#endif
+
+ };
+
+}
+
+#endif
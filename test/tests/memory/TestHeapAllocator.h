@@ -0,0 +1,333 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_HEAP_ALLOCATOR_H
+#define TEST_HEAP_ALLOCATOR_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/memory/HeapAllocator.h>
+#include <reactphysics3d/memory/TLSFHeapAllocator.h>
+#include "CountingAllocator.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestHeapAllocator
+/**
+ * Unit test for the heap allocators
+ */
+class TestHeapAllocator : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        /// State of the pseudo-random generator
+        uint32 mRandomState;
+
+        // ---------- Methods ---------- //
+
+        /// Return a deterministic pseudo-random number
+        uint32 random() {
+            mRandomState = mRandomState * 1664525u + 1013904223u;
+            return mRandomState >> 8;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestHeapAllocator(const std::string& name) : Test(name), mRandomState(12345) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testSmallAllocations();
+            testRandomAllocations();
+            testMergeFreeBlocks();
+            testLargeAllocations();
+            testAlignedAllocations();
+            testMemoryUsage();
+        }
+
+        void testSmallAllocations() {
+
+            CountingAllocator baseAllocator;
+
+            {
+                TLSFHeapAllocator allocator(baseAllocator);
+
+                // No memory is reserved before the first allocation
+                rp3d_test(baseAllocator.allocatedMemory == 0);
+
+                void* p1 = allocator.allocate(1);
+                void* p2 = allocator.allocate(7);
+                void* p3 = allocator.allocate(16);
+                void* p4 = allocator.allocate(33);
+
+                rp3d_test(p1 != nullptr && p2 != nullptr && p3 != nullptr && p4 != nullptr);
+                rp3d_test(reinterpret_cast<std::uintptr_t>(p1) % 16 == 0);
+                rp3d_test(reinterpret_cast<std::uintptr_t>(p2) % 16 == 0);
+                rp3d_test(reinterpret_cast<std::uintptr_t>(p3) % 16 == 0);
+                rp3d_test(reinterpret_cast<std::uintptr_t>(p4) % 16 == 0);
+                rp3d_test(baseAllocator.nbAllocations == 1);
+                rp3d_test(allocator.getAllocatedMemory() == baseAllocator.allocatedMemory);
+
+                allocator.release(p1, 1);
+                allocator.release(p2, 7);
+                allocator.release(p3, 16);
+                allocator.release(p4, 33);
+            }
+
+            // All the memory has been given back to the base allocator
+            rp3d_test(baseAllocator.allocatedMemory == 0);
+            rp3d_test(baseAllocator.nbAllocations == 0);
+        }
+
+        void testRandomAllocations() {
+
+            CountingAllocator baseAllocator;
+
+            {
+                TLSFHeapAllocator tlsfAllocator(baseAllocator, 4096);
+                HeapAllocator firstFitAllocator(baseAllocator, 4096);
+
+                testRandomAllocations(tlsfAllocator);
+                testRandomAllocations(firstFitAllocator);
+            }
+
+            rp3d_test(baseAllocator.allocatedMemory == 0);
+        }
+
+        void testRandomAllocations(MemoryAllocator& allocator) {
+
+            const uint32 nbBlocks = 2000;
+            std::vector<unsigned char*> pointers(nbBlocks, nullptr);
+            std::vector<size_t> sizes(nbBlocks, 0);
+
+            bool isDataValid = true;
+
+            for (uint32 i = 0; i < 20000; i++) {
+
+                const uint32 index = random() % nbBlocks;
+
+                if (pointers[index] == nullptr) {
+
+                    // Mostly small blocks with a few larger ones
+                    const size_t size = (random() % 8 == 0) ? 1 + random() % 20000 : 1 + random() % 256;
+                    pointers[index] = static_cast<unsigned char*>(allocator.allocate(size));
+                    sizes[index] = size;
+
+                    // Fill the block with a pattern that identifies it
+                    for (size_t j = 0; j < size; j++) {
+                        pointers[index][j] = static_cast<unsigned char>(index + j);
+                    }
+                }
+                else {
+
+                    // Check that the block has not been overwritten by another block
+                    for (size_t j = 0; j < sizes[index]; j++) {
+                        if (pointers[index][j] != static_cast<unsigned char>(index + j)) {
+                            isDataValid = false;
+                        }
+                    }
+
+                    allocator.release(pointers[index], sizes[index]);
+                    pointers[index] = nullptr;
+                }
+            }
+
+            rp3d_test(isDataValid);
+
+            for (uint32 i = 0; i < nbBlocks; i++) {
+                if (pointers[i] != nullptr) {
+                    allocator.release(pointers[i], sizes[i]);
+                }
+            }
+        }
+
+        void testMergeFreeBlocks() {
+
+            CountingAllocator baseAllocator;
+
+            {
+                TLSFHeapAllocator allocator(baseAllocator, 65536);
+
+                // Fill the first chunk with small blocks
+                std::vector<void*> pointers;
+                for (uint32 i = 0; i < 512; i++) {
+                    pointers.push_back(allocator.allocate(64));
+                }
+                const size_t nbChunks = baseAllocator.nbAllocations;
+
+                // Release every block in a different order than the allocation order
+                for (uint32 i = 0; i < 512; i += 2) {
+                    allocator.release(pointers[i], 64);
+                }
+                for (uint32 i = 1; i < 512; i += 2) {
+                    allocator.release(pointers[i], 64);
+                }
+
+                // The freed blocks must have been merged back so that a large block
+                // can be allocated without reserving more memory
+                void* largeBlock = allocator.allocate(16384);
+                rp3d_test(baseAllocator.nbAllocations == nbChunks);
+                allocator.release(largeBlock, 16384);
+            }
+
+            rp3d_test(baseAllocator.allocatedMemory == 0);
+        }
+
+        void testLargeAllocations() {
+
+            CountingAllocator baseAllocator;
+
+            {
+                TLSFHeapAllocator allocator(baseAllocator, 1024);
+
+                // Allocations larger than the first chunk need a new chunk
+                void* p1 = allocator.allocate(100000);
+                void* p2 = allocator.allocate(3000000);
+                rp3d_test(p1 != nullptr && p2 != nullptr);
+                static_cast<unsigned char*>(p2)[2999999] = 1;
+
+                allocator.release(p1, 100000);
+                allocator.release(p2, 3000000);
+
+                // Released memory is reused
+                const size_t allocatedMemory = baseAllocator.allocatedMemory;
+                void* p3 = allocator.allocate(2000000);
+                rp3d_test(baseAllocator.allocatedMemory == allocatedMemory);
+                allocator.release(p3, 2000000);
+            }
+
+            rp3d_test(baseAllocator.allocatedMemory == 0);
+            rp3d_test(baseAllocator.nbAllocations == 0);
+        }
+
+        void testAlignedAllocations() {
+
+            CountingAllocator baseAllocator;
+
+            {
+                TLSFHeapAllocator tlsfAllocator(baseAllocator);
+                HeapAllocator firstFitAllocator(baseAllocator);
+
+                rp3d_test(testAlignedAllocations(baseAllocator));
+                rp3d_test(testAlignedAllocations(tlsfAllocator));
+                rp3d_test(testAlignedAllocations(firstFitAllocator));
+            }
+
+            rp3d_test(baseAllocator.allocatedMemory == 0);
+            rp3d_test(baseAllocator.nbAllocations == 0);
+        }
+
+        /// Return true if the allocator returns memory with the requested alignment
+        bool testAlignedAllocations(MemoryAllocator& allocator) {
+
+            bool isAligned = true;
+            const size_t sizes[] = {1, 13, 64, 100, 4000};
+            const size_t alignments[] = {8, 16, 32, 64, 128};
+
+            std::vector<void*> pointers;
+            for (size_t i = 0; i < 5; i++) {
+                for (size_t j = 0; j < 5; j++) {
+                    unsigned char* pointer = static_cast<unsigned char*>(allocator.allocate(sizes[i], alignments[j]));
+                    if (reinterpret_cast<std::uintptr_t>(pointer) % alignments[j] != 0) {
+                        isAligned = false;
+                    }
+                    std::memset(pointer, 0xAB, sizes[i]);
+                    pointers.push_back(pointer);
+                }
+            }
+
+            for (size_t i = 0; i < 5; i++) {
+                for (size_t j = 0; j < 5; j++) {
+                    allocator.release(pointers[i * 5 + j], sizes[i], alignments[j]);
+                }
+            }
+
+            return isAligned;
+        }
+
+        void testMemoryUsage() {
+
+            CountingAllocator baseAllocator;
+
+            {
+                TLSFHeapAllocator tlsfAllocator(baseAllocator, 4096);
+                HeapAllocator firstFitAllocator(baseAllocator, 4096);
+
+                testMemoryUsage(tlsfAllocator);
+                testMemoryUsage(firstFitAllocator);
+            }
+
+            rp3d_test(baseAllocator.allocatedMemory == 0);
+        }
+
+        /// Test the memory usage reported by a heap allocator
+        void testMemoryUsage(MemoryAllocator& allocator) {
+
+            rp3d_test(allocator.getMemoryUsage().reservedBytes == 0);
+            rp3d_test(allocator.getMemoryUsage().usedBytes == 0);
+
+            void* p1 = allocator.allocate(1000);
+            void* p2 = allocator.allocate(16000);
+            void* p3 = allocator.allocate(64);
+
+            MemoryUsage memoryUsage = allocator.getMemoryUsage();
+            rp3d_test(memoryUsage.usedBytes >= 1000 + 16000 + 64);
+            rp3d_test(memoryUsage.reservedBytes >= memoryUsage.usedBytes);
+            rp3d_test(memoryUsage.peakUsedBytes == memoryUsage.usedBytes);
+
+            const size_t peakUsedBytes = memoryUsage.usedBytes;
+
+            allocator.release(p2, 16000);
+
+            memoryUsage = allocator.getMemoryUsage();
+            rp3d_test(memoryUsage.usedBytes >= 1000 + 64);
+            rp3d_test(memoryUsage.usedBytes < 16000);
+            rp3d_test(memoryUsage.peakUsedBytes == peakUsedBytes);
+
+            allocator.release(p1, 1000);
+            allocator.release(p3, 64);
+
+            memoryUsage = allocator.getMemoryUsage();
+            rp3d_test(memoryUsage.usedBytes == 0);
+            rp3d_test(memoryUsage.reservedBytes >= 16000);
+            rp3d_test(memoryUsage.peakUsedBytes == peakUsedBytes);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,239 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_POOL_ALLOCATOR_H
+#define TEST_POOL_ALLOCATOR_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/memory/PoolAllocator.h>
+#include <reactphysics3d/memory/TLSFHeapAllocator.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestPoolAllocator
+/**
+ * Unit test for the PoolAllocator class
+ */
+class TestPoolAllocator : public Test {
+
+    private :
+
+        // ---------- Methods ---------- //
+
+        /// Allocate and release memory units of different sizes and check that they are not shared
+        static void allocateAndRelease(PoolAllocator& allocator, uint32 seed, bool& isDataValid) {
+
+            const uint32 nbUnits = 3000;
+            std::vector<unsigned char*> units(nbUnits, nullptr);
+            std::vector<size_t> sizes(nbUnits, 0);
+            uint32 random = seed;
+
+            isDataValid = true;
+
+            for (uint32 i = 0; i < 30000; i++) {
+
+                random = random * 1664525u + 1013904223u;
+                const uint32 index = (random >> 8) % nbUnits;
+
+                if (units[index] == nullptr) {
+                    sizes[index] = 1 + (random >> 4) % 1024;
+                    units[index] = static_cast<unsigned char*>(allocator.allocate(sizes[index]));
+                    for (size_t j = 0; j < sizes[index]; j++) {
+                        units[index][j] = static_cast<unsigned char>(seed + index);
+                    }
+                }
+                else {
+                    for (size_t j = 0; j < sizes[index]; j++) {
+                        if (units[index][j] != static_cast<unsigned char>(seed + index)) {
+                            isDataValid = false;
+                        }
+                    }
+                    allocator.release(units[index], sizes[index]);
+                    units[index] = nullptr;
+                }
+            }
+
+            for (uint32 i = 0; i < nbUnits; i++) {
+                if (units[i] != nullptr) {
+                    allocator.release(units[i], sizes[i]);
+                }
+            }
+        }
+
+        /// Allocate memory units that will be released by another thread
+        static void allocateUnits(PoolAllocator& allocator, std::vector<void*>& units, size_t size) {
+            for (size_t i = 0; i < units.size(); i++) {
+                units[i] = allocator.allocate(size);
+            }
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestPoolAllocator(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testSingleThread();
+            testMultipleThreads();
+            testReleaseFromAnotherThread();
+            testAlignedAllocations();
+            testMemoryUsage();
+        }
+
+        void testSingleThread() {
+
+            DefaultAllocator baseAllocator;
+            PoolAllocator allocator(baseAllocator);
+
+            bool isDataValid;
+            allocateAndRelease(allocator, 1, isDataValid);
+            rp3d_test(isDataValid);
+        }
+
+        void testMultipleThreads() {
+
+            DefaultAllocator defaultAllocator;
+            TLSFHeapAllocator baseAllocator(defaultAllocator);
+
+            {
+                PoolAllocator allocator(baseAllocator);
+
+                const uint32 nbThreads = 4;
+                bool isDataValid[nbThreads];
+                std::vector<std::thread> threads;
+                for (uint32 i = 0; i < nbThreads; i++) {
+                    threads.push_back(std::thread(allocateAndRelease, std::ref(allocator), i + 1, std::ref(isDataValid[i])));
+                }
+                for (uint32 i = 0; i < nbThreads; i++) {
+                    threads[i].join();
+                }
+
+                for (uint32 i = 0; i < nbThreads; i++) {
+                    rp3d_test(isDataValid[i]);
+                }
+            }
+        }
+
+        void testReleaseFromAnotherThread() {
+
+            DefaultAllocator baseAllocator;
+            PoolAllocator allocator(baseAllocator);
+
+            // Allocate memory units in another thread and release them in this thread
+            std::vector<void*> units(1000, nullptr);
+            std::thread thread(allocateUnits, std::ref(allocator), std::ref(units), 48);
+            thread.join();
+
+            bool areUnitsAllocated = true;
+            for (size_t i = 0; i < units.size(); i++) {
+                if (units[i] == nullptr) areUnitsAllocated = false;
+            }
+            rp3d_test(areUnitsAllocated);
+
+            for (size_t i = 0; i < units.size(); i++) {
+                allocator.release(units[i], 48);
+            }
+
+            // The memory released by this thread compensates the memory allocated by the other thread
+            rp3d_test(allocator.getMemoryUsage().usedBytes == 0);
+            // The largest used memory is sampled when the caches are refilled
+            rp3d_test(allocator.getMemoryUsage().peakUsedBytes > 0);
+            rp3d_test(allocator.getMemoryUsage().peakUsedBytes <= 1000 * 48);
+
+            // The released units are reused by this thread
+            void* unit = allocator.allocate(48);
+            bool isUnitReused = false;
+            for (size_t i = 0; i < units.size(); i++) {
+                if (units[i] == unit) isUnitReused = true;
+            }
+            rp3d_test(isUnitReused);
+            allocator.release(unit, 48);
+        }
+
+        void testAlignedAllocations() {
+
+            DefaultAllocator baseAllocator;
+            PoolAllocator allocator(baseAllocator);
+
+            void* p1 = allocator.allocate(24, 64);
+            void* p2 = allocator.allocate(3000, 64);
+            rp3d_test(reinterpret_cast<std::uintptr_t>(p1) % 64 == 0);
+            rp3d_test(reinterpret_cast<std::uintptr_t>(p2) % 64 == 0);
+
+            allocator.release(p1, 24, 64);
+            allocator.release(p2, 3000, 64);
+        }
+
+        void testMemoryUsage() {
+
+            DefaultAllocator baseAllocator;
+            PoolAllocator allocator(baseAllocator);
+
+            rp3d_test(allocator.getMemoryUsage().reservedBytes == 0);
+            rp3d_test(allocator.getMemoryUsage().usedBytes == 0);
+
+            std::vector<void*> units;
+            for (uint32 i = 0; i < 100; i++) {
+                units.push_back(allocator.allocate(48));
+            }
+            void* largeMemory = allocator.allocate(3000);
+
+            MemoryUsage memoryUsage = allocator.getMemoryUsage();
+            rp3d_test(memoryUsage.usedBytes == 100 * 48 + 3000);
+            rp3d_test(memoryUsage.reservedBytes >= memoryUsage.usedBytes);
+            rp3d_test(memoryUsage.peakUsedBytes == memoryUsage.usedBytes);
+
+            for (uint32 i = 0; i < 100; i++) {
+                allocator.release(units[i], 48);
+            }
+
+            memoryUsage = allocator.getMemoryUsage();
+            rp3d_test(memoryUsage.usedBytes == 3000);
+            rp3d_test(memoryUsage.peakUsedBytes == 100 * 48 + 3000);
+
+            allocator.release(largeMemory, 3000);
+
+            memoryUsage = allocator.getMemoryUsage();
+            rp3d_test(memoryUsage.usedBytes == 0);
+            rp3d_test(memoryUsage.reservedBytes > 0);
+            rp3d_test(memoryUsage.peakUsedBytes == 100 * 48 + 3000);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,201 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_SINGLE_FRAME_ALLOCATOR_H
+#define TEST_SINGLE_FRAME_ALLOCATOR_H
+
+// Libraries
+#include "Test.h"
+#include "CountingAllocator.h"
+#include <reactphysics3d/memory/SingleFrameAllocator.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestSingleFrameAllocator
+/**
+ * Unit test for the SingleFrameAllocator class
+ */
+class TestSingleFrameAllocator : public Test {
+
+    private :
+
+        // ---------- Methods ---------- //
+
+        /// Allocate blocks of memory, fill them and check that they have not been overwritten
+        static void fillBlocks(SingleFrameAllocator& allocator, unsigned char value, uint32 nbBlocks, size_t blockSize, bool& isDataValid) {
+
+            std::vector<unsigned char*> blocks;
+            for (uint32 i = 0; i < nbBlocks; i++) {
+                unsigned char* block = static_cast<unsigned char*>(allocator.allocate(blockSize));
+                for (size_t j = 0; j < blockSize; j++) {
+                    block[j] = value;
+                }
+                blocks.push_back(block);
+            }
+
+            isDataValid = true;
+            for (uint32 i = 0; i < nbBlocks; i++) {
+                for (size_t j = 0; j < blockSize; j++) {
+                    if (blocks[i][j] != value) {
+                        isDataValid = false;
+                    }
+                }
+            }
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestSingleFrameAllocator(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testAlignment();
+            testOverflowAndReset();
+            testMultipleThreads();
+            testMemoryUsage();
+        }
+
+        void testAlignment() {
+
+            DefaultAllocator baseAllocator;
+            SingleFrameAllocator allocator(baseAllocator);
+
+            void* p1 = allocator.allocate(1);
+            void* p2 = allocator.allocate(3);
+            void* p3 = allocator.allocate(17);
+
+            rp3d_test(reinterpret_cast<std::uintptr_t>(p1) % 16 == 0);
+            rp3d_test(reinterpret_cast<std::uintptr_t>(p2) % 16 == 0);
+            rp3d_test(reinterpret_cast<std::uintptr_t>(p3) % 16 == 0);
+            rp3d_test(static_cast<char*>(p2) >= static_cast<char*>(p1) + 1);
+            rp3d_test(static_cast<char*>(p3) >= static_cast<char*>(p2) + 3);
+
+            void* p4 = allocator.allocate(5, 64);
+            void* p5 = allocator.allocate(2000000, 128);
+            rp3d_test(reinterpret_cast<std::uintptr_t>(p4) % 64 == 0);
+            rp3d_test(reinterpret_cast<std::uintptr_t>(p5) % 128 == 0);
+            rp3d_test(static_cast<char*>(p4) >= static_cast<char*>(p3) + 17);
+
+            allocator.reset();
+        }
+
+        void testOverflowAndReset() {
+
+            CountingAllocator baseAllocator;
+
+            {
+                SingleFrameAllocator allocator(baseAllocator);
+
+                // Allocation of the arenas of the threads
+                const size_t nbArenasAllocations = baseAllocator.nbAllocations;
+
+                // Allocate more memory than the initial buffer during a frame
+                bool isDataValid;
+                fillBlocks(allocator, 7, 3000, 1024, isDataValid);
+                rp3d_test(isDataValid);
+                rp3d_test(baseAllocator.nbAllocations > nbArenasAllocations + 1);
+
+                // The chunks are released and the buffer grows to fit the whole frame
+                allocator.reset();
+                rp3d_test(baseAllocator.nbAllocations == nbArenasAllocations + 1);
+
+                // The same frame does not need any more memory
+                fillBlocks(allocator, 9, 3000, 1024, isDataValid);
+                rp3d_test(isDataValid);
+                rp3d_test(baseAllocator.nbAllocations == nbArenasAllocations + 1);
+
+                allocator.reset();
+            }
+
+            rp3d_test(baseAllocator.allocatedMemory == 0);
+            rp3d_test(baseAllocator.nbAllocations == 0);
+        }
+
+        void testMultipleThreads() {
+
+            DefaultAllocator baseAllocator;
+            SingleFrameAllocator allocator(baseAllocator);
+
+            const uint32 nbThreads = 4;
+
+            for (uint32 frame = 0; frame < 3; frame++) {
+
+                bool isDataValid[nbThreads];
+                std::vector<std::thread> threads;
+                for (uint32 i = 0; i < nbThreads; i++) {
+                    threads.push_back(std::thread(fillBlocks, std::ref(allocator), static_cast<unsigned char>(i + 1), 4000, 512, std::ref(isDataValid[i])));
+                }
+                for (uint32 i = 0; i < nbThreads; i++) {
+                    threads[i].join();
+                }
+
+                for (uint32 i = 0; i < nbThreads; i++) {
+                    rp3d_test(isDataValid[i]);
+                }
+
+                allocator.reset();
+            }
+        }
+
+        void testMemoryUsage() {
+
+            DefaultAllocator baseAllocator;
+            SingleFrameAllocator allocator(baseAllocator);
+
+            rp3d_test(allocator.getMemoryUsage().reservedBytes == 0);
+
+            for (uint32 i = 0; i < 100; i++) {
+                allocator.allocate(1000);
+            }
+
+            // The sizes are rounded up to the alignment of the allocator
+            MemoryUsage memoryUsage = allocator.getMemoryUsage();
+            rp3d_test(memoryUsage.usedBytes == 100 * 1008);
+            rp3d_test(memoryUsage.reservedBytes >= memoryUsage.usedBytes);
+            rp3d_test(memoryUsage.peakUsedBytes == memoryUsage.usedBytes);
+
+            allocator.reset();
+
+            allocator.allocate(2000);
+
+            memoryUsage = allocator.getMemoryUsage();
+            rp3d_test(memoryUsage.usedBytes == 2000);
+            rp3d_test(memoryUsage.peakUsedBytes == 100 * 1008);
+        }
+};
+
+}
+
+#endif
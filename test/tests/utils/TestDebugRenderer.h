@@ -0,0 +1,336 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+
+#ifndef TEST_DEBUG_RENDERER_H
+#define TEST_DEBUG_RENDERER_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestDebugRenderer
+/**
+ * Unit test for the view filter, the cached tessellations and the output buffers of the DebugRenderer
+ */
+class TestDebugRenderer : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+        PhysicsCommon mPhysicsCommon;
+
+        PhysicsWorld* mWorld;
+
+        BoxShape* mBoxShape;
+
+        SphereShape* mSphereShape;
+
+        CapsuleShape* mCapsuleShape;
+
+        PolyhedronMesh* mPolyhedronMesh;
+
+        ConvexMeshShape* mConvexMeshShape;
+
+        HeightFieldShape* mHeightFieldShape;
+
+        RigidBody* mSphereBody;
+
+        RigidBody* mCapsuleBody;
+
+        /// Heights of the height field (not copied by the shape)
+        float mHeights[25];
+
+        /// Vertices of the convex hull (a cube)
+        float mHullPoints[24];
+
+        /// Total number of triangles of the shapes of the world
+        static constexpr uint32 NB_WORLD_TRIANGLES = 12 + 324 + 360 + 12 + 32;
+
+        // ---------- Methods ---------- //
+
+        /// Compute the debug primitives of the world
+        DebugRenderer& render() {
+
+            DebugRenderer& debugRenderer = mWorld->getDebugRenderer();
+            debugRenderer.reset();
+            debugRenderer.computeDebugRenderingPrimitives(*mWorld);
+
+            return debugRenderer;
+        }
+
+        /// Return the maximum distance between the vertices of the triangles and a line parallel to the y axis
+        decimal computeMaxDistanceToAxis(const DebugRenderer& debugRenderer, decimal axisX, decimal minX, decimal maxX) {
+
+            decimal maxDistance = 0;
+            for (uint32 t=0; t < debugRenderer.getNbTriangles(); t++) {
+
+                const DebugRenderer::DebugTriangle& triangle = debugRenderer.getTriangles()[t];
+                const Vector3 points[3] = {triangle.point1, triangle.point2, triangle.point3};
+                for (uint32 p=0; p < 3; p++) {
+                    if (points[p].x >= minX && points[p].x <= maxX) {
+                        const decimal distance = Vector3(points[p].x - axisX, 0, points[p].z).length();
+                        maxDistance = std::max(maxDistance, distance);
+                    }
+                }
+            }
+
+            return maxDistance;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestDebugRenderer(const std::string& name) : Test(name) {
+
+            for (uint32 i=0; i < 25; i++) {
+                mHeights[i] = 0.0f;
+            }
+
+            for (uint32 i=0; i < 8; i++) {
+                mHullPoints[i * 3] = (i & 1) ? 0.5f : -0.5f;
+                mHullPoints[i * 3 + 1] = (i & 2) ? 0.5f : -0.5f;
+                mHullPoints[i * 3 + 2] = (i & 4) ? 0.5f : -0.5f;
+            }
+
+            mBoxShape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            mSphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+            mCapsuleShape = mPhysicsCommon.createCapsuleShape(decimal(0.5), decimal(2.0));
+            mPolyhedronMesh = mPhysicsCommon.createConvexHullMesh(mHullPoints, 8, 3 * sizeof(float),
+                                                                  PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE);
+            mConvexMeshShape = mPhysicsCommon.createConvexMeshShape(mPolyhedronMesh);
+            mHeightFieldShape = mPhysicsCommon.createHeightFieldShape(5, 5, 0, 1, mHeights, HeightFieldShape::HeightDataType::HEIGHT_FLOAT_TYPE);
+
+            // Create a world with one body per shape along the x axis
+            mWorld = mPhysicsCommon.createPhysicsWorld();
+
+            RigidBody* box = mWorld->createRigidBody(Transform(Vector3(0, 0, 0), Quaternion::identity()));
+            box->addCollider(mBoxShape, Transform::identity());
+            mSphereBody = mWorld->createRigidBody(Transform(Vector3(10, 0, 0), Quaternion::identity()));
+            mSphereBody->addCollider(mSphereShape, Transform::identity());
+            mCapsuleBody = mWorld->createRigidBody(Transform(Vector3(20, 0, 0), Quaternion::identity()));
+            mCapsuleBody->addCollider(mCapsuleShape, Transform::identity());
+            RigidBody* convexMesh = mWorld->createRigidBody(Transform(Vector3(30, 0, 0), Quaternion::identity()));
+            convexMesh->addCollider(mConvexMeshShape, Transform::identity());
+            RigidBody* terrain = mWorld->createRigidBody(Transform(Vector3(40, 0, 0), Quaternion::identity()));
+            terrain->setType(BodyType::STATIC);
+            terrain->addCollider(mHeightFieldShape, Transform::identity());
+
+            mWorld->getDebugRenderer().setIsDebugItemDisplayed(DebugRenderer::DebugItem::COLLISION_SHAPE, true);
+        }
+
+        /// Destructor
+        virtual ~TestDebugRenderer() {
+
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+            mPhysicsCommon.destroyBoxShape(mBoxShape);
+            mPhysicsCommon.destroySphereShape(mSphereShape);
+            mPhysicsCommon.destroyCapsuleShape(mCapsuleShape);
+            mPhysicsCommon.destroyConvexMeshShape(mConvexMeshShape);
+            mPhysicsCommon.destroyPolyhedronMesh(mPolyhedronMesh);
+            mPhysicsCommon.destroyHeightFieldShape(mHeightFieldShape);
+        }
+
+        /// Run the tests
+        void run() {
+            testCachedTessellations();
+            testViewAABB();
+            testOutputBuffers();
+        }
+
+        /// Test that the cached tessellations follow the bodies and the changes of the shapes
+        void testCachedTessellations() {
+
+            DebugRenderer& debugRenderer = render();
+
+            rp3d_test(debugRenderer.getNbTriangles() == NB_WORLD_TRIANGLES);
+            rp3d_test(debugRenderer.getNbLines() == 0);
+
+            // Only the capsule, the convex mesh and the height field are cached
+            rp3d_test(debugRenderer.getNbCachedTessellations() == 3);
+
+            // The cached tessellations give the same result at the next frame
+            Array<DebugRenderer::DebugTriangle> firstFrameTriangles(mAllocator);
+            for (uint32 t=0; t < debugRenderer.getNbTriangles(); t++) {
+                firstFrameTriangles.add(debugRenderer.getTriangles()[t]);
+            }
+            render();
+            rp3d_test(debugRenderer.getNbTriangles() == NB_WORLD_TRIANGLES);
+            rp3d_test(debugRenderer.getNbCachedTessellations() == 3);
+            bool isSameFrame = true;
+            for (uint32 t=0; t < debugRenderer.getNbTriangles(); t++) {
+                isSameFrame &= debugRenderer.getTriangles()[t].point1 == firstFrameTriangles[t].point1 &&
+                               debugRenderer.getTriangles()[t].point2 == firstFrameTriangles[t].point2 &&
+                               debugRenderer.getTriangles()[t].point3 == firstFrameTriangles[t].point3;
+            }
+            rp3d_test(isSameFrame);
+
+            // The cached tessellations are transformed with the bodies
+            mCapsuleBody->setTransform(Transform(Vector3(25, 0, 0), Quaternion::identity()));
+            render();
+            rp3d_test(approxEqual(computeMaxDistanceToAxis(debugRenderer, 25, 24, 26), decimal(0.5), decimal(0.001)));
+
+            // The tessellation is computed again when the size of the shape changes
+            mCapsuleShape->setRadius(decimal(0.75));
+            render();
+            rp3d_test(debugRenderer.getNbTriangles() == NB_WORLD_TRIANGLES);
+            rp3d_test(approxEqual(computeMaxDistanceToAxis(debugRenderer, 25, 24, 26), decimal(0.75), decimal(0.001)));
+            mCapsuleShape->setRadius(decimal(0.5));
+
+            // The tessellations of the shapes that are not displayed anymore are released
+            mCapsuleBody->setIsActive(false);
+            render();
+            rp3d_test(debugRenderer.getNbTriangles() == NB_WORLD_TRIANGLES - 360);
+            rp3d_test(debugRenderer.getNbCachedTessellations() == 2);
+
+            mCapsuleBody->setIsActive(true);
+            mCapsuleBody->setTransform(Transform(Vector3(20, 0, 0), Quaternion::identity()));
+            render();
+            rp3d_test(debugRenderer.getNbTriangles() == NB_WORLD_TRIANGLES);
+            rp3d_test(debugRenderer.getNbCachedTessellations() == 3);
+
+            // The tessellation of a destroyed shape is released with the shape
+            CapsuleShape* capsuleShape = mPhysicsCommon.createCapsuleShape(decimal(0.5), decimal(2.0));
+            Collider* collider = mCapsuleBody->addCollider(capsuleShape, Transform(Vector3(0, 3, 0), Quaternion::identity()));
+            render();
+            rp3d_test(debugRenderer.getNbCachedTessellations() == 4);
+            mCapsuleBody->removeCollider(collider);
+            mPhysicsCommon.destroyCapsuleShape(capsuleShape);
+            rp3d_test(debugRenderer.getNbCachedTessellations() == 3);
+            render();
+            rp3d_test(debugRenderer.getNbTriangles() == NB_WORLD_TRIANGLES);
+        }
+
+        /// Test that only the objects inside the view AABB are displayed
+        void testViewAABB() {
+
+            DebugRenderer& debugRenderer = mWorld->getDebugRenderer();
+            rp3d_test(!debugRenderer.isViewAABBEnabled());
+
+            // View around the box only
+            debugRenderer.setViewAABB(AABB(Vector3(-1, -1, -1), Vector3(1, 1, 1)));
+            rp3d_test(debugRenderer.isViewAABBEnabled());
+            render();
+            rp3d_test(debugRenderer.getNbTriangles() == 12);
+
+            // The AABBs of the colliders are filtered as well
+            debugRenderer.setIsDebugItemDisplayed(DebugRenderer::DebugItem::COLLIDER_AABB, true);
+            render();
+            rp3d_test(debugRenderer.getNbLines() == 12);
+            debugRenderer.setIsDebugItemDisplayed(DebugRenderer::DebugItem::COLLIDER_AABB, false);
+
+            // View on a part of the height field only
+            debugRenderer.setViewAABB(AABB(Vector3(decimal(39.5), -10, decimal(-0.5)), Vector3(decimal(40.5), 10, decimal(0.5))));
+            render();
+            rp3d_test(debugRenderer.getNbTriangles() > 0);
+            rp3d_test(debugRenderer.getNbTriangles() < 32);
+            for (uint32 t=0; t < debugRenderer.getNbTriangles(); t++) {
+                const DebugRenderer::DebugTriangle& triangle = debugRenderer.getTriangles()[t];
+                const Vector3 trianglePoints[3] = {triangle.point1, triangle.point2, triangle.point3};
+                AABB triangleAABB = AABB::createAABBForTriangle(trianglePoints);
+                rp3d_test(triangleAABB.testCollision(debugRenderer.getViewAABB()));
+            }
+
+            // View containing the whole world
+            debugRenderer.setViewAABB(AABB(Vector3(-100, -100, -100), Vector3(100, 100, 100)));
+            render();
+            rp3d_test(debugRenderer.getNbTriangles() == NB_WORLD_TRIANGLES);
+
+            debugRenderer.disableViewAABB();
+            rp3d_test(!debugRenderer.isViewAABBEnabled());
+            render();
+            rp3d_test(debugRenderer.getNbTriangles() == NB_WORLD_TRIANGLES);
+        }
+
+        /// Test the packed vertex buffers provided by the user
+        void testOutputBuffers() {
+
+            DebugRenderer& debugRenderer = mWorld->getDebugRenderer();
+            debugRenderer.setIsDebugItemDisplayed(DebugRenderer::DebugItem::COLLIDER_AABB, true);
+
+            render();
+            const uint32 nbLines = debugRenderer.getNbLines();
+            const uint32 nbTriangles = debugRenderer.getNbTriangles();
+            rp3d_test(nbLines == 5 * 12);
+            rp3d_test(nbTriangles == NB_WORLD_TRIANGLES);
+            Array<DebugRenderer::DebugTriangle> triangles(mAllocator);
+            for (uint32 t=0; t < nbTriangles; t++) {
+                triangles.add(debugRenderer.getTriangles()[t]);
+            }
+
+            // Buffers large enough for all the primitives
+            Array<DebugRenderer::DebugVertex> lineVertices(mAllocator, 2 * nbLines);
+            Array<DebugRenderer::DebugVertex> triangleVertices(mAllocator, 3 * nbTriangles);
+            for (uint32 i=0; i < 2 * nbLines; i++) lineVertices.add(DebugRenderer::DebugVertex());
+            for (uint32 i=0; i < 3 * nbTriangles; i++) triangleVertices.add(DebugRenderer::DebugVertex());
+
+            debugRenderer.setOutputBuffers(&(lineVertices[0]), nbLines, &(triangleVertices[0]), nbTriangles);
+            rp3d_test(debugRenderer.isUsingOutputBuffers());
+            render();
+            rp3d_test(debugRenderer.getNbLines() == nbLines);
+            rp3d_test(debugRenderer.getNbTriangles() == nbTriangles);
+            rp3d_test(debugRenderer.getNbDroppedPrimitives() == 0);
+            rp3d_test(debugRenderer.getLines().size() == 0);
+            rp3d_test(debugRenderer.getTriangles().size() == 0);
+
+            bool isSameOutput = true;
+            for (uint32 t=0; t < nbTriangles; t++) {
+                const DebugRenderer::DebugVertex& vertex = triangleVertices[3 * t + 2];
+                isSameOutput &= vertex.x == static_cast<float>(triangles[t].point3.x) &&
+                                vertex.y == static_cast<float>(triangles[t].point3.y) &&
+                                vertex.z == static_cast<float>(triangles[t].point3.z) &&
+                                vertex.color == triangles[t].color3;
+            }
+            rp3d_test(isSameOutput);
+
+            // Buffers too small for all the primitives
+            debugRenderer.setOutputBuffers(&(lineVertices[0]), 10, &(triangleVertices[0]), 100);
+            render();
+            rp3d_test(debugRenderer.getNbLines() == 10);
+            rp3d_test(debugRenderer.getNbTriangles() == 100);
+            rp3d_test(debugRenderer.getNbDroppedPrimitives() == nbLines - 10 + nbTriangles - 100);
+
+            // Back to the arrays of the debug renderer
+            debugRenderer.removeOutputBuffers();
+            rp3d_test(!debugRenderer.isUsingOutputBuffers());
+            render();
+            rp3d_test(debugRenderer.getNbLines() == nbLines);
+            rp3d_test(debugRenderer.getNbTriangles() == nbTriangles);
+            rp3d_test(debugRenderer.getNbDroppedPrimitives() == 0);
+
+            debugRenderer.setIsDebugItemDisplayed(DebugRenderer::DebugItem::COLLIDER_AABB, false);
+        }
+ };
+
+}
+
+#endif
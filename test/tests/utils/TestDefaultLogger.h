@@ -0,0 +1,247 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_DEFAULT_LOGGER_H
+#define TEST_DEFAULT_LOGGER_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <sstream>
+#include <thread>
+#include <atomic>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class BlockingStringBuffer
+/**
+ * String buffer that blocks the writing thread while the blocking flag is set
+ */
+class BlockingStringBuffer : public std::stringbuf {
+
+    public:
+
+        /// True if the writes are blocked
+        std::atomic<bool> isBlocking;
+
+        /// True while a thread is blocked in a write
+        std::atomic<bool> isWriterBlocked;
+
+        BlockingStringBuffer() : isBlocking(false), isWriterBlocked(false) {
+
+        }
+
+    protected:
+
+        virtual std::streamsize xsputn(const char* text, std::streamsize size) override {
+
+            if (isBlocking.load()) {
+                isWriterBlocked.store(true);
+                while (isBlocking.load()) {
+                    std::this_thread::yield();
+                }
+                isWriterBlocked.store(false);
+            }
+
+            return std::stringbuf::xsputn(text, size);
+        }
+};
+
+// Class TestDefaultLogger
+/**
+ * Unit test for the DefaultLogger in synchronous and asynchronous modes
+ */
+class TestDefaultLogger : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        // ---------- Methods ---------- //
+
+        /// Return the number of occurrences of a text in a string
+        static uint32 countOccurrences(const std::string& text, const std::string& pattern) {
+
+            uint32 nbOccurrences = 0;
+            size_t position = text.find(pattern);
+            while (position != std::string::npos) {
+                nbOccurrences++;
+                position = text.find(pattern, position + pattern.size());
+            }
+
+            return nbOccurrences;
+        }
+
+        /// Log some messages with a given prefix
+        static void logMessages(DefaultLogger* logger, const std::string& prefix, uint32 nbMessages) {
+            for (uint32 i=0; i < nbMessages; i++) {
+                logger->log(Logger::Level::Warning, "World", Logger::Category::World, prefix + std::to_string(i) + ";",
+                            __FILE__, __LINE__);
+            }
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestDefaultLogger(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+            testSynchronousMode();
+            testAsynchronousMode();
+            testConcurrentLogging();
+            testDroppedMessages();
+        }
+
+        /// Test that the messages are written immediately in synchronous mode
+        void testSynchronousMode() {
+
+            DefaultLogger* logger = mPhysicsCommon.createDefaultLogger();
+            std::stringstream stream;
+            logger->addStreamDestination(stream, static_cast<uint>(Logger::Level::Warning), DefaultLogger::Format::Text);
+
+            rp3d_test(!logger->isAsynchronousModeEnabled());
+
+            logMessages(logger, "sync", 3);
+            rp3d_test(countOccurrences(stream.str(), "sync") == 3);
+
+            // The messages above the level of the destinations are ignored
+            logger->log(Logger::Level::Information, "World", Logger::Category::World, "information", __FILE__, __LINE__);
+            rp3d_test(countOccurrences(stream.str(), "information") == 0);
+
+            // Flushing does nothing
+            logger->flush();
+
+            mPhysicsCommon.destroyDefaultLogger(logger);
+        }
+
+        /// Test that the messages are written in order by the background thread
+        void testAsynchronousMode() {
+
+            DefaultLogger* logger = mPhysicsCommon.createDefaultLogger();
+            std::stringstream stream;
+            logger->addStreamDestination(stream, static_cast<uint>(Logger::Level::Warning), DefaultLogger::Format::Text);
+
+            logger->enableAsynchronousMode(1024);
+            rp3d_test(logger->isAsynchronousModeEnabled());
+
+            logMessages(logger, "async", 500);
+            logger->log(Logger::Level::Information, "World", Logger::Category::World, "information", __FILE__, __LINE__);
+            logger->flush();
+
+            const std::string logs = stream.str();
+            rp3d_test(countOccurrences(logs, "async") == 500);
+            rp3d_test(countOccurrences(logs, "information") == 0);
+            rp3d_test(logs.find("async0;") < logs.find("async1;"));
+            rp3d_test(logs.find("async1;") < logs.find("async499;"));
+            rp3d_test(logger->getNbDroppedMessages() == 0);
+
+            // The pending messages are written when the asynchronous mode is disabled
+            logMessages(logger, "pending", 10);
+            logger->disableAsynchronousMode();
+            rp3d_test(!logger->isAsynchronousModeEnabled());
+            rp3d_test(countOccurrences(stream.str(), "pending") == 10);
+
+            logMessages(logger, "direct", 1);
+            rp3d_test(countOccurrences(stream.str(), "direct") == 1);
+
+            // The destructor of the logger writes the pending messages
+            logger->enableAsynchronousMode();
+            logMessages(logger, "destroyed", 10);
+            mPhysicsCommon.destroyDefaultLogger(logger);
+            rp3d_test(countOccurrences(stream.str(), "destroyed") == 10);
+        }
+
+        /// Test that the messages of several threads are all written
+        void testConcurrentLogging() {
+
+            DefaultLogger* logger = mPhysicsCommon.createDefaultLogger();
+            std::stringstream stream;
+            logger->addStreamDestination(stream, static_cast<uint>(Logger::Level::Warning), DefaultLogger::Format::Text);
+            logger->enableAsynchronousMode(8192);
+
+            std::thread threads[4];
+            for (int i=0; i < 4; i++) {
+                threads[i] = std::thread(&TestDefaultLogger::logMessages, logger, "thread" + std::to_string(i) + "-", 1000);
+            }
+            for (int i=0; i < 4; i++) {
+                threads[i].join();
+            }
+            logger->flush();
+
+            const std::string logs = stream.str();
+            rp3d_test(logger->getNbDroppedMessages() == 0);
+            for (int i=0; i < 4; i++) {
+                rp3d_test(countOccurrences(logs, "thread" + std::to_string(i) + "-") == 1000);
+                rp3d_test(countOccurrences(logs, "thread" + std::to_string(i) + "-999;") == 1);
+            }
+
+            mPhysicsCommon.destroyDefaultLogger(logger);
+        }
+
+        /// Test that the messages are dropped when the queue is full
+        void testDroppedMessages() {
+
+            DefaultLogger* logger = mPhysicsCommon.createDefaultLogger();
+            BlockingStringBuffer buffer;
+            std::ostream stream(&buffer);
+            logger->addStreamDestination(stream, static_cast<uint>(Logger::Level::Warning), DefaultLogger::Format::Text);
+
+            // The capacity is rounded up to eight messages
+            logger->enableAsynchronousMode(5);
+
+            // Block the background thread while it writes the first message
+            buffer.isBlocking.store(true);
+            logMessages(logger, "first", 1);
+            while (!buffer.isWriterBlocked.load()) {
+                std::this_thread::yield();
+            }
+
+            // The record of the first message is not free yet and the next ones are dropped after seven messages
+            logMessages(logger, "queued", 13);
+            rp3d_test(logger->getNbDroppedMessages() == 6);
+
+            buffer.isBlocking.store(false);
+            logger->flush();
+
+            const std::string logs = buffer.str();
+            rp3d_test(countOccurrences(logs, "first") == 1);
+            rp3d_test(countOccurrences(logs, "queued") == 7);
+            rp3d_test(countOccurrences(logs, "queued6;") == 1);
+            rp3d_test(countOccurrences(logs, "6 messages dropped") == 1);
+
+            mPhysicsCommon.destroyDefaultLogger(logger);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,216 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_INSTRUMENTATION_H
+#define TEST_INSTRUMENTATION_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <cstring>
+#include <thread>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class InstrumentationRaycastCallback
+/**
+ * Raycast callback that does not stop the raycast
+ */
+class InstrumentationRaycastCallback : public RaycastCallback {
+
+    public:
+
+        virtual decimal notifyRaycastHit(const RaycastInfo& /*raycastInfo*/) override {
+            return decimal(1.0);
+        }
+};
+
+// Class TestInstrumentation
+/**
+ * Unit test for the lightweight instrumentation of the main stages
+ */
+class TestInstrumentation : public Test {
+
+    private :
+
+        // ---------- Methods ---------- //
+
+        /// Add samples of the raycast stage
+        static void addRaycastSamples(uint32 nbSamples, uint64 nbTicks) {
+            for (uint32 i=0; i < nbSamples; i++) {
+                Instrumentation::addSample(InstrumentationStage::Raycast, nbTicks);
+            }
+        }
+
+        /// Return a snapshot of the instrumentation
+        Instrumentation::Snapshot takeSnapshot() const {
+            Instrumentation::Snapshot snapshot;
+            Instrumentation::getSnapshot(snapshot);
+            return snapshot;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestInstrumentation(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testStagesNames();
+            testSamples();
+            testThreads();
+
+#ifdef IS_RP3D_INSTRUMENTATION_ENABLED
+            testWorldStages();
+#endif
+
+            Instrumentation::setIsEnabled(false);
+            Instrumentation::reset();
+        }
+
+        /// Test the names of the stages
+        void testStagesNames() {
+
+            rp3d_test(std::strcmp(Instrumentation::getStageName(InstrumentationStage::Step), "Step") == 0);
+            rp3d_test(std::strcmp(Instrumentation::getStageName(InstrumentationStage::NarrowPhase), "NarrowPhase") == 0);
+            rp3d_test(std::strcmp(Instrumentation::getStageName(InstrumentationStage::TestCollision), "TestCollision") == 0);
+        }
+
+        /// Test the samples added to the counters and the reset
+        void testSamples() {
+
+            Instrumentation::reset();
+
+            addRaycastSamples(3, 100);
+            Instrumentation::addSample(InstrumentationStage::Step, 50);
+
+            Instrumentation::Snapshot snapshot = takeSnapshot();
+            rp3d_test(snapshot.getStage(InstrumentationStage::Raycast).nbCalls == 3);
+            rp3d_test(snapshot.getStage(InstrumentationStage::Raycast).nbTicks == 300);
+            rp3d_test(snapshot.getStage(InstrumentationStage::Step).nbCalls == 1);
+            rp3d_test(snapshot.getStage(InstrumentationStage::Step).nbTicks == 50);
+            rp3d_test(snapshot.getStage(InstrumentationStage::BroadPhase).nbCalls == 0);
+            rp3d_test(snapshot.ticksPerSecond > 0);
+            rp3d_test(snapshot.getStage(InstrumentationStage::Raycast).time > 0);
+            rp3d_test(snapshot.nbThreads >= 1);
+
+            Instrumentation::reset();
+
+            snapshot = takeSnapshot();
+            rp3d_test(snapshot.getStage(InstrumentationStage::Raycast).nbCalls == 0);
+            rp3d_test(snapshot.getStage(InstrumentationStage::Raycast).nbTicks == 0);
+            rp3d_test(snapshot.getStage(InstrumentationStage::Step).nbCalls == 0);
+        }
+
+        /// Test that the counters of all the threads are summed in the snapshot
+        void testThreads() {
+
+            Instrumentation::reset();
+
+            std::thread thread1(addRaycastSamples, 1000, 2);
+            std::thread thread2(addRaycastSamples, 1000, 3);
+            thread1.join();
+            thread2.join();
+
+            Instrumentation::Snapshot snapshot = takeSnapshot();
+            rp3d_test(snapshot.getStage(InstrumentationStage::Raycast).nbCalls == 2000);
+            rp3d_test(snapshot.getStage(InstrumentationStage::Raycast).nbTicks == 5000);
+            rp3d_test(snapshot.nbThreads >= 2);
+
+            Instrumentation::reset();
+        }
+
+#ifdef IS_RP3D_INSTRUMENTATION_ENABLED
+
+        /// Test the stages measured during the steps of a physics world
+        void testWorldStages() {
+
+            PhysicsCommon physicsCommon;
+            PhysicsWorld* world = physicsCommon.createPhysicsWorld();
+
+            BoxShape* boxShape = physicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            BoxShape* floorShape = physicsCommon.createBoxShape(Vector3(10, decimal(0.5), 10));
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, decimal(-0.5), 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(floorShape, Transform::identity());
+            RigidBody* box = world->createRigidBody(Transform(Vector3(0, decimal(0.5), 0), Quaternion::identity()));
+            box->addCollider(boxShape, Transform::identity());
+
+            const decimal timeStep = decimal(1.0) / decimal(60.0);
+
+            // Nothing is measured when the instrumentation is disabled
+            Instrumentation::setIsEnabled(false);
+            Instrumentation::reset();
+            world->update(timeStep);
+            rp3d_test(takeSnapshot().getStage(InstrumentationStage::Step).nbCalls == 0);
+
+            Instrumentation::setIsEnabled(true);
+            rp3d_test(Instrumentation::isEnabled());
+
+            const uint32 nbSteps = 10;
+            for (uint32 i=0; i < nbSteps; i++) {
+                world->update(timeStep);
+            }
+
+            InstrumentationRaycastCallback raycastCounter;
+            world->raycast(Ray(Vector3(0, 10, 0), Vector3(0, -10, 0)), &raycastCounter);
+            world->testOverlap(floor, box);
+
+            Instrumentation::Snapshot snapshot = takeSnapshot();
+            rp3d_test(snapshot.getStage(InstrumentationStage::Step).nbCalls == nbSteps);
+            rp3d_test(snapshot.getStage(InstrumentationStage::CollisionDetection).nbCalls == nbSteps);
+            // The overlap query also computes the broad-phase
+            rp3d_test(snapshot.getStage(InstrumentationStage::BroadPhase).nbCalls == nbSteps + 1);
+            rp3d_test(snapshot.getStage(InstrumentationStage::NarrowPhase).nbCalls == nbSteps);
+            rp3d_test(snapshot.getStage(InstrumentationStage::IntegrateVelocities).nbCalls == nbSteps);
+            rp3d_test(snapshot.getStage(InstrumentationStage::ContactSolver).nbCalls == nbSteps * world->getNbIterationsVelocitySolver());
+            rp3d_test(snapshot.getStage(InstrumentationStage::Raycast).nbCalls == 1);
+            rp3d_test(snapshot.getStage(InstrumentationStage::TestOverlap).nbCalls == 1);
+            rp3d_test(snapshot.getStage(InstrumentationStage::TestCollision).nbCalls == 0);
+
+            // A stage contains the stages it calls
+            rp3d_test(snapshot.getStage(InstrumentationStage::Step).nbTicks > 0);
+            rp3d_test(snapshot.getStage(InstrumentationStage::Step).nbTicks >= snapshot.getStage(InstrumentationStage::CollisionDetection).nbTicks);
+            rp3d_test(snapshot.getStage(InstrumentationStage::CollisionDetection).nbTicks >= snapshot.getStage(InstrumentationStage::NarrowPhase).nbTicks);
+
+            Instrumentation::setIsEnabled(false);
+
+            physicsCommon.destroyPhysicsWorld(world);
+            physicsCommon.destroyBoxShape(boxShape);
+            physicsCommon.destroyBoxShape(floorShape);
+        }
+
+#endif
+};
+
+}
+
+#endif
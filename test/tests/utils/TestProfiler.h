@@ -0,0 +1,187 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_PROFILER_H
+#define TEST_PROFILER_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <sstream>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestProfiler
+/**
+ * Unit test for the trace of the Profiler (only tested when the profiling is enabled)
+ */
+class TestProfiler : public Test {
+
+    private :
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        // ---------- Methods ---------- //
+
+        /// Profile two nested blocks of code
+        void profileNestedBlocks(Profiler& profiler) {
+
+            profiler.startProfilingBlock("outer");
+            profiler.startProfilingBlock("inner");
+            profiler.stopProfilingBlock();
+            profiler.stopProfilingBlock();
+        }
+
+        /// Return the number of occurences of a string in a text
+        uint32 countOccurences(const std::string& text, const std::string& pattern) const {
+
+            uint32 nbOccurences = 0;
+            for (size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1)) {
+                nbOccurences++;
+            }
+            return nbOccurences;
+        }
+
+#endif
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestProfiler(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+            testTraceDisabled();
+            testTraceEvents();
+            testRingBuffer();
+            testReset();
+#endif
+        }
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        /// Test that no event is recorded when the trace is disabled
+        void testTraceDisabled() {
+
+            Profiler profiler;
+
+            rp3d_test(profiler.getTraceCapacity() == 0);
+
+            profileNestedBlocks(profiler);
+
+            rp3d_test(profiler.getNbTraceEvents() == 0);
+        }
+
+        /// Test the events of the trace and their trace event JSON output
+        void testTraceEvents() {
+
+            Profiler profiler;
+            std::stringstream stream;
+            profiler.addStreamDestination(stream, Profiler::Format::ChromeTrace);
+
+            // A trace destination enables the trace
+            rp3d_test(profiler.getTraceCapacity() > 0);
+
+            profiler.incrementFrameCounter();
+            profileNestedBlocks(profiler);
+            profiler.incrementFrameCounter();
+            profileNestedBlocks(profiler);
+
+            rp3d_test(profiler.getNbTraceEvents() == 4);
+
+            profiler.printReport();
+            const std::string trace = stream.str();
+
+            rp3d_test(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+            rp3d_test(countOccurences(trace, "\"name\":\"outer\"") == 2);
+            rp3d_test(countOccurences(trace, "\"name\":\"inner\"") == 2);
+            rp3d_test(countOccurences(trace, "\"ph\":\"X\"") == 4);
+            rp3d_test(countOccurences(trace, "\"args\":{\"frame\":1}") == 2);
+            rp3d_test(countOccurences(trace, "\"args\":{\"frame\":2}") == 2);
+
+            // The inner block is closed (and recorded) before the outer one
+            rp3d_test(trace.find("\"name\":\"inner\"") < trace.find("\"name\":\"outer\""));
+
+            // There is no comma after the last event
+            rp3d_test(trace.find("}}\n]}") != std::string::npos);
+        }
+
+        /// Test that only the last events are kept when the trace is full
+        void testRingBuffer() {
+
+            Profiler profiler;
+            profiler.setTraceCapacity(3);
+
+            for (uint32 i=0; i < 4; i++) {
+                profiler.incrementFrameCounter();
+                profileNestedBlocks(profiler);
+            }
+
+            rp3d_test(profiler.getNbTraceEvents() == 3);
+
+            std::stringstream stream;
+            profiler.addStreamDestination(stream, Profiler::Format::ChromeTrace);
+            profiler.printReport();
+            const std::string trace = stream.str();
+
+            // The last three events are the outer block of frame 3 and the two blocks of frame 4
+            rp3d_test(countOccurences(trace, "\"ph\":\"X\"") == 3);
+            rp3d_test(countOccurences(trace, "\"args\":{\"frame\":3}") == 1);
+            rp3d_test(countOccurences(trace, "\"args\":{\"frame\":4}") == 2);
+            rp3d_test(trace.find("\"args\":{\"frame\":3}") < trace.find("\"args\":{\"frame\":4}"));
+
+            // Disable the trace
+            profiler.setTraceCapacity(0);
+            profileNestedBlocks(profiler);
+            rp3d_test(profiler.getNbTraceEvents() == 0);
+        }
+
+        /// Test that the reset of the profiler clears the trace
+        void testReset() {
+
+            Profiler profiler;
+            profiler.setTraceCapacity(16);
+
+            profileNestedBlocks(profiler);
+            rp3d_test(profiler.getNbTraceEvents() == 2);
+
+            profiler.reset();
+            rp3d_test(profiler.getNbTraceEvents() == 0);
+            rp3d_test(profiler.getTraceCapacity() == 16);
+        }
+
+#endif
+
+};
+
+}
+
+#endif